@@ -0,0 +1,93 @@
+#
+# FindBenchmark_EP.cmake
+#
+#
+# The MIT License
+#
+# Copyright (c) 2018 TileDB, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# Finds the Google Benchmark library, installing with an ExternalProject as
+# necessary. This module defines:
+#   - BENCHMARK_INCLUDE_DIR, directory containing headers
+#   - BENCHMARK_LIBRARIES, the Benchmark library path
+#   - BENCHMARK_FOUND, whether Benchmark has been found
+#   - The Benchmark::Benchmark imported target
+
+# Search the path set during the superbuild for the EP.
+set(BENCHMARK_PATHS ${TILEDB_EP_INSTALL_PREFIX})
+
+find_path(BENCHMARK_INCLUDE_DIR
+  NAMES benchmark/benchmark.h
+  PATHS ${BENCHMARK_PATHS}
+  PATH_SUFFIXES include
+  ${TILEDB_DEPS_NO_DEFAULT_PATH}
+)
+
+find_library(BENCHMARK_LIBRARIES
+  NAMES
+    benchmark libbenchmark
+  PATHS ${BENCHMARK_PATHS}
+  PATH_SUFFIXES lib
+  ${TILEDB_DEPS_NO_DEFAULT_PATH}
+)
+
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(Benchmark
+  REQUIRED_VARS BENCHMARK_LIBRARIES BENCHMARK_INCLUDE_DIR
+)
+
+if (NOT BENCHMARK_FOUND)
+  if (TILEDB_SUPERBUILD)
+    message(STATUS "Adding Benchmark as an external project")
+    if (WIN32)
+      set(ARCH_SPEC -A X64)
+    endif()
+    ExternalProject_Add(ep_benchmark
+      PREFIX "externals"
+      GIT_REPOSITORY "https://github.com/google/benchmark.git"
+      GIT_TAG "v1.4.0"
+      CMAKE_ARGS
+        ${ARCH_SPEC}
+        -DCMAKE_INSTALL_PREFIX=${TILEDB_EP_INSTALL_PREFIX}
+        -DCMAKE_INSTALL_LIBDIR=lib
+        -DCMAKE_BUILD_TYPE=Release
+        -DBENCHMARK_ENABLE_TESTING=OFF
+      UPDATE_COMMAND ""
+      LOG_DOWNLOAD TRUE
+      LOG_CONFIGURE TRUE
+      LOG_BUILD TRUE
+      LOG_INSTALL TRUE
+    )
+    list(APPEND TILEDB_EXTERNAL_PROJECTS ep_benchmark)
+  else()
+    message(FATAL_ERROR "Unable to find Benchmark")
+  endif()
+endif()
+
+if (BENCHMARK_FOUND AND NOT TARGET Benchmark::Benchmark)
+  find_package(Threads REQUIRED)
+  add_library(Benchmark::Benchmark UNKNOWN IMPORTED)
+  set_target_properties(Benchmark::Benchmark PROPERTIES
+    IMPORTED_LOCATION "${BENCHMARK_LIBRARIES}"
+    INTERFACE_INCLUDE_DIRECTORIES "${BENCHMARK_INCLUDE_DIR}"
+    INTERFACE_LINK_LIBRARIES "Threads::Threads"
+  )
+endif()
@@ -25,8 +25,10 @@ set(INHERITED_CMAKE_ARGS
   -DTILEDB_VERBOSE=${TILEDB_VERBOSE}
   -DTILEDB_S3=${TILEDB_S3}
   -DTILEDB_HDFS=${TILEDB_HDFS}
+  -DTILEDB_ISAL=${TILEDB_ISAL}
   -DTILEDB_WERROR=${TILEDB_WERROR}
   -DTILEDB_CPP_API=${TILEDB_CPP_API}
+  -DTILEDB_BENCHMARKS=${TILEDB_BENCHMARKS}
   -DTILEDB_FORCE_ALL_DEPS=${TILEDB_FORCE_ALL_DEPS}
   -DTILEDB_TESTS_AWS_S3_CONFIG=${TILEDB_TESTS_AWS_S3_CONFIG}
   -DSANITIZER=${SANITIZER}
@@ -58,6 +60,10 @@ include(${CMAKE_SOURCE_DIR}/cmake/Modules/FindSpdlog_EP.cmake)
 include(${CMAKE_SOURCE_DIR}/cmake/Modules/FindZlib_EP.cmake)
 include(${CMAKE_SOURCE_DIR}/cmake/Modules/FindZstd_EP.cmake)
 
+if (TILEDB_BENCHMARKS)
+  include(${CMAKE_SOURCE_DIR}/cmake/Modules/FindBenchmark_EP.cmake)
+endif()
+
 if (TILEDB_S3)
   if (NOT WIN32)
     # AWS SDK uses builtin WinHTTP and BCrypt instead of these.
@@ -0,0 +1,29 @@
+/*
+ **********************************************************************
+ ** murmur3.h -- Header file for MurmurHash3 (x64, 128-bit variant)  **
+ ** MurmurHash3 was written by Austin Appleby, and is placed in the  **
+ ** public domain. The author hereby disclaims copyright to this     **
+ ** source code.                                                     **
+ **********************************************************************
+ */
+
+#ifndef TILEDB_MURMUR3_H
+#define TILEDB_MURMUR3_H
+
+#include <stdint.h>
+
+namespace murmur3 {
+
+/**
+ * Computes the 128-bit MurmurHash3 (x64 variant) of the input buffer.
+ *
+ * @param key The buffer to be hashed.
+ * @param len The size (in bytes) of the buffer.
+ * @param seed The hash seed.
+ * @param out The resulting 128-bit hash (the caller must provide 16 bytes).
+ */
+void MurmurHash3_x64_128(const void* key, int len, uint32_t seed, void* out);
+
+}  // namespace murmur3
+
+#endif  // TILEDB_MURMUR3_H
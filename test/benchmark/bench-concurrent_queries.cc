@@ -0,0 +1,373 @@
+/**
+ * @file bench-concurrent_queries.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Multithreaded scalability benchmark: N concurrent client threads
+ * submit a mixed read workload (dense/sparse point lookups and subarray
+ * scans) through `StorageManager::query_submit()` against pre-generated
+ * arrays, sharing the open-array registry, the tile cache and the stats
+ * facility. The benchmark reports the aggregate throughput (items/sec)
+ * and the per-thread p50/p99 query latencies per thread count, so that
+ * lock-contention regressions on the shared structures surface as
+ * flattening throughput curves. The arrays are generated once under
+ * `tiledb_bench_concurrent/` in the current working directory and are
+ * left in place across runs of the binary.
+ */
+
+#ifdef _WIN32
+#include "tiledb/sm/filesystem/win_filesystem.h"
+#else
+#include "tiledb/sm/filesystem/posix_filesystem.h"
+#endif
+#include "tiledb/sm/c_api/tiledb.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* attr_name = "a";
+
+#ifdef _WIN32
+const std::string bench_temp_dir =
+    tiledb::sm::win::current_dir() + "\\tiledb_bench_concurrent\\";
+#else
+const std::string bench_temp_dir =
+    tiledb::sm::posix::current_dir() + "/tiledb_bench_concurrent/";
+#endif
+
+const std::string dense_array = bench_temp_dir + "dense";
+const std::string sparse_array = bench_temp_dir + "sparse";
+
+/** The dense array is `dense_domain_size`^2 cells, one tile row each. */
+const int64_t dense_domain_size = 2000;
+const int64_t dense_tile_extent = 200;
+
+/** The sparse array holds `sparse_cell_num` random cells. */
+const int64_t sparse_domain_size = 1000000;
+const uint64_t sparse_cell_num = 200000;
+
+/** The edge of the dense subarray scans. */
+const int64_t dense_scan_size = 200;
+
+/** The edge of the sparse subarray scans. */
+const int64_t sparse_scan_size = 100000;
+
+/** The context shared by all client threads. */
+tiledb_ctx_t* ctx = nullptr;
+
+/** Creates the context and generates the arrays once per process. */
+bool ensure_setup() {
+  static std::mutex mtx;
+  static bool done = false;
+  static bool ok = false;
+  std::lock_guard<std::mutex> lock(mtx);
+  if (done)
+    return ok;
+  done = true;
+
+  if (tiledb_ctx_create(&ctx, nullptr) != TILEDB_OK)
+    return false;
+
+  // (Re)create the benchmark directory
+  tiledb_vfs_t* vfs = nullptr;
+  if (tiledb_vfs_create(ctx, &vfs, nullptr) != TILEDB_OK)
+    return false;
+  int is_dir = 0;
+  ok = tiledb_vfs_is_dir(ctx, vfs, bench_temp_dir.c_str(), &is_dir) ==
+       TILEDB_OK;
+  if (ok && is_dir)
+    ok = tiledb_vfs_remove_dir(ctx, vfs, bench_temp_dir.c_str()) == TILEDB_OK;
+  if (ok)
+    ok = tiledb_vfs_create_dir(ctx, vfs, bench_temp_dir.c_str()) == TILEDB_OK;
+  tiledb_vfs_free(ctx, &vfs);
+  if (!ok)
+    return false;
+
+  // Create the dense and sparse 2D arrays (int64 dimensions, int32
+  // attribute)
+  for (int sparse = 0; sparse < 2; sparse++) {
+    auto array_name = (sparse) ? sparse_array : dense_array;
+    auto domain_size = (sparse) ? sparse_domain_size : dense_domain_size;
+    auto tile_extent = (sparse) ? domain_size / 10 : dense_tile_extent;
+
+    tiledb_attribute_t* a = nullptr;
+    tiledb_dimension_t* d1 = nullptr;
+    tiledb_dimension_t* d2 = nullptr;
+    tiledb_domain_t* domain = nullptr;
+    tiledb_array_schema_t* array_schema = nullptr;
+    int64_t dim_domain[] = {1, domain_size, 1, domain_size};
+    ok = tiledb_attribute_create(ctx, &a, attr_name, TILEDB_INT32) ==
+             TILEDB_OK &&
+         tiledb_dimension_create(
+             ctx, &d1, "d1", TILEDB_INT64, &dim_domain[0], &tile_extent) ==
+             TILEDB_OK &&
+         tiledb_dimension_create(
+             ctx, &d2, "d2", TILEDB_INT64, &dim_domain[2], &tile_extent) ==
+             TILEDB_OK &&
+         tiledb_domain_create(ctx, &domain) == TILEDB_OK &&
+         tiledb_domain_add_dimension(ctx, domain, d1) == TILEDB_OK &&
+         tiledb_domain_add_dimension(ctx, domain, d2) == TILEDB_OK &&
+         tiledb_array_schema_create(
+             ctx, &array_schema, (sparse) ? TILEDB_SPARSE : TILEDB_DENSE) ==
+             TILEDB_OK &&
+         tiledb_array_schema_set_capacity(ctx, array_schema, 10000) ==
+             TILEDB_OK &&
+         tiledb_array_schema_add_attribute(ctx, array_schema, a) ==
+             TILEDB_OK &&
+         tiledb_array_schema_set_domain(ctx, array_schema, domain) ==
+             TILEDB_OK &&
+         tiledb_array_create(ctx, array_name.c_str(), array_schema) ==
+             TILEDB_OK;
+    if (a != nullptr)
+      tiledb_attribute_free(ctx, &a);
+    if (d1 != nullptr)
+      tiledb_dimension_free(ctx, &d1);
+    if (d2 != nullptr)
+      tiledb_dimension_free(ctx, &d2);
+    if (domain != nullptr)
+      tiledb_domain_free(ctx, &domain);
+    if (array_schema != nullptr)
+      tiledb_array_schema_free(ctx, &array_schema);
+    if (!ok)
+      return false;
+  }
+
+  // Ingest one full-domain dense fragment
+  {
+    auto cell_num = (uint64_t)(dense_domain_size * dense_domain_size);
+    std::vector<int> cells(cell_num);
+    for (uint64_t i = 0; i < cell_num; ++i)
+      cells[i] = (int)i;
+    const int64_t subarray[] = {
+        1, dense_domain_size, 1, dense_domain_size};
+    const char* attributes[] = {attr_name};
+    void* buffers[] = {&cells[0]};
+    uint64_t buffer_sizes[] = {cells.size() * sizeof(int)};
+    tiledb_query_t* query = nullptr;
+    ok = tiledb_query_create(
+             ctx, &query, dense_array.c_str(), TILEDB_WRITE) == TILEDB_OK &&
+         tiledb_query_set_buffers(
+             ctx, query, attributes, 1, buffers, buffer_sizes) == TILEDB_OK &&
+         tiledb_query_set_subarray(ctx, query, subarray) == TILEDB_OK &&
+         tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR) == TILEDB_OK &&
+         tiledb_query_submit(ctx, query) == TILEDB_OK &&
+         tiledb_query_finalize(ctx, query) == TILEDB_OK;
+    if (query != nullptr)
+      tiledb_query_free(ctx, &query);
+    if (!ok)
+      return false;
+  }
+
+  // Ingest one unordered sparse fragment with random coordinates
+  {
+    std::mt19937_64 rng(0xBADC0FFE);
+    std::vector<int> values(sparse_cell_num);
+    std::vector<int64_t> coords(2 * sparse_cell_num);
+    for (uint64_t i = 0; i < sparse_cell_num; ++i) {
+      values[i] = (int)i;
+      coords[2 * i] = (int64_t)(rng() % (uint64_t)sparse_domain_size) + 1;
+      coords[2 * i + 1] = (int64_t)(rng() % (uint64_t)sparse_domain_size) + 1;
+    }
+    const char* attributes[] = {attr_name, TILEDB_COORDS};
+    void* buffers[] = {&values[0], &coords[0]};
+    uint64_t buffer_sizes[] = {values.size() * sizeof(int),
+                               coords.size() * sizeof(int64_t)};
+    tiledb_query_t* query = nullptr;
+    ok = tiledb_query_create(
+             ctx, &query, sparse_array.c_str(), TILEDB_WRITE) == TILEDB_OK &&
+         tiledb_query_set_buffers(
+             ctx, query, attributes, 2, buffers, buffer_sizes) == TILEDB_OK &&
+         tiledb_query_set_layout(ctx, query, TILEDB_UNORDERED) == TILEDB_OK &&
+         tiledb_query_submit(ctx, query) == TILEDB_OK &&
+         tiledb_query_finalize(ctx, query) == TILEDB_OK;
+    if (query != nullptr)
+      tiledb_query_free(ctx, &query);
+  }
+
+  return ok;
+}
+
+/** Submits a dense read on the input subarray. */
+bool dense_read(const int64_t* subarray, std::vector<int>* cells) {
+  const char* attributes[] = {attr_name};
+  void* buffers[] = {&(*cells)[0]};
+  uint64_t buffer_sizes[] = {cells->size() * sizeof(int)};
+  tiledb_query_t* query = nullptr;
+  bool ok = tiledb_query_create(
+                ctx, &query, dense_array.c_str(), TILEDB_READ) == TILEDB_OK &&
+            tiledb_query_set_buffers(
+                ctx, query, attributes, 1, buffers, buffer_sizes) ==
+                TILEDB_OK &&
+            tiledb_query_set_subarray(ctx, query, subarray) == TILEDB_OK &&
+            tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR) ==
+                TILEDB_OK &&
+            tiledb_query_submit(ctx, query) == TILEDB_OK &&
+            tiledb_query_finalize(ctx, query) == TILEDB_OK;
+  if (query != nullptr)
+    tiledb_query_free(ctx, &query);
+  return ok;
+}
+
+/** Submits a sparse read on the input subarray. */
+bool sparse_read(
+    const int64_t* subarray,
+    std::vector<int>* values,
+    std::vector<int64_t>* coords) {
+  const char* attributes[] = {attr_name, TILEDB_COORDS};
+  void* buffers[] = {&(*values)[0], &(*coords)[0]};
+  uint64_t buffer_sizes[] = {values->size() * sizeof(int),
+                             coords->size() * sizeof(int64_t)};
+  tiledb_query_t* query = nullptr;
+  bool ok = tiledb_query_create(
+                ctx, &query, sparse_array.c_str(), TILEDB_READ) == TILEDB_OK &&
+            tiledb_query_set_buffers(
+                ctx, query, attributes, 2, buffers, buffer_sizes) ==
+                TILEDB_OK &&
+            tiledb_query_set_subarray(ctx, query, subarray) == TILEDB_OK &&
+            tiledb_query_set_layout(ctx, query, TILEDB_GLOBAL_ORDER) ==
+                TILEDB_OK &&
+            tiledb_query_submit(ctx, query) == TILEDB_OK &&
+            tiledb_query_finalize(ctx, query) == TILEDB_OK;
+  if (query != nullptr)
+    tiledb_query_free(ctx, &query);
+  return ok;
+}
+
+/** Returns the `p`-th percentile of the (sorted in place) latencies. */
+double percentile(std::vector<double>* latencies, double p) {
+  if (latencies->empty())
+    return 0.0;
+  std::sort(latencies->begin(), latencies->end());
+  auto idx = (size_t)(p * (double)(latencies->size() - 1));
+  return (*latencies)[idx];
+}
+
+}  // namespace
+
+/* ********************************* */
+/*        Concurrent reads           */
+/* ********************************* */
+
+// Each benchmark thread is a client cycling through four workloads:
+// dense point lookup, dense subarray scan, sparse point lookup, sparse
+// subarray scan. Run with `--benchmark_filter=ConcurrentMixedReads` and
+// compare items_per_second across thread counts.
+static void BM_ConcurrentMixedReads(benchmark::State& state) {
+  if (!ensure_setup()) {
+    state.SkipWithError("benchmark setup failed");
+    return;
+  }
+
+  // Per-thread result buffers, sized for the largest workload
+  auto dense_scan_cells = (uint64_t)(dense_scan_size * dense_scan_size);
+  std::vector<int> cells(dense_scan_cells);
+  std::vector<int> values(16384);
+  std::vector<int64_t> coords(2 * 16384);
+
+  std::mt19937_64 rng(0xDEADBEEF + (uint64_t)state.thread_index);
+  std::vector<double> latencies;
+  uint64_t op = (uint64_t)state.thread_index;
+
+  for (auto _ : state) {
+    // Pick a random position for the current workload
+    int64_t subarray[4];
+    bool ok = true;
+    auto t0 = std::chrono::steady_clock::now();
+    switch (op++ % 4) {
+      case 0: {  // Dense point lookup
+        auto r = (int64_t)(rng() % (uint64_t)dense_domain_size) + 1;
+        auto c = (int64_t)(rng() % (uint64_t)dense_domain_size) + 1;
+        subarray[0] = subarray[1] = r;
+        subarray[2] = subarray[3] = c;
+        ok = dense_read(subarray, &cells);
+        break;
+      }
+      case 1: {  // Dense subarray scan
+        auto range = (uint64_t)(dense_domain_size - dense_scan_size);
+        auto r = (int64_t)(rng() % range) + 1;
+        auto c = (int64_t)(rng() % range) + 1;
+        subarray[0] = r;
+        subarray[1] = r + dense_scan_size - 1;
+        subarray[2] = c;
+        subarray[3] = c + dense_scan_size - 1;
+        ok = dense_read(subarray, &cells);
+        break;
+      }
+      case 2: {  // Sparse point lookup (a tile-sized probe)
+        auto range = (uint64_t)(sparse_domain_size - 1000);
+        auto r = (int64_t)(rng() % range) + 1;
+        auto c = (int64_t)(rng() % range) + 1;
+        subarray[0] = r;
+        subarray[1] = r + 999;
+        subarray[2] = c;
+        subarray[3] = c + 999;
+        ok = sparse_read(subarray, &values, &coords);
+        break;
+      }
+      default: {  // Sparse subarray scan
+        auto range = (uint64_t)(sparse_domain_size - sparse_scan_size);
+        auto r = (int64_t)(rng() % range) + 1;
+        auto c = (int64_t)(rng() % range) + 1;
+        subarray[0] = r;
+        subarray[1] = r + sparse_scan_size - 1;
+        subarray[2] = c;
+        subarray[3] = c + sparse_scan_size - 1;
+        ok = sparse_read(subarray, &values, &coords);
+        break;
+      }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    if (!ok) {
+      state.SkipWithError("query submission failed");
+      break;
+    }
+    latencies.push_back(
+        std::chrono::duration<double, std::micro>(t1 - t0).count());
+  }
+
+  // Aggregate throughput across threads, latency percentiles averaged
+  // over the per-thread distributions
+  state.SetItemsProcessed(state.iterations());
+  state.counters["lat_p50_us"] = benchmark::Counter(
+      percentile(&latencies, 0.50), benchmark::Counter::kAvgThreads);
+  state.counters["lat_p99_us"] = benchmark::Counter(
+      percentile(&latencies, 0.99), benchmark::Counter::kAvgThreads);
+}
+
+BENCHMARK(BM_ConcurrentMixedReads)
+    ->ThreadRange(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
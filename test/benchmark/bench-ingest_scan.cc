@@ -0,0 +1,481 @@
+/**
+ * @file bench-ingest_scan.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * End-to-end ingest/scan benchmarks on synthetic dense and sparse arrays,
+ * driven through the C API so that the full write path (`WriteState`) and
+ * read path (`Query::dense_read`/`sparse_read`) are exercised. The
+ * benchmarks are parameterized over the domain size, the number of
+ * fragments and `sm.max_parallel_ops` (the storage manager thread pool
+ * size). Arrays are created under `tiledb_bench/` in the current working
+ * directory.
+ */
+
+#ifdef _WIN32
+#include "tiledb/sm/filesystem/win_filesystem.h"
+#else
+#include "tiledb/sm/filesystem/posix_filesystem.h"
+#endif
+#include "tiledb/sm/c_api/tiledb.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* attr_name = "a";
+
+#ifdef _WIN32
+const std::string bench_temp_dir =
+    tiledb::sm::win::current_dir() + "\\tiledb_bench\\";
+#else
+const std::string bench_temp_dir =
+    tiledb::sm::posix::current_dir() + "/tiledb_bench/";
+#endif
+
+/** Creates a context whose compute thread pool has `max_parallel_ops`. */
+bool create_ctx(uint64_t max_parallel_ops, tiledb_ctx_t** ctx) {
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  if (tiledb_config_create(&config, &error) != TILEDB_OK)
+    return false;
+  auto ops_str = std::to_string(max_parallel_ops);
+  if (tiledb_config_set(
+          config, "sm.max_parallel_ops", ops_str.c_str(), &error) !=
+      TILEDB_OK) {
+    tiledb_config_free(&config);
+    return false;
+  }
+  int rc = tiledb_ctx_create(ctx, config);
+  tiledb_config_free(&config);
+  return rc == TILEDB_OK;
+}
+
+/** Removes (if existent) and re-creates the benchmark temp directory. */
+bool reset_temp_dir(tiledb_ctx_t* ctx) {
+  tiledb_vfs_t* vfs = nullptr;
+  if (tiledb_vfs_create(ctx, &vfs, nullptr) != TILEDB_OK)
+    return false;
+  int is_dir = 0;
+  bool ok = tiledb_vfs_is_dir(ctx, vfs, bench_temp_dir.c_str(), &is_dir) ==
+            TILEDB_OK;
+  if (ok && is_dir)
+    ok = tiledb_vfs_remove_dir(ctx, vfs, bench_temp_dir.c_str()) == TILEDB_OK;
+  if (ok)
+    ok = tiledb_vfs_create_dir(ctx, vfs, bench_temp_dir.c_str()) == TILEDB_OK;
+  tiledb_vfs_free(ctx, &vfs);
+  return ok;
+}
+
+/** Creates a 2D array with `int64` dimensions and a single `int32` attribute.
+ */
+bool create_array_2D(
+    tiledb_ctx_t* ctx,
+    const std::string& array_name,
+    tiledb_array_type_t array_type,
+    int64_t domain_size,
+    int64_t tile_extent,
+    uint64_t capacity) {
+  tiledb_attribute_t* a = nullptr;
+  if (tiledb_attribute_create(ctx, &a, attr_name, TILEDB_INT32) != TILEDB_OK)
+    return false;
+
+  int64_t dim_domain[] = {1, domain_size, 1, domain_size};
+  tiledb_dimension_t* d1 = nullptr;
+  tiledb_dimension_t* d2 = nullptr;
+  if (tiledb_dimension_create(
+          ctx, &d1, "d1", TILEDB_INT64, &dim_domain[0], &tile_extent) !=
+          TILEDB_OK ||
+      tiledb_dimension_create(
+          ctx, &d2, "d2", TILEDB_INT64, &dim_domain[2], &tile_extent) !=
+          TILEDB_OK)
+    return false;
+
+  tiledb_domain_t* domain = nullptr;
+  if (tiledb_domain_create(ctx, &domain) != TILEDB_OK ||
+      tiledb_domain_add_dimension(ctx, domain, d1) != TILEDB_OK ||
+      tiledb_domain_add_dimension(ctx, domain, d2) != TILEDB_OK)
+    return false;
+
+  tiledb_array_schema_t* array_schema = nullptr;
+  bool ok = tiledb_array_schema_create(ctx, &array_schema, array_type) ==
+                TILEDB_OK &&
+            tiledb_array_schema_set_capacity(ctx, array_schema, capacity) ==
+                TILEDB_OK &&
+            tiledb_array_schema_add_attribute(ctx, array_schema, a) ==
+                TILEDB_OK &&
+            tiledb_array_schema_set_domain(ctx, array_schema, domain) ==
+                TILEDB_OK &&
+            tiledb_array_create(ctx, array_name.c_str(), array_schema) ==
+                TILEDB_OK;
+
+  tiledb_attribute_free(ctx, &a);
+  tiledb_dimension_free(ctx, &d1);
+  tiledb_dimension_free(ctx, &d2);
+  tiledb_domain_free(ctx, &domain);
+  if (array_schema != nullptr)
+    tiledb_array_schema_free(ctx, &array_schema);
+
+  return ok;
+}
+
+/** Writes the full 2D domain in row-major order, creating one fragment. */
+bool write_dense_fragment(
+    tiledb_ctx_t* ctx,
+    const std::string& array_name,
+    int64_t domain_size,
+    std::vector<int>* cells) {
+  const int64_t subarray[] = {1, domain_size, 1, domain_size};
+  const char* attributes[] = {attr_name};
+  void* buffers[] = {&(*cells)[0]};
+  uint64_t buffer_sizes[] = {cells->size() * sizeof(int)};
+
+  tiledb_query_t* query = nullptr;
+  bool ok =
+      tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE) ==
+          TILEDB_OK &&
+      tiledb_query_set_buffers(
+          ctx, query, attributes, 1, buffers, buffer_sizes) == TILEDB_OK &&
+      tiledb_query_set_subarray(ctx, query, subarray) == TILEDB_OK &&
+      tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR) == TILEDB_OK &&
+      tiledb_query_submit(ctx, query) == TILEDB_OK &&
+      tiledb_query_finalize(ctx, query) == TILEDB_OK;
+  if (query != nullptr)
+    tiledb_query_free(ctx, &query);
+  return ok;
+}
+
+/** Reads the full 2D domain in row-major order. */
+bool read_dense_array(
+    tiledb_ctx_t* ctx,
+    const std::string& array_name,
+    int64_t domain_size,
+    std::vector<int>* cells) {
+  const int64_t subarray[] = {1, domain_size, 1, domain_size};
+  const char* attributes[] = {attr_name};
+  void* buffers[] = {&(*cells)[0]};
+  uint64_t buffer_sizes[] = {cells->size() * sizeof(int)};
+
+  tiledb_query_t* query = nullptr;
+  bool ok = tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_READ) ==
+                TILEDB_OK &&
+            tiledb_query_set_buffers(
+                ctx, query, attributes, 1, buffers, buffer_sizes) ==
+                TILEDB_OK &&
+            tiledb_query_set_subarray(ctx, query, subarray) == TILEDB_OK &&
+            tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR) ==
+                TILEDB_OK &&
+            tiledb_query_submit(ctx, query) == TILEDB_OK &&
+            tiledb_query_finalize(ctx, query) == TILEDB_OK;
+  if (query != nullptr)
+    tiledb_query_free(ctx, &query);
+  return ok;
+}
+
+/** Writes `cell_num` random sparse cells in unordered layout. */
+bool write_sparse_fragment(
+    tiledb_ctx_t* ctx,
+    const std::string& array_name,
+    std::vector<int>* values,
+    std::vector<int64_t>* coords) {
+  const char* attributes[] = {attr_name, TILEDB_COORDS};
+  void* buffers[] = {&(*values)[0], &(*coords)[0]};
+  uint64_t buffer_sizes[] = {values->size() * sizeof(int),
+                             coords->size() * sizeof(int64_t)};
+
+  tiledb_query_t* query = nullptr;
+  bool ok =
+      tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE) ==
+          TILEDB_OK &&
+      tiledb_query_set_buffers(
+          ctx, query, attributes, 2, buffers, buffer_sizes) == TILEDB_OK &&
+      tiledb_query_set_layout(ctx, query, TILEDB_UNORDERED) == TILEDB_OK &&
+      tiledb_query_submit(ctx, query) == TILEDB_OK &&
+      tiledb_query_finalize(ctx, query) == TILEDB_OK;
+  if (query != nullptr)
+    tiledb_query_free(ctx, &query);
+  return ok;
+}
+
+/** Reads all sparse cells in the full 2D domain in global order. */
+bool read_sparse_array(
+    tiledb_ctx_t* ctx,
+    const std::string& array_name,
+    int64_t domain_size,
+    std::vector<int>* values,
+    std::vector<int64_t>* coords) {
+  const int64_t subarray[] = {1, domain_size, 1, domain_size};
+  const char* attributes[] = {attr_name, TILEDB_COORDS};
+  void* buffers[] = {&(*values)[0], &(*coords)[0]};
+  uint64_t buffer_sizes[] = {values->size() * sizeof(int),
+                             coords->size() * sizeof(int64_t)};
+
+  tiledb_query_t* query = nullptr;
+  bool ok = tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_READ) ==
+                TILEDB_OK &&
+            tiledb_query_set_buffers(
+                ctx, query, attributes, 2, buffers, buffer_sizes) ==
+                TILEDB_OK &&
+            tiledb_query_set_subarray(ctx, query, subarray) == TILEDB_OK &&
+            tiledb_query_set_layout(ctx, query, TILEDB_GLOBAL_ORDER) ==
+                TILEDB_OK &&
+            tiledb_query_submit(ctx, query) == TILEDB_OK &&
+            tiledb_query_finalize(ctx, query) == TILEDB_OK;
+  if (query != nullptr)
+    tiledb_query_free(ctx, &query);
+  return ok;
+}
+
+/** Generates `cell_num` random coordinates in the 2D domain. */
+void generate_sparse_coords(
+    int64_t domain_size, uint64_t cell_num, std::vector<int64_t>* coords) {
+  std::mt19937_64 rng(0xBADC0FFE);
+  coords->resize(2 * cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    (*coords)[2 * i] = (int64_t)(rng() % (uint64_t)domain_size) + 1;
+    (*coords)[2 * i + 1] = (int64_t)(rng() % (uint64_t)domain_size) + 1;
+  }
+}
+
+}  // namespace
+
+/* ********************************* */
+/*           Dense ingest            */
+/* ********************************* */
+
+// Args: {domain size, sm.max_parallel_ops}
+static void BM_DenseIngest(benchmark::State& state) {
+  auto domain_size = (int64_t)state.range(0);
+  auto parallel_ops = (uint64_t)state.range(1);
+  auto cell_num = (uint64_t)(domain_size * domain_size);
+
+  tiledb_ctx_t* ctx = nullptr;
+  if (!create_ctx(parallel_ops, &ctx) || !reset_temp_dir(ctx)) {
+    state.SkipWithError("benchmark setup failed");
+    return;
+  }
+  std::vector<int> cells(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    cells[i] = (int)i;
+
+  auto array_name = bench_temp_dir + "dense_ingest";
+  for (auto _ : state) {
+    state.PauseTiming();
+    reset_temp_dir(ctx);
+    if (!create_array_2D(
+            ctx, array_name, TILEDB_DENSE, domain_size, domain_size / 10,
+            10000)) {
+      state.SkipWithError("array creation failed");
+      break;
+    }
+    state.ResumeTiming();
+    if (!write_dense_fragment(ctx, array_name, domain_size, &cells)) {
+      state.SkipWithError("dense write failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * cell_num * sizeof(int));
+
+  reset_temp_dir(ctx);
+  tiledb_ctx_free(&ctx);
+}
+
+BENCHMARK(BM_DenseIngest)
+    ->Args({1000, 1})
+    ->Args({1000, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/* ********************************* */
+/*            Dense scan             */
+/* ********************************* */
+
+// Args: {domain size, fragment num, sm.max_parallel_ops}
+static void BM_DenseScan(benchmark::State& state) {
+  auto domain_size = (int64_t)state.range(0);
+  auto fragment_num = (uint64_t)state.range(1);
+  auto parallel_ops = (uint64_t)state.range(2);
+  auto cell_num = (uint64_t)(domain_size * domain_size);
+
+  tiledb_ctx_t* ctx = nullptr;
+  if (!create_ctx(parallel_ops, &ctx) || !reset_temp_dir(ctx)) {
+    state.SkipWithError("benchmark setup failed");
+    return;
+  }
+
+  // Ingest `fragment_num` full-domain fragments.
+  auto array_name = bench_temp_dir + "dense_scan";
+  std::vector<int> cells(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    cells[i] = (int)i;
+  bool ok = create_array_2D(
+      ctx, array_name, TILEDB_DENSE, domain_size, domain_size / 10, 10000);
+  for (uint64_t f = 0; ok && f < fragment_num; ++f)
+    ok = write_dense_fragment(ctx, array_name, domain_size, &cells);
+  if (!ok) {
+    state.SkipWithError("benchmark setup failed");
+    tiledb_ctx_free(&ctx);
+    return;
+  }
+
+  for (auto _ : state) {
+    if (!read_dense_array(ctx, array_name, domain_size, &cells)) {
+      state.SkipWithError("dense read failed");
+      break;
+    }
+    benchmark::DoNotOptimize(cells.data());
+  }
+  state.SetBytesProcessed(state.iterations() * cell_num * sizeof(int));
+
+  reset_temp_dir(ctx);
+  tiledb_ctx_free(&ctx);
+}
+
+BENCHMARK(BM_DenseScan)
+    ->Args({1000, 1, 1})
+    ->Args({1000, 1, 4})
+    ->Args({1000, 4, 1})
+    ->Args({1000, 4, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/* ********************************* */
+/*           Sparse ingest           */
+/* ********************************* */
+
+// Args: {cell num, sm.max_parallel_ops}
+static void BM_SparseIngest(benchmark::State& state) {
+  auto cell_num = (uint64_t)state.range(0);
+  auto parallel_ops = (uint64_t)state.range(1);
+  const int64_t domain_size = 1000000;
+
+  tiledb_ctx_t* ctx = nullptr;
+  if (!create_ctx(parallel_ops, &ctx) || !reset_temp_dir(ctx)) {
+    state.SkipWithError("benchmark setup failed");
+    return;
+  }
+  std::vector<int> values(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    values[i] = (int)i;
+  std::vector<int64_t> coords;
+  generate_sparse_coords(domain_size, cell_num, &coords);
+
+  auto array_name = bench_temp_dir + "sparse_ingest";
+  for (auto _ : state) {
+    state.PauseTiming();
+    reset_temp_dir(ctx);
+    if (!create_array_2D(
+            ctx, array_name, TILEDB_SPARSE, domain_size, domain_size / 10,
+            10000)) {
+      state.SkipWithError("array creation failed");
+      break;
+    }
+    state.ResumeTiming();
+    if (!write_sparse_fragment(ctx, array_name, &values, &coords)) {
+      state.SkipWithError("sparse write failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(
+      state.iterations() * cell_num * (sizeof(int) + 2 * sizeof(int64_t)));
+
+  reset_temp_dir(ctx);
+  tiledb_ctx_free(&ctx);
+}
+
+BENCHMARK(BM_SparseIngest)
+    ->Args({1 << 20, 1})
+    ->Args({1 << 20, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/* ********************************* */
+/*            Sparse scan            */
+/* ********************************* */
+
+// Args: {cell num per fragment, fragment num, sm.max_parallel_ops}
+static void BM_SparseScan(benchmark::State& state) {
+  auto cell_num = (uint64_t)state.range(0);
+  auto fragment_num = (uint64_t)state.range(1);
+  auto parallel_ops = (uint64_t)state.range(2);
+  const int64_t domain_size = 1000000;
+
+  tiledb_ctx_t* ctx = nullptr;
+  if (!create_ctx(parallel_ops, &ctx) || !reset_temp_dir(ctx)) {
+    state.SkipWithError("benchmark setup failed");
+    return;
+  }
+
+  // Ingest `fragment_num` fragments with different random coordinates.
+  auto array_name = bench_temp_dir + "sparse_scan";
+  std::vector<int> values(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    values[i] = (int)i;
+  bool ok = create_array_2D(
+      ctx, array_name, TILEDB_SPARSE, domain_size, domain_size / 10, 10000);
+  for (uint64_t f = 0; ok && f < fragment_num; ++f) {
+    std::vector<int64_t> coords;
+    generate_sparse_coords(domain_size, cell_num, &coords);
+    ok = write_sparse_fragment(ctx, array_name, &values, &coords);
+  }
+  if (!ok) {
+    state.SkipWithError("benchmark setup failed");
+    tiledb_ctx_free(&ctx);
+    return;
+  }
+
+  // The result buffers must fit all fragments, as coordinates rarely collide.
+  std::vector<int> read_values(fragment_num * cell_num);
+  std::vector<int64_t> read_coords(2 * fragment_num * cell_num);
+  for (auto _ : state) {
+    if (!read_sparse_array(
+            ctx, array_name, domain_size, &read_values, &read_coords)) {
+      state.SkipWithError("sparse read failed");
+      break;
+    }
+    benchmark::DoNotOptimize(read_values.data());
+  }
+  state.SetBytesProcessed(
+      state.iterations() * fragment_num * cell_num *
+      (sizeof(int) + 2 * sizeof(int64_t)));
+
+  reset_temp_dir(ctx);
+  tiledb_ctx_free(&ctx);
+}
+
+BENCHMARK(BM_SparseScan)
+    ->Args({1 << 20, 1, 1})
+    ->Args({1 << 20, 1, 4})
+    ->Args({1 << 20, 4, 1})
+    ->Args({1 << 20, 4, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,313 @@
+/**
+ * @file tiledb_benchmarks.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Microbenchmarks for the hot core kernels. Run with
+ * `--benchmark_format=json --benchmark_out=<file>` to produce
+ * machine-readable results that can be diffed across releases.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/compressors/blosc_compressor.h"
+#include "tiledb/sm/compressors/bzip_compressor.h"
+#include "tiledb/sm/compressors/dd_compressor.h"
+#include "tiledb/sm/compressors/gzip_compressor.h"
+#include "tiledb/sm/compressors/lz4_compressor.h"
+#include "tiledb/sm/compressors/rle_compressor.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/misc/radix_sort.h"
+#include "tiledb/sm/misc/thread_pool.h"
+
+using namespace tiledb::sm;
+
+/* ********************************* */
+/*       Domain::get_cell_pos        */
+/* ********************************* */
+
+static void BM_DomainGetCellPos(benchmark::State& state) {
+  // 2D dense domain [1,1000]x[1,1000] with 100x100 tiles.
+  uint64_t dim_domain[] = {1, 1000};
+  uint64_t tile_extent = 100;
+  Dimension d1("d1", Datatype::UINT64);
+  d1.set_domain(dim_domain);
+  d1.set_tile_extent(&tile_extent);
+  Dimension d2("d2", Datatype::UINT64);
+  d2.set_domain(dim_domain);
+  d2.set_tile_extent(&tile_extent);
+  Domain domain(Datatype::UINT64);
+  domain.add_dimension(&d1);
+  domain.add_dimension(&d2);
+  domain.init(Layout::ROW_MAJOR, Layout::ROW_MAJOR);
+
+  uint64_t coords[] = {1, 1};
+  uint64_t pos = 0;
+  for (auto _ : state) {
+    // Walk the cells of a single tile.
+    coords[1]++;
+    if (coords[1] > tile_extent) {
+      coords[1] = 1;
+      coords[0] = (coords[0] % tile_extent) + 1;
+    }
+    if (!domain.get_cell_pos(coords, &pos).ok())
+      state.SkipWithError("get_cell_pos failed");
+    benchmark::DoNotOptimize(pos);
+  }
+}
+
+BENCHMARK(BM_DomainGetCellPos);
+
+/* ********************************* */
+/*            Coords sort            */
+/* ********************************* */
+
+// The comparator-based and key-based sort paths of `Query::sort_coords`
+// both reduce to sorting (key, value) pairs; benchmark the two sort
+// kernels directly on random 64-bit keys.
+
+static void fill_random_pairs(
+    std::vector<std::pair<uint64_t, uint64_t>>* pairs, uint64_t num) {
+  std::mt19937_64 rng(0xDEADBEEF);
+  pairs->resize(num);
+  for (uint64_t i = 0; i < num; ++i)
+    (*pairs)[i] = std::make_pair(rng(), i);
+}
+
+static void BM_SortCoordsStdSort(benchmark::State& state) {
+  auto num = (uint64_t)state.range(0);
+  std::vector<std::pair<uint64_t, uint64_t>> pairs;
+  fill_random_pairs(&pairs, num);
+  std::vector<std::pair<uint64_t, uint64_t>> sorted;
+  for (auto _ : state) {
+    state.PauseTiming();
+    sorted = pairs;
+    state.ResumeTiming();
+    std::sort(sorted.begin(), sorted.end());
+    benchmark::DoNotOptimize(sorted.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+
+BENCHMARK(BM_SortCoordsStdSort)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_SortCoordsRadix(benchmark::State& state) {
+  auto num = (uint64_t)state.range(0);
+  ThreadPool pool(std::thread::hardware_concurrency());
+  std::vector<std::pair<uint64_t, uint64_t>> pairs;
+  fill_random_pairs(&pairs, num);
+  std::vector<std::pair<uint64_t, uint64_t>> sorted;
+  for (auto _ : state) {
+    state.PauseTiming();
+    sorted = pairs;
+    state.ResumeTiming();
+    radix_sort::sort_pairs(&pool, &sorted);
+    benchmark::DoNotOptimize(sorted.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num);
+}
+
+BENCHMARK(BM_SortCoordsRadix)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+
+/* ********************************* */
+/*         Tile compression          */
+/* ********************************* */
+
+// Fill a tile-sized input with a mildly noisy ramp, which is representative
+// of real coordinate/offset tiles: compressible, but not trivially so.
+static void fill_compressible(std::vector<uint64_t>* values) {
+  std::mt19937_64 rng(0xCAFEBABE);
+  for (uint64_t i = 0; i < values->size(); ++i)
+    (*values)[i] = 10 * i + (rng() % 10);
+}
+
+// One tile of 64K uint64 cells.
+static const uint64_t bench_tile_cells = 64 * 1024;
+
+typedef Status (*compress_func_t)(ConstBuffer*, Buffer*);
+
+static void benchmark_compressor(
+    benchmark::State& state, compress_func_t compress) {
+  std::vector<uint64_t> values(bench_tile_cells);
+  fill_compressible(&values);
+  auto nbytes = bench_tile_cells * sizeof(uint64_t);
+  Buffer out;
+  for (auto _ : state) {
+    ConstBuffer in(&values[0], nbytes);
+    out.reset_offset();
+    out.reset_size();
+    if (!compress(&in, &out).ok())
+      state.SkipWithError("compression failed");
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * nbytes);
+}
+
+static Status compress_gzip(ConstBuffer* in, Buffer* out) {
+  return GZip::compress(GZip::default_level(), in, out);
+}
+
+static Status compress_zstd(ConstBuffer* in, Buffer* out) {
+  return ZStd::compress(ZStd::default_level(), in, out);
+}
+
+static Status compress_lz4(ConstBuffer* in, Buffer* out) {
+  return LZ4::compress(LZ4::default_level(), in, out);
+}
+
+static Status compress_bzip(ConstBuffer* in, Buffer* out) {
+  return BZip::compress(BZip::default_level(), in, out);
+}
+
+static Status compress_blosc(ConstBuffer* in, Buffer* out) {
+  return Blosc::compress(
+      "blosclz", sizeof(uint64_t), Blosc::default_level(), in, out);
+}
+
+static Status compress_rle(ConstBuffer* in, Buffer* out) {
+  return RLE::compress(sizeof(uint64_t), in, out);
+}
+
+static Status compress_dd(ConstBuffer* in, Buffer* out) {
+  return DoubleDelta::compress(Datatype::UINT64, in, out);
+}
+
+static void BM_CompressTileGZip(benchmark::State& state) {
+  benchmark_compressor(state, compress_gzip);
+}
+
+static void BM_CompressTileZStd(benchmark::State& state) {
+  benchmark_compressor(state, compress_zstd);
+}
+
+static void BM_CompressTileLZ4(benchmark::State& state) {
+  benchmark_compressor(state, compress_lz4);
+}
+
+static void BM_CompressTileBZip(benchmark::State& state) {
+  benchmark_compressor(state, compress_bzip);
+}
+
+static void BM_CompressTileBlosc(benchmark::State& state) {
+  benchmark_compressor(state, compress_blosc);
+}
+
+static void BM_CompressTileRLE(benchmark::State& state) {
+  benchmark_compressor(state, compress_rle);
+}
+
+static void BM_CompressTileDoubleDelta(benchmark::State& state) {
+  benchmark_compressor(state, compress_dd);
+}
+
+BENCHMARK(BM_CompressTileGZip);
+BENCHMARK(BM_CompressTileZStd);
+BENCHMARK(BM_CompressTileLZ4);
+BENCHMARK(BM_CompressTileBZip);
+BENCHMARK(BM_CompressTileBlosc);
+BENCHMARK(BM_CompressTileRLE);
+BENCHMARK(BM_CompressTileDoubleDelta);
+
+/* ********************************* */
+/*           LRUCache::read          */
+/* ********************************* */
+
+static const uint64_t lru_object_num = 1024;
+static const uint64_t lru_object_size = 4096;
+
+// The cache is shared across all benchmark threads, so that the reads
+// contend on the cache mutex like concurrent queries do.
+static LRUCache* lru_bench_cache() {
+  static LRUCache* cache = []() {
+    auto c = new LRUCache(lru_object_num * lru_object_size);
+    for (uint64_t i = 0; i < lru_object_num; ++i) {
+      auto object = std::malloc(lru_object_size);
+      std::memset(object, (int)(i & 0xFF), lru_object_size);
+      c->insert(std::to_string(i), object, lru_object_size);
+    }
+    return c;
+  }();
+  return cache;
+}
+
+static void BM_LRUCacheRead(benchmark::State& state) {
+  auto cache = lru_bench_cache();
+  char buffer[lru_object_size];
+  // Each thread walks the keys with a different prime stride.
+  uint64_t i = (uint64_t)state.thread_index * 7919;
+  for (auto _ : state) {
+    bool success = false;
+    auto key = std::to_string(i % lru_object_num);
+    if (!cache->read(key, buffer, 0, lru_object_size, &success).ok() ||
+        !success)
+      state.SkipWithError("cache read failed");
+    benchmark::DoNotOptimize(buffer);
+    i += 7919;
+  }
+  state.SetBytesProcessed(state.iterations() * lru_object_size);
+}
+
+BENCHMARK(BM_LRUCacheRead)->ThreadRange(1, 8)->UseRealTime();
+
+/* ********************************* */
+/*           Buffer::write           */
+/* ********************************* */
+
+static void BM_BufferWriteGrowth(benchmark::State& state) {
+  const uint64_t chunk_size = 1024;
+  std::vector<char> chunk(chunk_size, 0x5A);
+  auto total = (uint64_t)state.range(0);
+  for (auto _ : state) {
+    // A fresh buffer each time, so that every iteration pays the full
+    // sequence of reallocations while the buffer grows to `total` bytes.
+    Buffer buff;
+    for (uint64_t written = 0; written < total; written += chunk_size) {
+      if (!buff.write(&chunk[0], chunk_size).ok())
+        state.SkipWithError("buffer write failed");
+    }
+    benchmark::DoNotOptimize(buff.data());
+  }
+  state.SetBytesProcessed(state.iterations() * total);
+}
+
+BENCHMARK(BM_BufferWriteGrowth)->Range(64 * 1024, 16 * 1024 * 1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+/**
+ * @file unit-arena.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests for class Arena.
+ */
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/arena.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("Arena: Test basic allocation", "[arena]") {
+  Arena arena;
+
+  // Many small allocations, all aligned and usable
+  std::vector<char*> ptrs;
+  for (int i = 0; i < 1000; ++i) {
+    auto p = (char*)arena.allocate(24);
+    REQUIRE(p != nullptr);
+    CHECK(((uintptr_t)p % 16) == 0);
+    std::memset(p, i % 256, 24);
+    ptrs.push_back(p);
+  }
+  for (int i = 0; i < 1000; ++i)
+    CHECK(ptrs[i][0] == (char)(i % 256));
+
+  // Clearing frees everything in one shot
+  CHECK(arena.size() > 0);
+  arena.clear();
+  CHECK(arena.size() == 0);
+
+  // The arena is reusable after clearing
+  CHECK(arena.allocate(100) != nullptr);
+}
+
+TEST_CASE("Arena: Test oversized allocations", "[arena]") {
+  Arena arena(1024);
+
+  // Larger than the block size - served by a dedicated block
+  auto big = (char*)arena.allocate(10000);
+  REQUIRE(big != nullptr);
+  std::memset(big, 1, 10000);
+
+  // Small allocations still work alongside
+  auto small = (char*)arena.allocate(8);
+  REQUIRE(small != nullptr);
+  std::memset(small, 2, 8);
+  CHECK(big[9999] == 1);
+}
+
+TEST_CASE("Arena: Test STL allocator adapter", "[arena]") {
+  Arena arena;
+
+  // Vector drawing from the arena
+  std::vector<uint64_t, ArenaAllocator<uint64_t>> v(
+      (ArenaAllocator<uint64_t>(&arena)));
+  for (uint64_t i = 0; i < 10000; ++i)
+    v.push_back(i);
+  for (uint64_t i = 0; i < 10000; ++i)
+    CHECK(v[i] == i);
+
+  // allocate_shared drawing from the arena
+  auto sp = std::allocate_shared<uint64_t>(ArenaAllocator<uint64_t>(&arena), 5);
+  CHECK(*sp == 5);
+  CHECK(arena.size() > 0);
+}
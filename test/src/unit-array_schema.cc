@@ -0,0 +1,173 @@
+/**
+ * @file unit-array_schema.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class ArraySchema (de)serialization.
+ */
+
+#include <cstring>
+
+#include "catch.hpp"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+
+using namespace tiledb::sm;
+
+namespace {
+
+/**
+ * Writes an attribute to `buff` in the pre-1.3.1 layout, which lacks
+ * the trailing shuffle, dict_encode and offsets_32 flag bytes.
+ */
+void write_old_attribute(
+    Buffer* buff,
+    const std::string& name,
+    Datatype type,
+    Compressor compressor,
+    int compression_level,
+    unsigned int cell_val_num) {
+  auto name_size = (unsigned int)name.size();
+  REQUIRE(buff->write(&name_size, sizeof(unsigned int)).ok());
+  REQUIRE(buff->write(name.c_str(), name_size).ok());
+  auto type_c = (char)type;
+  REQUIRE(buff->write(&type_c, sizeof(char)).ok());
+  auto compressor_c = (char)compressor;
+  REQUIRE(buff->write(&compressor_c, sizeof(char)).ok());
+  REQUIRE(buff->write(&compression_level, sizeof(int)).ok());
+  REQUIRE(buff->write(&cell_val_num, sizeof(unsigned int)).ok());
+}
+
+}  // namespace
+
+TEST_CASE(
+    "ArraySchema: Test deserialization of pre-1.3.1 schemas",
+    "[array_schema]") {
+  // Construct a schema buffer in the layout written by version 1.3.0,
+  // which predates the per-attribute flag bytes (shuffle, dict_encode,
+  // offsets_32) and the trailing key-value hash byte
+  Buffer buff;
+  int version[3] = {1, 3, 0};
+  REQUIRE(buff.write(version, sizeof(version)).ok());
+  auto array_type = (char)ArrayType::DENSE;
+  REQUIRE(buff.write(&array_type, sizeof(char)).ok());
+  auto tile_order = (char)Layout::ROW_MAJOR;
+  REQUIRE(buff.write(&tile_order, sizeof(char)).ok());
+  auto cell_order = (char)Layout::ROW_MAJOR;
+  REQUIRE(buff.write(&cell_order, sizeof(char)).ok());
+  uint64_t capacity = 10000;
+  REQUIRE(buff.write(&capacity, sizeof(uint64_t)).ok());
+  auto coords_compressor = (char)Compressor::ZSTD;
+  int coords_compression_level = -1;
+  REQUIRE(buff.write(&coords_compressor, sizeof(char)).ok());
+  REQUIRE(buff.write(&coords_compression_level, sizeof(int)).ok());
+  auto offsets_compressor = (char)Compressor::ZSTD;
+  int offsets_compression_level = -1;
+  REQUIRE(buff.write(&offsets_compressor, sizeof(char)).ok());
+  REQUIRE(buff.write(&offsets_compression_level, sizeof(int)).ok());
+
+  // The domain layout is unchanged, so serialize it with the current code
+  Dimension dim("d1", Datatype::INT64);
+  int64_t dim_domain[] = {1, 100};
+  int64_t tile_extent = 10;
+  REQUIRE(dim.set_domain(dim_domain).ok());
+  REQUIRE(dim.set_tile_extent(&tile_extent).ok());
+  Domain domain(Datatype::INT64);
+  REQUIRE(domain.add_dimension(&dim).ok());
+  REQUIRE(domain.serialize(&buff).ok());
+
+  // Two attributes in the old layout; with unconditional flag reads,
+  // deserializing the first attribute would consume the name length of
+  // the second and corrupt the rest of the parse
+  unsigned int attribute_num = 2;
+  REQUIRE(buff.write(&attribute_num, sizeof(unsigned int)).ok());
+  write_old_attribute(&buff, "a1", Datatype::INT32, Compressor::GZIP, -1, 1);
+  write_old_attribute(
+      &buff, "a2", Datatype::FLOAT64, Compressor::NO_COMPRESSION, -1, 2);
+
+  // Deserialize and verify every attribute field, with the absent
+  // flags defaulting to `false` and the absent hash to MD5
+  ConstBuffer cbuff(buff.data(), buff.size());
+  ArraySchema schema;
+  REQUIRE(schema.deserialize(&cbuff, false).ok());
+  CHECK(schema.array_type() == ArrayType::DENSE);
+  CHECK(schema.capacity() == 10000);
+  REQUIRE(schema.attribute_num() == 2);
+  auto a1 = schema.attribute((unsigned int)0);
+  REQUIRE(a1 != nullptr);
+  CHECK(a1->name() == "a1");
+  CHECK(a1->type() == Datatype::INT32);
+  CHECK(a1->compressor() == Compressor::GZIP);
+  CHECK(a1->cell_val_num() == 1);
+  CHECK(!a1->shuffle());
+  CHECK(!a1->dict_encode());
+  CHECK(!a1->offsets_32());
+  auto a2 = schema.attribute(1);
+  REQUIRE(a2 != nullptr);
+  CHECK(a2->name() == "a2");
+  CHECK(a2->type() == Datatype::FLOAT64);
+  CHECK(a2->compressor() == Compressor::NO_COMPRESSION);
+  CHECK(a2->cell_val_num() == 2);
+  CHECK(!a2->shuffle());
+  CHECK(!a2->dict_encode());
+  CHECK(!a2->offsets_32());
+  CHECK(schema.kv_hash() == KVHash::MD5);
+}
+
+TEST_CASE(
+    "ArraySchema: Test attribute flag round-trip", "[array_schema]") {
+  // A schema serialized by the current version carries the attribute
+  // flags and must preserve them across a (de)serialization round-trip
+  Dimension dim("d1", Datatype::INT64);
+  int64_t dim_domain[] = {1, 100};
+  int64_t tile_extent = 10;
+  REQUIRE(dim.set_domain(dim_domain).ok());
+  REQUIRE(dim.set_tile_extent(&tile_extent).ok());
+  Domain domain(Datatype::INT64);
+  REQUIRE(domain.add_dimension(&dim).ok());
+
+  Attribute attr("a1", Datatype::INT32);
+  attr.set_shuffle(true);
+  attr.set_dict_encode(true);
+
+  ArraySchema schema(ArrayType::DENSE);
+  REQUIRE(schema.set_domain(&domain).ok());
+  REQUIRE(schema.add_attribute(&attr).ok());
+
+  Buffer buff;
+  REQUIRE(schema.serialize(&buff).ok());
+  ConstBuffer cbuff(buff.data(), buff.size());
+  ArraySchema schema2;
+  REQUIRE(schema2.deserialize(&cbuff, false).ok());
+  REQUIRE(schema2.attribute_num() == 1);
+  auto a1 = schema2.attribute((unsigned int)0);
+  REQUIRE(a1 != nullptr);
+  CHECK(a1->shuffle());
+  CHECK(a1->dict_encode());
+  CHECK(!a1->offsets_32());
+}
@@ -34,6 +34,10 @@
 #include <catch.hpp>
 #include "tiledb/sm/buffer/buffer.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 using namespace tiledb::sm;
 
 TEST_CASE("Buffer: Test default constructor with write void*", "[buffer]") {
@@ -74,3 +78,28 @@ TEST_CASE("Buffer: Test default constructor with write void*", "[buffer]") {
 
   delete buff;
 }
+
+TEST_CASE("Buffer: Test disown_data", "[buffer]") {
+  // A small buffer stores its data inline; disowning must migrate it
+  // to the heap so that the new owner can free it with `std::free`
+  Buffer buff;
+  char data[3] = {1, 2, 3};
+  REQUIRE(buff.write(data, sizeof(data)).ok());
+  void* inline_data = buff.data();
+  REQUIRE(buff.disown_data().ok());
+  CHECK(!buff.owns_data());
+  void* heap_data = buff.data();
+  CHECK(heap_data != inline_data);
+  CHECK(!std::memcmp(heap_data, data, sizeof(data)));
+  std::free(heap_data);
+
+  // A heap-backed buffer hands over its allocation as is
+  Buffer big_buff;
+  std::vector<char> big_data(1024, 5);
+  REQUIRE(big_buff.write(&big_data[0], big_data.size()).ok());
+  void* big_ptr = big_buff.data();
+  REQUIRE(big_buff.disown_data().ok());
+  CHECK(!big_buff.owns_data());
+  CHECK(big_buff.data() == big_ptr);
+  std::free(big_ptr);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file unit-buffer_pool.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests for class BufferPool.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/buffer/buffer_pool.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("BufferPool: Test buffer recycling", "[buffer_pool]") {
+  BufferPool pool;
+
+  // Check out a buffer and grow it
+  auto buffer = pool.checkout();
+  REQUIRE(buffer != nullptr);
+  int value = 42;
+  CHECK(buffer->write(&value, sizeof(int)).ok());
+  auto data = buffer->data();
+  auto alloced_size = buffer->alloced_size();
+
+  // Releasing retains the allocation
+  pool.release(buffer);
+  CHECK(pool.size() == alloced_size);
+
+  // The next checkout reuses the same buffer, empty
+  buffer = pool.checkout(sizeof(int));
+  REQUIRE(buffer != nullptr);
+  CHECK(buffer->data() == data);
+  CHECK(buffer->size() == 0);
+  CHECK(buffer->alloced_size() == alloced_size);
+  CHECK(pool.size() == 0);
+  pool.release(buffer);
+}
+
+TEST_CASE("BufferPool: Test capacity", "[buffer_pool]") {
+  BufferPool pool(1024);
+
+  // A release that would exceed the capacity frees the buffer instead
+  auto buffer = pool.checkout();
+  CHECK(buffer->realloc(10000).ok());
+  pool.release(buffer);
+  CHECK(pool.size() == 0);
+
+  // A release within the capacity is retained
+  buffer = pool.checkout();
+  CHECK(buffer->realloc(512).ok());
+  pool.release(buffer);
+  CHECK(pool.size() == 512);
+}
+
+TEST_CASE("BufferPool: Test shared checkout", "[buffer_pool]") {
+  BufferPool pool;
+
+  // The shared pointer releases the buffer back to the pool
+  uint64_t alloced_size = 0;
+  {
+    auto buffer = pool.checkout_shared(100);
+    REQUIRE(buffer != nullptr);
+    CHECK(buffer->realloc(100).ok());
+    alloced_size = buffer->alloced_size();
+  }
+  CHECK(pool.size() == alloced_size);
+}
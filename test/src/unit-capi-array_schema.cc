@@ -878,3 +878,77 @@ TEST_CASE_METHOD(
   rc = tiledb_dimension_free(ctx_, &d1);
   CHECK(rc == TILEDB_OK);
 }
+
+TEST_CASE_METHOD(
+    ArraySchemaFx,
+    "C API: Test array schema with morton cell order",
+    "[capi], [array-schema]") {
+  // Create dimensions
+  tiledb_dimension_t* d1;
+  int rc = tiledb_dimension_create(
+      ctx_, &d1, "d1", TILEDB_INT64, &DIM_DOMAIN[0], &TILE_EXTENTS[0]);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_dimension_t* d2;
+  rc = tiledb_dimension_create(
+      ctx_, &d2, "d2", TILEDB_INT64, &DIM_DOMAIN[2], &TILE_EXTENTS[1]);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Set domain
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(ctx_, domain, d1);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(ctx_, domain, d2);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Set attribute
+  tiledb_attribute_t* attr;
+  rc = tiledb_attribute_create(ctx_, &attr, ATTR_NAME, ATTR_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Morton cell order on a sparse array - ok
+  tiledb_array_schema_t* array_schema;
+  rc = tiledb_array_schema_create(ctx_, &array_schema, TILEDB_SPARSE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_set_domain(ctx_, array_schema, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_add_attribute(ctx_, array_schema, attr);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_set_cell_order(ctx_, array_schema, TILEDB_MORTON);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_check(ctx_, array_schema);
+  CHECK(rc == TILEDB_OK);
+
+  // Morton tile order - error
+  rc = tiledb_array_schema_set_tile_order(ctx_, array_schema, TILEDB_MORTON);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_check(ctx_, array_schema);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_array_schema_free(ctx_, &array_schema);
+  CHECK(rc == TILEDB_OK);
+
+  // Morton cell order on a dense array - error
+  rc = tiledb_array_schema_create(ctx_, &array_schema, TILEDB_DENSE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_set_domain(ctx_, array_schema, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_add_attribute(ctx_, array_schema, attr);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_set_cell_order(ctx_, array_schema, TILEDB_MORTON);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_check(ctx_, array_schema);
+  CHECK(rc == TILEDB_ERR);
+
+  // Clean up
+  rc = tiledb_attribute_free(ctx_, &attr);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_dimension_free(ctx_, &d1);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_dimension_free(ctx_, &d2);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_domain_free(ctx_, &domain);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_schema_free(ctx_, &array_schema);
+  CHECK(rc == TILEDB_OK);
+}
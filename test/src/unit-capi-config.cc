@@ -182,19 +182,48 @@ void check_save_to_file() {
   REQUIRE(rc == TILEDB_OK);
 
   std::stringstream ss;
+  ss << "sm.array_open_timestamp 0\n";
   ss << "sm.array_schema_cache_size 10000000\n";
+  ss << "sm.async_worker_num 2\n";
+  ss << "sm.concurrency.io_ratio 0.5\n";
+  ss << "sm.concurrency.per_query_cap 0\n";
+  ss << "sm.concurrency.total_budget 0\n";
+  ss << "sm.consolidation.checkpoint_frequency 0\n";
+  ss << "sm.consolidation.scheduler_enable false\n";
+  ss << "sm.consolidation.scheduler_frag_threshold 10\n";
+  ss << "sm.consolidation.scheduler_interval_ms 60000\n";
+  ss << "sm.consolidation.step_max_frags 18446744073709551615\n";
+  ss << "sm.consolidation.step_min_frags 2\n";
+  ss << "sm.consolidation.step_size_ratio 0\n";
+  ss << "sm.consolidation.steps 18446744073709551615\n";
+  ss << "sm.disk_cache.size 10737418240\n";
+  ss << "sm.enable_checksums false\n";
   ss << "sm.fragment_metadata_cache_size 10000000\n";
+  ss << "sm.generic_tile_prefix_size 65536\n";
+  ss << "sm.hugepage_threshold 0\n";
+  ss << "sm.max_parallel_ops " << std::thread::hardware_concurrency() << "\n";
+  ss << "sm.memory_budget 0\n";
+  ss << "sm.read_partition_budget 536870912\n";
+  ss << "sm.tile_cache_compressed false\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "sm.write_combining_budget 0\n";
+  ss << "vfs.exists_cache_ttl_ms 10000\n";
+  ss << "vfs.max_batch_read_gap 512000\n";
   ss << "vfs.max_parallel_ops " << std::thread::hardware_concurrency() << "\n";
+  ss << "vfs.min_direct_write_size 4194304\n";
   ss << "vfs.min_parallel_size 10485760\n";
   ss << "vfs.s3.connect_max_tries 5\n";
   ss << "vfs.s3.connect_scale_factor 25\n";
   ss << "vfs.s3.connect_timeout_ms 3000\n";
+  ss << "vfs.s3.max_connections 64\n";
+  ss << "vfs.s3.max_parallel_ops " << std::thread::hardware_concurrency()
+     << "\n";
   ss << "vfs.s3.multipart_part_size 5242880\n";
   ss << "vfs.s3.region us-east-1\n";
   ss << "vfs.s3.request_timeout_ms 3000\n";
   ss << "vfs.s3.scheme https\n";
   ss << "vfs.s3.use_virtual_addressing true\n";
+  ss << "vfs.write_buffer_size 1048576\n";
 
   std::ifstream ifs("test_config.txt");
   std::stringstream ss_file;
@@ -351,10 +380,37 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   std::map<std::string, std::string> all_param_values;
   all_param_values["sm.tile_cache_size"] = "100";
   all_param_values["sm.array_schema_cache_size"] = "1000";
+  all_param_values["sm.async_worker_num"] = "2";
+  all_param_values["sm.concurrency.total_budget"] = "0";
+  all_param_values["sm.concurrency.io_ratio"] = "0.5";
+  all_param_values["sm.concurrency.per_query_cap"] = "0";
+  all_param_values["sm.consolidation.steps"] = "18446744073709551615";
+  all_param_values["sm.consolidation.step_min_frags"] = "2";
+  all_param_values["sm.consolidation.step_max_frags"] = "18446744073709551615";
+  all_param_values["sm.consolidation.step_size_ratio"] = "0";
+  all_param_values["sm.consolidation.checkpoint_frequency"] = "0";
+  all_param_values["sm.consolidation.scheduler_enable"] = "false";
+  all_param_values["sm.consolidation.scheduler_frag_threshold"] = "10";
+  all_param_values["sm.consolidation.scheduler_interval_ms"] = "60000";
   all_param_values["sm.fragment_metadata_cache_size"] = "10000000";
+  all_param_values["sm.enable_checksums"] = "false";
+  all_param_values["sm.max_parallel_ops"] =
+      std::to_string(std::thread::hardware_concurrency());
+  all_param_values["sm.memory_budget"] = "0";
+  all_param_values["sm.read_partition_budget"] = "536870912";
+  all_param_values["sm.write_combining_budget"] = "0";
+  all_param_values["sm.array_open_timestamp"] = "0";
+  all_param_values["sm.generic_tile_prefix_size"] = "65536";
+  all_param_values["sm.hugepage_threshold"] = "0";
   all_param_values["vfs.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
   all_param_values["vfs.min_parallel_size"] = "10485760";
+  all_param_values["vfs.max_batch_read_gap"] = "512000";
+  all_param_values["vfs.min_direct_write_size"] = "4194304";
+  all_param_values["vfs.write_buffer_size"] = "1048576";
+  all_param_values["vfs.exists_cache_ttl_ms"] = "10000";
+  all_param_values["vfs.s3.max_parallel_ops"] =
+      std::to_string(std::thread::hardware_concurrency());
   all_param_values["vfs.s3.scheme"] = "https";
   all_param_values["vfs.s3.region"] = "us-east-1";
   all_param_values["vfs.s3.endpoint_override"] = "";
@@ -363,6 +419,7 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["vfs.s3.connect_timeout_ms"] = "3000";
   all_param_values["vfs.s3.connect_max_tries"] = "5";
   all_param_values["vfs.s3.connect_scale_factor"] = "25";
+  all_param_values["vfs.s3.max_connections"] = "64";
   all_param_values["vfs.s3.request_timeout_ms"] = "3000";
   all_param_values["vfs.hdfs.username"] = "stavros";
   all_param_values["vfs.hdfs.kerb_ticket_cache_path"] = "";
@@ -372,6 +429,12 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   vfs_param_values["max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
   vfs_param_values["min_parallel_size"] = "10485760";
+  vfs_param_values["max_batch_read_gap"] = "512000";
+  vfs_param_values["min_direct_write_size"] = "4194304";
+  vfs_param_values["write_buffer_size"] = "1048576";
+  vfs_param_values["exists_cache_ttl_ms"] = "10000";
+  vfs_param_values["s3.max_parallel_ops"] =
+      std::to_string(std::thread::hardware_concurrency());
   vfs_param_values["s3.scheme"] = "https";
   vfs_param_values["s3.region"] = "us-east-1";
   vfs_param_values["s3.endpoint_override"] = "";
@@ -380,12 +443,15 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   vfs_param_values["s3.connect_timeout_ms"] = "3000";
   vfs_param_values["s3.connect_max_tries"] = "5";
   vfs_param_values["s3.connect_scale_factor"] = "25";
+  vfs_param_values["s3.max_connections"] = "64";
   vfs_param_values["s3.request_timeout_ms"] = "3000";
   vfs_param_values["hdfs.username"] = "stavros";
   vfs_param_values["hdfs.kerb_ticket_cache_path"] = "";
   vfs_param_values["hdfs.name_node_uri"] = "";
 
   std::map<std::string, std::string> s3_param_values;
+  s3_param_values["max_parallel_ops"] =
+      std::to_string(std::thread::hardware_concurrency());
   s3_param_values["scheme"] = "https";
   s3_param_values["region"] = "us-east-1";
   s3_param_values["endpoint_override"] = "";
@@ -394,6 +460,7 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   s3_param_values["connect_timeout_ms"] = "3000";
   s3_param_values["connect_max_tries"] = "5";
   s3_param_values["connect_scale_factor"] = "25";
+  s3_param_values["max_connections"] = "64";
   s3_param_values["request_timeout_ms"] = "3000";
 
   // Create an iterator and iterate over all parameters
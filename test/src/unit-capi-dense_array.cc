@@ -41,12 +41,16 @@
 #include "tiledb/sm/misc/utils.h"
 
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 struct DenseArrayFx {
   // Constant parameters
@@ -85,6 +89,43 @@ struct DenseArrayFx {
   void create_temp_dir(const std::string& path);
   void remove_temp_dir(const std::string& path);
   void check_sorted_reads(const std::string& path);
+  void check_opened_array_reads(const std::string& path);
+  void check_batch_reads(const std::string& path);
+  void check_preload_reads(const std::string& path);
+
+  /** Checks the budget-aware subarray partitioning. */
+  void check_subarray_partitioning(const std::string& path);
+
+  /** Checks planning a query and executing its partitions. */
+  void check_query_plan(const std::string& path);
+  void check_completion_queue_reads(const std::string& path);
+  void check_tile_aligned_reads(const std::string& path);
+  void check_aggregates(const std::string& path);
+  void check_predicates(const std::string& path);
+
+  /**
+   * Checks reads in the query-allocated buffers mode
+   * (`tiledb_query_set_alloc_buffers`/`tiledb_query_get_buffer`), over
+   * a fixed-sized and a var-sized attribute, including a region that
+   * no fragment covers (fill values only) and the lifetime/stability
+   * contract of the returned buffers.
+   */
+  void check_alloc_buffers(const std::string& path);
+
+  /**
+   * Checks that a completed read query can be rebound to a new subarray
+   * with `tiledb_query_reset` and resubmitted, and that resetting a
+   * write query or a query still in progress errors.
+   */
+  void check_reset_reads(const std::string& path);
+
+  /**
+   * Checks that a read submitted with the `TILEDB_CACHE_BYPASS` hint
+   * does not populate the tile cache, using the per-query statistics
+   * (`tiledb_query_get_stats`) of subsequent reads of the same tiles.
+   */
+  void check_cache_hint(const std::string& path);
+
   void check_sorted_writes(const std::string& path);
   void check_invalid_global_writes(const std::string& path);
   void check_sparse_writes(const std::string& path);
@@ -490,6 +531,13 @@ int* DenseArrayFx::read_dense_array_2D(
       tiledb_query_finalize(ctx_, query);  // Second time must create no problem
   REQUIRE(rc == TILEDB_OK);
 
+  // The per-query stats must have recorded the tile fetches
+  tiledb_query_stats_t stats;
+  rc = tiledb_query_get_stats(ctx_, query, &stats);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(stats.tiles_fetched > 0);
+  CHECK(stats.cache_hits + stats.cache_misses == stats.tiles_fetched);
+
   // Free/finalize query
   rc = tiledb_query_free(ctx_, &query);
   REQUIRE(rc == TILEDB_OK);
@@ -770,7 +818,7 @@ void DenseArrayFx::check_sorted_reads(const std::string& path) {
   CHECK(rc == TILEDB_OK);
 }
 
-void DenseArrayFx::check_sorted_writes(const std::string& path) {
+void DenseArrayFx::check_opened_array_reads(const std::string& path) {
   // Parameters used in this test
   int64_t domain_size_0 = 100;
   int64_t domain_size_1 = 100;
@@ -783,9 +831,9 @@ void DenseArrayFx::check_sorted_writes(const std::string& path) {
   uint64_t capacity = 1000;
   tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
   tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
-  std::string array_name = path + "sorted_writes_array";
+  std::string array_name = path + "opened_array_reads_array";
 
-  // Create a dense integer array
+  // Create and populate a dense integer array
   create_dense_array_2D(
       array_name,
       tile_extent_0,
@@ -797,65 +845,66 @@ void DenseArrayFx::check_sorted_writes(const std::string& path) {
       capacity,
       cell_order,
       tile_order);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
 
-  // Write random subarray, then read it back and check
-  int64_t d0[2], d1[2];
-  for (int i = 0; i < ITER_NUM; ++i) {
-    // Create subarray
-    d0[0] = std::rand() % domain_size_0;
-    d1[0] = std::rand() % domain_size_1;
-    d0[1] = d0[0] + std::rand() % (domain_size_0 - d0[0]);
-    d1[1] = d1[0] + std::rand() % (domain_size_1 - d1[0]);
-    int64_t subarray[] = {d0[0], d0[1], d1[0], d1[1]};
-
-    // Prepare buffers
-    int64_t subarray_length[2] = {d0[1] - d0[0] + 1, d1[1] - d1[0] + 1};
-    int64_t cell_num_in_subarray = subarray_length[0] * subarray_length[1];
-    auto buffer = new int[cell_num_in_subarray];
-    int64_t index = 0;
-    uint64_t buffer_size = cell_num_in_subarray * sizeof(int);
-    uint64_t buffer_sizes[] = {buffer_size};
-    for (int64_t r = 0; r < subarray_length[0]; ++r)
-      for (int64_t c = 0; c < subarray_length[1]; ++c)
-        buffer[index++] = -(std::rand() % 999999);
+  // Open the array once
+  tiledb_array_t* array = nullptr;
+  int rc = tiledb_array_open(ctx_, &array, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
 
-    // Write 2D subarray
-    write_dense_subarray_2D(
-        array_name,
-        subarray,
-        TILEDB_WRITE,
-        TILEDB_ROW_MAJOR,
-        buffer,
+  // Create multiple queries against the opened array, each reading a
+  // different subarray, and check the results
+  for (int iter = 0; iter < ITER_NUM; ++iter) {
+    int64_t d0_lo = std::rand() % domain_size_0;
+    int64_t d0_hi = d0_lo + std::rand() % (domain_size_0 - d0_lo);
+    int64_t d1_lo = std::rand() % domain_size_1;
+    int64_t d1_hi = d1_lo + std::rand() % (domain_size_1 - d1_lo);
+    int64_t subarray[] = {d0_lo, d0_hi, d1_lo, d1_hi};
+    uint64_t cell_num = (d0_hi - d0_lo + 1) * (d1_hi - d1_lo + 1);
+    auto buffer = new int[cell_num];
+    void* buffers[] = {buffer};
+    uint64_t buffer_sizes[] = {cell_num * sizeof(int)};
+    const char* attributes[] = {ATTR_NAME};
+
+    tiledb_query_t* query = nullptr;
+    rc = tiledb_query_create_with_array(ctx_, &query, array);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarray);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(ctx_, query, attributes, 1, buffers,
         buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_finalize(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
 
-    // Read back the same subarray
-    int* read_buffer = read_dense_array_2D(
-        array_name,
-        subarray[0],
-        subarray[1],
-        subarray[2],
-        subarray[3],
-        TILEDB_READ,
-        TILEDB_ROW_MAJOR);
-    REQUIRE(read_buffer != NULL);
-
-    // Check the two buffers
+    // Check the cells; they were written with value row_id*dim1+col_id
+    int64_t index = 0;
     bool allok = true;
-    for (index = 0; index < cell_num_in_subarray; ++index) {
-      if (buffer[index] != read_buffer[index]) {
-        allok = false;
-        break;
-      }
-    }
+    for (int64_t i = d0_lo; i <= d0_hi && allok; ++i)
+      for (int64_t j = d1_lo; j <= d1_hi; ++j)
+        if (buffer[index++] != i * domain_size_1 + j) {
+          allok = false;
+          break;
+        }
     REQUIRE(allok);
 
-    // Clean up
     delete[] buffer;
-    delete[] read_buffer;
   }
+
+  // Close the array
+  rc = tiledb_array_close(ctx_, &array);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(array == nullptr);
 }
 
-void DenseArrayFx::check_invalid_global_writes(const std::string& path) {
+void DenseArrayFx::check_batch_reads(const std::string& path) {
   // Parameters used in this test
   int64_t domain_size_0 = 100;
   int64_t domain_size_1 = 100;
@@ -868,9 +917,10 @@ void DenseArrayFx::check_invalid_global_writes(const std::string& path) {
   uint64_t capacity = 1000;
   tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
   tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
-  std::string array_name = path + "invalid_writes_array";
+  const uint64_t query_num = 20;
+  std::string array_name = path + "batch_reads_array";
 
-  // Create a dense integer array
+  // Create and populate a dense integer array
   create_dense_array_2D(
       array_name,
       tile_extent_0,
@@ -882,34 +932,143 @@ void DenseArrayFx::check_invalid_global_writes(const std::string& path) {
       capacity,
       cell_order,
       tile_order);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Open the array once and create a batch of single-cell read queries,
+  // several of which target the same tiles
+  tiledb_array_t* array = nullptr;
+  int rc = tiledb_array_open(ctx_, &array, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
 
+  tiledb_query_t* queries[query_num];
+  int64_t subarrays[query_num][4];
+  int buffers[query_num];
   const char* attributes[] = {ATTR_NAME};
-  int buffer[3] = {1, 2, 3};
-  void* buffers[] = {buffer};
-  uint64_t buffer_sizes[] = {sizeof(buffer)};
+  for (uint64_t q = 0; q < query_num; ++q) {
+    int64_t d0 = std::rand() % domain_size_0;
+    int64_t d1 = std::rand() % (2 * tile_extent_1);
+    subarrays[q][0] = subarrays[q][1] = d0;
+    subarrays[q][2] = subarrays[q][3] = d1;
+    void* query_buffers[] = {&buffers[q]};
+    uint64_t buffer_sizes[] = {sizeof(int)};
+    rc = tiledb_query_create_with_array(ctx_, &queries[q], array);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, queries[q], subarrays[q]);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx_, queries[q], attributes, 1, query_buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, queries[q], TILEDB_ROW_MAJOR);
+    REQUIRE(rc == TILEDB_OK);
+  }
 
-  // Create query
-  tiledb_query_t* query;
-  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+  // Submit the batch and check the results; the cells were written with
+  // value row_id*dim1+col_id
+  rc = tiledb_query_submit_batch(ctx_, queries, query_num);
   REQUIRE(rc == TILEDB_OK);
-  rc = tiledb_query_set_buffers(
-      ctx_, query, attributes, 1, buffers, buffer_sizes);
+  for (uint64_t q = 0; q < query_num; ++q) {
+    tiledb_query_status_t status;
+    rc = tiledb_query_get_status(ctx_, queries[q], &status);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(status == TILEDB_COMPLETED);
+    CHECK(buffers[q] == subarrays[q][0] * domain_size_1 + subarrays[q][2]);
+    rc = tiledb_query_finalize(ctx_, queries[q]);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &queries[q]);
+    REQUIRE(rc == TILEDB_OK);
+  }
+
+  // Close the array
+  rc = tiledb_array_close(ctx_, &array);
   REQUIRE(rc == TILEDB_OK);
-  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+}
+
+void DenseArrayFx::check_preload_reads(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "preload_reads_array";
+
+  // Create and populate a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Open the array and preload a subarray spanning four tiles
+  tiledb_array_t* array = nullptr;
+  int rc = tiledb_array_open(ctx_, &array, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  int64_t preload_subarray[] = {0, 2 * tile_extent_0 - 1,
+                                0, 2 * tile_extent_1 - 1};
+  const char* attributes[] = {ATTR_NAME};
+  rc = tiledb_array_preload(ctx_, array, preload_subarray, attributes, 1);
   REQUIRE(rc == TILEDB_OK);
 
-  // Submit query
+  // A preload with `NULL` subarray and attributes covers the entire
+  // domain and all the attributes
+  rc = tiledb_array_preload(ctx_, array, nullptr, nullptr, 0);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read back the preloaded subarray and check the results; the reads
+  // are correct whether or not the background preload has completed
+  uint64_t cell_num = (2 * tile_extent_0) * (2 * tile_extent_1);
+  std::vector<int> buffer(cell_num);
+  void* buffers[] = {&buffer[0]};
+  uint64_t buffer_sizes[] = {cell_num * sizeof(int)};
+  tiledb_query_t* query = nullptr;
+  rc = tiledb_query_create_with_array(ctx_, &query, array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, preload_subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(ctx_, query, attributes, 1, buffers,
+      buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
   rc = tiledb_query_submit(ctx_, query);
   REQUIRE(rc == TILEDB_OK);
   rc = tiledb_query_finalize(ctx_, query);
-  REQUIRE(rc == TILEDB_ERR);
-
-  // Free query
+  REQUIRE(rc == TILEDB_OK);
   rc = tiledb_query_free(ctx_, &query);
   REQUIRE(rc == TILEDB_OK);
+
+  // Check the cells; they were written with value row_id*dim1+col_id
+  int64_t index = 0;
+  bool allok = true;
+  for (int64_t i = 0; i < 2 * tile_extent_0 && allok; ++i)
+    for (int64_t j = 0; j < 2 * tile_extent_1; ++j)
+      if (buffer[index++] != i * domain_size_1 + j) {
+        allok = false;
+        break;
+      }
+  REQUIRE(allok);
+
+  // Close the array; the preloads hold their own references
+  rc = tiledb_array_close(ctx_, &array);
+  REQUIRE(rc == TILEDB_OK);
 }
 
-void DenseArrayFx::check_sparse_writes(const std::string& path) {
+void DenseArrayFx::check_subarray_partitioning(const std::string& path) {
   // Parameters used in this test
   int64_t domain_size_0 = 100;
   int64_t domain_size_1 = 100;
@@ -922,11 +1081,9 @@ void DenseArrayFx::check_sparse_writes(const std::string& path) {
   uint64_t capacity = 1000;
   tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
   tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
-  uint64_t update_num = 100;
-  int seed = 7;
-  std::string array_name = path + "sparse_writes_array";
+  std::string array_name = path + "partition_subarray_array";
 
-  // Create a dense integer array
+  // Create and populate a dense integer array
   create_dense_array_2D(
       array_name,
       tile_extent_0,
@@ -938,58 +1095,1127 @@ void DenseArrayFx::check_sparse_writes(const std::string& path) {
       capacity,
       cell_order,
       tile_order);
-
-  // Write array cells with value = row id * COLUMNS + col id
-  // to disk tile by tile
   write_dense_array_by_tiles(
       array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
 
-  // Read the entire array back to memory
-  int* before_update = read_dense_array_2D(
+  // A budget that fits the entire subarray yields a single partition
+  int64_t subarray[] = {0, domain_size_0 - 1, 0, domain_size_1 - 1};
+  const char* attributes[] = {ATTR_NAME};
+  void* partitions = nullptr;
+  uint64_t partition_num = 0;
+  uint64_t total_size =
+      (uint64_t)(domain_size_0 * domain_size_1) * sizeof(int);
+  int rc = tiledb_array_partition_subarray(
+      ctx_,
+      array_name.c_str(),
+      subarray,
+      TILEDB_ROW_MAJOR,
+      attributes,
+      1,
+      total_size,
+      &partitions,
+      &partition_num);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(partition_num == 1);
+  CHECK(!memcmp(partitions, subarray, sizeof(subarray)));
+  free(partitions);
+
+  // A smaller budget splits the subarray; every partition must fit in
+  // the budget and the partitions must cover the subarray
+  uint64_t budget = total_size / 4;
+  rc = tiledb_array_partition_subarray(
+      ctx_,
+      array_name.c_str(),
+      subarray,
+      TILEDB_ROW_MAJOR,
+      attributes,
+      1,
+      budget,
+      &partitions,
+      &partition_num);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(partition_num >= 4);
+  auto parts = (const int64_t*)partitions;
+  uint64_t cell_num = 0;
+  for (uint64_t p = 0; p < partition_num; ++p) {
+    auto s = &parts[4 * p];
+    CHECK(s[0] >= 0);
+    CHECK(s[1] < domain_size_0);
+    CHECK(s[2] >= 0);
+    CHECK(s[3] < domain_size_1);
+    CHECK(s[0] <= s[1]);
+    CHECK(s[2] <= s[3]);
+    uint64_t max_size = 0;
+    rc = tiledb_array_compute_max_read_buffer_sizes(
+        ctx_, array_name.c_str(), s, attributes, 1, &max_size);
+    CHECK(rc == TILEDB_OK);
+    CHECK(max_size <= budget);
+    cell_num += (uint64_t)(s[1] - s[0] + 1) * (uint64_t)(s[3] - s[2] + 1);
+  }
+  CHECK(cell_num == (uint64_t)(domain_size_0 * domain_size_1));
+  free(partitions);
+}
+
+void DenseArrayFx::check_query_plan(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "query_plan_array";
+
+  // Create and populate a dense integer array
+  create_dense_array_2D(
       array_name,
+      tile_extent_0,
+      tile_extent_1,
       domain_0_lo,
       domain_0_hi,
       domain_1_lo,
       domain_1_hi,
-      TILEDB_READ,
-      TILEDB_GLOBAL_ORDER);
-  REQUIRE(before_update != NULL);
+      capacity,
+      cell_order,
+      tile_order);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
 
-  // Prepare random updates
-  auto buffer_a1 = new int[update_num];
-  auto buffer_coords = new int64_t[2 * update_num];
-  void* buffers[] = {buffer_a1, buffer_coords};
-  uint64_t buffer_sizes[2];
-  buffer_sizes[0] = update_num * sizeof(int);
-  buffer_sizes[1] = 2 * update_num * sizeof(int64_t);
+  // Plan the query once, forcing multiple partitions
+  const char* attributes[] = {ATTR_NAME};
+  uint64_t total_size =
+      (uint64_t)(domain_size_0 * domain_size_1) * sizeof(int);
+  void* plan = nullptr;
+  uint64_t plan_size = 0;
+  uint64_t partition_num = 0;
+  int rc = tiledb_query_plan(
+      ctx_,
+      array_name.c_str(),
+      nullptr,
+      TILEDB_ROW_MAJOR,
+      attributes,
+      1,
+      total_size / 4,
+      &plan,
+      &plan_size,
+      &partition_num);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(partition_num >= 4);
+
+  // Execute each partition directly from the plan, as a worker node
+  // would, and check that the partitions cover the array exactly once
+  uint64_t cell_num = 0;
+  for (uint64_t p = 0; p < partition_num; ++p) {
+    tiledb_query_t* query = nullptr;
+    rc = tiledb_query_create_from_plan(ctx_, &query, plan, plan_size, p);
+    REQUIRE(rc == TILEDB_OK);
+    std::vector<int> buffer(domain_size_0 * domain_size_1);
+    void* buffers[] = {&buffer[0]};
+    uint64_t buffer_sizes[] = {buffer.size() * sizeof(int)};
+    rc = tiledb_query_set_buffers(
+        ctx_, query, attributes, 1, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_query_status_t status;
+    rc = tiledb_query_get_status(ctx_, query, &status);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(status == TILEDB_COMPLETED);
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
 
-  update_dense_array_2D(
-      array_name,
-      domain_size_0,
-      domain_size_1,
-      update_num,
-      seed,
-      buffers,
-      buffer_sizes);
+    // Every partition fits in the budget, which bounds its result size
+    uint64_t result_num = buffer_sizes[0] / sizeof(int);
+    CHECK(result_num > 0);
+    CHECK(buffer_sizes[0] <= total_size / 4);
+    cell_num += result_num;
+  }
+  CHECK(cell_num == (uint64_t)(domain_size_0 * domain_size_1));
 
-  // Read the entire array back to memory after update
-  int* after_update = read_dense_array_2D(
+  // An out-of-range partition index must fail
+  tiledb_query_t* query = nullptr;
+  rc = tiledb_query_create_from_plan(
+      ctx_, &query, plan, plan_size, partition_num);
+  CHECK(rc == TILEDB_ERR);
+  free(plan);
+}
+
+void DenseArrayFx::check_completion_queue_reads(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  const uint64_t query_num = 10;
+  std::string array_name = path + "completion_queue_reads_array";
+
+  // Create and populate a dense integer array
+  create_dense_array_2D(
       array_name,
+      tile_extent_0,
+      tile_extent_1,
       domain_0_lo,
       domain_0_hi,
       domain_1_lo,
       domain_1_hi,
-      TILEDB_READ,
-      TILEDB_GLOBAL_ORDER);
-  REQUIRE(after_update != NULL);
+      capacity,
+      cell_order,
+      tile_order);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
 
-  // Compare array before and after
-  check_buffer_after_updates(
-      before_update,
-      after_update,
-      buffer_a1,
-      buffer_coords,
-      domain_size_0,
+  // An empty completion queue does not block a poll and times out on wait
+  tiledb_completion_queue_t* cq = nullptr;
+  int rc = tiledb_completion_queue_create(ctx_, &cq);
+  REQUIRE(rc == TILEDB_OK);
+  void* tag = nullptr;
+  int has_completion = 1;
+  rc = tiledb_completion_queue_poll(ctx_, cq, &tag, &has_completion);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(has_completion == 0);
+  rc = tiledb_completion_queue_wait(ctx_, cq, 10, &tag, &has_completion);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(has_completion == 0);
+
+  // Submit single-cell read queries tagged with their index
+  tiledb_array_t* array = nullptr;
+  rc = tiledb_array_open(ctx_, &array, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_t* queries[query_num];
+  int64_t subarrays[query_num][4];
+  int buffers[query_num];
+  uint64_t tags[query_num];
+  const char* attributes[] = {ATTR_NAME};
+  for (uint64_t q = 0; q < query_num; ++q) {
+    int64_t d0 = std::rand() % domain_size_0;
+    int64_t d1 = std::rand() % domain_size_1;
+    subarrays[q][0] = subarrays[q][1] = d0;
+    subarrays[q][2] = subarrays[q][3] = d1;
+    tags[q] = q;
+    void* query_buffers[] = {&buffers[q]};
+    uint64_t buffer_sizes[] = {sizeof(int)};
+    rc = tiledb_query_create_with_array(ctx_, &queries[q], array);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, queries[q], subarrays[q]);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx_, queries[q], attributes, 1, query_buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, queries[q], TILEDB_ROW_MAJOR);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit_queued(ctx_, queries[q], cq, &tags[q]);
+    REQUIRE(rc == TILEDB_OK);
+  }
+
+  // Drain all the completions and check the results; the cells were
+  // written with value row_id*dim1+col_id
+  for (uint64_t c = 0; c < query_num; ++c) {
+    rc = tiledb_completion_queue_wait(
+        ctx_, cq, UINT64_MAX, &tag, &has_completion);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(has_completion == 1);
+    auto q = *(uint64_t*)tag;
+    REQUIRE(q < query_num);
+    tiledb_query_status_t status;
+    rc = tiledb_query_get_status(ctx_, queries[q], &status);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(status == TILEDB_COMPLETED);
+    CHECK(buffers[q] == subarrays[q][0] * domain_size_1 + subarrays[q][2]);
+  }
+  rc = tiledb_completion_queue_poll(ctx_, cq, &tag, &has_completion);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(has_completion == 0);
+
+  // Clean up
+  for (uint64_t q = 0; q < query_num; ++q) {
+    rc = tiledb_query_finalize(ctx_, queries[q]);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &queries[q]);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  rc = tiledb_array_close(ctx_, &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_completion_queue_free(ctx_, &cq);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(cq == nullptr);
+}
+
+void DenseArrayFx::check_tile_aligned_reads(const std::string& path) {
+  // Parameters used in this test. Global-order reads of tile-aligned
+  // subarrays over a single fragment take the direct whole-tile path.
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "tile_aligned_reads_array";
+
+  // Create a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  // to disk tile by tile
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Checks a global-order read of a tile-aligned subarray against the
+  // expected global cell order
+  auto check_global_read = [&](
+      int64_t d0_lo, int64_t d0_hi, int64_t d1_lo, int64_t d1_hi) {
+    int* buffer = read_dense_array_2D(
+        array_name, d0_lo, d0_hi, d1_lo, d1_hi, TILEDB_READ,
+        TILEDB_GLOBAL_ORDER);
+    REQUIRE(buffer != NULL);
+    bool allok = true;
+    int64_t idx = 0;
+    for (int64_t tr = d0_lo; tr <= d0_hi && allok; tr += tile_extent_0) {
+      for (int64_t tc = d1_lo; tc <= d1_hi && allok; tc += tile_extent_1) {
+        for (int64_t i = tr; i < tr + tile_extent_0 && allok; ++i) {
+          for (int64_t j = tc; j < tc + tile_extent_1; ++j) {
+            if (buffer[idx++] != (int)(i * domain_size_1 + j)) {
+              allok = false;
+              break;
+            }
+          }
+        }
+      }
+    }
+    CHECK(allok);
+    delete[] buffer;
+  };
+
+  // Full domain and a tile-aligned interior subarray
+  check_global_read(domain_0_lo, domain_0_hi, domain_1_lo, domain_1_hi);
+  check_global_read(20, 59, 30, 69);
+}
+
+void DenseArrayFx::check_aggregates(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "aggregates_array";
+
+  // Create a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  // to disk tile by tile
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Checks the aggregates of a subarray against the expected values
+  auto check_aggregate = [&](
+      int64_t d0_lo, int64_t d0_hi, int64_t d1_lo, int64_t d1_hi) {
+    const int64_t subarray[] = {d0_lo, d0_hi, d1_lo, d1_hi};
+    tiledb_query_t* query;
+    int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarray);
+    REQUIRE(rc == TILEDB_OK);
+
+    uint64_t count = 0;
+    int min = 0, max = 0;
+    int64_t sum = 0;
+    rc = tiledb_query_aggregate(ctx_, query, ATTR_NAME, &count, &min, &max, &sum);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Compute the expected aggregates
+    uint64_t e_count = 0;
+    int64_t e_sum = 0;
+    int e_min = std::numeric_limits<int>::max();
+    int e_max = std::numeric_limits<int>::min();
+    for (int64_t i = d0_lo; i <= d0_hi; ++i) {
+      for (int64_t j = d1_lo; j <= d1_hi; ++j) {
+        auto v = (int)(i * domain_size_1 + j);
+        ++e_count;
+        e_sum += v;
+        e_min = std::min(e_min, v);
+        e_max = std::max(e_max, v);
+      }
+    }
+    CHECK(count == e_count);
+    CHECK(min == e_min);
+    CHECK(max == e_max);
+    CHECK(sum == e_sum);
+
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
+  };
+
+  // Full domain (answered from the metadata statistics alone), a
+  // subarray that crosses tile boundaries, and a single cell
+  check_aggregate(domain_0_lo, domain_0_hi, domain_1_lo, domain_1_hi);
+  check_aggregate(5, 94, 3, 96);
+  check_aggregate(42, 42, 17, 17);
+}
+
+void DenseArrayFx::check_predicates(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "predicates_array";
+
+  // Create a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  // to disk tile by tile
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Reads a subarray with the predicates applied by `set_predicates`
+  // and checks the result against the cells that `selected` accepts
+  auto check_read = [&](
+      int64_t d0_lo,
+      int64_t d0_hi,
+      int64_t d1_lo,
+      int64_t d1_hi,
+      std::function<void(tiledb_query_t*)> set_predicates,
+      std::function<bool(int)> selected) {
+    const int64_t subarray[] = {d0_lo, d0_hi, d1_lo, d1_hi};
+    const char* attributes[] = {ATTR_NAME};
+    int64_t cell_num = (d0_hi - d0_lo + 1) * (d1_hi - d1_lo + 1);
+    std::vector<int> buffer_a1(cell_num);
+    void* buffers[] = {&buffer_a1[0]};
+    uint64_t buffer_sizes[] = {cell_num * sizeof(int)};
+
+    tiledb_query_t* query;
+    int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx_, query, attributes, 1, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarray);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+    REQUIRE(rc == TILEDB_OK);
+    set_predicates(query);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Compute the expected result, in the subarray row-major order
+    std::vector<int> expected;
+    for (int64_t i = d0_lo; i <= d0_hi; ++i) {
+      for (int64_t j = d1_lo; j <= d1_hi; ++j) {
+        auto v = (int)(i * domain_size_1 + j);
+        if (selected(v))
+          expected.push_back(v);
+      }
+    }
+
+    void* buffer;
+    uint64_t buffer_size;
+    rc = tiledb_query_get_buffer(
+        ctx_, query, ATTR_NAME, &buffer, &buffer_size, nullptr, nullptr);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(buffer_size == expected.size() * sizeof(int));
+    if (!expected.empty())
+      CHECK(!memcmp(&buffer_a1[0], &expected[0], buffer_size));
+
+    rc = tiledb_query_finalize(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
+  };
+
+  // An inclusive range over the full domain; the statistics reject
+  // most tiles without fetching them
+  check_read(
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      [&](tiledb_query_t* query) {
+        int low = 2500, high = 2599;
+        int rc = tiledb_query_set_predicate_range(
+            ctx_, query, ATTR_NAME, &low, &high);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v >= 2500 && v <= 2599; });
+
+  // A comparison over a subarray that crosses tile boundaries
+  check_read(
+      5,
+      94,
+      3,
+      96,
+      [&](tiledb_query_t* query) {
+        int value = 4321;
+        int rc = tiledb_query_set_predicate(
+            ctx_, query, ATTR_NAME, TILEDB_GE, &value);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v >= 4321; });
+
+  // Set membership over the full domain
+  check_read(
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      [&](tiledb_query_t* query) {
+        int values[] = {7, 5050, 9999};
+        int rc = tiledb_query_set_predicate_set(
+            ctx_, query, ATTR_NAME, values, 3);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v == 7 || v == 5050 || v == 9999; });
+
+  // Two predicates combine with a logical AND
+  check_read(
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      [&](tiledb_query_t* query) {
+        int low = 1000, high = 1010;
+        int rc = tiledb_query_set_predicate(
+            ctx_, query, ATTR_NAME, TILEDB_GE, &low);
+        REQUIRE(rc == TILEDB_OK);
+        rc = tiledb_query_set_predicate(
+            ctx_, query, ATTR_NAME, TILEDB_LT, &high);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v >= 1000 && v < 1010; });
+}
+
+void DenseArrayFx::check_alloc_buffers(const std::string& path) {
+  std::string array_name = path + "alloc_buffers_array";
+
+  // Create a dense array with a fixed-sized and a var-sized attribute,
+  // and a domain of two space tiles of which only the first is written
+  tiledb_attribute_t* a1;
+  int rc = tiledb_attribute_create(ctx_, &a1, "a1", TILEDB_INT32);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_t* a2;
+  rc = tiledb_attribute_create(ctx_, &a2, "a2", TILEDB_CHAR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_cell_val_num(ctx_, a2, TILEDB_VAR_NUM);
+  REQUIRE(rc == TILEDB_OK);
+  int64_t dim_domain[] = {0, 7, 0, 3};
+  int64_t tile_extents[] = {4, 4};
+  tiledb_dimension_t* d1;
+  rc = tiledb_dimension_create(
+      ctx_, &d1, DIM1_NAME, TILEDB_INT64, &dim_domain[0], &tile_extents[0]);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_dimension_t* d2;
+  rc = tiledb_dimension_create(
+      ctx_, &d2, DIM2_NAME, TILEDB_INT64, &dim_domain[2], &tile_extents[1]);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(ctx_, domain, d1);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(ctx_, domain, d2);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_schema_t* array_schema;
+  rc = tiledb_array_schema_create(ctx_, &array_schema, TILEDB_DENSE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_add_attribute(ctx_, array_schema, a1);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_add_attribute(ctx_, array_schema, a2);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_schema_set_domain(ctx_, array_schema, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_name.c_str(), array_schema);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(tiledb_attribute_free(ctx_, &a1) == TILEDB_OK);
+  REQUIRE(tiledb_attribute_free(ctx_, &a2) == TILEDB_OK);
+  REQUIRE(tiledb_dimension_free(ctx_, &d1) == TILEDB_OK);
+  REQUIRE(tiledb_dimension_free(ctx_, &d2) == TILEDB_OK);
+  REQUIRE(tiledb_domain_free(ctx_, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_free(ctx_, &array_schema) == TILEDB_OK);
+
+  // Write the first space tile; the second remains empty
+  int buffer_a1[16];
+  uint64_t buffer_a2_off[16];
+  char buffer_a2_val[3 * 16];
+  uint64_t a2_val_size = 0;
+  for (int i = 0; i < 16; ++i) {
+    buffer_a1[i] = i;
+    buffer_a2_off[i] = a2_val_size;
+    int len = i % 3 + 1;
+    for (int k = 0; k < len; ++k)
+      buffer_a2_val[a2_val_size++] = (char)('a' + i);
+  }
+  const char* attributes[] = {"a1", "a2"};
+  void* write_buffers[] = {buffer_a1, buffer_a2_off, buffer_a2_val};
+  uint64_t write_buffer_sizes[] = {
+      sizeof(buffer_a1), sizeof(buffer_a2_off), a2_val_size};
+  int64_t write_subarray[] = {0, 3, 0, 3};
+  tiledb_query_t* query;
+  rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 2, write_buffers, write_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, write_subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read the full domain in query-allocated mode; the unwritten tile
+  // comes back as fill values
+  int64_t subarray[] = {0, 7, 0, 3};
+  rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_alloc_buffers(ctx_, query, attributes, 2);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+
+  // The result buffers are not retrievable before the query completes
+  void* a1_values;
+  uint64_t a1_values_size;
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "a1", &a1_values, &a1_values_size, nullptr, nullptr);
+  CHECK(rc == TILEDB_ERR);
+
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // The fixed-sized buffer is sized to the exact result
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "a1", &a1_values, &a1_values_size, nullptr, nullptr);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(a1_values_size == 32 * sizeof(int));
+  auto a1_res = (int*)a1_values;
+  for (int i = 0; i < 16; ++i)
+    CHECK(a1_res[i] == i);
+  for (int i = 16; i < 32; ++i)
+    CHECK(a1_res[i] == std::numeric_limits<int>::max());
+
+  // The var-sized attribute returns an offsets and a values buffer;
+  // each of the 16 empty cells contributes a single fill character
+  void* a2_off;
+  uint64_t a2_off_size;
+  void* a2_val;
+  uint64_t a2_val_res_size;
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "a2", &a2_off, &a2_off_size, &a2_val, &a2_val_res_size);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(a2_off_size == 32 * sizeof(uint64_t));
+  REQUIRE(a2_val_res_size == a2_val_size + 16);
+  auto a2_off_res = (uint64_t*)a2_off;
+  auto a2_val_res = (char*)a2_val;
+  CHECK(!std::memcmp(a2_off_res, buffer_a2_off, sizeof(buffer_a2_off)));
+  CHECK(!std::memcmp(a2_val_res, buffer_a2_val, a2_val_size));
+  for (int i = 0; i < 16; ++i) {
+    CHECK(a2_off_res[16 + i] == a2_val_size + i);
+    CHECK(a2_val_res[a2_val_size + i] == std::numeric_limits<char>::max());
+  }
+
+  // Unknown attributes error
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "foo", &a1_values, &a1_values_size, nullptr, nullptr);
+  CHECK(rc == TILEDB_ERR);
+
+  // The buffers are owned by the query and stable across retrievals;
+  // they remain valid until `tiledb_query_free`
+  void* a1_values_2;
+  uint64_t a1_values_size_2;
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "a1", &a1_values_2, &a1_values_size_2, nullptr, nullptr);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(a1_values_2 == a1_values);
+  CHECK(a1_values_size_2 == a1_values_size);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // A read of a region no fragment covers returns only fill values
+  int64_t empty_subarray[] = {4, 7, 0, 3};
+  rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_alloc_buffers(ctx_, query, attributes, 2);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, empty_subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "a1", &a1_values, &a1_values_size, nullptr, nullptr);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(a1_values_size == 16 * sizeof(int));
+  a1_res = (int*)a1_values;
+  bool allfill = true;
+  for (int i = 0; i < 16; ++i)
+    allfill &= (a1_res[i] == std::numeric_limits<int>::max());
+  CHECK(allfill);
+  rc = tiledb_query_get_buffer(
+      ctx_, query, "a2", &a2_off, &a2_off_size, &a2_val, &a2_val_res_size);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(a2_off_size == 16 * sizeof(uint64_t));
+  CHECK(a2_val_res_size == 16);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+}
+
+void DenseArrayFx::check_reset_reads(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 16;
+  int64_t domain_size_1 = 16;
+  int64_t tile_extent_0 = 4;
+  int64_t tile_extent_1 = 4;
+  std::string array_name = path + "reset_reads_array";
+
+  // Create and populate a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      100,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Prepare a read of the first space tile
+  const char* attributes[] = {ATTR_NAME};
+  int buffer[16];
+  void* buffers[] = {buffer};
+  uint64_t buffer_sizes[] = {sizeof(buffer)};
+  int64_t subarray_1[] = {0, 3, 0, 3};
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 1, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray_1);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+
+  // A query is in progress until its first submission completes, so it
+  // cannot be reset yet
+  tiledb_query_status_t status;
+  rc = tiledb_query_get_status(ctx_, query, &status);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(status == TILEDB_INPROGRESS);
+  rc = tiledb_query_reset(ctx_, query, subarray_1);
+  CHECK(rc == TILEDB_ERR);
+
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_get_status(ctx_, query, &status);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(status == TILEDB_COMPLETED);
+  CHECK(buffer_sizes[0] == sizeof(buffer));
+  for (int i = 0; i < 16; ++i)
+    CHECK(buffer[i] == (int)((i / 4) * domain_size_1 + i % 4));
+
+  // Rebind the completed query to a different subarray and resubmit,
+  // reusing the array, the fragment metadata and the buffer bindings
+  int64_t subarray_2[] = {4, 7, 4, 7};
+  rc = tiledb_query_reset(ctx_, query, subarray_2);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_get_status(ctx_, query, &status);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(status == TILEDB_COMPLETED);
+  CHECK(buffer_sizes[0] == sizeof(buffer));
+  for (int i = 0; i < 16; ++i)
+    CHECK(buffer[i] == (int)((4 + i / 4) * domain_size_1 + 4 + i % 4));
+
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Resetting a write query errors
+  rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_reset(ctx_, query, subarray_1);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+}
+
+void DenseArrayFx::check_cache_hint(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 16;
+  int64_t domain_size_1 = 16;
+  int64_t tile_extent_0 = 4;
+  int64_t tile_extent_1 = 4;
+  std::string array_name = path + "cache_hint_array";
+
+  // Create and populate a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      100,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Reads the full domain with the input cache hint and retrieves the
+  // per-query statistics
+  auto read_with_hint = [&](tiledb_cache_hint_t hint,
+                            tiledb_query_stats_t* stats) {
+    const char* attributes[] = {ATTR_NAME};
+    std::vector<int> buffer((size_t)(domain_size_0 * domain_size_1));
+    void* buffers[] = {&buffer[0]};
+    uint64_t buffer_sizes[] = {buffer.size() * sizeof(int)};
+    int64_t subarray[] = {0, domain_size_0 - 1, 0, domain_size_1 - 1};
+    tiledb_query_t* query;
+    int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx_, query, attributes, 1, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarray);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_cache_hint(ctx_, query, hint);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_finalize(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_get_stats(ctx_, query, stats);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
+
+    // The read result itself must be correct under any hint
+    for (int64_t i = 0; i < domain_size_0 * domain_size_1; ++i)
+      REQUIRE(buffer[(size_t)i] == (int)i);
+  };
+
+  // A cold streaming read misses the (empty) tile cache on every tile
+  // and, due to the bypass hint, must not populate it
+  tiledb_query_stats_t stats;
+  read_with_hint(TILEDB_CACHE_BYPASS, &stats);
+  CHECK(stats.tiles_fetched > 0);
+  CHECK(stats.cache_hits == 0);
+  CHECK(stats.cache_misses == stats.tiles_fetched);
+
+  // A default read of the same tiles still misses on every tile, which
+  // proves the bypass read left the cache unpopulated; this one inserts
+  // its tiles
+  read_with_hint(TILEDB_CACHE_DEFAULT, &stats);
+  CHECK(stats.cache_hits == 0);
+  CHECK(stats.cache_misses == stats.tiles_fetched);
+
+  // A further default read is served from the tile cache
+  read_with_hint(TILEDB_CACHE_DEFAULT, &stats);
+  CHECK(stats.cache_hits == stats.tiles_fetched);
+  CHECK(stats.cache_misses == 0);
+}
+
+void DenseArrayFx::check_sorted_writes(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "sorted_writes_array";
+
+  // Create a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+
+  // Write random subarray, then read it back and check
+  int64_t d0[2], d1[2];
+  for (int i = 0; i < ITER_NUM; ++i) {
+    // Create subarray
+    d0[0] = std::rand() % domain_size_0;
+    d1[0] = std::rand() % domain_size_1;
+    d0[1] = d0[0] + std::rand() % (domain_size_0 - d0[0]);
+    d1[1] = d1[0] + std::rand() % (domain_size_1 - d1[0]);
+    int64_t subarray[] = {d0[0], d0[1], d1[0], d1[1]};
+
+    // Prepare buffers
+    int64_t subarray_length[2] = {d0[1] - d0[0] + 1, d1[1] - d1[0] + 1};
+    int64_t cell_num_in_subarray = subarray_length[0] * subarray_length[1];
+    auto buffer = new int[cell_num_in_subarray];
+    int64_t index = 0;
+    uint64_t buffer_size = cell_num_in_subarray * sizeof(int);
+    uint64_t buffer_sizes[] = {buffer_size};
+    for (int64_t r = 0; r < subarray_length[0]; ++r)
+      for (int64_t c = 0; c < subarray_length[1]; ++c)
+        buffer[index++] = -(std::rand() % 999999);
+
+    // Write 2D subarray
+    write_dense_subarray_2D(
+        array_name,
+        subarray,
+        TILEDB_WRITE,
+        TILEDB_ROW_MAJOR,
+        buffer,
+        buffer_sizes);
+
+    // Read back the same subarray
+    int* read_buffer = read_dense_array_2D(
+        array_name,
+        subarray[0],
+        subarray[1],
+        subarray[2],
+        subarray[3],
+        TILEDB_READ,
+        TILEDB_ROW_MAJOR);
+    REQUIRE(read_buffer != NULL);
+
+    // Check the two buffers
+    bool allok = true;
+    for (index = 0; index < cell_num_in_subarray; ++index) {
+      if (buffer[index] != read_buffer[index]) {
+        allok = false;
+        break;
+      }
+    }
+    REQUIRE(allok);
+
+    // Clean up
+    delete[] buffer;
+    delete[] read_buffer;
+  }
+}
+
+void DenseArrayFx::check_invalid_global_writes(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  std::string array_name = path + "invalid_writes_array";
+
+  // Create a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+
+  const char* attributes[] = {ATTR_NAME};
+  int buffer[3] = {1, 2, 3};
+  void* buffers[] = {buffer};
+  uint64_t buffer_sizes[] = {sizeof(buffer)};
+
+  // Create query
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 1, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Submit query
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_ERR);
+
+  // Free query
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+}
+
+void DenseArrayFx::check_sparse_writes(const std::string& path) {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t domain_0_lo = 0;
+  int64_t domain_0_hi = domain_size_0 - 1;
+  int64_t domain_1_lo = 0;
+  int64_t domain_1_hi = domain_size_1 - 1;
+  uint64_t capacity = 1000;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  uint64_t update_num = 100;
+  int seed = 7;
+  std::string array_name = path + "sparse_writes_array";
+
+  // Create a dense integer array
+  create_dense_array_2D(
+      array_name,
+      tile_extent_0,
+      tile_extent_1,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      capacity,
+      cell_order,
+      tile_order);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  // to disk tile by tile
+  write_dense_array_by_tiles(
+      array_name, domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+
+  // Read the entire array back to memory
+  int* before_update = read_dense_array_2D(
+      array_name,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      TILEDB_READ,
+      TILEDB_GLOBAL_ORDER);
+  REQUIRE(before_update != NULL);
+
+  // Prepare random updates
+  auto buffer_a1 = new int[update_num];
+  auto buffer_coords = new int64_t[2 * update_num];
+  void* buffers[] = {buffer_a1, buffer_coords};
+  uint64_t buffer_sizes[2];
+  buffer_sizes[0] = update_num * sizeof(int);
+  buffer_sizes[1] = 2 * update_num * sizeof(int64_t);
+
+  update_dense_array_2D(
+      array_name,
+      domain_size_0,
+      domain_size_1,
+      update_num,
+      seed,
+      buffers,
+      buffer_sizes);
+
+  // Read the entire array back to memory after update
+  int* after_update = read_dense_array_2D(
+      array_name,
+      domain_0_lo,
+      domain_0_hi,
+      domain_1_lo,
+      domain_1_hi,
+      TILEDB_READ,
+      TILEDB_GLOBAL_ORDER);
+  REQUIRE(after_update != NULL);
+
+  // Compare array before and after
+  check_buffer_after_updates(
+      before_update,
+      after_update,
+      buffer_a1,
+      buffer_coords,
+      domain_size_0,
       domain_size_1,
       update_num);
 
@@ -1027,6 +2253,259 @@ TEST_CASE_METHOD(
   }
 }
 
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, opened array reads",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_opened_array_reads(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_opened_array_reads(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_opened_array_reads(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, batch reads",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_batch_reads(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_batch_reads(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_batch_reads(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, preload reads",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_preload_reads(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_preload_reads(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_preload_reads(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, subarray partitioning",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_subarray_partitioning(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_subarray_partitioning(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_subarray_partitioning(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, query plan",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_query_plan(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_query_plan(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_query_plan(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, completion queue reads",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_completion_queue_reads(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_completion_queue_reads(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_completion_queue_reads(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, tile-aligned reads",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_tile_aligned_reads(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_tile_aligned_reads(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_tile_aligned_reads(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, aggregates",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_aggregates(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_aggregates(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_aggregates(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, predicates",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_predicates(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_predicates(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_predicates(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, query-allocated buffers",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_alloc_buffers(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_alloc_buffers(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_alloc_buffers(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, query reset",
+    "[capi], [dense]") {
+  if (supports_s3_) {
+    // S3
+    create_temp_dir(S3_TEMP_DIR);
+    check_reset_reads(S3_TEMP_DIR);
+    remove_temp_dir(S3_TEMP_DIR);
+  } else if (supports_hdfs_) {
+    // HDFS
+    create_temp_dir(HDFS_TEMP_DIR);
+    check_reset_reads(HDFS_TEMP_DIR);
+    remove_temp_dir(HDFS_TEMP_DIR);
+  } else {
+    // File
+    create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    check_reset_reads(FILE_URI_PREFIX + FILE_TEMP_DIR);
+    remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense array, cache hint",
+    "[capi], [dense]") {
+  // The check relies on the tiles of the array being absent from the
+  // tile cache, so it uses a fresh array on the local filesystem
+  create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  check_cache_hint(FILE_URI_PREFIX + FILE_TEMP_DIR);
+  remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+}
+
 TEST_CASE_METHOD(
     DenseArrayFx,
     "C API: Test dense array, invalid global writes",
@@ -93,10 +93,14 @@ struct KVFx {
   void check_single_read(const std::string& path);
   void check_read_on_attribute_subset(const std::string& path);
   void check_iter(const std::string& path);
+  void check_iter_read_ahead(const std::string& path);
   void check_kv_item();
   void check_kv_item(tiledb_kv_item_t* kv_item);
   void check_interleaved_read_write(const std::string& path);
+  void check_cached_read(const std::string& path);
+  void check_multi_get(const std::string& path);
   void check_write(const std::string& path);
+  void check_bulk_write(const std::string& path);
   void create_kv(const std::string& path);
   void create_temp_dir(const std::string& path);
   void remove_temp_dir(const std::string& path);
@@ -441,6 +445,84 @@ void KVFx::check_write(const std::string& path) {
   CHECK(kv_item6 == nullptr);
 }
 
+void KVFx::check_bulk_write(const std::string& path) {
+  tiledb_kv_t* kv;
+  int rc = tiledb_kv_open(ctx_, &kv, path.c_str(), nullptr, 0);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Three items in columnar form
+  const char keys[] = "bk_1bk_22bk_333";
+  uint64_t key_offsets[] = {0, 4, 9};
+  uint64_t keys_size = sizeof(keys) - 1;
+  int a1_values[] = {11, 22, 33};
+  const char a2_values[] = "xyyzzz";
+  uint64_t a2_offsets[] = {0, 1, 3};
+  float a3_values[] = {1.1f, 1.2f, 2.1f, 2.2f, 3.1f, 3.2f};
+  const void* values[] = {a1_values, a2_values, a3_values};
+  uint64_t value_sizes[] = {sizeof(a1_values),
+                            sizeof(a2_values) - 1,
+                            sizeof(a3_values)};
+  const uint64_t* value_offsets[] = {nullptr, a2_offsets, nullptr};
+
+  // Add the items in bulk
+  rc = tiledb_kv_add_items(
+      ctx_,
+      kv,
+      3,
+      keys,
+      key_offsets,
+      keys_size,
+      TILEDB_CHAR,
+      values,
+      value_sizes,
+      value_offsets);
+  CHECK(rc == TILEDB_OK);
+
+  // Flush
+  rc = tiledb_kv_flush(ctx_, kv);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read the items back and check their values
+  const void *a1, *a2, *a3;
+  uint64_t a1_size, a2_size, a3_size;
+  tiledb_datatype_t a1_type, a2_type, a3_type;
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto key = &keys[key_offsets[i]];
+    auto key_size = ((i < 2) ? key_offsets[i + 1] : keys_size) - key_offsets[i];
+    tiledb_kv_item_t* kv_item;
+    rc = tiledb_kv_get_item(ctx_, kv, &kv_item, key, TILEDB_CHAR, key_size);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(kv_item != nullptr);
+    rc = tiledb_kv_item_get_value(
+        ctx_, kv_item, ATTR_1, &a1, &a1_type, &a1_size);
+    CHECK(rc == TILEDB_OK);
+    CHECK(*(const int*)a1 == a1_values[i]);
+    CHECK(a1_type == TILEDB_INT32);
+    CHECK(a1_size == sizeof(int));
+    rc = tiledb_kv_item_get_value(
+        ctx_, kv_item, ATTR_2, &a2, &a2_type, &a2_size);
+    CHECK(rc == TILEDB_OK);
+    auto a2_value_size =
+        ((i < 2) ? a2_offsets[i + 1] : sizeof(a2_values) - 1) - a2_offsets[i];
+    CHECK(a2_size == a2_value_size);
+    CHECK(!memcmp(a2, &a2_values[a2_offsets[i]], a2_value_size));
+    CHECK(a2_type == TILEDB_CHAR);
+    rc = tiledb_kv_item_get_value(
+        ctx_, kv_item, ATTR_3, &a3, &a3_type, &a3_size);
+    CHECK(rc == TILEDB_OK);
+    CHECK(!memcmp(a3, &a3_values[2 * i], 2 * sizeof(float)));
+    CHECK(a3_type == TILEDB_FLOAT32);
+    CHECK(a3_size == 2 * sizeof(float));
+    rc = tiledb_kv_item_free(ctx_, &kv_item);
+    REQUIRE(rc == TILEDB_OK);
+  }
+
+  // Close kv
+  rc = tiledb_kv_close(ctx_, &kv);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(kv == nullptr);
+}
+
 void KVFx::check_single_read(const std::string& path) {
   // Open key-value store
   const char* attributes[] = {ATTR_1, ATTR_2, ATTR_3};
@@ -783,6 +865,140 @@ void KVFx::check_interleaved_read_write(const std::string& path) {
   REQUIRE(rc == TILEDB_OK);
 }
 
+void KVFx::check_cached_read(const std::string& path) {
+  // Open the key-value store
+  tiledb_kv_t* kv;
+  int rc = tiledb_kv_open(ctx_, &kv, path.c_str(), nullptr, 0);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Write and flush an item
+  int key = 456;
+  int value = 456456;
+  tiledb_kv_item_t* kv_item1;
+  rc = tiledb_kv_item_create(ctx_, &kv_item1);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_kv_item_set_key(ctx_, kv_item1, &key, TILEDB_INT32, sizeof(int));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_item_set_value(
+      ctx_, kv_item1, ATTR_1, &value, TILEDB_INT32, sizeof(int));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_item_set_value(
+      ctx_, kv_item1, ATTR_2, KEY1_A2, TILEDB_CHAR, strlen(KEY1_A2) + 1);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_item_set_value(
+      ctx_, kv_item1, ATTR_3, KEY1_A3, TILEDB_FLOAT32, 2 * sizeof(float));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_add_item(ctx_, kv, kv_item1);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_flush(ctx_, kv);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Get the item twice; the first get reads from disk and caches the
+  // item, the second is served from the item cache
+  const void* a1;
+  tiledb_datatype_t a1_type;
+  uint64_t a1_size;
+  for (int i = 0; i < 2; ++i) {
+    tiledb_kv_item_t* kv_item2;
+    rc = tiledb_kv_get_item(
+        ctx_, kv, &kv_item2, &key, TILEDB_INT32, sizeof(int));
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_kv_item_get_value(
+        ctx_, kv_item2, ATTR_1, &a1, &a1_type, &a1_size);
+    CHECK(rc == TILEDB_OK);
+    CHECK(*(int*)a1 == value);
+    CHECK(a1_type == TILEDB_INT32);
+    CHECK(a1_size == sizeof(int));
+    rc = tiledb_kv_item_free(ctx_, &kv_item2);
+    REQUIRE(rc == TILEDB_OK);
+  }
+
+  // Overwrite the item and flush; the flush invalidates the item cache
+  int new_value = 654654;
+  rc = tiledb_kv_item_set_value(
+      ctx_, kv_item1, ATTR_1, &new_value, TILEDB_INT32, sizeof(int));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_add_item(ctx_, kv, kv_item1);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_kv_flush(ctx_, kv);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Get the item again and check that the new value is visible
+  tiledb_kv_item_t* kv_item3;
+  rc =
+      tiledb_kv_get_item(ctx_, kv, &kv_item3, &key, TILEDB_INT32, sizeof(int));
+  REQUIRE(rc == TILEDB_OK);
+  rc =
+      tiledb_kv_item_get_value(ctx_, kv_item3, ATTR_1, &a1, &a1_type, &a1_size);
+  CHECK(rc == TILEDB_OK);
+  CHECK(*(int*)a1 == new_value);
+
+  // Close key-value store
+  rc = tiledb_kv_close(ctx_, &kv);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Clean up
+  rc = tiledb_kv_item_free(ctx_, &kv_item1);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_kv_item_free(ctx_, &kv_item3);
+  REQUIRE(rc == TILEDB_OK);
+}
+
+void KVFx::check_multi_get(const std::string& path) {
+  // Open the key-value store
+  const char* attributes[] = {ATTR_1};
+  tiledb_kv_t* kv;
+  int rc = tiledb_kv_open(ctx_, &kv, path.c_str(), attributes, 1);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Prepare the key batch; `key2` appears twice and `key5` does not
+  // exist in the store
+  const char* key5 = "invalid";
+  const void* keys[] = {&KEY1, &KEY2, KEY3, KEY4, key5, &KEY2};
+  tiledb_datatype_t key_types[] = {TILEDB_INT32,
+                                   TILEDB_FLOAT32,
+                                   TILEDB_FLOAT64,
+                                   TILEDB_CHAR,
+                                   TILEDB_CHAR,
+                                   TILEDB_FLOAT32};
+  uint64_t key_sizes[] = {sizeof(int),
+                          sizeof(float),
+                          2 * sizeof(double),
+                          strlen(KEY4) + 1,
+                          strlen(key5) + 1,
+                          sizeof(float)};
+
+  // Get all the items in a single batch
+  tiledb_kv_item_t* kv_items[6];
+  rc = tiledb_kv_get_items(ctx_, kv, kv_items, 6, keys, key_types, key_sizes);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Check the values
+  const int expected[] = {KEY1_A1, KEY2_A1, KEY3_A1, KEY4_A1, 0, KEY2_A1};
+  const void* a1;
+  tiledb_datatype_t a1_type;
+  uint64_t a1_size;
+  for (unsigned i = 0; i < 6; ++i) {
+    if (i == 4) {  // The non-existing key
+      CHECK(kv_items[i] == nullptr);
+      continue;
+    }
+    REQUIRE(kv_items[i] != nullptr);
+    rc = tiledb_kv_item_get_value(
+        ctx_, kv_items[i], ATTR_1, &a1, &a1_type, &a1_size);
+    CHECK(rc == TILEDB_OK);
+    CHECK(*(int*)a1 == expected[i]);
+    CHECK(a1_type == TILEDB_INT32);
+    CHECK(a1_size == sizeof(int));
+    rc = tiledb_kv_item_free(ctx_, &kv_items[i]);
+    REQUIRE(rc == TILEDB_OK);
+  }
+
+  // Close key-value store
+  rc = tiledb_kv_close(ctx_, &kv);
+  REQUIRE(rc == TILEDB_OK);
+}
+
 void KVFx::check_kv_item(tiledb_kv_item_t* kv_item) {
   const void *key, *value;
   tiledb_datatype_t key_type, value_type;
@@ -903,6 +1119,89 @@ void KVFx::check_iter(const std::string& path) {
   REQUIRE(rc == TILEDB_OK);
 }
 
+void KVFx::check_iter_read_ahead(const std::string& path) {
+  // Write enough items to span multiple iterator batches
+  const unsigned ITEM_NUM = 300;
+  tiledb_kv_t* kv;
+  int rc = tiledb_kv_open(ctx_, &kv, path.c_str(), nullptr, 0);
+  REQUIRE(rc == TILEDB_OK);
+  for (unsigned i = 0; i < ITEM_NUM; ++i) {
+    tiledb_kv_item_t* kv_item;
+    rc = tiledb_kv_item_create(ctx_, &kv_item);
+    REQUIRE(rc == TILEDB_OK);
+    int key = (int)i;
+    rc = tiledb_kv_item_set_key(ctx_, kv_item, &key, TILEDB_INT32, sizeof(int));
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_kv_item_set_value(
+        ctx_, kv_item, ATTR_1, &key, TILEDB_INT32, sizeof(int));
+    CHECK(rc == TILEDB_OK);
+    std::string a2 = std::to_string(i);
+    rc = tiledb_kv_item_set_value(
+        ctx_, kv_item, ATTR_2, a2.c_str(), TILEDB_CHAR, a2.size() + 1);
+    CHECK(rc == TILEDB_OK);
+    float a3[] = {(float)i, (float)i + 0.5f};
+    rc = tiledb_kv_item_set_value(
+        ctx_, kv_item, ATTR_3, a3, TILEDB_FLOAT32, 2 * sizeof(float));
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_kv_add_item(ctx_, kv, kv_item);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_kv_item_free(ctx_, &kv_item);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  rc = tiledb_kv_flush(ctx_, kv);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_kv_close(ctx_, &kv);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Iterate over the store, checking that every item is visited once
+  const char* attributes[] = {ATTR_1};
+  tiledb_kv_iter_t* kv_iter;
+  rc = tiledb_kv_iter_create(ctx_, &kv_iter, path.c_str(), attributes, 1);
+  REQUIRE(rc == TILEDB_OK);
+  std::vector<bool> seen(ITEM_NUM, false);
+  int done;
+  rc = tiledb_kv_iter_done(ctx_, kv_iter, &done);
+  REQUIRE(rc == TILEDB_OK);
+  while (!(bool)done) {
+    tiledb_kv_item_t* kv_item;
+    rc = tiledb_kv_iter_here(ctx_, kv_iter, &kv_item);
+    REQUIRE(rc == TILEDB_OK);
+    const void* key;
+    tiledb_datatype_t key_type;
+    uint64_t key_size;
+    rc = tiledb_kv_item_get_key(ctx_, kv_item, &key, &key_type, &key_size);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(key_type == TILEDB_INT32);
+    REQUIRE(key_size == sizeof(int));
+    int k = *(const int*)key;
+    REQUIRE(k >= 0);
+    REQUIRE(k < (int)ITEM_NUM);
+    REQUIRE(!seen[k]);
+    seen[k] = true;
+    const void* value;
+    tiledb_datatype_t value_type;
+    uint64_t value_size;
+    rc = tiledb_kv_item_get_value(
+        ctx_, kv_item, ATTR_1, &value, &value_type, &value_size);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(value_type == TILEDB_INT32);
+    REQUIRE(value_size == sizeof(int));
+    REQUIRE(*(const int*)value == k);
+    rc = tiledb_kv_item_free(ctx_, &kv_item);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_kv_iter_next(ctx_, kv_iter);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_kv_iter_done(ctx_, kv_iter, &done);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  for (unsigned i = 0; i < ITEM_NUM; ++i)
+    CHECK(seen[i]);
+
+  // Clean up
+  rc = tiledb_kv_iter_free(ctx_, &kv_iter);
+  REQUIRE(rc == TILEDB_OK);
+}
+
 TEST_CASE_METHOD(KVFx, "C API: Test key-value", "[capi], [kv]") {
   std::string array_name;
 
@@ -916,6 +1215,12 @@ TEST_CASE_METHOD(KVFx, "C API: Test key-value", "[capi], [kv]") {
     check_read_on_attribute_subset(array_name);
     check_iter(array_name);
     check_interleaved_read_write(array_name);
+    check_cached_read(array_name);
+    check_multi_get(array_name);
+    create_kv(array_name + "_bulk");
+    check_bulk_write(array_name + "_bulk");
+    create_kv(array_name + "_iter");
+    check_iter_read_ahead(array_name + "_iter");
     remove_temp_dir(S3_TEMP_DIR);
   } else if (supports_hdfs_) {
     create_temp_dir(HDFS_TEMP_DIR);
@@ -926,6 +1231,12 @@ TEST_CASE_METHOD(KVFx, "C API: Test key-value", "[capi], [kv]") {
     check_read_on_attribute_subset(array_name);
     check_iter(array_name);
     check_interleaved_read_write(array_name);
+    check_cached_read(array_name);
+    check_multi_get(array_name);
+    create_kv(array_name + "_bulk");
+    check_bulk_write(array_name + "_bulk");
+    create_kv(array_name + "_iter");
+    check_iter_read_ahead(array_name + "_iter");
     remove_temp_dir(HDFS_TEMP_DIR);
   } else {
     // File
@@ -938,6 +1249,12 @@ TEST_CASE_METHOD(KVFx, "C API: Test key-value", "[capi], [kv]") {
     check_read_on_attribute_subset(array_name);
     check_iter(array_name);
     check_interleaved_read_write(array_name);
+    check_cached_read(array_name);
+    check_multi_get(array_name);
+    create_kv(array_name + "_bulk");
+    check_bulk_write(array_name + "_bulk");
+    create_kv(array_name + "_iter");
+    check_iter_read_ahead(array_name + "_iter");
     remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
   }
 }
@@ -38,12 +38,18 @@
 #include "tiledb/sm/filesystem/posix_filesystem.h"
 #endif
 #include "tiledb/sm/c_api/tiledb.h"
+#include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <ctime>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <sstream>
 #include <thread>
@@ -166,6 +172,60 @@ struct SparseArrayFx {
       int64_t domain_size_0,
       int64_t domain_size_1,
       int iter_num);
+
+  /**
+   * Checks that reads whose internal subarray partitioning is forced by
+   * a tiny `sm.read_partition_budget` return exactly the same result as
+   * un-partitioned reads.
+   */
+  void check_partitioned_reads(const std::string& array_name);
+
+  /**
+   * Checks that an asynchronous read submitted with
+   * `tiledb_query_submit_async_progress` invokes the progress callback
+   * once per completed internal subarray partition, exposing the copied
+   * (final) prefix of the user buffers through the buffer sizes.
+   */
+  void check_async_progress_reads(const std::string& array_name);
+
+  /**
+   * Checks that unordered reads return every result cell exactly once
+   * (in some order), including when the cells are overwritten by a
+   * newer fragment.
+   */
+  void check_unordered_reads(const std::string& array_name);
+
+  /**
+   * Checks that many small unordered writes submitted with
+   * `sm.write_combining_budget` set get merged into a single fragment
+   * and that a subsequent read observes all of them.
+   */
+  void check_combined_writes(const std::string& array_name);
+
+  /**
+   * Checks that a context configured with `sm.array_open_timestamp` set
+   * to a time between two writes observes only the first one.
+   */
+  void check_open_at_timestamp(const std::string& array_name);
+
+  void check_aggregates(const std::string& array_name);
+
+  /**
+   * Checks that reads with attribute value predicates return exactly
+   * the selected cells.
+   *
+   * @param array_name The array name.
+   */
+  void check_predicates(const std::string& array_name);
+
+  /**
+   * Checks that reading the coordinates back returns the correct
+   * (zipped) values. Exercises the unzipped in-memory layout of
+   * compressed coordinate tiles.
+   *
+   * @param array_name The array name.
+   */
+  void check_coords_reads(const std::string& array_name);
 };
 
 SparseArrayFx::SparseArrayFx() {
@@ -532,6 +592,786 @@ void SparseArrayFx::check_sorted_reads(
   test_random_subarrays(array_name, domain_size_0, domain_size_1, iter_num);
 }
 
+void SparseArrayFx::check_partitioned_reads(const std::string& array_name) {
+  // Small array; the tiny partition budget below still forces the reads
+  // to be split into many internal subarray partitions
+  int64_t domain_size_0 = 200;
+  int64_t domain_size_1 = 200;
+  int64_t cell_num = domain_size_0 * domain_size_1;
+
+  create_sparse_array_2D(
+      array_name,
+      25,
+      25,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // Read the full array with the default (large) partition budget
+  int* expected_row = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  CHECK(expected_row != nullptr);
+  int* expected_global = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_GLOBAL_ORDER);
+  CHECK(expected_global != nullptr);
+
+  // Swap in a context with a tiny partition budget; the read helpers
+  // use `ctx_`
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(
+          config, "sm.read_partition_budget", "10000", &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* old_ctx = ctx_;
+  tiledb_ctx_t* ctx = nullptr;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+  ctx_ = ctx;
+
+  int* buffer_row = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  CHECK(buffer_row != nullptr);
+  int* buffer_global = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_GLOBAL_ORDER);
+  CHECK(buffer_global != nullptr);
+
+  ctx_ = old_ctx;
+  REQUIRE(tiledb_ctx_free(&ctx) == TILEDB_OK);
+
+  // The partitioned reads must return exactly the same result
+  CHECK(!std::memcmp(buffer_row, expected_row, cell_num * sizeof(int)));
+  CHECK(!std::memcmp(buffer_global, expected_global, cell_num * sizeof(int)));
+
+  // The row-major full-domain read is the written value sequence
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    if (buffer_row[i] != (int)i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+
+  delete[] expected_row;
+  delete[] expected_global;
+  delete[] buffer_row;
+  delete[] buffer_global;
+}
+
+/** Callback state for `check_async_progress_reads`. */
+struct AsyncProgressState {
+  /** The buffer sizes array passed to `tiledb_query_set_buffers`. */
+  uint64_t* buffer_sizes;
+  /** The result buffer of the attribute. */
+  int* buffer;
+  /** The buffer size observed at each progress callback invocation. */
+  std::vector<uint64_t> progress_sizes;
+  /** `false` if a progress invocation observed an incorrect prefix. */
+  bool prefix_ok;
+  /** Set to `true` by the completion callback. */
+  std::atomic<bool> done;
+};
+
+static void async_progress_callback(void* data) {
+  auto state = (AsyncProgressState*)data;
+  auto size = state->buffer_sizes[0];
+  state->progress_sizes.push_back(size);
+
+  // The exposed prefix is final; for a row-major full-domain read it is
+  // the value sequence 0, 1, 2, ...
+  for (uint64_t i = 0; i < size / sizeof(int); ++i) {
+    if (state->buffer[i] != (int)i) {
+      state->prefix_ok = false;
+      return;
+    }
+  }
+}
+
+static void async_progress_done_callback(void* data) {
+  ((AsyncProgressState*)data)->done = true;
+}
+
+void SparseArrayFx::check_async_progress_reads(const std::string& array_name) {
+  int64_t domain_size_0 = 200;
+  int64_t domain_size_1 = 200;
+  int64_t cell_num = domain_size_0 * domain_size_1;
+
+  create_sparse_array_2D(
+      array_name,
+      25,
+      25,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // A context with a tiny partition budget, so that the read is split
+  // into many internal subarray partitions
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(
+          config, "sm.read_partition_budget", "10000", &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* ctx = nullptr;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+
+  // Prepare a full-domain row-major read whose buffers fit the entire
+  // result, so that partitions complete within a single submission
+  const int64_t subarray[] = {
+      0, domain_size_0 - 1, 0, domain_size_1 - 1};
+  const char* attributes[] = {ATTR_NAME};
+  std::vector<int> buffer((size_t)cell_num);
+  void* buffers[] = {&buffer[0]};
+  uint64_t buffer_sizes[] = {cell_num * sizeof(int)};
+
+  AsyncProgressState state;
+  state.buffer_sizes = buffer_sizes;
+  state.buffer = &buffer[0];
+  state.prefix_ok = true;
+  state.done = false;
+
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx, query, attributes, 1, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx, query, subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+
+  rc = tiledb_query_submit_async_progress(
+      ctx,
+      query,
+      async_progress_done_callback,
+      &state,
+      async_progress_callback,
+      &state);
+  REQUIRE(rc == TILEDB_OK);
+  while (!state.done)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  tiledb_query_status_t status;
+  rc = tiledb_query_get_status(ctx, query, &status);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(status == TILEDB_COMPLETED);
+  rc = tiledb_query_free(ctx, &query);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(tiledb_ctx_free(&ctx) == TILEDB_OK);
+
+  // The progress callback must have observed intermediate results:
+  // invoked at least once before completion, with the exposed sizes
+  // strictly growing and each a strict prefix of the final result
+  CHECK(state.progress_sizes.size() > 1);
+  uint64_t prev_size = 0;
+  for (auto size : state.progress_sizes) {
+    CHECK(size > prev_size);
+    CHECK(size < cell_num * sizeof(int));
+    prev_size = size;
+  }
+  CHECK(state.prefix_ok);
+
+  // The completed read is the full value sequence
+  CHECK(buffer_sizes[0] == cell_num * sizeof(int));
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    if (buffer[i] != (int)i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+}
+
+void SparseArrayFx::check_unordered_reads(const std::string& array_name) {
+  int64_t domain_size_0 = 200;
+  int64_t domain_size_1 = 200;
+  int64_t cell_num = domain_size_0 * domain_size_1;
+
+  create_sparse_array_2D(
+      array_name,
+      25,
+      25,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Write the same cells twice, producing two fragments; the unordered
+  // read must prune the overwritten copies
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // The result buffer fits exactly `cell_num` cells, so any remaining
+  // duplicate would make the read fail with an overflow
+  int* buffer = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_UNORDERED);
+  CHECK(buffer != nullptr);
+
+  // In some order, every cell value must appear exactly once
+  std::sort(buffer, buffer + cell_num);
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    if (buffer[i] != (int)i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+
+  delete[] buffer;
+}
+
+void SparseArrayFx::check_combined_writes(const std::string& array_name) {
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t cell_num = domain_size_0 * domain_size_1;
+
+  create_sparse_array_2D(
+      array_name,
+      10,
+      10,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Swap in a context with write combining enabled; the read helper
+  // uses `ctx_`
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(
+          config, "sm.write_combining_budget", "10000000", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* old_ctx = ctx_;
+  tiledb_ctx_t* ctx = nullptr;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+  ctx_ = ctx;
+
+  // Submit one small unordered write per row; each would normally
+  // produce its own fragment
+  for (int64_t i = 0; i < domain_size_0; ++i) {
+    auto buffer_a1 = new int[domain_size_1];
+    auto buffer_coords = new int64_t[2 * domain_size_1];
+    for (int64_t j = 0; j < domain_size_1; ++j) {
+      buffer_a1[j] = (int)(i * domain_size_1 + j);
+      buffer_coords[2 * j] = i;
+      buffer_coords[2 * j + 1] = j;
+    }
+    void* buffers[] = {buffer_a1, buffer_coords};
+    uint64_t buffer_sizes[2];
+    buffer_sizes[0] = domain_size_1 * sizeof(int);
+    buffer_sizes[1] = 2 * domain_size_1 * sizeof(int64_t);
+    const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+
+    tiledb_query_t* query;
+    int rc =
+        tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx_, query, attributes, 2, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_UNORDERED);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_finalize(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
+
+    delete[] buffer_a1;
+    delete[] buffer_coords;
+  }
+
+  // The read flushes the pending writes and must observe all of them
+  int* buffer = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  CHECK(buffer != nullptr);
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    if (buffer[i] != (int)i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+  delete[] buffer;
+
+  ctx_ = old_ctx;
+  REQUIRE(tiledb_ctx_free(&ctx) == TILEDB_OK);
+
+  // All the writes must have been combined into a single fragment
+  // (a fragment is a subdirectory of the array directory)
+  tiledb::sm::VFS vfs;
+  std::vector<tiledb::sm::URI> uris;
+  REQUIRE(vfs.ls(tiledb::sm::URI(array_name), &uris).ok());
+  unsigned fragment_num = 0;
+  for (const auto& uri : uris) {
+    bool is_dir = false;
+    REQUIRE(vfs.is_dir(uri, &is_dir).ok());
+    fragment_num += (unsigned)is_dir;
+  }
+  CHECK(fragment_num == 1);
+}
+
+void SparseArrayFx::check_open_at_timestamp(const std::string& array_name) {
+  int64_t domain_size_0 = 20;
+  int64_t domain_size_1 = 20;
+  int64_t cell_num = domain_size_0 * domain_size_1;
+
+  create_sparse_array_2D(
+      array_name,
+      10,
+      10,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // First write: cell value = row id * columns + col id
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // Capture a timestamp strictly between the two writes; the fragment
+  // timestamps have millisecond resolution
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  uint64_t timestamp = tiledb::sm::utils::timestamp_ms();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // Second write: overwrite every cell with value + cell_num
+  auto buffer_a1 = new int[cell_num];
+  auto buffer_coords = new int64_t[2 * cell_num];
+  for (int64_t i = 0; i < domain_size_0; ++i) {
+    for (int64_t j = 0; j < domain_size_1; ++j) {
+      int64_t c = i * domain_size_1 + j;
+      buffer_a1[c] = (int)(c + cell_num);
+      buffer_coords[2 * c] = i;
+      buffer_coords[2 * c + 1] = j;
+    }
+  }
+  void* buffers[] = {buffer_a1, buffer_coords};
+  uint64_t buffer_sizes[2];
+  buffer_sizes[0] = cell_num * sizeof(int);
+  buffer_sizes[1] = 2 * cell_num * sizeof(int64_t);
+  const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 2, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_UNORDERED);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+  delete[] buffer_a1;
+  delete[] buffer_coords;
+
+  // A read at the current time observes the second write
+  int* buffer = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  CHECK(buffer != nullptr);
+  bool allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    if (buffer[i] != (int)(i + cell_num)) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+  delete[] buffer;
+
+  // A read at the captured timestamp observes only the first write;
+  // the read helper uses `ctx_`
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(
+          config,
+          "sm.array_open_timestamp",
+          std::to_string(timestamp).c_str(),
+          &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_t* old_ctx = ctx_;
+  tiledb_ctx_t* ctx = nullptr;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+  ctx_ = ctx;
+
+  buffer = read_sparse_array_2D(
+      array_name,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  CHECK(buffer != nullptr);
+  allok = true;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    if (buffer[i] != (int)i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+  delete[] buffer;
+
+  ctx_ = old_ctx;
+  REQUIRE(tiledb_ctx_free(&ctx) == TILEDB_OK);
+}
+
+void SparseArrayFx::check_aggregates(const std::string& array_name) {
+  int64_t domain_size_0 = 200;
+  int64_t domain_size_1 = 200;
+
+  create_sparse_array_2D(
+      array_name,
+      25,
+      25,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Write array cells with value = row id * columns + col id
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // Checks the aggregates of a subarray against the expected values
+  auto check_aggregate = [&](
+      int64_t d0_lo, int64_t d0_hi, int64_t d1_lo, int64_t d1_hi) {
+    const int64_t subarray[] = {d0_lo, d0_hi, d1_lo, d1_hi};
+    tiledb_query_t* query;
+    int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarray);
+    REQUIRE(rc == TILEDB_OK);
+
+    uint64_t count = 0;
+    int min = 0, max = 0;
+    int64_t sum = 0;
+    rc = tiledb_query_aggregate(ctx_, query, ATTR_NAME, &count, &min, &max, &sum);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Compute the expected aggregates
+    uint64_t e_count = 0;
+    int64_t e_sum = 0;
+    int e_min = std::numeric_limits<int>::max();
+    int e_max = std::numeric_limits<int>::min();
+    for (int64_t i = d0_lo; i <= d0_hi; ++i) {
+      for (int64_t j = d1_lo; j <= d1_hi; ++j) {
+        auto v = (int)(i * domain_size_1 + j);
+        ++e_count;
+        e_sum += v;
+        e_min = std::min(e_min, v);
+        e_max = std::max(e_max, v);
+      }
+    }
+    CHECK(count == e_count);
+    CHECK(min == e_min);
+    CHECK(max == e_max);
+    CHECK(sum == e_sum);
+
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
+  };
+
+  // Single fragment: the full domain is answered from the metadata
+  // statistics alone; the second subarray crosses tile boundaries
+  check_aggregate(0, domain_size_0 - 1, 0, domain_size_1 - 1);
+  check_aggregate(3, 141, 10, 187);
+
+  // A second fragment with the same cells; deduplication must leave
+  // the aggregates unchanged
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+  check_aggregate(0, domain_size_0 - 1, 0, domain_size_1 - 1);
+  check_aggregate(3, 141, 10, 187);
+}
+
+void SparseArrayFx::check_coords_reads(const std::string& array_name) {
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+
+  // Compressed coordinate tiles are kept unzipped (one stream per
+  // dimension) in memory; reading the coordinates back must return
+  // them zipped
+  create_sparse_array_2D(
+      array_name,
+      10,
+      10,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_GZIP,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Write array cells with value = row id * columns + col id
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // Read the attribute and the coordinates over a subarray that
+  // partially overlaps its tiles
+  int64_t d0_lo = 3, d0_hi = 46, d1_lo = 5, d1_hi = 87;
+  const int64_t subarray[] = {d0_lo, d0_hi, d1_lo, d1_hi};
+  const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+  int64_t cell_num = (d0_hi - d0_lo + 1) * (d1_hi - d1_lo + 1);
+  std::vector<int> buffer_a1(cell_num);
+  std::vector<int64_t> buffer_coords(2 * cell_num);
+  void* buffers[] = {&buffer_a1[0], &buffer_coords[0]};
+  uint64_t buffer_sizes[] = {cell_num * sizeof(int),
+                             2 * cell_num * sizeof(int64_t)};
+
+  tiledb_query_t* query;
+  int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffers(
+      ctx_, query, attributes, 2, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_finalize(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // The cells arrive in the subarray row-major order
+  int64_t idx = 0;
+  for (int64_t i = d0_lo; i <= d0_hi; ++i) {
+    for (int64_t j = d1_lo; j <= d1_hi; ++j) {
+      CHECK(buffer_a1[idx] == (int)(i * domain_size_1 + j));
+      CHECK(buffer_coords[2 * idx] == i);
+      CHECK(buffer_coords[2 * idx + 1] == j);
+      ++idx;
+    }
+  }
+}
+
+void SparseArrayFx::check_predicates(const std::string& array_name) {
+  int64_t domain_size_0 = 200;
+  int64_t domain_size_1 = 200;
+
+  create_sparse_array_2D(
+      array_name,
+      25,
+      25,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_NO_COMPRESSION,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Write array cells with value = row id * columns + col id
+  write_sparse_array_unsorted_2D(array_name, domain_size_0, domain_size_1);
+
+  // Reads a subarray with the predicates applied by `set_predicates`
+  // and checks the result against the cells that `selected` accepts
+  auto check_read = [&](
+      int64_t d0_lo,
+      int64_t d0_hi,
+      int64_t d1_lo,
+      int64_t d1_hi,
+      std::function<void(tiledb_query_t*)> set_predicates,
+      std::function<bool(int)> selected) {
+    const int64_t subarray[] = {d0_lo, d0_hi, d1_lo, d1_hi};
+    const char* attributes[] = {ATTR_NAME};
+    int64_t cell_num = (d0_hi - d0_lo + 1) * (d1_hi - d1_lo + 1);
+    std::vector<int> buffer_a1(cell_num);
+    void* buffers[] = {&buffer_a1[0]};
+    uint64_t buffer_sizes[] = {cell_num * sizeof(int)};
+
+    tiledb_query_t* query;
+    int rc = tiledb_query_create(ctx_, &query, array_name.c_str(), TILEDB_READ);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffers(
+        ctx_, query, attributes, 1, buffers, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarray);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR);
+    REQUIRE(rc == TILEDB_OK);
+    set_predicates(query);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Compute the expected result, in the subarray row-major order
+    std::vector<int> expected;
+    for (int64_t i = d0_lo; i <= d0_hi; ++i) {
+      for (int64_t j = d1_lo; j <= d1_hi; ++j) {
+        auto v = (int)(i * domain_size_1 + j);
+        if (selected(v))
+          expected.push_back(v);
+      }
+    }
+
+    void* buffer;
+    uint64_t buffer_size;
+    rc = tiledb_query_get_buffer(
+        ctx_, query, ATTR_NAME, &buffer, &buffer_size, nullptr, nullptr);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(buffer_size == expected.size() * sizeof(int));
+    if (!expected.empty())
+      CHECK(!memcmp(&buffer_a1[0], &expected[0], buffer_size));
+
+    rc = tiledb_query_finalize(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, &query);
+    REQUIRE(rc == TILEDB_OK);
+  };
+
+  // A comparison over the full domain; the statistics reject all but
+  // the last tiles
+  check_read(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      [&](tiledb_query_t* query) {
+        int value = 39900;
+        int rc = tiledb_query_set_predicate(
+            ctx_, query, ATTR_NAME, TILEDB_GE, &value);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v >= 39900; });
+
+  // An inclusive range over a subarray that crosses tile boundaries
+  check_read(
+      3,
+      141,
+      10,
+      187,
+      [&](tiledb_query_t* query) {
+        int low = 5000, high = 5600;
+        int rc = tiledb_query_set_predicate_range(
+            ctx_, query, ATTR_NAME, &low, &high);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v >= 5000 && v <= 5600; });
+
+  // Set membership over the full domain
+  check_read(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      [&](tiledb_query_t* query) {
+        int values[] = {7, 1234, 39999};
+        int rc = tiledb_query_set_predicate_set(
+            ctx_, query, ATTR_NAME, values, 3);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v == 7 || v == 1234 || v == 39999; });
+
+  // Two predicates combine with a logical AND
+  check_read(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      [&](tiledb_query_t* query) {
+        int low = 1000, high = 1100;
+        int rc = tiledb_query_set_predicate(
+            ctx_, query, ATTR_NAME, TILEDB_GE, &low);
+        REQUIRE(rc == TILEDB_OK);
+        rc = tiledb_query_set_predicate(
+            ctx_, query, ATTR_NAME, TILEDB_LT, &high);
+        REQUIRE(rc == TILEDB_OK);
+      },
+      [](int v) { return v >= 1000 && v < 1100; });
+}
+
 TEST_CASE_METHOD(
     SparseArrayFx, "C API: Test sparse sorted reads", "[capi], [sparse]") {
   std::string array_name;
@@ -792,6 +1632,137 @@ TEST_CASE_METHOD(
   }
 }
 
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse partitioned reads",
+    "[capi], [sparse]") {
+  std::string array_name;
+
+  if (supports_s3_) {
+    // S3
+    array_name = S3_TEMP_DIR + ARRAY;
+    check_partitioned_reads(array_name);
+  } else if (supports_hdfs_) {
+    // HDFS
+    array_name = HDFS_TEMP_DIR + ARRAY;
+    check_partitioned_reads(array_name);
+  } else {
+    // File
+    array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+    check_partitioned_reads(array_name);
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse async progress reads",
+    "[capi], [sparse]") {
+  std::string array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+  check_async_progress_reads(array_name);
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse unordered reads",
+    "[capi], [sparse]") {
+  std::string array_name;
+
+  if (supports_s3_) {
+    // S3
+    array_name = S3_TEMP_DIR + ARRAY;
+    check_unordered_reads(array_name);
+  } else if (supports_hdfs_) {
+    // HDFS
+    array_name = HDFS_TEMP_DIR + ARRAY;
+    check_unordered_reads(array_name);
+  } else {
+    // File
+    array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+    check_unordered_reads(array_name);
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse combined writes",
+    "[capi], [sparse]") {
+  // The check counts the fragment directories directly, so it runs on
+  // the local filesystem only
+  std::string array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+  check_combined_writes(array_name);
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse open at timestamp",
+    "[capi], [sparse]") {
+  std::string array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+  check_open_at_timestamp(array_name);
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse aggregates",
+    "[capi], [sparse]") {
+  std::string array_name;
+
+  if (supports_s3_) {
+    // S3
+    array_name = S3_TEMP_DIR + ARRAY;
+    check_aggregates(array_name);
+  } else if (supports_hdfs_) {
+    // HDFS
+    array_name = HDFS_TEMP_DIR + ARRAY;
+    check_aggregates(array_name);
+  } else {
+    // File
+    array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+    check_aggregates(array_name);
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse predicates",
+    "[capi], [sparse]") {
+  std::string array_name;
+
+  if (supports_s3_) {
+    // S3
+    array_name = S3_TEMP_DIR + ARRAY;
+    check_predicates(array_name);
+  } else if (supports_hdfs_) {
+    // HDFS
+    array_name = HDFS_TEMP_DIR + ARRAY;
+    check_predicates(array_name);
+  } else {
+    // File
+    array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+    check_predicates(array_name);
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse coordinate reads",
+    "[capi], [sparse]") {
+  std::string array_name;
+
+  if (supports_s3_) {
+    // S3
+    array_name = S3_TEMP_DIR + ARRAY;
+    check_coords_reads(array_name);
+  } else if (supports_hdfs_) {
+    // HDFS
+    array_name = HDFS_TEMP_DIR + ARRAY;
+    check_coords_reads(array_name);
+  } else {
+    // File
+    array_name = FILE_URI_PREFIX + FILE_TEMP_DIR + ARRAY;
+    check_coords_reads(array_name);
+  }
+}
+
 TEST_CASE_METHOD(
     SparseArrayFx,
     "C API: Test sparse buffer overflow",
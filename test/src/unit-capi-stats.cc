@@ -0,0 +1,86 @@
+/**
+ * @file   unit-capi-stats.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests for the C API statistics export.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/c_api/tiledb.h"
+
+#include <cstring>
+#include <string>
+
+TEST_CASE("C API: Test stats JSON dump", "[capi], [stats]") {
+  int rc = tiledb_stats_enable();
+  CHECK(rc == TILEDB_OK);
+
+  char* json_c = nullptr;
+  rc = tiledb_stats_dump_json(&json_c);
+  CHECK(rc == TILEDB_OK);
+  REQUIRE(json_c != nullptr);
+
+  // Check the top-level structure of the document.
+  std::string json(json_c);
+  CHECK(json.front() == '{');
+  CHECK(json.find("\"functions\"") != std::string::npos);
+  CHECK(json.find("\"counters\"") != std::string::npos);
+  CHECK(json.find("\"vfs_read\"") != std::string::npos);
+  CHECK(json.find("\"vfs_read_total_bytes\"") != std::string::npos);
+
+  rc = tiledb_stats_free_str(&json_c);
+  CHECK(rc == TILEDB_OK);
+  CHECK(json_c == nullptr);
+
+  // Invalid argument
+  rc = tiledb_stats_dump_json(nullptr);
+  CHECK(rc == TILEDB_ERR);
+
+  rc = tiledb_stats_disable();
+  CHECK(rc == TILEDB_OK);
+}
+
+TEST_CASE("C API: Test stats counter getter", "[capi], [stats]") {
+  int rc = tiledb_stats_reset();
+  CHECK(rc == TILEDB_OK);
+
+  uint64_t value = 1;
+  rc = tiledb_stats_get_counter("vfs_read_total_bytes", &value);
+  CHECK(rc == TILEDB_OK);
+  CHECK(value == 0);
+
+  // Unknown counter name
+  rc = tiledb_stats_get_counter("no_such_counter", &value);
+  CHECK(rc == TILEDB_ERR);
+
+  // Invalid arguments
+  rc = tiledb_stats_get_counter(nullptr, &value);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_stats_get_counter("vfs_read_total_bytes", nullptr);
+  CHECK(rc == TILEDB_ERR);
+}
@@ -95,6 +95,8 @@ void StringFx::create_array(const std::string& array_name) {
   REQUIRE(rc == TILEDB_OK);
   rc = tiledb_attribute_set_compressor(ctx, a2, TILEDB_GZIP, -1);
   REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_offsets_32(ctx, a2, 1);
+  REQUIRE(rc == TILEDB_OK);
 
   // Create variable-sized UTF-16 attribute
   tiledb_attribute_t* a3;
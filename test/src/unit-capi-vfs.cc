@@ -40,6 +40,10 @@
 #include "tiledb/sm/filesystem/posix_filesystem.h"
 #endif
 
+#include "tiledb/sm/filesystem/vfs.h"
+
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -49,6 +53,7 @@ struct VFSFx {
   const std::string S3_PREFIX = "s3://";
   const std::string S3_BUCKET = S3_PREFIX + random_bucket_name("tiledb") + "/";
   const std::string S3_TEMP_DIR = S3_BUCKET + "tiledb_test/";
+  const std::string MEM_TEMP_DIR = "mem://tiledb_test/";
 #ifdef _WIN32
   const std::string FILE_TEMP_DIR =
       tiledb::sm::win::current_dir() + "\\tiledb_test\\";
@@ -74,6 +79,7 @@ struct VFSFx {
   void check_move(const std::string& path);
   void check_read(const std::string& path);
   void check_append(const std::string& path);
+  void check_write_combining(const std::string& path);
   static std::string random_bucket_name(const std::string& prefix);
   void set_supported_fs();
   void set_num_vfs_threads(unsigned num_threads);
@@ -275,6 +281,7 @@ void VFSFx::check_vfs(const std::string& path) {
   // Check write and append
   check_write(path);
   check_append(path);
+  check_write_combining(path);
 
   // Read file
   check_read(path);
@@ -578,6 +585,56 @@ void VFSFx::check_append(const std::string& path) {
   REQUIRE(rc == TILEDB_OK);
 }
 
+void VFSFx::check_write_combining(const std::string& path) {
+  // Many small writes must be coalesced without affecting the
+  // contents or size of the file
+  auto file = path + "file_combined";
+  tiledb_vfs_fh_t* fh;
+  int rc = tiledb_vfs_open(ctx_, vfs_, file.c_str(), TILEDB_VFS_WRITE, &fh);
+  REQUIRE(rc == TILEDB_OK);
+
+  std::string written;
+  for (int i = 0; i < 1000; ++i) {
+    std::string chunk = "chunk " + std::to_string(i) + ";";
+    rc = tiledb_vfs_write(ctx_, fh, chunk.c_str(), chunk.size());
+    REQUIRE(rc == TILEDB_OK);
+    written += chunk;
+
+    // Make sure flushing mid-stream preserves the write order
+    if (i == 500) {
+      rc = tiledb_vfs_sync(ctx_, fh);
+      REQUIRE(rc == TILEDB_OK);
+    }
+  }
+
+  rc = tiledb_vfs_close(ctx_, fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_fh_free(ctx_, &fh);
+  REQUIRE(rc == TILEDB_OK);
+
+  uint64_t file_size = 0;
+  rc = tiledb_vfs_file_size(ctx_, vfs_, file.c_str(), &file_size);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(file_size == written.size());
+
+  // Check correctness with read
+  std::string to_read;
+  to_read.resize(written.size());
+  rc = tiledb_vfs_open(ctx_, vfs_, file.c_str(), TILEDB_VFS_READ, &fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_read(ctx_, fh, 0, &to_read[0], written.size());
+  REQUIRE(rc == TILEDB_OK);
+  CHECK_THAT(to_read, Catch::Equals(written));
+  rc = tiledb_vfs_close(ctx_, fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_fh_free(ctx_, &fh);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Remove file
+  rc = tiledb_vfs_remove_file(ctx_, vfs_, file.c_str());
+  REQUIRE(rc == TILEDB_OK);
+}
+
 void VFSFx::check_read(const std::string& path) {
   auto file = path + "file";
   std::string to_write = "This will be written to the file";
@@ -606,6 +663,31 @@ void VFSFx::check_read(const std::string& path) {
   rc = tiledb_vfs_fh_free(ctx_, &fh);
   REQUIRE(rc == TILEDB_OK);
 
+  // Overwrite the file via a move; the next read must not be served
+  // by a stale cached file descriptor
+  std::string to_write_2 = "This will overwrite the file";
+  auto file2 = path + "file2";
+  rc = tiledb_vfs_open(ctx_, vfs_, file2.c_str(), TILEDB_VFS_WRITE, &fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_write(ctx_, fh, to_write_2.c_str(), to_write_2.size());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_close(ctx_, fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_fh_free(ctx_, &fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_move_file(ctx_, vfs_, file2.c_str(), file.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  to_read.resize(to_write_2.size());
+  rc = tiledb_vfs_open(ctx_, vfs_, file.c_str(), TILEDB_VFS_READ, &fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_read(ctx_, fh, 0, &to_read[0], to_write_2.size());
+  REQUIRE(rc == TILEDB_OK);
+  CHECK_THAT(to_read, Catch::Equals(to_write_2));
+  rc = tiledb_vfs_close(ctx_, fh);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_vfs_fh_free(ctx_, &fh);
+  REQUIRE(rc == TILEDB_OK);
+
   // Remove file
   rc = tiledb_vfs_remove_file(ctx_, vfs_, file.c_str());
   REQUIRE(rc == TILEDB_OK);
@@ -629,7 +711,20 @@ TEST_CASE_METHOD(VFSFx, "C API: Test virtual filesystem", "[capi], [vfs]") {
   else
     check_vfs(FILE_TEMP_DIR);
 
-  CHECK(tiledb::sm::stats::all_stats.counter_vfs_read_num_parallelized == 0);
+  CHECK(
+      tiledb::sm::stats::all_stats.aggregate().counter_vfs_read_num_parallelized ==
+      0);
+}
+
+TEST_CASE_METHOD(
+    VFSFx, "C API: Test virtual filesystem mem://", "[capi], [vfs]") {
+  // The in-memory filesystem is always supported
+  int is_supported = 0;
+  int rc = tiledb_ctx_is_supported_fs(ctx_, TILEDB_MEMFS, &is_supported);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(is_supported);
+
+  check_vfs(MEM_TEMP_DIR);
 }
 
 TEST_CASE_METHOD(
@@ -697,5 +792,102 @@ TEST_CASE_METHOD(VFSFx, "C API: Test VFS parallel I/O", "[capi], [vfs]") {
   else
     check_vfs(FILE_TEMP_DIR);
 
-  CHECK(tiledb::sm::stats::all_stats.counter_vfs_read_num_parallelized > 0);
+  CHECK(
+      tiledb::sm::stats::all_stats.aggregate().counter_vfs_read_num_parallelized >
+      0);
+}
+
+TEST_CASE("C API: Test VFS mapped reads", "[capi], [vfs]") {
+#ifndef _WIN32
+  // Write a file spanning multiple pages
+  const std::string path =
+      tiledb::sm::posix::current_dir() + "/tiledb_test_map";
+  if (tiledb::sm::posix::is_file(path))
+    REQUIRE(tiledb::sm::posix::remove_file(path).ok());
+  std::vector<char> data(10000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = (char)(i % 256);
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(&data[0], data.size());
+  }
+
+  tiledb::sm::Config::VFSParams vfs_params;
+  vfs_params.map_reads_ = true;
+  tiledb::sm::VFS vfs;
+  REQUIRE(vfs.init(vfs_params).ok());
+  tiledb::sm::URI uri(std::string("file://") + path);
+  CHECK(vfs.supports_map(uri));
+
+  // Map the whole file
+  void* mapped = nullptr;
+  REQUIRE(vfs.map(uri, 0, data.size(), &mapped).ok());
+  CHECK(std::memcmp(mapped, &data[0], data.size()) == 0);
+  CHECK(vfs.unmap(mapped, data.size()).ok());
+
+  // Map a region at an offset that is not page-aligned
+  REQUIRE(vfs.map(uri, 1234, 1000, &mapped).ok());
+  CHECK(std::memcmp(mapped, &data[1234], 1000) == 0);
+  CHECK(vfs.unmap(mapped, 1000).ok());
+
+  // A region past the end of the file must error, not fault on access
+  CHECK(!vfs.map(uri, 9000, 2000, &mapped).ok());
+
+  // Unsupported backends error, so callers fall back to `read`
+  tiledb::sm::URI mem_uri("mem://tiledb_test/f");
+  CHECK(!vfs.supports_map(mem_uri));
+  CHECK(!vfs.map(mem_uri, 0, 10, &mapped).ok());
+
+  // Mapped reads are off by default
+  tiledb::sm::VFS default_vfs;
+  CHECK(!default_vfs.supports_map(uri));
+
+  REQUIRE(tiledb::sm::posix::remove_file(path).ok());
+#endif
+}
+
+TEST_CASE("C API: Test VFS async I/O", "[capi], [vfs]") {
+#ifndef _WIN32
+  tiledb::sm::VFS vfs;
+  REQUIRE(vfs.init(tiledb::sm::Config::VFSParams()).ok());
+
+  const std::string path =
+      tiledb::sm::posix::current_dir() + "/tiledb_test_async";
+  tiledb::sm::URI uri(std::string("file://") + path);
+  if (tiledb::sm::posix::is_file(path))
+    REQUIRE(tiledb::sm::posix::remove_file(path).ok());
+
+  std::vector<char> data(4096);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = (char)(i % 256);
+
+  // Writes to the same file append, so they must be issued in order;
+  // the future signals when a write may follow
+  auto w1 = vfs.write_async(uri, &data[0], 2048);
+  REQUIRE(w1.get().ok());
+  auto w2 = vfs.write_async(uri, &data[2048], 2048);
+  REQUIRE(w2.get().ok());
+  REQUIRE(vfs.close_file(uri).ok());
+  uint64_t nbytes = 0;
+  REQUIRE(vfs.file_size(uri, &nbytes).ok());
+  CHECK(nbytes == data.size());
+
+  // Reads of disjoint regions may be in flight concurrently
+  std::vector<char> readback(data.size());
+  auto r1 = vfs.read_async(uri, 0, &readback[0], 2048);
+  auto r2 = vfs.read_async(uri, 2048, &readback[2048], 2048);
+  CHECK(r1.get().ok());
+  CHECK(r2.get().ok());
+  CHECK(std::memcmp(&readback[0], &data[0], data.size()) == 0);
+
+  // The error of a failed async operation surfaces through the future
+  auto r3 = vfs.read_async(uri, 2048, &readback[0], 4096);  // Past EOF
+  CHECK(!r3.get().ok());
+  tiledb::sm::URI missing_uri(
+      std::string("file://") + path + "_does_not_exist");
+  auto r4 = vfs.read_async(missing_uri, 0, &readback[0], 1);
+  CHECK(!r4.get().ok());
+
+  REQUIRE(vfs.remove_file(uri).ok());
+#endif
 }
@@ -206,3 +206,84 @@ TEST_CASE(
   delete decomp_out_buff;
   delete[] data;
 }
+
+TEST_CASE(
+    "Compression-DoubleDelta: Test timestamp-like values",
+    "[compression], [double-delta]") {
+  // Create monotonically increasing values with small jitter
+  std::srand(std::time(nullptr));
+  int n = 100000;
+  auto data = new int64_t[n];
+  int64_t value = 1500000000000000;
+  for (int i = 0; i < n; ++i) {
+    value += 1000 + std::rand() % 50;
+    data[i] = value;
+  }
+
+  // Compress
+  auto comp_in_buff = new tiledb::sm::ConstBuffer(data, n * sizeof(int64_t));
+  auto comp_out_buff = new tiledb::sm::Buffer();
+  auto st = tiledb::sm::DoubleDelta::compress(
+      tiledb::sm::Datatype::INT64, comp_in_buff, comp_out_buff);
+  REQUIRE(st.ok());
+
+  // The block format must compress the jittery timestamps considerably
+  REQUIRE(comp_out_buff->size() < (uint64_t)n * sizeof(int64_t) / 4);
+
+  // Decompress
+  auto decomp_in_buff = new tiledb::sm::ConstBuffer(
+      comp_out_buff->data(), comp_out_buff->offset());
+  auto decomp_out_buff = new tiledb::sm::Buffer();
+  st = decomp_out_buff->realloc(sizeof(int64_t) * n);
+  REQUIRE(st.ok());
+  st = tiledb::sm::DoubleDelta::decompress(
+      tiledb::sm::Datatype::INT64, decomp_in_buff, decomp_out_buff);
+  REQUIRE(st.ok());
+
+  // Check data
+  auto decomp_data = (int64_t*)decomp_out_buff->data();
+  REQUIRE(std::memcmp(data, decomp_data, n * sizeof(int64_t)) == 0);
+
+  // Clean up
+  delete comp_in_buff;
+  delete comp_out_buff;
+  delete decomp_in_buff;
+  delete decomp_out_buff;
+  delete[] data;
+}
+
+TEST_CASE(
+    "Compression-DoubleDelta: Test extreme deltas",
+    "[compression], [double-delta]") {
+  // Deltas that overflow int64 arithmetic must still round-trip, as the
+  // codec uses wrap-around arithmetic
+  int64_t data[] = {INT64_MAX, INT64_MIN, INT64_MAX, INT64_MIN, 0, INT64_MAX};
+  int n = 6;
+
+  // Compress
+  auto comp_in_buff = new tiledb::sm::ConstBuffer(data, n * sizeof(int64_t));
+  auto comp_out_buff = new tiledb::sm::Buffer();
+  auto st = tiledb::sm::DoubleDelta::compress(
+      tiledb::sm::Datatype::INT64, comp_in_buff, comp_out_buff);
+  REQUIRE(st.ok());
+
+  // Decompress
+  auto decomp_in_buff = new tiledb::sm::ConstBuffer(
+      comp_out_buff->data(), comp_out_buff->offset());
+  auto decomp_out_buff = new tiledb::sm::Buffer();
+  st = decomp_out_buff->realloc(sizeof(int64_t) * n);
+  REQUIRE(st.ok());
+  st = tiledb::sm::DoubleDelta::decompress(
+      tiledb::sm::Datatype::INT64, decomp_in_buff, decomp_out_buff);
+  REQUIRE(st.ok());
+
+  // Check data
+  auto decomp_data = (int64_t*)decomp_out_buff->data();
+  REQUIRE(std::memcmp(data, decomp_data, n * sizeof(int64_t)) == 0);
+
+  // Clean up
+  delete comp_in_buff;
+  delete comp_out_buff;
+  delete decomp_in_buff;
+  delete decomp_out_buff;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file unit-compression-dict.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests for the dictionary encoding.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "tiledb/sm/compressors/dict_compressor.h"
+
+using namespace tiledb::sm;
+
+/** Concatenates the input values and computes their offsets. */
+static void build_input(
+    const std::vector<std::string>& values,
+    std::string* data,
+    std::vector<uint64_t>* offsets) {
+  for (const auto& v : values) {
+    offsets->push_back(data->size());
+    *data += v;
+  }
+}
+
+TEST_CASE(
+    "Compression-Dict: Test invalid input", "[compression], [dict]") {
+  auto input = new ConstBuffer(nullptr, 0);
+  auto compressed = new Buffer();
+  tiledb::sm::Status st;
+
+  // Test null input buffer
+  uint64_t offsets[] = {0};
+  st = DictEncoder::compress(offsets, 1, input, compressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Test no offsets
+  char data[] = "abc";
+  input = new ConstBuffer(data, sizeof(data));
+  st = DictEncoder::compress(nullptr, 0, input, compressed);
+  CHECK(!st.ok());
+
+  // Test non-increasing offsets
+  uint64_t bad_offsets[] = {2, 1};
+  st = DictEncoder::compress(bad_offsets, 2, input, compressed);
+  CHECK(!st.ok());
+
+  delete input;
+  delete compressed;
+}
+
+TEST_CASE(
+    "Compression-Dict: Test round-trip on low-cardinality values",
+    "[compression], [dict]") {
+  // Populate repetitive string data
+  std::vector<std::string> values;
+  const char* categories[] = {"yes", "no", "maybe", ""};
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(categories[i % 4]);
+  std::string data;
+  std::vector<uint64_t> offsets;
+  build_input(values, &data, &offsets);
+
+  // Encode
+  auto input = new ConstBuffer(data.data(), data.size());
+  auto compressed = new Buffer();
+  auto st =
+      DictEncoder::compress(&offsets[0], offsets.size(), input, compressed);
+  REQUIRE(st.ok());
+
+  // The encoding must shrink repetitive data considerably
+  CHECK(compressed->size() < data.size() / 2);
+
+  // Decode and compare
+  auto comp_input = new ConstBuffer(compressed->data(), compressed->size());
+  auto decompressed = new Buffer();
+  st = DictEncoder::decompress(comp_input, decompressed);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed->size() == data.size());
+  CHECK(std::memcmp(decompressed->data(), data.data(), data.size()) == 0);
+
+  delete input;
+  delete compressed;
+  delete comp_input;
+  delete decompressed;
+}
+
+TEST_CASE(
+    "Compression-Dict: Test round-trip on unique values",
+    "[compression], [dict]") {
+  // Populate all-unique string data
+  std::vector<std::string> values;
+  for (int i = 0; i < 300; ++i)
+    values.push_back("value_" + std::to_string(i));
+  std::string data;
+  std::vector<uint64_t> offsets;
+  build_input(values, &data, &offsets);
+
+  // Encode - the result is larger than the input, but must still
+  // round-trip correctly
+  auto input = new ConstBuffer(data.data(), data.size());
+  auto compressed = new Buffer();
+  auto st =
+      DictEncoder::compress(&offsets[0], offsets.size(), input, compressed);
+  REQUIRE(st.ok());
+
+  // Decode and compare
+  auto comp_input = new ConstBuffer(compressed->data(), compressed->size());
+  auto decompressed = new Buffer();
+  st = DictEncoder::decompress(comp_input, decompressed);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed->size() == data.size());
+  CHECK(std::memcmp(decompressed->data(), data.data(), data.size()) == 0);
+
+  delete input;
+  delete compressed;
+  delete comp_input;
+  delete decompressed;
+}
+
+TEST_CASE(
+    "Compression-Dict: Test single value", "[compression], [dict]") {
+  std::string data = "singleton";
+  uint64_t offsets[] = {0};
+
+  auto input = new ConstBuffer(data.data(), data.size());
+  auto compressed = new Buffer();
+  auto st = DictEncoder::compress(offsets, 1, input, compressed);
+  REQUIRE(st.ok());
+
+  auto comp_input = new ConstBuffer(compressed->data(), compressed->size());
+  auto decompressed = new Buffer();
+  st = DictEncoder::decompress(comp_input, decompressed);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed->size() == data.size());
+  CHECK(std::memcmp(decompressed->data(), data.data(), data.size()) == 0);
+
+  delete input;
+  delete compressed;
+  delete comp_input;
+  delete decompressed;
+}
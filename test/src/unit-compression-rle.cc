@@ -32,6 +32,7 @@
  */
 
 #include <cstring>
+#include <ctime>
 #include <iostream>
 
 #include "catch.hpp"
@@ -280,3 +281,98 @@ TEST_CASE(
   delete compressed;
   delete decompressed;
 }
+
+TEST_CASE(
+    "Compression-RLE: Test indexed format round-trip",
+    "[compression], [rle]") {
+  // Populate data with random runs
+  std::srand(std::time(nullptr));
+  uint64_t n = 100000;
+  auto data = new int[n];
+  uint64_t i = 0;
+  while (i < n) {
+    int value = std::rand() % 50;
+    uint64_t run_len = 1 + std::rand() % 300;
+    for (uint64_t j = 0; j < run_len && i < n; ++j)
+      data[i++] = value;
+  }
+
+  // Compress with the run index
+  auto input = new tiledb::sm::ConstBuffer(data, n * sizeof(int));
+  auto compressed = new tiledb::sm::Buffer();
+  auto st = tiledb::sm::RLE::compress_indexed(sizeof(int), input, compressed);
+  REQUIRE(st.ok());
+
+  // Decompress serially
+  auto comp_input =
+      new tiledb::sm::ConstBuffer(compressed->data(), compressed->size());
+  auto decompressed = new tiledb::sm::Buffer();
+  st = tiledb::sm::RLE::decompress_indexed(
+      sizeof(int), comp_input, decompressed);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed->size() == n * sizeof(int));
+  CHECK(std::memcmp(decompressed->data(), data, n * sizeof(int)) == 0);
+  delete comp_input;
+  delete decompressed;
+
+  // Decompress in parallel, split at the run index boundaries
+  tiledb::sm::ThreadPool thread_pool(4);
+  comp_input =
+      new tiledb::sm::ConstBuffer(compressed->data(), compressed->size());
+  decompressed = new tiledb::sm::Buffer();
+  st = tiledb::sm::RLE::decompress_indexed(
+      sizeof(int), comp_input, decompressed, &thread_pool);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed->size() == n * sizeof(int));
+  CHECK(std::memcmp(decompressed->data(), data, n * sizeof(int)) == 0);
+
+  delete input;
+  delete compressed;
+  delete comp_input;
+  delete decompressed;
+  delete[] data;
+}
+
+TEST_CASE(
+    "Compression-RLE: Test indexed format point access",
+    "[compression], [rle]") {
+  // Populate data with random runs
+  std::srand(std::time(nullptr));
+  uint64_t n = 100000;
+  auto data = new int[n];
+  uint64_t i = 0;
+  while (i < n) {
+    int value = std::rand() % 50;
+    uint64_t run_len = 1 + std::rand() % 300;
+    for (uint64_t j = 0; j < run_len && i < n; ++j)
+      data[i++] = value;
+  }
+
+  // Compress with the run index
+  auto input = new tiledb::sm::ConstBuffer(data, n * sizeof(int));
+  auto compressed = new tiledb::sm::Buffer();
+  auto st = tiledb::sm::RLE::compress_indexed(sizeof(int), input, compressed);
+  REQUIRE(st.ok());
+
+  // Retrieve single cells without decompressing the rest
+  auto comp_input =
+      new tiledb::sm::ConstBuffer(compressed->data(), compressed->size());
+  for (int t = 0; t < 1000; ++t) {
+    uint64_t cell_idx = std::rand() % n;
+    int value = -1;
+    st = tiledb::sm::RLE::decompress_cell(
+        sizeof(int), comp_input, cell_idx, &value);
+    REQUIRE(st.ok());
+    CHECK(value == data[cell_idx]);
+  }
+
+  // An out-of-bounds cell position must fail
+  int value;
+  st = tiledb::sm::RLE::decompress_cell(sizeof(int), comp_input, n, &value);
+  CHECK(!st.ok());
+
+  delete input;
+  delete compressed;
+  delete comp_input;
+  delete[] data;
+}
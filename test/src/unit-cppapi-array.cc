@@ -87,6 +87,49 @@ TEST_CASE_METHOD(CPPArrayFx, "C++ API: Arrays", "[cppapi]") {
     query.set_subarray(subarray);
   }
 
+  SECTION("Raw bindings") {
+    std::vector<int> a1 = {1, 2};
+    std::vector<std::string> a2 = {"abc", "defg"};
+    auto a2buf = ungroup_var_buffer(a2);
+    std::vector<int> subarray = {0, 1, 0, 0};
+
+    {
+      Query query(ctx, "cpp_unit_array", TILEDB_WRITE);
+      query.set_subarray(subarray);
+      query.set_buffer("a1", a1);
+      query.set_buffer("a2", a2buf);
+      query.set_layout(TILEDB_ROW_MAJOR);
+      CHECK_THROWS(query.bind_buffer("a1", a1.data(), a1.size()));
+      REQUIRE(query.submit() == Query::Status::COMPLETE);
+    }
+
+    {
+      int a1_read[2] = {0, 0};
+      uint64_t a2_offsets[2] = {0, 0};
+      char a2_data[16];
+      Query query(ctx, "cpp_unit_array", TILEDB_READ);
+      query.set_subarray(subarray);
+      query.set_layout(TILEDB_ROW_MAJOR);
+      query.bind_buffer("a1", a1_read, 2);
+      query.bind_buffer("a2", a2_offsets, 2, a2_data, sizeof(a2_data));
+      CHECK_THROWS(query.set_buffer("a1", a1));
+      REQUIRE(query.submit() == Query::Status::COMPLETE);
+      auto ret = query.result_buffer_elements();
+      CHECK(ret["a1"].second == 2);
+      CHECK(ret["a2"].first == 2);
+      CHECK(ret["a2"].second == 7);
+      CHECK(a1_read[0] == 1);
+      CHECK(a1_read[1] == 2);
+      CHECK(std::string(a2_data, 3) == "abc");
+
+      // A re-submission reuses the bindings without re-registration
+      a1_read[0] = a1_read[1] = 0;
+      REQUIRE(query.submit() == Query::Status::COMPLETE);
+      CHECK(a1_read[0] == 1);
+      CHECK(a1_read[1] == 2);
+    }
+  }
+
   SECTION("Read/Write") {
     std::vector<int> a1 = {1, 2};
     std::vector<std::string> a2 = {"abc", "defg"};
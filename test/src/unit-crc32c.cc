@@ -0,0 +1,78 @@
+/**
+ * @file unit-crc32c.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests the CRC32C checksum function.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/crc32c.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace tiledb::sm;
+
+TEST_CASE("CRC32C: Test known vectors", "[crc32c]") {
+  // Empty input
+  CHECK(crc32c::checksum(nullptr, 0) == 0);
+
+  // Standard check value for the Castagnoli polynomial
+  const char* input = "123456789";
+  CHECK(crc32c::checksum(input, strlen(input)) == 0xE3069283);
+
+  // RFC 3720 test vector: 32 bytes of zeros
+  std::vector<unsigned char> zeros(32, 0);
+  CHECK(crc32c::checksum(&zeros[0], zeros.size()) == 0x8A9136AA);
+
+  // RFC 3720 test vector: 32 bytes of 0xFF
+  std::vector<unsigned char> ones(32, 0xFF);
+  CHECK(crc32c::checksum(&ones[0], ones.size()) == 0x62A8AB43);
+
+  // RFC 3720 test vector: 32 incrementing bytes
+  std::vector<unsigned char> incr(32);
+  for (unsigned i = 0; i < 32; ++i)
+    incr[i] = (unsigned char)i;
+  CHECK(crc32c::checksum(&incr[0], incr.size()) == 0x46DD794E);
+}
+
+TEST_CASE("CRC32C: Test sensitivity to corruption", "[crc32c]") {
+  std::vector<unsigned char> data(1000);
+  for (unsigned i = 0; i < data.size(); ++i)
+    data[i] = (unsigned char)(i * 7);
+  auto crc = crc32c::checksum(&data[0], data.size());
+
+  // A single flipped bit must change the checksum
+  data[500] ^= 1;
+  CHECK(crc32c::checksum(&data[0], data.size()) != crc);
+  data[500] ^= 1;
+  CHECK(crc32c::checksum(&data[0], data.size()) == crc);
+
+  // Unaligned lengths
+  CHECK(crc32c::checksum(&data[0], 7) != crc32c::checksum(&data[0], 8));
+}
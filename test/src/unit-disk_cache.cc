@@ -0,0 +1,309 @@
+/**
+ * @file unit-disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class DiskCache.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "tiledb/sm/c_api/tiledb.h"
+#include "tiledb/sm/cache/disk_cache.h"
+
+#ifdef _WIN32
+#include "tiledb/sm/filesystem/win_filesystem.h"
+#else
+#include "tiledb/sm/filesystem/posix_filesystem.h"
+#endif
+
+using namespace tiledb::sm;
+
+namespace {
+
+const std::string cache_dir = "unit_disk_cache_dir";
+
+void remove_cache_dir() {
+#ifdef _WIN32
+  if (win::is_dir(cache_dir))
+    win::remove_dir(cache_dir);
+#else
+  if (posix::is_dir(cache_dir))
+    posix::remove_dir(cache_dir);
+#endif
+}
+
+/**
+ * Polls the cache until the input key is readable (insertions are
+ * performed by a background writer), up to a timeout.
+ */
+bool wait_for_hit(
+    DiskCache* cache, const std::string& key, void* buffer, uint64_t nbytes) {
+  bool in_cache = false;
+  for (int i = 0; i < 500 && !in_cache; ++i) {
+    REQUIRE(cache->read(key, buffer, nbytes, &in_cache).ok());
+    if (!in_cache)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return in_cache;
+}
+
+}  // namespace
+
+TEST_CASE("DiskCache: Test insertions and reads", "[disk_cache]") {
+  remove_cache_dir();
+  DiskCache cache(cache_dir, 1024 * 1024);
+  REQUIRE(cache.init().ok());
+
+  std::vector<char> object(1000);
+  for (size_t i = 0; i < object.size(); ++i)
+    object[i] = (char)(i % 256);
+  REQUIRE(cache.insert("s3://bucket/array/a1.tdb+100", &object[0], 1000).ok());
+
+  // The background writer eventually makes the entry readable
+  std::vector<char> read_buffer(1000);
+  CHECK(wait_for_hit(&cache, "s3://bucket/array/a1.tdb+100", &read_buffer[0], 1000));
+  CHECK(std::memcmp(&object[0], &read_buffer[0], 1000) == 0);
+
+  // Miss on an unknown key
+  bool in_cache = true;
+  REQUIRE(
+      cache.read("s3://bucket/array/a2.tdb+0", &read_buffer[0], 1000, &in_cache)
+          .ok());
+  CHECK(!in_cache);
+
+  // A size mismatch is treated as a miss
+  REQUIRE(
+      cache.read("s3://bucket/array/a1.tdb+100", &read_buffer[0], 500, &in_cache)
+          .ok());
+  CHECK(!in_cache);
+
+  remove_cache_dir();
+}
+
+TEST_CASE("DiskCache: Test persistence across re-initialization", "[disk_cache]") {
+  remove_cache_dir();
+
+  std::vector<char> object(512, 'x');
+  {
+    DiskCache cache(cache_dir, 1024 * 1024);
+    REQUIRE(cache.init().ok());
+    REQUIRE(cache.insert("s3://bucket/array/a1.tdb+0", &object[0], 512).ok());
+    std::vector<char> read_buffer(512);
+    CHECK(wait_for_hit(&cache, "s3://bucket/array/a1.tdb+0", &read_buffer[0], 512));
+  }
+
+  // A new cache over the same directory serves the entry of the
+  // previous run
+  {
+    DiskCache cache(cache_dir, 1024 * 1024);
+    REQUIRE(cache.init().ok());
+    std::vector<char> read_buffer(512);
+    bool in_cache = false;
+    REQUIRE(
+        cache.read("s3://bucket/array/a1.tdb+0", &read_buffer[0], 512, &in_cache)
+            .ok());
+    CHECK(in_cache);
+    CHECK(std::memcmp(&object[0], &read_buffer[0], 512) == 0);
+  }
+
+  remove_cache_dir();
+}
+
+TEST_CASE("DiskCache: Test eviction upon exceeded capacity", "[disk_cache]") {
+  remove_cache_dir();
+  DiskCache cache(cache_dir, 1024);
+  REQUIRE(cache.init().ok());
+
+  // An object larger than the capacity is never cached
+  std::vector<char> large(2048, 'y');
+  REQUIRE(cache.insert("large", &large[0], 2048).ok());
+
+  // Inserting over the capacity evicts in LRU order
+  std::vector<char> object(512, 'z');
+  std::vector<char> read_buffer(512);
+  REQUIRE(cache.insert("k1", &object[0], 512).ok());
+  CHECK(wait_for_hit(&cache, "k1", &read_buffer[0], 512));
+  REQUIRE(cache.insert("k2", &object[0], 512).ok());
+  CHECK(wait_for_hit(&cache, "k2", &read_buffer[0], 512));
+  REQUIRE(cache.insert("k3", &object[0], 512).ok());
+  CHECK(wait_for_hit(&cache, "k3", &read_buffer[0], 512));
+
+  bool in_cache = true;
+  REQUIRE(cache.read("k1", &read_buffer[0], 512, &in_cache).ok());
+  CHECK(!in_cache);
+  REQUIRE(cache.read("large", &read_buffer[0], 2048, &in_cache).ok());
+  CHECK(!in_cache);
+
+  remove_cache_dir();
+}
+
+TEST_CASE(
+    "DiskCache: Test disk-tier hit through a real tile read",
+    "[disk_cache]") {
+  const std::string array_name = "unit_disk_cache_array";
+  const std::string tier_dir = "unit_disk_cache_tier_dir";
+  auto remove_dirs = [&]() {
+#ifdef _WIN32
+    if (win::is_dir(array_name))
+      win::remove_dir(array_name);
+    if (win::is_dir(tier_dir))
+      win::remove_dir(tier_dir);
+#else
+    if (posix::is_dir(array_name))
+      posix::remove_dir(array_name);
+    if (posix::is_dir(tier_dir))
+      posix::remove_dir(tier_dir);
+#endif
+  };
+  remove_dirs();
+
+  tiledb_config_t* config;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_create(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(config, "sm.disk_cache.dir", tier_dir.c_str(), &error) ==
+      TILEDB_OK);
+
+  // Create a single-tile dense vector and write it
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  uint64_t dim_domain[] = {1, 16};
+  uint64_t tile_extent = 16;
+  tiledb_dimension_t* d1;
+  REQUIRE(
+      tiledb_dimension_create(
+          ctx, &d1, "d1", TILEDB_UINT64, dim_domain, &tile_extent) ==
+      TILEDB_OK);
+  tiledb_domain_t* domain;
+  REQUIRE(tiledb_domain_create(ctx, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_domain_add_dimension(ctx, domain, d1) == TILEDB_OK);
+  tiledb_attribute_t* a;
+  REQUIRE(tiledb_attribute_create(ctx, &a, "a", TILEDB_INT32) == TILEDB_OK);
+  REQUIRE(
+      tiledb_attribute_set_compressor(ctx, a, TILEDB_NO_COMPRESSION, -1) ==
+      TILEDB_OK);
+  tiledb_array_schema_t* array_schema;
+  REQUIRE(
+      tiledb_array_schema_create(ctx, &array_schema, TILEDB_DENSE) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_array_schema_set_domain(ctx, array_schema, domain) == TILEDB_OK);
+  REQUIRE(
+      tiledb_array_schema_add_attribute(ctx, array_schema, a) == TILEDB_OK);
+  REQUIRE(
+      tiledb_array_create(ctx, array_name.c_str(), array_schema) == TILEDB_OK);
+  REQUIRE(tiledb_attribute_free(ctx, &a) == TILEDB_OK);
+  REQUIRE(tiledb_dimension_free(ctx, &d1) == TILEDB_OK);
+  REQUIRE(tiledb_domain_free(ctx, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_free(ctx, &array_schema) == TILEDB_OK);
+
+  int write_buffer[16];
+  for (int i = 0; i < 16; ++i)
+    write_buffer[i] = i;
+  void* write_buffers[] = {write_buffer};
+  uint64_t write_buffer_sizes[] = {sizeof(write_buffer)};
+  const char* attributes[] = {"a"};
+  tiledb_query_t* query;
+  REQUIRE(
+      tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_WRITE) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_layout(ctx, query, TILEDB_GLOBAL_ORDER) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffers(
+          ctx, query, attributes, 1, write_buffers, write_buffer_sizes) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  REQUIRE(tiledb_query_free(ctx, &query) == TILEDB_OK);
+
+  // Read the tile once, feeding both cache tiers, and free the context,
+  // draining the disk cache writer
+  int read_buffer[16] = {0};
+  void* read_buffers[] = {read_buffer};
+  uint64_t read_buffer_sizes[] = {sizeof(read_buffer)};
+  REQUIRE(
+      tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_READ) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_layout(ctx, query, TILEDB_GLOBAL_ORDER) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffers(
+          ctx, query, attributes, 1, read_buffers, read_buffer_sizes) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  REQUIRE(tiledb_query_free(ctx, &query) == TILEDB_OK);
+  REQUIRE(tiledb_ctx_free(&ctx) == TILEDB_OK);
+  REQUIRE(std::memcmp(read_buffer, write_buffer, sizeof(read_buffer)) == 0);
+
+  // Corrupt the attribute file on disk, so that the second read can
+  // only be served by the disk cache tier
+#ifndef _WIN32
+  std::vector<std::string> paths;
+  REQUIRE(posix::ls(posix::current_dir() + "/" + array_name, &paths).ok());
+  std::string attr_file;
+  for (const auto& path : paths) {
+    if (posix::is_dir(path) && posix::is_file(path + "/a.tdb"))
+      attr_file = path + "/a.tdb";
+  }
+  REQUIRE(!attr_file.empty());
+  uint64_t attr_file_size = 0;
+  REQUIRE(posix::file_size(attr_file, &attr_file_size).ok());
+  {
+    std::ofstream file(attr_file, std::ios::binary | std::ios::trunc);
+    std::vector<char> garbage(attr_file_size, (char)0xff);
+    file.write(&garbage[0], garbage.size());
+  }
+#endif
+
+  // A fresh context starts with a cold memory cache; the tile read must
+  // fall through to the persisted disk tier and still return the data
+  std::memset(read_buffer, 0, sizeof(read_buffer));
+  REQUIRE(tiledb_ctx_create(&ctx, config) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_create(ctx, &query, array_name.c_str(), TILEDB_READ) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_layout(ctx, query, TILEDB_GLOBAL_ORDER) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffers(
+          ctx, query, attributes, 1, read_buffers, read_buffer_sizes) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  REQUIRE(tiledb_query_free(ctx, &query) == TILEDB_OK);
+  REQUIRE(tiledb_ctx_free(&ctx) == TILEDB_OK);
+  CHECK(std::memcmp(read_buffer, write_buffer, sizeof(read_buffer)) == 0);
+
+  REQUIRE(tiledb_config_free(&config) == TILEDB_OK);
+  remove_dirs();
+}
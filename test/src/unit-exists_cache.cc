@@ -0,0 +1,124 @@
+/**
+ * @file unit-exists_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class ExistsCache.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cache/exists_cache.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("ExistsCache: Test hits and misses", "[exists_cache]") {
+  ExistsCache cache(10, 60000);
+  bool exists = false;
+
+  // Miss on an empty cache
+  CHECK(!cache.get("file:s3://bucket/a", &exists));
+
+  // Positive result
+  cache.put("file:s3://bucket/a", true);
+  CHECK(cache.get("file:s3://bucket/a", &exists));
+  CHECK(exists);
+
+  // Negative result
+  cache.put("file:s3://bucket/b", false);
+  CHECK(cache.get("file:s3://bucket/b", &exists));
+  CHECK(!exists);
+
+  // Overwriting an entry updates its result
+  cache.put("file:s3://bucket/a", false);
+  CHECK(cache.get("file:s3://bucket/a", &exists));
+  CHECK(!exists);
+  CHECK(cache.size() == 2);
+
+  // Clearing removes all entries
+  cache.clear();
+  CHECK(cache.size() == 0);
+  CHECK(!cache.get("file:s3://bucket/a", &exists));
+}
+
+TEST_CASE("ExistsCache: Test zero TTL disables caching", "[exists_cache]") {
+  ExistsCache cache(10, 0);
+  bool exists = false;
+
+  cache.put("file:s3://bucket/a", true);
+  CHECK(cache.size() == 0);
+  CHECK(!cache.get("file:s3://bucket/a", &exists));
+}
+
+TEST_CASE("ExistsCache: Test eviction upon full cache", "[exists_cache]") {
+  ExistsCache cache(3, 60000);
+  bool exists = false;
+
+  cache.put("k1", true);
+  cache.put("k2", true);
+  cache.put("k3", true);
+  CHECK(cache.size() == 3);
+
+  // Inserting a fourth entry evicts the oldest insertion
+  cache.put("k4", true);
+  CHECK(cache.size() == 3);
+  CHECK(!cache.get("k1", &exists));
+  CHECK(cache.get("k2", &exists));
+  CHECK(cache.get("k3", &exists));
+  CHECK(cache.get("k4", &exists));
+
+  // Refreshing an existing entry does not evict
+  cache.put("k2", false);
+  CHECK(cache.size() == 3);
+  CHECK(cache.get("k3", &exists));
+}
+
+TEST_CASE("ExistsCache: Test invalidation", "[exists_cache]") {
+  ExistsCache cache(10, 60000);
+  bool exists = false;
+
+  cache.put("dir:s3://bucket/arr/f1", true);
+  cache.put("dir:s3://bucket/arr/f2", true);
+  cache.put("dir:s3://bucket/other", true);
+  cache.put("file:s3://bucket/arr/f1/meta", false);
+
+  // Invalidating a single key leaves the rest intact
+  cache.invalidate("dir:s3://bucket/arr/f2");
+  CHECK(!cache.get("dir:s3://bucket/arr/f2", &exists));
+  CHECK(cache.get("dir:s3://bucket/arr/f1", &exists));
+  CHECK(cache.size() == 3);
+
+  // Invalidating a missing key is a noop
+  cache.invalidate("dir:s3://bucket/missing");
+  CHECK(cache.size() == 3);
+
+  // Prefix invalidation removes all entries under the prefix
+  cache.invalidate_prefix("dir:s3://bucket/arr");
+  CHECK(!cache.get("dir:s3://bucket/arr/f1", &exists));
+  CHECK(cache.get("dir:s3://bucket/other", &exists));
+  CHECK(cache.get("file:s3://bucket/arr/f1/meta", &exists));
+  CHECK(cache.size() == 2);
+}
@@ -33,6 +33,8 @@
 #include "catch.hpp"
 #include "tiledb/sm/cache/lru_cache.h"
 
+#include <vector>
+
 using namespace tiledb::sm;
 
 #define CACHE_SIZE 10 * sizeof(int)
@@ -48,27 +50,32 @@ struct LRUCacheFx {
     delete lru_cache_;
   }
 
-  bool check_key_order(const std::string& golden_order) {
+  /** Returns a cache key with the input URI identifier and offset 0. */
+  static CacheKey key(uint64_t uri_id) {
+    return CacheKey(uri_id, 0);
+  }
+
+  bool check_key_order(const std::vector<uint64_t>& golden_order) {
     auto it = lru_cache_->item_iter_begin();
     auto it_end = lru_cache_->item_iter_end();
-    std::string keys;
+    std::vector<uint64_t> keys;
     for (; it != it_end; ++it)
-      keys += it->key_;
+      keys.push_back(it->key_.uri_id_);
     return keys == golden_order;
   }
 };
 
 TEST_CASE_METHOD(LRUCacheFx, "Unit-test class LRUCache", "[lru_cache]") {
   // Insert a null object
-  Status st = lru_cache_->insert("key", nullptr, 20);
+  Status st = lru_cache_->insert(key(0), nullptr, 20);
   CHECK(!st.ok());
 
   // Insert an object larger than CACHE_SIZE
   int v;
   bool success;
-  st = lru_cache_->insert("key", &v, CACHE_SIZE + 1);
+  st = lru_cache_->insert(key(0), &v, CACHE_SIZE + 1);
   CHECK(st.ok());
-  st = lru_cache_->read("key", &v, 0, sizeof(int), &success);
+  st = lru_cache_->read(key(0), &v, 0, sizeof(int), &success);
   CHECK(st.ok());
   CHECK(!success);
 
@@ -83,52 +90,87 @@ TEST_CASE_METHOD(LRUCacheFx, "Unit-test class LRUCache", "[lru_cache]") {
   }
 
   // Insert 3 items in the cache
-  st = lru_cache_->insert("v1", v1, 3 * sizeof(int));
+  st = lru_cache_->insert(key(1), v1, 3 * sizeof(int));
   CHECK(st.ok());
-  st = lru_cache_->insert("v2", v2, 3 * sizeof(int));
+  st = lru_cache_->insert(key(2), v2, 3 * sizeof(int));
   CHECK(st.ok());
-  st = lru_cache_->insert("v3", v3, 3 * sizeof(int));
+  st = lru_cache_->insert(key(3), v3, 3 * sizeof(int));
   CHECK(st.ok());
 
   // Check that the order in the linked list is v1-v2-v3
-  CHECK(check_key_order("v1v2v3"));
+  CHECK(check_key_order({1, 2, 3}));
 
   // Read non-existent item
-  st = lru_cache_->read("v", &v, 0, sizeof(int), &success);
+  st = lru_cache_->read(key(99), &v, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(!success);
+
+  // A key with the same URI identifier but a different offset is a
+  // different object
+  st = lru_cache_->read(CacheKey(1, 8), &v, 0, sizeof(int), &success);
   CHECK(st.ok());
   CHECK(!success);
 
   // Read full v3
   int b3[3];
-  st = lru_cache_->read("v3", b3, 0, 3 * sizeof(int), &success);
+  st = lru_cache_->read(key(3), b3, 0, 3 * sizeof(int), &success);
   CHECK(st.ok());
   CHECK(success);
   CHECK(!memcmp(b3, v3, 3 * sizeof(int)));
 
   // Check that the order in the linked list is v1-v2-v3
-  CHECK(check_key_order("v1v2v3"));
+  CHECK(check_key_order({1, 2, 3}));
 
   // Read partial v2
   int b2;
-  st = lru_cache_->read("v2", &b2, sizeof(int), sizeof(int), &success);
+  st = lru_cache_->read(key(2), &b2, sizeof(int), sizeof(int), &success);
   CHECK(st.ok());
   CHECK(success);
   CHECK(b2 == v2[1]);
 
   // Check that the order in the linked list is v1-v3-v2
-  CHECK(check_key_order("v1v3v2"));
+  CHECK(check_key_order({1, 3, 2}));
 
   // Read out of bounds
-  st = lru_cache_->read("v2", &b2, sizeof(int), 4 * sizeof(int), &success);
+  st = lru_cache_->read(key(2), &b2, sizeof(int), 4 * sizeof(int), &success);
   CHECK(!st.ok());
 
-  // Test eviction
+  // Test admission: a first-seen key is not admitted over the resident
+  // items when the cache is full
   auto v4 = new int[5];
-  st = lru_cache_->insert("v4", v4, 5 * sizeof(int));
+  for (int i = 0; i < 5; ++i)
+    v4[i] = 9 + i;
+  st = lru_cache_->insert(key(4), v4, 5 * sizeof(int));
+  CHECK(st.ok());
+  CHECK(check_key_order({1, 3, 2}));
+
+  // A repeated insertion makes v4 more frequent than v1, which gets
+  // evicted; v3 (accessed as frequently as v4) still blocks admission
+  v4 = new int[5];
+  for (int i = 0; i < 5; ++i)
+    v4[i] = 9 + i;
+  st = lru_cache_->insert(key(4), v4, 5 * sizeof(int));
+  CHECK(st.ok());
+  CHECK(check_key_order({3, 2}));
+
+  // A third insertion makes v4 more frequent than v3 as well, so it is
+  // admitted into the probationary segment
+  v4 = new int[5];
+  for (int i = 0; i < 5; ++i)
+    v4[i] = 9 + i;
+  st = lru_cache_->insert(key(4), v4, 5 * sizeof(int));
+  CHECK(st.ok());
+  CHECK(check_key_order({4, 2}));
+
+  // Read full v4, which promotes it to the protected segment
+  int b4[5];
+  st = lru_cache_->read(key(4), b4, 0, 5 * sizeof(int), &success);
   CHECK(st.ok());
+  CHECK(success);
+  CHECK(!memcmp(b4, v4, 5 * sizeof(int)));
 
   // Check that the order in the linked list is v2-v4
-  CHECK(check_key_order("v2v4"));
+  CHECK(check_key_order({2, 4}));
 
   // Test clear
   lru_cache_->clear();
@@ -136,3 +178,80 @@ TEST_CASE_METHOD(LRUCacheFx, "Unit-test class LRUCache", "[lru_cache]") {
   auto it_end = lru_cache_->item_iter_end();
   CHECK(it == it_end);
 }
+
+TEST_CASE_METHOD(
+    LRUCacheFx, "LRUCache: Test scan resistance", "[lru_cache]") {
+  Status st;
+  bool success;
+  int b;
+
+  // Insert a frequently read item and fill the rest of the cache
+  auto hot = new int(0);
+  st = lru_cache_->insert(key(100), hot, sizeof(int));
+  CHECK(st.ok());
+  for (int i = 0; i < 3; ++i) {
+    st = lru_cache_->read(key(100), &b, 0, sizeof(int), &success);
+    CHECK(st.ok());
+    CHECK(success);
+  }
+  for (int i = 0; i < 9; ++i) {
+    st = lru_cache_->insert(key(200 + i), new int(i), sizeof(int));
+    CHECK(st.ok());
+  }
+
+  // A scan of one-shot keys is not admitted over the resident items
+  for (int i = 0; i < 20; ++i) {
+    st = lru_cache_->insert(key(300 + i), new int(i), sizeof(int));
+    CHECK(st.ok());
+  }
+  st = lru_cache_->read(key(100), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(success);
+  st = lru_cache_->read(key(310), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(!success);
+
+  // A repeatedly accessed key is eventually admitted, evicting the least
+  // recently used probationary item but not the frequently read one
+  st = lru_cache_->insert(key(300), new int(0), sizeof(int));
+  CHECK(st.ok());
+  st = lru_cache_->read(key(300), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(success);
+  st = lru_cache_->read(key(200), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(!success);
+  st = lru_cache_->read(key(100), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(success);
+}
+
+TEST_CASE_METHOD(
+    LRUCacheFx, "LRUCache: Test pinned insertion", "[lru_cache]") {
+  Status st;
+  bool success;
+  int b;
+
+  // Fill the cache with one-shot items
+  for (int i = 0; i < 10; ++i) {
+    st = lru_cache_->insert(key(200 + i), new int(i), sizeof(int));
+    CHECK(st.ok());
+  }
+
+  // A pinned insertion bypasses the admission policy even though the key
+  // is first-seen, and goes directly to the protected segment
+  st = lru_cache_->insert(key(400), new int(0), sizeof(int), true, true);
+  CHECK(st.ok());
+  st = lru_cache_->read(key(200), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(!success);
+
+  // A subsequent scan of one-shot items does not displace the pinned one
+  for (int i = 0; i < 20; ++i) {
+    st = lru_cache_->insert(key(300 + i), new int(i), sizeof(int));
+    CHECK(st.ok());
+  }
+  st = lru_cache_->read(key(400), &b, 0, sizeof(int), &success);
+  CHECK(st.ok());
+  CHECK(success);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file   unit-mbr_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `MBRFilter` class.
+ */
+
+#include <catch.hpp>
+#include "tiledb/sm/fragment/mbr_filter.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("MBRFilter: Test empty", "[mbr_filter]") {
+  MBRFilter filter;
+  CHECK(filter.mbr_num() == 0);
+
+  std::vector<uint64_t> candidates;
+  int64_t subarray[] = {0, 100};
+  CHECK(filter.get_candidates(subarray, 0, 0, &candidates).ok());
+  CHECK(candidates.empty());
+}
+
+TEST_CASE("MBRFilter: Test 1D", "[mbr_filter]") {
+  // 100 MBRs, MBR i covering [10*i, 10*i+9]; the count is not a
+  // multiple of the vector width, exercising the scalar tail
+  uint64_t mbr_num = 100;
+  std::vector<int64_t> mbrs(2 * mbr_num);
+  for (uint64_t i = 0; i < mbr_num; ++i) {
+    mbrs[2 * i] = 10 * i;
+    mbrs[2 * i + 1] = 10 * i + 9;
+  }
+
+  MBRFilter filter;
+  REQUIRE(filter.init(Datatype::INT64, 1, mbrs.data(), mbr_num).ok());
+  CHECK(filter.mbr_num() == mbr_num);
+
+  // Subarray overlapping MBRs 2-5
+  std::vector<uint64_t> candidates;
+  int64_t subarray[] = {25, 52};
+  CHECK(filter.get_candidates(subarray, 0, mbr_num, &candidates).ok());
+  REQUIRE(candidates.size() == 4);
+  CHECK(candidates[0] == 2);
+  CHECK(candidates[1] == 3);
+  CHECK(candidates[2] == 4);
+  CHECK(candidates[3] == 5);
+
+  // The same subarray restricted to the range [4, 20) of MBRs
+  candidates.clear();
+  CHECK(filter.get_candidates(subarray, 4, 20, &candidates).ok());
+  REQUIRE(candidates.size() == 2);
+  CHECK(candidates[0] == 4);
+  CHECK(candidates[1] == 5);
+
+  // Subarray containing everything
+  candidates.clear();
+  int64_t full_subarray[] = {0, 1000};
+  CHECK(filter.get_candidates(full_subarray, 0, mbr_num, &candidates).ok());
+  REQUIRE(candidates.size() == mbr_num);
+  for (uint64_t i = 0; i < mbr_num; ++i)
+    CHECK(candidates[i] == i);
+
+  // Subarray overlapping nothing
+  candidates.clear();
+  int64_t empty_subarray[] = {2000, 3000};
+  CHECK(filter.get_candidates(empty_subarray, 0, mbr_num, &candidates).ok());
+  CHECK(candidates.empty());
+}
+
+TEST_CASE("MBRFilter: Test 2D", "[mbr_filter]") {
+  // A 10x10 grid of MBRs in row-major order, MBR (r, c) covering
+  // [10*r, 10*r+9] x [10*c, 10*c+9]
+  std::vector<double> mbrs(4 * 100);
+  for (uint64_t r = 0; r < 10; ++r) {
+    for (uint64_t c = 0; c < 10; ++c) {
+      auto i = 10 * r + c;
+      mbrs[4 * i] = double(10 * r);
+      mbrs[4 * i + 1] = double(10 * r + 9);
+      mbrs[4 * i + 2] = double(10 * c);
+      mbrs[4 * i + 3] = double(10 * c + 9);
+    }
+  }
+
+  MBRFilter filter;
+  REQUIRE(filter.init(Datatype::FLOAT64, 2, mbrs.data(), 100).ok());
+
+  // Subarray overlapping rows 1-2 and columns 3-4
+  std::vector<uint64_t> candidates;
+  double subarray[] = {10.0, 25.0, 30.0, 42.0};
+  CHECK(filter.get_candidates(subarray, 0, 100, &candidates).ok());
+  REQUIRE(candidates.size() == 4);
+  CHECK(candidates[0] == 13);
+  CHECK(candidates[1] == 14);
+  CHECK(candidates[2] == 23);
+  CHECK(candidates[3] == 24);
+}
+
+TEST_CASE("MBRFilter: Test unsigned order", "[mbr_filter]") {
+  // MBRs straddling the signed/unsigned boundary; the filter must
+  // compare them in unsigned order
+  uint64_t big = uint64_t(1) << 63;
+  std::vector<uint64_t> mbrs = {0, 10, big - 5, big + 5, big + 10, big + 20};
+
+  MBRFilter filter;
+  REQUIRE(filter.init(Datatype::UINT64, 1, mbrs.data(), 3).ok());
+
+  std::vector<uint64_t> candidates;
+  uint64_t subarray[] = {big, big + 12};
+  CHECK(filter.get_candidates(subarray, 0, 3, &candidates).ok());
+  REQUIRE(candidates.size() == 2);
+  CHECK(candidates[0] == 1);
+  CHECK(candidates[1] == 2);
+}
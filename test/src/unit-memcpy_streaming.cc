@@ -0,0 +1,66 @@
+/**
+ * @file unit-memcpy_streaming.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests the streaming (non-temporal) memory copy.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/utils.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace tiledb::sm;
+
+TEST_CASE(
+    "Memcpy streaming: Test all alignments and sizes", "[memcpy_streaming]") {
+  // Exercise every combination of source/destination misalignment with
+  // sizes around the head/bulk/tail boundaries of the kernel
+  const uint64_t max_size = 300;
+  std::vector<unsigned char> src(max_size + 16);
+  for (uint64_t i = 0; i < src.size(); ++i)
+    src[i] = (unsigned char)(i * 131 + 17);
+
+  std::vector<unsigned char> dest(max_size + 16);
+  for (unsigned src_align = 0; src_align < 16; ++src_align) {
+    for (unsigned dest_align = 0; dest_align < 16; ++dest_align) {
+      for (uint64_t size : {0, 1, 15, 16, 17, 63, 64, 65, 127, 200, 300}) {
+        std::memset(&dest[0], 0xAB, dest.size());
+        utils::memcpy_streaming(&dest[dest_align], &src[src_align], size);
+        CHECK(std::memcmp(&dest[dest_align], &src[src_align], size) == 0);
+
+        // The bytes around the destination must be untouched
+        if (dest_align > 0)
+          CHECK(dest[dest_align - 1] == 0xAB);
+        if (dest_align + size < dest.size())
+          CHECK(dest[dest_align + size] == 0xAB);
+      }
+    }
+  }
+}
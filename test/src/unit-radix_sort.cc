@@ -0,0 +1,86 @@
+/**
+ * @file   unit-radix_sort.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the parallel radix sort.
+ */
+
+#include <catch.hpp>
+#include <random>
+#include "tiledb/sm/misc/radix_sort.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("RadixSort: Test empty and single", "[radix_sort]") {
+  ThreadPool pool(4);
+
+  std::vector<std::pair<uint64_t, uint64_t>> pairs;
+  radix_sort::sort_pairs(&pool, &pairs);
+  CHECK(pairs.empty());
+
+  pairs.emplace_back(10, 0);
+  radix_sort::sort_pairs(&pool, &pairs);
+  REQUIRE(pairs.size() == 1);
+  CHECK(pairs[0].first == 10);
+}
+
+TEST_CASE("RadixSort: Test random keys", "[radix_sort]") {
+  ThreadPool pool(4);
+
+  std::mt19937_64 gen(0);
+  std::vector<std::pair<uint64_t, uint64_t>> pairs;
+  for (uint64_t i = 0; i < 100000; ++i)
+    pairs.emplace_back(gen(), i);
+
+  auto expected = pairs;
+  std::stable_sort(
+      expected.begin(),
+      expected.end(),
+      [](const std::pair<uint64_t, uint64_t>& a,
+         const std::pair<uint64_t, uint64_t>& b) { return a.first < b.first; });
+
+  radix_sort::sort_pairs(&pool, &pairs);
+  CHECK(pairs == expected);
+}
+
+TEST_CASE("RadixSort: Test stability", "[radix_sort]") {
+  ThreadPool pool(4);
+
+  // Many duplicate keys; values must retain their original order per key
+  std::vector<std::pair<uint64_t, uint64_t>> pairs;
+  for (uint64_t i = 0; i < 10000; ++i)
+    pairs.emplace_back(i % 7, i);
+
+  radix_sort::sort_pairs(&pool, &pairs);
+
+  for (uint64_t i = 1; i < pairs.size(); ++i) {
+    CHECK(pairs[i - 1].first <= pairs[i].first);
+    if (pairs[i - 1].first == pairs[i].first)
+      CHECK(pairs[i - 1].second < pairs[i].second);
+  }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file   unit-rtree.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `RTree` class.
+ */
+
+#include <catch.hpp>
+#include "tiledb/sm/fragment/rtree.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("RTree: Test empty", "[rtree]") {
+  RTree rtree;
+  CHECK(rtree.leaf_num() == 0);
+
+  std::vector<std::pair<uint64_t, bool>> result;
+  int64_t subarray[] = {0, 100};
+  CHECK(rtree.get_overlapping_tiles(subarray, &result).ok());
+  CHECK(result.empty());
+}
+
+TEST_CASE("RTree: Test 1D", "[rtree]") {
+  // 100 leaves, leaf i covering [10*i, 10*i+9]
+  uint64_t leaf_num = 100;
+  std::vector<std::vector<int64_t>> mbr_data(leaf_num);
+  std::vector<void*> mbrs(leaf_num);
+  for (uint64_t i = 0; i < leaf_num; ++i) {
+    mbr_data[i] = {int64_t(10 * i), int64_t(10 * i + 9)};
+    mbrs[i] = mbr_data[i].data();
+  }
+
+  RTree rtree;
+  REQUIRE(rtree.init(Datatype::INT64, 1, 3, mbrs).ok());
+  CHECK(rtree.leaf_num() == leaf_num);
+
+  // Subarray overlapping leaves 2-5, fully containing only 3-4
+  std::vector<std::pair<uint64_t, bool>> result;
+  int64_t subarray[] = {25, 52};
+  CHECK(rtree.get_overlapping_tiles(subarray, &result).ok());
+  REQUIRE(result.size() == 4);
+  CHECK(result[0] == std::make_pair(uint64_t(2), false));
+  CHECK(result[1] == std::make_pair(uint64_t(3), true));
+  CHECK(result[2] == std::make_pair(uint64_t(4), true));
+  CHECK(result[3] == std::make_pair(uint64_t(5), false));
+
+  // Subarray containing everything
+  int64_t full_subarray[] = {0, 1000};
+  CHECK(rtree.get_overlapping_tiles(full_subarray, &result).ok());
+  REQUIRE(result.size() == leaf_num);
+  for (uint64_t i = 0; i < leaf_num; ++i)
+    CHECK(result[i] == std::make_pair(i, true));
+
+  // Subarray overlapping nothing
+  int64_t empty_subarray[] = {2000, 3000};
+  CHECK(rtree.get_overlapping_tiles(empty_subarray, &result).ok());
+  CHECK(result.empty());
+}
+
+TEST_CASE("RTree: Test 2D", "[rtree]") {
+  // A 10x10 grid of leaves in row-major order, leaf (r, c) covering
+  // [10*r, 10*r+9] x [10*c, 10*c+9]
+  std::vector<std::vector<double>> mbr_data(100);
+  std::vector<void*> mbrs(100);
+  for (uint64_t r = 0; r < 10; ++r) {
+    for (uint64_t c = 0; c < 10; ++c) {
+      auto i = 10 * r + c;
+      mbr_data[i] = {
+          double(10 * r), double(10 * r + 9), double(10 * c),
+          double(10 * c + 9)};
+      mbrs[i] = mbr_data[i].data();
+    }
+  }
+
+  RTree rtree;
+  REQUIRE(rtree.init(Datatype::FLOAT64, 2, 5, mbrs).ok());
+  CHECK(rtree.leaf_num() == 100);
+
+  // Subarray overlapping rows 1-2 and columns 3-4, containing only (1, 3)
+  std::vector<std::pair<uint64_t, bool>> result;
+  double subarray[] = {10.0, 25.0, 30.0, 42.0};
+  CHECK(rtree.get_overlapping_tiles(subarray, &result).ok());
+  REQUIRE(result.size() == 4);
+  CHECK(result[0] == std::make_pair(uint64_t(13), true));
+  CHECK(result[1] == std::make_pair(uint64_t(14), false));
+  CHECK(result[2] == std::make_pair(uint64_t(23), false));
+  CHECK(result[3] == std::make_pair(uint64_t(24), false));
+}
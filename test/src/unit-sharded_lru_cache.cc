@@ -0,0 +1,95 @@
+/**
+ * @file unit-sharded_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `ShardedLRUCache` class.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+#include "tiledb/sm/cache/sharded_lru_cache.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE(
+    "ShardedLRUCache: Test insert and read", "[cache], [sharded_lru_cache]") {
+  ShardedLRUCache cache(1024, 4);
+  CHECK(cache.max_size() == 1024);
+  CHECK(cache.shard_num() == 4);
+
+  // Insert some items
+  for (int i = 0; i < 10; ++i) {
+    auto v = (int*)std::malloc(sizeof(int));
+    *v = i;
+    CHECK(cache.insert(CacheKey(i, 0), v, sizeof(int)).ok());
+  }
+
+  // Read them back
+  for (int i = 0; i < 10; ++i) {
+    int v = 0;
+    bool success = false;
+    CHECK(cache.read(CacheKey(i, 0), &v, 0, sizeof(int), &success).ok());
+    CHECK(success);
+    CHECK(v == i);
+  }
+
+  // Non-existent key
+  int v = 0;
+  bool success = true;
+  CHECK(cache.read(CacheKey(1000, 0), &v, 0, sizeof(int), &success).ok());
+  CHECK(!success);
+}
+
+TEST_CASE(
+    "ShardedLRUCache: Test concurrent access",
+    "[cache], [sharded_lru_cache]") {
+  ShardedLRUCache cache(1024 * 1024, 8);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 100; ++i) {
+        CacheKey key(t, i);
+        auto v = (int*)std::malloc(sizeof(int));
+        *v = i;
+        REQUIRE(cache.insert(key, v, sizeof(int)).ok());
+        int read_v = 0;
+        bool success = false;
+        REQUIRE(cache.read(key, &read_v, 0, sizeof(int), &success).ok());
+        REQUIRE(success);
+        REQUIRE(read_v == i);
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+}
@@ -67,6 +67,32 @@ TEST_CASE("Status: Test code_to_string", "[status]") {
   CHECK_THAT(err.code_to_string(), Catch::Equals("Error"));
 }
 
+TEST_CASE("Status: Test code-only status", "[status]") {
+  Status err = Status(StatusCode::Buffer);
+  CHECK(!err.ok());
+  CHECK(StatusCode::Buffer == err.code());
+  CHECK_THAT(err.message(), Catch::Equals(""));
+  CHECK_THAT(err.to_string(), Catch::Equals("[TileDB::Buffer] Error"));
+  CHECK(err.posix_code() == -1);
+
+  // Copies share the static state
+  Status copy = err;
+  CHECK(StatusCode::Buffer == copy.code());
+  err = copy;
+  CHECK(StatusCode::Buffer == err.code());
+}
+
+TEST_CASE("Status: Test move", "[status]") {
+  Status err = Status::Error("err msg");
+  Status moved = std::move(err);
+  CHECK(StatusCode::Error == moved.code());
+  CHECK_THAT(moved.message(), Catch::Equals("err msg"));
+
+  Status target = Status::Error("other");
+  target = std::move(moved);
+  CHECK_THAT(target.message(), Catch::Equals("err msg"));
+}
+
 TEST_CASE("Status: Test posix_code", "[status]") {
   Status st = Status::Ok();
   // check that posix code is < 0 by default
@@ -70,6 +70,22 @@ TEST_CASE("ThreadPool: Test multiple threads", "[threadpool]") {
   CHECK(result == 100);
 }
 
+TEST_CASE("ThreadPool: Test NUMA-aware pool", "[threadpool]") {
+  // On single-node machines the pool falls back to the regular
+  // behavior; either way the tasks must all execute
+  std::atomic<int> result(0);
+  std::vector<std::future<Status>> results;
+  ThreadPool pool(4, true);
+  for (int i = 0; i < 100; i++) {
+    results.push_back(pool.enqueue([&result]() {
+      result++;
+      return Status::Ok();
+    }));
+  }
+  CHECK(pool.wait_all(results));
+  CHECK(result == 100);
+}
+
 TEST_CASE("ThreadPool: Test wait status", "[threadpool]") {
   std::atomic<int> result(0);
   std::vector<std::future<Status>> results;
@@ -84,6 +100,77 @@ TEST_CASE("ThreadPool: Test wait status", "[threadpool]") {
   CHECK(result == 100);
 }
 
+TEST_CASE("ThreadPool: Test nested parallelism", "[threadpool]") {
+  std::atomic<int> result(0);
+  std::vector<std::future<Status>> results;
+  ThreadPool pool(2);
+  // More outer tasks than threads; each outer task opens a nested
+  // parallel region on the same pool and waits on it. This would
+  // deadlock if waiting threads blocked instead of executing tasks.
+  for (int i = 0; i < 10; i++) {
+    results.push_back(pool.enqueue([&result, &pool]() {
+      std::vector<std::future<Status>> inner;
+      for (int j = 0; j < 10; j++) {
+        inner.push_back(pool.enqueue([&result]() {
+          result++;
+          return Status::Ok();
+        }));
+      }
+      return pool.wait_all(inner) ? Status::Ok() : Status::Error("Inner error");
+    }));
+  }
+  CHECK(pool.wait_all(results));
+  CHECK(result == 100);
+}
+
+TEST_CASE("ThreadPool: Test task group", "[threadpool]") {
+  std::atomic<int> result(0);
+  ThreadPool pool(4);
+  ThreadPool::TaskGroup group(&pool);
+  for (int i = 0; i < 100; i++) {
+    group.run([&result]() {
+      result++;
+      return Status::Ok();
+    });
+  }
+  CHECK(group.wait().ok());
+  CHECK(result == 100);
+}
+
+TEST_CASE("ThreadPool: Test task group error status", "[threadpool]") {
+  std::atomic<int> result(0);
+  ThreadPool pool(4);
+  ThreadPool::TaskGroup group(&pool);
+  for (int i = 0; i < 100; i++) {
+    group.run([&result, i]() {
+      result++;
+      return i == 50 ? Status::Error("Generic error") : Status::Ok();
+    });
+  }
+  CHECK(!group.wait().ok());
+  CHECK(result == 100);
+}
+
+TEST_CASE("ThreadPool: Test nested task groups", "[threadpool]") {
+  std::atomic<int> result(0);
+  ThreadPool pool(2);
+  ThreadPool::TaskGroup group(&pool);
+  for (int i = 0; i < 10; i++) {
+    group.run([&result, &pool]() {
+      ThreadPool::TaskGroup inner(&pool);
+      for (int j = 0; j < 10; j++) {
+        inner.run([&result]() {
+          result++;
+          return Status::Ok();
+        });
+      }
+      return inner.wait();
+    });
+  }
+  CHECK(group.wait().ok());
+  CHECK(result == 100);
+}
+
 TEST_CASE("ThreadPool: Test no wait", "[threadpool]") {
   {
     ThreadPool pool(4);
@@ -176,3 +176,21 @@ TEST_CASE("URI: Test Windows paths", "[uri]") {
 }
 
 #endif
+
+TEST_CASE("URI: Test interning", "[uri]") {
+  // Equal paths share a single interned string, so copying a URI copies
+  // a pointer and `c_str()` remains valid after the URI is destroyed
+  URI uri1("file:///my/path");
+  URI uri2("file:///my/path");
+  CHECK(uri1.c_str() == uri2.c_str());
+
+  URI copy = uri1;
+  CHECK(copy.c_str() == uri1.c_str());
+
+  const char* c_str;
+  {
+    URI scoped("file:///my/path");
+    c_str = scoped.c_str();
+  }
+  CHECK(std::string(c_str) == "file:///my/path");
+}
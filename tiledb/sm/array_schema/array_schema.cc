@@ -59,6 +59,7 @@ ArraySchema::ArraySchema() {
   coords_compression_ = constants::coords_compression;
   coords_compression_level_ = constants::coords_compression_level;
   is_kv_ = false;
+  kv_hash_ = KVHash::MD5;
   domain_ = nullptr;
   tile_order_ = Layout::ROW_MAJOR;
   std::memcpy(version_, constants::version, sizeof(version_));
@@ -76,6 +77,7 @@ ArraySchema::ArraySchema(ArrayType array_type)
   coords_compression_ = constants::coords_compression;
   coords_compression_level_ = constants::coords_compression_level;
   is_kv_ = false;
+  kv_hash_ = KVHash::MD5;
   domain_ = nullptr;
   tile_order_ = Layout::ROW_MAJOR;
   std::memcpy(version_, constants::version, sizeof(version_));
@@ -84,7 +86,10 @@ ArraySchema::ArraySchema(ArrayType array_type)
 ArraySchema::ArraySchema(const ArraySchema* array_schema) {
   array_uri_ = array_schema->array_uri_;
   array_type_ = array_schema->array_type_;
-  attributes_ = array_schema->attributes_;
+  for (auto attr : array_schema->attributes_) {
+    attributes_.push_back(new Attribute(attr));
+    index_attribute((unsigned int)attributes_.size() - 1);
+  }
   attribute_num_ = array_schema->attribute_num();
   capacity_ = array_schema->capacity_;
   cell_order_ = array_schema->cell_order_;
@@ -96,7 +101,10 @@ ArraySchema::ArraySchema(const ArraySchema* array_schema) {
   coords_compression_level_ = array_schema->coords_compression_level_;
   coords_size_ = array_schema->coords_size_;
   is_kv_ = array_schema->is_kv_;
-  domain_ = array_schema->domain_;
+  kv_hash_ = array_schema->kv_hash_;
+  domain_ = (array_schema->domain_ == nullptr) ?
+                nullptr :
+                new Domain(array_schema->domain_);
   tile_order_ = array_schema->tile_order_;
   std::memcpy(version_, array_schema->version_, sizeof(version_));
 }
@@ -124,15 +132,10 @@ const Attribute* ArraySchema::attribute(unsigned int id) const {
 }
 
 const Attribute* ArraySchema::attribute(std::string name) const {
-  bool anonymous = name.empty();
-  unsigned int nattr = attribute_num();
-  for (unsigned int i = 0; i < nattr; i++) {
-    auto attr = attribute(i);
-    if ((attr->name() == name) || (anonymous && attr->is_anonymous())) {
-      return attr;
-    }
-  }
-  return nullptr;
+  auto it = attribute_name_ids_.find(name);
+  if (it == attribute_name_ids_.end())
+    return nullptr;
+  return attributes_[it->second];
 }
 
 const std::string& ArraySchema::attribute_name(
@@ -144,23 +147,19 @@ const std::string& ArraySchema::attribute_name(
 
 Status ArraySchema::attribute_id(
     const std::string& attribute_name, unsigned int* id) const {
-  bool anonymous = attribute_name.empty();
   // Special case - coordinates
   if (attribute_name == constants::coords) {
     *id = attribute_num_;
     return Status::Ok();
   }
-  for (unsigned int i = 0; i < attribute_num_; ++i) {
-    auto attr = attributes_[i];
-    if ((attr->name() == attribute_name) ||
-        (anonymous && attr->is_anonymous())) {
-      *id = i;
-      return Status::Ok();
-    }
+  auto it = attribute_name_ids_.find(attribute_name);
+  if (it != attribute_name_ids_.end()) {
+    *id = it->second;
+    return Status::Ok();
   }
   return LOG_STATUS(Status::ArraySchemaError(
       std::string("Attribute not found: ") +
-      (anonymous ? "<anonymous>" : attribute_name)));
+      (attribute_name.empty() ? "<anonymous>" : attribute_name)));
 }
 
 std::vector<std::string> ArraySchema::attribute_names() const {
@@ -287,6 +286,23 @@ Status ArraySchema::check() const {
     }
   }
 
+  if (tile_order_ == Layout::MORTON)
+    return LOG_STATUS(
+        Status::ArraySchemaError("Array schema check failed; The morton "
+                                 "layout applies only to the cell order"));
+
+  if (cell_order_ == Layout::MORTON) {
+    if (array_type_ == ArrayType::DENSE)
+      return LOG_STATUS(
+          Status::ArraySchemaError("Array schema check failed; The morton "
+                                   "cell order applies only to sparse arrays"));
+    if (domain_->type() == Datatype::FLOAT32 ||
+        domain_->type() == Datatype::FLOAT64)
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Array schema check failed; The morton cell order can not "
+          "be used with floating point domains"));
+  }
+
   if (!check_double_delta_compressor())
     return LOG_STATUS(Status::ArraySchemaError(
         "Array schema check failed; Double delta compression can be used "
@@ -410,6 +426,11 @@ Status ArraySchema::get_attribute_ids(
 //   attribute #1
 //   attribute #2
 //   ...
+// kv_hash (char) - absent in schemas written before its introduction
+KVHash ArraySchema::kv_hash() const {
+  return kv_hash_;
+}
+
 Status ArraySchema::serialize(Buffer* buff) const {
   // Write version
   RETURN_NOT_OK(buff->write(constants::version, sizeof(constants::version)));
@@ -445,6 +466,10 @@ Status ArraySchema::serialize(Buffer* buff) const {
   for (auto& attr : attributes_)
     RETURN_NOT_OK(attr->serialize(buff));
 
+  // Write the key-value hash function
+  auto kv_hash = (char)kv_hash_;
+  RETURN_NOT_OK(buff->write(&kv_hash, sizeof(char)));
+
   return Status::Ok();
 }
 
@@ -498,6 +523,7 @@ Status ArraySchema::add_attribute(const Attribute* attr) {
     new_attr = new Attribute(attr);
   }
   attributes_.emplace_back(new_attr);
+  index_attribute(attribute_num_);
   ++attribute_num_;
   return Status::Ok();
 }
@@ -518,6 +544,7 @@ Status ArraySchema::add_attribute(const Attribute* attr) {
 //   attribute #1
 //   attribute #2
 //   ...
+// kv_hash (char) - absent in schemas written before its introduction
 Status ArraySchema::deserialize(ConstBuffer* buff, bool is_kv) {
   is_kv_ = is_kv;
 
@@ -558,12 +585,28 @@ Status ArraySchema::deserialize(ConstBuffer* buff, bool is_kv) {
   domain_ = new Domain();
   RETURN_NOT_OK(domain_->deserialize(buff));
 
+  // Schemas written before library version 1.3.1 lack the trailing
+  // per-attribute flag bytes (shuffle et al.)
+  bool attr_flags =
+      (version_[0] > 1) || (version_[0] == 1 && version_[1] > 3) ||
+      (version_[0] == 1 && version_[1] == 3 && version_[2] >= 1);
+
   // Load attributes
   RETURN_NOT_OK(buff->read(&attribute_num_, sizeof(unsigned int)));
   for (unsigned int i = 0; i < attribute_num_; ++i) {
     auto attr = new Attribute();
-    attr->deserialize(buff);
+    attr->deserialize(buff, attr_flags);
     attributes_.emplace_back(attr);
+    index_attribute(i);
+  }
+
+  // Load the key-value hash function. Schemas written before the hash
+  // function became selectable lack this field; they used MD5.
+  kv_hash_ = KVHash::MD5;
+  if (buff->nbytes_left_to_read() >= sizeof(char)) {
+    char kv_hash;
+    RETURN_NOT_OK(buff->read(&kv_hash, sizeof(char)));
+    kv_hash_ = (KVHash)kv_hash;
   }
 
   // Initialize the rest of the object members
@@ -596,6 +639,16 @@ Status ArraySchema::init() {
   return Status::Ok();
 }
 
+Status ArraySchema::set_kv_hash(KVHash kv_hash) {
+  if (!is_kv_)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot set hash function; The array is not a key-value store"));
+
+  kv_hash_ = kv_hash;
+
+  return Status::Ok();
+}
+
 Status ArraySchema::set_as_kv() {
   // Do nothing if the array is already set as a key-value store
   if (is_kv_)
@@ -713,6 +766,15 @@ void ArraySchema::set_tile_order(Layout tile_order) {
 /*         PRIVATE METHODS        */
 /* ****************************** */
 
+void ArraySchema::index_attribute(unsigned int id) {
+  auto attr = attributes_[id];
+  attribute_name_ids_[attr->name()] = id;
+
+  // The anonymous attribute may also be located by the empty name
+  if (attr->is_anonymous())
+    attribute_name_ids_[""] = id;
+}
+
 bool ArraySchema::check_attribute_dimension_names() const {
   std::set<std::string> names;
   auto dim_num = this->dim_num();
@@ -751,6 +813,7 @@ void ArraySchema::clear() {
   for (auto& attr : attributes_)
     delete attr;
   attributes_.clear();
+  attribute_name_ids_.clear();
   attribute_num_ = 0;
 
   delete domain_;
@@ -781,6 +844,7 @@ Status ArraySchema::set_kv_attributes() {
   key_attr->set_cell_val_num(constants::var_num);
   key_attr->set_compressor(constants::key_attr_compressor);
   attributes_.emplace_back(key_attr);
+  index_attribute(attribute_num_);
   ++attribute_num_;
 
   // Add key type attribute
@@ -788,6 +852,7 @@ Status ArraySchema::set_kv_attributes() {
       constants::key_type_attr_name, constants::key_type_attr_type);
   key_type_attr->set_compressor(constants::key_type_attr_compressor);
   attributes_.emplace_back(key_type_attr);
+  index_attribute(attribute_num_);
   ++attribute_num_;
 
   return Status::Ok();
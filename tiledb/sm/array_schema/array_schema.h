@@ -36,6 +36,7 @@
 
 #include <string>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "tiledb/sm/array_schema/attribute.h"
@@ -45,6 +46,7 @@
 #include "tiledb/sm/enums/array_type.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/kv_hash.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/status.h"
@@ -217,6 +219,12 @@ class ArraySchema {
   /** Checks if the array is defined as a key-value store. */
   bool is_kv() const;
 
+  /**
+   * Returns the hash function used to map keys to coordinates, applicable
+   * only if the array is defined as a key-value store.
+   */
+  KVHash kv_hash() const;
+
   /**
    * Serializes the array schema object into a buffer.
    *
@@ -263,6 +271,12 @@ class ArraySchema {
   /** Defines the array as a key-value store. */
   Status set_as_kv();
 
+  /**
+   * Sets the hash function used to map keys to coordinates. The function
+   * returns an error if the array is not defined as a key-value store.
+   */
+  Status set_kv_hash(KVHash kv_hash);
+
   /** Sets an array URI. */
   void set_array_uri(const URI& array_uri);
 
@@ -325,6 +339,15 @@ class ArraySchema {
 
   /** The array attributes. */
   std::vector<Attribute*> attributes_;
+
+  /**
+   * Maps an attribute name to its id in `attributes_`, so that name
+   * resolution takes constant time instead of a linear scan (arrays may
+   * carry hundreds of attributes). The anonymous attribute is indexed
+   * under the empty name as well.
+   */
+  std::unordered_map<std::string, unsigned int> attribute_name_ids_;
+
   /**
    * The tile capacity for the case of sparse fragments.
    */
@@ -361,6 +384,12 @@ class ArraySchema {
   /** `true` if the array is a key-value store. */
   bool is_kv_;
 
+  /**
+   * The hash function used to map keys to coordinates, applicable only
+   * if the array is a key-value store.
+   */
+  KVHash kv_hash_;
+
   /**
    * The tile order. It can be one of the following:
    *    - TILEDB_ROW_MAJOR
@@ -381,6 +410,13 @@ class ArraySchema {
    */
   bool check_attribute_dimension_names() const;
 
+  /**
+   * Registers the attribute with the input id in the name-to-id index.
+   * Must be called right after the attribute is appended to
+   * `attributes_`.
+   */
+  void index_attribute(unsigned int id);
+
   /**
    * Returns false if double delta compression is used with real attributes
    * or coordinates and true otherwise.
@@ -53,6 +53,9 @@ Attribute::Attribute(const char* name, Datatype type) {
   cell_val_num_ = (type == Datatype::ANY) ? constants::var_num : 1;
   compressor_ = Compressor::NO_COMPRESSION;
   compression_level_ = -1;
+  shuffle_ = false;
+  dict_encode_ = false;
+  offsets_32_ = false;
 }
 
 Attribute::Attribute(const Attribute* attr) {
@@ -63,6 +66,9 @@ Attribute::Attribute(const Attribute* attr) {
   cell_val_num_ = attr->cell_val_num();
   compressor_ = attr->compressor();
   compression_level_ = attr->compression_level();
+  shuffle_ = attr->shuffle();
+  dict_encode_ = attr->dict_encode();
+  offsets_32_ = attr->offsets_32();
 }
 
 Attribute::~Attribute() = default;
@@ -90,6 +96,18 @@ int Attribute::compression_level() const {
   return compression_level_;
 }
 
+bool Attribute::shuffle() const {
+  return shuffle_;
+}
+
+bool Attribute::dict_encode() const {
+  return dict_encode_;
+}
+
+bool Attribute::offsets_32() const {
+  return offsets_32_;
+}
+
 // ===== FORMAT =====
 // attribute_name_size (unsigned int)
 // attribute_name (string)
@@ -97,7 +115,10 @@ int Attribute::compression_level() const {
 // compressor (char)
 // compression_level (int)
 // cell_val_num (unsigned int)
-Status Attribute::deserialize(ConstBuffer* buff) {
+// shuffle (char) - absent in schemas written before version 1.3.1
+// dict_encode (char) - absent in schemas written before version 1.3.1
+// offsets_32 (char) - absent in schemas written before version 1.3.1
+Status Attribute::deserialize(ConstBuffer* buff, bool attr_flags) {
   // Load attribute name
   unsigned int attribute_name_size;
   RETURN_NOT_OK(buff->read(&attribute_name_size, sizeof(unsigned int)));
@@ -118,6 +139,31 @@ Status Attribute::deserialize(ConstBuffer* buff) {
   // Load cell_val_num_
   RETURN_NOT_OK(buff->read(&cell_val_num_, sizeof(unsigned int)));
 
+  // Load shuffle. Schemas written before version 1.3.1 lack this
+  // field; those libraries never shuffled.
+  shuffle_ = false;
+  if (attr_flags) {
+    char shuffle;
+    RETURN_NOT_OK(buff->read(&shuffle, sizeof(char)));
+    shuffle_ = (bool)shuffle;
+  }
+
+  // Load dict_encode, absent in schemas written before version 1.3.1
+  dict_encode_ = false;
+  if (attr_flags) {
+    char dict_encode;
+    RETURN_NOT_OK(buff->read(&dict_encode, sizeof(char)));
+    dict_encode_ = (bool)dict_encode;
+  }
+
+  // Load offsets_32, absent in schemas written before version 1.3.1
+  offsets_32_ = false;
+  if (attr_flags) {
+    char offsets_32;
+    RETURN_NOT_OK(buff->read(&offsets_32, sizeof(char)));
+    offsets_32_ = (bool)offsets_32;
+  }
+
   return Status::Ok();
 }
 
@@ -132,6 +178,12 @@ void Attribute::dump(FILE* out) const {
   fprintf(out, "- Type: %s\n", type_s);
   fprintf(out, "- Compressor: %s\n", compressor_s);
   fprintf(out, "- Compression level: %d\n", compression_level_);
+  fprintf(out, "- Shuffle: %s\n", (shuffle_) ? "true" : "false");
+  fprintf(
+      out,
+      "- Dictionary encoding: %s\n",
+      (dict_encode_) ? "true" : "false");
+  fprintf(out, "- 32-bit offsets: %s\n", (offsets_32_) ? "true" : "false");
 
   if (!var_size())
     fprintf(out, "- Cell val num: %u\n", cell_val_num_);
@@ -155,6 +207,9 @@ bool Attribute::is_anonymous() const {
 // compressor (char)
 // compression_level (int)
 // cell_val_num (unsigned int)
+// shuffle (char)
+// dict_encode (char)
+// offsets_32 (char)
 Status Attribute::serialize(Buffer* buff) {
   // Write attribute name
   auto attribute_name_size = (unsigned int)name_.size();
@@ -173,6 +228,18 @@ Status Attribute::serialize(Buffer* buff) {
   // Write cell_val_num_
   RETURN_NOT_OK(buff->write(&cell_val_num_, sizeof(unsigned int)));
 
+  // Write shuffle
+  auto shuffle = (char)shuffle_;
+  RETURN_NOT_OK(buff->write(&shuffle, sizeof(char)));
+
+  // Write dict_encode
+  auto dict_encode = (char)dict_encode_;
+  RETURN_NOT_OK(buff->write(&dict_encode, sizeof(char)));
+
+  // Write offsets_32
+  auto offsets_32 = (char)offsets_32_;
+  RETURN_NOT_OK(buff->write(&offsets_32, sizeof(char)));
+
   return Status::Ok();
 }
 
@@ -195,6 +262,18 @@ void Attribute::set_compression_level(int compression_level) {
   compression_level_ = compression_level;
 }
 
+void Attribute::set_shuffle(bool shuffle) {
+  shuffle_ = shuffle;
+}
+
+void Attribute::set_dict_encode(bool dict_encode) {
+  dict_encode_ = dict_encode;
+}
+
+void Attribute::set_offsets_32(bool offsets_32) {
+  offsets_32_ = offsets_32;
+}
+
 void Attribute::set_name(const std::string& name) {
   name_ = name;
 }
@@ -93,13 +93,35 @@ class Attribute {
   /** Returns the compression level. */
   int compression_level() const;
 
+  /**
+   * Returns `true` if the attribute values are byte-shuffled before
+   * compression.
+   */
+  bool shuffle() const;
+
+  /**
+   * Returns `true` if the attribute values are dictionary-encoded before
+   * compression.
+   */
+  bool dict_encode() const;
+
+  /**
+   * Returns `true` if the cell offsets of the attribute are stored as
+   * 32-bit values on disk.
+   */
+  bool offsets_32() const;
+
   /**
    * Populates the object members from the data in the input binary buffer.
    *
    * @param buff The buffer to deserialize from.
+   * @param attr_flags `true` if the serialized attribute carries the
+   *     trailing flag bytes (shuffle et al.), which schemas written
+   *     before library version 1.3.1 lack. The absent flags default to
+   *     `false`, matching the behavior of the older libraries.
    * @return Status
    */
-  Status deserialize(ConstBuffer* buff);
+  Status deserialize(ConstBuffer* buff, bool attr_flags);
 
   /** Dumps the attribute contents in ASCII form in the selected output. */
   void dump(FILE* out) const;
@@ -133,6 +155,24 @@ class Attribute {
   /** Sets the attribute compression level. */
   void set_compression_level(int compression_level);
 
+  /**
+   * Sets whether the attribute values are byte-shuffled before
+   * compression.
+   */
+  void set_shuffle(bool shuffle);
+
+  /**
+   * Sets whether the attribute values are dictionary-encoded before
+   * compression. Applicable only to variable-sized attributes.
+   */
+  void set_dict_encode(bool dict_encode);
+
+  /**
+   * Sets whether the cell offsets of the attribute are stored as 32-bit
+   * values on disk. Applicable only to variable-sized attributes.
+   */
+  void set_offsets_32(bool offsets_32);
+
   /** Sets the attribute name. */
   void set_name(const std::string& name);
 
@@ -162,6 +202,21 @@ class Attribute {
   /** The attribute name. */
   std::string name_;
 
+  /** If `true`, the attribute values are byte-shuffled before compression. */
+  bool shuffle_;
+
+  /**
+   * If `true`, the attribute values are dictionary-encoded before
+   * compression.
+   */
+  bool dict_encode_;
+
+  /**
+   * If `true`, the cell offsets of the attribute are stored as 32-bit
+   * values on disk (and widened back to 64 bits upon reading).
+   */
+  bool offsets_32_;
+
   /** The attribute type. */
   Datatype type_;
 };
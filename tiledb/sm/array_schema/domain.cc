@@ -434,6 +434,25 @@ int Domain::cell_order_cmp(const T* coords_a, const T* coords_b) const {
       if (coords_a[i] > coords_b[i])
         return 1;
     }
+  } else if (cell_order_ == Layout::MORTON) {  // MORTON
+    // Find the dimension holding the most significant differing bit of
+    // the morton codes of the two (domain-normalized) coordinates,
+    // without materializing the codes
+    auto domain = static_cast<const T*>(domain_);
+    uint64_t coord_a, coord_b, coords_xor, max_xor = 0;
+    unsigned int msd = 0;
+    for (unsigned int i = 0; i < dim_num_; ++i) {
+      coord_a = (uint64_t)(coords_a[i] - domain[2 * i]);
+      coord_b = (uint64_t)(coords_b[i] - domain[2 * i]);
+      coords_xor = coord_a ^ coord_b;
+      if (max_xor < coords_xor && max_xor < (max_xor ^ coords_xor)) {
+        msd = i;
+        max_xor = coords_xor;
+      }
+    }
+    coord_a = (uint64_t)(coords_a[msd] - domain[2 * msd]);
+    coord_b = (uint64_t)(coords_b[msd] - domain[2 * msd]);
+    return (coord_a < coord_b) ? -1 : 1;
   } else {  // Invalid cell order
     assert(0);
   }
@@ -563,21 +582,70 @@ void Domain::expand_domain(T* domain) const {
 
 template <class T>
 void Domain::get_tile_coords(const T* coords, T* tile_coords) const {
+  // Dispatch to a kernel specialized for the number of dimensions
+  switch (dim_num_) {
+    case 1:
+      return get_tile_coords<T, 1>(coords, tile_coords);
+    case 2:
+      return get_tile_coords<T, 2>(coords, tile_coords);
+    case 3:
+      return get_tile_coords<T, 3>(coords, tile_coords);
+    default:
+      break;
+  }
+
   auto domain = (T*)domain_;
   auto tile_extents = (T*)tile_extents_;
   for (unsigned i = 0; i < dim_num_; i++)
     tile_coords[i] = (coords[i] - domain[2 * i]) / tile_extents[i];
 }
 
+template <class T, unsigned int DIM>
+void Domain::get_tile_coords(const T* coords, T* tile_coords) const {
+  auto domain = (T*)domain_;
+  auto tile_extents = (T*)tile_extents_;
+  for (unsigned i = 0; i < DIM; i++)
+    tile_coords[i] = (coords[i] - domain[2 * i]) / tile_extents[i];
+}
+
 template <class T>
 Status Domain::get_cell_pos(const T* coords, uint64_t* pos) const {
-  // Invoke the proper function based on the cell order
+  // Invoke the proper function based on the cell order, dispatching to
+  // a kernel specialized for the number of dimensions
   if (cell_order_ == Layout::ROW_MAJOR) {
-    *pos = get_cell_pos_row(coords);
+    switch (dim_num_) {
+      case 1:
+        *pos = get_cell_pos_row<T, 1>(coords);
+        break;
+      case 2:
+        *pos = get_cell_pos_row<T, 2>(coords);
+        break;
+      case 3:
+        *pos = get_cell_pos_row<T, 3>(coords);
+        break;
+      default:
+        *pos = get_cell_pos_row(coords);
+    }
     return Status::Ok();
   }
   if (cell_order_ == Layout::COL_MAJOR) {
-    *pos = get_cell_pos_col(coords);
+    switch (dim_num_) {
+      case 1:
+        *pos = get_cell_pos_col<T, 1>(coords);
+        break;
+      case 2:
+        *pos = get_cell_pos_col<T, 2>(coords);
+        break;
+      case 3:
+        *pos = get_cell_pos_col<T, 3>(coords);
+        break;
+      default:
+        *pos = get_cell_pos_col(coords);
+    }
+    return Status::Ok();
+  }
+  if (cell_order_ == Layout::MORTON) {
+    *pos = get_cell_pos_morton(coords);
     return Status::Ok();
   }
 
@@ -623,6 +691,8 @@ void Domain::get_next_cell_coords(
     get_next_cell_coords_row(domain, cell_coords, coords_retrieved);
   else if (cell_order_ == Layout::COL_MAJOR)
     get_next_cell_coords_col(domain, cell_coords, coords_retrieved);
+  else if (cell_order_ == Layout::MORTON)
+    get_next_cell_coords_morton(domain, cell_coords, coords_retrieved);
   else  // Sanity check
     assert(0);
 }
@@ -657,6 +727,8 @@ void Domain::get_previous_cell_coords(const T* domain, T* cell_coords) const {
     get_previous_cell_coords_row(domain, cell_coords);
   else if (cell_order_ == Layout::COL_MAJOR)
     get_previous_cell_coords_col(domain, cell_coords);
+  else if (cell_order_ == Layout::MORTON)
+    get_previous_cell_coords_morton(domain, cell_coords);
   else  // Sanity check
     assert(0);
 }
@@ -959,8 +1031,9 @@ unsigned int Domain::subarray_overlap(
     }
   }
 
-  // Check contig overlap
-  if (overlap == 2 && dim_num_ > 1) {
+  // Check contig overlap (partial overlaps are never contiguous on the
+  // morton cell order)
+  if (overlap == 2 && dim_num_ > 1 && cell_order_ != Layout::MORTON) {
     overlap = 3;
     if (cell_order_ == Layout::ROW_MAJOR) {  // Row major
       for (unsigned int i = 1; i < dim_num_; ++i) {
@@ -1492,6 +1565,27 @@ uint64_t Domain::get_cell_pos_col(const T* coords) const {
   return pos;
 }
 
+template <class T, unsigned int DIM>
+uint64_t Domain::get_cell_pos_col(const T* coords) const {
+  // For easy reference
+  auto domain = static_cast<const T*>(domain_);
+  auto tile_extents = static_cast<const T*>(tile_extents_);
+
+  // Calculate position; the loop bound is a compile-time constant, so
+  // the loop fully unrolls and no cell offsets need to be materialized
+  T coords_norm;  // Normalized coordinates inside the tile
+  uint64_t pos = 0, cell_offset = 1;
+  for (unsigned int i = 0; i < DIM; ++i) {
+    coords_norm = (coords[i] - domain[2 * i]);
+    coords_norm -= (coords_norm / tile_extents[i]) * tile_extents[i];
+    pos += coords_norm * cell_offset;
+    cell_offset *= (uint64_t)tile_extents[i];
+  }
+
+  // Return
+  return pos;
+}
+
 template <class T>
 uint64_t Domain::get_cell_pos_row(const T* coords) const {
   // For easy reference
@@ -1525,9 +1619,114 @@ uint64_t Domain::get_cell_pos_row(const T* coords) const {
   return pos;
 }
 
+template <class T, unsigned int DIM>
+uint64_t Domain::get_cell_pos_row(const T* coords) const {
+  // For easy reference
+  auto domain = static_cast<const T*>(domain_);
+  auto tile_extents = static_cast<const T*>(tile_extents_);
+
+  // Calculate position; the loop bound is a compile-time constant, so
+  // the loop fully unrolls and no cell offsets need to be materialized
+  T coords_norm;  // Normalized coordinates inside the tile
+  uint64_t pos = 0, cell_offset = 1;
+  for (unsigned int i = DIM; i-- > 0;) {
+    coords_norm = (coords[i] - domain[2 * i]);
+    coords_norm -= (coords_norm / tile_extents[i]) * tile_extents[i];
+    pos += coords_norm * cell_offset;
+    cell_offset *= (uint64_t)tile_extents[i];
+  }
+
+  // Return
+  return pos;
+}
+
+unsigned int Domain::morton_bits(uint64_t max) {
+  unsigned int bits = 0;
+  while (max > 0) {
+    ++bits;
+    max >>= 1;
+  }
+  return bits;
+}
+
+uint64_t Domain::morton_interleave(
+    const uint64_t* coords, const unsigned int* bits, unsigned int dim_num) {
+  unsigned int max_bits = 0;
+  for (unsigned int i = 0; i < dim_num; ++i)
+    max_bits = MAX(max_bits, bits[i]);
+
+  uint64_t code = 0;
+  for (unsigned int b = max_bits; b-- > 0;) {
+    for (unsigned int i = 0; i < dim_num; ++i) {
+      if (b < bits[i])
+        code = (code << 1) | ((coords[i] >> b) & 1);
+    }
+  }
+
+  return code;
+}
+
+void Domain::morton_deinterleave(
+    uint64_t code,
+    const unsigned int* bits,
+    unsigned int dim_num,
+    uint64_t* coords) {
+  unsigned int max_bits = 0, shift = 0;
+  for (unsigned int i = 0; i < dim_num; ++i) {
+    max_bits = MAX(max_bits, bits[i]);
+    shift += bits[i];
+    coords[i] = 0;
+  }
+
+  for (unsigned int b = max_bits; b-- > 0;) {
+    for (unsigned int i = 0; i < dim_num; ++i) {
+      if (b < bits[i]) {
+        --shift;
+        coords[i] |= ((code >> shift) & 1) << b;
+      }
+    }
+  }
+}
+
+template <class T>
+uint64_t Domain::get_cell_pos_morton(const T* coords) const {
+  // For easy reference
+  auto domain = static_cast<const T*>(domain_);
+  auto tile_extents = static_cast<const T*>(tile_extents_);
+
+  // Normalize the coordinates inside the tile
+  std::vector<uint64_t> coords_norm(dim_num_);
+  std::vector<unsigned int> bits(dim_num_);
+  T coord;
+  for (unsigned int i = 0; i < dim_num_; ++i) {
+    coord = coords[i] - domain[2 * i];
+    coord -= (coord / tile_extents[i]) * tile_extents[i];
+    coords_norm[i] = (uint64_t)coord;
+    bits[i] = morton_bits((uint64_t)tile_extents[i] - 1);
+  }
+
+  // Calculate position
+  return morton_interleave(&coords_norm[0], &bits[0], dim_num_);
+}
+
 template <class T>
 void Domain::get_next_cell_coords_col(
     const T* domain, T* cell_coords, bool* coords_retrieved) const {
+  // Dispatch to a kernel specialized for the number of dimensions
+  switch (dim_num_) {
+    case 1:
+      return get_next_cell_coords_col<T, 1>(
+          domain, cell_coords, coords_retrieved);
+    case 2:
+      return get_next_cell_coords_col<T, 2>(
+          domain, cell_coords, coords_retrieved);
+    case 3:
+      return get_next_cell_coords_col<T, 3>(
+          domain, cell_coords, coords_retrieved);
+    default:
+      break;
+  }
+
   unsigned int i = 0;
   ++cell_coords[i];
 
@@ -1540,9 +1739,38 @@ void Domain::get_next_cell_coords_col(
       !(i == dim_num_ - 1 && cell_coords[i] > domain[2 * i + 1]);
 }
 
+template <class T, unsigned int DIM>
+void Domain::get_next_cell_coords_col(
+    const T* domain, T* cell_coords, bool* coords_retrieved) const {
+  unsigned int i = 0;
+  ++cell_coords[i];
+
+  while (i < DIM - 1 && cell_coords[i] > domain[2 * i + 1]) {
+    cell_coords[i] = domain[2 * i];
+    ++cell_coords[++i];
+  }
+
+  *coords_retrieved = !(i == DIM - 1 && cell_coords[i] > domain[2 * i + 1]);
+}
+
 template <class T>
 void Domain::get_next_cell_coords_row(
     const T* domain, T* cell_coords, bool* coords_retrieved) const {
+  // Dispatch to a kernel specialized for the number of dimensions
+  switch (dim_num_) {
+    case 1:
+      return get_next_cell_coords_row<T, 1>(
+          domain, cell_coords, coords_retrieved);
+    case 2:
+      return get_next_cell_coords_row<T, 2>(
+          domain, cell_coords, coords_retrieved);
+    case 3:
+      return get_next_cell_coords_row<T, 3>(
+          domain, cell_coords, coords_retrieved);
+    default:
+      break;
+  }
+
   unsigned int i = dim_num_ - 1;
   ++cell_coords[i];
 
@@ -1554,6 +1782,60 @@ void Domain::get_next_cell_coords_row(
   *coords_retrieved = !(i == 0 && cell_coords[i] > domain[2 * i + 1]);
 }
 
+template <class T, unsigned int DIM>
+void Domain::get_next_cell_coords_row(
+    const T* domain, T* cell_coords, bool* coords_retrieved) const {
+  unsigned int i = DIM - 1;
+  ++cell_coords[i];
+
+  while (i > 0 && cell_coords[i] > domain[2 * i + 1]) {
+    cell_coords[i] = domain[2 * i];
+    ++cell_coords[--i];
+  }
+
+  *coords_retrieved = !(i == 0 && cell_coords[i] > domain[2 * i + 1]);
+}
+
+template <class T>
+void Domain::get_next_cell_coords_morton(
+    const T* domain, T* cell_coords, bool* coords_retrieved) const {
+  // Normalize the coordinates inside the input domain
+  std::vector<uint64_t> coords_norm(dim_num_), extents(dim_num_);
+  std::vector<unsigned int> bits(dim_num_);
+  unsigned int sum_bits = 0;
+  for (unsigned int i = 0; i < dim_num_; ++i) {
+    extents[i] = (uint64_t)(domain[2 * i + 1] - domain[2 * i]) + 1;
+    coords_norm[i] = (uint64_t)(cell_coords[i] - domain[2 * i]);
+    bits[i] = morton_bits(extents[i] - 1);
+    sum_bits += bits[i];
+  }
+  uint64_t code_num =
+      (sum_bits >= 64) ? UINT64_MAX : (UINT64_C(1) << sum_bits);
+
+  // Advance to the next morton code, skipping codes that decode to
+  // coordinates outside the domain (no codes are skipped when the domain
+  // extents are powers of two)
+  uint64_t code = morton_interleave(&coords_norm[0], &bits[0], dim_num_);
+  for (++code; code < code_num; ++code) {
+    morton_deinterleave(code, &bits[0], dim_num_, &coords_norm[0]);
+    bool in = true;
+    for (unsigned int i = 0; i < dim_num_; ++i) {
+      if (coords_norm[i] >= extents[i]) {
+        in = false;
+        break;
+      }
+    }
+    if (in) {
+      for (unsigned int i = 0; i < dim_num_; ++i)
+        cell_coords[i] = domain[2 * i] + (T)coords_norm[i];
+      *coords_retrieved = true;
+      return;
+    }
+  }
+
+  *coords_retrieved = false;
+}
+
 template <class T>
 void Domain::get_previous_cell_coords_col(
     const T* domain, T* cell_coords) const {
@@ -1578,6 +1860,44 @@ void Domain::get_previous_cell_coords_row(
   }
 }
 
+template <class T>
+void Domain::get_previous_cell_coords_morton(
+    const T* domain, T* cell_coords) const {
+  // Normalize the coordinates inside the input domain
+  std::vector<uint64_t> coords_norm(dim_num_), extents(dim_num_);
+  std::vector<unsigned int> bits(dim_num_);
+  for (unsigned int i = 0; i < dim_num_; ++i) {
+    extents[i] = (uint64_t)(domain[2 * i + 1] - domain[2 * i]) + 1;
+    coords_norm[i] = (uint64_t)(cell_coords[i] - domain[2 * i]);
+    bits[i] = morton_bits(extents[i] - 1);
+  }
+
+  // Move to the previous morton code, skipping codes that decode to
+  // coordinates outside the domain (no codes are skipped when the domain
+  // extents are powers of two)
+  uint64_t code = morton_interleave(&coords_norm[0], &bits[0], dim_num_);
+  while (code > 0) {
+    --code;
+    morton_deinterleave(code, &bits[0], dim_num_, &coords_norm[0]);
+    bool in = true;
+    for (unsigned int i = 0; i < dim_num_; ++i) {
+      if (coords_norm[i] >= extents[i]) {
+        in = false;
+        break;
+      }
+    }
+    if (in) {
+      for (unsigned int i = 0; i < dim_num_; ++i)
+        cell_coords[i] = domain[2 * i] + (T)coords_norm[i];
+      return;
+    }
+  }
+
+  // The input coordinates were the first on the morton order; mimic the
+  // row-/column-major versions by moving before the start of the domain
+  cell_coords[0] = domain[0] - 1;
+}
+
 template <class T>
 void Domain::get_next_tile_coords_col(const T* domain, T* tile_coords) const {
   unsigned int i = 0;
@@ -1876,6 +2196,29 @@ template void Domain::get_next_cell_coords_col<uint64_t>(
     uint64_t* cell_coords,
     bool* coords_retrieved) const;
 
+template void Domain::get_next_cell_coords_morton<int>(
+    const int* domain, int* cell_coords, bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<int64_t>(
+    const int64_t* domain, int64_t* cell_coords, bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<int8_t>(
+    const int8_t* domain, int8_t* cell_coords, bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<uint8_t>(
+    const uint8_t* domain, uint8_t* cell_coords, bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<int16_t>(
+    const int16_t* domain, int16_t* cell_coords, bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<uint16_t>(
+    const uint16_t* domain,
+    uint16_t* cell_coords,
+    bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<uint32_t>(
+    const uint32_t* domain,
+    uint32_t* cell_coords,
+    bool* coords_retrieved) const;
+template void Domain::get_next_cell_coords_morton<uint64_t>(
+    const uint64_t* domain,
+    uint64_t* cell_coords,
+    bool* coords_retrieved) const;
+
 template void Domain::get_next_tile_coords<int>(
     const int* domain, int* tile_coords) const;
 template void Domain::get_next_tile_coords<int64_t>(
@@ -285,6 +285,20 @@ class Domain {
   template <class T>
   void get_tile_coords(const T* coords, T* tile_coords) const;
 
+  /**
+   * Retrieves the tile coordinates of the input cell coordinates,
+   * specialized for `DIM` dimensions so that the loop fully unrolls
+   * at compile time.
+   *
+   * @tparam T The domain type.
+   * @tparam DIM The number of dimensions.
+   * @param coords The cell coordinates.
+   * @param tile_coords The tile coordinates of the cell coordinates to
+   *     be retrieved.
+   */
+  template <class T, unsigned int DIM>
+  void get_tile_coords(const T* coords, T* tile_coords) const;
+
   /**
    * Retrieves the end of a cell slab starting at the `start` input
    * coordinates. The cell slab is determined based on the domain
@@ -337,6 +351,24 @@ class Domain {
   void get_next_cell_coords_col(
       const T* domain, T* cell_coords, bool* coords_retrieved) const;
 
+  /**
+   * Retrieves the next coordinates along the **column-major** cell order,
+   * specialized for `DIM` dimensions so that the loop fully unrolls
+   * at compile time.
+   *
+   * @tparam T The coordinates type.
+   * @tparam DIM The number of dimensions.
+   * @param domain The targeted domain.
+   * @param cell_coords The input cell coordinates, which the function modifies
+   *     to store the next coordinates at termination.
+   * @param coords_retrieved Will store true if the retrieved coordinates are
+   *     inside the domain, and false otherwise.
+   * @return void
+   */
+  template <class T, unsigned int DIM>
+  void get_next_cell_coords_col(
+      const T* domain, T* cell_coords, bool* coords_retrieved) const;
+
   /**
    * Retrieves the next coordinates along the array cell order within a given
    * domain (desregarding whether the domain is split into tiles or not).
@@ -355,6 +387,44 @@ class Domain {
   void get_next_cell_coords_row(
       const T* domain, T* cell_coords, bool* coords_retrieved) const;
 
+  /**
+   * Retrieves the next coordinates along the **row-major** cell order,
+   * specialized for `DIM` dimensions so that the loop fully unrolls
+   * at compile time.
+   *
+   * @tparam T The coordinates type.
+   * @tparam DIM The number of dimensions.
+   * @param domain The targeted domain.
+   * @param cell_coords The input cell coordinates, which the function modifies
+   *     to store the next coordinates at termination.
+   * @param coords_retrieved Will store true if the retrieved coordinates are
+   *     inside the domain, and false otherwise.
+   * @return void
+   */
+  template <class T, unsigned int DIM>
+  void get_next_cell_coords_row(
+      const T* domain, T* cell_coords, bool* coords_retrieved) const;
+
+  /**
+   * Retrieves the next coordinates along the array cell order within a given
+   * domain (desregarding whether the domain is split into tiles or not).
+   * Applicable only to **dense** arrays, and focusing on the **morton**
+   * (Z-order) cell order, relative to the input domain. Note that, if the
+   * domain extents are not powers of two, the function may have to skip
+   * morton codes that decode to coordinates outside the domain.
+   *
+   * @tparam T The coordinates type.
+   * @param domain The targeted domain.
+   * @param cell_coords The input cell coordinates, which the function modifies
+   *     to store the next coordinates at termination.
+   * @param coords_retrieved Will store true if the retrieved coordinates are
+   *     inside the domain, and false otherwise.
+   * @return void
+   */
+  template <class T>
+  void get_next_cell_coords_morton(
+      const T* domain, T* cell_coords, bool* coords_retrieved) const;
+
   /**
    * Retrieves the next tile coordinates along the array tile order within a
    * given tile domain. Applicable only to **dense** arrays.
@@ -786,6 +856,21 @@ class Domain {
   template <class T>
   uint64_t get_cell_pos_col(const T* coords) const;
 
+  /**
+   * Returns the position of the input coordinates inside its corresponding
+   * tile on the **column-major** cell order, specialized for `DIM`
+   * dimensions so that the loop fully unrolls at compile time.
+   *
+   * @tparam T The coordinates type.
+   * @tparam DIM The number of dimensions.
+   * @param coords The input coordindates, which are expressed as global
+   *     coordinates in the array domain.
+   * @return The position of the cell coordinates in the array cell order
+   *     within its corresponding tile.
+   */
+  template <class T, unsigned int DIM>
+  uint64_t get_cell_pos_col(const T* coords) const;
+
   /**
    * Returns the position of the input coordinates inside its corresponding
    * tile, based on the array cell order. Applicable only to **dense** arrays,
@@ -800,6 +885,72 @@ class Domain {
   template <class T>
   uint64_t get_cell_pos_row(const T* coords) const;
 
+  /**
+   * Returns the position of the input coordinates inside its corresponding
+   * tile on the **row-major** cell order, specialized for `DIM` dimensions
+   * so that the loop fully unrolls at compile time.
+   *
+   * @tparam T The coordinates type.
+   * @tparam DIM The number of dimensions.
+   * @param coords The input coordindates, which are expressed as global
+   *     coordinates in the array domain.
+   * @return The position of the cell coordinates in the array cell order
+   *     within its corresponding tile.
+   */
+  template <class T, unsigned int DIM>
+  uint64_t get_cell_pos_row(const T* coords) const;
+
+  /**
+   * Returns the position of the input coordinates inside its corresponding
+   * tile, based on the array cell order. Applicable only to **dense** arrays,
+   * and focusing on the **morton** (Z-order) cell order.
+   *
+   * @tparam T The coordinates type.
+   * @param coords The input coordindates, which are expressed as global
+   *     coordinates in the array domain.
+   * @return The position of the cell coordinates in the array cell order
+   *     within its corresponding tile.
+   */
+  template <class T>
+  uint64_t get_cell_pos_morton(const T* coords) const;
+
+  /**
+   * Returns the number of bits needed to represent the values in `[0, max]`.
+   */
+  static unsigned int morton_bits(uint64_t max);
+
+  /**
+   * Interleaves the bits of the input coordinates into a morton (Z-order)
+   * code. The bits are interleaved round-robin across the dimensions, from
+   * the most to the least significant bit, with earlier dimensions being
+   * more significant within the same bit level. A dimension contributes only
+   * its `bits[i]` least significant bits, which makes the code a bijection
+   * from the coordinate space onto `[0, 2^(bits[0]+...+bits[dim_num-1]))`.
+   *
+   * @param coords The input coordinates.
+   * @param bits The number of bits each dimension contributes.
+   * @param dim_num The number of dimensions.
+   * @return The morton code of the input coordinates.
+   */
+  static uint64_t morton_interleave(
+      const uint64_t* coords, const unsigned int* bits, unsigned int dim_num);
+
+  /**
+   * The inverse of `morton_interleave`; retrieves the coordinates encoded
+   * in the input morton code.
+   *
+   * @param code The input morton code.
+   * @param bits The number of bits each dimension contributes.
+   * @param dim_num The number of dimensions.
+   * @param coords The decoded coordinates to be retrieved.
+   * @return void
+   */
+  static void morton_deinterleave(
+      uint64_t code,
+      const unsigned int* bits,
+      unsigned int dim_num,
+      uint64_t* coords);
+
   /**
    * Retrieves the next tile coordinates along the array tile order within a
    * given tile domain. Applicable only to **dense** arrays, and focusing on
@@ -890,6 +1041,21 @@ class Domain {
   template <class T>
   void get_previous_cell_coords_row(const T* domain, T* cell_coords) const;
 
+  /**
+   * Retrieves the previous coordinates along the array cell order within a
+   * given domain (desregarding whether the domain is split into tiles or not).
+   * Applicable only to **dense** arrays, and focusing on the **morton**
+   * (Z-order) cell order, relative to the input domain.
+   *
+   * @tparam T The coordinates type.
+   * @param domain The targeted domain.
+   * @param cell_coords The input cell coordinates, which the function modifies
+   *     to store the previous coordinates at termination.
+   * @return void
+   */
+  template <class T>
+  void get_previous_cell_coords_morton(const T* domain, T* cell_coords) const;
+
   /**
    * Returns the tile position along the array tile order within the input
    * domain. Applicable only to **dense** arrays, and focusing on the
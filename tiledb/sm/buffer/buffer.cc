@@ -34,8 +34,14 @@
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace tiledb {
 namespace sm {
 
@@ -45,6 +51,15 @@ namespace sm {
 
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
+/* ****************************** */
+/*         STATIC CONSTANTS       */
+/* ****************************** */
+
+/** The (transparent) hugepage size on x86-64 Linux. */
+static const uint64_t hugepage_size = 2 * 1024 * 1024;
+
+uint64_t Buffer::hugepage_threshold_ = 0;
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -66,6 +81,49 @@ Buffer::Buffer(void* data, uint64_t size, bool owns_data)
   owns_data_ = false;
 }
 
+Buffer::Buffer(Buffer&& buff) {
+  if (buff.data_is_inline()) {
+    std::memcpy(inline_data_, buff.inline_data_, buff.alloced_size_);
+    data_ = inline_data_;
+  } else {
+    data_ = buff.data_;
+  }
+  alloced_size_ = buff.alloced_size_;
+  offset_ = buff.offset_;
+  owns_data_ = buff.owns_data_;
+  size_ = buff.size_;
+
+  buff.data_ = nullptr;
+  buff.alloced_size_ = 0;
+  buff.offset_ = 0;
+  buff.owns_data_ = true;
+  buff.size_ = 0;
+}
+
+Buffer& Buffer::operator=(Buffer&& buff) {
+  if (this != &buff) {
+    clear();
+    if (buff.data_is_inline()) {
+      std::memcpy(inline_data_, buff.inline_data_, buff.alloced_size_);
+      data_ = inline_data_;
+    } else {
+      data_ = buff.data_;
+    }
+    alloced_size_ = buff.alloced_size_;
+    offset_ = buff.offset_;
+    owns_data_ = buff.owns_data_;
+    size_ = buff.size_;
+
+    buff.data_ = nullptr;
+    buff.alloced_size_ = 0;
+    buff.offset_ = 0;
+    buff.owns_data_ = true;
+    buff.size_ = 0;
+  }
+
+  return *this;
+}
+
 Buffer::~Buffer() {
   clear();
 }
@@ -87,7 +145,7 @@ uint64_t Buffer::alloced_size() const {
 }
 
 void Buffer::clear() {
-  if (data_ != nullptr && owns_data_)
+  if (data_ != nullptr && owns_data_ && !data_is_inline())
     std::free(data_);
 
   data_ = nullptr;
@@ -108,8 +166,22 @@ void* Buffer::data(uint64_t offset) const {
   return (char*)data_ + offset;
 }
 
-void Buffer::disown_data() {
+Status Buffer::disown_data() {
+  // Inline data cannot outlive the buffer object; migrate it to the
+  // heap so that the new owner can free it with `std::free`. On
+  // failure the buffer keeps owning its (inline) data.
+  if (data_is_inline()) {
+    auto heap_data = std::malloc(alloced_size_);
+    if (heap_data == nullptr) {
+      return LOG_STATUS(Status::BufferError(
+          "Cannot disown buffer data; Memory allocation failed"));
+    }
+    std::memcpy(heap_data, inline_data_, alloced_size_);
+    data_ = heap_data;
+  }
+
   owns_data_ = false;
+  return Status::Ok();
 }
 
 uint64_t Buffer::free_space() const {
@@ -121,6 +193,10 @@ uint64_t Buffer::offset() const {
   return offset_;
 }
 
+bool Buffer::owns_data() const {
+  return owns_data_;
+}
+
 Status Buffer::read(void* buffer, uint64_t nbytes) {
   if (nbytes + offset_ > size_) {
     return LOG_STATUS(
@@ -138,18 +214,46 @@ Status Buffer::realloc(uint64_t nbytes) {
   }
 
   if (data_ == nullptr) {
-    data_ = std::malloc(nbytes);
-    if (data_ == nullptr) {
-      return LOG_STATUS(Status::BufferError(
-          "Cannot allocate buffer; Memory allocation failed"));
+    if (nbytes <= INLINE_CAPACITY) {
+      data_ = inline_data_;
+    } else {
+      data_ = alloc_data(nbytes);
+      if (data_ == nullptr) {
+        return LOG_STATUS(Status::BufferError(
+            "Cannot allocate buffer; Memory allocation failed"));
+      }
     }
   } else if (nbytes > alloced_size_) {
-    auto new_data = std::realloc(data_, nbytes);
-    if (new_data == nullptr) {
-      return LOG_STATUS(Status::BufferError(
-          "Cannot reallocate buffer; Memory allocation failed"));
+    if (data_is_inline()) {
+      if (nbytes > INLINE_CAPACITY) {
+        // The data no longer fits inline; migrate it to the heap
+        auto new_data = alloc_data(nbytes);
+        if (new_data == nullptr) {
+          return LOG_STATUS(Status::BufferError(
+              "Cannot reallocate buffer; Memory allocation failed"));
+        }
+        std::memcpy(new_data, inline_data_, alloced_size_);
+        data_ = new_data;
+      }
+    } else if (use_hugepages(nbytes)) {
+      // Migrate to a hugepage-advised region; the system realloc would
+      // not preserve the hugepage alignment
+      auto new_data = alloc_data(nbytes);
+      if (new_data == nullptr) {
+        return LOG_STATUS(Status::BufferError(
+            "Cannot reallocate buffer; Memory allocation failed"));
+      }
+      std::memcpy(new_data, data_, alloced_size_);
+      std::free(data_);
+      data_ = new_data;
+    } else {
+      auto new_data = std::realloc(data_, nbytes);
+      if (new_data == nullptr) {
+        return LOG_STATUS(Status::BufferError(
+            "Cannot reallocate buffer; Memory allocation failed"));
+      }
+      data_ = new_data;
     }
-    data_ = new_data;
   }
 
   alloced_size_ = nbytes;
@@ -157,6 +261,47 @@ Status Buffer::realloc(uint64_t nbytes) {
   return Status::Ok();
 }
 
+void Buffer::set_hugepage_threshold(uint64_t threshold) {
+  hugepage_threshold_ = threshold;
+}
+
+uint64_t Buffer::hugepage_threshold() {
+  return hugepage_threshold_;
+}
+
+void* Buffer::alloc_data(uint64_t nbytes) {
+#ifdef __linux__
+  if (use_hugepages(nbytes)) {
+    // Align the allocation to the hugepage size so that the kernel can
+    // back it with transparent hugepages
+    void* data = nullptr;
+    if (posix_memalign(&data, hugepage_size, nbytes) == 0) {
+#ifdef MADV_HUGEPAGE
+      // Advisory; the allocation is usable even if the advice fails
+      madvise(data, nbytes, MADV_HUGEPAGE);
+#endif
+      return data;
+    }
+    // Fall through to a regular allocation
+  }
+#endif
+
+  return std::malloc(nbytes);
+}
+
+bool Buffer::data_is_inline() const {
+  return data_ == inline_data_;
+}
+
+bool Buffer::use_hugepages(uint64_t nbytes) {
+#ifdef __linux__
+  return hugepage_threshold_ != 0 && nbytes >= hugepage_threshold_;
+#else
+  (void)nbytes;
+  return false;
+#endif
+}
+
 void Buffer::reset_offset() {
   offset_ = 0;
 }
@@ -63,9 +63,52 @@ class Buffer {
    */
   Buffer(void* data, uint64_t size, bool owns_data);
 
+  /**
+   * Move constructor. Heap-allocated data is stolen from `buff`; inline
+   * data is copied (at most `INLINE_CAPACITY` bytes). `buff` is left
+   * empty.
+   */
+  Buffer(Buffer&& buff);
+
+  /** Move assignment. See the move constructor. */
+  Buffer& operator=(Buffer&& buff);
+
+  Buffer(const Buffer&) = delete;
+  Buffer& operator=(const Buffer&) = delete;
+
   /** Destructor. */
   ~Buffer();
 
+  /* ********************************* */
+  /*             CONSTANTS             */
+  /* ********************************* */
+
+  /**
+   * The number of bytes stored inline in the buffer object itself.
+   * Allocations up to this size do not hit the heap, which matters for
+   * the short-lived tiny buffers created during header serialization
+   * and KV item handling.
+   */
+  static const uint64_t INLINE_CAPACITY = 64;
+
+  /* ********************************* */
+  /*           STATIC METHODS          */
+  /* ********************************* */
+
+  /**
+   * Sets the hugepage threshold (in bytes). Allocations of at least this
+   * many bytes are hugepage-aligned and advised to be backed by
+   * transparent hugepages, which reduces dTLB pressure when large tiles
+   * are decompressed and copied. A value of 0 (the default) disables the
+   * policy. The threshold is process-global; it is set by
+   * `StorageManager::init` from the `sm.hugepage_threshold` config
+   * parameter. Only effective on Linux; a no-op on other platforms.
+   */
+  static void set_hugepage_threshold(uint64_t threshold);
+
+  /** Returns the hugepage threshold (in bytes, 0 means disabled). */
+  static uint64_t hugepage_threshold();
+
   /* ********************************* */
   /*                API                */
   /* ********************************* */
@@ -93,9 +136,14 @@ class Buffer {
 
   /**
    * Sets `owns_data_` to `false` and thus will not destroy the data
-   * in the destructor.
+   * in the destructor. Inline data is first migrated to the heap (so
+   * that the new owner can free it with `std::free`), which may change
+   * the `data()` pointer; callers must read `data()` after disowning.
+   * On error the buffer keeps owning its data.
+   *
+   * @return Status
    */
-  void disown_data();
+  Status disown_data();
 
   /** Returns the number of byte of free space in the buffer. */
   uint64_t free_space() const;
@@ -103,6 +151,9 @@ class Buffer {
   /** Returns the current offset in the buffer. */
   uint64_t offset() const;
 
+  /** Returns `true` if the buffer owns its data. */
+  bool owns_data() const;
+
   /**
    * Reads from the local data into the input buffer.
    *
@@ -226,6 +277,38 @@ class Buffer {
 
   /** Size of the buffer useful data. */
   uint64_t size_;
+
+  /**
+   * Inline storage for small buffers. `data_` points to it (instead of
+   * a heap allocation) when the allocated size fits.
+   */
+  char inline_data_[INLINE_CAPACITY];
+
+  /**
+   * The size (in bytes) above which allocations are hugepage-aligned
+   * and advised to be backed by transparent hugepages (0 = disabled).
+   */
+  static uint64_t hugepage_threshold_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Allocates `nbytes` bytes, from a hugepage-advised region if the
+   * hugepage policy applies to this size. The returned memory must be
+   * freed with `std::free`.
+   *
+   * @param nbytes The number of bytes to allocate.
+   * @return The allocated memory, or `nullptr` upon failure.
+   */
+  static void* alloc_data(uint64_t nbytes);
+
+  /** Returns true if the hugepage policy applies to this size. */
+  static bool use_hugepages(uint64_t nbytes);
+
+  /** Returns true if the buffer data resides in the inline storage. */
+  bool data_is_inline() const;
 };
 
 }  // namespace sm
@@ -0,0 +1,124 @@
+/**
+ * @file   buffer_pool.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class BufferPool.
+ */
+
+#include "tiledb/sm/buffer/buffer_pool.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+BufferPool::BufferPool(uint64_t capacity) {
+  capacity_ = capacity;
+  size_ = 0;
+  free_.resize(CLASS_NUM);
+}
+
+BufferPool::~BufferPool() {
+  for (auto& free_list : free_)
+    for (auto buffer : free_list)
+      delete buffer;
+}
+
+/* ********************************* */
+/*               API                 */
+/* ********************************* */
+
+Buffer* BufferPool::checkout(uint64_t nbytes) {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // Prefer the smallest pooled buffer that fits the hint, falling
+    // back to larger classes before allocating fresh.
+    auto c = (nbytes == 0) ? 0 : size_class(nbytes);
+    for (; c < CLASS_NUM; ++c) {
+      auto& free_list = free_[c];
+      if (!free_list.empty()) {
+        auto buffer = free_list.back();
+        free_list.pop_back();
+        size_ -= buffer->alloced_size();
+        return buffer;
+      }
+    }
+  }
+
+  return new Buffer();
+}
+
+std::shared_ptr<Buffer> BufferPool::checkout_shared(uint64_t nbytes) {
+  return std::shared_ptr<Buffer>(
+      checkout(nbytes), [this](Buffer* buffer) { release(buffer); });
+}
+
+void BufferPool::release(Buffer* buffer) {
+  if (buffer == nullptr)
+    return;
+
+  auto nbytes = buffer->alloced_size();
+  if (nbytes == 0 || !buffer->owns_data()) {
+    delete buffer;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (size_ + nbytes <= capacity_) {
+      buffer->reset_size();
+      free_[size_class(nbytes)].push_back(buffer);
+      size_ += nbytes;
+      return;
+    }
+  }
+
+  delete buffer;
+}
+
+uint64_t BufferPool::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return size_;
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+unsigned BufferPool::size_class(uint64_t nbytes) {
+  unsigned c = 0;
+  while (c < CLASS_NUM - 1 && ((uint64_t)1 << c) < nbytes)
+    ++c;
+  return c;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,145 @@
+/**
+ * @file   buffer_pool.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class BufferPool.
+ */
+
+#ifndef TILEDB_BUFFER_POOL_H
+#define TILEDB_BUFFER_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tiledb/sm/buffer/buffer.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A pool of reusable tile-sized buffers, organized in power-of-two size
+ * classes on the buffers' allocated capacity. Checking a buffer out and
+ * releasing it back recycles its allocation (`Buffer::realloc` never
+ * shrinks), so steady-state tile reads and writes stop hitting the
+ * system allocator. The pool is thread-safe.
+ */
+class BufferPool {
+ public:
+  /** The default maximum number of bytes the pool will retain. */
+  static const uint64_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param capacity The maximum number of bytes the pool will retain.
+   *     Buffers released when the pool is full are simply freed.
+   */
+  explicit BufferPool(uint64_t capacity = DEFAULT_CAPACITY);
+
+  /** Destructor. Frees all the pooled buffers. */
+  ~BufferPool();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /* ********************************* */
+  /*               API                 */
+  /* ********************************* */
+
+  /**
+   * Checks an empty buffer out of the pool, allocating a new one if no
+   * pooled buffer fits. The caller assumes ownership and should return
+   * the buffer with `release` when done with it.
+   *
+   * @param nbytes A hint on the number of bytes the caller will write,
+   *     used to pick the size class. A pooled buffer from a larger class
+   *     may be returned; `0` means no preference.
+   * @return The checked out buffer.
+   */
+  Buffer* checkout(uint64_t nbytes = 0);
+
+  /**
+   * Checks a buffer out of the pool wrapped in a shared pointer whose
+   * deleter releases the buffer back to the pool. The pool must outlive
+   * the returned pointer.
+   *
+   * @param nbytes A hint on the number of bytes the caller will write.
+   * @return The checked out buffer.
+   */
+  std::shared_ptr<Buffer> checkout_shared(uint64_t nbytes = 0);
+
+  /**
+   * Returns a buffer to the pool, retaining its allocation for reuse.
+   * The buffer is freed instead if it does not own its data, or if
+   * retaining it would exceed the pool capacity.
+   */
+  void release(Buffer* buffer);
+
+  /** Returns the number of bytes the pool currently retains. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The number of size classes. */
+  static const unsigned CLASS_NUM = 64;
+
+  /** The maximum number of bytes the pool will retain. */
+  uint64_t capacity_;
+
+  /** The number of bytes the pool currently retains. */
+  uint64_t size_;
+
+  /** The pooled buffers, one free list per size class. */
+  std::vector<std::vector<Buffer*>> free_;
+
+  /** A mutex protecting the pool. */
+  mutable std::mutex mtx_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Returns the size class of an allocation, i.e., the position of the
+   * smallest power of two that fits `nbytes`.
+   */
+  static unsigned size_class(uint64_t nbytes);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BUFFER_POOL_H
@@ -39,11 +39,18 @@
 #include "tiledb/sm/kv/kv_iter.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/trace.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/storage_manager/config.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <sstream>
 
 /* ****************************** */
@@ -121,9 +128,28 @@ struct tiledb_domain_t {
   tiledb::sm::Domain* domain_;
 };
 
+struct tiledb_array_t {
+  tiledb::sm::URI array_uri_;
+  const tiledb::sm::ArraySchema* array_schema_;
+  std::vector<tiledb::sm::FragmentMetadata*> fragment_metadata_;
+  tiledb::sm::QueryType query_type_;
+};
+
 struct tiledb_query_t {
   tiledb::sm::Query* query_;
   bool finalized_;
+  /**
+   * `true` if the query opened the array itself and, hence, must close it
+   * upon finalization; `false` if the query was created against an opened
+   * array, which is closed by `tiledb_array_close` instead.
+   */
+  bool owns_array_;
+};
+
+struct tiledb_completion_queue_t {
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<void*> completions_;
 };
 
 struct tiledb_kv_schema_t {
@@ -198,169 +224,144 @@ static bool create_error(tiledb_error_t** error, const tiledb::sm::Status& st) {
   return true;
 }
 
-inline int sanity_check(tiledb_config_t* config, tiledb_error_t** error) {
-  if (config == nullptr || config->config_ == nullptr) {
-    auto st =
-        tiledb::sm::Status::Error("Cannot set config; Invalid config object");
-    LOG_STATUS(st);
-    create_error(error, st);
-    return TILEDB_ERR;
-  }
+/**
+ * Builds and saves the error of a failed sanity check. Error construction
+ * allocates, so it is deliberately kept out of line: the inlined sanity
+ * checks on the success path reduce to a pointer test and a cold call.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((cold, noinline))
+#endif
+static int
+sanity_error(tiledb_ctx_t* ctx, const char* msg) {
+  auto st = tiledb::sm::Status::Error(msg);
+  LOG_STATUS(st);
+  save_error(ctx, st);
+  return TILEDB_ERR;
+}
+
+/** As above, but reports through an error object instead of the context. */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((cold, noinline))
+#endif
+static int
+sanity_error(tiledb_error_t** error, const char* msg) {
+  auto st = tiledb::sm::Status::Error(msg);
+  LOG_STATUS(st);
+  create_error(error, st);
+  return TILEDB_ERR;
+}
 
+inline int sanity_check(tiledb_config_t* config, tiledb_error_t** error) {
+  if (TILEDB_UNLIKELY(config == nullptr || config->config_ == nullptr))
+    return sanity_error(error, "Cannot set config; Invalid config object");
   *error = nullptr;
   return TILEDB_OK;
 }
 
 inline int sanity_check(
     tiledb_config_iter_t* config_iter, tiledb_error_t** error) {
-  if (config_iter == nullptr) {
-    auto st = tiledb::sm::Status::Error(
-        "Cannot set config; Invalid config iterator object");
-    LOG_STATUS(st);
-    create_error(error, st);
-    return TILEDB_ERR;
-  }
-
+  if (TILEDB_UNLIKELY(config_iter == nullptr))
+    return sanity_error(
+        error, "Cannot set config; Invalid config iterator object");
   *error = nullptr;
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx) {
-  if (ctx == nullptr || ctx->mtx_ == nullptr)
+  if (TILEDB_UNLIKELY(ctx == nullptr || ctx->mtx_ == nullptr))
     return TILEDB_ERR;
-  if (ctx->storage_manager_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB context");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(ctx->storage_manager_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB context");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_error_t* err) {
-  if (err == nullptr || err->status_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB error object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(err == nullptr || err->status_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB error object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_attribute_t* attr) {
-  if (attr == nullptr || attr->attr_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB attribute object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(attr == nullptr || attr->attr_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB attribute object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_dimension_t* dim) {
-  if (dim == nullptr || dim->dim_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB dimension object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(dim == nullptr || dim->dim_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB dimension object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(
     tiledb_ctx_t* ctx, const tiledb_array_schema_t* array_schema) {
-  if (array_schema == nullptr || array_schema->array_schema_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB array schema object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(
+          array_schema == nullptr || array_schema->array_schema_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB array schema object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_domain_t* domain) {
-  if (domain == nullptr || domain->domain_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB domain object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(domain == nullptr || domain->domain_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB domain object");
+  return TILEDB_OK;
+}
+
+inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_array_t* array) {
+  if (TILEDB_UNLIKELY(array == nullptr || array->array_schema_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB opened array object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_query_t* query) {
-  if (query == nullptr || query->query_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB query object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(query == nullptr || query->query_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB query object");
+  return TILEDB_OK;
+}
+
+inline int sanity_check(
+    tiledb_ctx_t* ctx, const tiledb_completion_queue_t* cq) {
+  if (TILEDB_UNLIKELY(cq == nullptr))
+    return sanity_error(ctx, "Invalid TileDB completion queue");
   return TILEDB_OK;
 }
 
 inline int sanity_check(
     tiledb_ctx_t* ctx, const tiledb_kv_schema_t* kv_schema) {
-  if (kv_schema == nullptr || kv_schema->array_schema_ == nullptr) {
-    auto st =
-        tiledb::sm::Status::Error("Invalid TileDB key-value schema object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(
+          kv_schema == nullptr || kv_schema->array_schema_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB key-value schema object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_kv_t* kv) {
-  if (kv == nullptr || kv->kv_ == nullptr) {
-    auto st =
-        tiledb::sm::Status::Error("Invalid TileDB key-value store object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(kv == nullptr || kv->kv_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB key-value store object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_kv_iter_t* kv_iter) {
-  if (kv_iter == nullptr || kv_iter->kv_iter_ == nullptr) {
-    auto st =
-        tiledb::sm::Status::Error("Invalid TileDB key-value iterator object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(kv_iter == nullptr || kv_iter->kv_iter_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB key-value iterator object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_kv_item_t* kv_item) {
-  if (kv_item == nullptr || kv_item->kv_item_ == nullptr) {
-    auto st = tiledb::sm::Status::Error("Invalid TileDB key-value item object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(kv_item == nullptr || kv_item->kv_item_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB key-value item object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_vfs_t* vfs) {
-  if (vfs == nullptr || vfs->vfs_ == nullptr) {
-    auto st =
-        tiledb::sm::Status::Error("Invalid TileDB virtual filesystem object");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(vfs == nullptr || vfs->vfs_ == nullptr))
+    return sanity_error(ctx, "Invalid TileDB virtual filesystem object");
   return TILEDB_OK;
 }
 
 inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_vfs_fh_t* fh) {
-  if (fh == nullptr) {
-    auto st = tiledb::sm::Status::Error(
-        "Invalid TileDB virtual filesystem file handle");
-    LOG_STATUS(st);
-    save_error(ctx, st);
-    return TILEDB_ERR;
-  }
+  if (TILEDB_UNLIKELY(fh == nullptr))
+    return sanity_error(ctx, "Invalid TileDB virtual filesystem file handle");
   return TILEDB_OK;
 }
 
@@ -816,6 +817,30 @@ int tiledb_attribute_set_compressor(
   return TILEDB_OK;
 }
 
+int tiledb_attribute_set_shuffle(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int shuffle) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_shuffle(shuffle != 0);
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_dict_encode(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int dict_encode) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_dict_encode(dict_encode != 0);
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_offsets_32(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int offsets_32) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_offsets_32(offsets_32 != 0);
+  return TILEDB_OK;
+}
+
 int tiledb_attribute_set_cell_val_num(
     tiledb_ctx_t* ctx, tiledb_attribute_t* attr, unsigned int cell_val_num) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
@@ -855,6 +880,30 @@ int tiledb_attribute_get_compressor(
   return TILEDB_OK;
 }
 
+int tiledb_attribute_get_shuffle(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, int* shuffle) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *shuffle = (int)attr->attr_->shuffle();
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_dict_encode(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, int* dict_encode) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *dict_encode = (int)attr->attr_->dict_encode();
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_offsets_32(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, int* offsets_32) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *offsets_32 = (int)attr->attr_->offsets_32();
+  return TILEDB_OK;
+}
+
 int tiledb_attribute_get_cell_val_num(
     tiledb_ctx_t* ctx,
     const tiledb_attribute_t* attr,
@@ -1631,123 +1680,500 @@ int tiledb_query_create(
   }
 
   (*query)->finalized_ = false;
+  (*query)->owns_array_ = true;
 
   // Success
   return TILEDB_OK;
 }
 
-int tiledb_query_set_subarray(
-    tiledb_ctx_t* ctx, tiledb_query_t* query, const void* subarray) {
+int tiledb_query_create_with_array(
+    tiledb_ctx_t* ctx, tiledb_query_t** query, tiledb_array_t* array) {
   // Sanity check
-  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
     return TILEDB_ERR;
 
-  // Set subarray
-  if (save_error(ctx, query->query_->set_subarray(subarray)))
+  // Create query struct
+  *query = new (std::nothrow) tiledb_query_t;
+  if (*query == nullptr) {
+    auto st =
+        tiledb::sm::Status::Error("Failed to allocate TileDB query object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create a new Query object
+  (*query)->query_ = new (std::nothrow) tiledb::sm::Query();
+  if ((*query)->query_ == nullptr) {
+    delete *query;
+    tiledb::sm::Status st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB query object in object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create query object against the opened array; the array remains open
+  // (and, hence, the schema and fragment metadata valid) until
+  // `tiledb_array_close`
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->query_init(
+              ((*query)->query_),
+              array->array_schema_,
+              array->fragment_metadata_,
+              array->query_type_))) {
+    delete (*query)->query_;
+    delete *query;
     return TILEDB_ERR;
+  }
+
+  (*query)->finalized_ = false;
+  (*query)->owns_array_ = false;
 
+  // Success
   return TILEDB_OK;
 }
 
-int tiledb_query_set_buffers(
+int tiledb_query_plan(
     tiledb_ctx_t* ctx,
-    tiledb_query_t* query,
+    const char* array_uri,
+    const void* subarray,
+    tiledb_layout_t layout,
     const char** attributes,
-    unsigned int attribute_num,
-    void** buffers,
-    uint64_t* buffer_sizes) {
+    unsigned attribute_num,
+    uint64_t budget,
+    void** plan,
+    uint64_t* plan_size,
+    uint64_t* partition_num) {
   // Sanity check
-  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+  if (sanity_check(ctx) == TILEDB_ERR)
     return TILEDB_ERR;
 
-  // Set attributes and buffers
+  // Compute the plan
+  tiledb::sm::Buffer plan_buff;
   if (save_error(
           ctx,
-          query->query_->set_buffers(
-              attributes, attribute_num, buffers, buffer_sizes)))
-    return TILEDB_ERR;
+          ctx->storage_manager_->query_plan(
+              array_uri,
+              subarray,
+              static_cast<tiledb::sm::Layout>(layout),
+              attributes,
+              attribute_num,
+              budget,
+              &plan_buff,
+              partition_num)))
+    return TILEDB_ERR;
+
+  // Emit the serialized plan
+  *plan_size = plan_buff.size();
+  *plan = std::malloc(plan_buff.size());
+  if (*plan == nullptr) {
+    auto st =
+        tiledb::sm::Status::Error("Failed to allocate memory for query plan");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+  std::memcpy(*plan, plan_buff.data(), plan_buff.size());
 
+  // Success
   return TILEDB_OK;
 }
 
-int tiledb_query_set_layout(
-    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout) {
+int tiledb_query_create_from_plan(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t** query,
+    const void* plan,
+    uint64_t plan_size,
+    uint64_t partition_idx) {
   // Sanity check
-  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+  if (sanity_check(ctx) == TILEDB_ERR)
     return TILEDB_ERR;
 
-  // Set layout
+  // Create query struct
+  *query = new (std::nothrow) tiledb_query_t;
+  if (*query == nullptr) {
+    auto st =
+        tiledb::sm::Status::Error("Failed to allocate TileDB query object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create a new Query object
+  (*query)->query_ = new (std::nothrow) tiledb::sm::Query();
+  if ((*query)->query_ == nullptr) {
+    delete *query;
+    tiledb::sm::Status st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB query object in object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create query object from the plan
   if (save_error(
           ctx,
-          query->query_->set_layout(static_cast<tiledb::sm::Layout>(layout))))
+          ctx->storage_manager_->query_init_from_plan(
+              ((*query)->query_), plan, plan_size, partition_idx))) {
+    delete (*query)->query_;
+    delete *query;
     return TILEDB_ERR;
+  }
+
+  (*query)->finalized_ = false;
+  (*query)->owns_array_ = true;
 
+  // Success
   return TILEDB_OK;
 }
 
-int tiledb_query_finalize(tiledb_ctx_t* ctx, tiledb_query_t* query) {
-  // Trivial case
-  if (query == nullptr || query->finalized_)
-    return TILEDB_OK;
-
-  query->finalized_ = true;
-
+int tiledb_query_set_subarray(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, const void* subarray) {
   // Sanity check
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
     return TILEDB_ERR;
 
-  // Finalize query and check error
-  if (save_error(ctx, ctx->storage_manager_->query_finalize(query->query_)))
+  // Set subarray
+  if (save_error(ctx, query->query_->set_subarray(subarray)))
     return TILEDB_ERR;
 
   return TILEDB_OK;
 }
 
-int tiledb_query_free(tiledb_ctx_t* ctx, tiledb_query_t** query) {
-  if (sanity_check(ctx) == TILEDB_ERR)
+int tiledb_query_set_subarrays(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const void* subarrays,
+    uint64_t range_num) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
     return TILEDB_ERR;
 
-  if (query == nullptr || *query == nullptr)
-    return TILEDB_OK;
-
-  delete (*query)->query_;
-  delete *query;
-  *query = nullptr;
+  // Set subarrays
+  if (save_error(ctx, query->query_->set_subarrays(subarrays, range_num)))
+    return TILEDB_ERR;
 
   return TILEDB_OK;
 }
 
-int tiledb_query_submit(tiledb_ctx_t* ctx, tiledb_query_t* query) {
+int tiledb_query_set_buffers(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char** attributes,
+    unsigned int attribute_num,
+    void** buffers,
+    uint64_t* buffer_sizes) {
+  // Sanity check
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
     return TILEDB_ERR;
 
-  if (save_error(ctx, ctx->storage_manager_->query_submit(query->query_)))
+  // Set attributes and buffers
+  if (save_error(
+          ctx,
+          query->query_->set_buffers(
+              attributes, attribute_num, buffers, buffer_sizes)))
     return TILEDB_ERR;
 
   return TILEDB_OK;
 }
 
-int tiledb_query_submit_async(
+int tiledb_query_set_alloc_buffers(
     tiledb_ctx_t* ctx,
     tiledb_query_t* query,
-    void (*callback)(void*),
-    void* callback_data) {
+    const char** attributes,
+    unsigned int attribute_num) {
+  // Sanity check
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
     return TILEDB_ERR;
 
+  // Set attributes; the query allocates and owns the result buffers
   if (save_error(
-          ctx,
-          ctx->storage_manager_->query_submit_async(
-              query->query_, callback, callback_data)))
+          ctx, query->query_->set_alloc_buffers(attributes, attribute_num)))
     return TILEDB_ERR;
 
   return TILEDB_OK;
 }
 
-int tiledb_query_reset_buffers(
+int tiledb_query_get_buffer(
     tiledb_ctx_t* ctx,
     tiledb_query_t* query,
-    void** buffers,
+    const char* attribute,
+    void** buffer,
+    uint64_t* buffer_size,
+    void** buffer_var,
+    uint64_t* buffer_var_size) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Get the owned result buffers
+  std::shared_ptr<tiledb::sm::Buffer> b, b_var;
+  if (save_error(ctx, query->query_->result_buffer(attribute, &b, &b_var)))
+    return TILEDB_ERR;
+
+  *buffer = b->data();
+  *buffer_size = b->size();
+  if (buffer_var != nullptr)
+    *buffer_var = (b_var != nullptr) ? b_var->data() : nullptr;
+  if (buffer_var_size != nullptr)
+    *buffer_var_size = (b_var != nullptr) ? b_var->size() : 0;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    uint64_t* count,
+    void* min,
+    void* max,
+    void* sum) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Compute the aggregates
+  if (save_error(
+          ctx, query->query_->aggregate(attribute, count, min, max, sum)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_set_predicate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_predicate_op_t op,
+    const void* value) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set predicate
+  if (save_error(
+          ctx,
+          query->query_->set_predicate(
+              attribute, static_cast<tiledb::sm::PredicateOp>(op), value)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_set_predicate_range(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    const void* low,
+    const void* high) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set predicate
+  if (save_error(
+          ctx, query->query_->set_predicate_range(attribute, low, high)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_set_predicate_set(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    const void* values,
+    uint64_t value_num) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set predicate
+  if (save_error(
+          ctx,
+          query->query_->set_predicate_set(attribute, values, value_num)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_set_cache_hint(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_cache_hint_t hint) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set cache hint
+  if (save_error(
+          ctx,
+          query->query_->set_cache_hint(
+              static_cast<tiledb::sm::CacheHint>(hint))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_set_layout(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set layout
+  if (save_error(
+          ctx,
+          query->query_->set_layout(static_cast<tiledb::sm::Layout>(layout))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_finalize(tiledb_ctx_t* ctx, tiledb_query_t* query) {
+  // Trivial case
+  if (query == nullptr || query->finalized_)
+    return TILEDB_OK;
+
+  query->finalized_ = true;
+
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Finalize query and check error. If the query was created against an
+  // opened array, do not close the array here; `tiledb_array_close` does.
+  if (query->owns_array_) {
+    if (save_error(ctx, ctx->storage_manager_->query_finalize(query->query_)))
+      return TILEDB_ERR;
+  } else {
+    if (save_error(ctx, query->query_->finalize()))
+      return TILEDB_ERR;
+  }
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_free(tiledb_ctx_t* ctx, tiledb_query_t** query) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (query == nullptr || *query == nullptr)
+    return TILEDB_OK;
+
+  delete (*query)->query_;
+  delete *query;
+  *query = nullptr;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_submit(tiledb_ctx_t* ctx, tiledb_query_t* query) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(ctx, ctx->storage_manager_->query_submit(query->query_)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_submit_batch(
+    tiledb_ctx_t* ctx, tiledb_query_t** queries, uint64_t query_num) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Sanity check all the queries before submitting any of them
+  std::vector<tiledb::sm::Query*> batch(query_num);
+  for (uint64_t i = 0; i < query_num; ++i) {
+    if (sanity_check(ctx, queries[i]) == TILEDB_ERR)
+      return TILEDB_ERR;
+    batch[i] = queries[i]->query_;
+  }
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->query_submit_batch(
+              batch.data(), query_num)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_submit_async(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void (*callback)(void*),
+    void* callback_data) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->query_submit_async(
+              query->query_, callback, callback_data)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_submit_async_progress(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void (*callback)(void*),
+    void* callback_data,
+    void (*progress_callback)(void*),
+    void* progress_callback_data) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->query_submit_async(
+              query->query_,
+              callback,
+              callback_data,
+              progress_callback,
+              progress_callback_data)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_submit_queued(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    tiledb_completion_queue_t* cq,
+    void* tag) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR ||
+      sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Upon completion (successful or not), push the tag to the completion
+  // queue and wake up a drainer
+  auto callback = [cq, tag](void*) {
+    {
+      std::lock_guard<std::mutex> lock(cq->mtx_);
+      cq->completions_.push_back(tag);
+    }
+    cq->cv_.notify_one();
+  };
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->query_submit_async(
+              query->query_, callback, nullptr)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int tiledb_query_reset_buffers(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void** buffers,
     uint64_t* buffer_sizes) {
   // Sanity check
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
@@ -1760,6 +2186,19 @@ int tiledb_query_reset_buffers(
   return TILEDB_OK;
 }
 
+int tiledb_query_reset(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, const void* subarray) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Reset the query with the new subarray
+  if (save_error(ctx, query->query_->reset(subarray)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int tiledb_query_get_status(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_query_status_t* status) {
   // Sanity check
@@ -1800,10 +2239,194 @@ int tiledb_query_get_attribute_status(
   return TILEDB_OK;
 }
 
+int tiledb_query_get_stats(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_t* query,
+    tiledb_query_stats_t* stats) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto query_stats = query->query_->stats();
+  stats->bytes_read = query_stats->bytes_read_;
+  stats->tiles_fetched = query_stats->tiles_fetched_;
+  stats->cache_hits = query_stats->cache_hits_;
+  stats->cache_misses = query_stats->cache_misses_;
+  stats->compute_overlap_time_ns = query_stats->compute_overlap_ns_;
+  stats->io_time_ns = query_stats->io_ns_;
+  stats->decompress_time_ns = query_stats->decompress_ns_;
+  stats->sort_time_ns = query_stats->sort_ns_;
+  stats->copy_time_ns = query_stats->copy_ns_;
+
+  return TILEDB_OK;
+}
+
+/* ****************************** */
+/*        COMPLETION QUEUE        */
+/* ****************************** */
+
+int tiledb_completion_queue_create(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t** cq) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  *cq = new (std::nothrow) tiledb_completion_queue_t;
+  if (*cq == nullptr) {
+    auto st =
+        tiledb::sm::Status::Error("Failed to allocate TileDB completion queue");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  return TILEDB_OK;
+}
+
+int tiledb_completion_queue_free(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t** cq) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (cq == nullptr || *cq == nullptr)
+    return TILEDB_OK;
+
+  delete *cq;
+  *cq = nullptr;
+
+  return TILEDB_OK;
+}
+
+int tiledb_completion_queue_poll(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    void** tag,
+    int* has_completion) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  std::lock_guard<std::mutex> lock(cq->mtx_);
+  if (cq->completions_.empty()) {
+    *has_completion = 0;
+  } else {
+    *tag = cq->completions_.front();
+    cq->completions_.pop_front();
+    *has_completion = 1;
+  }
+
+  return TILEDB_OK;
+}
+
+int tiledb_completion_queue_wait(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    uint64_t timeout_ms,
+    void** tag,
+    int* has_completion) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  std::unique_lock<std::mutex> lock(cq->mtx_);
+  auto has_completions = [cq] { return !cq->completions_.empty(); };
+  if (timeout_ms == UINT64_MAX)
+    cq->cv_.wait(lock, has_completions);
+  else
+    cq->cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+        has_completions);
+
+  if (cq->completions_.empty()) {
+    *has_completion = 0;
+  } else {
+    *tag = cq->completions_.front();
+    cq->completions_.pop_front();
+    *has_completion = 1;
+  }
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*              ARRAY             */
 /* ****************************** */
 
+int tiledb_array_open(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t** array,
+    const char* array_uri,
+    tiledb_query_type_t query_type) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Create opened array struct
+  *array = new (std::nothrow) tiledb_array_t;
+  if (*array == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB opened array object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  (*array)->array_uri_ = tiledb::sm::URI(array_uri);
+  (*array)->array_schema_ = nullptr;
+  (*array)->query_type_ = static_cast<tiledb::sm::QueryType>(query_type);
+
+  // Open the array; it remains open (with its schema and fragment metadata
+  // cached) until `tiledb_array_close`
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->array_open(
+              (*array)->array_uri_,
+              (*array)->query_type_,
+              &(*array)->array_schema_,
+              &(*array)->fragment_metadata_))) {
+    delete *array;
+    *array = nullptr;
+    return TILEDB_ERR;
+  }
+
+  return TILEDB_OK;
+}
+
+int tiledb_array_close(tiledb_ctx_t* ctx, tiledb_array_t** array) {
+  if (array == nullptr || *array == nullptr)
+    return TILEDB_OK;
+
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, *array) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(ctx, ctx->storage_manager_->array_close((*array)->array_uri_)))
+    return TILEDB_ERR;
+
+  delete *array;
+  *array = nullptr;
+
+  return TILEDB_OK;
+}
+
+int tiledb_array_preload(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    const void* subarray,
+    const char** attributes,
+    unsigned int attribute_num) {
+  // Sanity checks
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Schedule the preload; it opens the array again internally (sharing
+  // the open array entry with the input handle) and keeps it open until
+  // the background task completes
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->array_preload(
+              array->array_uri_, subarray, attributes, attribute_num)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int tiledb_array_create(
     tiledb_ctx_t* ctx,
     const char* array_uri,
@@ -1881,6 +2504,82 @@ int tiledb_array_compute_max_read_buffer_sizes(
   return TILEDB_OK;
 }
 
+int tiledb_array_partition_subarray(
+    tiledb_ctx_t* ctx,
+    const char* array_uri,
+    const void* subarray,
+    tiledb_layout_t layout,
+    const char** attributes,
+    unsigned attribute_num,
+    uint64_t budget,
+    void** partitions,
+    uint64_t* partition_num) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Compute the partitions
+  std::vector<std::vector<uint8_t>> partitions_vec;
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->array_partition_subarray(
+              array_uri,
+              subarray,
+              static_cast<tiledb::sm::Layout>(layout),
+              attributes,
+              attribute_num,
+              budget,
+              &partitions_vec)))
+    return TILEDB_ERR;
+
+  // Emit the partitions in a single buffer
+  *partition_num = partitions_vec.size();
+  if (partitions_vec.empty()) {
+    *partitions = nullptr;
+    return TILEDB_OK;
+  }
+  auto partition_size = partitions_vec[0].size();
+  *partitions = std::malloc(*partition_num * partition_size);
+  if (*partitions == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate memory for subarray partitions");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+  for (uint64_t i = 0; i < *partition_num; ++i)
+    std::memcpy(
+        (char*)*partitions + i * partition_size,
+        &(partitions_vec[i])[0],
+        partition_size);
+
+  return TILEDB_OK;
+}
+
+int tiledb_array_compute_est_read_buffer_sizes(
+    tiledb_ctx_t* ctx,
+    const char* array_uri,
+    const void* subarray,
+    const char** attributes,
+    unsigned attribute_num,
+    double confidence,
+    uint64_t* buffer_sizes) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->array_compute_est_read_buffer_sizes(
+              array_uri,
+              subarray,
+              attributes,
+              attribute_num,
+              confidence,
+              buffer_sizes)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*         OBJECT MANAGEMENT      */
 /* ****************************** */
@@ -2085,6 +2784,19 @@ int tiledb_kv_schema_add_attribute(
   return TILEDB_OK;
 }
 
+int tiledb_kv_schema_set_hash_function(
+    tiledb_ctx_t* ctx, tiledb_kv_schema_t* kv_schema, tiledb_kv_hash_t hash) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, kv_schema) == TILEDB_ERR)
+    return TILEDB_ERR;
+  if (save_error(
+          ctx,
+          kv_schema->array_schema_->set_kv_hash(
+              static_cast<tiledb::sm::KVHash>(hash))))
+    return TILEDB_ERR;
+  return TILEDB_OK;
+}
+
 int tiledb_kv_schema_check(tiledb_ctx_t* ctx, tiledb_kv_schema_t* kv_schema) {
   if (sanity_check(ctx) == TILEDB_ERR ||
       sanity_check(ctx, kv_schema) == TILEDB_ERR)
@@ -2425,6 +3137,61 @@ int tiledb_kv_get_item(
   return TILEDB_OK;
 }
 
+int tiledb_kv_get_items(
+    tiledb_ctx_t* ctx,
+    tiledb_kv_t* kv,
+    tiledb_kv_item_t** kv_items,
+    uint64_t item_num,
+    const void** keys,
+    const tiledb_datatype_t* key_types,
+    const uint64_t* key_sizes) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (item_num == 0)
+    return TILEDB_OK;
+
+  // Get the items from the key-value store in a single batch
+  std::vector<tiledb::sm::Datatype> types(item_num);
+  for (uint64_t i = 0; i < item_num; ++i)
+    types[i] = static_cast<tiledb::sm::Datatype>(key_types[i]);
+  std::vector<tiledb::sm::KVItem*> items(item_num, nullptr);
+  if (save_error(
+          ctx,
+          kv->kv_->get_items(item_num, keys, &types[0], key_sizes, &items[0])))
+    return TILEDB_ERR;
+
+  // Create the key-value item structs; the entry of a key that does not
+  // exist in the store is set to NULL
+  for (uint64_t i = 0; i < item_num; ++i) {
+    if (items[i] == nullptr) {
+      kv_items[i] = nullptr;
+      continue;
+    }
+    kv_items[i] = new (std::nothrow) tiledb_kv_item_t;
+    if (kv_items[i] == nullptr) {
+      for (uint64_t j = i; j < item_num; ++j)
+        delete items[j];
+      for (uint64_t j = 0; j < i; ++j) {
+        if (kv_items[j] != nullptr) {
+          delete kv_items[j]->kv_item_;
+          delete kv_items[j];
+          kv_items[j] = nullptr;
+        }
+      }
+      tiledb::sm::Status st = tiledb::sm::Status::Error(
+          "Failed to allocate TileDB key-value item object");
+      LOG_STATUS(st);
+      save_error(ctx, st);
+      return TILEDB_OOM;
+    }
+    kv_items[i]->kv_item_ = items[i];
+  }
+
+  // Success
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*             KEY-VALUE          */
 /* ****************************** */
@@ -2546,6 +3313,36 @@ int tiledb_kv_add_item(
   return TILEDB_OK;
 }
 
+int tiledb_kv_add_items(
+    tiledb_ctx_t* ctx,
+    tiledb_kv_t* kv,
+    uint64_t item_num,
+    const void* keys,
+    const uint64_t* key_offsets,
+    uint64_t keys_size,
+    tiledb_datatype_t key_type,
+    const void** values,
+    const uint64_t* value_sizes,
+    const uint64_t* const* value_offsets) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, kv) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(
+          ctx,
+          kv->kv_->add_items(
+              item_num,
+              keys,
+              key_offsets,
+              keys_size,
+              static_cast<tiledb::sm::Datatype>(key_type),
+              values,
+              value_sizes,
+              value_offsets)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int tiledb_kv_flush(tiledb_ctx_t* ctx, tiledb_kv_t* kv) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, kv) == TILEDB_ERR)
     return TILEDB_ERR;
@@ -3124,6 +3921,63 @@ int tiledb_stats_dump(FILE* out) {
   return TILEDB_OK;
 }
 
+int tiledb_stats_dump_json(char** out) {
+  if (out == nullptr)
+    return TILEDB_ERR;
+
+  std::string json;
+  tiledb::sm::stats::all_stats.dump_json(&json);
+
+  *out = static_cast<char*>(std::malloc(json.size() + 1));
+  if (*out == nullptr)
+    return TILEDB_OOM;
+  std::memcpy(*out, json.c_str(), json.size() + 1);
+
+  return TILEDB_OK;
+}
+
+int tiledb_stats_free_str(char** str) {
+  if (str != nullptr && *str != nullptr) {
+    std::free(*str);
+    *str = nullptr;
+  }
+  return TILEDB_OK;
+}
+
+int tiledb_stats_get_counter(const char* name, uint64_t* value) {
+  if (name == nullptr || value == nullptr)
+    return TILEDB_ERR;
+
+  if (!tiledb::sm::stats::all_stats.get_counter(name, value))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+/* ****************************** */
+/*             Trace              */
+/* ****************************** */
+
+int tiledb_trace_enable() {
+  tiledb::sm::trace::all_tracer.set_enabled(true);
+  return TILEDB_OK;
+}
+
+int tiledb_trace_disable() {
+  tiledb::sm::trace::all_tracer.set_enabled(false);
+  return TILEDB_OK;
+}
+
+int tiledb_trace_reset() {
+  tiledb::sm::trace::all_tracer.clear();
+  return TILEDB_OK;
+}
+
+int tiledb_trace_dump(FILE* out) {
+  tiledb::sm::trace::all_tracer.dump_json(out);
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*            C++ API             */
 /* ****************************** */
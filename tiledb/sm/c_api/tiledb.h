@@ -78,6 +78,22 @@ typedef enum {
 #undef TILEDB_QUERY_STATUS_ENUM
 } tiledb_query_status_t;
 
+/** Predicate comparison operator. */
+typedef enum {
+/** Helper macro for defining predicate op enums. */
+#define TILEDB_PREDICATE_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_PREDICATE_OP_ENUM
+} tiledb_predicate_op_t;
+
+/** Tile cache behavior hint. */
+typedef enum {
+/** Helper macro for defining cache hint enums. */
+#define TILEDB_CACHE_HINT_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_CACHE_HINT_ENUM
+} tiledb_cache_hint_t;
+
 /** Filesystem type. */
 typedef enum {
 /** Helper macro for defining filesystem enums. */
@@ -134,6 +150,14 @@ typedef enum {
 #undef TILEDB_VFS_MODE_ENUM
 } tiledb_vfs_mode_t;
 
+/** Key-value key hash function. */
+typedef enum {
+/** Helper macro for defining key-value hash enums. */
+#define TILEDB_KV_HASH_ENUM(id) TILEDB_KV_HASH_##id
+#include "tiledb_enum.h"
+#undef TILEDB_KV_HASH_ENUM
+} tiledb_kv_hash_t;
+
 /* ****************************** */
 /*            CONSTANTS           */
 /* ****************************** */
@@ -182,6 +206,19 @@ TILEDB_EXPORT uint64_t tiledb_offset_size();
 #define TILEDB_OFFSET_SIZE tiledb_offset_size()
 /**@}*/
 
+/**
+ * @name Compression level presets, usable wherever a compression level
+ * is expected
+ */
+/**@{*/
+/** Favors compression/decompression speed. */
+#define TILEDB_COMPRESSION_FAST (-2)
+/** Balances compression speed and ratio. */
+#define TILEDB_COMPRESSION_BALANCED (-3)
+/** Favors compression ratio over speed. */
+#define TILEDB_COMPRESSION_ARCHIVE (-4)
+/**@}*/
+
 /* ****************************** */
 /*            VERSION             */
 /* ****************************** */
@@ -223,9 +260,15 @@ typedef struct tiledb_dimension_t tiledb_dimension_t;
 /** A TileDB domain. */
 typedef struct tiledb_domain_t tiledb_domain_t;
 
+/** An opened TileDB array. */
+typedef struct tiledb_array_t tiledb_array_t;
+
 /** A TileDB query. */
 typedef struct tiledb_query_t tiledb_query_t;
 
+/** A completion queue for asynchronous queries. */
+typedef struct tiledb_completion_queue_t tiledb_completion_queue_t;
+
 /** A key-value store schema. */
 typedef struct tiledb_kv_schema_t tiledb_kv_schema_t;
 
@@ -345,6 +388,60 @@ TILEDB_EXPORT int tiledb_config_free(tiledb_config_t** config);
  *    The fragment metadata cache size in bytes. Any `uint64_t` value is
  *    acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.enable_checksums` <br>
+ *    If `true`, per-chunk CRC32C checksums are written to compressed
+ *    tiles and verified upon reading. <br>
+ *    **Default**: false
+ * - `sm.concurrency.total_budget` <br>
+ *    The total number of threads in the compute and I/O thread pools
+ *    combined. If greater than 0, it overrides `sm.max_parallel_ops` and
+ *    `vfs.max_parallel_ops` when sizing the pools, with the split
+ *    determined by `sm.concurrency.io_ratio`. <br>
+ *    **Default**: 0 (no explicit budget)
+ * - `sm.concurrency.io_ratio` <br>
+ *    The fraction of the concurrency budget given to I/O threads, the
+ *    rest going to compute threads. Only meaningful when
+ *    `sm.concurrency.total_budget` is set. Any value in `[0.0, 1.0]` is
+ *    acceptable. <br>
+ *    **Default**: 0.5
+ * - `sm.concurrency.per_query_cap` <br>
+ *    The cap on the number of parallel operations a single query may
+ *    have in flight (e.g. concurrent tile decompressions), so that one
+ *    query cannot monopolize the thread pools. <br>
+ *    **Default**: 0 (unbounded)
+ * - `sm.memory_budget` <br>
+ *    The memory budget (in bytes) that the caches and per-query tile
+ *    buffers charge against. When the budget is hit, the read path
+ *    fetches tiles in smaller batches instead of all at once. The
+ *    budget should exceed the combined cache sizes. <br>
+ *    **Default**: 0 (unbounded)
+ * - `sm.write_combining_budget` <br>
+ *    If greater than 0, small unordered sparse writes get buffered in
+ *    memory (up to the given number of bytes) and flushed as a single
+ *    merged fragment, instead of each write producing its own fragment.
+ *    A buffered write becomes durable upon the flush, which happens
+ *    when the budget fills up, when the array is read or consolidated,
+ *    or when the context is freed. <br>
+ *    **Default**: 0 (disabled)
+ * - `sm.array_open_timestamp` <br>
+ *    If greater than 0, arrays open for reading at the given timestamp
+ *    (in ms since the epoch): fragments written after it are not
+ *    visible to the queries, and their metadata is not loaded. Note
+ *    that consolidating fragments assigns them a new timestamp. <br>
+ *    **Default**: 0 (current time)
+ * - `sm.generic_tile_prefix_size` <br>
+ *    The number of tile body bytes speculatively fetched together with
+ *    a generic tile header in a single read. Metadata objects (array
+ *    schemas, fragment metadata) that fit in the prefix are read in
+ *    one request instead of two dependent ones, which halves their
+ *    read latency on high-latency backends (e.g., S3). <br>
+ *    **Default**: 65536
+ * - `sm.hugepage_threshold` <br>
+ *    The buffer size (in bytes) above which allocations are
+ *    hugepage-aligned and advised to be backed by transparent
+ *    hugepages, reducing dTLB pressure when large tiles are
+ *    decompressed and copied. Only effective on Linux. <br>
+ *    **Default**: 0 (disabled)
  * - `vfs.max_parallel_ops` <br>
  *    The maximum number of VFS parallel operations. <br>
  *    **Default**: number of cores
@@ -352,6 +449,10 @@ TILEDB_EXPORT int tiledb_config_free(tiledb_config_t** config);
  *    The minimum number of bytes in a parallel VFS operation. (Does not
  *    affect parallel S3 writes.) <br>
  *    **Default**: 10MB
+ * - `vfs.max_batch_read_gap` <br>
+ *    The maximum gap (in bytes) between two regions that get coalesced
+ *    into a single read in a batched VFS read. <br>
+ *    **Default**: 500KB
  * - `vfs.s3.region` <br>
  *    The S3 region, if S3 is enabled. <br>
  *    **Default**: us-east-1
@@ -839,6 +940,68 @@ TILEDB_EXPORT int tiledb_attribute_set_compressor(
     tiledb_compressor_t compressor,
     int compression_level);
 
+/**
+ * Sets whether the attribute values are byte-shuffled before compression.
+ * Byte shuffling typically renders numeric data (especially floats)
+ * much more compressible and can be combined with any compressor.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_attribute_set_shuffle(ctx, attr, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param shuffle `1` to enable byte shuffling, `0` to disable it.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_shuffle(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int shuffle);
+
+/**
+ * Sets whether the attribute values are dictionary-encoded before
+ * compression. Each distinct value is stored once and the value sequence
+ * is replaced by small codes, which is very effective for
+ * low-cardinality variable-sized attributes (e.g., categorical strings).
+ * Applicable only to variable-sized attributes.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_attribute_set_dict_encode(ctx, attr, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param dict_encode `1` to enable dictionary encoding, `0` to disable it.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_dict_encode(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int dict_encode);
+
+/**
+ * Sets whether the cell offsets of the attribute are stored as 32-bit
+ * values on disk, halving the I/O and cache footprint of the offset
+ * tiles. The offsets are widened back to 64 bits upon reading, so query
+ * buffers always use 64-bit offsets. Writes error out if the
+ * variable-sized values of a single tile exceed the 32-bit range.
+ * Applicable only to variable-sized attributes.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_attribute_set_offsets_32(ctx, attr, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param offsets_32 `1` to store 32-bit offsets on disk, `0` for 64-bit.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_offsets_32(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, int offsets_32);
+
 /**
  * Sets the number of values per cell for an attribute. If this is not
  * used, the default is `1`.
@@ -924,6 +1087,63 @@ TILEDB_EXPORT int tiledb_attribute_get_compressor(
     tiledb_compressor_t* compressor,
     int* compression_level);
 
+/**
+ * Retrieves whether the attribute values are byte-shuffled before
+ * compression.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int shuffle;
+ * tiledb_attribute_get_shuffle(ctx, attr, &shuffle);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param shuffle Set to `1` if byte shuffling is enabled, else `0`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_shuffle(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, int* shuffle);
+
+/**
+ * Retrieves whether the attribute values are dictionary-encoded before
+ * compression.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int dict_encode;
+ * tiledb_attribute_get_dict_encode(ctx, attr, &dict_encode);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param dict_encode Set to `1` if dictionary encoding is enabled, else `0`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_dict_encode(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, int* dict_encode);
+
+/**
+ * Retrieves whether the cell offsets of the attribute are stored as
+ * 32-bit values on disk.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int offsets_32;
+ * tiledb_attribute_get_offsets_32(ctx, attr, &offsets_32);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param offsets_32 Set to `1` if 32-bit offsets are enabled, else `0`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_offsets_32(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, int* offsets_32);
+
 /**
  * Retrieves the number of values per cell for the attribute.
  *
@@ -1397,7 +1617,11 @@ TILEDB_EXPORT int tiledb_array_schema_set_capacity(
  *
  * @param ctx The TileDB context.
  * @param array_schema The array schema.
- * @param cell_order The cell order to be set.
+ * @param cell_order The cell order to be set. In addition to
+ *     `TILEDB_ROW_MAJOR` and `TILEDB_COL_MAJOR`, sparse arrays with integer
+ *     domains may use `TILEDB_MORTON`, which orders the cells on a morton
+ *     (Z-order) space-filling curve and, hence, clusters spatially close
+ *     cells into the same tiles.
  * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
 TILEDB_EXPORT int tiledb_array_schema_set_cell_order(
@@ -1781,6 +2005,123 @@ TILEDB_EXPORT int tiledb_query_create(
     const char* array_uri,
     tiledb_query_type_t type);
 
+/**
+ * Creates a TileDB query object against an array that has been opened
+ * with `tiledb_array_open`. Unlike `tiledb_query_create`, no array
+ * opening takes place; the array schema and fragment metadata cached in
+ * the opened array are shared by all the queries created against it,
+ * which amortizes the opening cost when many (potentially concurrent)
+ * queries target the same array. The query type is the one the array
+ * was opened with.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_t* query;
+ * tiledb_query_create_with_array(ctx, &query, array);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object to be created.
+ * @param array An array opened with `tiledb_array_open`. It must remain
+ *     open until the query is finalized.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_create_with_array(
+    tiledb_ctx_t* ctx, tiledb_query_t** query, tiledb_array_t* array);
+
+/**
+ * Plans a read query once for execution by multiple workers. The array
+ * is opened a single time, the subarray is partitioned so that the
+ * results of each partition are estimated to fit in the given memory
+ * budget (see `tiledb_array_partition_subarray`), and the array URI,
+ * layout, fragment snapshot and partitions are serialized into a
+ * compact plan. The plan can be shipped to worker nodes, each of which
+ * creates a query directly from it with
+ * `tiledb_query_create_from_plan`, without re-running the discovery
+ * performed by the planner. The partitions are non-overlapping, so the
+ * workers produce disjoint results.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * void* plan;
+ * uint64_t plan_size, partition_num;
+ * tiledb_query_plan(
+ *     ctx,
+ *     "my_array",
+ *     NULL,
+ *     TILEDB_ROW_MAJOR,
+ *     NULL,
+ *     0,
+ *     64 * 1024 * 1024,
+ *     &plan,
+ *     &plan_size,
+ *     &partition_num);
+ * // ... ship the plan to the workers of each partition ...
+ * free(plan);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_uri The array URI.
+ * @param subarray The subarray to plan for. Note that it must have the
+ *     same underlying type as the array domain. Use `NULL` for the
+ *     entire domain.
+ * @param layout The layout in which the partitions will be read.
+ * @param attributes The attributes the reads will focus on. Use `NULL`
+ *     to indicate **all** attributes (and the coordinates, if the array
+ *     is sparse).
+ * @param attribute_num The number of attributes.
+ * @param budget The memory budget (in bytes) per partition.
+ * @param plan The serialized plan, in a buffer allocated by the
+ *     function. The caller must release it with `free`.
+ * @param plan_size The size (in bytes) of the serialized plan.
+ * @param partition_num The number of partitions in the plan.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_plan(
+    tiledb_ctx_t* ctx,
+    const char* array_uri,
+    const void* subarray,
+    tiledb_layout_t layout,
+    const char** attributes,
+    unsigned attribute_num,
+    uint64_t budget,
+    void** plan,
+    uint64_t* plan_size,
+    uint64_t* partition_num);
+
+/**
+ * Creates a TileDB read query from a serialized query plan (see
+ * `tiledb_query_plan`), constrained on the plan partition with the
+ * given index. The query is restricted to the fragment snapshot
+ * recorded in the plan, so all the workers executing the partitions of
+ * a plan observe the same data. The caller then sets the buffers and
+ * submits the query as usual.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_t* query;
+ * tiledb_query_create_from_plan(ctx, &query, plan, plan_size, 0);
+ * tiledb_query_set_buffers(ctx, query, attributes, 1, buffers, sizes);
+ * tiledb_query_submit(ctx, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object to be created.
+ * @param plan The serialized query plan.
+ * @param plan_size The size (in bytes) of the serialized plan.
+ * @param partition_idx The index of the plan partition to execute.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_create_from_plan(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t** query,
+    const void* plan,
+    uint64_t plan_size,
+    uint64_t partition_idx);
+
 /**
  * Indicates that the query will write or read a subarray, and provides
  * the appropriate information.
@@ -1806,6 +2147,41 @@ TILEDB_EXPORT int tiledb_query_create(
 TILEDB_EXPORT int tiledb_query_set_subarray(
     tiledb_ctx_t* ctx, tiledb_query_t* query, const void* subarray);
 
+/**
+ * Indicates that the query will read a list of subarray ranges, and
+ * provides the appropriate information. This is applicable only to read
+ * queries on sparse arrays. The tile overlap is computed once for the
+ * union of the ranges and a tile overlapping multiple ranges is fetched
+ * only once, which makes a single multi-range query much faster than
+ * submitting one query per range. The results are produced in the array
+ * cell order, deduplicated across the ranges.
+ *
+ * **Example:**
+ *
+ * The following sets the two 2D ranges [0,10], [20,30] and [50,60],
+ * [20,30] to the query.
+ *
+ * @code{.c}
+ * uint64_t subarrays[] = {0, 10, 20, 30, 50, 60, 20, 30};
+ * tiledb_query_set_subarrays(ctx, query, subarrays, 2);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param subarrays The ranges in which the array read will be constrained
+ *     on. It should be a sequence of `range_num` consecutive
+ *     hyper-rectangles, each a sequence of [low, high] pairs (one pair per
+ *     dimension). Note that `subarrays` must have the same type as the
+ *     domain.
+ * @param range_num The number of ranges in `subarrays`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_set_subarrays(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const void* subarrays,
+    uint64_t range_num);
+
 /**
  * Sets the buffers to the query, which will either hold the attribute
  * values to be written (if it is a write query), or will hold the
@@ -1851,158 +2227,512 @@ TILEDB_EXPORT int tiledb_query_set_buffers(
     uint64_t* buffer_sizes);
 
 /**
- * Sets the layout of the cells to be written or read.
+ * Sets the attributes of a read query in "query-allocated buffers" mode.
+ * Instead of copying results into user-provided buffers, the query
+ * allocates its result buffers itself, sized exactly to the result.
+ * Reads in this mode always complete in a single submission; there is
+ * no buffer overflow or resubmit cycle. The buffers are retrieved with
+ * `tiledb_query_get_buffer` after the query completes, and can be
+ * handed to columnar consumers (values plus 64-bit offsets) without an
+ * extra copy.
  *
  * **Example:**
  *
  * @code{.c}
- * tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR);
+ * const char* attributes[] = {"attr_1", "attr_2"};
+ * tiledb_query_set_alloc_buffers(ctx, query, attributes, 2);
  * @endcode
  *
  * @param ctx The TileDB context.
  * @param query The TileDB query.
- * @param layout For a write query, this specifies the order of the cells
- *     provided by the user in the buffers. For a read query, this specifies
- *     the order of the cells that will be retrieved as results and stored
- *     in the user buffers. The layout can be one of the following:
- *    - `TILEDB_COL_MAJOR`:
- *      This means column-major order with respect to the subarray.
- *    - `TILEDB_ROW_MAJOR`:
- *      This means row-major order with respect to the subarray.
- *    - `TILEDB_GLOBAL_ORDER`:
- *      This means that cells are stored or retrieved in the array global
- *      cell order.
- *    - `TILEDB_UNORDERED`:
- *      This is applicable only to writes for sparse arrays, or for sparse
- *      writes to dense arrays. It specifies that the cells are unordered and,
- *      hence, TileDB must sort the cells in the global cell order prior to
- *      writing.
+ * @param attributes A set of the array attributes the read will be
+ *     constrained on. If it is set to `NULL`, then this means **all**
+ *     attributes.
+ * @param attribute_num The number of the input attributes.
  * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_set_layout(
-    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout);
+TILEDB_EXPORT int tiledb_query_set_alloc_buffers(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char** attributes,
+    unsigned int attribute_num);
 
 /**
- * Finalizes a TileDB query object, flushing all internal state.
+ * Retrieves the query-allocated result buffers of an attribute, after a
+ * read in the mode set by `tiledb_query_set_alloc_buffers` has
+ * completed. The buffers are owned by the query and remain valid until
+ * the query object is freed.
  *
  * **Example:**
  *
  * @code{.c}
- * tiledb_query_t* query;
- * // ... Your code here ... //
- * tiledb_query_finalize(ctx, query);
+ * void* values;
+ * uint64_t values_size;
+ * tiledb_query_get_buffer(
+ *     ctx, query, "attr_1", &values, &values_size, NULL, NULL);
  * @endcode
  *
  * @param ctx The TileDB context.
- * @param query The query object to be finalized.
+ * @param query The TileDB query.
+ * @param attribute The attribute name.
+ * @param buffer Set to the values buffer for a fixed-sized attribute,
+ *     or to the (64-bit) offsets buffer for a var-sized one.
+ * @param buffer_size Set to the useful size of `buffer` in bytes.
+ * @param buffer_var Set to the values buffer for a var-sized attribute,
+ *     or to `NULL` for a fixed-sized one. It may be `NULL` if the caller
+ *     is not interested.
+ * @param buffer_var_size Set to the useful size of `buffer_var` in
+ *     bytes. It may be `NULL` if the caller is not interested.
  * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_finalize(
-    tiledb_ctx_t* ctx, tiledb_query_t* query);
+TILEDB_EXPORT int tiledb_query_get_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    void** buffer,
+    uint64_t* buffer_size,
+    void** buffer_var,
+    uint64_t* buffer_var_size);
 
 /**
- * Frees a TileDB query object.
+ * Computes the count/min/max/sum aggregates of an attribute over the
+ * cells a read of the query subarray would return, without materializing
+ * the cells in result buffers. Tiles whose cells are all part of the
+ * result are answered from the per-tile statistics in the fragment
+ * metadata (no tile I/O at all); only the boundary tiles and the tiles
+ * affected by overwrites are fetched and scanned. In a dense array,
+ * cells that no fragment has written contribute nothing to the
+ * aggregates.
+ *
+ * Applicable only to read queries and to fixed-sized, single-value
+ * numeric attributes. The query needs no buffers set; only the subarray
+ * (and, optionally, the layout) matters.
  *
  * **Example:**
  *
  * @code{.c}
- * tiledb_query_free(ctx, &query);
+ * uint64_t count;
+ * int32_t min, max;
+ * int64_t sum;
+ * tiledb_query_aggregate(ctx, query, "attr_1", &count, &min, &max, &sum);
  * @endcode
  *
  * @param ctx The TileDB context.
- * @param query The query object to be deleted.
+ * @param query The TileDB query.
+ * @param attribute The attribute to aggregate.
+ * @param count Set to the number of result cells.
+ * @param min Set to the minimum cell value, in the attribute type. It
+ *     may be `NULL`. It is left unset if the count is 0.
+ * @param max Set to the maximum cell value, in the attribute type. It
+ *     may be `NULL`. It is left unset if the count is 0.
+ * @param sum Set to the sum of the cell values, in the widest type of
+ *     the attribute's kind (`int64_t` for signed integers, `uint64_t`
+ *     for unsigned integers and `double` for floating point values).
+ *     It may be `NULL`. It is left unset if the count is 0.
  * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_free(tiledb_ctx_t* ctx, tiledb_query_t** query);
+TILEDB_EXPORT int tiledb_query_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    uint64_t* count,
+    void* min,
+    void* max,
+    void* sum);
 
 /**
- * Submits a TileDB query.
+ * Sets a comparison predicate on an attribute. The read returns only
+ * the cells whose value for the attribute compares `op` against
+ * `value`; setting multiple predicates (on the same or different
+ * attributes) combines them with a logical AND. The predicates are
+ * evaluated inside the read path, so only the selected cells are
+ * copied to the result buffers, and tiles that the per-tile statistics
+ * prove empty of matches are neither fetched nor decompressed.
+ *
+ * Applicable only to read queries and to fixed-sized, single-value
+ * numeric attributes. The predicate attribute does not need to be among
+ * the attributes the query retrieves.
  *
  * **Example:**
  *
  * @code{.c}
- * tiledb_query_submit(ctx, &query);
+ * int32_t value = 10;
+ * tiledb_query_set_predicate(ctx, query, "attr_1", TILEDB_GE, &value);
  * @endcode
  *
  * @param ctx The TileDB context.
- * @param query The query to be submitted.
- * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
- *
- * @note Always invoke `tiledb_query_free` after the query is completed.
+ * @param query The TileDB query.
+ * @param attribute The attribute to filter on.
+ * @param op The comparison operator.
+ * @param value The operand value, in the attribute type.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_submit(tiledb_ctx_t* ctx, tiledb_query_t* query);
+TILEDB_EXPORT int tiledb_query_set_predicate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_predicate_op_t op,
+    const void* value);
 
 /**
- * Submits a TileDB query in asynchronous mode.
- *
- * **Examples:**
- *
- * Submit without a callback.
- *
- * @code{.c}
- * tiledb_query_submit_async(ctx, &query, NULL, NULL);
- * @endcode
+ * Sets an inclusive range predicate on an attribute, selecting the
+ * cells whose value lies in `[low, high]`. See
+ * `tiledb_query_set_predicate` for the applicability rules and the
+ * combination semantics.
  *
- * Submit with a callback function `print` that takes as input message
- * `msg` and prints it upon completion of the query.
+ * **Example:**
  *
  * @code{.c}
- * const char* msg = "Query completed";
- * tiledb_query_submit_async(ctx, &query, foo, msg);
+ * int32_t low = 10, high = 20;
+ * tiledb_query_set_predicate_range(ctx, query, "attr_1", &low, &high);
  * @endcode
  *
  * @param ctx The TileDB context.
- * @param query The query to be submitted.
- * @param callback The function to be called when the query completes.
- * @param callback_data The data to be passed to the callback function.
- * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
- *
- * @note Always invoke `tiledb_query_free` after the query is completed.
+ * @param query The TileDB query.
+ * @param attribute The attribute to filter on.
+ * @param low The low bound, in the attribute type.
+ * @param high The high bound, in the attribute type.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_submit_async(
+TILEDB_EXPORT int tiledb_query_set_predicate_range(
     tiledb_ctx_t* ctx,
     tiledb_query_t* query,
-    void (*callback)(void*),
-    void* callback_data);
+    const char* attribute,
+    const void* low,
+    const void* high);
 
 /**
- * Resets the query buffers.
+ * Sets a set membership predicate on an attribute, selecting the cells
+ * whose value equals one of the given values. See
+ * `tiledb_query_set_predicate` for the applicability rules and the
+ * combination semantics.
  *
  * **Example:**
  *
  * @code{.c}
- * tiledb_query_reset_buffers(ctx, query, buffers, buffer_sizes);
+ * int32_t values[] = {10, 20, 30};
+ * tiledb_query_set_predicate_set(ctx, query, "attr_1", values, 3);
  * @endcode
  *
  * @param ctx The TileDB context.
- * @param query The query whose buffers are to be se.
- * @param buffers The buffers to be set.
- * @param buffer_sizes The corresponding buffer sizes.
- * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ * @param query The TileDB query.
+ * @param attribute The attribute to filter on.
+ * @param values The member values, serialized consecutively in the
+ *     attribute type.
+ * @param value_num The number of values in `values`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_reset_buffers(
+TILEDB_EXPORT int tiledb_query_set_predicate_set(
     tiledb_ctx_t* ctx,
     tiledb_query_t* query,
-    void** buffers,
-    uint64_t* buffer_sizes);
+    const char* attribute,
+    const void* values,
+    uint64_t value_num);
 
 /**
- * Retrieves the status of a query.
+ * Sets the tile cache behavior of a read query. `TILEDB_CACHE_BYPASS`
+ * marks the read as streaming/one-shot; its tiles are served from the
+ * cache if present, but are not inserted into it, so that a large scan
+ * does not pollute the cache. `TILEDB_CACHE_PIN` marks the read as
+ * latency-critical; its tiles are cached so that they resist eviction
+ * by one-shot reads.
  *
  * **Example:**
  *
  * @code{.c}
- * tiledb_query_status_t status;
- * tiledb_query_get_status(ctx, query, &status);
+ * tiledb_query_set_cache_hint(ctx, query, TILEDB_CACHE_BYPASS);
  * @endcode
  *
  * @param ctx The TileDB context.
- * @param query The query.
- * @param status The query status to be retrieved.
- * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ * @param query The TileDB query.
+ * @param hint The cache behavior hint.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
-TILEDB_EXPORT int tiledb_query_get_status(
-    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_query_status_t* status);
+TILEDB_EXPORT int tiledb_query_set_cache_hint(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_cache_hint_t hint);
+
+/**
+ * Sets the layout of the cells to be written or read.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param layout For a write query, this specifies the order of the cells
+ *     provided by the user in the buffers. For a read query, this specifies
+ *     the order of the cells that will be retrieved as results and stored
+ *     in the user buffers. The layout can be one of the following:
+ *    - `TILEDB_COL_MAJOR`:
+ *      This means column-major order with respect to the subarray.
+ *    - `TILEDB_ROW_MAJOR`:
+ *      This means row-major order with respect to the subarray.
+ *    - `TILEDB_GLOBAL_ORDER`:
+ *      This means that cells are stored or retrieved in the array global
+ *      cell order.
+ *    - `TILEDB_UNORDERED`:
+ *      For writes, this is applicable only to sparse arrays, or to sparse
+ *      writes to dense arrays. It specifies that the cells are unordered and,
+ *      hence, TileDB must sort the cells in the global cell order prior to
+ *      writing. For reads, this is applicable only to sparse arrays. It
+ *      specifies that the result cells may be returned in any order, which
+ *      allows TileDB to skip sorting them - the fastest option for
+ *      order-insensitive scans.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_set_layout(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout);
+
+/**
+ * Finalizes a TileDB query object, flushing all internal state.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_t* query;
+ * // ... Your code here ... //
+ * tiledb_query_finalize(ctx, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object to be finalized.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_finalize(
+    tiledb_ctx_t* ctx, tiledb_query_t* query);
+
+/**
+ * Frees a TileDB query object.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_free(ctx, &query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object to be deleted.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_query_free(tiledb_ctx_t* ctx, tiledb_query_t** query);
+
+/**
+ * Submits a TileDB query.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_submit(ctx, &query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be submitted.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ *
+ * @note Always invoke `tiledb_query_free` after the query is completed.
+ */
+TILEDB_EXPORT int tiledb_query_submit(tiledb_ctx_t* ctx, tiledb_query_t* query);
+
+/**
+ * Submits a batch of TileDB queries in a single call and blocks until all
+ * of them complete. The queries are scheduled cooperatively on the async
+ * workers, with small reads getting ahead of bulk scans, and queries in
+ * the batch that target the same tiles share the fetched tiles through
+ * the tile cache. This is more efficient than submitting many small
+ * queries one at a time.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_t* queries[2] = {query_1, query_2};
+ * tiledb_query_submit_batch(ctx, queries, 2);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param queries The queries to be submitted.
+ * @param query_num The number of queries.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error. If any query
+ *     in the batch fails, `TILEDB_ERR` is returned; the status of each
+ *     individual query can be retrieved with `tiledb_query_get_status`.
+ *
+ * @note Always invoke `tiledb_query_free` after a query is completed.
+ */
+TILEDB_EXPORT int tiledb_query_submit_batch(
+    tiledb_ctx_t* ctx, tiledb_query_t** queries, uint64_t query_num);
+
+/**
+ * Submits a TileDB query in asynchronous mode.
+ *
+ * **Examples:**
+ *
+ * Submit without a callback.
+ *
+ * @code{.c}
+ * tiledb_query_submit_async(ctx, &query, NULL, NULL);
+ * @endcode
+ *
+ * Submit with a callback function `print` that takes as input message
+ * `msg` and prints it upon completion of the query.
+ *
+ * @code{.c}
+ * const char* msg = "Query completed";
+ * tiledb_query_submit_async(ctx, &query, foo, msg);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be submitted.
+ * @param callback The function to be called when the query completes.
+ * @param callback_data The data to be passed to the callback function.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ *
+ * @note Always invoke `tiledb_query_free` after the query is completed.
+ */
+TILEDB_EXPORT int tiledb_query_submit_async(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void (*callback)(void*),
+    void* callback_data);
+
+/**
+ * Submits a TileDB query in asynchronous mode with incremental result
+ * delivery. In addition to the completion callback, the progress
+ * callback is invoked every time a batch of result cells has been
+ * copied into the user buffers before the submission completes (which
+ * happens when a read is internally partitioned, see config parameter
+ * `sm.read_partition_budget`). Upon each invocation the buffer sizes
+ * passed to `tiledb_query_set_buffers` reflect the copied prefix of the
+ * user buffers, which is final and can be consumed while the remaining
+ * partitions are still being read. The progress callback runs on the
+ * thread processing the query; the user buffers must not be modified
+ * while the query is in flight.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_submit_async_progress(ctx, &query, done, NULL, consume, &st);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be submitted.
+ * @param callback The function to be called when the query completes.
+ * @param callback_data The data to be passed to the callback function.
+ * @param progress_callback The function to be called upon the completion
+ *     of each result batch before the query completes.
+ * @param progress_callback_data The data to be passed to the progress
+ *     callback function.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ *
+ * @note Always invoke `tiledb_query_free` after the query is completed.
+ */
+TILEDB_EXPORT int tiledb_query_submit_async_progress(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void (*callback)(void*),
+    void* callback_data,
+    void (*progress_callback)(void*),
+    void* progress_callback_data);
+
+/**
+ * Submits a TileDB query in asynchronous mode, tagging it with user data.
+ * Upon completion (successful or not), the tag is pushed to the input
+ * completion queue, which the caller drains on its own thread with
+ * `tiledb_completion_queue_poll` or `tiledb_completion_queue_wait`. This
+ * avoids bouncing each completion through a callback thread when
+ * integrating with an event loop.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_submit_queued(ctx, query, cq, my_request);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be submitted.
+ * @param cq The completion queue the query completion will be pushed to.
+ *     It must not be freed before the query completes.
+ * @param tag User data identifying the query; it is returned verbatim
+ *     when the completion is drained from the queue.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ *
+ * @note Always invoke `tiledb_query_free` after the query is completed.
+ */
+TILEDB_EXPORT int tiledb_query_submit_queued(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    tiledb_completion_queue_t* cq,
+    void* tag);
+
+/**
+ * Resets the query buffers.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_reset_buffers(ctx, query, buffers, buffer_sizes);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query whose buffers are to be se.
+ * @param buffers The buffers to be set.
+ * @param buffer_sizes The corresponding buffer sizes.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int tiledb_query_reset_buffers(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void** buffers,
+    uint64_t* buffer_sizes);
+
+/**
+ * Resets a completed read query with a new subarray, so that the same
+ * query object can be submitted again. The query keeps the array open:
+ * the fragment list, the loaded fragment metadata and the attribute and
+ * buffer bindings are all reused, making repeated submissions of the
+ * same query shape with different subarrays much cheaper than creating
+ * a new query per submission.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t subarray[] = {10, 20, 10, 20};
+ * tiledb_query_reset(ctx, query, subarray);
+ * tiledb_query_submit(ctx, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be reset.
+ * @param subarray The new subarray. If it is `NULL`, the subarray is set
+ *     to the entire domain.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ *
+ * @note For reads into user-provided buffers, also invoke
+ *     `tiledb_query_reset_buffers` (or re-set the buffer sizes), since
+ *     a completed read overwrites the buffer sizes with the result
+ *     sizes.
+ */
+TILEDB_EXPORT int tiledb_query_reset(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, const void* subarray);
+
+/**
+ * Retrieves the status of a query.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_status_t status;
+ * tiledb_query_get_status(ctx, query, &status);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param status The query status to be retrieved.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int tiledb_query_get_status(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_query_status_t* status);
 
 /**
  * Checks the query status for a particular attribute. This is because a
@@ -2028,10 +2758,236 @@ TILEDB_EXPORT int tiledb_query_get_attribute_status(
     const char* attribute_name,
     tiledb_query_status_t* status);
 
+/** Statistics gathered during the execution of a single query. */
+typedef struct tiledb_query_stats_t {
+  /** The number of bytes read from storage (compressed size). */
+  uint64_t bytes_read;
+  /** The number of tiles fetched by the query. */
+  uint64_t tiles_fetched;
+  /** The number of tiles served from the tile cache. */
+  uint64_t cache_hits;
+  /** The number of tiles not found in the tile cache. */
+  uint64_t cache_misses;
+  /** Time spent computing the subarray/tile overlap, in nanoseconds. */
+  uint64_t compute_overlap_time_ns;
+  /** Time spent reading tile bytes from storage, in nanoseconds. */
+  uint64_t io_time_ns;
+  /** Time spent decompressing tiles, in nanoseconds. */
+  uint64_t decompress_time_ns;
+  /** Time spent sorting/deduplicating coordinates, in nanoseconds. */
+  uint64_t sort_time_ns;
+  /** Time spent copying cells into the user buffers, in nanoseconds. */
+  uint64_t copy_time_ns;
+} tiledb_query_stats_t;
+
+/**
+ * Retrieves the statistics gathered during the execution of a query.
+ * Unlike `tiledb_stats_dump`, these are specific to the input query, so
+ * the I/O and time of concurrently executing queries can be attributed
+ * individually. The phase timers are cumulative across threads.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_stats_t stats;
+ * tiledb_query_get_stats(ctx, query, &stats);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param stats The query statistics to be retrieved.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int tiledb_query_get_stats(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_t* query,
+    tiledb_query_stats_t* stats);
+
+/* ********************************* */
+/*         COMPLETION QUEUE          */
+/* ********************************* */
+
+/**
+ * Creates a completion queue for asynchronous queries. Queries submitted
+ * with `tiledb_query_submit_queued` push their tag to the queue upon
+ * completion, and the caller drains the completions with
+ * `tiledb_completion_queue_poll` or `tiledb_completion_queue_wait`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_completion_queue_t* cq;
+ * tiledb_completion_queue_create(ctx, &cq);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue to be created.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_completion_queue_create(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t** cq);
+
+/**
+ * Frees a completion queue. All the queries submitted with the queue must
+ * have completed before the queue is freed.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_completion_queue_free(ctx, &cq);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue to be freed.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_completion_queue_free(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t** cq);
+
+/**
+ * Drains one completion from the queue without blocking.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * void* tag;
+ * int has_completion;
+ * tiledb_completion_queue_poll(ctx, cq, &tag, &has_completion);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue.
+ * @param tag The tag of the completed query to be retrieved. It is set
+ *     only if `has_completion` is set to `1`.
+ * @param has_completion The function sets it to `1` if a completion was
+ *     drained and `0` if the queue was empty.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_completion_queue_poll(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    void** tag,
+    int* has_completion);
+
+/**
+ * Drains one completion from the queue, blocking until a completion is
+ * available or the timeout expires.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * void* tag;
+ * int has_completion;
+ * tiledb_completion_queue_wait(ctx, cq, 100, &tag, &has_completion);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue.
+ * @param timeout_ms The maximum number of milliseconds to wait for a
+ *     completion. Use `UINT64_MAX` to wait without a timeout.
+ * @param tag The tag of the completed query to be retrieved. It is set
+ *     only if `has_completion` is set to `1`.
+ * @param has_completion The function sets it to `1` if a completion was
+ *     drained and `0` if the timeout expired.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_completion_queue_wait(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    uint64_t timeout_ms,
+    void** tag,
+    int* has_completion);
+
 /* ********************************* */
 /*               ARRAY               */
 /* ********************************* */
 
+/**
+ * Opens a TileDB array for a given query type, retaining its schema and
+ * fragment metadata in memory until the array is closed. Queries can then
+ * be created against the opened array with `tiledb_query_create_with_array`
+ * (open once, submit many queries, close once), which avoids re-opening
+ * the array for every query.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_t* array;
+ * tiledb_array_open(ctx, &array, "file:///my_array", TILEDB_READ);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The opened array object to be created.
+ * @param array_uri The array URI.
+ * @param query_type The type of the queries that will be created against
+ *     the array, which must be one of the following:
+ *    - `TILEDB_WRITE`
+ *    - `TILEDB_READ`
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ *
+ * @note Fragments committed to the array after it is opened are not
+ *     visible to the queries created against it; close and re-open the
+ *     array to see them.
+ */
+TILEDB_EXPORT int tiledb_array_open(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t** array,
+    const char* array_uri,
+    tiledb_query_type_t query_type);
+
+/**
+ * Closes a TileDB array opened with `tiledb_array_open` and frees the
+ * opened array object. All the queries created against the array must
+ * have been finalized before the array is closed.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_close(ctx, &array);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The opened array object to be closed and freed.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_array_close(tiledb_ctx_t* ctx, tiledb_array_t** array);
+
+/**
+ * Preloads into the tile cache, on background threads, the tiles of the
+ * input attributes that overlap the input subarray, so that subsequent
+ * read queries on the subarray are served from the cache instead of
+ * incurring cold-start I/O. The function returns as soon as the preload
+ * is scheduled; I/O errors during the preload itself are only logged, as
+ * preloading is best-effort.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t subarray[] = {1, 100, 1, 100};
+ * const char* attributes[] = {"a1"};
+ * tiledb_array_preload(ctx, array, subarray, attributes, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array An array opened with `tiledb_array_open`.
+ * @param subarray The subarray whose tiles to preload. If `NULL`, the
+ *     tiles of the entire domain are preloaded.
+ * @param attributes The attributes whose tiles to preload. If `NULL`,
+ *     all the array attributes (and, for sparse arrays, the coordinates)
+ *     are preloaded.
+ * @param attribute_num The number of attributes.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note The preload holds its own reference to the open array, so the
+ *     array may be closed before the background preload completes.
+ */
+TILEDB_EXPORT int tiledb_array_preload(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    const void* subarray,
+    const char** attributes,
+    unsigned int attribute_num);
+
 /**
  * Creates a new TileDB array given an input schema.
  *
@@ -2124,6 +3080,111 @@ TILEDB_EXPORT int tiledb_array_compute_max_read_buffer_sizes(
     unsigned attribute_num,
     uint64_t* buffer_sizes);
 
+/**
+ * Partitions a subarray into a list of sub-partitions, such that the
+ * results of a read query on each sub-partition are estimated to fit
+ * in the given memory budget. The estimates are upper bounds computed
+ * from the fragment metadata, hence a read on a produced partition is
+ * guaranteed not to overflow buffers totaling the budget. A partition
+ * that exceeds the budget but cannot be split any further (i.e., it
+ * covers a single cell) is emitted as is, and sub-partitions with no
+ * results are omitted.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t subarray[] = {10, 20, 10, 100};
+ * const char* attributes[] = {"attr_1"};
+ * void* partitions;
+ * uint64_t partition_num;
+ * tiledb_array_partition_subarray(
+ *     ctx,
+ *     "my_array",
+ *     subarray,
+ *     TILEDB_ROW_MAJOR,
+ *     attributes,
+ *     1,
+ *     1024 * 1024,
+ *     &partitions,
+ *     &partition_num);
+ * // ... read each partition with a separate query ...
+ * free(partitions);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_uri The array URI.
+ * @param subarray The subarray to partition. Note that it must have the
+ *     same underlying type as the array domain. Use `NULL` for the
+ *     entire domain.
+ * @param layout The layout in which the partitions will be read. The
+ *     partitions are also emitted in this order.
+ * @param attributes The attributes the reads will focus on. Use `NULL`
+ *     to indicate **all** attributes (and the coordinates, if the array
+ *     is sparse).
+ * @param attribute_num The number of attributes.
+ * @param budget The memory budget (in bytes).
+ * @param partitions The sub-partitions, emitted as `partition_num`
+ *     consecutive subarrays in a single buffer allocated by the
+ *     function. The caller must release it with `free`.
+ * @param partition_num The number of emitted sub-partitions.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_array_partition_subarray(
+    tiledb_ctx_t* ctx,
+    const char* array_uri,
+    const void* subarray,
+    tiledb_layout_t layout,
+    const char** attributes,
+    unsigned attribute_num,
+    uint64_t budget,
+    void** partitions,
+    uint64_t* partition_num);
+
+/**
+ * Computes an estimate of the buffer sizes required for a read query,
+ * for a given subarray and set of attributes. Unlike
+ * `tiledb_array_compute_max_read_buffer_sizes`, which for sparse arrays
+ * returns a worst-case bound counting every cell of every tile that
+ * overlaps the subarray, this function scales each tile's contribution
+ * by the fraction of the tile MBR the subarray covers, yielding the
+ * expected result size. This allows allocating near-optimal buffers
+ * instead of looping on buffer overflow.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t buffer_sizes[2];
+ * const char* attributes[] = {"attr_1", "attr_2"};
+ * uint64_t subarray[] = {10, 20, 10, 100};
+ * tiledb_array_compute_est_read_buffer_sizes(
+ *     ctx, "my_array", subarray, attributes, 2, 1.5, buffer_sizes);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_uri The array URI.
+ * @param subarray The subarray to focus on. Note that it must have the same
+ *     underlying type as the array domain.
+ * @param attributes The attributes to focus on.
+ * @param attribute_num The number of attributes.
+ * @param confidence A factor (>= 1.0) the expected sizes are multiplied
+ *     with, adding headroom that reduces the chance of a retry upon
+ *     buffer overflow. `1.0` returns the raw expectation.
+ * @param buffer_sizes The buffer sizes to be retrieved. Note that one
+ *     buffer size corresponds to a fixed-sized attributes, and two
+ *     buffer sizes for a variable-sized attribute (the first is the
+ *     size of the offsets, whereas the second is the size of the
+ *     actual variable-sized cell values.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_array_compute_est_read_buffer_sizes(
+    tiledb_ctx_t* ctx,
+    const char* array_uri,
+    const void* subarray,
+    const char** attributes,
+    unsigned attribute_num,
+    double confidence,
+    uint64_t* buffer_sizes);
+
 /* ********************************* */
 /*          OBJECT MANAGEMENT        */
 /* ********************************* */
@@ -2295,6 +3356,29 @@ TILEDB_EXPORT int tiledb_kv_schema_free(
 TILEDB_EXPORT int tiledb_kv_schema_add_attribute(
     tiledb_ctx_t* ctx, tiledb_kv_schema_t* kv_schema, tiledb_attribute_t* attr);
 
+/**
+ * Sets the hash function the key-value store uses to map keys to
+ * coordinates. The keys are hashed only for placement - there is no
+ * security requirement - so a non-cryptographic hash such as
+ * `TILEDB_KV_HASH_MURMUR3` is considerably faster than the default
+ * `TILEDB_KV_HASH_MD5` upon ingestion. The choice is stored in the
+ * key-value schema upon creation and cannot change afterwards; existing
+ * stores keep using the hash function they were created with.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_kv_schema_set_hash_function(ctx, kv_schema, TILEDB_KV_HASH_MURMUR3);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param kv_schema The key-value schema.
+ * @param hash The hash function to be set.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_kv_schema_set_hash_function(
+    tiledb_ctx_t* ctx, tiledb_kv_schema_t* kv_schema, tiledb_kv_hash_t hash);
+
 /**
  * Checks the correctness of the key-value schema.
  *
@@ -2684,6 +3768,58 @@ TILEDB_EXPORT int tiledb_kv_close(tiledb_ctx_t* ctx, tiledb_kv_t** kv);
 TILEDB_EXPORT int tiledb_kv_add_item(
     tiledb_ctx_t* ctx, tiledb_kv_t* kv, tiledb_kv_item_t* kv_item);
 
+/**
+ * Adds multiple key-value items to a key-value store in a single call.
+ * The items are given in columnar form, i.e., one buffer per attribute
+ * holding the values of all items contiguously. This bypasses the
+ * per-item `tiledb_kv_item_t` object construction of
+ * `tiledb_kv_add_item` and, hence, is much more efficient for bulk
+ * ingestion. Note that, unlike `tiledb_kv_add_item`, the added items
+ * become visible to `tiledb_kv_get_item` only after they are flushed.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * // Two string keys, "key_1" and "key_2", and one int32 attribute
+ * const char keys[] = "key_1key_2";
+ * uint64_t key_offsets[] = {0, 5};
+ * int key_values[] = {1, 2};
+ * const void* values[] = {key_values};
+ * uint64_t value_sizes[] = {sizeof(key_values)};
+ * tiledb_kv_add_items(
+ *     ctx, kv, 2, keys, key_offsets, 10, TILEDB_CHAR,
+ *     values, value_sizes, NULL);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param kv The key-value store.
+ * @param item_num The number of items to be added.
+ * @param keys Buffer holding the keys of all items contiguously.
+ * @param key_offsets The starting offset of each key in `keys`.
+ * @param keys_size The size (in bytes) of `keys`.
+ * @param key_type The type of the keys (common across the batch).
+ * @param values One buffer per attribute (in the order the attributes
+ *     were specified upon opening the key-value store), holding the
+ *     values of all items contiguously.
+ * @param value_sizes The size (in bytes) of each buffer in `values`.
+ * @param value_offsets For each variable-sized attribute, the starting
+ *     offset of each item's value in the corresponding `values` buffer.
+ *     The entries for fixed-sized attributes are ignored. If all
+ *     attributes are fixed-sized, `NULL` may be passed.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_kv_add_items(
+    tiledb_ctx_t* ctx,
+    tiledb_kv_t* kv,
+    uint64_t item_num,
+    const void* keys,
+    const uint64_t* key_offsets,
+    uint64_t keys_size,
+    tiledb_datatype_t key_type,
+    const void** values,
+    const uint64_t* value_sizes,
+    const uint64_t* const* value_offsets);
+
 /**
  * Flushes the buffered items to persistent storage.
  *
@@ -2727,6 +3863,43 @@ TILEDB_EXPORT int tiledb_kv_get_item(
     tiledb_datatype_t key_type,
     uint64_t key_size);
 
+/**
+ * Retrieves a batch of key-value items based on the input keys. Unlike
+ * calling `tiledb_kv_get_item` in a loop, which runs one read query per
+ * key, the keys in the batch are resolved with a single read query that
+ * fetches each overlapping tile once, even if multiple keys hash into
+ * it. The entry for a key that does not exist in the store is set to
+ * `NULL`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_kv_item_t* kv_items[2];
+ * const void* keys[] = {"key_1", "key_2"};
+ * tiledb_datatype_t key_types[] = {TILEDB_CHAR, TILEDB_CHAR};
+ * uint64_t key_sizes[] = {5, 5};
+ * tiledb_kv_get_items(ctx, kv, kv_items, 2, keys, key_types, key_sizes);
+ * // Make sure to delete the retrieved kv items in the end
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param kv The key-value store.
+ * @param kv_items The retrieved key-value items, one per key.
+ * @param item_num The number of items to retrieve.
+ * @param keys The keys, one per item.
+ * @param key_types The types of the keys.
+ * @param key_sizes The sizes (in bytes) of the keys.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_kv_get_items(
+    tiledb_ctx_t* ctx,
+    tiledb_kv_t* kv,
+    tiledb_kv_item_t** kv_items,
+    uint64_t item_num,
+    const void** keys,
+    const tiledb_datatype_t* key_types,
+    const uint64_t* key_sizes);
+
 /* ****************************** */
 /*          KEY-VALUE ITER        */
 /* ****************************** */
@@ -3376,6 +4549,91 @@ TILEDB_EXPORT int tiledb_stats_reset();
  */
 TILEDB_EXPORT int tiledb_stats_dump(FILE* out);
 
+/**
+ * Dump all internal statistics counters to an allocated JSON string with
+ * a stable schema, suitable for machine consumption. The caller must free
+ * the string with `tiledb_stats_free_str`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * char* json;
+ * tiledb_stats_dump_json(&json);
+ * // ... ship `json` off to the telemetry pipeline ...
+ * tiledb_stats_free_str(&json);
+ * @endcode
+ *
+ * @param out Set to a newly allocated, null-terminated JSON string.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_stats_dump_json(char** out);
+
+/**
+ * Frees a string allocated by `tiledb_stats_dump_json`, setting the input
+ * pointer to `NULL`.
+ *
+ * @param str The string to free.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_stats_free_str(char** str);
+
+/**
+ * Retrieves the current value of a single internal statistics counter.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t read_bytes;
+ * tiledb_stats_get_counter("vfs_read_total_bytes", &read_bytes);
+ * @endcode
+ *
+ * @param name The counter name, as reported by `tiledb_stats_dump`.
+ * @param value Set to the counter value.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` if no counter with the
+ *     input name exists.
+ */
+TILEDB_EXPORT int tiledb_stats_get_counter(const char* name, uint64_t* value);
+
+/* ****************************** */
+/*             Trace              */
+/* ****************************** */
+
+/**
+ * Enable internal tracing. While tracing is enabled, begin/end span events
+ * are recorded for the phases of query execution, tile I/O and VFS backend
+ * calls into a fixed-capacity ring buffer (the oldest events are
+ * overwritten when the buffer fills up).
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_trace_enable();
+
+/**
+ * Disable internal tracing.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_trace_disable();
+
+/**
+ * Discard all recorded trace events.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_trace_reset();
+
+/**
+ * Dump the recorded trace events to some output (e.g., file or stdout) in
+ * the Chrome trace-event JSON format. The output can be loaded into
+ * `chrome://tracing` to view a per-thread timeline of the traced code
+ * sections. This should be invoked after the operations under
+ * investigation have completed.
+ *
+ * @param out The output.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int tiledb_trace_dump(FILE* out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,8 @@
     TILEDB_FILESYSTEM_ENUM(HDFS),
     /** S3 filesystem */
     TILEDB_FILESYSTEM_ENUM(S3),
+    /** In-memory filesystem */
+    TILEDB_FILESYSTEM_ENUM(MEMFS),
 #endif
 
 #ifdef TILEDB_DATATYPE_ENUM
@@ -106,6 +108,8 @@
     TILEDB_LAYOUT_ENUM(GLOBAL_ORDER),
     /** Unordered layout */
     TILEDB_LAYOUT_ENUM(UNORDERED),
+    /** Morton (Z-order) layout */
+    TILEDB_LAYOUT_ENUM(MORTON),
 #endif
 
 #ifdef TILEDB_COMPRESSOR_ENUM
@@ -153,6 +157,30 @@
     TILEDB_QUERY_STATUS_ENUM(INCOMPLETE) = 2,
 #endif
 
+#ifdef TILEDB_PREDICATE_OP_ENUM
+    /** Less-than comparison */
+    TILEDB_PREDICATE_OP_ENUM(LT),
+    /** Less-than-or-equal comparison */
+    TILEDB_PREDICATE_OP_ENUM(LE),
+    /** Greater-than comparison */
+    TILEDB_PREDICATE_OP_ENUM(GT),
+    /** Greater-than-or-equal comparison */
+    TILEDB_PREDICATE_OP_ENUM(GE),
+    /** Equality comparison */
+    TILEDB_PREDICATE_OP_ENUM(EQ),
+    /** Inequality comparison */
+    TILEDB_PREDICATE_OP_ENUM(NE),
+#endif
+
+#ifdef TILEDB_CACHE_HINT_ENUM
+    /** Default caching behavior */
+    TILEDB_CACHE_HINT_ENUM(CACHE_DEFAULT) = 0,
+    /** Streaming/one-shot read; its tiles are not inserted into the cache */
+    TILEDB_CACHE_HINT_ENUM(CACHE_BYPASS) = 1,
+    /** Latency-critical read; its tiles resist eviction by one-shot reads */
+    TILEDB_CACHE_HINT_ENUM(CACHE_PIN) = 2,
+#endif
+
 #ifdef TILEDB_WALK_ORDER_ENUM
     /** Pre-order traversal */
     TILEDB_WALK_ORDER_ENUM(PREORDER),
@@ -169,3 +197,10 @@
     /** Append mode */
     TILEDB_VFS_MODE_ENUM(VFS_APPEND),
 #endif
+
+#ifdef TILEDB_KV_HASH_ENUM
+    /** MD5 hash (the default) */
+    TILEDB_KV_HASH_ENUM(MD5),
+    /** MurmurHash3 (x64, 128-bit) non-cryptographic hash */
+    TILEDB_KV_HASH_ENUM(MURMUR3),
+#endif
@@ -28,4 +28,4 @@
 
 #define TILEDB_VERSION_MAJOR 1
 #define TILEDB_VERSION_MINOR 3
-#define TILEDB_VERSION_PATCH 0
+#define TILEDB_VERSION_PATCH 1
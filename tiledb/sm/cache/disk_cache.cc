@@ -0,0 +1,379 @@
+/**
+ * @file   disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class DiskCache.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#include "tiledb/sm/cache/disk_cache.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+
+#ifdef _WIN32
+#include "tiledb/sm/filesystem/win_filesystem.h"
+#else
+#include "tiledb/sm/filesystem/posix_filesystem.h"
+#endif
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+DiskCache::DiskCache(const std::string& dir, uint64_t max_size)
+    : dir_(dir)
+    , max_size_(max_size)
+    , size_(0)
+    , queued_bytes_(0)
+    , done_(false) {
+}
+
+DiskCache::~DiskCache() {
+  {
+    std::lock_guard<std::mutex> lck(queue_mtx_);
+    done_ = true;
+  }
+  queue_cv_.notify_all();
+  if (writer_thread_.joinable())
+    writer_thread_.join();
+}
+
+/* ****************************** */
+/*              API               */
+/* ****************************** */
+
+Status DiskCache::init() {
+#ifdef _WIN32
+  if (!win::is_dir(dir_))
+    RETURN_NOT_OK(win::create_dir(dir_));
+  std::vector<std::string> paths;
+  RETURN_NOT_OK(win::ls(dir_, &paths));
+#else
+  if (!posix::is_dir(dir_))
+    RETURN_NOT_OK(posix::create_dir(dir_));
+  std::vector<std::string> paths;
+  RETURN_NOT_OK(posix::ls(dir_, &paths));
+#endif
+
+  // Re-populate the index from the entries of a previous run, dropping
+  // the files that are not well-formed cache entries (e.g. partially
+  // written ones)
+  for (const auto& path : paths) {
+    std::string key;
+    uint64_t size;
+    if (!read_header(path, &key, &size).ok() ||
+        entry_map_.find(key) != entry_map_.end()) {
+#ifdef _WIN32
+      win::remove_file(path);
+#else
+      posix::remove_file(path);
+#endif
+      continue;
+    }
+    entries_.push_back({key, path, size});
+    entry_map_[key] = std::prev(entries_.end());
+    size_ += size;
+  }
+  evict(0);
+
+  writer_thread_ = std::thread(&DiskCache::writer_loop, this);
+
+  return Status::Ok();
+}
+
+Status DiskCache::read(
+    const std::string& key, void* buffer, uint64_t nbytes, bool* in_cache) {
+  *in_cache = false;
+
+  // Look up the entry, releasing the lock around the file read
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    auto it = entry_map_.find(key);
+    if (it == entry_map_.end() || it->second->size_ != nbytes)
+      return Status::Ok();
+    path = it->second->path_;
+  }
+
+  // Read and validate the entry; upon any failure, drop it and report
+  // a miss
+  std::string stored_key;
+  uint64_t stored_size;
+  bool ok = read_header(path, &stored_key, &stored_size).ok() &&
+            stored_key == key && stored_size == nbytes;
+  if (ok) {
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(2 * sizeof(uint64_t) + key.size());
+    file.read(static_cast<char*>(buffer), nbytes);
+    ok = file.good();
+  }
+
+  std::lock_guard<std::mutex> lck(mtx_);
+  auto it = entry_map_.find(key);
+  if (!ok) {
+    if (it != entry_map_.end()) {
+      size_ -= it->second->size_;
+      entries_.erase(it->second);
+      entry_map_.erase(it);
+    }
+#ifdef _WIN32
+    win::remove_file(path);
+#else
+    posix::remove_file(path);
+#endif
+    return Status::Ok();
+  }
+
+  // Move the entry to the back of the LRU list
+  if (it != entry_map_.end())
+    entries_.splice(entries_.end(), entries_, it->second);
+  *in_cache = true;
+
+  return Status::Ok();
+}
+
+Status DiskCache::read(
+    const std::string& key, void** object, uint64_t* nbytes, bool* in_cache) {
+  *in_cache = false;
+
+  // Look up the entry, releasing the lock around the file read
+  std::string path;
+  uint64_t size;
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    auto it = entry_map_.find(key);
+    if (it == entry_map_.end())
+      return Status::Ok();
+    path = it->second->path_;
+    size = it->second->size_;
+  }
+
+  // Read and validate the entry
+  std::string stored_key;
+  uint64_t stored_size;
+  bool ok = read_header(path, &stored_key, &stored_size).ok() &&
+            stored_key == key && stored_size == size;
+  void* data = nullptr;
+  if (ok) {
+    // An allocation failure is a plain miss; the entry stays intact
+    data = std::malloc(size);
+    if (data == nullptr)
+      return Status::Ok();
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(2 * sizeof(uint64_t) + key.size());
+    file.read(static_cast<char*>(data), size);
+    ok = file.good();
+    if (!ok) {
+      std::free(data);
+      data = nullptr;
+    }
+  }
+
+  // Upon any failure, drop the entry and report a miss
+  std::lock_guard<std::mutex> lck(mtx_);
+  auto it = entry_map_.find(key);
+  if (!ok) {
+    if (it != entry_map_.end()) {
+      size_ -= it->second->size_;
+      entries_.erase(it->second);
+      entry_map_.erase(it);
+    }
+#ifdef _WIN32
+    win::remove_file(path);
+#else
+    posix::remove_file(path);
+#endif
+    return Status::Ok();
+  }
+
+  // Move the entry to the back of the LRU list
+  if (it != entry_map_.end())
+    entries_.splice(entries_.end(), entries_, it->second);
+  *object = data;
+  *nbytes = size;
+  *in_cache = true;
+
+  return Status::Ok();
+}
+
+Status DiskCache::insert(
+    const std::string& key, const void* object, uint64_t size) {
+  if (size == 0 || size > max_size_)
+    return Status::Ok();
+
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (entry_map_.find(key) != entry_map_.end())
+      return Status::Ok();
+  }
+
+  // Copy the object into the writer queue, dropping the insertion if
+  // the queue is full
+  {
+    std::lock_guard<std::mutex> lck(queue_mtx_);
+    if (queued_bytes_ + size > constants::disk_cache_max_queued_bytes)
+      return Status::Ok();
+    queue_.emplace_back();
+    queue_.back().key_ = key;
+    queue_.back().data_.resize(size);
+    std::memcpy(queue_.back().data_.data(), object, size);
+    queued_bytes_ += size;
+  }
+  queue_cv_.notify_one();
+
+  return Status::Ok();
+}
+
+uint64_t DiskCache::max_size() const {
+  return max_size_;
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+void DiskCache::writer_loop() {
+  for (;;) {
+    PendingWrite write;
+    {
+      std::unique_lock<std::mutex> lck(queue_mtx_);
+      queue_cv_.wait(lck, [this]() { return !queue_.empty() || done_; });
+      if (queue_.empty())
+        return;
+      write = std::move(queue_.front());
+      queue_.pop_front();
+      queued_bytes_ -= write.data_.size();
+    }
+
+    // A failed cache write only loses caching of this object
+    Status st = write_entry(write);
+    (void)st;
+  }
+}
+
+Status DiskCache::write_entry(const PendingWrite& write) {
+  auto path = path_for(write.key_);
+
+  // Upon a key hash collision the entry of the colliding key wins;
+  // skip the insertion instead of invalidating it
+#ifdef _WIN32
+  bool exists = win::is_file(path);
+#else
+  bool exists = posix::is_file(path);
+#endif
+  if (exists)
+    return Status::Ok();
+
+  uint64_t key_size = write.key_.size();
+  uint64_t data_size = write.data_.size();
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(&key_size), sizeof(uint64_t));
+  file.write(reinterpret_cast<const char*>(&data_size), sizeof(uint64_t));
+  file.write(write.key_.data(), key_size);
+  file.write(write.data_.data(), data_size);
+  file.close();
+  if (!file.good()) {
+#ifdef _WIN32
+    win::remove_file(path);
+#else
+    posix::remove_file(path);
+#endif
+    return LOG_STATUS(Status::DiskCacheError(
+        "Cannot write disk cache entry; File write failed"));
+  }
+
+  std::lock_guard<std::mutex> lck(mtx_);
+  if (entry_map_.find(write.key_) != entry_map_.end())
+    return Status::Ok();
+  evict(data_size);
+  entries_.push_back({write.key_, path, data_size});
+  entry_map_[write.key_] = std::prev(entries_.end());
+  size_ += data_size;
+
+  return Status::Ok();
+}
+
+Status DiskCache::read_header(
+    const std::string& path, std::string* key, uint64_t* size) const {
+  uint64_t file_size;
+#ifdef _WIN32
+  RETURN_NOT_OK(win::file_size(path, &file_size));
+#else
+  RETURN_NOT_OK(posix::file_size(path, &file_size));
+#endif
+
+  uint64_t key_size = 0, data_size = 0;
+  std::ifstream file(path, std::ios::binary);
+  file.read(reinterpret_cast<char*>(&key_size), sizeof(uint64_t));
+  file.read(reinterpret_cast<char*>(&data_size), sizeof(uint64_t));
+  if (!file.good() ||
+      file_size != 2 * sizeof(uint64_t) + key_size + data_size)
+    return Status::DiskCacheError(
+        "Cannot read disk cache entry header; Malformed entry");
+
+  key->resize(key_size);
+  file.read(&(*key)[0], key_size);
+  if (!file.good())
+    return Status::DiskCacheError(
+        "Cannot read disk cache entry header; Malformed entry");
+  *size = data_size;
+
+  return Status::Ok();
+}
+
+std::string DiskCache::path_for(const std::string& key) const {
+  std::stringstream path;
+  path << dir_ << "/" << std::hex << std::hash<std::string>()(key) << "-"
+       << key.size() << ".tdbc";
+  return path.str();
+}
+
+void DiskCache::evict(uint64_t nbytes) {
+  while (size_ + nbytes > max_size_ && !entries_.empty()) {
+    auto& entry = entries_.front();
+#ifdef _WIN32
+    win::remove_file(entry.path_);
+#else
+    posix::remove_file(entry.path_);
+#endif
+    size_ -= entry.size_;
+    entry_map_.erase(entry.key_);
+    entries_.pop_front();
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,242 @@
+/**
+ * @file   disk_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DiskCache.
+ */
+
+#ifndef TILEDB_DISK_CACHE_H
+#define TILEDB_DISK_CACHE_H
+
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A persistent second-tier cache of opaque objects (compressed tiles)
+ * stored as files in a local directory, keyed like the in-memory tile
+ * cache. Its purpose is to serve repeated reads of remote (e.g. S3)
+ * arrays from local disk, whose capacity far exceeds the in-memory
+ * cache.
+ *
+ * Each object is stored in its own file, prefixed by a small header
+ * recording the key and object size, which is validated upon reading
+ * (guarding against hash collisions and partially written entries).
+ * Insertions are copied into a bounded queue and written by a
+ * background thread, so that the read path never blocks on cache
+ * writes; when the queue is full, new insertions are dropped. The cache
+ * evicts entries in LRU order once the configured capacity is exceeded,
+ * and re-populates its index from the existing files upon
+ * initialization, so it persists across process restarts.
+ *
+ * This class is thread-safe.
+ */
+class DiskCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param dir The local directory that holds the cached files.
+   * @param max_size The maximum total size (in bytes) of the cached
+   *     objects.
+   */
+  DiskCache(const std::string& dir, uint64_t max_size);
+
+  /** Destructor. Stops the background writer after draining its queue. */
+  ~DiskCache();
+
+  DiskCache(const DiskCache&) = delete;
+  DiskCache& operator=(const DiskCache&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the cache. It creates the cache directory if it does
+   * not exist, builds the index from the entries already on disk, and
+   * starts the background writer thread.
+   *
+   * @return Status
+   */
+  Status init();
+
+  /**
+   * Reads an entire cached object into the input buffer.
+   *
+   * @param key The key of the object to be read.
+   * @param buffer The buffer into which the object will be copied.
+   * @param nbytes The expected object size; a cached object of a
+   *     different size is treated as a miss.
+   * @param in_cache Set to `true` upon a hit and `false` upon a miss.
+   * @return Status
+   */
+  Status read(
+      const std::string& key, void* buffer, uint64_t nbytes, bool* in_cache);
+
+  /**
+   * Reads an entire cached object into a newly allocated buffer, for
+   * callers that do not know the object size up front. Upon a hit, the
+   * caller takes ownership of `*object` (allocated with `std::malloc`).
+   *
+   * @param key The key of the object to be read.
+   * @param object Set to the allocated object bytes upon a hit.
+   * @param nbytes Set to the object size upon a hit.
+   * @param in_cache Set to `true` upon a hit and `false` upon a miss.
+   * @return Status
+   */
+  Status read(
+      const std::string& key, void** object, uint64_t* nbytes, bool* in_cache);
+
+  /**
+   * Queues an object for insertion into the cache. The object bytes are
+   * copied, so the caller retains ownership of `object`. The insertion
+   * is a no-op if the object is already cached, exceeds the cache
+   * capacity, or the writer queue is full.
+   *
+   * @param key The key of the object to be inserted.
+   * @param object The object bytes.
+   * @param size The object size.
+   * @return Status
+   */
+  Status insert(const std::string& key, const void* object, uint64_t size);
+
+  /** Returns the maximum cache size. */
+  uint64_t max_size() const;
+
+ private:
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** An index entry of a cached file. */
+  struct Entry {
+    /** The object key. */
+    std::string key_;
+    /** The file that stores the object. */
+    std::string path_;
+    /** The object size (excluding the file header). */
+    uint64_t size_;
+  };
+
+  /** A queued insertion to be performed by the background writer. */
+  struct PendingWrite {
+    /** The object key. */
+    std::string key_;
+    /** The copied object bytes. */
+    std::vector<char> data_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The cache directory. */
+  std::string dir_;
+
+  /** The maximum total size of the cached objects. */
+  uint64_t max_size_;
+
+  /** The current total size of the cached objects. */
+  uint64_t size_;
+
+  /**
+   * The cached entries in LRU order; the entry at the head of the list
+   * is evicted first.
+   */
+  std::list<Entry> entries_;
+
+  /** Maps keys to entries for constant-time lookups. */
+  std::map<std::string, std::list<Entry>::iterator> entry_map_;
+
+  /** Protects the index (`entries_`, `entry_map_`, `size_`). */
+  std::mutex mtx_;
+
+  /** The queued insertions. */
+  std::list<PendingWrite> queue_;
+
+  /** The total size of the queued insertions. */
+  uint64_t queued_bytes_;
+
+  /** `true` when the background writer must terminate. */
+  bool done_;
+
+  /** Protects the writer queue. */
+  std::mutex queue_mtx_;
+
+  /** Signals the background writer upon new insertions. */
+  std::condition_variable queue_cv_;
+
+  /** The background writer thread. */
+  std::thread writer_thread_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** The background writer main loop. */
+  void writer_loop();
+
+  /**
+   * Writes a queued object to its cache file and indexes it, evicting
+   * LRU entries if the capacity is exceeded.
+   */
+  Status write_entry(const PendingWrite& write);
+
+  /**
+   * Reads the key header of the cache file at `path`, retrieving also
+   * the stored object size. Errors out if the file is not a complete,
+   * well-formed cache entry.
+   */
+  Status read_header(
+      const std::string& path, std::string* key, uint64_t* size) const;
+
+  /** Returns the cache file path that stores the input key. */
+  std::string path_for(const std::string& key) const;
+
+  /** Evicts LRU entries until `nbytes` more fit in the capacity. */
+  void evict(uint64_t nbytes);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DISK_CACHE_H
@@ -0,0 +1,131 @@
+/**
+ * @file   exists_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ExistsCache.
+ */
+
+#include "tiledb/sm/cache/exists_cache.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+ExistsCache::ExistsCache(uint64_t max_size, uint64_t ttl_ms) {
+  max_size_ = max_size;
+  ttl_ = std::chrono::milliseconds(ttl_ms);
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void ExistsCache::clear() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  entries_.clear();
+  fifo_.clear();
+}
+
+bool ExistsCache::get(const std::string& key, bool* exists) {
+  if (ttl_.count() == 0)
+    return false;
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return false;
+
+  // An expired entry is treated as a miss and removed
+  if (std::chrono::steady_clock::now() >= it->second.expires_) {
+    fifo_.erase(it->second.fifo_it_);
+    entries_.erase(it);
+    return false;
+  }
+
+  *exists = it->second.exists_;
+  return true;
+}
+
+void ExistsCache::invalidate(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    fifo_.erase(it->second.fifo_it_);
+    entries_.erase(it);
+  }
+}
+
+void ExistsCache::invalidate_prefix(const std::string& prefix) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = entries_.lower_bound(prefix);
+  while (it != entries_.end() &&
+         it->first.compare(0, prefix.size(), prefix) == 0) {
+    fifo_.erase(it->second.fifo_it_);
+    it = entries_.erase(it);
+  }
+}
+
+void ExistsCache::put(const std::string& key, bool exists) {
+  if (ttl_.count() == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto expires = std::chrono::steady_clock::now() + ttl_;
+
+  // Refresh the entry if it already exists
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second.exists_ = exists;
+    it->second.expires_ = expires;
+    return;
+  }
+
+  // Evict the oldest insertion if the cache is full
+  if (entries_.size() >= max_size_ && !fifo_.empty()) {
+    entries_.erase(fifo_.front());
+    fifo_.pop_front();
+  }
+
+  fifo_.push_back(key);
+  Entry entry;
+  entry.exists_ = exists;
+  entry.expires_ = expires;
+  entry.fifo_it_ = --fifo_.end();
+  entries_[key] = entry;
+}
+
+uint64_t ExistsCache::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return entries_.size();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,136 @@
+/**
+ * @file   exists_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ExistsCache.
+ */
+
+#ifndef TILEDB_EXISTS_CACHE_H
+#define TILEDB_EXISTS_CACHE_H
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Caches the results of existence checks (both positive and negative),
+ * so that repeated checks of the same path avoid redundant round-trips
+ * to remote backends. Entries expire after a time-to-live, and the cache
+ * holds a bounded number of entries, evicting the oldest insertion when
+ * it is full.
+ */
+class ExistsCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum number of cached entries.
+   * @param ttl_ms The time after which an entry expires, in milliseconds.
+   *     A value of 0 disables the cache.
+   */
+  ExistsCache(uint64_t max_size, uint64_t ttl_ms);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Removes all cached entries. */
+  void clear();
+
+  /**
+   * Retrieves a cached existence result.
+   *
+   * @param key The key of the checked path.
+   * @param exists Set to the cached result upon a cache hit.
+   * @return `true` if there is an unexpired entry for the key.
+   */
+  bool get(const std::string& key, bool* exists);
+
+  /** Removes the entry for the input key (if any). */
+  void invalidate(const std::string& key);
+
+  /** Removes all entries whose key starts with the input prefix. */
+  void invalidate_prefix(const std::string& prefix);
+
+  /** Caches an existence result for the input key. */
+  void put(const std::string& key, bool exists);
+
+  /** Returns the number of cached entries. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** A cached existence result. */
+  struct Entry {
+    /** The cached result. */
+    bool exists_;
+
+    /** The time point upon which the entry expires. */
+    std::chrono::steady_clock::time_point expires_;
+
+    /** The position of the key in the insertion-order list. */
+    std::list<std::string>::iterator fifo_it_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The cached entries, keyed on the checked path. */
+  std::map<std::string, Entry> entries_;
+
+  /** The keys in insertion order, used for eviction when full. */
+  std::list<std::string> fifo_;
+
+  /** The maximum number of cached entries. */
+  uint64_t max_size_;
+
+  /** Protects the cache structures. */
+  mutable std::mutex mtx_;
+
+  /** The entry time-to-live. */
+  std::chrono::milliseconds ttl_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_EXISTS_CACHE_H
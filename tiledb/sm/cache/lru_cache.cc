@@ -33,6 +33,7 @@
 #include "tiledb/sm/cache/lru_cache.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
@@ -40,6 +41,20 @@
 namespace tiledb {
 namespace sm {
 
+/* ****************************** */
+/*            CACHE KEY           */
+/* ****************************** */
+
+uint64_t CacheKey::hash() const {
+  // Combine the two words and finalize with an avalanche mix, so that
+  // keys differing only in a few offset bits spread over the full range
+  uint64_t h = uri_id_ + 0x9e3779b97f4a7c15ULL * offset_;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -52,6 +67,9 @@ LRUCache::LRUCache(
   evict_callback_data_ = evict_callback_data;
   max_size_ = max_size;
   size_ = 0;
+  prot_begin_ = item_ll_.end();
+  prot_size_ = 0;
+  prot_max_size_ = max_size - max_size / 5;
 }
 
 LRUCache::~LRUCache() {
@@ -64,16 +82,22 @@ LRUCache::~LRUCache() {
 
 void LRUCache::clear() {
   for (auto& item : item_ll_) {
-    if (evict_callback_ == nullptr)
-      std::free(item.object_);
-    else
+    if (evict_callback_ != nullptr)
       (*evict_callback_)(&item, evict_callback_data_);
   }
   item_ll_.clear();
+  item_map_.clear();
+  size_ = 0;
+  prot_begin_ = item_ll_.end();
+  prot_size_ = 0;
 }
 
 Status LRUCache::insert(
-    const std::string& key, void* object, uint64_t size, bool overwrite) {
+    const CacheKey& key,
+    void* object,
+    uint64_t size,
+    bool overwrite,
+    bool pin) {
   // Do nothing if the object size is bigger than the cache maximum size
   if (size > max_size_)
     return Status::Ok();
@@ -85,6 +109,9 @@ Status LRUCache::insert(
   // Lock mutex
   mtx_.lock();
 
+  // An insertion counts as an access of the key
+  sketch_.record(key);
+
   auto item_it = item_map_.find(key);
   bool exists = item_it != item_map_.end();
 
@@ -94,42 +121,71 @@ Status LRUCache::insert(
     return Status::Ok();
   }
 
-  // Evict if necessary
-  while (size_ + size > max_size_)
-    evict();
-
-  // Key exists
   if (exists) {
-    // Replace cache item
-    auto& node = item_it->second;
-    auto& item = *node;
-    if (evict_callback_ == nullptr)
-      std::free(item.object_);
-    else
-      (*evict_callback_)(&item, evict_callback_data_);
-    item.object_ = object;
-    item.size_ = size;
-
-    // Move cache item node to the end of the list
-    if (std::next(node) != item_ll_.end()) {
-      item_ll_.splice(item_ll_.end(), item_ll_, node, std::next(node));
+    // Remove the replaced item; overwriting a resident key bypasses the
+    // admission policy below
+    auto node = item_it->second;
+    if (evict_callback_ != nullptr)
+      (*evict_callback_)(&(*node), evict_callback_data_);
+    size_ -= node->size_;
+    if (node->protected_) {
+      prot_size_ -= node->size_;
+      if (node == prot_begin_)
+        prot_begin_ = std::next(node);
+    }
+    item_map_.erase(item_it);
+    item_ll_.erase(node);
+
+    // Evict if necessary
+    while (size_ + size > max_size_)
+      evict();
+  } else {
+    // Admission policy: a new key must have been accessed more frequently
+    // than each eviction victim, so that the objects of a one-shot scan
+    // cannot displace frequently accessed ones. Pinned insertions bypass
+    // the policy.
+    while (size_ + size > max_size_) {
+      auto victim = item_ll_.begin();
+      if (!pin && sketch_.estimate(key) <= sketch_.estimate(victim->key_)) {
+        // Decline admission and delete the object
+        if (evict_callback_ == nullptr) {
+          std::free(object);
+        } else {
+          LRUCacheItem item;
+          item.key_ = key;
+          item.object_ = std::shared_ptr<void>(object, [](void*) {});
+          item.size_ = size;
+          (*evict_callback_)(&item, evict_callback_data_);
+        }
+        mtx_.unlock();
+        return Status::Ok();
+      }
+      evict();
     }
-  } else {  // Key does not exist
-    // Create a new cache item
-    LRUCacheItem new_item;
-    new_item.key_ = key;
-    new_item.object_ = object;
-    new_item.size_ = size;
-
-    // Create new node in linked list
-    item_ll_.emplace_back(new_item);
-
-    // Create new element in the hash table
-    item_map_[key] = --(item_ll_.end());
   }
 
+  // Wrap the object for shared ownership. If there is an evict callback,
+  // it is responsible for reclaiming the object instead.
+  std::shared_ptr<void> object_sp;
+  if (evict_callback_ == nullptr)
+    object_sp = std::shared_ptr<void>(object, std::free);
+  else
+    object_sp = std::shared_ptr<void>(object, [](void*) {});
+
+  // Create a new cache item at the tail of the probationary segment
+  LRUCacheItem new_item;
+  new_item.key_ = key;
+  new_item.object_ = object_sp;
+  new_item.size_ = size;
+  auto node = item_ll_.insert(prot_begin_, new_item);
+  item_map_[key] = node;
   size_ += size;
 
+  // An overwrite of a resident key counts as a cache hit of the key, and
+  // a pinned insertion goes directly to the protected segment
+  if (exists || pin)
+    touch(node);
+
   // Unlock mutex
   mtx_.unlock();
 
@@ -140,10 +196,13 @@ uint64_t LRUCache::max_size() const {
   return max_size_;
 }
 
-Status LRUCache::read(const std::string& key, Buffer* buffer, bool* success) {
+Status LRUCache::read(const CacheKey& key, Buffer* buffer, bool* success) {
   // Lock mutex
   mtx_.lock();
 
+  // A read attempt counts as an access of the key
+  sketch_.record(key);
+
   // Find cached item
   auto item_it = item_map_.find(key);
   if (item_it == item_map_.end()) {
@@ -154,12 +213,10 @@ Status LRUCache::read(const std::string& key, Buffer* buffer, bool* success) {
 
   // Write item object to buffer
   auto& item = item_it->second;
-  buffer->write(item->object_, item->size_);
+  buffer->write(item->object_.get(), item->size_);
 
-  // Move cache item node to the end of the list
-  if (std::next(item) != item_ll_.end()) {
-    item_ll_.splice(item_ll_.end(), item_ll_, item, std::next(item));
-  }
+  // Handle the hit in the segmented list
+  touch(item);
 
   // Unlock mutex
   mtx_.unlock();
@@ -169,7 +226,7 @@ Status LRUCache::read(const std::string& key, Buffer* buffer, bool* success) {
 }
 
 Status LRUCache::read(
-    const std::string& key,
+    const CacheKey& key,
     void* buffer,
     uint64_t offset,
     uint64_t nbytes,
@@ -177,6 +234,9 @@ Status LRUCache::read(
   // Lock mutex
   mtx_.lock();
 
+  // A read attempt counts as an access of the key
+  sketch_.record(key);
+
   // Find cached item
   auto item_it = item_map_.find(key);
   if (item_it == item_map_.end()) {
@@ -192,13 +252,45 @@ Status LRUCache::read(
     return LOG_STATUS(
         Status::LRUCacheError("Failed to read item; Byte range out of bounds"));
   }
-  std::memcpy(buffer, (char*)item->object_ + offset, nbytes);
+  std::memcpy(buffer, (char*)item->object_.get() + offset, nbytes);
+
+  // Handle the hit in the segmented list
+  touch(item);
+
+  // Unlock mutex
+  mtx_.unlock();
+
+  *success = true;
+  return Status::Ok();
+}
+
+Status LRUCache::read_shared(
+    const CacheKey& key,
+    std::shared_ptr<void>* object,
+    uint64_t* size,
+    bool* success) {
+  // Lock mutex
+  mtx_.lock();
+
+  // A read attempt counts as an access of the key
+  sketch_.record(key);
 
-  // Move cache item node to the end of the list
-  if (std::next(item) != item_ll_.end()) {
-    item_ll_.splice(item_ll_.end(), item_ll_, item, std::next(item));
+  // Find cached item
+  auto item_it = item_map_.find(key);
+  if (item_it == item_map_.end()) {
+    mtx_.unlock();
+    *success = false;
+    return Status::Ok();
   }
 
+  // Share ownership of the item object - no copy
+  auto& item = item_it->second;
+  *object = item->object_;
+  *size = item->size_;
+
+  // Handle the hit in the segmented list
+  touch(item);
+
   // Unlock mutex
   mtx_.unlock();
 
@@ -223,15 +315,98 @@ std::list<LRUCache::LRUCacheItem>::const_iterator LRUCache::item_iter_end()
 void LRUCache::evict() {
   assert(!item_ll_.empty());
 
-  auto item = item_ll_.front();
-  if (evict_callback_ == nullptr)
-    std::free(item.object_);
-  else
-    (*evict_callback_)(&item, evict_callback_data_);
-  item_map_.erase(item.key_);
-  size_ -= item.size_;
+  // The head of the list is the least recently used probationary item, or
+  // the least recently used protected item if the probationary segment is
+  // empty
+  auto node = item_ll_.begin();
+  if (node->protected_) {
+    prot_size_ -= node->size_;
+    prot_begin_ = std::next(node);
+  }
+  if (evict_callback_ != nullptr)
+    (*evict_callback_)(&(*node), evict_callback_data_);
+  item_map_.erase(node->key_);
+  size_ -= node->size_;
   item_ll_.pop_front();
 }
 
+void LRUCache::touch(std::list<LRUCacheItem>::iterator node) {
+  if (!node->protected_) {
+    // Promote to the protected segment
+    bool first_prot = (prot_size_ == 0);
+    item_ll_.splice(item_ll_.end(), item_ll_, node);
+    node->protected_ = true;
+    prot_size_ += node->size_;
+    if (first_prot)
+      prot_begin_ = node;
+
+    // Demote the least recently used protected items back to the tail of
+    // the probationary segment if the protected segment overflowed
+    while (prot_size_ > prot_max_size_) {
+      auto demoted = prot_begin_;
+      prot_begin_ = std::next(prot_begin_);
+      demoted->protected_ = false;
+      prot_size_ -= demoted->size_;
+    }
+  } else {
+    // Move the item to the end of the protected segment
+    if (std::next(node) == item_ll_.end())
+      return;
+    bool was_begin = (node == prot_begin_);
+    auto next = std::next(node);
+    item_ll_.splice(item_ll_.end(), item_ll_, node);
+    if (was_begin)
+      prot_begin_ = next;
+  }
+}
+
+/* ****************************** */
+/*        FREQUENCY SKETCH        */
+/* ****************************** */
+
+LRUCache::FrequencySketch::FrequencySketch()
+    : counters_(row_num_ * row_size_, 0)
+    , accesses_(0) {
+}
+
+void LRUCache::FrequencySketch::record(const CacheKey& key) {
+  uint64_t idx[row_num_];
+  indexes(key, idx);
+  for (unsigned r = 0; r < row_num_; r++) {
+    auto& counter = counters_[idx[r]];
+    if (counter < counter_max_)
+      counter++;
+  }
+
+  // Age the sketch
+  if (++accesses_ >= aging_threshold_) {
+    for (auto& counter : counters_)
+      counter >>= 1;
+    accesses_ >>= 1;
+  }
+}
+
+uint64_t LRUCache::FrequencySketch::estimate(const CacheKey& key) const {
+  uint64_t idx[row_num_];
+  indexes(key, idx);
+  uint64_t min = counter_max_;
+  for (unsigned r = 0; r < row_num_; r++)
+    min = std::min<uint64_t>(min, counters_[idx[r]]);
+  return min;
+}
+
+void LRUCache::FrequencySketch::indexes(
+    const CacheKey& key, uint64_t* idx) const {
+  // Derive the per-row indexes from a single hash via double hashing
+  uint64_t h1 = key.hash();
+  uint64_t h2 = h1;
+  h2 ^= h2 >> 33;
+  h2 *= 0xff51afd7ed558ccdULL;
+  h2 ^= h2 >> 33;
+  h2 |= 1;
+  for (unsigned r = 0; r < row_num_; r++)
+    idx[r] = r * row_size_ + ((h1 + r * h2) & (row_size_ - 1));
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -38,17 +38,67 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace tiledb {
 namespace sm {
 
 /**
- * Implements an LRU cache of opaque (`void*`) objects that can be located via
- * a string key. This class is thread-safe, providing also thread-safe
- * copying of portions of the opaque objects. Note that, after inserting
- * an object into the cache, the cache **owns** the object and will delete
- * it upon eviction.
+ * The binary key of a cached object: a 64-bit identifier of the file the
+ * object came from (see `URI::id`) plus the offset of the object in that
+ * file. Objects keyed by a file alone use an offset of 0. Compared to the
+ * previously used concatenated URI strings, the key is built and compared
+ * without any allocation or string traversal on the cache hot path.
+ */
+struct CacheKey {
+  /** Constructor. */
+  CacheKey()
+      : uri_id_(0)
+      , offset_(0) {
+  }
+
+  /** Constructor. */
+  CacheKey(uint64_t uri_id, uint64_t offset)
+      : uri_id_(uri_id)
+      , offset_(offset) {
+  }
+
+  /** The identifier of the file the object came from. */
+  uint64_t uri_id_;
+
+  /** The offset of the object in the file. */
+  uint64_t offset_;
+
+  /** Returns a well-mixed 64-bit hash of the key. */
+  uint64_t hash() const;
+
+  bool operator<(const CacheKey& rhs) const {
+    if (uri_id_ != rhs.uri_id_)
+      return uri_id_ < rhs.uri_id_;
+    return offset_ < rhs.offset_;
+  }
+
+  bool operator==(const CacheKey& rhs) const {
+    return uri_id_ == rhs.uri_id_ && offset_ == rhs.offset_;
+  }
+};
+
+/**
+ * Implements a scan-resistant LRU cache of opaque (`void*`) objects that can
+ * be located via a binary key. This class is thread-safe, providing also
+ * thread-safe copying of portions of the opaque objects. Note that, after
+ * inserting an object into the cache, the cache **owns** the object and will
+ * delete it upon eviction.
+ *
+ * The cache is segmented: new objects enter a probationary segment and are
+ * promoted to a protected segment upon their first cache hit, so that the
+ * objects of a one-shot scan evict each other instead of the frequently hit
+ * ones. In addition, an approximate frequency sketch over the accessed keys
+ * (in the style of TinyLFU) gates admission; when the cache is full, a new
+ * object is admitted only if its key has been accessed more frequently than
+ * the keys of the objects it would evict.
  */
 class LRUCache {
  public:
@@ -58,11 +108,14 @@ class LRUCache {
 
   struct LRUCacheItem {
     /** The object lable. */
-    std::string key_;
-    /** The opaque object. */
-    void* object_;
+    CacheKey key_;
+    /** The opaque object, with shared ownership so that readers may
+     * reference it beyond its eviction from the cache. */
+    std::shared_ptr<void> object_;
     /** The object size. */
     uint64_t size_;
+    /** `true` if the item resides in the protected segment. */
+    bool protected_ = false;
   };
 
   /* ********************************* */
@@ -108,20 +161,28 @@ class LRUCache {
 
   /**
    * Inserts an object with a given key and size into the cache. Note that
-   * the cache *owns* the object after insertion.
+   * the cache *owns* the object after insertion. If the cache is full and
+   * the key has been accessed less frequently than the keys of the objects
+   * that would have to be evicted, admission is declined and the object is
+   * deleted without disturbing the cache contents.
    *
    * @param key The key that describes the inserted object.
    * @param object The opaque object to be stored.
    * @param size The size of the object.
    * @param overwrite If `true`, if the object exists in the cache it will be
    *     overwritten. Otherwise, the new object will be deleted.
+   * @param pin If `true`, the object bypasses the admission policy and is
+   *     inserted directly into the protected segment, so that it resists
+   *     eviction by one-shot traffic. It may still be evicted once it
+   *     becomes the least recently used item overall.
    * @return Status
    */
   Status insert(
-      const std::string& key,
+      const CacheKey& key,
       void* object,
       uint64_t size,
-      bool overwrite = true);
+      bool overwrite = true,
+      bool pin = false);
 
   /** Returns the maximum size of the cache. */
   uint64_t max_size() const;
@@ -136,7 +197,7 @@ class LRUCache {
    *     otherwise.
    * @return Status.
    */
-  Status read(const std::string& key, Buffer* buffer, bool* success);
+  Status read(const CacheKey& key, Buffer* buffer, bool* success);
 
   /**
    * Reads a portion of the object labeled by `key`.
@@ -150,13 +211,81 @@ class LRUCache {
    * @return Status.
    */
   Status read(
-      const std::string& key,
+      const CacheKey& key,
       void* buffer,
       uint64_t offset,
       uint64_t nbytes,
       bool* success);
 
+  /**
+   * Retrieves shared ownership of the cached object labeled by `key`,
+   * without copying its contents. The returned object remains valid
+   * even if it gets evicted from the cache, for as long as the caller
+   * holds the returned pointer. This must not be combined with an
+   * evict callback, as the callback may reclaim the object while
+   * shared references are still live.
+   *
+   * @param key The label of the object to be read.
+   * @param object The cached object to be retrieved.
+   * @param size The size of the cached object to be retrieved.
+   * @param success `true` if the object was found in the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read_shared(
+      const CacheKey& key,
+      std::shared_ptr<void>* object,
+      uint64_t* size,
+      bool* success);
+
  private:
+  /* ********************************* */
+  /*          PRIVATE DATATYPES        */
+  /* ********************************* */
+
+  /**
+   * A compact approximate frequency counter over the accessed keys, in the
+   * style of the TinyLFU counting sketch. Each key maps to one saturating
+   * counter per hash row and its frequency is estimated as the minimum of
+   * those counters, so that hash collisions can only over-estimate. All
+   * counters are periodically halved, so that stale history decays and the
+   * estimates track the recent access pattern.
+   */
+  class FrequencySketch {
+   public:
+    /** Constructor. */
+    FrequencySketch();
+
+    /** Records an access to `key`. */
+    void record(const CacheKey& key);
+
+    /** Returns the approximate access frequency of `key`. */
+    uint64_t estimate(const CacheKey& key) const;
+
+   private:
+    /** The number of hash rows. */
+    static const unsigned row_num_ = 4;
+
+    /** The number of counters per row (must be a power of two). */
+    static const uint64_t row_size_ = 4096;
+
+    /** The value at which a counter saturates. */
+    static const uint8_t counter_max_ = 15;
+
+    /** The number of recorded accesses after which all counters
+     * are halved. */
+    static const uint64_t aging_threshold_ = 8 * row_size_;
+
+    /** The counters of all rows, in a single contiguous array. */
+    std::vector<uint8_t> counters_;
+
+    /** The number of accesses recorded since the last halving. */
+    uint64_t accesses_;
+
+    /** Computes the counter index of `key` in each row. */
+    void indexes(const CacheKey& key, uint64_t* idx) const;
+  };
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -172,12 +301,14 @@ class LRUCache {
 
   /**
    * Doubly-connected linked list of cache items. The head of the list is the
-   * next item to be evicted.
+   * next item to be evicted. The list stores the probationary segment first
+   * and the protected segment after it, each ordered from least to most
+   * recently used.
    */
   std::list<LRUCacheItem> item_ll_;
 
   /** Maps a key label to an iterator (list node of) of `item_ll_`. */
-  std::map<std::string, std::list<LRUCacheItem>::iterator> item_map_;
+  std::map<CacheKey, std::list<LRUCacheItem>::iterator> item_map_;
 
   /** The maximum cache size. */
   uint64_t max_size_;
@@ -188,12 +319,34 @@ class LRUCache {
   /** The current cache size. */
   uint64_t size_;
 
+  /** The first item of the protected segment in `item_ll_`, or
+   * `item_ll_.end()` if the protected segment is empty. */
+  std::list<LRUCacheItem>::iterator prot_begin_;
+
+  /** The current size of the protected segment. */
+  uint64_t prot_size_;
+
+  /** The maximum size of the protected segment. */
+  uint64_t prot_max_size_;
+
+  /** The frequency sketch over the accessed keys that gates admission. */
+  FrequencySketch sketch_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
   /** Evicts the next object. */
   void evict();
+
+  /**
+   * Handles a cache hit on the input item; a probationary item is promoted
+   * to the protected segment (demoting the least recently used protected
+   * items back to the probationary segment if the protected segment
+   * overflows), whereas a protected item becomes its segment's most
+   * recently used.
+   */
+  void touch(std::list<LRUCacheItem>::iterator node);
 };
 
 }  // namespace sm
@@ -0,0 +1,115 @@
+/**
+ * @file   sharded_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ShardedLRUCache.
+ */
+
+#include "tiledb/sm/cache/sharded_lru_cache.h"
+
+#include <functional>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+ShardedLRUCache::ShardedLRUCache(uint64_t max_size, uint64_t shard_num) {
+  max_size_ = max_size;
+  if (shard_num == 0)
+    shard_num = 1;
+  auto shard_size = max_size / shard_num;
+  for (uint64_t i = 0; i < shard_num; ++i)
+    shards_.push_back(new LRUCache(shard_size));
+}
+
+ShardedLRUCache::~ShardedLRUCache() {
+  for (auto& shard : shards_)
+    delete shard;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void ShardedLRUCache::clear() {
+  for (auto& shard : shards_)
+    shard->clear();
+}
+
+Status ShardedLRUCache::insert(
+    const CacheKey& key,
+    void* object,
+    uint64_t size,
+    bool overwrite,
+    bool pin) {
+  return shard(key)->insert(key, object, size, overwrite, pin);
+}
+
+uint64_t ShardedLRUCache::max_size() const {
+  return max_size_;
+}
+
+Status ShardedLRUCache::read(
+    const CacheKey& key, Buffer* buffer, bool* success) {
+  return shard(key)->read(key, buffer, success);
+}
+
+Status ShardedLRUCache::read(
+    const CacheKey& key,
+    void* buffer,
+    uint64_t offset,
+    uint64_t nbytes,
+    bool* success) {
+  return shard(key)->read(key, buffer, offset, nbytes, success);
+}
+
+Status ShardedLRUCache::read_shared(
+    const CacheKey& key,
+    std::shared_ptr<void>* object,
+    uint64_t* size,
+    bool* success) {
+  return shard(key)->read_shared(key, object, size, success);
+}
+
+uint64_t ShardedLRUCache::shard_num() const {
+  return shards_.size();
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+LRUCache* ShardedLRUCache::shard(const CacheKey& key) const {
+  return shards_[key.hash() % shards_.size()];
+}
+
+}  // namespace sm
+}  // namespace tiledb
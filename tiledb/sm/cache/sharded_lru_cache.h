@@ -0,0 +1,173 @@
+/**
+ * @file   sharded_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ShardedLRUCache.
+ */
+
+#ifndef TILEDB_SHARDED_LRU_CACHE_H
+#define TILEDB_SHARDED_LRU_CACHE_H
+
+#include "tiledb/sm/cache/lru_cache.h"
+
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * An LRU cache that is partitioned into independently locked `LRUCache`
+ * shards, so that concurrent readers and writers of different keys do not
+ * contend on a single global mutex. A key is mapped to a shard via its
+ * hash, and each shard performs its own LRU eviction over an equal
+ * fraction of the total cache capacity.
+ */
+class ShardedLRUCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum total cache size, distributed equally
+   *     over the shards.
+   * @param shard_num The number of shards. A value of 0 is adjusted to 1.
+   */
+  ShardedLRUCache(uint64_t max_size, uint64_t shard_num);
+
+  /** Destructor. */
+  ~ShardedLRUCache();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Clears the cache, deleting all cached items in all shards. */
+  void clear();
+
+  /**
+   * Inserts an object with a given key and size into the cache. Note that
+   * the cache *owns* the object after insertion.
+   *
+   * @param key The key that describes the inserted object.
+   * @param object The opaque object to be stored.
+   * @param size The size of the object.
+   * @param overwrite If `true`, if the object exists in the cache it will be
+   *     overwritten. Otherwise, the new object will be deleted.
+   * @param pin If `true`, the object bypasses the admission policy of its
+   *     shard and is inserted directly into the protected segment (see
+   *     `LRUCache::insert`).
+   * @return Status
+   */
+  Status insert(
+      const CacheKey& key,
+      void* object,
+      uint64_t size,
+      bool overwrite = true,
+      bool pin = false);
+
+  /** Returns the maximum total size of the cache. */
+  uint64_t max_size() const;
+
+  /**
+   * Reads an entire cached object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param buffer The buffer that will store the data to be read. It will be
+   *     resized appropriately.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(const CacheKey& key, Buffer* buffer, bool* success);
+
+  /**
+   * Reads a portion of the object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param buffer The buffer that will store the data to be read.
+   * @param offset The offset where the read will start.
+   * @param nbytes The number of bytes to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(
+      const CacheKey& key,
+      void* buffer,
+      uint64_t offset,
+      uint64_t nbytes,
+      bool* success);
+
+  /**
+   * Retrieves shared ownership of the cached object labeled by `key`,
+   * without copying its contents. The returned object remains valid
+   * even if it gets evicted from the cache, for as long as the caller
+   * holds the returned pointer.
+   *
+   * @param key The label of the object to be read.
+   * @param object The cached object to be retrieved.
+   * @param size The size of the cached object to be retrieved.
+   * @param success `true` if the object was found in the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read_shared(
+      const CacheKey& key,
+      std::shared_ptr<void>* object,
+      uint64_t* size,
+      bool* success);
+
+  /** Returns the number of shards. */
+  uint64_t shard_num() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The maximum total cache size. */
+  uint64_t max_size_;
+
+  /** The cache shards, each with its own mutex and LRU eviction. */
+  std::vector<LRUCache*> shards_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the shard that stores the input key. */
+  LRUCache* shard(const CacheKey& key) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SHARDED_LRU_CACHE_H
@@ -52,7 +52,7 @@ Status Blosc::compress(
 
   // Compress
   int rc = blosc_compress_ctx(
-      level < 0 ? Blosc::default_level() : level,
+      Blosc::resolve_level(level),
       1,  // shuffle
       type_size,
       input_buffer->size(),
@@ -53,7 +53,7 @@ Status BZip::compress(
       &out_size,
       (char*)input_buffer->data(),
       in_size,
-      level < 1 ? BZip::default_level() : level,  // block size 100k
+      BZip::resolve_level(level),  // block size 100k
       0,                                          // verbosity
       0);                                         // work factor
 
@@ -35,6 +35,7 @@
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/status.h"
 
 namespace tiledb {
@@ -68,6 +69,19 @@ class BZip {
     return 1;
   }
 
+  /**
+   * Resolves the preset level values in `constants` to concrete bzip2
+   * block sizes ("fast" -> 1, "archive" -> 9); input below the valid
+   * minimum of 1 (including "balanced") maps to the default.
+   */
+  static int resolve_level(int level) {
+    if (level == constants::compression_level_archive)
+      return 9;
+    if (level < 1)  // includes the "fast" and "balanced" presets
+      return default_level();
+    return level;
+  }
+
   /** Returns the compression overhead for the given input. */
   static uint64_t overhead(uint64_t nbytes);
 };
@@ -30,6 +30,8 @@
  * This file implements the double delta compressor class.
  */
 
+#include <cstring>
+
 #include "tiledb/sm/compressors/dd_compressor.h"
 #include "tiledb/sm/misc/logger.h"
 
@@ -45,6 +47,8 @@ namespace tiledb {
 namespace sm {
 
 const uint64_t DoubleDelta::OVERHEAD = 17;
+const uint64_t DoubleDelta::BLOCK_VALUES;
+const uint8_t DoubleDelta::BLOCK_FORMAT_FLAG;
 
 /* ****************************** */
 /*               API              */
@@ -148,24 +152,43 @@ Status DoubleDelta::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
   uint64_t value_size = sizeof(T);
   uint64_t num = input_buffer->size() / value_size;
   assert(num > 0 && (input_buffer->size() % value_size == 0));
-
-  // Calculate bitsize (ignoring the sign bit)
   auto in = (T*)input_buffer->data();
-  unsigned int bitsize;
-  RETURN_NOT_OK(compute_bitsize(in, num, &bitsize));
-  assert(bitsize <= std::numeric_limits<uint8_t>::max());
-  auto bitsize_c = static_cast<uint8_t>(bitsize);
 
-  // Write bitsize and number of values
-  RETURN_NOT_OK(output_buffer->write(&bitsize_c, sizeof(uint8_t)));
-  RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
+  // Calculate the width of the zigzag-encoded double deltas. The deltas
+  // are computed with wrap-around (modulo 2^64) arithmetic, which the
+  // decompressor inverts exactly, so no input can go out of bounds.
+  unsigned int width = 1;
+  if (num > 2) {
+    uint64_t max_zz = 0;
+    uint64_t prev_delta = (uint64_t)in[1] - (uint64_t)in[0];
+    for (uint64_t i = 2; i < num; ++i) {
+      uint64_t cur_delta = (uint64_t)in[i] - (uint64_t)in[i - 1];
+      uint64_t dd = cur_delta - prev_delta;
+      max_zz |= (dd << 1) ^ (uint64_t)((int64_t)dd >> 63);
+      prev_delta = cur_delta;
+    }
+    width = 0;
+    do {
+      ++width;
+      max_zz >>= 1;
+    } while (max_zz);
+  }
 
   // Trivial case - no compression
-  if (bitsize >= sizeof(T) * 8 - 1) {
+  if (num > 2 && width >= sizeof(T) * 8) {
+    auto bitsize_c = static_cast<uint8_t>(sizeof(T) * 8 - 1);
+    RETURN_NOT_OK(output_buffer->write(&bitsize_c, sizeof(uint8_t)));
+    RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
     RETURN_NOT_OK(output_buffer->write(in, input_buffer->size()));
     return Status::Ok();
   }
 
+  // Write width (with the block format flag) and number of values
+  auto bitsize_c = static_cast<uint8_t>(
+      (num > 2) ? (width | BLOCK_FORMAT_FLAG) : 0);
+  RETURN_NOT_OK(output_buffer->write(&bitsize_c, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
+
   // Write first value
   RETURN_NOT_OK(output_buffer->write(&in[0], value_size));
   if (num == 1)
@@ -176,22 +199,29 @@ Status DoubleDelta::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
   if (num == 2)
     return Status::Ok();
 
-  // Write double deltas
-  int64_t prev_delta = int64_t(in[1]) - int64_t(in[0]);
-  int bit_in_chunk = 63;  // Leftmost bit (MSB)
-  uint64_t chunk = 0;
-  for (uint64_t i = 2; i < num; ++i) {
-    int64_t cur_delta = int64_t(in[i]) - int64_t(in[i - 1]);
-    int64_t dd = cur_delta - prev_delta;
-    RETURN_NOT_OK(
-        write_double_delta(output_buffer, dd, bitsize, &chunk, &bit_in_chunk));
-    prev_delta = cur_delta;
+  // Zigzag-encode and bit-pack the double deltas in blocks. Only the
+  // last (potentially partial) block is truncated to the words it needs.
+  uint64_t zz[BLOCK_VALUES];
+  uint64_t words[BLOCK_VALUES];
+  uint64_t prev_delta = (uint64_t)in[1] - (uint64_t)in[0];
+  uint64_t i = 2;
+  while (i < num) {
+    uint64_t block_values = MIN(BLOCK_VALUES, num - i);
+    for (uint64_t j = 0; j < block_values; ++j) {
+      uint64_t cur_delta = (uint64_t)in[i + j] - (uint64_t)in[i + j - 1];
+      uint64_t dd = cur_delta - prev_delta;
+      zz[j] = (dd << 1) ^ (uint64_t)((int64_t)dd >> 63);
+      prev_delta = cur_delta;
+    }
+    for (uint64_t j = block_values; j < BLOCK_VALUES; ++j)
+      zz[j] = 0;
+    std::memset(words, 0, width * sizeof(uint64_t));
+    pack_block(zz, width, words);
+    uint64_t word_num = (block_values * width + 63) / 64;
+    RETURN_NOT_OK(output_buffer->write(words, word_num * sizeof(uint64_t)));
+    i += block_values;
   }
 
-  // Write whatever is left in the chunk
-  if (bit_in_chunk < 63)
-    RETURN_NOT_OK(output_buffer->write(&chunk, sizeof(uint64_t)));
-
   return Status::Ok();
 }
 
@@ -238,6 +268,15 @@ Status DoubleDelta::decompress(
   uint64_t value_size = sizeof(T);
   RETURN_NOT_OK(input_buffer->read(&bitsize_c, sizeof(uint8_t)));
   RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
+
+  // Block-based format
+  if (bitsize_c & BLOCK_FORMAT_FLAG)
+    return decompress_blocks<T>(
+        (unsigned int)(bitsize_c & ~BLOCK_FORMAT_FLAG),
+        num,
+        input_buffer,
+        output_buffer);
+
   auto bitsize = static_cast<unsigned int>(bitsize_c);
   auto out = (T*)output_buffer->cur_data();
 
@@ -278,6 +317,75 @@ Status DoubleDelta::decompress(
   return Status::Ok();
 }
 
+template <class T>
+Status DoubleDelta::decompress_blocks(
+    unsigned int width,
+    uint64_t num,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
+  assert(num > 2 && width > 0 && width < sizeof(T) * 8);
+  uint64_t value_size = sizeof(T);
+
+  // Read first two values
+  T value;
+  RETURN_NOT_OK(input_buffer->read(&value, value_size));
+  RETURN_NOT_OK(output_buffer->write(&value, value_size));
+  uint64_t prev_prev = (uint64_t)value;
+  RETURN_NOT_OK(input_buffer->read(&value, value_size));
+  RETURN_NOT_OK(output_buffer->write(&value, value_size));
+  uint64_t prev = (uint64_t)value;
+
+  // Unpack the double deltas block by block and reconstruct the values
+  uint64_t zz[BLOCK_VALUES];
+  uint64_t words[BLOCK_VALUES];
+  T values[BLOCK_VALUES];
+  uint64_t prev_delta = prev - prev_prev;
+  uint64_t left = num - 2;
+  while (left > 0) {
+    uint64_t block_values = MIN(BLOCK_VALUES, left);
+    uint64_t word_num = (block_values * width + 63) / 64;
+    std::memset(words, 0, width * sizeof(uint64_t));
+    RETURN_NOT_OK(input_buffer->read(words, word_num * sizeof(uint64_t)));
+    unpack_block(words, width, zz);
+    for (uint64_t j = 0; j < block_values; ++j) {
+      uint64_t dd = (zz[j] >> 1) ^ (~(zz[j] & 1) + 1);
+      prev_delta += dd;
+      prev += prev_delta;
+      values[j] = (T)prev;
+    }
+    RETURN_NOT_OK(output_buffer->write(values, block_values * value_size));
+    left -= block_values;
+  }
+
+  return Status::Ok();
+}
+
+void DoubleDelta::pack_block(
+    const uint64_t* zz, unsigned int width, uint64_t* words) {
+  for (uint64_t j = 0; j < BLOCK_VALUES; ++j) {
+    uint64_t bit = j * width;
+    uint64_t idx = bit >> 6;
+    uint64_t off = bit & 63;
+    words[idx] |= zz[j] << off;
+    if (off + width > 64)
+      words[idx + 1] |= zz[j] >> (64 - off);
+  }
+}
+
+void DoubleDelta::unpack_block(
+    const uint64_t* words, unsigned int width, uint64_t* zz) {
+  uint64_t mask = (((uint64_t)1) << width) - 1;
+  for (uint64_t j = 0; j < BLOCK_VALUES; ++j) {
+    uint64_t bit = j * width;
+    uint64_t idx = bit >> 6;
+    uint64_t off = bit & 63;
+    uint64_t v = words[idx] >> off;
+    if (off + width > 64)
+      v |= words[idx + 1] << (64 - off);
+    zz[j] = v & mask;
+  }
+}
+
 Status DoubleDelta::read_double_delta(
     ConstBuffer* buff,
     int64_t* double_delta,
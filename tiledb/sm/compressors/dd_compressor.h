@@ -50,6 +50,15 @@ class DoubleDelta {
    */
   static const uint64_t OVERHEAD;
 
+  /** The number of values packed together in the block-based format. */
+  static const uint64_t BLOCK_VALUES = 64;
+
+  /**
+   * Flag set on the stored bitsize to denote the block-based format.
+   * The bitsize never exceeds 64, so its top bit is always free.
+   */
+  static const uint8_t BLOCK_FORMAT_FLAG = 0x80;
+
   /* ****************************** */
   /*               API              */
   /* ****************************** */
@@ -83,19 +92,22 @@ class DoubleDelta {
    *  overhead of 1 (bitsize) + 8 (n) + 8 (last, potentially almost empty chunk)
    *  bytes.
    *
+   *  When there are more than two values, the compressor emits a block-based
+   *  variant of the format (denoted by `BLOCK_FORMAT_FLAG` on the stored
+   *  bitsize): the double deltas are zigzag-encoded and bit-packed in blocks
+   *  of `BLOCK_VALUES` values, which the decompressor unpacks with simple
+   *  branchless shifts instead of the bit-serial chunk state machine. The
+   *  legacy format is still understood upon decompression.
+   *
    * @param type The type of the input values.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write to the compressed data.
    * @return Status
    *
-   * @note The function will fail with an error in two cases: (i) the output
-   *     buffer incurs a memory allocation error, and (ii) some double delta
-   *     value is out of bounds. Note that all double deltas are represented
-   *     as int64_t. Therefore, the out of bounds case occurs when adding
-   *     two huge positive numbers (e.g., INT64_MAX) resulting in a negative
-   *     value, or adding to very small negative numbers (e.g., -INT64_MAX),
-   *     resulting in a positive number. However, both these two cases are
-   *     extreme.
+   * @note The function will fail with an error if the output buffer incurs
+   *     a memory allocation error. The double deltas are computed with
+   *     wrap-around (modulo 2^64) arithmetic, which the decompressor
+   *     inverts exactly, so no input values can go out of bounds.
    */
   static Status compress(
       Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
@@ -147,6 +159,24 @@ class DoubleDelta {
   template <class T>
   static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
 
+  /**
+   * Decompression function for the block-based format.
+   *
+   * @tparam The datatype of the values.
+   * @param width The number of bits each zigzag-encoded double delta
+   *     occupies.
+   * @param num The number of values to decompress.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  template <class T>
+  static Status decompress_blocks(
+      unsigned int width,
+      uint64_t num,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
   /**
    * Reads/reconstructs a double delta value from a compressed buffer.
    *
@@ -186,6 +216,29 @@ class DoubleDelta {
       int bitsize,
       uint64_t* chunk,
       int* bit_in_chunk);
+
+  /**
+   * Packs a block of `BLOCK_VALUES` zigzag-encoded double deltas into
+   * consecutive bit-packed 64-bit words, each value occupying exactly
+   * `width` bits.
+   *
+   * @param zz The zigzag-encoded double deltas to pack.
+   * @param width The number of bits each value occupies.
+   * @param words The output words. The caller must provide (and zero)
+   *     `width` words.
+   */
+  static void pack_block(const uint64_t* zz, unsigned int width, uint64_t* words);
+
+  /**
+   * Unpacks a block of `BLOCK_VALUES` zigzag-encoded double deltas from
+   * consecutive bit-packed 64-bit words.
+   *
+   * @param words The input words.
+   * @param width The number of bits each value occupies.
+   * @param zz The output zigzag-encoded double deltas.
+   */
+  static void unpack_block(
+      const uint64_t* words, unsigned int width, uint64_t* zz);
 };
 
 }  // namespace sm
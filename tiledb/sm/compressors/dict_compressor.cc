@@ -0,0 +1,163 @@
+/**
+ * @file   dict_compressor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the dictionary encoder class.
+ *
+ * The encoded format is the following:
+ *   - Number of values (uint64_t)
+ *   - Number of dictionary entries (uint64_t)
+ *   - Total size of the dictionary entry bytes (uint64_t)
+ *   - The length of each dictionary entry (uint64_t each)
+ *   - The dictionary entry bytes, concatenated
+ *   - The per-value codes into the dictionary, each stored with the
+ *     minimum byte width that fits the number of entries
+ */
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tiledb/sm/compressors/dict_compressor.h"
+#include "tiledb/sm/misc/logger.h"
+
+namespace tiledb {
+namespace sm {
+
+Status DictEncoder::compress(
+    const uint64_t* offsets,
+    uint64_t offsets_num,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
+  // Sanity checks
+  if (input_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with dictionary encoding; null input buffer"));
+  if (offsets == nullptr || offsets_num == 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with dictionary encoding; no value offsets"));
+
+  auto data = (const char*)input_buffer->data();
+  auto nbytes = input_buffer->size();
+
+  // Build the dictionary and the per-value codes
+  std::unordered_map<std::string, uint64_t> dict;
+  std::vector<uint64_t> entry_lens;
+  std::string entry_data;
+  std::vector<uint64_t> codes(offsets_num);
+  for (uint64_t i = 0; i < offsets_num; ++i) {
+    uint64_t end = (i + 1 < offsets_num) ? offsets[i + 1] : nbytes;
+    if (offsets[i] > end || end > nbytes)
+      return LOG_STATUS(Status::CompressionError(
+          "Failed compressing with dictionary encoding; invalid offsets"));
+    std::string value(data + offsets[i], end - offsets[i]);
+    auto it = dict.find(value);
+    if (it == dict.end()) {
+      it = dict.emplace(value, dict.size()).first;
+      entry_lens.push_back(value.size());
+      entry_data += value;
+    }
+    codes[i] = it->second;
+  }
+  uint64_t dict_num = dict.size();
+  uint64_t dict_size = entry_data.size();
+  uint64_t code_nbytes = code_size(dict_num);
+
+  // Write the header and the dictionary
+  RETURN_NOT_OK(output_buffer->write(&offsets_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&dict_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&dict_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(
+      output_buffer->write(&entry_lens[0], dict_num * sizeof(uint64_t)));
+  if (dict_size > 0)
+    RETURN_NOT_OK(output_buffer->write(entry_data.data(), dict_size));
+
+  // Write the codes
+  for (uint64_t i = 0; i < offsets_num; ++i)
+    RETURN_NOT_OK(output_buffer->write(&codes[i], code_nbytes));
+
+  return Status::Ok();
+}
+
+Status DictEncoder::decompress(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // Read the header
+  uint64_t value_num, dict_num, dict_size;
+  RETURN_NOT_OK(input_buffer->read(&value_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&dict_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&dict_size, sizeof(uint64_t)));
+  if (dict_num == 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with dictionary encoding; empty dictionary"));
+
+  // Read the dictionary entry lengths and compute the entry offsets
+  std::vector<uint64_t> entry_lens(dict_num);
+  std::vector<uint64_t> entry_offsets(dict_num);
+  RETURN_NOT_OK(input_buffer->read(&entry_lens[0], dict_num * sizeof(uint64_t)));
+  uint64_t entry_offset = 0;
+  for (uint64_t i = 0; i < dict_num; ++i) {
+    entry_offsets[i] = entry_offset;
+    entry_offset += entry_lens[i];
+  }
+  if (entry_offset != dict_size)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with dictionary encoding; corrupted "
+        "dictionary"));
+  auto entry_data =
+      (const char*)input_buffer->data() + input_buffer->offset();
+  input_buffer->advance_offset(dict_size);
+
+  // Decode the values
+  uint64_t code_nbytes = code_size(dict_num);
+  for (uint64_t i = 0; i < value_num; ++i) {
+    uint64_t code = 0;
+    RETURN_NOT_OK(input_buffer->read(&code, code_nbytes));
+    if (code >= dict_num)
+      return LOG_STATUS(Status::CompressionError(
+          "Failed decompressing with dictionary encoding; invalid code"));
+    if (entry_lens[code] > 0)
+      RETURN_NOT_OK(output_buffer->write(
+          entry_data + entry_offsets[code], entry_lens[code]));
+  }
+
+  return Status::Ok();
+}
+
+uint64_t DictEncoder::code_size(uint64_t dict_num) {
+  if (dict_num <= UINT8_MAX)
+    return 1;
+  if (dict_num <= UINT16_MAX)
+    return 2;
+  if (dict_num <= UINT32_MAX)
+    return 4;
+  return 8;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,87 @@
+/**
+ * @file   dict_compressor.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the dictionary encoder class.
+ */
+
+#ifndef TILEDB_DICT_COMPRESSOR_H
+#define TILEDB_DICT_COMPRESSOR_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Handles dictionary encoding/decoding of variable-sized values.
+ * Each distinct value is stored once in a dictionary and the value
+ * sequence is replaced by fixed-width codes into the dictionary, which
+ * is very effective for low-cardinality data.
+ */
+class DictEncoder {
+ public:
+  /**
+   * Encoding function. The input values are delimited by `offsets`, where
+   * the i-th value spans `[offsets[i], offsets[i+1])` (the last value
+   * extends to the end of the input buffer). The offsets must be
+   * relative to the beginning of the input buffer.
+   *
+   * @param offsets The offsets delimiting the input values.
+   * @param offsets_num The number of offsets (i.e., of values).
+   * @param input_buffer Input buffer to read the values from.
+   * @param output_buffer Output buffer to write the encoded data to.
+   * @return Status
+   */
+  static Status compress(
+      const uint64_t* offsets,
+      uint64_t offsets_num,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
+  /**
+   * Decoding function. Reproduces the exact byte sequence of the
+   * original values.
+   *
+   * @param input_buffer Input buffer to read the encoded data from.
+   * @param output_buffer Output buffer to write the decoded values to.
+   * @return Status
+   */
+  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+ private:
+  /** Returns the code width in bytes for the given dictionary size. */
+  static uint64_t code_size(uint64_t dict_num);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DICT_COMPRESSOR_H
@@ -35,6 +35,7 @@
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/status.h"
 
 #include <cmath>
@@ -72,6 +73,21 @@ class GZip {
   static int default_level() {
     return -1;
   }
+
+  /**
+   * Maps the input level to the effective zlib level, resolving the
+   * preset values in `constants` ("fast" -> 1, "archive" -> 9) as well
+   * as negative (default) levels.
+   */
+  static int resolve_level(int level) {
+    if (level == constants::compression_level_fast)
+      return 1;
+    if (level == constants::compression_level_archive)
+      return 9;
+    if (level < 0)  // includes the "balanced" preset
+      return default_level();
+    return level;
+  }
 };
 
 }  // namespace sm
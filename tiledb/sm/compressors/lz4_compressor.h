@@ -35,6 +35,7 @@
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/status.h"
 
 namespace tiledb {
@@ -68,6 +69,21 @@ class LZ4 {
     return -1;
   }
 
+  /**
+   * Maps the input level to an LZ4 acceleration factor. The simple LZ4
+   * API exposes no ratio-oriented levels, so "balanced" and "archive"
+   * compress at the default acceleration of 1, while the "fast" preset
+   * trades some ratio for speed. A positive input is used as the
+   * acceleration factor directly.
+   */
+  static int resolve_acceleration(int level) {
+    if (level == constants::compression_level_fast)
+      return 8;
+    if (level < 1)
+      return 1;
+    return level;
+  }
+
   /** Returns the compression overhead for the given input. */
   static uint64_t overhead(uint64_t nbytes);
 };
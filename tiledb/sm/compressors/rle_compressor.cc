@@ -31,11 +31,19 @@
  */
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "tiledb/sm/compressors/rle_compressor.h"
 #include "tiledb/sm/misc/logger.h"
 
+/* ****************************** */
+/*             MACROS             */
+/* ****************************** */
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
 namespace tiledb {
 namespace sm {
 
@@ -141,5 +149,213 @@ uint64_t RLE::overhead(uint64_t nbytes, uint64_t value_size) {
   return value_num * 2;
 }
 
+Status RLE::compress_indexed(
+    uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // Sanity check
+  if (input_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with RLE; null input buffer"));
+  unsigned int max_run_len = 65535;
+  uint64_t value_num = input_buffer->size() / value_size;
+
+  // Sanity check on input buffer
+  if (input_buffer->size() % value_size != 0) {
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with RLE; invalid input buffer format"));
+  }
+
+  // Trivial case
+  if (value_num == 0) {
+    uint64_t zero = 0;
+    RETURN_NOT_OK(output_buffer->write(&zero, sizeof(uint64_t)));
+    RETURN_NOT_OK(output_buffer->write(&zero, sizeof(uint64_t)));
+    RETURN_NOT_OK(output_buffer->write(&zero, sizeof(uint64_t)));
+    return Status::Ok();
+  }
+
+  // First pass - count the runs and record the starting cell position
+  // of every INDEX_RUN_GAP-th run
+  uint64_t run_num = 0;
+  std::vector<uint64_t> index;
+  auto input_cur = (const unsigned char*)input_buffer->data() + value_size;
+  auto input_prev = (const unsigned char*)input_buffer->data();
+  unsigned int cur_run_len = 1;
+  uint64_t run_start = 0;
+  for (uint64_t i = 1; i < value_num; ++i) {
+    if (std::memcmp(input_cur, input_prev, value_size) == 0 &&
+        cur_run_len < max_run_len) {
+      ++cur_run_len;
+    } else {
+      if (run_num % INDEX_RUN_GAP == 0)
+        index.push_back(run_start);
+      ++run_num;
+      run_start = i;
+      cur_run_len = 1;
+    }
+    input_prev = input_cur;
+    input_cur = input_prev + value_size;
+  }
+  if (run_num % INDEX_RUN_GAP == 0)
+    index.push_back(run_start);
+  ++run_num;
+
+  // Write the header and the run index
+  uint64_t index_num = index.size();
+  RETURN_NOT_OK(output_buffer->write(&run_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&value_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&index_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&index[0], index_num * sizeof(uint64_t)));
+
+  // Second pass - write the runs
+  ConstBuffer runs_input(input_buffer->data(), input_buffer->size());
+  return compress(value_size, &runs_input, output_buffer);
+}
+
+Status RLE::decompress_indexed(
+    uint64_t value_size,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer,
+    ThreadPool* thread_pool) {
+  // Sanity check
+  if (input_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; null input buffer"));
+
+  // Read the header and the run index
+  uint64_t run_num, value_num, index_num;
+  RETURN_NOT_OK(input_buffer->read(&run_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&value_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&index_num, sizeof(uint64_t)));
+
+  // Trivial case
+  if (run_num == 0)
+    return Status::Ok();
+
+  auto index =
+      (const uint64_t*)((const char*)input_buffer->data() +
+                        input_buffer->offset());
+  input_buffer->advance_offset(index_num * sizeof(uint64_t));
+  auto runs =
+      (const unsigned char*)input_buffer->data() + input_buffer->offset();
+  uint64_t run_size = value_size + 2 * sizeof(char);
+
+  // Sanity check on input buffer format
+  if (index_num != (run_num + INDEX_RUN_GAP - 1) / INDEX_RUN_GAP ||
+      input_buffer->nbytes_left_to_read() != run_num * run_size) {
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; invalid input buffer format"));
+  }
+
+  // Serial path
+  if (thread_pool == nullptr || index_num == 1) {
+    ConstBuffer runs_input(runs, run_num * run_size);
+    return decompress(value_size, &runs_input, output_buffer);
+  }
+
+  // Parallel path - decompress the run segments concurrently, each
+  // into its own (disjoint) region of the output buffer
+  uint64_t out_nbytes = value_num * value_size;
+  RETURN_NOT_OK(output_buffer->realloc(output_buffer->size() + out_nbytes));
+  auto out_base = (unsigned char*)output_buffer->data() + output_buffer->size();
+  std::vector<std::future<Status>> tasks;
+  for (uint64_t s = 0; s < index_num; ++s) {
+    uint64_t first_run = s * INDEX_RUN_GAP;
+    uint64_t seg_run_num = MIN(INDEX_RUN_GAP, run_num - first_run);
+    uint64_t seg_cell_num =
+        ((s + 1 < index_num) ? index[s + 1] : value_num) - index[s];
+    auto seg_runs = runs + first_run * run_size;
+    auto seg_out = out_base + index[s] * value_size;
+    tasks.push_back(thread_pool->enqueue(
+        [value_size, run_size, seg_runs, seg_run_num, seg_cell_num, seg_out]() {
+          auto input_cur = seg_runs;
+          auto output_cur = seg_out;
+          uint64_t cell_num = 0;
+          for (uint64_t i = 0; i < seg_run_num; ++i) {
+            uint64_t run_len = (((uint64_t)input_cur[value_size]) << 8) +
+                               (uint64_t)input_cur[value_size + 1];
+            for (uint64_t j = 0; j < run_len; ++j) {
+              std::memcpy(output_cur, input_cur, value_size);
+              output_cur += value_size;
+            }
+            cell_num += run_len;
+            input_cur += run_size;
+          }
+          if (cell_num != seg_cell_num)
+            return LOG_STATUS(Status::CompressionError(
+                "Failed decompressing with RLE; corrupted run index"));
+          return Status::Ok();
+        }));
+  }
+  if (!thread_pool->wait_all(tasks))
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; parallel decompression failed"));
+
+  output_buffer->advance_size(out_nbytes);
+  output_buffer->advance_offset(out_nbytes);
+
+  return Status::Ok();
+}
+
+Status RLE::decompress_cell(
+    uint64_t value_size,
+    ConstBuffer* input_buffer,
+    uint64_t cell_idx,
+    void* value) {
+  // Sanity check
+  if (input_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; null input buffer"));
+
+  // Read the header
+  auto data = (const char*)input_buffer->data();
+  uint64_t run_num, value_num, index_num;
+  std::memcpy(&run_num, data, sizeof(uint64_t));
+  std::memcpy(&value_num, data + sizeof(uint64_t), sizeof(uint64_t));
+  std::memcpy(&index_num, data + 2 * sizeof(uint64_t), sizeof(uint64_t));
+  if (cell_idx >= value_num)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; cell position out of bounds"));
+  auto index = (const uint64_t*)(data + 3 * sizeof(uint64_t));
+  auto runs =
+      (const unsigned char*)(data + (3 + index_num) * sizeof(uint64_t));
+  uint64_t run_size = value_size + 2 * sizeof(char);
+
+  // Binary-search the run index for the segment containing the cell
+  uint64_t lo = 0, hi = index_num - 1;
+  while (lo < hi) {
+    uint64_t mid = (lo + hi + 1) / 2;
+    if (index[mid] <= cell_idx)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  // Scan the runs of the segment
+  uint64_t first_run = lo * INDEX_RUN_GAP;
+  uint64_t seg_run_num = MIN(INDEX_RUN_GAP, run_num - first_run);
+  auto input_cur = runs + first_run * run_size;
+  uint64_t cell = index[lo];
+  for (uint64_t i = 0; i < seg_run_num; ++i) {
+    uint64_t run_len = (((uint64_t)input_cur[value_size]) << 8) +
+                       (uint64_t)input_cur[value_size + 1];
+    if (cell_idx < cell + run_len) {
+      std::memcpy(value, input_cur, value_size);
+      return Status::Ok();
+    }
+    cell += run_len;
+    input_cur += run_size;
+  }
+
+  return LOG_STATUS(Status::CompressionError(
+      "Failed decompressing with RLE; corrupted run index"));
+}
+
+uint64_t RLE::overhead_indexed(uint64_t nbytes, uint64_t value_size) {
+  // The runs overhead, plus the header and the worst-case run index
+  uint64_t value_num = nbytes / value_size;
+  return overhead(nbytes, value_size) + 3 * sizeof(uint64_t) +
+         (value_num / INDEX_RUN_GAP + 1) * sizeof(uint64_t);
+}
+
 }  // namespace sm
 }  // namespace tiledb
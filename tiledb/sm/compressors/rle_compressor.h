@@ -36,6 +36,7 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/thread_pool.h"
 
 namespace tiledb {
 namespace sm {
@@ -67,6 +68,63 @@ class RLE {
 
   /** Returns the compression overhead for the given input. */
   static uint64_t overhead(uint64_t nbytes, uint64_t value_size);
+
+  /** The number of runs between two consecutive run index entries. */
+  static const uint64_t INDEX_RUN_GAP = 256;
+
+  /**
+   * Compression function for the indexed format. In addition to the
+   * runs, a sparse run index is stored that holds the starting cell
+   * position of every `INDEX_RUN_GAP`-th run, enabling parallel
+   * decompression and point access without decoding preceding runs.
+   *
+   * @param value_size The size of a single value.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the compressed data to.
+   * @return Status
+   */
+  static Status compress_indexed(
+      uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Decompression function for the indexed format. If a thread pool is
+   * given, the runs are decompressed concurrently, split at the run
+   * index boundaries.
+   *
+   * @param value_size The size of a single value.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the decompressed data.
+   * @param thread_pool The thread pool to decompress with, or `nullptr`
+   *     for serial decompression.
+   * @return Status
+   */
+  static Status decompress_indexed(
+      uint64_t value_size,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer,
+      ThreadPool* thread_pool = nullptr);
+
+  /**
+   * Retrieves a single value from a buffer in the indexed format,
+   * decoding only the runs of the index segment that contains it.
+   *
+   * @param value_size The size of a single value.
+   * @param input_buffer Input buffer holding the indexed compressed data.
+   * @param cell_idx The position of the value to retrieve.
+   * @param value Buffer of `value_size` bytes to write the value to.
+   * @return Status
+   */
+  static Status decompress_cell(
+      uint64_t value_size,
+      ConstBuffer* input_buffer,
+      uint64_t cell_idx,
+      void* value);
+
+  /**
+   * Returns the compression overhead of the indexed format for the
+   * given input.
+   */
+  static uint64_t overhead_indexed(uint64_t nbytes, uint64_t value_size);
 };
 
 }  // namespace sm
@@ -35,6 +35,7 @@
 
 #include <zstd.h>
 #include <iostream>
+#include <memory>
 
 namespace tiledb {
 namespace sm {
@@ -46,13 +47,22 @@ Status ZStd::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with ZStd; invalid buffer format"));
 
+  // Reuse a compression context per thread; creating a fresh context on
+  // every call dominates codec time for small tile chunks.
+  thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> ctx(
+      ZSTD_createCCtx(), ZSTD_freeCCtx);
+  if (ctx == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with ZStd; cannot create compression context"));
+
   // Compress
-  uint64_t zstd_ret = ZSTD_compress(
+  uint64_t zstd_ret = ZSTD_compressCCtx(
+      ctx.get(),
       output_buffer->cur_data(),
       output_buffer->free_space(),
       input_buffer->data(),
       input_buffer->size(),
-      level < 0 ? ZStd::default_level() : level);
+      ZStd::resolve_level(level));
 
   // Handle error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -74,8 +84,17 @@ Status ZStd::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with ZStd; invalid buffer format"));
 
+  // Reuse a decompression context per thread (see `compress`)
+  thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> ctx(
+      ZSTD_createDCtx(), ZSTD_freeDCtx);
+  if (ctx == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with ZStd; cannot create decompression "
+        "context"));
+
   // Decompress
-  uint64_t zstd_ret = ZSTD_decompress(
+  uint64_t zstd_ret = ZSTD_decompressDCtx(
+      ctx.get(),
       output_buffer->cur_data(),
       output_buffer->free_space(),
       input_buffer->data(),
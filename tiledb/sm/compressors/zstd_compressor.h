@@ -35,6 +35,7 @@
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/status.h"
 
 namespace tiledb {
@@ -68,6 +69,21 @@ class ZStd {
     return 5;
   }
 
+  /**
+   * Resolves the preset level values in `constants` to concrete zstd
+   * levels: "fast" -> 1, "archive" -> 19, other negative input (which
+   * covers "balanced") -> the default level.
+   */
+  static int resolve_level(int level) {
+    if (level == constants::compression_level_fast)
+      return 1;
+    if (level == constants::compression_level_archive)
+      return 19;
+    if (level < 0)
+      return default_level();
+    return level;
+  }
+
   /** Returns the compression overhead for the given input. */
   static uint64_t overhead(uint64_t nbytes);
 };
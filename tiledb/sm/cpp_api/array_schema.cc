@@ -248,6 +248,8 @@ std::string ArraySchema::to_str(tiledb_layout_t layout) {
       return "COL-MAJOR";
     case TILEDB_UNORDERED:
       return "UNORDERED";
+    case TILEDB_MORTON:
+      return "MORTON";
   }
   return "";
 }
@@ -115,6 +115,10 @@ class TILEDB_EXPORT Config {
    *    The fragment metadata cache size in bytes. Any `uint64_t` value is
    *    acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.enable_checksums` <br>
+   *    If `true`, per-chunk CRC32C checksums are written to compressed
+   *    tiles and verified upon reading. <br>
+   *    **Default**: false
    * - `vfs.max_parallel_ops` <br>
    *    The maximum number of VFS parallel operations. <br>
    *    **Default**: number of cores
@@ -122,6 +126,10 @@ class TILEDB_EXPORT Config {
    *    The minimum number of bytes in a parallel VFS operation. (Does not
    *    affect parallel S3 writes.) <br>
    *    **Default**: 10MB
+   * - `vfs.max_batch_read_gap` <br>
+   *    The maximum gap (in bytes) between two regions that get coalesced
+   *    into a single read in a batched VFS read. <br>
+   *    **Default**: 500KB
    * - `vfs.s3.region` <br>
    *    The S3 region, if S3 is enabled. <br>
    *    **Default**: us-east-1
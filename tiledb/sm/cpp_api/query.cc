@@ -64,7 +64,10 @@ Query& Query::set_layout(tiledb_layout_t layout) {
 
 Query::Status Query::submit() {
   auto& ctx = ctx_.get();
-  prepare_submission();
+  if (raw_bindings_)
+    register_bindings();
+  else
+    prepare_submission();
   ctx.handle_error(tiledb_query_submit(ctx, query_.get()));
   return query_status();
 }
@@ -111,6 +114,10 @@ void Query::reset_buffers() {
   buff_sizes_.clear();
   all_buff_.clear();
   sub_tsize_.clear();
+  attr_names_.clear();
+  bind_capacities_.clear();
+  raw_bindings_ = false;
+  bindings_registered_ = false;
 }
 
 /* ********************************* */
@@ -145,6 +152,33 @@ std::string Query::to_str(tiledb_query_type_t type) {
 /*          PRIVATE METHODS          */
 /* ********************************* */
 
+void Query::register_bindings() {
+  if (bindings_registered_) {
+    // The bindings are already attached; only restore the capacities
+    // that the previous submission overwrote with the result sizes
+    std::memcpy(
+        buff_sizes_.data(),
+        bind_capacities_.data(),
+        buff_sizes_.size() * sizeof(uint64_t));
+    return;
+  }
+
+  attr_names_.clear();
+  for (const auto& a : attrs_)
+    attr_names_.push_back(a.c_str());
+  bind_capacities_ = buff_sizes_;
+
+  auto& ctx = ctx_.get();
+  ctx.handle_error(tiledb_query_set_buffers(
+      ctx,
+      query_.get(),
+      attr_names_.data(),
+      (unsigned)attr_names_.size(),
+      all_buff_.data(),
+      buff_sizes_.data()));
+  bindings_registered_ = true;
+}
+
 void Query::prepare_submission() {
   all_buff_.clear();
   buff_sizes_.clear();
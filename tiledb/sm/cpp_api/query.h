@@ -121,7 +121,10 @@ class TILEDB_EXPORT Query {
   void submit_async(const Fn& callback) {
     std::function<void(void*)> wrapper = [&](void*) { callback(); };
     auto& ctx = ctx_.get();
-    prepare_submission();
+    if (raw_bindings_)
+      register_bindings();
+    else
+      prepare_submission();
     ctx.handle_error(tiledb::impl::tiledb_query_submit_async(
         ctx, query_.get(), wrapper, nullptr));
   }
@@ -259,6 +262,9 @@ class TILEDB_EXPORT Query {
    **/
   template <typename T>
   void set_buffer(const std::string& attr, const T* buf, uint64_t size) {
+    if (raw_bindings_)
+      throw TileDBError(
+          "Cannot mix set_buffer with bind_buffer on the same query.");
     uint64_t element_size = 0;
     if (array_attributes_.count(attr)) {
       const auto& a = array_attributes_.at(attr);
@@ -351,6 +357,72 @@ class TILEDB_EXPORT Query {
     set_buffer(attr, buf.first, buf.second);
   }
 
+  /**
+   * Binds a raw buffer for a fixed-sized attribute, registering it
+   * once: the first submission attaches the bindings to the query, and
+   * subsequent submissions (e.g., after an incomplete read) reuse them
+   * without re-registration or internal copies of the buffer-size
+   * arrays. The buffer must outlive the query. Raw bindings cannot be
+   * mixed with `set_buffer` on the same query.
+   *
+   * The number of result elements of a read is retrieved with
+   * `result_buffer_elements`, as with `set_buffer`.
+   *
+   * @tparam T Attribute type
+   * @param attr Attribute name
+   * @param buf Buffer pointer with elements of the attribute type.
+   * @param size Number of elements in the buffer.
+   **/
+  template <typename T>
+  void bind_buffer(const std::string& attr, T* buf, uint64_t size) {
+    if (!raw_bindings_ && !attrs_.empty())
+      throw TileDBError(
+          "Cannot mix bind_buffer with set_buffer on the same query.");
+    auto element_size = bind_element_size<T>(attr);
+    raw_bindings_ = true;
+    bindings_registered_ = false;
+    attrs_.emplace_back(attr);
+    all_buff_.push_back(buf);
+    buff_sizes_.push_back(sizeof(T) * size);
+    sub_tsize_.push_back(element_size);
+  }
+
+  /**
+   * Binds raw buffers for a variable-sized attribute, registering them
+   * once (see the fixed-sized overload). The buffers must outlive the
+   * query.
+   *
+   * @tparam T Attribute type
+   * @param attr Attribute name
+   * @param offsets Offsets buffer pointer.
+   * @param offset_size Number of elements in the offsets buffer.
+   * @param data Data buffer pointer with elements of the attribute type.
+   * @param size Number of elements in the data buffer.
+   **/
+  template <typename T>
+  void bind_buffer(
+      const std::string& attr,
+      uint64_t* offsets,
+      uint64_t offset_size,
+      T* data,
+      uint64_t size) {
+    if (attr == TILEDB_COORDS)
+      throw TileDBError("Cannot bind coordinate buffer as variable sized.");
+    if (!raw_bindings_ && !attrs_.empty())
+      throw TileDBError(
+          "Cannot mix bind_buffer with set_buffer on the same query.");
+    auto element_size = bind_element_size<T>(attr);
+    raw_bindings_ = true;
+    bindings_registered_ = false;
+    all_buff_.push_back(offsets);
+    buff_sizes_.push_back(TILEDB_OFFSET_SIZE * offset_size);
+    sub_tsize_.push_back(TILEDB_OFFSET_SIZE);
+    attrs_.emplace_back(attr);
+    all_buff_.push_back(data);
+    buff_sizes_.push_back(sizeof(T) * size);
+    sub_tsize_.push_back(element_size);
+  }
+
   /* ********************************* */
   /*         STATIC FUNCTIONS          */
   /* ********************************* */
@@ -381,6 +453,19 @@ class TILEDB_EXPORT Query {
   /** The buffer sizes that will be passed to a TileDB C query. */
   std::vector<uint64_t> buff_sizes_;
 
+  /** `true` if the buffers were bound raw with `bind_buffer`. */
+  bool raw_bindings_ = false;
+
+  /** `true` once the raw bindings have been attached to the C query. */
+  bool bindings_registered_ = false;
+
+  /**
+   * The byte capacities of the raw bindings. `buff_sizes_` is
+   * overwritten with the result sizes by a read, so the capacities are
+   * restored into it before a re-submission.
+   */
+  std::vector<uint64_t> bind_capacities_;
+
   /** The TileDB context. */
   std::reference_wrapper<const Context> ctx_;
 
@@ -429,6 +514,30 @@ class TILEDB_EXPORT Query {
 
   /** Collate buffers and attach them to the query. */
   void prepare_submission();
+
+  /**
+   * Attaches the raw bindings to the C query upon the first submission;
+   * subsequent submissions only restore the binding capacities into the
+   * (in-place updated) size array.
+   */
+  void register_bindings();
+
+  /**
+   * Type-checks a raw binding against the array schema and returns the
+   * element size of the attribute.
+   */
+  template <typename T>
+  uint64_t bind_element_size(const std::string& attr) {
+    if (array_attributes_.count(attr)) {
+      const auto& a = array_attributes_.at(attr);
+      impl::type_check<T>(a.type(), 0);
+      return a.variable_sized() ? sizeof(T) : a.cell_size();
+    } else if (attr == TILEDB_COORDS) {
+      impl::type_check<T>(schema_.domain().type());
+      return tiledb_datatype_size(schema_.domain().type());
+    }
+    throw AttributeError("Attribute does not exist: " + attr);
+  }
 };
 
 /* ********************************* */
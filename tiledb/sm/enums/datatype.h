@@ -48,49 +48,43 @@ enum class Datatype : char {
 #undef TILEDB_DATATYPE_ENUM
 };
 
-/** Returns the datatype size. */
-inline uint64_t datatype_size(Datatype type) {
-  switch (type) {
-    case Datatype::INT32:
-      return sizeof(int);
-    case Datatype::INT64:
-      return sizeof(int64_t);
-    case Datatype::FLOAT32:
-      return sizeof(float);
-    case Datatype::FLOAT64:
-      return sizeof(double);
-    case Datatype::CHAR:
-      return sizeof(char);
-    case Datatype::INT8:
-      return sizeof(int8_t);
-    case Datatype::UINT8:
-      return sizeof(uint8_t);
-    case Datatype::INT16:
-      return sizeof(int16_t);
-    case Datatype::UINT16:
-      return sizeof(uint16_t);
-    case Datatype::UINT32:
-      return sizeof(uint32_t);
-    case Datatype::UINT64:
-      return sizeof(uint64_t);
-    case Datatype::STRING_ASCII:
-      return sizeof(uint8_t);
-    case Datatype::STRING_UTF8:
-      return sizeof(uint8_t);
-    case Datatype::STRING_UTF16:
-      return sizeof(uint16_t);
-    case Datatype::STRING_UTF32:
-      return sizeof(uint32_t);
-    case Datatype::STRING_UCS2:
-      return sizeof(uint16_t);
-    case Datatype::STRING_UCS4:
-      return sizeof(uint32_t);
-    case Datatype::ANY:
-      return sizeof(uint8_t);
-  }
+/**
+ * The datatype sizes (in bytes), indexed by the Datatype enum value.
+ * Keep in sync with the datatype enum in tiledb_enum.h.
+ */
+constexpr uint64_t datatype_sizes[] = {
+    sizeof(int),       // INT32
+    sizeof(int64_t),   // INT64
+    sizeof(float),     // FLOAT32
+    sizeof(double),    // FLOAT64
+    sizeof(char),      // CHAR
+    sizeof(int8_t),    // INT8
+    sizeof(uint8_t),   // UINT8
+    sizeof(int16_t),   // INT16
+    sizeof(uint16_t),  // UINT16
+    sizeof(uint32_t),  // UINT32
+    sizeof(uint64_t),  // UINT64
+    sizeof(uint8_t),   // STRING_ASCII
+    sizeof(uint8_t),   // STRING_UTF8
+    sizeof(uint16_t),  // STRING_UTF16
+    sizeof(uint32_t),  // STRING_UTF32
+    sizeof(uint16_t),  // STRING_UCS2
+    sizeof(uint32_t),  // STRING_UCS4
+    sizeof(uint8_t),   // ANY
+};
 
-  assert(false);
-  return 0;
+/**
+ * Returns the datatype size, or 0 if the input does not denote a valid
+ * datatype (e.g. a corrupt serialized datatype byte). A constexpr table
+ * lookup rather than a runtime switch, so calls in per-cell loops
+ * compile to a single indexed load and calls on compile-time known
+ * datatypes fold into constants.
+ */
+inline constexpr uint64_t datatype_size(Datatype type) {
+  return (static_cast<unsigned char>(type) <
+          sizeof(datatype_sizes) / sizeof(datatype_sizes[0])) ?
+             datatype_sizes[static_cast<unsigned char>(type)] :
+             0;
 }
 
 /** Returns the string representation of the input datatype. */
@@ -56,6 +56,8 @@ inline const char* layout_str(Layout layout) {
     return constants::global_order_str;
   if (layout == Layout::UNORDERED)
     return constants::unordered_str;
+  if (layout == Layout::MORTON)
+    return constants::morton_str;
 
   return nullptr;
 }
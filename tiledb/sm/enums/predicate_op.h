@@ -0,0 +1,60 @@
+/**
+ * @file predicate_op.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This defines the tiledb PredicateOp enum that maps to the
+ * tiledb_predicate_op_t C-api enum.
+ */
+
+#ifndef TILEDB_PREDICATE_OP_H
+#define TILEDB_PREDICATE_OP_H
+
+namespace tiledb {
+namespace sm {
+
+/** Defines the comparison operator of an attribute value predicate. */
+enum class PredicateOp : char {
+#define TILEDB_PREDICATE_OP_ENUM(id) id
+#include "tiledb/sm/c_api/tiledb_enum.h"
+#undef TILEDB_PREDICATE_OP_ENUM
+  /**
+   * Inclusive range predicate. Internal only; set through
+   * `Query::set_predicate_range`.
+   */
+  BETWEEN,
+  /**
+   * Set membership predicate. Internal only; set through
+   * `Query::set_predicate_set`.
+   */
+  IN,
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_PREDICATE_OP_H
@@ -119,6 +119,8 @@ class LibHDFS {
       hdfsBuilderSetKerbTicketCachePath;
   std::function<void(hdfsBuilder*, const char* userName)>
       hdfsBuilderSetUserName;
+  std::function<int(hdfsBuilder*, const char* key, const char* val)>
+      hdfsBuilderConfSetStr;
   std::function<int(hdfsFS, hdfsFile)> hdfsCloseFile;
   std::function<tSize(hdfsFS, hdfsFile, tOffset, void*, tSize)> hdfsPread;
   std::function<tSize(hdfsFS, hdfsFile, void*, tSize)> hdfsRead;
@@ -150,6 +152,7 @@ class LibHDFS {
       BIND_HDFS_FUNC(hdfsConfGetStr);
       BIND_HDFS_FUNC(hdfsBuilderSetKerbTicketCachePath);
       BIND_HDFS_FUNC(hdfsBuilderSetUserName);
+      BIND_HDFS_FUNC(hdfsBuilderConfSetStr);
       BIND_HDFS_FUNC(hdfsCloseFile);
       BIND_HDFS_FUNC(hdfsPread);
       BIND_HDFS_FUNC(hdfsRead);
@@ -226,7 +229,17 @@ Status HDFS::connect(const Config::HDFSParams& config) {
     libhdfs_->hdfsBuilderSetKerbTicketCachePath(
         builder, config.kerb_ticket_cache_path_.c_str());
   }
-  // TODO: Set config strings
+  // libhdfs exposes no per-file readahead API, so the knob maps to the
+  // client configuration of this connection
+  if (config.readahead_ != 0) {
+    std::string readahead = std::to_string(config.readahead_);
+    if (libhdfs_->hdfsBuilderConfSetStr(
+            builder, "dfs.client.cache.readahead", readahead.c_str()) != 0) {
+      return LOG_STATUS(Status::HDFSError(
+          "Failed to connect to hdfs, could not set client readahead"));
+    }
+  }
+  config_ = config;
   hdfs_ = libhdfs_->hdfsBuilderConnect(builder);
   if (hdfs_ == nullptr) {
     // TODO: errno for better options
@@ -238,6 +251,12 @@ Status HDFS::connect(const Config::HDFSParams& config) {
 
 Status HDFS::disconnect() {
   RETURN_NOT_OK(libhdfs_->status());
+  {
+    std::unique_lock<std::mutex> lck(read_file_pool_mtx_);
+    for (auto& entry : read_file_pool_)
+      libhdfs_->hdfsCloseFile(hdfs_, entry.second);
+    read_file_pool_.clear();
+  }
   if (libhdfs_->hdfsDisconnect(hdfs_) != 0) {
     return LOG_STATUS(Status::HDFSError("Failed to disconnect hdfs"));
   }
@@ -298,6 +317,7 @@ Status HDFS::create_dir(const URI& uri) {
 Status HDFS::remove_dir(const URI& uri) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs))
+  evict_read_files(fs, uri.to_path(), true);
   int rc = libhdfs_->hdfsDelete(fs, uri.to_path().c_str(), 1);
   if (rc < 0) {
     return LOG_STATUS(
@@ -309,6 +329,7 @@ Status HDFS::remove_dir(const URI& uri) {
 Status HDFS::move_path(const URI& old_uri, const URI& new_uri) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
+  evict_read_files(fs, old_uri.to_path(), true);
   if (libhdfs_->hdfsExists(fs, new_uri.to_path().c_str()) == 0) {
     return LOG_STATUS(Status::HDFSError(
         "Cannot move path " + old_uri.to_string() + " to " +
@@ -368,6 +389,7 @@ Status HDFS::touch(const URI& uri) {
 Status HDFS::remove_file(const URI& uri) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
+  evict_read_files(fs, uri.to_path(), false);
   int ret = libhdfs_->hdfsDelete(fs, uri.to_path().c_str(), 0);
   if (ret < 0) {
     return LOG_STATUS(Status::HDFSError(
@@ -376,47 +398,90 @@ Status HDFS::remove_file(const URI& uri) {
   return Status::Ok();
 }
 
+hdfsFile HDFS::open_read_file(
+    hdfsFS fs, const std::string& path, uint64_t length) {
+  {
+    std::unique_lock<std::mutex> lck(read_file_pool_mtx_);
+    auto it = read_file_pool_.find(path);
+    if (it != read_file_pool_.end()) {
+      hdfsFile file = it->second;
+      read_file_pool_.erase(it);
+      return file;
+    }
+  }
+  // The buffer size applies to the lifetime of the handle, which may
+  // serve reads other than the current one, so the configured size takes
+  // precedence over the current read length
+  uint64_t buffer_size =
+      (config_.read_buffer_size_ != 0) ? config_.read_buffer_size_ : length;
+  return libhdfs_->hdfsOpenFile(
+      fs, path.c_str(), O_RDONLY, static_cast<int>(buffer_size), 0, 0);
+}
+
+void HDFS::release_read_file(
+    hdfsFS fs, const std::string& path, hdfsFile file) {
+  {
+    std::unique_lock<std::mutex> lck(read_file_pool_mtx_);
+    if (read_file_pool_.size() < config_.max_open_read_files_) {
+      read_file_pool_.emplace(path, file);
+      return;
+    }
+  }
+  libhdfs_->hdfsCloseFile(fs, file);
+}
+
+void HDFS::evict_read_files(hdfsFS fs, const std::string& path, bool prefix) {
+  std::unique_lock<std::mutex> lck(read_file_pool_mtx_);
+  for (auto it = read_file_pool_.begin(); it != read_file_pool_.end();) {
+    bool match =
+        prefix ? utils::starts_with(it->first, path) : (it->first == path);
+    if (match) {
+      libhdfs_->hdfsCloseFile(fs, it->second);
+      it = read_file_pool_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 Status HDFS::read(const URI& uri, off_t offset, void* buffer, uint64_t length) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
-  hdfsFile readFile =
-      libhdfs_->hdfsOpenFile(fs, uri.to_path().c_str(), O_RDONLY, length, 0, 0);
-  if (!readFile) {
-    return LOG_STATUS(Status::HDFSError(
-        std::string("Cannot read file ") + uri.to_string() +
-        ": file open error"));
-  }
   if (offset > std::numeric_limits<tOffset>::max()) {
     return LOG_STATUS(Status::HDFSError(
         std::string("Cannot read from from '") + uri.to_string() +
         "'; offset > typemax(tOffset)"));
   }
-  tOffset off = static_cast<tOffset>(offset);
-  int ret = libhdfs_->hdfsSeek(fs, readFile, off);
-  if (ret < 0) {
+  std::string path = uri.to_path();
+  hdfsFile readFile = open_read_file(fs, path, length);
+  if (!readFile) {
     return LOG_STATUS(Status::HDFSError(
-        std::string("Cannot seek to offset ") + uri.to_string()));
+        std::string("Cannot read file ") + uri.to_string() +
+        ": file open error"));
   }
+  tOffset off = static_cast<tOffset>(offset);
   uint64_t bytes_to_read = length;
   char* buffptr = static_cast<char*>(buffer);
   do {
     tSize nbytes = (bytes_to_read <= INT_MAX) ? bytes_to_read : INT_MAX;
-    tSize bytes_read =
-        libhdfs_->hdfsRead(fs, readFile, static_cast<void*>(buffptr), nbytes);
+    // Read at an explicit position instead of seeking a shared stream
+    // position, so that the chunks of a large read that `VFS::read`
+    // issues concurrently on the thread pool do not serialize on the
+    // stream state and can saturate multiple DataNodes
+    tSize bytes_read = libhdfs_->hdfsPread(
+        fs, readFile, off, static_cast<void*>(buffptr), nbytes);
     if (bytes_read < 0) {
+      libhdfs_->hdfsCloseFile(fs, readFile);
       return LOG_STATUS(Status::HDFSError(
           "Cannot read from file " + uri.to_string() + "; File reading error"));
     }
     bytes_to_read -= bytes_read;
     buffptr += bytes_read;
+    off += bytes_read;
   } while (bytes_to_read > 0);
 
-  // Close file
-  if (libhdfs_->hdfsCloseFile(fs, readFile)) {
-    return LOG_STATUS(Status::HDFSError(
-        std::string("Cannot read from file ") + uri.to_string() +
-        "; File closing error"));
-  }
+  // Return the handle to the pool for reuse by subsequent reads
+  release_read_file(fs, path, readFile);
   return Status::Ok();
 }
 
@@ -425,9 +490,19 @@ Status HDFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   RETURN_NOT_OK(connect(&fs));
   bool file_exists = false;
   RETURN_NOT_OK(is_file(uri, &file_exists));
+  // Pooled read handles on this path would observe a stale file length
+  evict_read_files(fs, uri.to_path(), false);
   int flags = file_exists ? O_WRONLY | O_APPEND : O_WRONLY;
+  uint64_t open_buffer_size = (config_.write_buffer_size_ != 0) ?
+                                  config_.write_buffer_size_ :
+                                  constants::max_write_bytes;
   hdfsFile write_file = libhdfs_->hdfsOpenFile(
-      fs, uri.to_path().c_str(), flags, constants::max_write_bytes, 0, 0);
+      fs,
+      uri.to_path().c_str(),
+      flags,
+      static_cast<int>(open_buffer_size),
+      0,
+      static_cast<tSize>(config_.block_size_));
   if (!write_file) {
     return LOG_STATUS(Status::HDFSError(
         std::string("Cannot write to file ") + uri.to_string() +
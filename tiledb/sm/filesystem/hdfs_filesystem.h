@@ -36,6 +36,8 @@
 #ifdef HAVE_HDFS
 
 #include <sys/types.h>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -135,7 +137,14 @@ class HDFS {
   Status remove_dir(const URI& uri);
 
   /**
-   *  Reads data from a file into a buffer.
+   *  Reads data from a file into a buffer, using positional reads on a
+   * file handle exclusively owned by the call. Hence, it is safe to read
+   * multiple chunks of the same file concurrently (as `VFS::read` does
+   * for large reads), each chunk streaming from its own DataNode
+   * connection. Handles are returned to a pool upon completion and
+   * reused by subsequent reads of the same file, so that the repeated
+   * reads of an attribute file during a query do not pay the namenode
+   * round-trip of `hdfsOpenFile` each time.
    *
    * @param uri The URI of the file to be read.
    * @param offset The offset in the file from which the read will start.
@@ -190,10 +199,42 @@ class HDFS {
   hdfsFS hdfs_;
   LibHDFS* libhdfs_;
 
+  /** The HDFS configuration parameters set upon connection. */
+  Config::HDFSParams config_;
+
+  /** Protects the read file handle pool. */
+  std::mutex read_file_pool_mtx_;
+
+  /**
+   * Pool of open read file handles, keyed on the file path. A handle is
+   * removed from the pool while a read uses it (a handle must not be
+   * shared by concurrent reads) and returned upon completion, up to
+   * `Config::HDFSParams::max_open_read_files_` pooled handles.
+   */
+  std::multimap<std::string, hdfsFile> read_file_pool_;
+
   /** Connect to hdfsFS and return handle, stub for future cached dynamic
    * connections **/
   Status connect(hdfsFS* fs);
 
+  /**
+   * Returns an open read file handle for the input path, either reusing
+   * a pooled one or opening a new one (`nullptr` upon error).
+   */
+  hdfsFile open_read_file(hdfsFS fs, const std::string& path, uint64_t length);
+
+  /** Returns a read file handle to the pool, or closes it if the pool is
+   * full. */
+  void release_read_file(hdfsFS fs, const std::string& path, hdfsFile file);
+
+  /**
+   * Closes all pooled read file handles for the input path (or, if
+   * `prefix` is `true`, for all paths starting with it). Invoked when a
+   * file is written, moved or deleted, as the pooled handles would then
+   * observe stale contents.
+   */
+  void evict_read_files(hdfsFS fs, const std::string& path, bool prefix);
+
   HDFS(HDFS const& l);             // disable copy ctor
   HDFS& operator=(HDFS const& l);  // disable assignment
 };
@@ -0,0 +1,305 @@
+/**
+ * @file   mem_filesystem.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class MemFilesystem.
+ */
+
+#include "tiledb/sm/filesystem/mem_filesystem.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/utils.h"
+
+#include <cstring>
+#include <functional>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The number of path registry shards. */
+constexpr unsigned shard_num = 16;
+
+}  // namespace
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+MemFilesystem::MemFilesystem() {
+  for (unsigned i = 0; i < shard_num; ++i)
+    shards_.emplace_back(new Shard());
+}
+
+MemFilesystem::~MemFilesystem() = default;
+
+/* ********************************* */
+/*                 API               */
+/* ********************************* */
+
+Status MemFilesystem::create_dir(const URI& uri) {
+  auto path = normalize(uri.to_string());
+
+  if (is_dir(uri))
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot create directory '") + path +
+        "'; Directory already exists"));
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  s->dirs_.insert(path);
+  return Status::Ok();
+}
+
+Status MemFilesystem::touch(const URI& uri) {
+  auto path = normalize(uri.to_string());
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  s->files_[path];
+  return Status::Ok();
+}
+
+Status MemFilesystem::file_size(const URI& uri, uint64_t* size) const {
+  auto path = normalize(uri.to_string());
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  auto it = s->files_.find(path);
+  if (it == s->files_.end())
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot get size of file '") + path +
+        "'; File does not exist"));
+  *size = it->second.data_.size();
+  return Status::Ok();
+}
+
+bool MemFilesystem::is_dir(const URI& uri) const {
+  auto path = normalize(uri.to_string());
+
+  // Explicitly created directory
+  {
+    auto s = shard(path);
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    if (s->dirs_.count(path) != 0)
+      return true;
+  }
+
+  // A directory also exists implicitly if anything exists beneath it
+  auto prefix = path + "/";
+  for (const auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    auto fit = s->files_.lower_bound(prefix);
+    if (fit != s->files_.end() && utils::starts_with(fit->first, prefix))
+      return true;
+    auto dit = s->dirs_.lower_bound(prefix);
+    if (dit != s->dirs_.end() && utils::starts_with(*dit, prefix))
+      return true;
+  }
+
+  return false;
+}
+
+bool MemFilesystem::is_file(const URI& uri) const {
+  auto path = normalize(uri.to_string());
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  return s->files_.count(path) != 0;
+}
+
+Status MemFilesystem::ls(
+    const URI& parent, std::vector<std::string>* paths) const {
+  auto prefix = normalize(parent.to_string()) + "/";
+
+  // Collect the immediate children: for every path under the prefix,
+  // keep the prefix plus the first remaining path component
+  std::set<std::string> children;
+  auto add_child = [&prefix, &children](const std::string& path) {
+    if (!utils::starts_with(path, prefix))
+      return;
+    auto pos = path.find('/', prefix.size());
+    children.insert(
+        (pos == std::string::npos) ? path : path.substr(0, pos));
+  };
+  for (const auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    for (auto it = s->files_.lower_bound(prefix);
+         it != s->files_.end() && utils::starts_with(it->first, prefix);
+         ++it)
+      add_child(it->first);
+    for (auto it = s->dirs_.lower_bound(prefix);
+         it != s->dirs_.end() && utils::starts_with(*it, prefix);
+         ++it)
+      add_child(*it);
+  }
+
+  for (const auto& child : children)
+    paths->push_back(child);
+
+  return Status::Ok();
+}
+
+Status MemFilesystem::move_path(const URI& old_uri, const URI& new_uri) {
+  auto old_path = normalize(old_uri.to_string());
+  auto new_path = normalize(new_uri.to_string());
+  auto old_prefix = old_path + "/";
+
+  // Collect and erase the affected paths, one shard at a time
+  std::vector<std::pair<std::string, File>> files;
+  std::vector<std::string> dirs;
+  for (const auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    for (auto it = s->files_.lower_bound(old_path); it != s->files_.end();) {
+      if (it->first != old_path && !utils::starts_with(it->first, old_prefix))
+        break;
+      files.emplace_back(it->first, std::move(it->second));
+      it = s->files_.erase(it);
+    }
+    for (auto it = s->dirs_.lower_bound(old_path); it != s->dirs_.end();) {
+      if (*it != old_path && !utils::starts_with(*it, old_prefix))
+        break;
+      dirs.push_back(*it);
+      it = s->dirs_.erase(it);
+    }
+  }
+
+  if (files.empty() && dirs.empty())
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot move path '") + old_path +
+        "'; Path does not exist"));
+
+  // Re-insert the paths under the new prefix
+  for (auto& file : files) {
+    auto path = new_path + file.first.substr(old_path.size());
+    auto s = shard(path);
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    s->files_[path] = std::move(file.second);
+  }
+  for (const auto& dir : dirs) {
+    auto path = new_path + dir.substr(old_path.size());
+    auto s = shard(path);
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    s->dirs_.insert(path);
+  }
+
+  return Status::Ok();
+}
+
+Status MemFilesystem::read(
+    const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const {
+  auto path = normalize(uri.to_string());
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  auto it = s->files_.find(path);
+  if (it == s->files_.end())
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot read from file '") + path +
+        "'; File does not exist"));
+  const auto& data = it->second.data_;
+  if (offset + nbytes > data.size())
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot read from file '") + path +
+        "'; Read exceeds file size"));
+  std::memcpy(buffer, &data[offset], nbytes);
+  return Status::Ok();
+}
+
+Status MemFilesystem::remove_dir(const URI& uri) {
+  auto path = normalize(uri.to_string());
+  auto prefix = path + "/";
+
+  bool found = false;
+  for (const auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    for (auto it = s->files_.lower_bound(prefix); it != s->files_.end();) {
+      if (!utils::starts_with(it->first, prefix))
+        break;
+      it = s->files_.erase(it);
+      found = true;
+    }
+    for (auto it = s->dirs_.lower_bound(path); it != s->dirs_.end();) {
+      if (*it != path && !utils::starts_with(*it, prefix))
+        break;
+      it = s->dirs_.erase(it);
+      found = true;
+    }
+  }
+
+  if (!found)
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot remove directory '") + path +
+        "'; Directory does not exist"));
+
+  return Status::Ok();
+}
+
+Status MemFilesystem::remove_file(const URI& uri) {
+  auto path = normalize(uri.to_string());
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  if (s->files_.erase(path) == 0)
+    return LOG_STATUS(Status::MemFSError(
+        std::string("Cannot remove file '") + path +
+        "'; File does not exist"));
+  return Status::Ok();
+}
+
+Status MemFilesystem::write(
+    const URI& uri, const void* buffer, uint64_t buffer_size) {
+  auto path = normalize(uri.to_string());
+
+  auto s = shard(path);
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  auto& data = s->files_[path].data_;
+  if (buffer_size != 0) {
+    auto old_size = data.size();
+    data.resize(old_size + buffer_size);
+    std::memcpy(&data[old_size], buffer, buffer_size);
+  }
+  return Status::Ok();
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+MemFilesystem::Shard* MemFilesystem::shard(const std::string& path) const {
+  return shards_[std::hash<std::string>()(path) % shard_num].get();
+}
+
+std::string MemFilesystem::normalize(const std::string& path) {
+  if (!path.empty() && path.back() == '/')
+    return path.substr(0, path.size() - 1);
+  return path;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,210 @@
+/**
+ * @file   mem_filesystem.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class MemFilesystem.
+ */
+
+#ifndef TILEDB_MEM_FILESYSTEM_H
+#define TILEDB_MEM_FILESYSTEM_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/uri.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A RAM-backed filesystem for `mem://` URIs. Files live for the lifetime
+ * of the owning VFS and are never persisted, so reads and writes are
+ * plain memory copies without any system calls. This is intended for
+ * scratch arrays (e.g. intermediate pipeline results) and for isolating
+ * CPU costs from I/O in benchmarks.
+ *
+ * The files and directories are kept in maps sharded by path hash, so
+ * that concurrent operations on unrelated files do not contend on a
+ * single global mutex. Multi-path operations (listing, moving or
+ * removing directories) lock one shard at a time and are not atomic with
+ * respect to concurrent modifications of the affected paths, matching
+ * the guarantees of the other backends.
+ */
+class MemFilesystem {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  MemFilesystem();
+
+  /** Destructor. */
+  ~MemFilesystem();
+
+  /* ********************************* */
+  /*                 API               */
+  /* ********************************* */
+
+  /**
+   * Creates a directory.
+   *
+   * @param uri The URI of the directory.
+   * @return Status
+   */
+  Status create_dir(const URI& uri);
+
+  /**
+   * Creates an empty file.
+   *
+   * @param uri The URI of the file.
+   * @return Status
+   */
+  Status touch(const URI& uri);
+
+  /**
+   * Retrieves the size of a file.
+   *
+   * @param uri The URI of the file.
+   * @param size Set to the file size.
+   * @return Status
+   */
+  Status file_size(const URI& uri, uint64_t* size) const;
+
+  /** Returns `true` if the URI is an existing directory. */
+  bool is_dir(const URI& uri) const;
+
+  /** Returns `true` if the URI is an existing file. */
+  bool is_file(const URI& uri) const;
+
+  /**
+   * Lists the immediate children (files and directories) of a directory.
+   *
+   * @param parent The URI of the directory.
+   * @param paths Set to the URI strings of the children.
+   * @return Status
+   */
+  Status ls(const URI& parent, std::vector<std::string>* paths) const;
+
+  /**
+   * Renames a file or directory.
+   *
+   * @param old_uri The URI of the old path.
+   * @param new_uri The URI of the new path.
+   * @return Status
+   */
+  Status move_path(const URI& old_uri, const URI& new_uri);
+
+  /**
+   * Reads from a file.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset to read from.
+   * @param buffer The buffer to read into.
+   * @param nbytes The number of bytes to read.
+   * @return Status
+   */
+  Status read(
+      const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
+
+  /**
+   * Removes a directory and all its contents.
+   *
+   * @param uri The URI of the directory.
+   * @return Status
+   */
+  Status remove_dir(const URI& uri);
+
+  /**
+   * Removes a file.
+   *
+   * @param uri The URI of the file.
+   * @return Status
+   */
+  Status remove_file(const URI& uri);
+
+  /**
+   * Appends to the end of a file, creating it if it does not exist.
+   *
+   * @param uri The URI of the file.
+   * @param buffer The buffer with the bytes to write.
+   * @param buffer_size The number of bytes to write.
+   * @return Status
+   */
+  Status write(const URI& uri, const void* buffer, uint64_t buffer_size);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** An in-memory file. */
+  struct File {
+    /** The file contents. */
+    std::vector<uint8_t> data_;
+  };
+
+  /** A shard of the path registry, guarded by its own mutex. */
+  struct Shard {
+    /** The files of the shard, indexed by their URI string. */
+    std::map<std::string, File> files_;
+
+    /** The directories of the shard (URI strings). */
+    std::set<std::string> dirs_;
+
+    /** Protects `files_` and `dirs_`. */
+    mutable std::mutex mtx_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The path registry shards. */
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the shard that owns the input path. */
+  Shard* shard(const std::string& path) const;
+
+  /** Returns the path without any trailing slash. */
+  static std::string normalize(const std::string& path);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_MEM_FILESYSTEM_H
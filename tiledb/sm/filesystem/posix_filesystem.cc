@@ -40,9 +40,19 @@
 #include <dirent.h>
 
 #include <ftw.h>
+#include <sys/mman.h>
 
+#ifdef __linux__
+#include <linux/aio_abi.h>
+#include <sys/syscall.h>
+#endif
+
+#include <climits>
 #include <fstream>
 #include <iostream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
 namespace tiledb {
 namespace sm {
@@ -105,6 +115,160 @@ uint64_t write_all(int fd, const void* buffer, uint64_t nbytes) {
   return written;
 }
 
+/** The maximum number of file descriptors the read path keeps open. */
+static const uint64_t fd_cache_capacity = 128;
+
+/** An entry of the file descriptor cache. */
+struct FDCacheEntry {
+  /** The open (read-only) file descriptor. */
+  int fd_;
+
+  /** The number of reads currently using the descriptor. */
+  uint64_t users_;
+
+  /** `false` if the entry has been invalidated or evicted. */
+  bool cached_;
+
+  /** The path the descriptor was opened on. */
+  std::string path_;
+
+  /** The position of the entry in the LRU list (valid while cached). */
+  std::list<FDCacheEntry*>::iterator lru_it_;
+};
+
+/**
+ * A bounded, thread-safe LRU cache of read-only file descriptors,
+ * keyed by path. The read path used to open and close the file on
+ * every call, so a query touching many tiles of one attribute file
+ * paid an open/close syscall pair per tile; caching the descriptor
+ * leaves only the `pread` itself. Sharing one descriptor between
+ * concurrent reads is safe, as `pread` does not use the file offset.
+ *
+ * An entry is invalidated when its file, or a directory above it,
+ * gets moved or removed; a descriptor that is in use survives the
+ * invalidation (reads already in flight complete on the old file)
+ * and gets closed upon its release.
+ */
+class FDCache {
+ public:
+  /** Destructor. Closes the cached descriptors. */
+  ~FDCache() {
+    for (auto& entry : entries_) {
+      ::close(entry.second->fd_);
+      delete entry.second;
+    }
+  }
+
+  /**
+   * Retrieves a descriptor for the input path, opening the file if it
+   * is not cached. The entry must be given back with `release` after
+   * the read completes.
+   *
+   * @param path The file path.
+   * @param entry The cache entry with the descriptor.
+   * @return Status
+   */
+  Status acquire(const std::string& path, FDCacheEntry** entry) {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+      auto e = it->second;
+      e->users_++;
+      lru_.splice(lru_.begin(), lru_, e->lru_it_);
+      *entry = e;
+      return Status::Ok();
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot read from file; ") + strerror(errno)));
+    }
+
+    auto e = new FDCacheEntry();
+    e->fd_ = fd;
+    e->users_ = 1;
+    e->cached_ = true;
+    e->path_ = path;
+    lru_.push_front(e);
+    e->lru_it_ = lru_.begin();
+    entries_[path] = e;
+    evict();
+
+    *entry = e;
+    return Status::Ok();
+  }
+
+  /** Gives back an acquired entry. */
+  void release(FDCacheEntry* entry) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    entry->users_--;
+    if (!entry->cached_ && entry->users_ == 0) {
+      ::close(entry->fd_);
+      delete entry;
+    }
+  }
+
+  /**
+   * Invalidates the entries of the input path and of all the paths
+   * under it (when the path is a directory).
+   */
+  void invalidate(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      const auto& p = it->first;
+      bool match = p.size() >= path.size() &&
+                   p.compare(0, path.size(), path) == 0 &&
+                   (p.size() == path.size() || p[path.size()] == '/');
+      if (!match) {
+        ++it;
+        continue;
+      }
+      auto e = it->second;
+      lru_.erase(e->lru_it_);
+      e->cached_ = false;
+      if (e->users_ == 0) {
+        ::close(e->fd_);
+        delete e;
+      }
+      it = entries_.erase(it);
+    }
+  }
+
+ private:
+  /**
+   * Closes descriptors beyond the capacity, least recently used and
+   * not in use first. Must be called with `mtx_` held.
+   */
+  void evict() {
+    while (entries_.size() > fd_cache_capacity) {
+      auto it = lru_.rbegin();
+      while (it != lru_.rend() && (*it)->users_ > 0)
+        ++it;
+      if (it == lru_.rend())  // Every entry is in use
+        break;
+      auto e = *it;
+      entries_.erase(e->path_);
+      lru_.erase(e->lru_it_);
+      ::close(e->fd_);
+      delete e;
+    }
+  }
+
+  /** Protects the cache state. */
+  std::mutex mtx_;
+
+  /** The cached entries, keyed by path. */
+  std::unordered_map<std::string, FDCacheEntry*> entries_;
+
+  /** The cached entries in LRU order (most recently used first). */
+  std::list<FDCacheEntry*> lru_;
+};
+
+/** The process-wide file descriptor cache of the read path. */
+static FDCache fd_cache;
+
 void adjacent_slashes_dedup(std::string* path) {
   assert(utils::starts_with(*path, "file://"));
   path->erase(
@@ -203,6 +367,7 @@ int unlink_cb(
 }
 
 Status remove_dir(const std::string& path) {
+  fd_cache.invalidate(path);
   int rc = nftw(path.c_str(), unlink_cb, 64, FTW_DEPTH | FTW_PHYS);
   if (rc)
     return LOG_STATUS(Status::IOError(
@@ -212,6 +377,7 @@ Status remove_dir(const std::string& path) {
 }
 
 Status remove_file(const std::string& path) {
+  fd_cache.invalidate(path);
   if (remove(path.c_str()) != 0) {
     return LOG_STATUS(Status::IOError(
         std::string("Cannot delete file '") + path + "'; " + strerror(errno)));
@@ -304,6 +470,10 @@ Status ls(const std::string& path, std::vector<std::string>* paths) {
 }
 
 Status move_path(const std::string& old_path, const std::string& new_path) {
+  // Descriptors cached on the old path no longer refer to it; ones
+  // cached on the new path would refer to the overwritten file
+  fd_cache.invalidate(old_path);
+  fd_cache.invalidate(new_path);
   if (rename(old_path.c_str(), new_path.c_str()) != 0) {
     return LOG_STATUS(
         Status::IOError(std::string("Cannot move path: ") + strerror(errno)));
@@ -365,14 +535,74 @@ void purge_dots_from_path(std::string* path) {
     *path += std::string("/") + t;
 }
 
-Status read(
-    const std::string& path, uint64_t offset, void* buffer, uint64_t nbytes) {
+Status mmap(
+    const std::string& path, uint64_t offset, uint64_t nbytes, void** buffer) {
   // Open file
   int fd = open(path.c_str(), O_RDONLY);
   if (fd == -1) {
+    return LOG_STATUS(
+        Status::IOError(std::string("Cannot map file; ") + strerror(errno)));
+  }
+  if (offset > (uint64_t)std::numeric_limits<off_t>::max()) {
+    close(fd);
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot map file ' ") + path.c_str() +
+        "'; offset > typemax(off_t)"));
+  }
+
+  // Validate the region against the file size - accessing a mapping
+  // past the end of the file faults instead of erroring
+  struct stat st;
+  if (fstat(fd, &st) == -1 || offset + nbytes > (uint64_t)st.st_size) {
+    close(fd);
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot map file '") + path.c_str() +
+        "'; mapped region exceeds the file size"));
+  }
+
+  // The mapping offset must be a multiple of the page size
+  auto page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+  uint64_t delta = offset % page_size;
+  void* addr = ::mmap(
+      nullptr,
+      nbytes + delta,
+      PROT_READ,
+      MAP_SHARED,
+      fd,
+      (off_t)(offset - delta));
+
+  // Close file
+  int close_ret = close(fd);
+  if (addr == MAP_FAILED) {
     return LOG_STATUS(Status::IOError(
-        std::string("Cannot read from file; ") + strerror(errno)));
+        std::string("Cannot map file '") + path.c_str() + "'; " +
+        strerror(errno)));
+  }
+  if (close_ret) {
+    ::munmap(addr, nbytes + delta);
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot close mapped file '") + path.c_str() + "'; " +
+        strerror(errno)));
   }
+
+  *buffer = (char*)addr + delta;
+  return Status::Ok();
+}
+
+Status munmap(void* buffer, uint64_t nbytes) {
+  // Recover the page-aligned mapping start
+  auto page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+  uint64_t delta = (uint64_t)((uintptr_t)buffer % page_size);
+  if (::munmap((char*)buffer - delta, nbytes + delta)) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot unmap file region; ") + strerror(errno)));
+  }
+
+  return Status::Ok();
+}
+
+Status read(
+    const std::string& path, uint64_t offset, void* buffer, uint64_t nbytes) {
   if (offset > std::numeric_limits<off_t>::max()) {
     return LOG_STATUS(Status::IOError(
         std::string("Cannot read from file ' ") + path.c_str() +
@@ -383,20 +613,176 @@ Status read(
         std::string("Cannot read from file ' ") + path.c_str() +
         "'; nbytes > SSIZE_MAX"));
   }
-  uint64_t bytes_read = read_all(fd, buffer, nbytes, offset);
+
+  // Get a (cached) file descriptor
+  FDCacheEntry* entry;
+  RETURN_NOT_OK(fd_cache.acquire(path, &entry));
+
+  uint64_t bytes_read = read_all(entry->fd_, buffer, nbytes, offset);
+  fd_cache.release(entry);
   if (bytes_read != nbytes) {
     return LOG_STATUS(Status::IOError(
         std::string("Cannot read from file '") + path.c_str() +
         "'; File reading error"));
   }
-  // Close file
-  if (close(fd)) {
+  return Status::Ok();
+}
+
+Status read_at_most(
+    const std::string& path,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    uint64_t* nbytes_read) {
+  if (offset > std::numeric_limits<off_t>::max()) {
     return LOG_STATUS(Status::IOError(
-        std::string("Cannot read from file; ") + strerror(errno)));
+        std::string("Cannot read from file ' ") + path.c_str() +
+        "'; offset > typemax(off_t)"));
   }
+  if (nbytes > SSIZE_MAX) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file ' ") + path.c_str() +
+        "'; nbytes > SSIZE_MAX"));
+  }
+
+  // Get a (cached) file descriptor
+  FDCacheEntry* entry;
+  RETURN_NOT_OK(fd_cache.acquire(path, &entry));
+
+  // Read until `nbytes` bytes are read or the end of the file is reached
+  auto bytes = reinterpret_cast<char*>(buffer);
+  uint64_t nread = 0;
+  ssize_t actual_read = 0;
+  do {
+    actual_read =
+        ::pread(entry->fd_, bytes + nread, nbytes - nread, offset + nread);
+    if (actual_read > 0)
+      nread += (uint64_t)actual_read;
+  } while (actual_read > 0 && nread < nbytes);
+  fd_cache.release(entry);
+
+  if (actual_read == -1) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file '") + path.c_str() +
+        "'; File reading error"));
+  }
+
+  *nbytes_read = nread;
+
   return Status::Ok();
 }
 
+#ifdef __linux__
+
+/** Thin wrapper around the Linux native AIO `io_setup` syscall. */
+static int io_setup(unsigned nr_events, aio_context_t* ctx) {
+  return (int)syscall(__NR_io_setup, nr_events, ctx);
+}
+
+/** Thin wrapper around the Linux native AIO `io_destroy` syscall. */
+static int io_destroy(aio_context_t ctx) {
+  return (int)syscall(__NR_io_destroy, ctx);
+}
+
+/** Thin wrapper around the Linux native AIO `io_submit` syscall. */
+static int io_submit(aio_context_t ctx, long nr, struct iocb** iocbpp) {
+  return (int)syscall(__NR_io_submit, ctx, nr, iocbpp);
+}
+
+/** Thin wrapper around the Linux native AIO `io_getevents` syscall. */
+static int io_getevents(
+    aio_context_t ctx,
+    long min_nr,
+    long nr,
+    struct io_event* events,
+    struct timespec* timeout) {
+  return (int)syscall(__NR_io_getevents, ctx, min_nr, nr, events, timeout);
+}
+
+Status read_batch(
+    const std::string& path, const std::vector<ReadRegion>& regions) {
+  if (regions.empty())
+    return Status::Ok();
+
+  // Get a (cached) file descriptor
+  FDCacheEntry* entry;
+  RETURN_NOT_OK(fd_cache.acquire(path, &entry));
+  int fd = entry->fd_;
+
+  // Create the AIO context
+  auto region_num = (uint64_t)regions.size();
+  aio_context_t ctx = 0;
+  if (io_setup((unsigned)region_num, &ctx) != 0) {
+    fd_cache.release(entry);
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file '") + path +
+        "'; AIO context creation failed: " + strerror(errno)));
+  }
+
+  // Prepare one read request per region
+  std::vector<struct iocb> iocbs(region_num);
+  std::vector<struct iocb*> iocbps(region_num);
+  for (uint64_t i = 0; i < region_num; ++i) {
+    std::memset(&iocbs[i], 0, sizeof(struct iocb));
+    iocbs[i].aio_fildes = (uint32_t)fd;
+    iocbs[i].aio_lio_opcode = IOCB_CMD_PREAD;
+    iocbs[i].aio_buf = (uint64_t)(uintptr_t)regions[i].buffer_;
+    iocbs[i].aio_nbytes = regions[i].nbytes_;
+    iocbs[i].aio_offset = (int64_t)regions[i].offset_;
+    iocbs[i].aio_data = i;
+    iocbps[i] = &iocbs[i];
+  }
+
+  // Submit all reads in as few syscalls as the kernel permits and reap
+  // the completions
+  Status st = Status::Ok();
+  uint64_t submitted = 0, completed = 0;
+  std::vector<struct io_event> events(region_num);
+  while (completed < region_num) {
+    if (submitted < region_num) {
+      auto ret =
+          io_submit(ctx, (long)(region_num - submitted), &iocbps[submitted]);
+      if (ret <= 0) {
+        st = LOG_STATUS(Status::IOError(
+            std::string("Cannot read from file '") + path +
+            "'; AIO submission failed: " + strerror(errno)));
+        break;
+      }
+      submitted += (uint64_t)ret;
+    }
+
+    auto ret = io_getevents(
+        ctx, 1, (long)(submitted - completed), &events[0], nullptr);
+    if (ret <= 0) {
+      st = LOG_STATUS(Status::IOError(
+          std::string("Cannot read from file '") + path +
+          "'; AIO completion failed: " + strerror(errno)));
+      break;
+    }
+
+    // Check for failed or short reads
+    for (int e = 0; e < ret && st.ok(); ++e) {
+      auto idx = (uint64_t)events[e].data;
+      if (events[e].res != (int64_t)regions[idx].nbytes_)
+        st = LOG_STATUS(Status::IOError(
+            std::string("Cannot read from file '") + path +
+            "'; File reading error"));
+    }
+    if (!st.ok())
+      break;
+    completed += (uint64_t)ret;
+  }
+
+  // Clean up. `io_destroy` also cancels or waits for any reads that are
+  // still in flight after an error.
+  io_destroy(ctx);
+  fd_cache.release(entry);
+
+  return st;
+}
+
+#endif
+
 Status sync(const std::string& path) {
   // Open file
   int fd = -1;
@@ -476,6 +862,86 @@ Status write(
   return Status::Ok();
 }
 
+#ifdef __linux__
+
+/** The file offset, size and memory alignment required for direct I/O. */
+static const uint64_t direct_io_alignment = 4096;
+
+/** The size of the aligned bounce buffer used by `write_direct`. */
+static const uint64_t direct_io_bounce_size = 4 * 1024 * 1024;
+
+Status write_direct(
+    const std::string& path, const void* buffer, uint64_t buffer_size) {
+  // Get the current file size; direct I/O is possible only while the
+  // write offset remains block-aligned
+  uint64_t offset = 0;
+  if (is_file(path))
+    RETURN_NOT_OK(file_size(path, &offset));
+
+  auto direct_size = (buffer_size / direct_io_alignment) * direct_io_alignment;
+  if (offset % direct_io_alignment != 0 || direct_size == 0)
+    return write(path, buffer, buffer_size);
+
+  // Open file
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_DIRECT, S_IRWXU);
+  if (fd == -1) {
+    // The filesystem may not support direct I/O at all
+    if (errno == EINVAL)
+      return write(path, buffer, buffer_size);
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot write to file '") + path + "'; " +
+        strerror(errno)));
+  }
+
+  // Allocate the aligned bounce buffer
+  void* bounce = nullptr;
+  uint64_t bounce_size = std::min(direct_size, direct_io_bounce_size);
+  if (posix_memalign(&bounce, direct_io_alignment, bounce_size) != 0) {
+    close(fd);
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot write to file '") + path +
+        "'; Aligned buffer allocation failed"));
+  }
+
+  // Write the aligned part of the buffer through the bounce buffer
+  auto buffer_bytes_ptr = static_cast<const char*>(buffer);
+  uint64_t written = 0;
+  while (written < direct_size) {
+    uint64_t nbytes = std::min(direct_size - written, bounce_size);
+    std::memcpy(bounce, buffer_bytes_ptr + written, nbytes);
+    ssize_t actual = ::pwrite(fd, bounce, nbytes, (off_t)(offset + written));
+    if (actual != (ssize_t)nbytes) {
+      auto write_errno = errno;
+      std::free(bounce);
+      close(fd);
+      // The filesystem may accept O_DIRECT on open but reject the
+      // writes; fall back to buffered I/O if nothing has been written
+      if (written == 0 && actual == -1 && write_errno == EINVAL)
+        return write(path, buffer, buffer_size);
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot write to file '") + path +
+          "'; File writing error"));
+    }
+    written += nbytes;
+  }
+  std::free(bounce);
+
+  // Close file
+  if (close(fd) != 0) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot close file '") + path + "'; " + strerror(errno)));
+  }
+
+  // Append the unaligned tail with buffered I/O
+  if (direct_size < buffer_size)
+    return write(
+        path, buffer_bytes_ptr + direct_size, buffer_size - direct_size);
+
+  return Status::Ok();
+}
+
+#endif
+
 }  // namespace posix
 
 }  // namespace sm
@@ -39,6 +39,7 @@
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/filesystem/read_region.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/uri.h"
 
@@ -149,6 +150,29 @@ bool is_file(const std::string& path);
  */
 Status ls(const std::string& path, std::vector<std::string>* paths);
 
+/**
+ * Memory-maps a region of a file for reading, giving the caller direct
+ * access to the page cache without an intermediate copy. The mapping is
+ * read-only. The region must be unmapped with `munmap`.
+ *
+ * @param path The name of the file.
+ * @param offset The offset in the file where the mapped region starts.
+ * @param nbytes The size of the mapped region.
+ * @param buffer Set to the start of the mapped region.
+ * @return Status
+ */
+Status mmap(
+    const std::string& path, uint64_t offset, uint64_t nbytes, void** buffer);
+
+/**
+ * Unmaps a file region previously mapped with `mmap`.
+ *
+ * @param buffer The start of the mapped region.
+ * @param nbytes The size of the mapped region.
+ * @return Status
+ */
+Status munmap(void* buffer, uint64_t nbytes);
+
 /**
  * Move a given filesystem path.
  *
@@ -172,7 +196,11 @@ Status move_path(const std::string& old_path, const std::string& new_path);
 void purge_dots_from_path(std::string* path);
 
 /**
- * Reads data from a file into a buffer.
+ * Reads data from a file into a buffer. The file descriptor is served
+ * from a bounded process-wide LRU cache keyed by path, so that a query
+ * reading many tiles of the same file does not pay an open/close
+ * syscall pair per read. The cached descriptors are invalidated when
+ * the file (or a directory above it) gets moved or removed.
  *
  * @param path The name of the file.
  * @param offset The offset in the file from which the read will start.
@@ -183,6 +211,44 @@ void purge_dots_from_path(std::string* path);
 Status read(
     const std::string& path, uint64_t offset, void* buffer, uint64_t nbytes);
 
+/**
+ * Reads up to `nbytes` bytes from a file into a buffer, without failing
+ * if the file ends before `nbytes` bytes are available. The file
+ * descriptor is served from the same LRU cache as `read`.
+ *
+ * @param path The name of the file.
+ * @param offset The offset in the file from which the read will start.
+ * @param buffer The buffer into which the data will be written.
+ * @param nbytes The maximum size of the data to be read from the file.
+ * @param nbytes_read The number of bytes actually read.
+ * @return Status.
+ */
+Status read_at_most(
+    const std::string& path,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    uint64_t* nbytes_read);
+
+#ifdef __linux__
+/**
+ * Reads multiple regions from a file, submitting all reads to the kernel
+ * in a single batch via Linux native AIO (`io_submit`), instead of one
+ * blocking `pread` syscall per region. On buffered files the kernel may
+ * still serve the reads synchronously within the submission, but the
+ * batching alone removes the syscall-per-region overhead that caps
+ * small-region read IOPS. The function may fail if the system-wide AIO
+ * context limit (`/proc/sys/fs/aio-max-nr`) has been reached, in which
+ * case the caller should fall back to issuing the reads individually.
+ *
+ * @param path The name of the file.
+ * @param regions The regions to read. The regions must not overlap.
+ * @return Status.
+ */
+Status read_batch(
+    const std::string& path, const std::vector<ReadRegion>& regions);
+#endif
+
 /**
  * Syncs a file or directory.
  *
@@ -204,6 +270,25 @@ Status sync(const std::string& path);
  */
 Status write(const std::string& path, const void* buffer, uint64_t buffer_size);
 
+#ifdef __linux__
+/**
+ * Appends the input buffer to a file with direct I/O (`O_DIRECT`),
+ * bypassing the page cache, so that large sequential writes neither
+ * evict hot pages nor trigger dirty-page writeback stalls for
+ * co-located readers. The buffer is staged through an aligned bounce
+ * buffer; the unaligned tail of the write (and the entire write, if the
+ * current file size is not block-aligned or the filesystem does not
+ * support direct I/O) falls back to buffered `write`.
+ *
+ * @param path The name of the file.
+ * @param buffer The input buffer.
+ * @param buffer_size The size of the input buffer.
+ * @return Status
+ */
+Status write_direct(
+    const std::string& path, const void* buffer, uint64_t buffer_size);
+#endif
+
 }  // namespace posix
 
 }  // namespace sm
@@ -33,8 +33,11 @@
 #ifdef HAVE_S3
 
 #include <boost/interprocess/streams/bufferstream.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
@@ -49,16 +52,53 @@
 namespace tiledb {
 namespace sm {
 
+/* ********************************* */
+/*          AWS SDK INSTANCE         */
+/* ********************************* */
+
+namespace {
+
+/**
+ * The process-wide AWS SDK instance, shared by all S3 backends (and
+ * hence all contexts). The SDK is initialized when the first backend
+ * connects and torn down when the last one disconnects, instead of
+ * each backend running its own init/shutdown cycle.
+ */
+std::mutex aws_sdk_mtx;
+uint64_t aws_sdk_use_count = 0;
+Aws::SDKOptions aws_sdk_options;
+
+/** Initializes the AWS SDK if this is the first user. */
+void aws_sdk_acquire() {
+  std::lock_guard<std::mutex> lock(aws_sdk_mtx);
+  if (aws_sdk_use_count++ == 0)
+    Aws::InitAPI(aws_sdk_options);
+}
+
+/** Shuts down the AWS SDK if this was the last user. */
+void aws_sdk_release() {
+  std::lock_guard<std::mutex> lock(aws_sdk_mtx);
+  if (aws_sdk_use_count > 0 && --aws_sdk_use_count == 0)
+    Aws::ShutdownAPI(aws_sdk_options);
+}
+
+}  // namespace
+
 /* ********************************* */
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
 
 S3::S3() {
   client_ = nullptr;
+  max_parallel_ops_ = 0;
   multipart_part_size_ = 0;
 }
 
 S3::~S3() {
+  // Wait for any in-flight part uploads
+  for (auto& kv : multipart_upload_tasks_)
+    vfs_thread_pool_->wait_all(kv.second);
+
   for (auto& buff : file_buffers_)
     delete buff.second;
 }
@@ -73,11 +113,12 @@ Status S3::init(const S3Config& s3_config, ThreadPool* thread_pool) {
         Status::S3Error("Can't initialize with null thread pool."));
   }
 
-  Aws::InitAPI(options_);
+  aws_sdk_acquire();
 
   vfs_thread_pool_ = thread_pool;
+  max_parallel_ops_ = std::max(s3_config.max_parallel_ops_, uint64_t(1));
   multipart_part_size_ = s3_config.multipart_part_size_;
-  file_buffer_size_ = multipart_part_size_ * thread_pool->num_threads();
+  file_buffer_size_ = multipart_part_size_ * max_parallel_ops_;
 
   Aws::Client::ClientConfiguration config;
   if (!s3_config.region_.empty())
@@ -89,6 +130,17 @@ Status S3::init(const S3Config& s3_config, ThreadPool* thread_pool) {
                                                   Aws::Http::Scheme::HTTPS;
   config.connectTimeoutMs = s3_config.connect_timeout_ms_;
   config.requestTimeoutMs = s3_config.request_timeout_ms_;
+  config.maxConnections = s3_config.max_connections_;
+
+  // Share one transfer executor across all S3 clients in the process, so
+  // that multiple VFS instances draw from a single bounded pool of
+  // transfer threads instead of each spawning their own. The executor is
+  // sized by the first client to initialize.
+  static std::shared_ptr<Aws::Utils::Threading::PooledThreadExecutor>
+      transfer_executor =
+          Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+              constants::s3_allocation_tag, s3_config.max_connections_);
+  config.executor = transfer_executor;
 
   config.retryStrategy = Aws::MakeShared<Aws::Client::DefaultRetryStrategy>(
       constants::s3_allocation_tag,
@@ -153,6 +205,10 @@ Status S3::remove_bucket(const URI& bucket) const {
 }
 
 Status S3::disconnect() {
+  // Wait for all in-flight part uploads
+  for (auto& kv : multipart_upload_tasks_)
+    RETURN_NOT_OK(wait_multipart_tasks(kv.first));
+
   for (const auto& record : multipart_upload_request_) {
     auto completed_multipart_upload = multipart_upload_[record.first];
     auto complete_multipart_upload_request = record.second;
@@ -171,7 +227,7 @@ Status S3::disconnect() {
           complete_multipart_upload_outcome.GetError().GetMessage().c_str()));
     }
   }
-  Aws::ShutdownAPI(options_);
+  aws_sdk_release();
 
   return Status::Ok();
 }
@@ -197,6 +253,9 @@ Status S3::flush_object(const URI& uri) {
   Aws::Http::URI aws_uri = uri.c_str();
   std::string path_c_str = aws_uri.GetPath().c_str();
 
+  // Wait for the in-flight part uploads of this object (if any)
+  RETURN_NOT_OK(wait_multipart_tasks(path_c_str));
+
   // Do nothing - empty object
   auto multipart_upload_it = multipart_upload_.find(path_c_str);
   if (multipart_upload_it == multipart_upload_.end())
@@ -232,6 +291,7 @@ Status S3::flush_object(const URI& uri) {
   multipart_upload_request_.erase(multipart_upload_request_it);
   multipart_upload_.erase(multipart_upload_it);
   multipart_upload_completed_parts_.erase(path_c_str);
+  multipart_upload_tasks_.erase(path_c_str);
 
   //  fails when flushing directories or removed files
   if (!complete_multipart_upload_outcome.IsSuccess()) {
@@ -313,6 +373,21 @@ Status S3::ls(
     std::vector<std::string>* paths,
     const std::string& delimiter,
     int max_paths) const {
+  return ls(
+      prefix,
+      [paths](const std::string& path) {
+        paths->push_back(path);
+        return Status::Ok();
+      },
+      delimiter,
+      max_paths);
+}
+
+Status S3::ls(
+    const URI& prefix,
+    std::function<Status(const std::string&)> cb,
+    const std::string& delimiter,
+    int max_paths) const {
   auto prefix_str = prefix.to_string();
   if (!prefix.is_s3()) {
     return LOG_STATUS(
@@ -328,23 +403,49 @@ Status S3::ls(
   list_objects_request.SetDelimiter(delimiter.c_str());
   if (max_paths != -1)
     list_objects_request.SetMaxKeys(max_paths);
-  auto list_objects_outcome = client_->ListObjects(list_objects_request);
 
-  if (!list_objects_outcome.IsSuccess())
-    return LOG_STATUS(Status::S3Error(
-        std::string("Error while listing with prefix '") + prefix_str +
-        "' and delimiter '" + delimiter + "'"));
+  int emitted = 0;
+  bool truncated = false;
+  do {
+    auto list_objects_outcome = client_->ListObjects(list_objects_request);
 
-  for (const auto& object : list_objects_outcome.GetResult().GetContents()) {
-    std::string file(object.GetKey().c_str());
-    paths->push_back("s3://" + aws_auth + add_front_slash(file));
-  }
+    if (!list_objects_outcome.IsSuccess())
+      return LOG_STATUS(Status::S3Error(
+          std::string("Error while listing with prefix '") + prefix_str +
+          "' and delimiter '" + delimiter + "'"));
+    const auto& result = list_objects_outcome.GetResult();
+
+    std::string last_key;
+    for (const auto& object : result.GetContents()) {
+      std::string file(object.GetKey().c_str());
+      last_key = file;
+      RETURN_NOT_OK(cb("s3://" + aws_auth + add_front_slash(file)));
+      if (max_paths != -1 && ++emitted >= max_paths)
+        return Status::Ok();
+    }
 
-  for (const auto& object :
-       list_objects_outcome.GetResult().GetCommonPrefixes()) {
-    std::string file(object.GetPrefix().c_str());
-    paths->push_back("s3://" + aws_auth + add_front_slash(file));
-  }
+    for (const auto& object : result.GetCommonPrefixes()) {
+      std::string file(object.GetPrefix().c_str());
+      RETURN_NOT_OK(cb("s3://" + aws_auth + add_front_slash(file)));
+      if (max_paths != -1 && ++emitted >= max_paths)
+        return Status::Ok();
+    }
+
+    // Fetch the next page of a truncated listing. `NextMarker` is
+    // returned only when a delimiter is set; otherwise the last
+    // returned key serves as the continuation marker.
+    truncated = result.GetIsTruncated();
+    if (truncated) {
+      std::string next_marker = result.GetNextMarker().c_str();
+      if (next_marker.empty())
+        next_marker = last_key;
+      if (next_marker.empty())
+        return LOG_STATUS(Status::S3Error(
+            std::string("Error while listing with prefix '") + prefix_str +
+            "'; truncated listing returned no continuation marker"));
+      list_objects_request.SetMarker(next_marker.c_str());
+    }
+  } while (truncated);
 
   return Status::Ok();
 }
@@ -401,6 +502,86 @@ Status S3::read(
         std::string("URI is not an S3 URI: " + uri.to_string())));
   }
 
+  auto path = uri.to_string();
+  std::unique_lock<std::mutex> lck(prefetch_mtx_);
+
+  // Bound the number of objects with tracked state
+  if (prefetch_states_.find(path) == prefetch_states_.end() &&
+      prefetch_states_.size() >= constants::s3_prefetch_max_objects)
+    prefetch_states_.erase(prefetch_states_.begin());
+  auto& state = prefetch_states_[path];
+
+  // Serve the read from the prefetch buffer upon a hit
+  if (!state.buffer_.empty() && (uint64_t)offset >= state.buffer_offset_ &&
+      (uint64_t)offset + length <= state.buffer_offset_ + state.buffer_.size()) {
+    std::memcpy(
+        buffer, &state.buffer_[offset - state.buffer_offset_], length);
+    state.next_offset_ = offset + length;
+    state.sequential_reads_++;
+    return Status::Ok();
+  }
+
+  // Track sequential accesses; a non-sequential read resets the state
+  if ((uint64_t)offset == state.next_offset_) {
+    state.sequential_reads_++;
+  } else {
+    state.sequential_reads_ = 0;
+    state.window_ = 0;
+    state.buffer_.clear();
+    state.buffer_.shrink_to_fit();
+  }
+  state.next_offset_ = offset + length;
+
+  // Prefetch with a geometrically growing window upon a sequential scan
+  if (state.sequential_reads_ >= constants::s3_prefetch_sequential_reads) {
+    auto window = std::min<uint64_t>(
+        std::max<uint64_t>(state.window_ * 2, 2 * length),
+        constants::s3_prefetch_max_window);
+    auto object_size = state.object_size_;
+
+    // Release the lock around network calls
+    lck.unlock();
+
+    if (object_size == 0)
+      RETURN_NOT_OK(this->object_size(uri, &object_size));
+    if (object_size > (uint64_t)offset)
+      window = std::min<uint64_t>(window, object_size - offset);
+
+    if (window > length) {
+      std::vector<char> prefetch_buffer(window);
+      RETURN_NOT_OK(read_object(uri, offset, &prefetch_buffer[0], window));
+      std::memcpy(buffer, &prefetch_buffer[0], length);
+
+      lck.lock();
+      auto& new_state = prefetch_states_[path];
+      new_state.buffer_ = std::move(prefetch_buffer);
+      new_state.buffer_offset_ = offset;
+      new_state.next_offset_ = offset + length;
+      new_state.object_size_ = object_size;
+      new_state.window_ = window;
+      return Status::Ok();
+    }
+
+    lck.lock();
+    prefetch_states_[path].object_size_ = object_size;
+  }
+
+  lck.unlock();
+
+  return read_object(uri, offset, buffer, length);
+}
+
+Status S3::read_at_most(
+    const URI& uri,
+    off_t offset,
+    void* buffer,
+    uint64_t length,
+    uint64_t* nbytes_read) const {
+  if (!uri.is_s3()) {
+    return LOG_STATUS(Status::S3Error(
+        std::string("URI is not an S3 URI: " + uri.to_string())));
+  }
+
   Aws::Http::URI aws_uri = uri.c_str();
   Aws::S3::Model::GetObjectRequest get_object_request;
   get_object_request.WithBucket(aws_uri.GetAuthority())
@@ -422,10 +603,15 @@ Status S3::read(
         std::string("\nError message:  ") +
         get_object_outcome.GetError().GetMessage().c_str()));
   }
-  if ((uint64_t)get_object_outcome.GetResult().GetContentLength() != length) {
+
+  // The returned range gets truncated at the end of the object
+  auto content_length =
+      (uint64_t)get_object_outcome.GetResult().GetContentLength();
+  if (content_length > length) {
     return LOG_STATUS(Status::S3Error(
-        std::string("Read operation returned different size of bytes.")));
+        std::string("Read operation returned more bytes than requested.")));
   }
+  *nbytes_read = content_length;
 
   return Status::Ok();
 }
@@ -460,8 +646,44 @@ Status S3::remove_dir(const URI& uri) const {
   std::vector<std::string> paths;
   auto uri_dir = uri.join_path("");
   RETURN_NOT_OK(ls(uri_dir, &paths, ""));
-  for (const auto& p : paths)
-    RETURN_NOT_OK(remove_object(URI(p)));
+  if (paths.empty())
+    return Status::Ok();
+
+  // Delete the objects in batches of up to 1000 keys (the AWS cap per
+  // DeleteObjects request), instead of one round trip per object
+  Aws::Http::URI aws_uri = uri_dir.c_str();
+  const size_t batch_cap = 1000;
+  for (size_t i = 0; i < paths.size(); i += batch_cap) {
+    auto batch_num = std::min(batch_cap, paths.size() - i);
+    Aws::S3::Model::Delete delete_list;
+    for (size_t j = 0; j < batch_num; ++j) {
+      Aws::Http::URI path_uri = paths[i + j].c_str();
+      delete_list.AddObjects(
+          Aws::S3::Model::ObjectIdentifier().WithKey(path_uri.GetPath()));
+    }
+    Aws::S3::Model::DeleteObjectsRequest delete_objects_request;
+    delete_objects_request.SetBucket(aws_uri.GetAuthority());
+    delete_objects_request.SetDelete(std::move(delete_list));
+    auto delete_objects_outcome =
+        client_->DeleteObjects(delete_objects_request);
+    if (!delete_objects_outcome.IsSuccess()) {
+      return LOG_STATUS(Status::S3Error(
+          std::string("Failed to delete S3 directory '") + uri.c_str() +
+          std::string("'\nException:  ") +
+          delete_objects_outcome.GetError().GetExceptionName().c_str() +
+          std::string("\nError message:  ") +
+          delete_objects_outcome.GetError().GetMessage().c_str()));
+    }
+    const auto& errors = delete_objects_outcome.GetResult().GetErrors();
+    if (!errors.empty()) {
+      return LOG_STATUS(Status::S3Error(
+          std::string("Failed to delete S3 object '") +
+          errors.front().GetKey().c_str() +
+          std::string("'\nError message:  ") +
+          errors.front().GetMessage().c_str()));
+    }
+  }
+
   return Status::Ok();
 }
 
@@ -515,8 +737,12 @@ Status S3::write(const URI& uri, const void* buffer, uint64_t length) {
   RETURN_NOT_OK(fill_file_buffer(buff, buffer, length, &nbytes_filled));
 
   // Flush file buffer
-  if (buff->size() == file_buffer_size_)
+  if (buff->size() == file_buffer_size_) {
     RETURN_NOT_OK(flush_file_buffer(uri, buff, is_last_part));
+    // The flush may have handed the buffer off to the upload tasks and
+    // installed a fresh file buffer
+    RETURN_NOT_OK(get_file_buffer(uri, &buff));
+  }
 
   // Write chunks
   uint64_t new_length = length - nbytes_filled;
@@ -596,10 +822,88 @@ std::string S3::remove_front_slash(const std::string& path) const {
   return path;
 }
 
+Status S3::read_object(
+    const URI& uri, off_t offset, void* buffer, uint64_t length) const {
+  // Split large reads into concurrent range GETs, so that they are not
+  // bound by single-stream S3 throughput. Each part is at least a
+  // multipart part size, and the number of parts is capped at the
+  // maximum parallel operations.
+  if (length > constants::s3_min_parallel_read_size &&
+      vfs_thread_pool_ != nullptr) {
+    uint64_t num_parts = std::min(
+        max_parallel_ops_,
+        std::max<uint64_t>(length / multipart_part_size_, 1));
+    if (num_parts > 1) {
+      STATS_COUNTER_ADD(vfs_s3_read_num_parallelized, 1);
+
+      uint64_t part_size = utils::ceil(length, num_parts);
+      std::vector<std::future<Status>> results;
+      for (uint64_t i = 0; i < num_parts; i++) {
+        uint64_t begin = i * part_size,
+                 end = std::min((i + 1) * part_size - 1, length - 1);
+        uint64_t part_nbytes = end - begin + 1;
+        auto part_offset = offset + (off_t)begin;
+        auto part_buffer = reinterpret_cast<char*>(buffer) + begin;
+        results.push_back(vfs_thread_pool_->enqueue(
+            [this, &uri, part_offset, part_buffer, part_nbytes]() {
+              return read_object_range(
+                  uri, part_offset, part_buffer, part_nbytes);
+            }));
+      }
+
+      bool all_ok = vfs_thread_pool_->wait_all(results);
+      return all_ok ?
+                 Status::Ok() :
+                 LOG_STATUS(Status::S3Error("S3 parallel read error"));
+    }
+  }
+
+  return read_object_range(uri, offset, buffer, length);
+}
+
+Status S3::read_object_range(
+    const URI& uri, off_t offset, void* buffer, uint64_t length) const {
+  Aws::Http::URI aws_uri = uri.c_str();
+  Aws::S3::Model::GetObjectRequest get_object_request;
+  get_object_request.WithBucket(aws_uri.GetAuthority())
+      .WithKey(aws_uri.GetPath());
+  get_object_request.SetRange(("bytes=" + std::to_string(offset) + "-" +
+                               std::to_string(offset + length - 1))
+                                  .c_str());
+  get_object_request.SetResponseStreamFactory([buffer, length]() {
+    auto streamBuf = new boost::interprocess::bufferbuf((char*)buffer, length);
+    return Aws::New<Aws::IOStream>(constants::s3_allocation_tag, streamBuf);
+  });
+
+  auto get_object_outcome = client_->GetObject(get_object_request);
+  if (!get_object_outcome.IsSuccess()) {
+    return LOG_STATUS(Status::S3Error(
+        std::string("Failed to read S3 object ") + uri.c_str() +
+        std::string("\nException:  ") +
+        get_object_outcome.GetError().GetExceptionName().c_str() +
+        std::string("\nError message:  ") +
+        get_object_outcome.GetError().GetMessage().c_str()));
+  }
+  if ((uint64_t)get_object_outcome.GetResult().GetContentLength() != length) {
+    return LOG_STATUS(Status::S3Error(
+        std::string("Read operation returned different size of bytes.")));
+  }
+
+  return Status::Ok();
+}
+
 Status S3::flush_file_buffer(const URI& uri, Buffer* buff, bool last_part) {
   if (buff->size() > 0) {
-    RETURN_NOT_OK(write_multipart(uri, buff->data(), buff->size(), last_part));
-    buff->reset_size();
+    // Queue the parts of a full (non-terminal) buffer in the background,
+    // so that the caller keeps filling the next buffer while the parts
+    // upload. Only the last part must flush synchronously.
+    if (last_part) {
+      RETURN_NOT_OK(
+          write_multipart(uri, buff->data(), buff->size(), last_part));
+      buff->reset_size();
+    } else {
+      RETURN_NOT_OK(write_multipart_async(uri, buff));
+    }
   }
 
   return Status::Ok();
@@ -722,11 +1026,10 @@ Status S3::write_multipart(
   // Ensure that each thread is responsible for exactly multipart_part_size_
   // bytes (except if this is the last write_multipart, in which case the final
   // thread should write less), and cap the number of parallel operations at the
-  // thread pool size.
+  // configured maximum.
   uint64_t num_ops = last_part ? utils::ceil(length, multipart_part_size_) :
                                  (length / multipart_part_size_);
-  num_ops =
-      std::min(std::max(num_ops, uint64_t(1)), vfs_thread_pool_->num_threads());
+  num_ops = std::min(std::max(num_ops, uint64_t(1)), max_parallel_ops_);
 
   if (!last_part && length % multipart_part_size_ != 0) {
     return LOG_STATUS(
@@ -782,6 +1085,69 @@ Status S3::write_multipart(
   STATS_FUNC_OUT(vfs_s3_write_multipart);
 }
 
+Status S3::write_multipart_async(const URI& uri, Buffer* buff) {
+  // The buffer must consist of whole parts
+  uint64_t length = buff->size();
+  if (length % multipart_part_size_ != 0) {
+    return LOG_STATUS(
+        Status::S3Error("Length not evenly divisible by part length"));
+  }
+
+  Aws::Http::URI aws_uri = uri.c_str();
+  auto& path = aws_uri.GetPath();
+  std::string path_c_str = path.c_str();
+  if (multipart_upload_IDs_.find(path_c_str) == multipart_upload_IDs_.end()) {
+    // Delete file if it exists (overwrite) and initiate multipart request
+    if (is_object(uri))
+      RETURN_NOT_OK(remove_object(uri));
+    RETURN_NOT_OK(initiate_multipart_request(aws_uri));
+  }
+
+  // Get the upload ID
+  auto upload_id = multipart_upload_IDs_[path_c_str];
+
+  // Bound the number of in-flight parts per object
+  auto& tasks = multipart_upload_tasks_[path_c_str];
+  if (tasks.size() >= max_parallel_ops_)
+    RETURN_NOT_OK(wait_multipart_tasks(path_c_str));
+
+  // Queue one upload task per part, handing the buffer off to the tasks
+  // (shared ownership keeps it alive until the last part uploads) and
+  // installing a fresh file buffer for the object
+  uint64_t num_parts = length / multipart_part_size_;
+  std::shared_ptr<Buffer> part_buff(buff);
+  file_buffers_[uri.to_string()] = new Buffer();
+  int part_num_base = multipart_upload_part_number_[path_c_str];
+  for (uint64_t i = 0; i < num_parts; i++) {
+    auto part_data = (char*)part_buff->data() + i * multipart_part_size_;
+    auto part_size = multipart_part_size_;
+    int part_num = static_cast<int>(part_num_base + i);
+    tasks.push_back(vfs_thread_pool_->enqueue(
+        [this, uri, part_buff, part_data, part_size, upload_id, part_num]() {
+          return make_upload_part_req(
+              uri, part_data, part_size, upload_id, part_num);
+        }));
+  }
+  multipart_upload_part_number_[path_c_str] += num_parts;
+
+  STATS_COUNTER_ADD(vfs_s3_write_num_parallelized, 1);
+
+  return Status::Ok();
+}
+
+Status S3::wait_multipart_tasks(const std::string& path) {
+  auto it = multipart_upload_tasks_.find(path);
+  if (it == multipart_upload_tasks_.end() || it->second.empty())
+    return Status::Ok();
+
+  bool all_ok = vfs_thread_pool_->wait_all(it->second);
+  it->second.clear();
+
+  return all_ok ? Status::Ok() :
+                  LOG_STATUS(Status::S3Error(
+                      "S3 multipart part upload failed for object " + path));
+}
+
 Status S3::make_upload_part_req(
     const URI& uri,
     const void* buffer,
@@ -60,6 +60,7 @@
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/GetBucketLocationRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadBucketRequest.h>
@@ -68,6 +69,7 @@
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/UploadPartRequest.h>
 #include <sys/types.h>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -92,7 +94,9 @@ class S3 {
       scheme_ = constants::s3_scheme;
       endpoint_override_ = constants::s3_endpoint_override;
       use_virtual_addressing_ = constants::s3_use_virtual_addressing;
+      max_parallel_ops_ = constants::s3_max_parallel_ops;
       multipart_part_size_ = constants::s3_multipart_part_size;
+      max_connections_ = constants::s3_max_connections;
       request_timeout_ms_ = constants::s3_request_timeout_ms;
       connect_timeout_ms_ = constants::s3_connect_timeout_ms;
       connect_max_tries_ = constants::s3_connect_max_tries;
@@ -103,7 +107,9 @@ class S3 {
     std::string scheme_;
     std::string endpoint_override_;
     bool use_virtual_addressing_;
+    uint64_t max_parallel_ops_;
     uint64_t multipart_part_size_;
+    uint64_t max_connections_;
     long request_timeout_ms_;
     long connect_timeout_ms_;
     long connect_max_tries_;
@@ -227,6 +233,28 @@ class S3 {
       const std::string& delimiter = "/",
       int max_paths = -1) const;
 
+  /**
+   * Lists objects and common prefixes with a given prefix, invoking the
+   * input callback on each retrieved path as soon as its listing page
+   * arrives, instead of collecting all paths first. This allows the
+   * caller to start processing results while the remaining pages of a
+   * truncated listing are still being fetched. The listing stops early
+   * if the callback returns a non-OK status, which is then returned to
+   * the caller.
+   *
+   * @param prefix The prefix URI.
+   * @param cb The callback invoked on each retrieved path.
+   * @param delimiter The delimiter used to truncate the paths.
+   * @param max_paths The maximum number of paths to be retrieved. The default
+   *     `-1` indicates that no upper bound is specified.
+   * @return Status
+   */
+  Status ls(
+      const URI& prefix,
+      std::function<Status(const std::string&)> cb,
+      const std::string& delimiter = "/",
+      int max_paths = -1) const;
+
   /**
    * Renames an object.
    *
@@ -260,6 +288,12 @@ class S3 {
   /**
    * Reads data from an object into a buffer.
    *
+   * When consecutive reads on the same object are detected to be
+   * sequential, the function fetches a window larger than the requested
+   * range in a single GET and serves subsequent reads from the prefetched
+   * data, doubling the window on every read-ahead up to
+   * `constants::s3_prefetch_max_window`.
+   *
    * @param uri The URI of the object to be read.
    * @param offset The offset in the object from which the read will start.
    * @param buffer The buffer into which the data will be written.
@@ -269,6 +303,25 @@ class S3 {
   Status read(
       const URI& uri, off_t offset, void* buffer, uint64_t length) const;
 
+  /**
+   * Reads up to `length` bytes from an object into a buffer, without
+   * failing if the object ends before `length` bytes are available. The
+   * read is a single ranged GET that bypasses the prefetch machinery.
+   *
+   * @param uri The URI of the object to be read.
+   * @param offset The offset in the object from which the read will start.
+   * @param buffer The buffer into which the data will be written.
+   * @param length The maximum size of the data to be read from the object.
+   * @param nbytes_read The number of bytes actually read.
+   * @return Status
+   */
+  Status read_at_most(
+      const URI& uri,
+      off_t offset,
+      void* buffer,
+      uint64_t length,
+      uint64_t* nbytes_read) const;
+
   /**
    * Deletes a bucket.
    *
@@ -341,9 +394,6 @@ class S3 {
   /** The size of the file buffers used in multipart uploads. */
   uint64_t file_buffer_size_;
 
-  /** AWS options. */
-  Aws::SDKOptions options_;
-
   /** Used in multi-part uploads. */
   std::unordered_map<std::string, Aws::String> multipart_upload_IDs_;
 
@@ -366,6 +416,17 @@ class S3 {
   /** Used for synchronization in async multi-part uploads. */
   std::mutex multipart_upload_mtx_;
 
+  /**
+   * Map of object path -> in-flight part upload tasks. The parts of an
+   * object queued by `write_multipart_async` upload in the background and
+   * are drained by `wait_multipart_tasks` before the upload completes.
+   */
+  std::unordered_map<std::string, std::vector<std::future<Status>>>
+      multipart_upload_tasks_;
+
+  /** The maximum number of parallel part upload operations per object. */
+  uint64_t max_parallel_ops_;
+
   /** The length of a non-terminal multipart part. */
   uint64_t multipart_part_size_;
 
@@ -375,6 +436,42 @@ class S3 {
   /** Pointer to thread pool owned by parent VFS instance. */
   ThreadPool* vfs_thread_pool_;
 
+  /** Per-object state used to detect sequential reads and prefetch. */
+  struct PrefetchState {
+    /** Constructor. */
+    PrefetchState()
+        : next_offset_(0)
+        , sequential_reads_(0)
+        , window_(0)
+        , object_size_(0)
+        , buffer_offset_(0) {
+    }
+
+    /** The object offset where the next sequential read would start. */
+    uint64_t next_offset_;
+
+    /** The number of consecutive sequential reads observed. */
+    uint64_t sequential_reads_;
+
+    /** The current read-ahead window size, in bytes. */
+    uint64_t window_;
+
+    /** The object size, or 0 if not retrieved yet. */
+    uint64_t object_size_;
+
+    /** The object offset the prefetch buffer starts at. */
+    uint64_t buffer_offset_;
+
+    /** The prefetched data (empty if nothing is prefetched). */
+    std::vector<char> buffer_;
+  };
+
+  /** Map of object path -> prefetch state. */
+  mutable std::unordered_map<std::string, PrefetchState> prefetch_states_;
+
+  /** Protects `prefetch_states_`. */
+  mutable std::mutex prefetch_mtx_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -417,6 +514,35 @@ class S3 {
    */
   std::string remove_front_slash(const std::string& path) const;
 
+  /**
+   * Reads exactly the range `[offset, offset+length)` of an object into
+   * a buffer. Reads larger than `constants::s3_min_parallel_read_size`
+   * are split into multiple range GET requests issued concurrently on
+   * the VFS thread pool, as a single GET is limited to single-stream S3
+   * throughput.
+   *
+   * @param uri The URI of the object to be read.
+   * @param offset The offset in the object from which the read will start.
+   * @param buffer The buffer into which the data will be written.
+   * @param length The size of the data to be read from the object.
+   * @return Status
+   */
+  Status read_object(
+      const URI& uri, off_t offset, void* buffer, uint64_t length) const;
+
+  /**
+   * Reads exactly the range `[offset, offset+length)` of an object into
+   * a buffer with a single GET request.
+   *
+   * @param uri The URI of the object to be read.
+   * @param offset The offset in the object from which the read will start.
+   * @param buffer The buffer into which the data will be written.
+   * @param length The size of the data to be read from the object.
+   * @return Status
+   */
+  Status read_object_range(
+      const URI& uri, off_t offset, void* buffer, uint64_t length) const;
+
   /**
    * Writes the contents of the input buffer to the S3 object given by
    * the input `uri` as a new series of multipart uploads. It then
@@ -475,6 +601,30 @@ class S3 {
   Status write_multipart(
       const URI& uri, const void* buffer, uint64_t length, bool last_part);
 
+  /**
+   * Queues the contents of the input file buffer as multipart upload
+   * requests without waiting for them to complete, taking ownership of
+   * the buffer data (the buffer is left empty). The parts upload in the
+   * background on the thread pool while the caller keeps filling the
+   * next buffer; `wait_multipart_tasks` drains them. If the number of
+   * in-flight parts for the object reaches the configured maximum, the
+   * function first waits for the pending ones to complete.
+   *
+   * @param uri The URI of the S3 file to be written to.
+   * @param buff The file buffer whose contents will be uploaded.
+   * @return Status
+   */
+  Status write_multipart_async(const URI& uri, Buffer* buff);
+
+  /**
+   * Waits for all in-flight part uploads of the input object path to
+   * complete.
+   *
+   * @param path The S3 object path whose part uploads will be awaited.
+   * @return Status
+   */
+  Status wait_multipart_tasks(const std::string& path);
+
   /**
    * Issues a multipart upload request.
    *
@@ -34,11 +34,15 @@
 #include "tiledb/sm/filesystem/hdfs_filesystem.h"
 #include "tiledb/sm/filesystem/posix_filesystem.h"
 #include "tiledb/sm/filesystem/win_filesystem.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/trace.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/storage_manager/config.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace tiledb {
@@ -53,10 +57,13 @@ VFS::VFS() {
 
 #ifdef HAVE_HDFS
   supported_fs_.insert(Filesystem::HDFS);
+  hdfs_connected_ = false;
 #endif
 #ifdef HAVE_S3
   supported_fs_.insert(Filesystem::S3);
+  s3_initialized_ = false;
 #endif
+  supported_fs_.insert(Filesystem::MEMFS);
 
   STATS_FUNC_VOID_OUT(vfs_constructor);
 }
@@ -81,6 +88,8 @@ std::string VFS::abs_path(const std::string& path) {
     return path;
   if (URI::is_s3(path))
     return path;
+  if (URI::is_memfs(path))
+    return path;
   // Certainly starts with "<resource>://" other than "file://"
   return path;
 
@@ -101,6 +110,8 @@ Status VFS::create_dir(const URI& uri) const {
       return Status::Ok();
   }
 
+  invalidate_exists_cache(uri, false);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::create_dir(uri.to_path());
@@ -108,8 +119,11 @@ Status VFS::create_dir(const URI& uri) const {
     return posix::create_dir(uri.to_path());
 #endif
   }
+  if (uri.is_memfs())
+    return memfs_.create_dir(uri);
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->create_dir(uri);
 #else
     return LOG_STATUS(
@@ -133,6 +147,8 @@ Status VFS::create_dir(const URI& uri) const {
 Status VFS::touch(const URI& uri) const {
   STATS_FUNC_IN(vfs_create_file);
 
+  invalidate_exists_cache(uri, false);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::touch(uri.to_path());
@@ -140,8 +156,11 @@ Status VFS::touch(const URI& uri) const {
     return posix::touch(uri.to_path());
 #endif
   }
+  if (uri.is_memfs())
+    return memfs_.touch(uri);
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->touch(uri);
 #else
     return LOG_STATUS(
@@ -150,6 +169,7 @@ Status VFS::touch(const URI& uri) const {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.touch(uri);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -166,6 +186,7 @@ Status VFS::create_bucket(const URI& uri) const {
 
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.create_bucket(uri);
 #else
     (void)uri;
@@ -182,8 +203,11 @@ Status VFS::create_bucket(const URI& uri) const {
 Status VFS::remove_bucket(const URI& uri) const {
   STATS_FUNC_IN(vfs_remove_bucket);
 
+  invalidate_exists_cache(uri, true);
+
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.remove_bucket(uri);
 #else
     (void)uri;
@@ -200,8 +224,11 @@ Status VFS::remove_bucket(const URI& uri) const {
 Status VFS::empty_bucket(const URI& uri) const {
   STATS_FUNC_IN(vfs_empty_bucket);
 
+  invalidate_exists_cache(uri, true);
+
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.empty_bucket(uri);
 #else
     (void)uri;
@@ -220,6 +247,7 @@ Status VFS::is_empty_bucket(const URI& uri, bool* is_empty) const {
 
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.is_empty_bucket(uri, is_empty);
 #else
     (void)uri;
@@ -237,14 +265,36 @@ Status VFS::is_empty_bucket(const URI& uri, bool* is_empty) const {
 Status VFS::remove_dir(const URI& uri) const {
   STATS_FUNC_IN(vfs_remove_dir);
 
+  invalidate_exists_cache(uri, true);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::remove_dir(uri.to_path());
 #else
+    // Fan out the removal of the top-level entries on the thread pool;
+    // post-consolidation cleanup removes thousands of independent
+    // fragment directories
+    std::vector<std::string> entries;
+    RETURN_NOT_OK(posix::ls(uri.to_path(), &entries));
+    if (entries.size() > 1) {
+      std::vector<std::future<Status>> tasks;
+      for (const auto& entry : entries)
+        tasks.push_back(thread_pool_->enqueue([entry]() {
+          if (posix::is_dir(entry))
+            return posix::remove_dir(entry);
+          return posix::remove_file(entry);
+        }));
+      if (!thread_pool_->wait_all(tasks))
+        return LOG_STATUS(Status::VFSError(
+            std::string("Cannot remove directory '") + uri.c_str() + "'"));
+    }
     return posix::remove_dir(uri.to_path());
 #endif
+  } else if (uri.is_memfs()) {
+    return memfs_.remove_dir(uri);
   } else if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->remove_dir(uri);
 #else
     return LOG_STATUS(
@@ -252,6 +302,7 @@ Status VFS::remove_dir(const URI& uri) const {
 #endif
   } else if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.remove_dir(uri);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -267,6 +318,8 @@ Status VFS::remove_dir(const URI& uri) const {
 Status VFS::remove_file(const URI& uri) const {
   STATS_FUNC_IN(vfs_remove_file);
 
+  invalidate_exists_cache(uri, false);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::remove_file(uri.to_path());
@@ -274,8 +327,11 @@ Status VFS::remove_file(const URI& uri) const {
     return posix::remove_file(uri.to_path());
 #endif
   }
+  if (uri.is_memfs())
+    return memfs_.remove_file(uri);
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->remove_file(uri);
 #else
     return LOG_STATUS(
@@ -284,6 +340,7 @@ Status VFS::remove_file(const URI& uri) const {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.remove_object(uri);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -305,6 +362,8 @@ Status VFS::filelock_lock(const URI& uri, filelock_t* fd, bool shared) const {
     return posix::filelock_lock(uri.to_path(), fd, shared);
 #endif
 
+  if (uri.is_memfs())
+    return Status::Ok();
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
     return Status::Ok();
@@ -336,6 +395,8 @@ Status VFS::filelock_unlock(const URI& uri, filelock_t fd) const {
     return posix::filelock_unlock(fd);
 #endif
   }
+  if (uri.is_memfs())
+    return Status::Ok();
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
     return Status::Ok();
@@ -367,8 +428,11 @@ Status VFS::file_size(const URI& uri, uint64_t* size) const {
     return posix::file_size(uri.to_path(), size);
 #endif
   }
+  if (uri.is_memfs())
+    return memfs_.file_size(uri, size);
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->file_size(uri, size);
 #else
     return LOG_STATUS(
@@ -377,6 +441,7 @@ Status VFS::file_size(const URI& uri, uint64_t* size) const {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.object_size(uri, size);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -399,9 +464,23 @@ Status VFS::is_dir(const URI& uri, bool* is_dir) const {
 #endif
     return Status::Ok();
   }
+  if (uri.is_memfs()) {
+    *is_dir = memfs_.is_dir(uri);
+    return Status::Ok();
+  }
+
+  // Consult the existence cache for remote URIs
+  auto cache_key = std::string("dir:") + uri.to_string();
+  if (exists_cache_ != nullptr && exists_cache_->get(cache_key, is_dir))
+    return Status::Ok();
+
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
-    return hdfs_->is_dir(uri, is_dir);
+    RETURN_NOT_OK(init_hdfs());
+    RETURN_NOT_OK(hdfs_->is_dir(uri, is_dir));
+    if (exists_cache_ != nullptr)
+      exists_cache_->put(cache_key, *is_dir);
+    return Status::Ok();
 #else
     *is_dir = false;
     return LOG_STATUS(
@@ -410,7 +489,11 @@ Status VFS::is_dir(const URI& uri, bool* is_dir) const {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
-    return s3_.is_dir(uri, is_dir);
+    RETURN_NOT_OK(init_s3());
+    RETURN_NOT_OK(s3_.is_dir(uri, is_dir));
+    if (exists_cache_ != nullptr)
+      exists_cache_->put(cache_key, *is_dir);
+    return Status::Ok();
 #else
     *is_dir = false;
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -433,9 +516,23 @@ Status VFS::is_file(const URI& uri, bool* is_file) const {
 #endif
     return Status::Ok();
   }
+  if (uri.is_memfs()) {
+    *is_file = memfs_.is_file(uri);
+    return Status::Ok();
+  }
+
+  // Consult the existence cache for remote URIs
+  auto cache_key = std::string("file:") + uri.to_string();
+  if (exists_cache_ != nullptr && exists_cache_->get(cache_key, is_file))
+    return Status::Ok();
+
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
-    return hdfs_->is_file(uri, is_file);
+    RETURN_NOT_OK(init_hdfs());
+    RETURN_NOT_OK(hdfs_->is_file(uri, is_file));
+    if (exists_cache_ != nullptr)
+      exists_cache_->put(cache_key, *is_file);
+    return Status::Ok();
 #else
     *is_file = false;
     return LOG_STATUS(
@@ -444,7 +541,10 @@ Status VFS::is_file(const URI& uri, bool* is_file) const {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     *is_file = s3_.is_object(uri);
+    if (exists_cache_ != nullptr)
+      exists_cache_->put(cache_key, *is_file);
     return Status::Ok();
 #else
     *is_file = false;
@@ -462,6 +562,7 @@ Status VFS::is_bucket(const URI& uri, bool* is_bucket) const {
 
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     *is_bucket = s3_.is_bucket(uri);
     return Status::Ok();
 #else
@@ -487,35 +588,101 @@ Status VFS::init(const Config::VFSParams& vfs_params) {
     return LOG_STATUS(Status::VFSError("Could not create VFS thread pool"));
   }
 
+  exists_cache_ = std::unique_ptr<ExistsCache>(new (std::nothrow) ExistsCache(
+      constants::vfs_exists_cache_size, vfs_params_.exists_cache_ttl_ms_));
+  if (exists_cache_.get() == nullptr) {
+    return LOG_STATUS(Status::VFSError("Could not create VFS existence cache"));
+  }
+
+  // The HDFS and S3 backends are initialized lazily, upon the first
+  // operation on a URI of their scheme (see init_hdfs/init_s3), so
+  // contexts that never touch them pay no backend startup cost
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(vfs_init);
+}
+
 #ifdef HAVE_HDFS
+Status VFS::init_hdfs() const {
+  if (hdfs_connected_.load(std::memory_order_acquire))
+    return Status::Ok();
+
+  std::lock_guard<std::mutex> lock(backend_init_mtx_);
+  if (hdfs_connected_.load(std::memory_order_relaxed))
+    return Status::Ok();
+
   hdfs_ = std::unique_ptr<hdfs::HDFS>(new (std::nothrow) hdfs::HDFS());
   if (hdfs_.get() == nullptr) {
     return LOG_STATUS(Status::VFSError("Could not create VFS HDFS backend"));
   }
-  RETURN_NOT_OK(hdfs_->connect(vfs_params.hdfs_params_));
+  RETURN_NOT_OK(hdfs_->connect(vfs_params_.hdfs_params_));
+
+  hdfs_connected_.store(true, std::memory_order_release);
+  return Status::Ok();
+}
 #endif
 
 #ifdef HAVE_S3
+Status VFS::init_s3() const {
+  if (s3_initialized_.load(std::memory_order_acquire))
+    return Status::Ok();
+
+  std::lock_guard<std::mutex> lock(backend_init_mtx_);
+  if (s3_initialized_.load(std::memory_order_relaxed))
+    return Status::Ok();
+
   S3::S3Config s3_config;
-  s3_config.region_ = vfs_params.s3_params_.region_;
-  s3_config.scheme_ = vfs_params.s3_params_.scheme_;
-  s3_config.endpoint_override_ = vfs_params.s3_params_.endpoint_override_;
+  s3_config.region_ = vfs_params_.s3_params_.region_;
+  s3_config.scheme_ = vfs_params_.s3_params_.scheme_;
+  s3_config.endpoint_override_ = vfs_params_.s3_params_.endpoint_override_;
   s3_config.use_virtual_addressing_ =
-      vfs_params.s3_params_.use_virtual_addressing_;
-  s3_config.multipart_part_size_ = vfs_params.s3_params_.multipart_part_size_;
-  s3_config.connect_timeout_ms_ = vfs_params.s3_params_.connect_timeout_ms_;
-  s3_config.request_timeout_ms_ = vfs_params.s3_params_.request_timeout_ms_;
+      vfs_params_.s3_params_.use_virtual_addressing_;
+  s3_config.max_parallel_ops_ = vfs_params_.s3_params_.max_parallel_ops_;
+  s3_config.multipart_part_size_ = vfs_params_.s3_params_.multipart_part_size_;
+  s3_config.max_connections_ = vfs_params_.s3_params_.max_connections_;
+  s3_config.connect_timeout_ms_ = vfs_params_.s3_params_.connect_timeout_ms_;
+  s3_config.connect_max_tries_ = vfs_params_.s3_params_.connect_max_tries_;
+  s3_config.connect_scale_factor_ =
+      vfs_params_.s3_params_.connect_scale_factor_;
+  s3_config.request_timeout_ms_ = vfs_params_.s3_params_.request_timeout_ms_;
   RETURN_NOT_OK(s3_.init(s3_config, thread_pool_.get()));
-#endif
 
+  s3_initialized_.store(true, std::memory_order_release);
   return Status::Ok();
-
-  STATS_FUNC_OUT(vfs_init);
 }
+#endif
 
 Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
   STATS_FUNC_IN(vfs_ls);
 
+  std::vector<std::string> paths;
+  RETURN_NOT_OK(this->ls(parent, [&paths](const std::string& path) {
+    paths.push_back(path);
+    return Status::Ok();
+  }));
+  std::sort(paths.begin(), paths.end());
+  for (auto& path : paths) {
+    uris->emplace_back(path);
+  }
+  return Status::Ok();
+
+  STATS_FUNC_OUT(vfs_ls);
+}
+
+Status VFS::ls(
+    const URI& parent, std::function<Status(const std::string&)> cb) const {
+  // S3 listings are paginated - stream each page to the callback
+  if (parent.is_s3()) {
+#ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
+    return s3_.ls(parent, std::move(cb));
+#else
+    return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
+#endif
+  }
+
+  // The other backends list synchronously - collect and then emit
   std::vector<std::string> paths;
   if (parent.is_file()) {
 #ifdef _WIN32
@@ -523,30 +690,25 @@ Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
 #else
     RETURN_NOT_OK(posix::ls(parent.to_path(), &paths));
 #endif
+  } else if (parent.is_memfs()) {
+    RETURN_NOT_OK(memfs_.ls(parent, &paths));
   } else if (parent.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     RETURN_NOT_OK(hdfs_->ls(parent, &paths));
 #else
     return LOG_STATUS(
         Status::VFSError("TileDB was built without HDFS support"));
-#endif
-  } else if (parent.is_s3()) {
-#ifdef HAVE_S3
-    RETURN_NOT_OK(s3_.ls(parent, &paths));
-#else
-    return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
 #endif
   } else {
     return LOG_STATUS(
         Status::VFSError("Unsupported URI scheme: " + parent.to_string()));
   }
-  std::sort(paths.begin(), paths.end());
-  for (auto& path : paths) {
-    uris->emplace_back(path);
-  }
-  return Status::Ok();
 
-  STATS_FUNC_OUT(vfs_ls);
+  for (auto& path : paths)
+    RETURN_NOT_OK(cb(path));
+
+  return Status::Ok();
 }
 
 Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
@@ -558,6 +720,9 @@ Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
   if (is_file)
     RETURN_NOT_OK(remove_file(new_uri));
 
+  invalidate_exists_cache(old_uri, false);
+  invalidate_exists_cache(new_uri, false);
+
   // File
   if (old_uri.is_file()) {
     if (new_uri.is_file()) {
@@ -571,10 +736,19 @@ Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
         "Moving files across filesystems is not supported yet"));
   }
 
+  // In-memory
+  if (old_uri.is_memfs()) {
+    if (new_uri.is_memfs())
+      return memfs_.move_path(old_uri, new_uri);
+    return LOG_STATUS(Status::VFSError(
+        "Moving files across filesystems is not supported yet"));
+  }
+
   // HDFS
   if (old_uri.is_hdfs()) {
     if (new_uri.is_hdfs())
 #ifdef HAVE_HDFS
+      RETURN_NOT_OK(init_hdfs());
       return hdfs_->move_path(old_uri, new_uri);
 #else
       return LOG_STATUS(
@@ -588,6 +762,7 @@ Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
   if (old_uri.is_s3()) {
     if (new_uri.is_s3())
 #ifdef HAVE_S3
+      RETURN_NOT_OK(init_s3());
       return s3_.move_object(old_uri, new_uri);
 #else
       return LOG_STATUS(
@@ -608,6 +783,9 @@ Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
 Status VFS::move_dir(const URI& old_uri, const URI& new_uri) {
   STATS_FUNC_IN(vfs_move_dir);
 
+  invalidate_exists_cache(old_uri, true);
+  invalidate_exists_cache(new_uri, true);
+
   // File
   if (old_uri.is_file()) {
     if (new_uri.is_file()) {
@@ -621,10 +799,19 @@ Status VFS::move_dir(const URI& old_uri, const URI& new_uri) {
         "Moving files across filesystems is not supported yet"));
   }
 
+  // In-memory
+  if (old_uri.is_memfs()) {
+    if (new_uri.is_memfs())
+      return memfs_.move_path(old_uri, new_uri);
+    return LOG_STATUS(Status::VFSError(
+        "Moving files across filesystems is not supported yet"));
+  }
+
   // HDFS
   if (old_uri.is_hdfs()) {
     if (new_uri.is_hdfs())
 #ifdef HAVE_HDFS
+      RETURN_NOT_OK(init_hdfs());
       return hdfs_->move_path(old_uri, new_uri);
 #else
       return LOG_STATUS(
@@ -638,6 +825,7 @@ Status VFS::move_dir(const URI& old_uri, const URI& new_uri) {
   if (old_uri.is_s3()) {
     if (new_uri.is_s3())
 #ifdef HAVE_S3
+      RETURN_NOT_OK(init_s3());
       return s3_.move_dir(old_uri, new_uri);
 #else
       return LOG_STATUS(
@@ -693,8 +881,220 @@ Status VFS::read(
   STATS_FUNC_OUT(vfs_read);
 }
 
+Status VFS::read_at_most(
+    const URI& uri,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    uint64_t* nbytes_read) const {
+#ifndef _WIN32
+  if (uri.is_file())
+    return posix::read_at_most(
+        uri.to_path(), offset, buffer, nbytes, nbytes_read);
+#endif
+#ifdef HAVE_S3
+  if (uri.is_s3())
+    RETURN_NOT_OK(init_s3());
+    return s3_.read_at_most(uri, offset, buffer, nbytes, nbytes_read);
+#endif
+
+  // Fallback for the backends without a short-read-tolerant native call:
+  // clamp the read to the file size, paying an extra size request
+  uint64_t size;
+  RETURN_NOT_OK(file_size(uri, &size));
+  if (offset >= size) {
+    *nbytes_read = 0;
+    return Status::Ok();
+  }
+  uint64_t clamped_nbytes = std::min(nbytes, size - offset);
+  RETURN_NOT_OK(read(uri, offset, buffer, clamped_nbytes));
+  *nbytes_read = clamped_nbytes;
+
+  return Status::Ok();
+}
+
+std::future<Status> VFS::read_async(
+    const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const {
+  return thread_pool_->enqueue([this, uri, offset, buffer, nbytes]() {
+    return read(uri, offset, buffer, nbytes);
+  });
+}
+
+Status VFS::read_batch(
+    const URI& uri, const std::vector<ReadRegion>& regions) const {
+  if (regions.empty())
+    return Status::Ok();
+
+  // Sort the regions on their file offsets
+  std::vector<ReadRegion> sorted_regions = regions;
+  std::sort(
+      sorted_regions.begin(),
+      sorted_regions.end(),
+      [](const ReadRegion& a, const ReadRegion& b) {
+        return a.offset_ < b.offset_;
+      });
+
+  // Coalesce regions whose gap does not exceed the configured threshold.
+  // A batch is a contiguous range of regions in `sorted_regions`.
+  struct Batch {
+    uint64_t offset_;
+    uint64_t nbytes_;
+    uint64_t first_;
+    uint64_t last_;
+  };
+  std::vector<Batch> batches;
+  auto region_num = (uint64_t)sorted_regions.size();
+  batches.push_back(
+      {sorted_regions[0].offset_, sorted_regions[0].nbytes_, 0, 0});
+  for (uint64_t r = 1; r < region_num; r++) {
+    const auto& region = sorted_regions[r];
+    auto& batch = batches.back();
+    uint64_t batch_end = batch.offset_ + batch.nbytes_;
+    if (region.offset_ <= batch_end + vfs_params_.max_batch_read_gap_) {
+      uint64_t region_end = region.offset_ + region.nbytes_;
+      batch.nbytes_ = std::max(batch_end, region_end) - batch.offset_;
+      batch.last_ = r;
+    } else {
+      batches.push_back({region.offset_, region.nbytes_, r, r});
+    }
+  }
+
+  STATS_COUNTER_ADD(vfs_read_batch_num_regions, region_num);
+  STATS_COUNTER_ADD(vfs_read_batch_num_reads, batches.size());
+
+#if defined(__linux__) || defined(_WIN32)
+  // On local files, submit the entire batch to the kernel at once —
+  // via Linux native AIO on posix, or overlapped I/O on a completion
+  // port on Windows — instead of one blocking read per batch on the
+  // thread pool. Upon failure (e.g., if the system-wide AIO context
+  // limit has been reached), fall through to the thread pool below.
+  if (uri.is_file()) {
+    auto batch_num = (uint64_t)batches.size();
+    std::vector<std::vector<char>> batch_buffers(batch_num);
+    std::vector<ReadRegion> batch_regions(batch_num);
+    for (uint64_t b = 0; b < batch_num; ++b) {
+      const auto& batch = batches[b];
+      batch_regions[b].offset_ = batch.offset_;
+      batch_regions[b].nbytes_ = batch.nbytes_;
+      if (batch.first_ == batch.last_) {
+        // Read single-region batches directly into the region buffer
+        batch_regions[b].buffer_ = sorted_regions[batch.first_].buffer_;
+      } else {
+        batch_buffers[b].resize(batch.nbytes_);
+        batch_regions[b].buffer_ = &batch_buffers[b][0];
+      }
+    }
+
+#ifdef _WIN32
+    auto st = win::read_batch(uri.to_path(), batch_regions);
+#else
+    auto st = posix::read_batch(uri.to_path(), batch_regions);
+#endif
+    if (st.ok()) {
+      // Scatter the coalesced batches into the region buffers
+      for (uint64_t b = 0; b < batch_num; ++b) {
+        const auto& batch = batches[b];
+        if (batch.first_ == batch.last_)
+          continue;
+        for (uint64_t r = batch.first_; r <= batch.last_; r++) {
+          const auto& region = sorted_regions[r];
+          std::memcpy(
+              region.buffer_,
+              &batch_buffers[b][region.offset_ - batch.offset_],
+              region.nbytes_);
+        }
+      }
+      return Status::Ok();
+    }
+  }
+#endif
+
+  // Issue the batched reads concurrently. A batch that contains a single
+  // region is read directly into the region buffer; otherwise, the batch
+  // is read into a temporary buffer and scattered into the region buffers.
+  std::vector<std::future<Status>> tasks;
+  for (const auto& batch : batches) {
+    if (batch.first_ == batch.last_) {
+      const auto& region = sorted_regions[batch.first_];
+      tasks.push_back(thread_pool_->enqueue([this, &uri, &region]() {
+        return read(uri, region.offset_, region.buffer_, region.nbytes_);
+      }));
+    } else {
+      tasks.push_back(
+          thread_pool_->enqueue([this, &uri, &sorted_regions, batch]() {
+            std::vector<char> batch_buffer(batch.nbytes_);
+            RETURN_NOT_OK(
+                read(uri, batch.offset_, &batch_buffer[0], batch.nbytes_));
+            for (uint64_t r = batch.first_; r <= batch.last_; r++) {
+              const auto& region = sorted_regions[r];
+              std::memcpy(
+                  region.buffer_,
+                  &batch_buffer[region.offset_ - batch.offset_],
+                  region.nbytes_);
+            }
+            return Status::Ok();
+          }));
+    }
+  }
+
+  bool all_ok = thread_pool_->wait_all(tasks);
+  return all_ok ? Status::Ok() :
+                  LOG_STATUS(Status::VFSError("VFS batched read error"));
+}
+
+Status VFS::map(
+    const URI& uri, uint64_t offset, uint64_t nbytes, void** buffer) const {
+  if (uri.is_file()) {
+#ifdef _WIN32
+    return LOG_STATUS(
+        Status::VFSError("Memory mapping not supported on Windows"));
+#else
+    return posix::mmap(uri.to_path(), offset, nbytes, buffer);
+#endif
+  }
+
+  // Unsupported filesystem
+  return LOG_STATUS(Status::VFSError(
+      "Memory mapping unsupported URI scheme: " + uri.to_string()));
+}
+
+Status VFS::unmap(void* buffer, uint64_t nbytes) const {
+#ifdef _WIN32
+  (void)buffer;
+  (void)nbytes;
+  return LOG_STATUS(
+      Status::VFSError("Memory mapping not supported on Windows"));
+#else
+  return posix::munmap(buffer, nbytes);
+#endif
+}
+
+bool VFS::supports_map(const URI& uri) const {
+#ifdef _WIN32
+  (void)uri;
+  return false;
+#else
+  return vfs_params_.map_reads_ && uri.is_file();
+#endif
+}
+
+void VFS::invalidate_exists_cache(const URI& uri, bool recursive) const {
+  if (exists_cache_ == nullptr)
+    return;
+
+  if (recursive) {
+    exists_cache_->invalidate_prefix(std::string("dir:") + uri.to_string());
+    exists_cache_->invalidate_prefix(std::string("file:") + uri.to_string());
+  } else {
+    exists_cache_->invalidate(std::string("dir:") + uri.to_string());
+    exists_cache_->invalidate(std::string("file:") + uri.to_string());
+  }
+}
+
 Status VFS::read_impl(
     const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const {
+  TRACE_SCOPED_SPAN("vfs_read");
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::read(uri.to_path(), offset, buffer, nbytes);
@@ -702,8 +1102,11 @@ Status VFS::read_impl(
     return posix::read(uri.to_path(), offset, buffer, nbytes);
 #endif
   }
+  if (uri.is_memfs())
+    return memfs_.read(uri, offset, buffer, nbytes);
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->read(uri, offset, buffer, nbytes);
 #else
     return LOG_STATUS(
@@ -712,6 +1115,7 @@ Status VFS::read_impl(
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.read(uri, offset, buffer, nbytes);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -731,6 +1135,9 @@ bool VFS::supports_fs(Filesystem fs) const {
 
 Status VFS::sync(const URI& uri) {
   STATS_FUNC_IN(vfs_sync);
+  TRACE_SCOPED_SPAN("vfs_sync");
+
+  RETURN_NOT_OK(flush_write_buffer(uri, false));
 
   if (uri.is_file()) {
 #ifdef _WIN32
@@ -739,8 +1146,11 @@ Status VFS::sync(const URI& uri) {
     return posix::sync(uri.to_path());
 #endif
   }
+  if (uri.is_memfs())
+    return Status::Ok();
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->sync(uri);
 #else
     return LOG_STATUS(
@@ -776,6 +1186,15 @@ Status VFS::open_file(const URI& uri, VFSMode mode) {
     case VFSMode::VFS_WRITE:
       if (is_file)
         RETURN_NOT_OK(remove_file(uri));
+      // Drop any buffered writes of the overwritten file
+      {
+        std::lock_guard<std::mutex> lock(write_buffers_mtx_);
+        auto it = write_buffers_.find(uri.to_string());
+        if (it != write_buffers_.end()) {
+          it->second.reset_offset();
+          it->second.reset_size();
+        }
+      }
       break;
     case VFSMode::VFS_APPEND:
       if (uri.is_s3()) {
@@ -799,6 +1218,10 @@ Status VFS::open_file(const URI& uri, VFSMode mode) {
 Status VFS::close_file(const URI& uri) {
   STATS_FUNC_IN(vfs_close_file);
 
+  RETURN_NOT_OK(flush_write_buffer(uri, true));
+
+  invalidate_exists_cache(uri, false);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::sync(uri.to_path());
@@ -806,8 +1229,11 @@ Status VFS::close_file(const URI& uri) {
     return posix::sync(uri.to_path());
 #endif
   }
+  if (uri.is_memfs())
+    return Status::Ok();
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->sync(uri);
 #else
     return LOG_STATUS(
@@ -816,6 +1242,7 @@ Status VFS::close_file(const URI& uri) {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.flush_object(uri);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -830,16 +1257,66 @@ Status VFS::close_file(const URI& uri) {
 Status VFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   STATS_FUNC_IN(vfs_write);
   STATS_COUNTER_ADD(vfs_write_total_bytes, buffer_size);
+  TRACE_SCOPED_SPAN("vfs_write");
+
+  if (vfs_params_.write_buffer_size_ != 0) {
+    // Coalesce small writes in the write-combining buffer of the file,
+    // so that metadata-heavy paths (e.g., storing the fragment metadata)
+    // issue a handful of backend writes instead of one per call. The
+    // callers serialize the writes to each file, hence the buffer is
+    // accessed without the map mutex.
+    Buffer* write_buffer;
+    {
+      std::lock_guard<std::mutex> lock(write_buffers_mtx_);
+      write_buffer = &write_buffers_[uri.to_string()];
+    }
+    if (buffer_size < constants::vfs_max_combined_write_size) {
+      RETURN_NOT_OK(write_buffer->write(buffer, buffer_size));
+      if (write_buffer->size() >= vfs_params_.write_buffer_size_) {
+        RETURN_NOT_OK(
+            write_impl(uri, write_buffer->data(), write_buffer->size()));
+        write_buffer->reset_offset();
+        write_buffer->reset_size();
+      }
+      return Status::Ok();
+    }
+    // A large write must flush the buffered writes first, in order to
+    // preserve the write order
+    if (write_buffer->size() != 0) {
+      RETURN_NOT_OK(
+          write_impl(uri, write_buffer->data(), write_buffer->size()));
+      write_buffer->reset_offset();
+      write_buffer->reset_size();
+    }
+  }
+
+  return write_impl(uri, buffer, buffer_size);
 
+  STATS_FUNC_OUT(vfs_write);
+}
+
+Status VFS::write_impl(
+    const URI& uri, const void* buffer, uint64_t buffer_size) {
   if (uri.is_file()) {
 #ifdef _WIN32
     return win::write(uri.to_path(), buffer, buffer_size);
+#elif defined(__linux__)
+    // Issue large writes (e.g., attribute tile data) with direct I/O,
+    // so that they do not pollute the page cache; small writes (e.g.,
+    // metadata files) remain buffered
+    if (vfs_params_.min_direct_write_size_ != 0 &&
+        buffer_size >= vfs_params_.min_direct_write_size_)
+      return posix::write_direct(uri.to_path(), buffer, buffer_size);
+    return posix::write(uri.to_path(), buffer, buffer_size);
 #else
     return posix::write(uri.to_path(), buffer, buffer_size);
 #endif
   }
+  if (uri.is_memfs())
+    return memfs_.write(uri, buffer, buffer_size);
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
+    RETURN_NOT_OK(init_hdfs());
     return hdfs_->write(uri, buffer, buffer_size);
 #else
     return LOG_STATUS(
@@ -848,6 +1325,7 @@ Status VFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   }
   if (uri.is_s3()) {
 #ifdef HAVE_S3
+    RETURN_NOT_OK(init_s3());
     return s3_.write(uri, buffer, buffer_size);
 #else
     return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
@@ -855,8 +1333,39 @@ Status VFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   }
   return LOG_STATUS(
       Status::VFSError("Unsupported URI schemes: " + uri.to_string()));
+}
 
-  STATS_FUNC_OUT(vfs_write);
+Status VFS::flush_write_buffer(const URI& uri, bool remove) {
+  Buffer* write_buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(write_buffers_mtx_);
+    auto it = write_buffers_.find(uri.to_string());
+    if (it != write_buffers_.end())
+      write_buffer = &it->second;
+  }
+
+  if (write_buffer == nullptr)
+    return Status::Ok();
+
+  if (write_buffer->size() != 0) {
+    RETURN_NOT_OK(write_impl(uri, write_buffer->data(), write_buffer->size()));
+    write_buffer->reset_offset();
+    write_buffer->reset_size();
+  }
+
+  if (remove) {
+    std::lock_guard<std::mutex> lock(write_buffers_mtx_);
+    write_buffers_.erase(uri.to_string());
+  }
+
+  return Status::Ok();
+}
+
+std::future<Status> VFS::write_async(
+    const URI& uri, const void* buffer, uint64_t buffer_size) {
+  return thread_pool_->enqueue([this, uri, buffer, buffer_size]() {
+    return write(uri, buffer, buffer_size);
+  });
 }
 
 }  // namespace sm
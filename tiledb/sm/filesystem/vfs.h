@@ -34,9 +34,12 @@
 #define TILEDB_VFS_H
 
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/exists_cache.h"
 #include "tiledb/sm/enums/filesystem.h"
 #include "tiledb/sm/enums/vfs_mode.h"
 #include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/filesystem/mem_filesystem.h"
+#include "tiledb/sm/filesystem/read_region.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/uri.h"
@@ -50,6 +53,10 @@
 #include "tiledb/sm/filesystem/hdfs_filesystem.h"
 #endif
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -233,6 +240,22 @@ class VFS {
    */
   Status ls(const URI& parent, std::vector<URI>* uris) const;
 
+  /**
+   * Retrieves all the paths that have the first input as parent,
+   * invoking the input callback on each path as soon as it is
+   * retrieved from the backend. On backends with paginated listings
+   * (S3), this allows the caller to start processing results before
+   * the listing completes. The paths are not sorted. The listing stops
+   * early if the callback returns a non-OK status, which is then
+   * returned to the caller.
+   *
+   * @param parent The target directory to list.
+   * @param cb The callback invoked on each retrieved path.
+   * @return Status
+   */
+  Status ls(
+      const URI& parent, std::function<Status(const std::string&)> cb) const;
+
   /**
    * Renames a file.
    *
@@ -263,6 +286,90 @@ class VFS {
   Status read(
       const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
 
+  /**
+   * Reads up to `nbytes` bytes from a file, without failing if the file
+   * ends before `nbytes` bytes are available. This enables speculative
+   * reads past a known prefix of a file (e.g. fetching a tile header
+   * together with the tile body in a single request) without a prior
+   * request for the file size. Backends without a short-read-tolerant
+   * native call serve the read by clamping `nbytes` to the file size.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes Maximum number of bytes to read.
+   * @param nbytes_read The number of bytes actually read.
+   * @return Status
+   */
+  Status read_at_most(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      uint64_t* nbytes_read) const;
+
+  /**
+   * Reads from a file asynchronously, enqueuing the read on the VFS
+   * thread pool. The caller must keep both the file and `buffer` alive
+   * until the returned future completes.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes Number of bytes to read.
+   * @return A future holding the status of the read.
+   */
+  std::future<Status> read_async(
+      const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
+
+  /**
+   * Reads multiple regions from a file, coalescing regions whose gap does
+   * not exceed `vfs.max_batch_read_gap` into a single read and issuing the
+   * resulting reads concurrently on the VFS thread pool. This drastically
+   * reduces the number of requests on high-latency backends (e.g. S3)
+   * when many nearby tiles of the same file are read together. On Linux,
+   * reads on posix files are submitted to the kernel in a single batch
+   * via native AIO, removing the syscall-per-read overhead as well.
+   *
+   * @param uri The URI of the file.
+   * @param regions The regions to read. The regions must not overlap.
+   * @return Status
+   */
+  Status read_batch(const URI& uri, const std::vector<ReadRegion>& regions)
+      const;
+
+  /**
+   * Memory-maps a region of a file for reading, giving the caller direct
+   * access to the page cache without an intermediate copy (e.g. so that a
+   * tile can wrap the mapped memory via a non-owning buffer). The region
+   * must be unmapped with `unmap`. Only supported for posix files; the
+   * caller should fall back to `read` for other backends.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset in the file where the mapped region starts.
+   * @param nbytes The size of the mapped region.
+   * @param buffer Set to the start of the mapped region.
+   * @return Status
+   */
+  Status map(
+      const URI& uri, uint64_t offset, uint64_t nbytes, void** buffer) const;
+
+  /**
+   * Unmaps a file region previously mapped with `map`.
+   *
+   * @param buffer The start of the mapped region.
+   * @param nbytes The size of the mapped region.
+   * @return Status
+   */
+  Status unmap(void* buffer, uint64_t nbytes) const;
+
+  /**
+   * Returns `true` if reads of the input URI may go through `map`,
+   * i.e. if it is a posix file and mapped reads are enabled (see
+   * config parameter `vfs.map_reads`).
+   */
+  bool supports_map(const URI& uri) const;
+
   /** Checks if a given filesystem is supported. */
   bool supports_fs(Filesystem fs) const;
 
@@ -313,18 +420,61 @@ class VFS {
    */
   Status write(const URI& uri, const void* buffer, uint64_t buffer_size);
 
+  /**
+   * Writes the contents of a buffer into a file asynchronously,
+   * enqueuing the write on the VFS thread pool. The caller must keep
+   * `buffer` alive until the returned future completes. Note that
+   * writes to the same file are appending and, thus, the caller must
+   * wait for an in-flight write to a file to complete before issuing
+   * the next one, in order to preserve the write order.
+   *
+   * @param uri The URI of the file.
+   * @param buffer The buffer to write from.
+   * @param buffer_size The buffer size.
+   * @return A future holding the status of the write.
+   */
+  std::future<Status> write_async(
+      const URI& uri, const void* buffer, uint64_t buffer_size);
+
  private:
 /* ********************************* */
 /*         PRIVATE ATTRIBUTES        */
 /* ********************************* */
 #ifdef HAVE_S3
-  S3 s3_;
+  /**
+   * The S3 backend. It is connected lazily by `init_s3()` upon the
+   * first operation on an S3 URI, so contexts that never touch S3 skip
+   * the AWS SDK and client initialization entirely.
+   */
+  mutable S3 s3_;
+
+  /** `true` if the S3 backend has been initialized. */
+  mutable std::atomic<bool> s3_initialized_;
 #endif
 
 #ifdef HAVE_HDFS
-  std::unique_ptr<hdfs::HDFS> hdfs_;
+  /**
+   * The HDFS backend. It is created and connected lazily by
+   * `init_hdfs()` upon the first operation on an HDFS URI.
+   */
+  mutable std::unique_ptr<hdfs::HDFS> hdfs_;
+
+  /** `true` if the HDFS backend has been connected. */
+  mutable std::atomic<bool> hdfs_connected_;
 #endif
 
+  /** Protects the lazy initialization of the backends. */
+  mutable std::mutex backend_init_mtx_;
+
+  /**
+   * The in-memory backend for `mem://` URIs. It is always available and
+   * needs no initialization; its files live for the lifetime of the VFS.
+   */
+  mutable MemFilesystem memfs_;
+
+  /** Caches existence check results for remote URIs. */
+  std::unique_ptr<ExistsCache> exists_cache_;
+
   /** VFS parameters. */
   Config::VFSParams vfs_params_;
 
@@ -334,6 +484,34 @@ class VFS {
   /** Thread pool for parallel I/O operations. */
   std::unique_ptr<ThreadPool> thread_pool_;
 
+  /**
+   * The write-combining buffers of the files opened in write mode, keyed
+   * on the file URI string. Writes smaller than
+   * `constants::vfs_max_combined_write_size` are appended to the buffer
+   * and flushed to the backend as a single write when the buffer reaches
+   * `vfs.write_buffer_size`, upon `sync`, or when the file is closed.
+   * This turns metadata-heavy commit paths, which issue long runs of
+   * tiny writes, into a handful of backend writes.
+   */
+  std::map<std::string, Buffer> write_buffers_;
+
+  /**
+   * Protects `write_buffers_`. The mutex guards only the map structure;
+   * the buffers themselves are accessed without it, since the callers
+   * already serialize the writes to each file (see `write_async`).
+   */
+  std::mutex write_buffers_mtx_;
+
+  /**
+   * Removes the cached existence results for the input URI, which is
+   * about to be mutated. If `recursive` is `true`, the results for all
+   * URIs prefixed by the input URI are removed as well.
+   *
+   * @param uri The URI being mutated.
+   * @param recursive Whether to also invalidate URIs under the input URI.
+   */
+  void invalidate_exists_cache(const URI& uri, bool recursive) const;
+
   /**
    * Reads from a file by calling the specific backend read function.
    *
@@ -345,6 +523,43 @@ class VFS {
    */
   Status read_impl(
       const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
+
+  /**
+   * Flushes the write-combining buffer of the input file, if any, and
+   * optionally removes it (upon closing the file).
+   *
+   * @param uri The URI of the file.
+   * @param remove Whether to remove the buffer after flushing.
+   * @return Status
+   */
+  Status flush_write_buffer(const URI& uri, bool remove);
+
+  /**
+   * Writes the contents of a buffer into a file by calling the specific
+   * backend write function, bypassing the write-combining buffer.
+   *
+   * @param uri The URI of the file.
+   * @param buffer The buffer to write from.
+   * @param buffer_size The buffer size.
+   * @return Status
+   */
+  Status write_impl(const URI& uri, const void* buffer, uint64_t buffer_size);
+
+#ifdef HAVE_S3
+  /**
+   * Initializes the S3 backend upon the first operation on an S3 URI.
+   * Thread-safe; a no-op once the backend is initialized.
+   */
+  Status init_s3() const;
+#endif
+
+#ifdef HAVE_HDFS
+  /**
+   * Creates and connects the HDFS backend upon the first operation on
+   * an HDFS URI. Thread-safe; a no-op once the backend is connected.
+   */
+  Status init_hdfs() const;
+#endif
 };
 
 }  // namespace sm
@@ -371,6 +371,86 @@ Status read(
   return Status::Ok();
 }
 
+Status read_batch(
+    const std::string& path, const std::vector<ReadRegion>& regions) {
+  if (regions.empty())
+    return Status::Ok();
+
+  // Open the file for overlapped (asynchronous) access
+  HANDLE file_h = CreateFile(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      NULL,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+      NULL);
+  if (file_h == INVALID_HANDLE_VALUE) {
+    return LOG_STATUS(Status::IOError(
+        "Cannot read from file '" + path + "'; File opening error"));
+  }
+
+  // Attach the file to a completion port that collects the completions
+  HANDLE port = CreateIoCompletionPort(file_h, NULL, 0, 0);
+  if (port == NULL) {
+    CloseHandle(file_h);
+    return LOG_STATUS(Status::IOError(
+        "Cannot read from file '" + path + "'; Completion port error"));
+  }
+
+  // Issue all reads without waiting. Reads that complete synchronously
+  // still queue a completion on the port, so every issued read is
+  // collected below exactly once.
+  auto region_num = regions.size();
+  std::vector<OVERLAPPED> overlapped(region_num);
+  uint64_t issued = 0;
+  Status st = Status::Ok();
+  for (uint64_t r = 0; r < region_num; ++r) {
+    const auto& region = regions[r];
+    memset(&overlapped[r], 0, sizeof(OVERLAPPED));
+    overlapped[r].Offset = (DWORD)(region.offset_ & 0xFFFFFFFF);
+    overlapped[r].OffsetHigh = (DWORD)(region.offset_ >> 32);
+    if (ReadFile(
+            file_h, region.buffer_, region.nbytes_, NULL, &overlapped[r]) ==
+            0 &&
+        GetLastError() != ERROR_IO_PENDING) {
+      st = LOG_STATUS(Status::IOError(
+          "Cannot read from file '" + path + "'; File read error"));
+      break;
+    }
+    issued++;
+  }
+
+  // Collect the completions (also draining those of a failed submission)
+  for (uint64_t i = 0; i < issued; ++i) {
+    DWORD num_bytes_read = 0;
+    ULONG_PTR key = 0;
+    LPOVERLAPPED ov = NULL;
+    if (GetQueuedCompletionStatus(port, &num_bytes_read, &key, &ov, INFINITE) ==
+        0) {
+      if (st.ok())
+        st = LOG_STATUS(Status::IOError(
+            "Cannot read from file '" + path + "'; File read error"));
+      if (ov == NULL)
+        break;  // Port error; no completion was dequeued
+      continue;
+    }
+    auto r = (uint64_t)(ov - &overlapped[0]);
+    if (num_bytes_read != regions[r].nbytes_ && st.ok()) {
+      st = LOG_STATUS(Status::IOError(
+          "Cannot read from file '" + path + "'; File read error"));
+    }
+  }
+
+  CloseHandle(port);
+  if (CloseHandle(file_h) == 0 && st.ok()) {
+    st = LOG_STATUS(Status::IOError(
+        "Cannot read from file '" + path + "'; File closing error"));
+  }
+
+  return st;
+}
+
 Status sync(const std::string& path) {
   if (!is_file(path)) {
     return Status::Ok();
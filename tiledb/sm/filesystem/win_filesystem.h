@@ -41,6 +41,7 @@
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/filesystem/read_region.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/uri.h"
 
@@ -170,6 +171,20 @@ Status move_path(const std::string& old_path, const std::string& new_path);
 Status read(
     const std::string& path, uint64_t offset, void* buffer, uint64_t nbytes);
 
+/**
+ * Reads multiple regions from a file, issuing all reads as overlapped
+ * (asynchronous) I/O on a completion port before collecting their
+ * completions, instead of one blocking ReadFile call per region. The
+ * reads overlap inside the kernel, which removes the call-per-region
+ * latency that caps small-region read IOPS on synchronous handles.
+ *
+ * @param path The name of the file.
+ * @param regions The regions to read. The regions must not overlap.
+ * @return Status.
+ */
+Status read_batch(
+    const std::string& path, const std::vector<ReadRegion>& regions);
+
 /**
  * Syncs a file or directory.
  *
@@ -0,0 +1,121 @@
+/**
+ * @file   bloom_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class BloomFilter.
+ */
+
+#include "tiledb/sm/fragment/bloom_filter.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <cassert>
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+BloomFilter::BloomFilter() {
+  bit_num_ = 0;
+  hash_num_ = constants::bloom_hash_num;
+}
+
+BloomFilter::~BloomFilter() = default;
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+Status BloomFilter::init(uint64_t item_num) {
+  if (item_num == 0)
+    return LOG_STATUS(Status::BloomFilterError(
+        "Cannot initialize Bloom filter; Invalid number of items"));
+
+  // Round the number of bits up to a multiple of the word size
+  bit_num_ = item_num * constants::bloom_bits_per_cell;
+  auto word_num = (bit_num_ + 63) / 64;
+  bit_num_ = word_num * 64;
+  bits_.assign(word_num, 0);
+  hash_num_ = constants::bloom_hash_num;
+
+  return Status::Ok();
+}
+
+bool BloomFilter::empty() const {
+  return bit_num_ == 0;
+}
+
+void BloomFilter::insert(uint64_t hash_1, uint64_t hash_2) {
+  assert(bit_num_ != 0);
+  for (unsigned i = 0; i < hash_num_; ++i) {
+    auto bit = (hash_1 + i * hash_2) % bit_num_;
+    bits_[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+}
+
+bool BloomFilter::maybe_contains(uint64_t hash_1, uint64_t hash_2) const {
+  // An empty filter cannot rule anything out
+  if (bit_num_ == 0)
+    return true;
+
+  for (unsigned i = 0; i < hash_num_; ++i) {
+    auto bit = (hash_1 + i * hash_2) % bit_num_;
+    if ((bits_[bit / 64] & (uint64_t(1) << (bit % 64))) == 0)
+      return false;
+  }
+
+  return true;
+}
+
+Status BloomFilter::serialize(Buffer* buff) const {
+  RETURN_NOT_OK(buff->write(&bit_num_, sizeof(uint64_t)));
+  if (bit_num_ != 0) {
+    RETURN_NOT_OK(buff->write(&hash_num_, sizeof(unsigned)));
+    RETURN_NOT_OK(buff->write(&bits_[0], bits_.size() * sizeof(uint64_t)));
+  }
+
+  return Status::Ok();
+}
+
+Status BloomFilter::deserialize(ConstBuffer* buff) {
+  RETURN_NOT_OK(buff->read(&bit_num_, sizeof(uint64_t)));
+  if (bit_num_ != 0) {
+    RETURN_NOT_OK(buff->read(&hash_num_, sizeof(unsigned)));
+    bits_.resize(bit_num_ / 64);
+    RETURN_NOT_OK(buff->read(&bits_[0], bits_.size() * sizeof(uint64_t)));
+  }
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
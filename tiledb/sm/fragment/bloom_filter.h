@@ -0,0 +1,130 @@
+/**
+ * @file   bloom_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class BloomFilter.
+ */
+
+#ifndef TILEDB_BLOOM_FILTER_H
+#define TILEDB_BLOOM_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A Bloom filter over the coordinates of a sparse fragment. It answers
+ * whether a coordinate tuple is definitely absent from the fragment,
+ * which lets point lookups skip the fragment without any tile I/O.
+ * The filter stores no keys; items are represented by a 128-bit hash
+ * and the probe bits are derived from it with double hashing.
+ */
+class BloomFilter {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  BloomFilter();
+
+  /** Destructor. */
+  ~BloomFilter();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the filter for the input number of items, allocating
+   * `constants::bloom_bits_per_cell` bits per item.
+   *
+   * @param item_num The number of items the filter will store.
+   * @return Status
+   */
+  Status init(uint64_t item_num);
+
+  /** Returns `true` if the filter stores no bits. */
+  bool empty() const;
+
+  /**
+   * Inserts an item into the filter, given its 128-bit hash.
+   *
+   * @param hash_1 The low 64 bits of the item hash.
+   * @param hash_2 The high 64 bits of the item hash.
+   * @return void
+   */
+  void insert(uint64_t hash_1, uint64_t hash_2);
+
+  /**
+   * Checks if an item may be stored in the filter, given its 128-bit
+   * hash. Returns `false` only if the item is definitely absent. An
+   * empty filter cannot rule anything out, so it returns `true`.
+   */
+  bool maybe_contains(uint64_t hash_1, uint64_t hash_2) const;
+
+  /**
+   * Serializes the filter into a binary buffer.
+   *
+   * @param buff The buffer to serialize into.
+   * @return Status
+   */
+  Status serialize(Buffer* buff) const;
+
+  /**
+   * Loads the filter from the input binary buffer.
+   *
+   * @param buff The binary buffer to deserialize from.
+   * @return Status
+   */
+  Status deserialize(ConstBuffer* buff);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The number of bits in the filter. */
+  uint64_t bit_num_;
+
+  /** The number of hash probes per item. */
+  unsigned hash_num_;
+
+  /** The filter bits, packed in 64-bit words. */
+  std::vector<uint64_t> bits_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BLOOM_FILTER_H
@@ -144,7 +144,8 @@ Status Fragment::init(
   }
 
   // Initialize metadata and read/write state
-  metadata_ = new FragmentMetadata(query_->array_schema(), dense_, uri);
+  metadata_ = new FragmentMetadata(
+      query_->storage_manager(), query_->array_schema(), dense_, uri);
   Status st = metadata_->init(subarray);
   if (!st.ok()) {
     delete metadata_;
@@ -32,13 +32,17 @@
  */
 
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "murmur3/murmur3.h"
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
 
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <type_traits>
 
 /* ****************************** */
 /*             MACROS             */
@@ -55,14 +59,26 @@ namespace sm {
 /* ****************************** */
 
 FragmentMetadata::FragmentMetadata(
-    const ArraySchema* array_schema, bool dense, const URI& fragment_uri)
+    StorageManager* storage_manager,
+    const ArraySchema* array_schema,
+    bool dense,
+    const URI& fragment_uri)
     : array_schema_(array_schema)
+    , storage_manager_(storage_manager)
     , dense_(dense)
     , fragment_uri_(fragment_uri) {
   cell_num_in_domain_ = 0;
   domain_ = nullptr;
+  flat_blob_ = nullptr;
+  flat_blob_size_ = 0;
+  mbr_block_ = nullptr;
   non_empty_domain_ = nullptr;
+  tile_offsets_view_ = nullptr;
+  tile_var_offsets_view_ = nullptr;
+  tile_var_sizes_view_ = nullptr;
+  tile_offsets_loaded_.resize(array_schema_->attribute_num() + 1, true);
   std::memcpy(version_, constants::version, sizeof(version_));
+  compute_attr_uris();
 }
 
 FragmentMetadata::~FragmentMetadata() {
@@ -72,10 +88,21 @@ FragmentMetadata::~FragmentMetadata() {
   if (non_empty_domain_ != nullptr)
     std::free(non_empty_domain_);
 
-  auto mbr_num = (uint64_t)mbrs_.size();
-  for (uint64_t i = 0; i < mbr_num; ++i)
-    if (mbrs_[i] != nullptr)
-      std::free(mbrs_[i]);
+  if (flat_blob_ != nullptr) {
+    // The MBRs and bounding coordinates are views into the blob
+    std::free(flat_blob_);
+    return;
+  }
+
+  if (mbr_block_ != nullptr) {
+    // Deserialized MBRs live in a single contiguous block
+    std::free(mbr_block_);
+  } else {
+    auto mbr_num = (uint64_t)mbrs_.size();
+    for (uint64_t i = 0; i < mbr_num; ++i)
+      if (mbrs_[i] != nullptr)
+        std::free(mbrs_[i]);
+  }
 
   auto bounding_coords_num = (uint64_t)bounding_coords_.size();
   for (uint64_t i = 0; i < bounding_coords_num; ++i)
@@ -87,6 +114,10 @@ FragmentMetadata::~FragmentMetadata() {
 /*             ACCESSORS          */
 /* ****************************** */
 
+const ArraySchema* FragmentMetadata::array_schema() const {
+  return array_schema_;
+}
+
 void FragmentMetadata::append_bounding_coords(const void* bounding_coords) {
   // For easy reference
   uint64_t bounding_coords_size = 2 * array_schema_->coords_size();
@@ -97,6 +128,13 @@ void FragmentMetadata::append_bounding_coords(const void* bounding_coords) {
   bounding_coords_.push_back(new_bounding_coords);
 }
 
+void FragmentMetadata::append_coords_hash(const void* coords) {
+  uint64_t digest[2];
+  murmur3::MurmurHash3_x64_128(
+      coords, (int)array_schema_->coords_size(), 0, digest);
+  coords_hashes_.emplace_back(digest[0], digest[1]);
+}
+
 Status FragmentMetadata::append_mbr(const void* mbr) {
   switch (array_schema_->coords_type()) {
     case Datatype::INT8:
@@ -158,6 +196,27 @@ void FragmentMetadata::append_tile_var_size(
   tile_var_sizes_[attribute_id].push_back(size);
 }
 
+void FragmentMetadata::append_tile_stats(
+    unsigned int attribute_id, const void* min, const void* max, uint64_t sum) {
+  auto cell_size = array_schema_->cell_size(attribute_id);
+  TileStats stats;
+  stats.min_.assign((const uint8_t*)min, (const uint8_t*)min + cell_size);
+  stats.max_.assign((const uint8_t*)max, (const uint8_t*)max + cell_size);
+  stats.sum_ = sum;
+  tile_stats_[attribute_id].emplace_back(std::move(stats));
+}
+
+bool FragmentMetadata::has_tile_stats(unsigned int attribute_id) const {
+  return attribute_id < tile_stats_.size() &&
+         !tile_stats_[attribute_id].empty();
+}
+
+const std::vector<FragmentMetadata::TileStats>& FragmentMetadata::tile_stats(
+    unsigned int attribute_id) const {
+  assert(attribute_id < tile_stats_.size());
+  return tile_stats_[attribute_id];
+}
+
 const std::vector<void*>& FragmentMetadata::bounding_coords() const {
   return bounding_coords_;
 }
@@ -218,7 +277,7 @@ Status FragmentMetadata::compute_max_read_buffer_sizes_dense(
       if (var_sizes[i]) {
         auto cell_num = this->cell_num(tid);
         buffer_sizes[bid++] += cell_num * constants::cell_var_offset_size;
-        buffer_sizes[bid++] += tile_var_sizes_[attribute_ids[i]][tid];
+        buffer_sizes[bid++] += tile_var_size(attribute_ids[i], tid);
       } else {
         buffer_sizes[bid++] +=
             cell_num(tid) * array_schema_->cell_size(attribute_ids[i]);
@@ -255,7 +314,7 @@ Status FragmentMetadata::compute_max_read_buffer_sizes_sparse(
         if (var_sizes[i]) {
           auto cell_num = this->cell_num(tid);
           buffer_sizes[bid++] += cell_num * constants::cell_var_offset_size;
-          buffer_sizes[bid++] += tile_var_sizes_[attribute_ids[i]][tid];
+          buffer_sizes[bid++] += tile_var_size(attribute_ids[i], tid);
         } else {
           buffer_sizes[bid++] +=
               cell_num(tid) * array_schema_->cell_size(attribute_ids[i]);
@@ -269,6 +328,66 @@ Status FragmentMetadata::compute_max_read_buffer_sizes_sparse(
   return Status::Ok();
 }
 
+template <class T>
+Status FragmentMetadata::compute_est_read_buffer_sizes(
+    const T* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const {
+  // The dense upper bound is tight already
+  if (dense_)
+    return compute_max_read_buffer_sizes_dense(
+        subarray, attribute_ids, buffer_num, buffer_sizes);
+  return compute_est_read_buffer_sizes_sparse(
+      subarray, attribute_ids, buffer_num, buffer_sizes);
+}
+
+template <class T>
+Status FragmentMetadata::compute_est_read_buffer_sizes_sparse(
+    const T* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const {
+  for (unsigned i = 0; i < buffer_num; ++i)
+    buffer_sizes[i] = 0;
+
+  // Calculate var sizes
+  std::vector<bool> var_sizes;
+  var_sizes.reserve(attribute_ids.size());
+  for (auto aid : attribute_ids)
+    var_sizes.push_back(array_schema_->var_size(aid));
+  auto attribute_num = attribute_ids.size();
+
+  // Scale the contribution of each overlapping tile by the fraction of
+  // its MBR the subarray covers, accumulating in floating point
+  std::vector<double> est(buffer_num, 0.0);
+  unsigned bid, tid = 0;
+  auto dim_num = array_schema_->dim_num();
+  for (auto& mbr : mbrs_) {
+    bid = 0;
+    if (utils::overlap(static_cast<T*>(mbr), subarray, dim_num)) {
+      auto frac = mbr_coverage(static_cast<T*>(mbr), subarray, dim_num);
+      for (unsigned i = 0; i < attribute_num; ++i) {
+        if (var_sizes[i]) {
+          auto cell_num = this->cell_num(tid);
+          est[bid++] += frac * cell_num * constants::cell_var_offset_size;
+          est[bid++] += frac * tile_var_size(attribute_ids[i], tid);
+        } else {
+          est[bid++] +=
+              frac * cell_num(tid) * array_schema_->cell_size(attribute_ids[i]);
+        }
+      }
+      assert(bid == buffer_num);
+    }
+    tid++;
+  }
+
+  for (unsigned i = 0; i < buffer_num; ++i)
+    buffer_sizes[i] = (uint64_t)std::ceil(est[i]);
+
+  return Status::Ok();
+}
+
 bool FragmentMetadata::dense() const {
   return dense_;
 }
@@ -284,6 +403,50 @@ Status FragmentMetadata::deserialize(ConstBuffer* buf) {
   RETURN_NOT_OK(load_last_tile_cell_num(buf));
   RETURN_NOT_OK(load_file_sizes(buf));
   RETURN_NOT_OK(load_file_var_sizes(buf));
+  RETURN_NOT_OK(load_bloom_filter(buf));
+  RETURN_NOT_OK(load_tile_stats(buf));
+
+  // Build an R-tree over the MBRs (sparse case only)
+  if (!mbrs_.empty())
+    RETURN_NOT_OK(rtree_.init(
+        array_schema_->coords_type(),
+        array_schema_->dim_num(),
+        constants::rtree_fanout,
+        mbrs_));
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::deserialize(Buffer* buff, bool* took_ownership) {
+  *took_ownership = false;
+  ConstBuffer cbuff(buff->data(), buff->size());
+
+  // Detect the layout from the magic value following the library
+  // version; the old layout stores the (small) non-empty domain size
+  // there instead
+  bool flat = buff->size() >= sizeof(version_) + sizeof(uint64_t) &&
+              cbuff.value<uint64_t>(sizeof(version_)) ==
+                  constants::fragment_metadata_flat_magic;
+  if (!flat)
+    return deserialize(&cbuff);
+
+  // Flat layout - take ownership of the buffer data and use the
+  // sections in place
+  RETURN_NOT_OK(load_version(&cbuff));
+  cbuff.advance_offset(sizeof(uint64_t));  // Skip the magic value
+  RETURN_NOT_OK(buff->disown_data());  // May migrate inline data
+  flat_blob_ = buff->data();
+  flat_blob_size_ = buff->size();
+  *took_ownership = true;
+  RETURN_NOT_OK(load_flat(&cbuff));
+
+  // Build an R-tree over the MBRs (sparse case only)
+  if (!mbrs_.empty())
+    RETURN_NOT_OK(rtree_.init(
+        array_schema_->coords_type(),
+        array_schema_->dim_num(),
+        constants::rtree_fanout,
+        mbrs_));
 
   return Status::Ok();
 }
@@ -363,6 +526,9 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
   for (unsigned int i = 0; i < attribute_num + 1; ++i)
     next_tile_offsets_[i] = 0;
 
+  // Initialize per-tile statistics
+  tile_stats_.resize(attribute_num);
+
   // Initialize variable tile offsets
   tile_var_offsets_.resize(attribute_num);
   next_tile_var_offsets_.resize(attribute_num);
@@ -375,10 +541,62 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_offsets(unsigned attribute_id) {
+  assert(attribute_id < tile_offsets_loaded_.size());
+
+  std::lock_guard<std::mutex> lock(tile_offsets_mtx_);
+  if (tile_offsets_loaded_[attribute_id])
+    return Status::Ok();
+
+  // Read the serialized metadata (typically served from the metadata cache)
+  URI fragment_metadata_uri = fragment_uri_.join_path(
+      std::string(constants::fragment_metadata_filename));
+  bool in_cache;
+  auto buff = (Buffer*)nullptr;
+  RETURN_NOT_OK(storage_manager_->read_fragment_metadata(
+      fragment_metadata_uri, &buff, &in_cache));
+
+  // Materialize the offsets of the input attribute
+  auto cbuff = new ConstBuffer(buff);
+  Status st = load_tile_offsets(attribute_id, cbuff);
+  if (st.ok() && array_schema_->var_size(attribute_id)) {
+    st = load_tile_var_offsets(attribute_id, cbuff);
+    if (st.ok())
+      st = load_tile_var_sizes(attribute_id, cbuff);
+  }
+  delete cbuff;
+  delete buff;
+
+  if (st.ok())
+    tile_offsets_loaded_[attribute_id] = true;
+
+  return st;
+}
+
+uint64_t FragmentMetadata::fragment_size() const {
+  uint64_t size = 0;
+  for (auto file_size : file_sizes_)
+    size += file_size;
+  for (auto file_var_size : file_var_sizes_)
+    size += file_var_size;
+  return size;
+}
+
 uint64_t FragmentMetadata::last_tile_cell_num() const {
   return last_tile_cell_num_;
 }
 
+bool FragmentMetadata::maybe_contains_coords(const void* coords) const {
+  // A fragment without a filter cannot rule anything out
+  if (bloom_filter_.empty())
+    return true;
+
+  uint64_t digest[2];
+  murmur3::MurmurHash3_x64_128(
+      coords, (int)array_schema_->coords_size(), 0, digest);
+  return bloom_filter_.maybe_contains(digest[0], digest[1]);
+}
+
 const std::vector<void*>& FragmentMetadata::mbrs() const {
   return mbrs_;
 }
@@ -387,19 +605,104 @@ const void* FragmentMetadata::non_empty_domain() const {
   return non_empty_domain_;
 }
 
-Status FragmentMetadata::serialize(Buffer* buf) {
-  RETURN_NOT_OK(write_version(buf));
-  RETURN_NOT_OK(write_non_empty_domain(buf));
-  RETURN_NOT_OK(write_mbrs(buf));
-  RETURN_NOT_OK(write_bounding_coords(buf));
-  RETURN_NOT_OK(write_tile_offsets(buf));
-  RETURN_NOT_OK(write_tile_var_offsets(buf));
-  RETURN_NOT_OK(write_tile_var_sizes(buf));
-  RETURN_NOT_OK(write_last_tile_cell_num(buf));
-  RETURN_NOT_OK(write_file_sizes(buf));
-  RETURN_NOT_OK(write_file_var_sizes(buf));
+const RTree* FragmentMetadata::rtree() const {
+  return &rtree_;
+}
 
-  return Status::Ok();
+Status FragmentMetadata::serialize(Buffer* buf, ThreadPool* thread_pool) {
+  // The sections, in the order they appear in the serialized format
+  typedef Status (FragmentMetadata::*SectionFn)(Buffer*);
+  SectionFn sections[] = {&FragmentMetadata::write_non_empty_domain,
+                          &FragmentMetadata::write_mbrs,
+                          &FragmentMetadata::write_bounding_coords,
+                          &FragmentMetadata::write_tile_offsets,
+                          &FragmentMetadata::write_tile_var_offsets,
+                          &FragmentMetadata::write_tile_var_sizes,
+                          &FragmentMetadata::write_last_tile_cell_num,
+                          &FragmentMetadata::write_file_sizes,
+                          &FragmentMetadata::write_file_var_sizes,
+                          &FragmentMetadata::write_bloom_filter,
+                          &FragmentMetadata::write_tile_stats};
+  uint64_t section_num = sizeof(sections) / sizeof(sections[0]);
+
+  // The sections are independent - serialize them into separate buffers
+  // (concurrently, if a thread pool is given), then stitch them after
+  // the section directory. The per-attribute tile offsets/sizes
+  // dominate the cost for large fragments.
+  std::vector<Buffer*> section_buffs(section_num, nullptr);
+  for (uint64_t i = 0; i < section_num; ++i)
+    section_buffs[i] = new Buffer();
+  Status st = Status::Ok();
+  if (thread_pool == nullptr) {
+    for (uint64_t i = 0; st.ok() && i < section_num; ++i)
+      st = (this->*sections[i])(section_buffs[i]);
+  } else {
+    std::vector<std::future<Status>> tasks;
+    for (uint64_t i = 0; i < section_num; ++i) {
+      auto section = sections[i];
+      auto section_buff = section_buffs[i];
+      tasks.push_back(thread_pool->enqueue([this, section, section_buff]() {
+        return (this->*section)(section_buff);
+      }));
+    }
+    if (!thread_pool->wait_all(tasks))
+      st = LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Section serialization failed"));
+  }
+
+  // Write the header of the flat layout: the library version, the magic
+  // value and the section directory with the absolute offset of each
+  // section. Each section is padded to an 8-byte boundary, so that the
+  // views set up upon deserialization are aligned.
+  if (st.ok()) {
+    uint64_t header_size = sizeof(constants::version) + sizeof(uint64_t) +
+                           sizeof(uint32_t) + section_num * sizeof(uint64_t);
+    std::vector<uint64_t> section_offsets(section_num);
+    uint64_t offset = (header_size + 7) & ~(uint64_t)7;
+    for (uint64_t i = 0; i < section_num; ++i) {
+      section_offsets[i] = offset;
+      offset += (section_buffs[i]->size() + 7) & ~(uint64_t)7;
+    }
+    auto section_num_32 = (uint32_t)section_num;
+    st = write_version(buf);
+    if (st.ok())
+      st = buf->write(
+          &constants::fragment_metadata_flat_magic, sizeof(uint64_t));
+    if (st.ok())
+      st = buf->write(&section_num_32, sizeof(uint32_t));
+    if (st.ok())
+      st = buf->write(&section_offsets[0], section_num * sizeof(uint64_t));
+    if (st.ok() && section_offsets[0] != header_size) {
+      uint64_t zero = 0;
+      st = buf->write(&zero, section_offsets[0] - header_size);
+    }
+    if (!st.ok())
+      st = LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing section directory "
+          "failed"));
+  }
+
+  // Stitch the sections in order
+  uint64_t zero = 0;
+  for (uint64_t i = 0; st.ok() && i < section_num; ++i) {
+    auto section_size = section_buffs[i]->size();
+    if (section_size != 0)
+      st = buf->write(section_buffs[i]->data(), section_size);
+    uint64_t pad = (8 - (section_size % 8)) % 8;
+    if (st.ok() && pad != 0)
+      st = buf->write(&zero, pad);
+  }
+
+  // Clean up
+  for (auto& section_buff : section_buffs)
+    delete section_buff;
+
+  return st;
+}
+
+void FragmentMetadata::set_array_schema(const ArraySchema* array_schema) {
+  array_schema_ = array_schema;
+  compute_attr_uris();
 }
 
 void FragmentMetadata::set_last_tile_cell_num(uint64_t cell_num) {
@@ -414,28 +717,22 @@ uint64_t FragmentMetadata::tile_num() const {
 }
 
 URI FragmentMetadata::attr_uri(unsigned int attribute_id) const {
-  if (attribute_id == array_schema_->attribute_num())
-    return fragment_uri_.join_path(
-        std::string(constants::coords) + constants::file_suffix);
-
-  const Attribute* attr = array_schema_->attribute(attribute_id);
-  return fragment_uri_.join_path(attr->name() + constants::file_suffix);
+  return attr_uris_[attribute_id];
 }
 
 URI FragmentMetadata::attr_var_uri(unsigned int attribute_id) const {
-  auto attr = array_schema_->attribute(attribute_id);
-  return fragment_uri_.join_path(
-      attr->name() + "_var" + constants::file_suffix);
+  return attr_var_uris_[attribute_id];
 }
 
 uint64_t FragmentMetadata::file_offset(
     unsigned attribute_id, uint64_t tile_idx) const {
-  return tile_offsets_[attribute_id][tile_idx];
+  return tile_offsets_view_[tile_offsets_span_[attribute_id] + tile_idx];
 }
 
 uint64_t FragmentMetadata::file_var_offset(
     unsigned attribute_id, uint64_t tile_idx) const {
-  return tile_var_offsets_[attribute_id][tile_idx];
+  return tile_var_offsets_view_
+      [tile_var_offsets_span_[attribute_id] + tile_idx];
 }
 
 uint64_t FragmentMetadata::compressed_tile_size(
@@ -450,10 +747,10 @@ uint64_t FragmentMetadata::compressed_tile_size(
   }
 
   auto tile_num = this->tile_num();
+  auto offsets = &tile_offsets_view_[tile_offsets_span_[attribute_id]];
   return (tile_idx != tile_num - 1) ?
-             tile_offsets_[attribute_id][tile_idx + 1] -
-                 tile_offsets_[attribute_id][tile_idx] :
-             file_sizes_[attribute_id] - tile_offsets_[attribute_id][tile_idx];
+             offsets[tile_idx + 1] - offsets[tile_idx] :
+             file_sizes_[attribute_id] - offsets[tile_idx];
 }
 
 uint64_t FragmentMetadata::compressed_tile_var_size(
@@ -462,11 +759,11 @@ uint64_t FragmentMetadata::compressed_tile_var_size(
     return 0;
 
   auto tile_num = this->tile_num();
+  auto offsets =
+      &tile_var_offsets_view_[tile_var_offsets_span_[attribute_id]];
   return (tile_idx != tile_num - 1) ?
-             tile_var_offsets_[attribute_id][tile_idx + 1] -
-                 tile_var_offsets_[attribute_id][tile_idx] :
-             file_var_sizes_[attribute_id] -
-                 tile_var_offsets_[attribute_id][tile_idx];
+             offsets[tile_idx + 1] - offsets[tile_idx] :
+             file_var_sizes_[attribute_id] - offsets[tile_idx];
 }
 
 uint64_t FragmentMetadata::tile_size(
@@ -479,28 +776,86 @@ uint64_t FragmentMetadata::tile_size(
 
 uint64_t FragmentMetadata::tile_var_size(
     unsigned attribute_id, uint64_t tile_idx) const {
-  return tile_var_sizes_[attribute_id][tile_idx];
+  return tile_var_sizes_view_[tile_var_sizes_span_[attribute_id] + tile_idx];
 }
 
-const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_offsets()
-    const {
-  return tile_offsets_;
-}
-
-const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_var_offsets()
-    const {
-  return tile_var_offsets_;
+void FragmentMetadata::tile_fetch_info(
+    unsigned attribute_id,
+    const std::vector<uint64_t>& tile_indices,
+    std::vector<TileFetchInfo>* info) const {
+  auto tile_num = this->tile_num();
+  auto offsets =
+      tile_offsets_view_ + tile_offsets_span_[attribute_id];
+  auto file_size = file_sizes_[attribute_id];
+  bool compressed =
+      (array_schema_->var_size(attribute_id)) ?
+          constants::cell_var_offsets_compression !=
+              Compressor::NO_COMPRESSION :
+          array_schema_->compression(attribute_id) !=
+              Compressor::NO_COMPRESSION;
+
+  info->clear();
+  info->reserve(tile_indices.size());
+  for (auto tile_idx : tile_indices) {
+    TileFetchInfo ti;
+    ti.file_offset_ = offsets[tile_idx];
+    ti.compressed_size_ =
+        (!compressed) ? 0 :
+                        (tile_idx != tile_num - 1) ?
+                        offsets[tile_idx + 1] - offsets[tile_idx] :
+                        file_size - offsets[tile_idx];
+    ti.tile_size_ = tile_size(attribute_id, tile_idx);
+    info->push_back(ti);
+  }
 }
 
-const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_var_sizes()
-    const {
-  return tile_var_sizes_;
+void FragmentMetadata::tile_var_fetch_info(
+    unsigned attribute_id,
+    const std::vector<uint64_t>& tile_indices,
+    std::vector<TileFetchInfo>* info) const {
+  auto tile_num = this->tile_num();
+  auto offsets =
+      tile_var_offsets_view_ + tile_var_offsets_span_[attribute_id];
+  auto sizes =
+      tile_var_sizes_view_ + tile_var_sizes_span_[attribute_id];
+  auto file_size = file_var_sizes_[attribute_id];
+  bool compressed =
+      array_schema_->compression(attribute_id) != Compressor::NO_COMPRESSION;
+
+  info->clear();
+  info->reserve(tile_indices.size());
+  for (auto tile_idx : tile_indices) {
+    TileFetchInfo ti;
+    ti.file_offset_ = offsets[tile_idx];
+    ti.compressed_size_ =
+        (!compressed) ? 0 :
+                        (tile_idx != tile_num - 1) ?
+                        offsets[tile_idx + 1] - offsets[tile_idx] :
+                        file_size - offsets[tile_idx];
+    ti.tile_size_ = sizes[tile_idx];
+    info->push_back(ti);
+  }
 }
 
 /* ****************************** */
 /*        PRIVATE METHODS         */
 /* ****************************** */
 
+void FragmentMetadata::compute_attr_uris() {
+  auto attribute_num = array_schema_->attribute_num();
+  attr_uris_.resize(attribute_num + 1);
+  attr_var_uris_.resize(attribute_num);
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    const Attribute* attr = array_schema_->attribute(i);
+    attr_uris_[i] =
+        fragment_uri_.join_path(attr->name() + constants::file_suffix);
+    attr_var_uris_[i] = fragment_uri_.join_path(
+        attr->name() + "_var" + constants::file_suffix);
+  }
+  attr_uris_[attribute_num] = fragment_uri_.join_path(
+      std::string(constants::coords) + constants::file_suffix);
+}
+
 template <class T>
 std::vector<uint64_t> FragmentMetadata::compute_overlapping_tile_ids(
     const T* subarray) const {
@@ -538,6 +893,26 @@ std::vector<uint64_t> FragmentMetadata::compute_overlapping_tile_ids(
   return tids;
 }
 
+template <class T>
+double FragmentMetadata::mbr_coverage(
+    const T* mbr, const T* subarray, unsigned dim_num) {
+  double frac = 1.0;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto lo = MAX(mbr[2 * d], subarray[2 * d]);
+    auto hi = MIN(mbr[2 * d + 1], subarray[2 * d + 1]);
+    auto mbr_len = (double)mbr[2 * d + 1] - (double)mbr[2 * d];
+    auto cov_len = (double)hi - (double)lo;
+    // Integral domains span one extra unit, as the bounds are inclusive
+    if (std::is_integral<T>::value) {
+      mbr_len += 1;
+      cov_len += 1;
+    }
+    if (mbr_len > 0 && cov_len < mbr_len)
+      frac *= cov_len / mbr_len;
+  }
+  return frac;
+}
+
 template <class T>
 void FragmentMetadata::get_subarray_tile_domain(
     const T* subarray, T* subarray_tile_domain) const {
@@ -585,6 +960,73 @@ Status FragmentMetadata::expand_non_empty_domain(const T* mbr) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+//  bloom_bit_num (uint64_t)
+//  bloom_hash_num (unsigned) bloom_bits (uint64_t x bloom_bit_num / 64)
+// The entire section is absent in metadata written before the Bloom
+// filter was introduced.
+Status FragmentMetadata::load_bloom_filter(ConstBuffer* buff) {
+  if (buff->nbytes_left_to_read() == 0)
+    return Status::Ok();
+
+  Status st = bloom_filter_.deserialize(buff);
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading Bloom filter failed"));
+  }
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// attribute_num (unsigned int)
+// tile_stats_num_attr_#1 (uint64_t)
+//   tile_stats_attr_#1_tile_#1 (min (cell_size) max (cell_size) sum (uint64_t))
+//   ...
+// ...
+Status FragmentMetadata::load_tile_stats(ConstBuffer* buff) {
+  // Metadata written before the statistics were introduced ends here
+  if (buff->nbytes_left_to_read() == 0)
+    return Status::Ok();
+
+  unsigned int attribute_num = 0;
+  Status st = buff->read(&attribute_num, sizeof(unsigned int));
+  if (!st.ok() || attribute_num != array_schema_->attribute_num()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of attributes with "
+        "tile statistics failed"));
+  }
+
+  tile_stats_.resize(attribute_num);
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    uint64_t tile_stats_num = 0;
+    st = buff->read(&tile_stats_num, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Reading number of tile statistics "
+          "failed"));
+    }
+    auto cell_size = array_schema_->cell_size(i);
+    tile_stats_[i].resize(tile_stats_num);
+    for (uint64_t j = 0; j < tile_stats_num; ++j) {
+      auto& stats = tile_stats_[i][j];
+      stats.min_.resize(cell_size);
+      stats.max_.resize(cell_size);
+      st = buff->read(&stats.min_[0], cell_size);
+      if (st.ok())
+        st = buff->read(&stats.max_[0], cell_size);
+      if (st.ok())
+        st = buff->read(&stats.sum_, sizeof(uint64_t));
+      if (!st.ok()) {
+        return LOG_STATUS(Status::FragmentMetadataError(
+            "Cannot load fragment metadata; Reading tile statistics failed"));
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 //  bounding_coords_num (uint64_t)
 //  bounding_coords_#1 (void*) bounding_coords_#2 (void*) ...
@@ -616,6 +1058,30 @@ Status FragmentMetadata::load_bounding_coords(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_bounding_coords_flat(uint64_t section_offset) {
+  uint64_t bounding_coords_size = 2 * array_schema_->coords_size();
+  ConstBuffer buff(
+      (char*)flat_blob_ + section_offset, flat_blob_size_ - section_offset);
+
+  // Get number of bounding coordinates
+  uint64_t bounding_coords_num = 0;
+  Status st = buff.read(&bounding_coords_num, sizeof(uint64_t));
+  if (!st.ok() ||
+      bounding_coords_num * bounding_coords_size > buff.nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of "
+        "bounding coordinates failed"));
+  }
+
+  // The bounding coordinates are used in place - no copying
+  auto data = (char*)flat_blob_ + section_offset + sizeof(uint64_t);
+  bounding_coords_.resize(bounding_coords_num);
+  for (uint64_t i = 0; i < bounding_coords_num; ++i)
+    bounding_coords_[i] = data + i * bounding_coords_size;
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // file_sizes_attr#0 (uint64_t)
 // ...
@@ -651,6 +1117,73 @@ Status FragmentMetadata::load_file_var_sizes(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT (flat layout) =====
+// version (int[3])
+// flat_magic (uint64_t)
+// section_num (uint32_t)
+// section_offset_#1 (uint64_t) ... section_offset_#section_num (uint64_t)
+// The sections, in order: non-empty domain, MBRs, bounding coordinates,
+// tile offsets, variable tile offsets, variable tile sizes, last tile
+// cell number, file sizes, variable file sizes, Bloom filter, tile
+// statistics. Each section starts at an 8-byte boundary.
+Status FragmentMetadata::load_flat(ConstBuffer* buff) {
+  // Read the section directory
+  uint32_t section_num = 0;
+  Status st = buff->read(&section_num, sizeof(uint32_t));
+  if (!st.ok() || section_num < 11) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading section directory failed"));
+  }
+  std::vector<uint64_t> section_offsets(section_num);
+  st = buff->read(&section_offsets[0], section_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading section offsets failed"));
+  }
+  for (uint32_t i = 0; i < section_num; ++i) {
+    bool ordered = (i == 0) ? section_offsets[i] >= buff->offset() :
+                              section_offsets[i] >= section_offsets[i - 1];
+    if (!ordered || section_offsets[i] > flat_blob_size_) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Invalid section offset"));
+    }
+  }
+
+  // The size of each section, bounded by the next one (the last section
+  // extends to the end of the blob)
+  auto section_size = [&](uint32_t i) {
+    return ((i + 1 < section_num) ? section_offsets[i + 1] :
+                                    flat_blob_size_) -
+           section_offsets[i];
+  };
+  auto section_data = [&](uint32_t i) {
+    return (char*)flat_blob_ + section_offsets[i];
+  };
+
+  // The non-empty domain and the small fixed-size sections are parsed
+  // as before (the cost is negligible); the MBRs, bounding coordinates
+  // and tile offset tables are set up as views into the blob
+  ConstBuffer ned_buff(section_data(0), section_size(0));
+  RETURN_NOT_OK(load_non_empty_domain(&ned_buff));
+  RETURN_NOT_OK(load_mbrs_flat(section_offsets[1]));
+  RETURN_NOT_OK(load_bounding_coords_flat(section_offsets[2]));
+  RETURN_NOT_OK(load_tile_offsets_flat(section_offsets[3]));
+  RETURN_NOT_OK(load_tile_var_offsets_flat(section_offsets[4]));
+  RETURN_NOT_OK(load_tile_var_sizes_flat(section_offsets[5]));
+  ConstBuffer ltcn_buff(section_data(6), section_size(6));
+  RETURN_NOT_OK(load_last_tile_cell_num(&ltcn_buff));
+  ConstBuffer fs_buff(section_data(7), section_size(7));
+  RETURN_NOT_OK(load_file_sizes(&fs_buff));
+  ConstBuffer fvs_buff(section_data(8), section_size(8));
+  RETURN_NOT_OK(load_file_var_sizes(&fvs_buff));
+  ConstBuffer bf_buff(section_data(9), section_size(9));
+  RETURN_NOT_OK(load_bloom_filter(&bf_buff));
+  ConstBuffer ts_buff(section_data(10), section_size(10));
+  RETURN_NOT_OK(load_tile_stats(&ts_buff));
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // last_tile_cell_num (uint64_t)
 Status FragmentMetadata::load_last_tile_cell_num(ConstBuffer* buff) {
@@ -677,20 +1210,54 @@ Status FragmentMetadata::load_mbrs(ConstBuffer* buff) {
         "Cannot load fragment metadata; Reading number of MBRs failed"));
   }
 
-  // Get MBRs
+  if (mbr_num == 0)
+    return Status::Ok();
+
+  // Read all MBRs into a single contiguous block, rather than one heap
+  // allocation per MBR. This avoids the per-allocation overhead (which
+  // doubles the resident size for low-dimensionality MBRs) and keeps
+  // the MBRs cache-friendly for the R-tree build and tile overlap
+  // computations.
   uint64_t mbr_size = 2 * array_schema_->coords_size();
-  void* mbr = nullptr;
+  mbr_block_ = std::malloc(mbr_num * mbr_size);
+  if (mbr_block_ == nullptr) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; MBR allocation failed"));
+  }
+  st = buff->read(mbr_block_, mbr_num * mbr_size);
+  if (!st.ok()) {
+    std::free(mbr_block_);
+    mbr_block_ = nullptr;
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading MBR failed"));
+  }
+
   mbrs_.resize(mbr_num);
-  for (uint64_t i = 0; i < mbr_num; ++i) {
-    mbr = std::malloc(mbr_size);
-    st = buff->read(mbr, mbr_size);
-    if (!st.ok()) {
-      std::free(mbr);
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading MBR failed"));
-    }
-    mbrs_[i] = mbr;
+  for (uint64_t i = 0; i < mbr_num; ++i)
+    mbrs_[i] = (char*)mbr_block_ + i * mbr_size;
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::load_mbrs_flat(uint64_t section_offset) {
+  uint64_t mbr_size = 2 * array_schema_->coords_size();
+  ConstBuffer buff(
+      (char*)flat_blob_ + section_offset, flat_blob_size_ - section_offset);
+
+  // Get number of MBRs
+  uint64_t mbr_num = 0;
+  Status st = buff.read(&mbr_num, sizeof(uint64_t));
+  if (!st.ok() || mbr_num * mbr_size > buff.nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of MBRs failed"));
   }
+
+  // The MBRs are used in place - no copying
+  auto data = (char*)flat_blob_ + section_offset + sizeof(uint64_t);
+  mbrs_.resize(mbr_num);
+  for (uint64_t i = 0; i < mbr_num; ++i)
+    mbrs_[i] = data + i * mbr_size;
+
   return Status::Ok();
 }
 
@@ -743,11 +1310,18 @@ Status FragmentMetadata::load_tile_offsets(ConstBuffer* buff) {
   uint64_t tile_offsets_num = 0;
   unsigned int attribute_num = array_schema_->attribute_num();
 
-  // Allocate tile offsets
-  tile_offsets_.resize(attribute_num + 1);
+  // Record the position and arena span of each attribute's section,
+  // deferring materialization to the first touch
+  tile_offsets_pos_.resize(attribute_num + 1);
+  tile_offsets_span_.resize(attribute_num + 1);
+  tile_offsets_loaded_.assign(attribute_num + 1, false);
 
-  // For all attributes, get the tile offsets
+  // For all attributes, skip over the tile offsets
+  uint64_t total_num = 0;
   for (unsigned int i = 0; i < attribute_num + 1; ++i) {
+    tile_offsets_pos_[i] = buff->offset();
+    tile_offsets_span_[i] = total_num;
+
     // Get number of tile offsets
     st = buff->read(&tile_offsets_num, sizeof(uint64_t));
     if (!st.ok()) {
@@ -756,17 +1330,75 @@ Status FragmentMetadata::load_tile_offsets(ConstBuffer* buff) {
           "failed"));
     }
 
-    if (tile_offsets_num == 0)
-      continue;
+    total_num += tile_offsets_num;
+    buff->advance_offset(tile_offsets_num * sizeof(uint64_t));
+  }
 
-    // Get tile offsets
-    tile_offsets_[i].resize(tile_offsets_num);
-    st = buff->read(&tile_offsets_[i][0], tile_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading tile offsets failed"));
-    }
+  // Allocate the offsets of all the attributes as one contiguous arena
+  tile_offsets_arena_.resize(total_num);
+  tile_offsets_view_ = tile_offsets_arena_.data();
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::load_tile_offsets(
+    unsigned attribute_id, ConstBuffer* buff) {
+  uint64_t tile_offsets_num = 0;
+  buff->advance_offset(tile_offsets_pos_[attribute_id] - buff->offset());
+
+  // Get number of tile offsets
+  Status st = buff->read(&tile_offsets_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of tile offsets "
+        "failed"));
+  }
+
+  if (tile_offsets_num == 0)
+    return Status::Ok();
+
+  // Get tile offsets, materializing them into the attribute's arena span
+  st = buff->read(
+      &tile_offsets_arena_[tile_offsets_span_[attribute_id]],
+      tile_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading tile offsets failed"));
+  }
+  return Status::Ok();
+}
+
+Status FragmentMetadata::load_tile_offsets_flat(uint64_t section_offset) {
+  unsigned int attribute_num = array_schema_->attribute_num();
+  ConstBuffer buff(
+      (char*)flat_blob_ + section_offset, flat_blob_size_ - section_offset);
+
+  // Read the per-attribute counts table
+  std::vector<uint64_t> counts(attribute_num + 1);
+  Status st = buff.read(&counts[0], (attribute_num + 1) * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of tile offsets "
+        "failed"));
   }
+
+  // The offsets of all the attributes follow the table contiguously -
+  // point the view directly into the blob, with nothing to materialize
+  uint64_t total_num = 0;
+  tile_offsets_span_.resize(attribute_num + 1);
+  for (unsigned int i = 0; i < attribute_num + 1; ++i) {
+    tile_offsets_span_[i] = total_num;
+    total_num += counts[i];
+  }
+  if (total_num * sizeof(uint64_t) > buff.nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Invalid tile offsets section"));
+  }
+  tile_offsets_view_ =
+      (const uint64_t*)((char*)flat_blob_ + section_offset +
+                        (attribute_num + 1) * sizeof(uint64_t));
+  tile_offsets_loaded_.assign(attribute_num + 1, true);
+
   return Status::Ok();
 }
 
@@ -783,11 +1415,17 @@ Status FragmentMetadata::load_tile_var_offsets(ConstBuffer* buff) {
   unsigned int attribute_num = array_schema_->attribute_num();
   uint64_t tile_var_offsets_num = 0;
 
-  // Allocate tile offsets
-  tile_var_offsets_.resize(attribute_num);
+  // Record the position and arena span of each attribute's section,
+  // deferring materialization to the first touch
+  tile_var_offsets_pos_.resize(attribute_num);
+  tile_var_offsets_span_.resize(attribute_num);
 
-  // For all attributes, get the variable tile offsets
+  // For all attributes, skip over the variable tile offsets
+  uint64_t total_num = 0;
   for (unsigned int i = 0; i < attribute_num; ++i) {
+    tile_var_offsets_pos_[i] = buff->offset();
+    tile_var_offsets_span_[i] = total_num;
+
     // Get number of tile offsets
     st = buff->read(&tile_var_offsets_num, sizeof(uint64_t));
     if (!st.ok()) {
@@ -796,22 +1434,80 @@ Status FragmentMetadata::load_tile_var_offsets(ConstBuffer* buff) {
           "offsets failed"));
     }
 
-    if (tile_var_offsets_num == 0)
-      continue;
+    total_num += tile_var_offsets_num;
+    buff->advance_offset(tile_var_offsets_num * sizeof(uint64_t));
+  }
 
-    // Get variable tile offsets
-    tile_var_offsets_[i].resize(tile_var_offsets_num);
-    st = buff->read(
-        &tile_var_offsets_[i][0], tile_var_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading variable tile offsets "
-          "failed"));
-    }
+  // Allocate the offsets of all the attributes as one contiguous arena
+  tile_var_offsets_arena_.resize(total_num);
+  tile_var_offsets_view_ = tile_var_offsets_arena_.data();
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::load_tile_var_offsets(
+    unsigned attribute_id, ConstBuffer* buff) {
+  uint64_t tile_var_offsets_num = 0;
+  buff->advance_offset(tile_var_offsets_pos_[attribute_id] - buff->offset());
+
+  // Get number of tile offsets
+  Status st = buff->read(&tile_var_offsets_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of variable tile "
+        "offsets failed"));
+  }
+
+  if (tile_var_offsets_num == 0)
+    return Status::Ok();
+
+  // Get variable tile offsets, materializing them into the attribute's
+  // arena span
+  st = buff->read(
+      &tile_var_offsets_arena_[tile_var_offsets_span_[attribute_id]],
+      tile_var_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading variable tile offsets "
+        "failed"));
   }
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_var_offsets_flat(uint64_t section_offset) {
+  unsigned int attribute_num = array_schema_->attribute_num();
+  ConstBuffer buff(
+      (char*)flat_blob_ + section_offset, flat_blob_size_ - section_offset);
+
+  // Read the per-attribute counts table
+  std::vector<uint64_t> counts(attribute_num);
+  Status st = buff.read(&counts[0], attribute_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of variable tile "
+        "offsets failed"));
+  }
+
+  // The offsets of all the attributes follow the table contiguously -
+  // point the view directly into the blob
+  uint64_t total_num = 0;
+  tile_var_offsets_span_.resize(attribute_num);
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    tile_var_offsets_span_[i] = total_num;
+    total_num += counts[i];
+  }
+  if (total_num * sizeof(uint64_t) > buff.nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Invalid variable tile offsets "
+        "section"));
+  }
+  tile_var_offsets_view_ =
+      (const uint64_t*)((char*)flat_blob_ + section_offset +
+                        attribute_num * sizeof(uint64_t));
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // tile_var_sizes_attr#0_num (uint64_t)
 // tile_var_sizes_attr#0_#1 (uint64_t) tile_sizes_attr#0_#2 (uint64_t) ...
@@ -824,11 +1520,17 @@ Status FragmentMetadata::load_tile_var_sizes(ConstBuffer* buff) {
   unsigned int attribute_num = array_schema_->attribute_num();
   uint64_t tile_var_sizes_num = 0;
 
-  // Allocate tile sizes
-  tile_var_sizes_.resize(attribute_num);
+  // Record the position and arena span of each attribute's section,
+  // deferring materialization to the first touch
+  tile_var_sizes_pos_.resize(attribute_num);
+  tile_var_sizes_span_.resize(attribute_num);
 
-  // For all attributes, get the variable tile sizes
+  // For all attributes, skip over the variable tile sizes
+  uint64_t total_num = 0;
   for (unsigned int i = 0; i < attribute_num; ++i) {
+    tile_var_sizes_pos_[i] = buff->offset();
+    tile_var_sizes_span_[i] = total_num;
+
     // Get number of tile sizes
     st = buff->read(&tile_var_sizes_num, sizeof(uint64_t));
     if (!st.ok()) {
@@ -837,21 +1539,78 @@ Status FragmentMetadata::load_tile_var_sizes(ConstBuffer* buff) {
           "sizes failed"));
     }
 
-    if (tile_var_sizes_num == 0)
-      continue;
+    total_num += tile_var_sizes_num;
+    buff->advance_offset(tile_var_sizes_num * sizeof(uint64_t));
+  }
 
-    // Get variable tile sizes
-    tile_var_sizes_[i].resize(tile_var_sizes_num);
-    st = buff->read(
-        &tile_var_sizes_[i][0], tile_var_sizes_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading variable tile sizes failed"));
-    }
+  // Allocate the sizes of all the attributes as one contiguous arena
+  tile_var_sizes_arena_.resize(total_num);
+  tile_var_sizes_view_ = tile_var_sizes_arena_.data();
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::load_tile_var_sizes(
+    unsigned attribute_id, ConstBuffer* buff) {
+  uint64_t tile_var_sizes_num = 0;
+  buff->advance_offset(tile_var_sizes_pos_[attribute_id] - buff->offset());
+
+  // Get number of tile sizes
+  Status st = buff->read(&tile_var_sizes_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of variable tile "
+        "sizes failed"));
+  }
+
+  if (tile_var_sizes_num == 0)
+    return Status::Ok();
+
+  // Get variable tile sizes, materializing them into the attribute's
+  // arena span
+  st = buff->read(
+      &tile_var_sizes_arena_[tile_var_sizes_span_[attribute_id]],
+      tile_var_sizes_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading variable tile sizes failed"));
   }
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_var_sizes_flat(uint64_t section_offset) {
+  unsigned int attribute_num = array_schema_->attribute_num();
+  ConstBuffer buff(
+      (char*)flat_blob_ + section_offset, flat_blob_size_ - section_offset);
+
+  // Read the per-attribute counts table
+  std::vector<uint64_t> counts(attribute_num);
+  Status st = buff.read(&counts[0], attribute_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of variable tile "
+        "sizes failed"));
+  }
+
+  // The sizes of all the attributes follow the table contiguously -
+  // point the view directly into the blob
+  uint64_t total_num = 0;
+  tile_var_sizes_span_.resize(attribute_num);
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    tile_var_sizes_span_[i] = total_num;
+    total_num += counts[i];
+  }
+  if (total_num * sizeof(uint64_t) > buff.nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Invalid variable tile sizes section"));
+  }
+  tile_var_sizes_view_ =
+      (const uint64_t*)((char*)flat_blob_ + section_offset +
+                        attribute_num * sizeof(uint64_t));
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // version (int[3])
 Status FragmentMetadata::load_version(ConstBuffer* buff) {
@@ -859,6 +1618,67 @@ Status FragmentMetadata::load_version(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// bloom_bit_num(uint64_t)
+// bloom_hash_num(unsigned) bloom_bits(uint64_t x bloom_bit_num / 64)
+Status FragmentMetadata::write_bloom_filter(Buffer* buff) {
+  // Build the filter from the accumulated coordinate hashes
+  // (applicable only to the sparse case)
+  if (!coords_hashes_.empty()) {
+    RETURN_NOT_OK(bloom_filter_.init(coords_hashes_.size()));
+    for (const auto& ch : coords_hashes_)
+      bloom_filter_.insert(ch.first, ch.second);
+  }
+
+  Status st = bloom_filter_.serialize(buff);
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing Bloom filter failed"));
+  }
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// attribute_num (unsigned int)
+// tile_stats_num_attr_#1 (uint64_t)
+//   tile_stats_attr_#1_tile_#1 (min (cell_size) max (cell_size) sum (uint64_t))
+//   ...
+// ...
+Status FragmentMetadata::write_tile_stats(Buffer* buff) {
+  unsigned int attribute_num = array_schema_->attribute_num();
+  Status st = buff->write(&attribute_num, sizeof(unsigned int));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of attributes "
+        "with tile statistics failed"));
+  }
+
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    auto tile_stats_num = (uint64_t)tile_stats_[i].size();
+    st = buff->write(&tile_stats_num, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing number of tile "
+          "statistics failed"));
+    }
+    for (const auto& stats : tile_stats_[i]) {
+      st = buff->write(&stats.min_[0], stats.min_.size());
+      if (st.ok())
+        st = buff->write(&stats.max_[0], stats.max_.size());
+      if (st.ok())
+        st = buff->write(&stats.sum_, sizeof(uint64_t));
+      if (!st.ok()) {
+        return LOG_STATUS(Status::FragmentMetadataError(
+            "Cannot serialize fragment metadata; Writing tile statistics "
+            "failed"));
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // bounding_coords_num(uint64_t)
 // bounding_coords_#1(void*) bounding_coords_#2(void*) ...
@@ -989,19 +1809,19 @@ Status FragmentMetadata::write_non_empty_domain(Buffer* buff) {
 }
 
 // ===== FORMAT =====
-// tile_offsets_attr#0_num(uint64_t)
+// tile_offsets_attr#0_num (uint64_t)
+// ...
+// tile_offsets_attr#<attribute_num>_num (uint64_t)
 // tile_offsets_attr#0_#1 (uint64_t) tile_offsets_attr#0_#2 (uint64_t) ...
 // ...
-// tile_offsets_attr#<attribute_num>_num(uint64_t)
 // tile_offsets_attr#<attribute_num>_#1 (uint64_t)
 // tile_offsets_attr#<attribute_num>_#2 (uint64_t) ...
 Status FragmentMetadata::write_tile_offsets(Buffer* buff) {
   Status st;
   unsigned int attribute_num = array_schema_->attribute_num();
 
-  // Write tile offsets for each attribute
+  // Write the per-attribute counts table
   for (unsigned int i = 0; i < attribute_num + 1; ++i) {
-    // Write number of tile offsets
     uint64_t tile_offsets_num = tile_offsets_[i].size();
     st = buff->write(&tile_offsets_num, sizeof(uint64_t));
     if (!st.ok()) {
@@ -1009,12 +1829,15 @@ Status FragmentMetadata::write_tile_offsets(Buffer* buff) {
           "Cannot serialize fragment metadata; Writing number of tile offsets "
           "failed"));
     }
+  }
 
-    if (tile_offsets_num == 0)
+  // Write the tile offsets of all the attributes contiguously, so that
+  // they can be used in place upon deserialization
+  for (unsigned int i = 0; i < attribute_num + 1; ++i) {
+    if (tile_offsets_[i].empty())
       continue;
-
-    // Write tile offsets
-    st = buff->write(&tile_offsets_[i][0], tile_offsets_num * sizeof(uint64_t));
+    st = buff->write(
+        &tile_offsets_[i][0], tile_offsets_[i].size() * sizeof(uint64_t));
     if (!st.ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
           "Cannot serialize fragment metadata; Writing tile offsets failed"));
@@ -1025,20 +1848,20 @@ Status FragmentMetadata::write_tile_offsets(Buffer* buff) {
 }
 
 // ===== FORMAT =====
-// tile_var_offsets_attr#0_num(uint64_t)
+// tile_var_offsets_attr#0_num (uint64_t)
+// ...
+// tile_var_offsets_attr#<attribute_num-1>_num (uint64_t)
 // tile_var_offsets_attr#0_#1 (uint64_t) tile_var_offsets_attr#0_#2 (uint64_t)
 // ...
 // ...
-// tile_var_offsets_attr#<attribute_num-1>_num(uint64_t)
 // tile_var_offsets_attr#<attribute_num-1>_#1 (uint64_t)
 //     tile_var_offsets_attr#<attribute_num-1>_#2 (uint64_t) ...
 Status FragmentMetadata::write_tile_var_offsets(Buffer* buff) {
   Status st;
   unsigned int attribute_num = array_schema_->attribute_num();
 
-  // Write tile offsets for each attribute
+  // Write the per-attribute counts table
   for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Write number of offsets
     uint64_t tile_var_offsets_num = tile_var_offsets_[i].size();
     st = buff->write(&tile_var_offsets_num, sizeof(uint64_t));
     if (!st.ok()) {
@@ -1046,13 +1869,16 @@ Status FragmentMetadata::write_tile_var_offsets(Buffer* buff) {
           "Cannot serialize fragment metadata; Writing number of "
           "variable tile offsets failed"));
     }
+  }
 
-    if (tile_var_offsets_num == 0)
+  // Write the variable tile offsets of all the attributes contiguously,
+  // so that they can be used in place upon deserialization
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    if (tile_var_offsets_[i].empty())
       continue;
-
-    // Write tile offsets
     st = buff->write(
-        &tile_var_offsets_[i][0], tile_var_offsets_num * sizeof(uint64_t));
+        &tile_var_offsets_[i][0],
+        tile_var_offsets_[i].size() * sizeof(uint64_t));
     if (!st.ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
           "Cannot serialize fragment metadata; Writing "
@@ -1064,19 +1890,19 @@ Status FragmentMetadata::write_tile_var_offsets(Buffer* buff) {
 }
 
 // ===== FORMAT =====
-// tile_var_sizes_attr#0_num(uint64_t)
+// tile_var_sizes_attr#0_num (uint64_t)
+// ...
+// tile_var_sizes_attr#<attribute_num-1>_num (uint64_t)
 // tile_var_sizes_attr#0_#1 (uint64_t) tile_sizes_attr#0_#2 (uint64_t) ...
 // ...
-// tile_var_sizes_attr#<attribute_num-1>_num(uint64_t)
-// tile_var_sizes_attr#<attribute_num-1>_#1(uint64_t)
+// tile_var_sizes_attr#<attribute_num-1>_#1 (uint64_t)
 //     tile_var_sizes_attr#<attribute_num-1>_#2 (uint64_t) ...
 Status FragmentMetadata::write_tile_var_sizes(Buffer* buff) {
   Status st;
   unsigned int attribute_num = array_schema_->attribute_num();
 
-  // Write tile sizes for each attribute
+  // Write the per-attribute counts table
   for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Write number of sizes
     uint64_t tile_var_sizes_num = tile_var_sizes_[i].size();
     st = buff->write(&tile_var_sizes_num, sizeof(uint64_t));
     if (!st.ok()) {
@@ -1084,13 +1910,15 @@ Status FragmentMetadata::write_tile_var_sizes(Buffer* buff) {
           "Cannot serialize fragment metadata; Writing number of "
           "variable tile sizes failed"));
     }
+  }
 
-    if (tile_var_sizes_num == 0)
+  // Write the variable tile sizes of all the attributes contiguously,
+  // so that they can be used in place upon deserialization
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    if (tile_var_sizes_[i].empty())
       continue;
-
-    // Write tile sizes
     st = buff->write(
-        &tile_var_sizes_[i][0], tile_var_sizes_num * sizeof(uint64_t));
+        &tile_var_sizes_[i][0], tile_var_sizes_[i].size() * sizeof(uint64_t));
     if (!st.ok()) {
       return LOG_STATUS(
           Status::FragmentMetadataError("Cannot serialize fragment metadata; "
@@ -1170,6 +1998,57 @@ template Status FragmentMetadata::compute_max_read_buffer_sizes<double>(
     unsigned buffer_num,
     uint64_t* buffer_sizes) const;
 
+template Status FragmentMetadata::compute_est_read_buffer_sizes<int8_t>(
+    const int8_t* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<uint8_t>(
+    const uint8_t* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<int16_t>(
+    const int16_t* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<uint16_t>(
+    const uint16_t* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<int>(
+    const int* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<unsigned>(
+    const unsigned* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<int64_t>(
+    const int64_t* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<uint64_t>(
+    const uint64_t* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<float>(
+    const float* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+template Status FragmentMetadata::compute_est_read_buffer_sizes<double>(
+    const double* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    unsigned buffer_num,
+    uint64_t* buffer_sizes) const;
+
 template uint64_t FragmentMetadata::get_tile_pos<int8_t>(
     const int8_t* tile_coords) const;
 template uint64_t FragmentMetadata::get_tile_pos<uint8_t>(
@@ -37,17 +37,61 @@
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/fragment/bloom_filter.h"
+#include "tiledb/sm/fragment/rtree.h"
 #include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/thread_pool.h"
 
 #include <zlib.h>
+#include <mutex>
 #include <vector>
 
 namespace tiledb {
 namespace sm {
 
+class StorageManager;
+
 /** Stores the metadata structures of a fragment. */
 class FragmentMetadata {
  public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /**
+   * Per-tile statistics of a fixed-sized, single-value attribute,
+   * computed at write time. They allow the read path to prune tiles by
+   * value predicates and aggregate queries to be answered from the
+   * metadata alone.
+   */
+  struct TileStats {
+    /** The minimum cell value in the tile (raw attribute bytes). */
+    std::vector<uint8_t> min_;
+    /** The maximum cell value in the tile (raw attribute bytes). */
+    std::vector<uint8_t> max_;
+    /**
+     * The raw bits of the sum of the cell values in the tile. The sum
+     * is accumulated in the widest type of the attribute's kind:
+     * `int64_t` for signed integers, `uint64_t` for unsigned integers
+     * and `double` for floating point values.
+     */
+    uint64_t sum_;
+  };
+
+  /**
+   * The resolved fetch info of a tile: where its bytes live in the
+   * attribute file and how large they are. Retrieved in batches via
+   * `tile_fetch_info`.
+   */
+  struct TileFetchInfo {
+    /** The starting offset of the tile in the attribute file. */
+    uint64_t file_offset_;
+    /** The compressed tile size (0 if the tile is uncompressed). */
+    uint64_t compressed_size_;
+    /** The (uncompressed) tile size. */
+    uint64_t tile_size_;
+  };
+
   /* ********************************* */
   /*     CONSTRUCTORS & DESTRUCTORS    */
   /* ********************************* */
@@ -55,12 +99,17 @@ class FragmentMetadata {
   /**
    * Constructor.
    *
+   * @param storage_manager The storage manager, used to read back the
+   *     serialized metadata when tile offsets are loaded lazily.
    * @param array_schema The schema of the array the fragment belongs to.
    * @param dense Indicates whether the fragment is dense or sparse.
    * @param fragment_uri The fragment URI.
    */
   FragmentMetadata(
-      const ArraySchema* array_schema, bool dense, const URI& fragment_uri);
+      StorageManager* storage_manager,
+      const ArraySchema* array_schema,
+      bool dense,
+      const URI& fragment_uri);
 
   /** Destructor. */
   ~FragmentMetadata();
@@ -69,6 +118,9 @@ class FragmentMetadata {
   /*                API                */
   /* ********************************* */
 
+  /** Returns the schema of the array the fragment belongs to. */
+  const ArraySchema* array_schema() const;
+
   /**
    * Appends the tile bounding coordinates to the fragment metadata.
    *
@@ -97,6 +149,16 @@ class FragmentMetadata {
   template <class T>
   Status append_mbr(const void* mbr);
 
+  /**
+   * Appends the hash of a coordinate tuple to the fragment metadata.
+   * The hashes feed the Bloom filter that is built when the metadata
+   * gets serialized. Applicable only to the sparse case.
+   *
+   * @param coords The coordinates whose hash to append.
+   * @return void
+   */
+  void append_coords_hash(const void* coords);
+
   /**
    * Appends a tile offset for the input attribute.
    *
@@ -128,6 +190,33 @@ class FragmentMetadata {
    */
   void append_tile_var_size(unsigned int attribute_id, uint64_t size);
 
+  /**
+   * Appends the statistics of a tile for the input attribute.
+   *
+   * @param attribute_id The id of the attribute for which the
+   *     statistics are appended.
+   * @param min The minimum cell value in the tile (raw attribute bytes).
+   * @param max The maximum cell value in the tile (raw attribute bytes).
+   * @param sum The raw bits of the sum of the cell values in the tile.
+   * @return void
+   */
+  void append_tile_stats(
+      unsigned int attribute_id,
+      const void* min,
+      const void* max,
+      uint64_t sum);
+
+  /**
+   * Returns `true` if per-tile statistics are available for the input
+   * attribute. They are not available for var-sized or multi-value
+   * attributes, nor for fragments written before the statistics were
+   * introduced.
+   */
+  bool has_tile_stats(unsigned int attribute_id) const;
+
+  /** Returns the per-tile statistics of the input attribute. */
+  const std::vector<TileStats>& tile_stats(unsigned int attribute_id) const;
+
   /** Returns the bounding coordinates. */
   const std::vector<void*>& bounding_coords() const;
 
@@ -202,6 +291,54 @@ class FragmentMetadata {
       unsigned buffer_num,
       uint64_t* buffer_sizes) const;
 
+  /**
+   * Computes an estimate of the buffer sizes needed when reading a subarray
+   * from the fragment, for a given set of attributes. Unlike
+   * `compute_max_read_buffer_sizes`, which counts every cell of every tile
+   * whose MBR overlaps the subarray, this function scales each overlapping
+   * tile's contribution by the fraction of its MBR the subarray covers,
+   * assuming the cells are uniformly distributed in the MBR. For dense
+   * fragments the estimate coincides with the upper bound.
+   *
+   * @tparam T The coordinates type.
+   * @param subarray The targeted subarray.
+   * @param attribute_ids The ids of the targeted attributes.
+   * @param buffer_num The number of buffer sizes.
+   * @param buffer_sizes The buffer sizes to be computed. Note that there is
+   *     a single buffer size per fixed-sized attribute, and two for every
+   *     variable-sized attribute (the first is for the offsets, whereas the
+   *     second is for the actual variable-sized attribute values).
+   * @return Status
+   */
+  template <class T>
+  Status compute_est_read_buffer_sizes(
+      const T* subarray,
+      const std::vector<unsigned>& attribute_ids,
+      unsigned buffer_num,
+      uint64_t* buffer_sizes) const;
+
+  /**
+   * Computes an estimate of the buffer sizes needed when reading a subarray
+   * from the fragment, for a given set of attributes. This focuses on sparse
+   * fragments.
+   *
+   * @tparam T The coordinates type.
+   * @param subarray The targeted subarray.
+   * @param attribute_ids The ids of the targeted attributes.
+   * @param buffer_num The number of buffer sizes.
+   * @param buffer_sizes The buffer sizes to be computed. Note that there is
+   *     a single buffer size per fixed-sized attribute, and two for every
+   *     variable-sized attribute (the first is for the offsets, whereas the
+   *     second is for the actual variable-sized attribute values).
+   * @return Status
+   */
+  template <class T>
+  Status compute_est_read_buffer_sizes_sparse(
+      const T* subarray,
+      const std::vector<unsigned>& attribute_ids,
+      unsigned buffer_num,
+      uint64_t* buffer_sizes) const;
+
   /**
    * Returns ture if the corresponding fragment is dense, and false if it
    * is sparse.
@@ -209,13 +346,30 @@ class FragmentMetadata {
   bool dense() const;
 
   /**
-   * Loads the fragment metadata structures from the input binary buffer.
+   * Loads the fragment metadata structures from the input binary buffer,
+   * which must be in the old (parsed) layout.
    *
    * @param buff The binary buffer to deserialize from.
    * @return Status
    */
   Status deserialize(ConstBuffer* buff);
 
+  /**
+   * Loads the fragment metadata structures from the input binary buffer,
+   * detecting the layout from the buffer contents. If the buffer is in
+   * the flat layout, the metadata takes ownership of the buffer data and
+   * uses it in place - the MBRs, bounding coordinates and tile offset
+   * tables become views into the buffer, with no per-section parsing or
+   * copying. Old-layout buffers fall back to the parsing path.
+   *
+   * @param buff The binary buffer to deserialize from.
+   * @param took_ownership Set to `true` if the metadata took ownership
+   *     of the buffer data (flat layout), in which case the caller must
+   *     not free or reuse it.
+   * @return Status
+   */
+  Status deserialize(Buffer* buff, bool* took_ownership);
+
   /** Returns the (expanded) domain in which the fragment is constrained. */
   const void* domain() const;
 
@@ -248,9 +402,41 @@ class FragmentMetadata {
    */
   Status init(const void* non_empty_domain);
 
+  /**
+   * Materializes the tile offsets of the input attribute (and its
+   * variable tile offsets and sizes, if the attribute is var-sized)
+   * from the serialized metadata. Upon deserialization only the
+   * positions of the per-attribute sections are recorded; the offsets
+   * themselves are loaded on the first touch of each attribute, so that
+   * a query reading a few attributes of a wide array does not pay for
+   * the rest. This is a noop if the offsets are already loaded. It is
+   * safe to call this function concurrently from multiple threads.
+   *
+   * @param attribute_id The id of the attribute whose offsets to load.
+   *     `attribute_num` stands for the coordinates.
+   * @return Status
+   */
+  Status load_tile_offsets(unsigned attribute_id);
+
+  /**
+   * Returns the total fragment size in bytes, i.e., the sum of the
+   * fixed and variable attribute file sizes.
+   */
+  uint64_t fragment_size() const;
+
   /** Returns the number of cells in the last tile. */
   uint64_t last_tile_cell_num() const;
 
+  /**
+   * Checks against the Bloom filter if the input coordinates may be
+   * stored in the fragment. Returns `false` only if the coordinates are
+   * definitely absent, in which case a point lookup can skip the
+   * fragment without any tile I/O. Returns `true` if the fragment
+   * carries no filter (dense fragments, or metadata written before the
+   * filter was introduced).
+   */
+  bool maybe_contains_coords(const void* coords) const;
+
   /** Returns the MBRs. */
   const std::vector<void*>& mbrs() const;
 
@@ -258,12 +444,38 @@ class FragmentMetadata {
   const void* non_empty_domain() const;
 
   /**
-   * Serializes the metadata structures into a binary buffer.
+   * Returns the R-tree built over the MBRs. The tree is built upon
+   * deserialization; it is empty for dense fragments.
+   */
+  const RTree* rtree() const;
+
+  /**
+   * Serializes the metadata structures into a binary buffer, in the
+   * flat layout: a section directory with the absolute offset of each
+   * section follows the library version, and the MBRs, bounding
+   * coordinates and tile offset tables are stored so that they can be
+   * used in place upon deserialization. The sections of the metadata
+   * (MBRs, per-attribute tile offsets and sizes, Bloom filter, tile
+   * statistics, etc.) are independent, so they are serialized into
+   * separate buffers concurrently on the input thread pool and stitched
+   * in order afterwards.
    *
    * @param buff The buffer to serialize into.
+   * @param thread_pool The thread pool to serialize the sections on.
+   *     If `nullptr`, the sections are serialized serially on the
+   *     calling thread.
    * @return Status
    */
-  Status serialize(Buffer* buff);
+  Status serialize(Buffer* buff, ThreadPool* thread_pool);
+
+  /**
+   * Sets the array schema. Used when cached metadata gets reused upon
+   * re-opening an array, in which case a fresh schema object is loaded.
+   *
+   * @param array_schema The array schema to set.
+   * @return void
+   */
+  void set_array_schema(const ArraySchema* array_schema);
 
   /**
    * Simply sets the number of cells for the last tile.
@@ -346,14 +558,39 @@ class FragmentMetadata {
    */
   uint64_t tile_var_size(unsigned attribute_id, uint64_t tile_idx) const;
 
-  /** Returns the tile offsets. */
-  const std::vector<std::vector<uint64_t>>& tile_offsets() const;
-
-  /** Returns the variable tile offsets. */
-  const std::vector<std::vector<uint64_t>>& tile_var_offsets() const;
+  /**
+   * Batch-retrieves the fetch info (file offset, compressed size and
+   * tile size) of the input tiles of the input attribute, walking the
+   * contiguous offset arena in a single pass instead of paying the
+   * per-attribute indirection on every lookup. If the attribute is
+   * var-sized, the info refers to its offsets tiles.
+   *
+   * @param attribute_id The attribute id.
+   * @param tile_indices The indices of the tiles in the metadata, in
+   *     ascending order.
+   * @param info The fetch info of each input tile will be stored here.
+   * @return void
+   */
+  void tile_fetch_info(
+      unsigned attribute_id,
+      const std::vector<uint64_t>& tile_indices,
+      std::vector<TileFetchInfo>* info) const;
 
-  /** Returns the variable tile sizes. */
-  const std::vector<std::vector<uint64_t>>& tile_var_sizes() const;
+  /**
+   * Batch-retrieves the fetch info (file offset, compressed size and
+   * tile size) of the input value tiles of the input var-sized
+   * attribute, in a single pass.
+   *
+   * @param attribute_id The attribute id.
+   * @param tile_indices The indices of the tiles in the metadata, in
+   *     ascending order.
+   * @param info The fetch info of each input tile will be stored here.
+   * @return void
+   */
+  void tile_var_fetch_info(
+      unsigned attribute_id,
+      const std::vector<uint64_t>& tile_indices,
+      std::vector<TileFetchInfo>* info) const;
 
  private:
   /* ********************************* */
@@ -363,6 +600,19 @@ class FragmentMetadata {
   /** The array schema */
   const ArraySchema* array_schema_;
 
+  /** The storage manager. */
+  StorageManager* storage_manager_;
+
+  /**
+   * The URIs of the attribute files, resolved once upon construction so
+   * that repeated queries against a long-lived open array do not
+   * re-resolve the paths. The last URI is that of the coordinates file.
+   */
+  std::vector<URI> attr_uris_;
+
+  /** The URIs of the variable-sized attribute value files. */
+  std::vector<URI> attr_var_uris_;
+
   /** A vector storing the first and last coordinates of each tile. */
   std::vector<void*> bounding_coords_;
 
@@ -389,12 +639,48 @@ class FragmentMetadata {
   /** The uri of the fragment the metadata belongs to. */
   URI fragment_uri_;
 
+  /**
+   * The serialized metadata blob, owned by this object when the metadata
+   * was deserialized from the flat layout. The MBRs, bounding coordinates
+   * and tile offset tables are views into this blob; it is `nullptr` for
+   * metadata built by a write query or parsed from the old layout.
+   */
+  void* flat_blob_;
+
+  /** The size (in bytes) of `flat_blob_`. */
+  uint64_t flat_blob_size_;
+
   /** Number of cells in the last tile (meaningful only in the sparse case). */
   uint64_t last_tile_cell_num_;
 
+  /**
+   * A single contiguous block storing all MBRs of deserialized metadata,
+   * into which the `mbrs_` pointers point. It is `nullptr` for metadata
+   * built by a write query, in which case each MBR is allocated
+   * separately.
+   */
+  void* mbr_block_;
+
   /** The MBRs (applicable only to the sparse case with irregular tiles). */
   std::vector<void*> mbrs_;
 
+  /** An R-tree built over the MBRs upon deserialization. */
+  RTree rtree_;
+
+  /**
+   * A Bloom filter over the coordinates of the fragment (applicable
+   * only to the sparse case). It is empty for dense fragments and for
+   * metadata written before the filter was introduced.
+   */
+  BloomFilter bloom_filter_;
+
+  /**
+   * The hashes of the coordinates of each cell written, accumulated
+   * during a write query. The Bloom filter is built from them when the
+   * metadata gets serialized.
+   */
+  std::vector<std::pair<uint64_t, uint64_t>> coords_hashes_;
+
   /** The offsets of the next tile for each attribute. */
   std::vector<uint64_t> next_tile_offsets_;
 
@@ -409,19 +695,111 @@ class FragmentMetadata {
 
   /**
    * The tile offsets in their corresponding attribute files. Meaningful only
-   * when there is compression.
+   * when there is compression. Populated only while the metadata is being
+   * built by a write query; deserialized metadata materializes the offsets
+   * in `tile_offsets_arena_` instead.
    */
   std::vector<std::vector<uint64_t>> tile_offsets_;
 
+  /**
+   * All the tile offsets of deserialized metadata in a single contiguous
+   * arena, laid out attribute-after-attribute (with the coordinates in the
+   * last span). The contiguous storage avoids the per-attribute heap
+   * blocks and the pointer-chasing of a vector-of-vectors, which misses
+   * cache constantly when million-tile fragments are read. The arena is
+   * allocated in one piece upon deserialization and each attribute's span
+   * is filled lazily by `load_tile_offsets`.
+   */
+  std::vector<uint64_t> tile_offsets_arena_;
+
+  /** The start of each attribute's span in `tile_offsets_arena_`. */
+  std::vector<uint64_t> tile_offsets_span_;
+
+  /**
+   * The contiguous tile offsets of deserialized metadata, indexed via
+   * `tile_offsets_span_`. It points into `tile_offsets_arena_` for
+   * metadata parsed from the old layout and directly into `flat_blob_`
+   * for the flat layout.
+   */
+  const uint64_t* tile_offsets_view_;
+
+  /**
+   * All the variable tile offsets of deserialized metadata in a single
+   * contiguous arena, laid out attribute-after-attribute.
+   */
+  std::vector<uint64_t> tile_var_offsets_arena_;
+
+  /** The start of each attribute's span in `tile_var_offsets_arena_`. */
+  std::vector<uint64_t> tile_var_offsets_span_;
+
+  /**
+   * The contiguous variable tile offsets of deserialized metadata,
+   * indexed via `tile_var_offsets_span_`.
+   */
+  const uint64_t* tile_var_offsets_view_;
+
+  /**
+   * All the variable tile sizes of deserialized metadata in a single
+   * contiguous arena, laid out attribute-after-attribute.
+   */
+  std::vector<uint64_t> tile_var_sizes_arena_;
+
+  /** The start of each attribute's span in `tile_var_sizes_arena_`. */
+  std::vector<uint64_t> tile_var_sizes_span_;
+
+  /**
+   * The contiguous variable tile sizes of deserialized metadata,
+   * indexed via `tile_var_sizes_span_`.
+   */
+  const uint64_t* tile_var_sizes_view_;
+
+  /**
+   * The per-tile statistics of each attribute. The vector of an
+   * attribute is empty if statistics do not apply to it (var-sized or
+   * multi-value attributes) or were not written.
+   */
+  std::vector<std::vector<TileStats>> tile_stats_;
+
+  /**
+   * Whether the tile offsets of each attribute (and the coordinates in
+   * the last position) have been materialized. Always `true` for
+   * metadata built by a write query.
+   */
+  std::vector<bool> tile_offsets_loaded_;
+
+  /**
+   * The position of each attribute's tile offsets in the serialized
+   * metadata, recorded upon deserialization. The last position refers
+   * to the coordinates.
+   */
+  std::vector<uint64_t> tile_offsets_pos_;
+
+  /**
+   * The position of each attribute's variable tile offsets in the
+   * serialized metadata, recorded upon deserialization.
+   */
+  std::vector<uint64_t> tile_var_offsets_pos_;
+
+  /**
+   * The position of each attribute's variable tile sizes in the
+   * serialized metadata, recorded upon deserialization.
+   */
+  std::vector<uint64_t> tile_var_sizes_pos_;
+
+  /** Protects the lazily materialized tile offset structures. */
+  std::mutex tile_offsets_mtx_;
+
   /**
    * The variable tile offsets in their corresponding attribute files.
-   * Meaningful only for variable-sized tiles.
+   * Meaningful only for variable-sized tiles. Populated only while the
+   * metadata is being built by a write query.
    */
   std::vector<std::vector<uint64_t>> tile_var_offsets_;
 
   /**
    * The sizes of the uncompressed variable tiles.
    * Meaningful only when there is compression for variable tiles.
+   * Populated only while the metadata is being built by a write query.
    */
   std::vector<std::vector<uint64_t>> tile_var_sizes_;
 
@@ -432,10 +810,21 @@ class FragmentMetadata {
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
+  /** Resolves and stores the URIs of the attribute files. */
+  void compute_attr_uris();
+
   /** Returns the ids (positions) of the tiles overlapping `subarray. */
   template <class T>
   std::vector<uint64_t> compute_overlapping_tile_ids(const T* subarray) const;
 
+  /**
+   * Returns the fraction (in [0.0, 1.0]) of the volume of the input MBR
+   * that the input subarray covers. The two hyper-rectangles must overlap.
+   * Zero-extent MBR dimensions are considered fully covered.
+   */
+  template <class T>
+  static double mbr_coverage(const T* mbr, const T* subarray, unsigned dim_num);
+
   /**
    * Retrieves the tile domain for the input `subarray` based on the expanded
    * `domain_`.
@@ -458,6 +847,16 @@ class FragmentMetadata {
   template <class T>
   Status expand_non_empty_domain(const T* mbr);
 
+  /**
+   * Loads the Bloom filter from the fragment metadata buffer. Metadata
+   * written before the filter was introduced lacks this section, in
+   * which case the filter is left empty.
+   *
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_bloom_filter(ConstBuffer* buff);
+
   /**
    * Loads the bounding coordinates from the fragment metadata buffer.
    *
@@ -472,6 +871,54 @@ class FragmentMetadata {
   /** Loads the sizes of each variable attribute file from the buffer. */
   Status load_file_var_sizes(ConstBuffer* buff);
 
+  /**
+   * Loads the fragment metadata structures from `flat_blob_`, which must
+   * be in the flat layout. The section directory after the magic value
+   * gives the absolute offset of each section; the MBRs, bounding
+   * coordinates and tile offset tables are set up as views into the
+   * blob without copying. `buff` must be positioned right after the
+   * magic value.
+   *
+   * @param buff Metadata buffer (wrapping `flat_blob_`).
+   * @return Status
+   */
+  Status load_flat(ConstBuffer* buff);
+
+  /**
+   * Sets up the bounding coordinates as views into `flat_blob_`, at the
+   * input offset of the bounding coordinates section.
+   */
+  Status load_bounding_coords_flat(uint64_t section_offset);
+
+  /**
+   * Sets up the MBRs as views into `flat_blob_`, at the input offset of
+   * the MBR section.
+   */
+  Status load_mbrs_flat(uint64_t section_offset);
+
+  /**
+   * Sets up the tile offsets of all the attributes as a view into
+   * `flat_blob_`, at the input offset of the tile offsets section. The
+   * section stores the per-attribute counts as a table followed by all
+   * the offsets contiguously, so no parsing or materialization is
+   * needed.
+   */
+  Status load_tile_offsets_flat(uint64_t section_offset);
+
+  /**
+   * Sets up the variable tile offsets of all the attributes as a view
+   * into `flat_blob_`, at the input offset of the variable tile offsets
+   * section.
+   */
+  Status load_tile_var_offsets_flat(uint64_t section_offset);
+
+  /**
+   * Sets up the variable tile sizes of all the attributes as a view
+   * into `flat_blob_`, at the input offset of the variable tile sizes
+   * section.
+   */
+  Status load_tile_var_sizes_flat(uint64_t section_offset);
+
   /**
    * Loads the cell number of the last tile from the fragment metadata buffer.
    *
@@ -497,7 +944,9 @@ class FragmentMetadata {
   Status load_non_empty_domain(ConstBuffer* buff);
 
   /**
-   * Loads the tile offsets from the fragment metadata buffer.
+   * Records the position of each attribute's tile offsets in the
+   * fragment metadata buffer and skips over them. The offsets are
+   * materialized lazily by the public `load_tile_offsets` overload.
    *
    * @param buff Metadata buffer.
    * @return Status
@@ -505,7 +954,20 @@ class FragmentMetadata {
   Status load_tile_offsets(ConstBuffer* buff);
 
   /**
-   * Loads the variable tile offsets from the fragment metadata buffer.
+   * Materializes the tile offsets of the input attribute from the
+   * fragment metadata buffer, at the position recorded upon
+   * deserialization.
+   *
+   * @param attribute_id The id of the attribute whose offsets to load.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_offsets(unsigned attribute_id, ConstBuffer* buff);
+
+  /**
+   * Records the position of each attribute's variable tile offsets in
+   * the fragment metadata buffer and skips over them. The offsets are
+   * materialized lazily by the public `load_tile_offsets` overload.
    *
    * @param buff Metadata buffer.
    * @return Status
@@ -513,16 +975,56 @@ class FragmentMetadata {
   Status load_tile_var_offsets(ConstBuffer* buff);
 
   /**
-   * Loads the variable tile sizes from the fragment metadata.
+   * Materializes the variable tile offsets of the input attribute from
+   * the fragment metadata buffer, at the position recorded upon
+   * deserialization.
+   *
+   * @param attribute_id The id of the attribute whose offsets to load.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_var_offsets(unsigned attribute_id, ConstBuffer* buff);
+
+  /**
+   * Records the position of each attribute's variable tile sizes in
+   * the fragment metadata buffer and skips over them. The sizes are
+   * materialized lazily by the public `load_tile_offsets` overload.
    *
    * @param buff Metadata buffer.
    * @return Status
    */
   Status load_tile_var_sizes(ConstBuffer* buff);
 
+  /**
+   * Materializes the variable tile sizes of the input attribute from
+   * the fragment metadata buffer, at the position recorded upon
+   * deserialization.
+   *
+   * @param attribute_id The id of the attribute whose sizes to load.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_var_sizes(unsigned attribute_id, ConstBuffer* buff);
+
+  /**
+   * Loads the per-tile statistics from the buffer. Metadata written
+   * before the statistics were introduced simply exhausts the buffer,
+   * in which case the statistics remain empty.
+   */
+  Status load_tile_stats(ConstBuffer* buff);
+
   /** Loads the library version from the buffer. */
   Status load_version(ConstBuffer* buff);
 
+  /**
+   * Builds the Bloom filter from the accumulated coordinate hashes and
+   * writes it to the fragment metadata buffer.
+   *
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status write_bloom_filter(Buffer* buff);
+
   /**
    * Writes the bounding coordinates to the fragment metadata buffer.
    *
@@ -585,6 +1087,9 @@ class FragmentMetadata {
    */
   Status write_tile_var_sizes(Buffer* buff);
 
+  /** Writes the per-tile statistics to the buffer. */
+  Status write_tile_stats(Buffer* buff);
+
   /** Writes the library version to the buffer. */
   Status write_version(Buffer* buff);
 };
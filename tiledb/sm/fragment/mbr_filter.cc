@@ -0,0 +1,605 @@
+/**
+ * @file   mbr_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the MBRFilter class.
+ */
+
+#include "tiledb/sm/fragment/mbr_filter.h"
+#include "tiledb/sm/misc/cpu.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <cassert>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TILEDB_MBR_FILTER_X86
+#include <immintrin.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/**
+ * Maps a coordinate type to its canonical representation and converts
+ * values into it. Unsigned integers have their sign bit flipped, which
+ * maps unsigned order onto signed order, so that the signed-compare
+ * kernels apply to them as well.
+ */
+template <class T>
+struct Canonical;
+
+template <>
+struct Canonical<int8_t> {
+  typedef int32_t type;
+  static int32_t convert(int8_t v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<uint8_t> {
+  typedef int32_t type;
+  static int32_t convert(uint8_t v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<int16_t> {
+  typedef int32_t type;
+  static int32_t convert(int16_t v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<uint16_t> {
+  typedef int32_t type;
+  static int32_t convert(uint16_t v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<int32_t> {
+  typedef int32_t type;
+  static int32_t convert(int32_t v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<uint32_t> {
+  typedef int32_t type;
+  static int32_t convert(uint32_t v) {
+    return (int32_t)(v ^ 0x80000000u);
+  }
+};
+
+template <>
+struct Canonical<int64_t> {
+  typedef int64_t type;
+  static int64_t convert(int64_t v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<uint64_t> {
+  typedef int64_t type;
+  static int64_t convert(uint64_t v) {
+    return (int64_t)(v ^ 0x8000000000000000ull);
+  }
+};
+
+template <>
+struct Canonical<float> {
+  typedef float type;
+  static float convert(float v) {
+    return v;
+  }
+};
+
+template <>
+struct Canonical<double> {
+  typedef double type;
+  static double convert(double v) {
+    return v;
+  }
+};
+
+/**
+ * The signature shared by the scalar and vectorized sweep kernels. The
+ * bounds are dimension-major with stride `stride`; the kernel appends
+ * to `out` the indices in `[start, end)` of the MBRs satisfying
+ * `low[d] <= sub_high[d] && high[d] >= sub_low[d]` for every dimension.
+ */
+template <class C>
+struct FilterFn {
+  typedef void (*type)(
+      const C* low,
+      const C* high,
+      uint64_t stride,
+      unsigned dim_num,
+      const C* sub_low,
+      const C* sub_high,
+      uint64_t start,
+      uint64_t end,
+      std::vector<uint64_t>* out);
+};
+
+/** Scalar sweep over the SoA layout. */
+template <class C>
+void filter_scalar(
+    const C* low,
+    const C* high,
+    uint64_t stride,
+    unsigned dim_num,
+    const C* sub_low,
+    const C* sub_high,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* out) {
+  for (uint64_t j = start; j < end; ++j) {
+    bool overlaps = true;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      overlaps &= (low[d * stride + j] <= sub_high[d]) &
+                  (high[d * stride + j] >= sub_low[d]);
+    }
+    if (overlaps)
+      out->push_back(j);
+  }
+}
+
+#ifdef TILEDB_MBR_FILTER_X86
+
+// The kernels below are compiled for AVX2 irrespective of the baseline
+// target; they are only invoked after the runtime CPU check.
+
+/** Tests 8 MBRs with 32-bit coordinates per iteration. */
+__attribute__((target("avx2"))) void filter_avx2_i32(
+    const int32_t* low,
+    const int32_t* high,
+    uint64_t stride,
+    unsigned dim_num,
+    const int32_t* sub_low,
+    const int32_t* sub_high,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* out) {
+  uint64_t j = start;
+  for (; j + 8 <= end; j += 8) {
+    __m256i m = _mm256_set1_epi32(-1);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto lo = _mm256_loadu_si256((const __m256i*)&low[d * stride + j]);
+      auto hi = _mm256_loadu_si256((const __m256i*)&high[d * stride + j]);
+      auto slo = _mm256_set1_epi32(sub_low[d]);
+      auto shi = _mm256_set1_epi32(sub_high[d]);
+      // low <= sub_high  <=>  !(low > sub_high)
+      m = _mm256_andnot_si256(_mm256_cmpgt_epi32(lo, shi), m);
+      // high >= sub_low  <=>  !(sub_low > high)
+      m = _mm256_andnot_si256(_mm256_cmpgt_epi32(slo, hi), m);
+    }
+    int bits = _mm256_movemask_ps(_mm256_castsi256_ps(m));
+    while (bits != 0) {
+      int k = __builtin_ctz(bits);
+      bits &= bits - 1;
+      out->push_back(j + k);
+    }
+  }
+  filter_scalar(low, high, stride, dim_num, sub_low, sub_high, j, end, out);
+}
+
+/** Tests 4 MBRs with 64-bit coordinates per iteration. */
+__attribute__((target("avx2"))) void filter_avx2_i64(
+    const int64_t* low,
+    const int64_t* high,
+    uint64_t stride,
+    unsigned dim_num,
+    const int64_t* sub_low,
+    const int64_t* sub_high,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* out) {
+  uint64_t j = start;
+  for (; j + 4 <= end; j += 4) {
+    __m256i m = _mm256_set1_epi32(-1);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto lo = _mm256_loadu_si256((const __m256i*)&low[d * stride + j]);
+      auto hi = _mm256_loadu_si256((const __m256i*)&high[d * stride + j]);
+      auto slo = _mm256_set1_epi64x(sub_low[d]);
+      auto shi = _mm256_set1_epi64x(sub_high[d]);
+      m = _mm256_andnot_si256(_mm256_cmpgt_epi64(lo, shi), m);
+      m = _mm256_andnot_si256(_mm256_cmpgt_epi64(slo, hi), m);
+    }
+    int bits = _mm256_movemask_pd(_mm256_castsi256_pd(m));
+    while (bits != 0) {
+      int k = __builtin_ctz(bits);
+      bits &= bits - 1;
+      out->push_back(j + k);
+    }
+  }
+  filter_scalar(low, high, stride, dim_num, sub_low, sub_high, j, end, out);
+}
+
+/** Tests 8 MBRs with single-precision coordinates per iteration. */
+__attribute__((target("avx2"))) void filter_avx2_f32(
+    const float* low,
+    const float* high,
+    uint64_t stride,
+    unsigned dim_num,
+    const float* sub_low,
+    const float* sub_high,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* out) {
+  uint64_t j = start;
+  for (; j + 8 <= end; j += 8) {
+    auto m = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto lo = _mm256_loadu_ps(&low[d * stride + j]);
+      auto hi = _mm256_loadu_ps(&high[d * stride + j]);
+      auto slo = _mm256_set1_ps(sub_low[d]);
+      auto shi = _mm256_set1_ps(sub_high[d]);
+      m = _mm256_and_ps(m, _mm256_cmp_ps(lo, shi, _CMP_LE_OQ));
+      m = _mm256_and_ps(m, _mm256_cmp_ps(hi, slo, _CMP_GE_OQ));
+    }
+    int bits = _mm256_movemask_ps(m);
+    while (bits != 0) {
+      int k = __builtin_ctz(bits);
+      bits &= bits - 1;
+      out->push_back(j + k);
+    }
+  }
+  filter_scalar(low, high, stride, dim_num, sub_low, sub_high, j, end, out);
+}
+
+/** Tests 4 MBRs with double-precision coordinates per iteration. */
+__attribute__((target("avx2"))) void filter_avx2_f64(
+    const double* low,
+    const double* high,
+    uint64_t stride,
+    unsigned dim_num,
+    const double* sub_low,
+    const double* sub_high,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* out) {
+  uint64_t j = start;
+  for (; j + 4 <= end; j += 4) {
+    auto m = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto lo = _mm256_loadu_pd(&low[d * stride + j]);
+      auto hi = _mm256_loadu_pd(&high[d * stride + j]);
+      auto slo = _mm256_set1_pd(sub_low[d]);
+      auto shi = _mm256_set1_pd(sub_high[d]);
+      m = _mm256_and_pd(m, _mm256_cmp_pd(lo, shi, _CMP_LE_OQ));
+      m = _mm256_and_pd(m, _mm256_cmp_pd(hi, slo, _CMP_GE_OQ));
+    }
+    int bits = _mm256_movemask_pd(m);
+    while (bits != 0) {
+      int k = __builtin_ctz(bits);
+      bits &= bits - 1;
+      out->push_back(j + k);
+    }
+  }
+  filter_scalar(low, high, stride, dim_num, sub_low, sub_high, j, end, out);
+}
+
+#endif
+
+/** Selects the fastest 32-bit integer kernel the CPU supports. */
+FilterFn<int32_t>::type pick_filter_i32() {
+#ifdef TILEDB_MBR_FILTER_X86
+  if (cpu::features().avx2_)
+    return filter_avx2_i32;
+#endif
+  return filter_scalar<int32_t>;
+}
+
+/** Selects the fastest 64-bit integer kernel the CPU supports. */
+FilterFn<int64_t>::type pick_filter_i64() {
+#ifdef TILEDB_MBR_FILTER_X86
+  if (cpu::features().avx2_)
+    return filter_avx2_i64;
+#endif
+  return filter_scalar<int64_t>;
+}
+
+/** Selects the fastest single-precision kernel the CPU supports. */
+FilterFn<float>::type pick_filter_f32() {
+#ifdef TILEDB_MBR_FILTER_X86
+  if (cpu::features().avx2_)
+    return filter_avx2_f32;
+#endif
+  return filter_scalar<float>;
+}
+
+/** Selects the fastest double-precision kernel the CPU supports. */
+FilterFn<double>::type pick_filter_f64() {
+#ifdef TILEDB_MBR_FILTER_X86
+  if (cpu::features().avx2_)
+    return filter_avx2_f64;
+#endif
+  return filter_scalar<double>;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+MBRFilter::MBRFilter() {
+  type_ = Datatype::INT32;
+  repr_ = Repr::I32;
+  dim_num_ = 0;
+  mbr_num_ = 0;
+}
+
+MBRFilter::~MBRFilter() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status MBRFilter::init(
+    Datatype type, unsigned dim_num, const void* mbrs, uint64_t mbr_num) {
+  if (dim_num == 0)
+    return LOG_STATUS(
+        Status::Error("Cannot initialize MBR filter; Invalid parameters"));
+
+  type_ = type;
+  dim_num_ = dim_num;
+  mbr_num_ = mbr_num;
+  low_.clear();
+  high_.clear();
+
+  if (mbr_num_ == 0)
+    return Status::Ok();
+
+  switch (type_) {
+    case Datatype::INT8:
+      repr_ = Repr::I32;
+      build<int8_t>(mbrs);
+      break;
+    case Datatype::UINT8:
+      repr_ = Repr::I32;
+      build<uint8_t>(mbrs);
+      break;
+    case Datatype::INT16:
+      repr_ = Repr::I32;
+      build<int16_t>(mbrs);
+      break;
+    case Datatype::UINT16:
+      repr_ = Repr::I32;
+      build<uint16_t>(mbrs);
+      break;
+    case Datatype::INT32:
+      repr_ = Repr::I32;
+      build<int32_t>(mbrs);
+      break;
+    case Datatype::UINT32:
+      repr_ = Repr::I32;
+      build<uint32_t>(mbrs);
+      break;
+    case Datatype::INT64:
+      repr_ = Repr::I64;
+      build<int64_t>(mbrs);
+      break;
+    case Datatype::UINT64:
+      repr_ = Repr::I64;
+      build<uint64_t>(mbrs);
+      break;
+    case Datatype::FLOAT32:
+      repr_ = Repr::F32;
+      build<float>(mbrs);
+      break;
+    case Datatype::FLOAT64:
+      repr_ = Repr::F64;
+      build<double>(mbrs);
+      break;
+    default:
+      return LOG_STATUS(
+          Status::Error("Cannot initialize MBR filter; Invalid datatype"));
+  }
+
+  return Status::Ok();
+}
+
+uint64_t MBRFilter::mbr_num() const {
+  return mbr_num_;
+}
+
+template <class T>
+Status MBRFilter::get_candidates(
+    const T* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const {
+  assert(sizeof(T) == datatype_size(type_));
+  assert(end <= mbr_num_);
+
+  if (start >= end || mbr_num_ == 0)
+    return Status::Ok();
+
+  // Convert the subarray bounds to the canonical representation
+  typedef typename Canonical<T>::type C;
+  std::vector<C> sub_low(dim_num_), sub_high(dim_num_);
+  for (unsigned d = 0; d < dim_num_; ++d) {
+    sub_low[d] = Canonical<T>::convert(subarray[2 * d]);
+    sub_high[d] = Canonical<T>::convert(subarray[2 * d + 1]);
+  }
+
+  // Sweep with the matching kernel. The kernels are picked once, upon
+  // the first invocation. The casts via `void*` are no-ops: only the
+  // branch whose canonical type matches `C` can be reached at runtime.
+  auto low = (const void*)low_.data();
+  auto high = (const void*)high_.data();
+  auto slo = (const void*)sub_low.data();
+  auto shi = (const void*)sub_high.data();
+  switch (repr_) {
+    case Repr::I32: {
+      static const FilterFn<int32_t>::type impl = pick_filter_i32();
+      impl(
+          (const int32_t*)low,
+          (const int32_t*)high,
+          mbr_num_,
+          dim_num_,
+          (const int32_t*)slo,
+          (const int32_t*)shi,
+          start,
+          end,
+          candidates);
+      break;
+    }
+    case Repr::I64: {
+      static const FilterFn<int64_t>::type impl = pick_filter_i64();
+      impl(
+          (const int64_t*)low,
+          (const int64_t*)high,
+          mbr_num_,
+          dim_num_,
+          (const int64_t*)slo,
+          (const int64_t*)shi,
+          start,
+          end,
+          candidates);
+      break;
+    }
+    case Repr::F32: {
+      static const FilterFn<float>::type impl = pick_filter_f32();
+      impl(
+          (const float*)low,
+          (const float*)high,
+          mbr_num_,
+          dim_num_,
+          (const float*)slo,
+          (const float*)shi,
+          start,
+          end,
+          candidates);
+      break;
+    }
+    case Repr::F64: {
+      static const FilterFn<double>::type impl = pick_filter_f64();
+      impl(
+          (const double*)low,
+          (const double*)high,
+          mbr_num_,
+          dim_num_,
+          (const double*)slo,
+          (const double*)shi,
+          start,
+          end,
+          candidates);
+      break;
+    }
+  }
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+template <class T>
+void MBRFilter::build(const void* mbrs_in) {
+  typedef typename Canonical<T>::type C;
+  low_.resize(dim_num_ * mbr_num_ * sizeof(C));
+  high_.resize(dim_num_ * mbr_num_ * sizeof(C));
+  auto low = (C*)&low_[0];
+  auto high = (C*)&high_[0];
+  auto mbrs = (const T*)mbrs_in;
+  for (uint64_t j = 0; j < mbr_num_; ++j) {
+    for (unsigned d = 0; d < dim_num_; ++d) {
+      low[d * mbr_num_ + j] =
+          Canonical<T>::convert(mbrs[j * 2 * dim_num_ + 2 * d]);
+      high[d * mbr_num_ + j] =
+          Canonical<T>::convert(mbrs[j * 2 * dim_num_ + 2 * d + 1]);
+    }
+  }
+}
+
+// Explicit template instantiations
+template Status MBRFilter::get_candidates<int8_t>(
+    const int8_t* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<uint8_t>(
+    const uint8_t* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<int16_t>(
+    const int16_t* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<uint16_t>(
+    const uint16_t* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<int>(
+    const int* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<unsigned>(
+    const unsigned* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<int64_t>(
+    const int64_t* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<uint64_t>(
+    const uint64_t* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<float>(
+    const float* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+template Status MBRFilter::get_candidates<double>(
+    const double* subarray,
+    uint64_t start,
+    uint64_t end,
+    std::vector<uint64_t>* candidates) const;
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,289 @@
+/**
+ * @file   rtree.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class RTree.
+ */
+
+#include "tiledb/sm/fragment/rtree.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+RTree::RTree() {
+  type_ = Datatype::INT32;
+  dim_num_ = 0;
+  fanout_ = 0;
+  mbr_size_ = 0;
+  leaf_num_ = 0;
+}
+
+RTree::~RTree() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status RTree::init(
+    Datatype type,
+    unsigned dim_num,
+    unsigned fanout,
+    const std::vector<void*>& mbrs) {
+  if (dim_num == 0 || fanout < 2)
+    return LOG_STATUS(
+        Status::RTreeError("Cannot initialize R-tree; Invalid parameters"));
+
+  type_ = type;
+  dim_num_ = dim_num;
+  fanout_ = fanout;
+  mbr_size_ = 2 * dim_num * datatype_size(type);
+  leaf_num_ = mbrs.size();
+  levels_.clear();
+  level_filters_.clear();
+
+  if (leaf_num_ == 0)
+    return Status::Ok();
+
+  switch (type_) {
+    case Datatype::INT8:
+      return build<int8_t>(mbrs);
+    case Datatype::UINT8:
+      return build<uint8_t>(mbrs);
+    case Datatype::INT16:
+      return build<int16_t>(mbrs);
+    case Datatype::UINT16:
+      return build<uint16_t>(mbrs);
+    case Datatype::INT32:
+      return build<int>(mbrs);
+    case Datatype::UINT32:
+      return build<unsigned>(mbrs);
+    case Datatype::INT64:
+      return build<int64_t>(mbrs);
+    case Datatype::UINT64:
+      return build<uint64_t>(mbrs);
+    case Datatype::FLOAT32:
+      return build<float>(mbrs);
+    case Datatype::FLOAT64:
+      return build<double>(mbrs);
+    default:
+      return LOG_STATUS(
+          Status::RTreeError("Cannot initialize R-tree; Invalid datatype"));
+  }
+}
+
+uint64_t RTree::leaf_num() const {
+  return leaf_num_;
+}
+
+template <class T>
+Status RTree::get_overlapping_tiles(
+    const T* subarray, std::vector<std::pair<uint64_t, bool>>* tiles) const {
+  tiles->clear();
+
+  if (leaf_num_ == 0)
+    return Status::Ok();
+
+  assert(sizeof(T) == datatype_size(type_));
+
+  // Depth-first traversal. The stack stores nodes known to overlap the
+  // subarray; the children of a partially overlapping node are tested
+  // in one batch with the vectorized level filter and pushed in reverse
+  // order, so that the overlapping leaves are reported in ascending
+  // leaf order.
+  struct Entry {
+    unsigned level_;
+    uint64_t idx_;
+    bool full_;
+  };
+  std::vector<Entry> stack;
+  auto level_num = (unsigned)levels_.size();
+  auto root_level = level_num - 1;
+  auto root_num = levels_[root_level].size() / mbr_size_;
+
+  bool full_overlap;
+  for (uint64_t i = root_num; i > 0; --i) {
+    auto mbr = (const T*)&levels_[root_level][(i - 1) * mbr_size_];
+    if (overlap(subarray, mbr, dim_num_, &full_overlap))
+      stack.push_back({root_level, i - 1, full_overlap});
+  }
+
+  std::vector<uint64_t> candidates;
+  while (!stack.empty()) {
+    auto entry = stack.back();
+    stack.pop_back();
+
+    if (entry.level_ == 0) {
+      // Leaf node - report it
+      tiles->emplace_back(entry.idx_, entry.full_);
+      continue;
+    }
+
+    if (entry.full_) {
+      // The subarray fully contains the node, hence all the leaves in
+      // its subtree - report them without descending
+      uint64_t subtree_leaf_num = 1;
+      for (unsigned l = 0; l < entry.level_; ++l)
+        subtree_leaf_num *= fanout_;
+      auto first_leaf = entry.idx_ * subtree_leaf_num;
+      auto last_leaf = std::min(first_leaf + subtree_leaf_num, leaf_num_);
+      for (uint64_t i = first_leaf; i < last_leaf; ++i)
+        tiles->emplace_back(i, true);
+      continue;
+    }
+
+    // Partially overlapping internal node - batch-test its children,
+    // then determine the full-overlap flag only for the (typically few)
+    // overlapping ones
+    auto child_level = entry.level_ - 1;
+    auto child_num = levels_[child_level].size() / mbr_size_;
+    auto first_child = entry.idx_ * fanout_;
+    auto last_child = std::min<uint64_t>(first_child + fanout_, child_num);
+    candidates.clear();
+    RETURN_NOT_OK(level_filters_[child_level].get_candidates(
+        subarray, first_child, last_child, &candidates));
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+      auto mbr = (const T*)&levels_[child_level][*it * mbr_size_];
+      if (overlap(subarray, mbr, dim_num_, &full_overlap))
+        stack.push_back({child_level, *it, full_overlap});
+    }
+  }
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+template <class T>
+Status RTree::build(const std::vector<void*>& mbrs) {
+  auto coords_num = 2 * dim_num_;
+
+  // Create the leaf level, copying the input MBRs into a packed buffer
+  levels_.emplace_back(leaf_num_ * mbr_size_);
+  for (uint64_t i = 0; i < leaf_num_; ++i)
+    std::memcpy(&levels_[0][i * mbr_size_], mbrs[i], mbr_size_);
+
+  // Build the upper levels bottom-up, each node storing the MBR union
+  // of its (at most `fanout_`) children
+  uint64_t node_num = leaf_num_;
+  while (node_num > 1) {
+    uint64_t parent_num = (node_num + fanout_ - 1) / fanout_;
+    std::vector<uint8_t> parents(parent_num * mbr_size_);
+    auto children = (const T*)levels_.back().data();
+    auto parent = (T*)parents.data();
+    for (uint64_t p = 0; p < parent_num; ++p) {
+      auto first_child = p * fanout_;
+      auto last_child = std::min<uint64_t>(first_child + fanout_, node_num);
+      std::memcpy(
+          &parent[p * coords_num],
+          &children[first_child * coords_num],
+          mbr_size_);
+      for (uint64_t c = first_child + 1; c < last_child; ++c) {
+        auto child = &children[c * coords_num];
+        for (unsigned d = 0; d < dim_num_; ++d) {
+          parent[p * coords_num + 2 * d] =
+              std::min(parent[p * coords_num + 2 * d], child[2 * d]);
+          parent[p * coords_num + 2 * d + 1] =
+              std::max(parent[p * coords_num + 2 * d + 1], child[2 * d + 1]);
+        }
+      }
+    }
+    levels_.push_back(std::move(parents));
+    node_num = parent_num;
+  }
+
+  // Build the vectorized filters over the levels
+  level_filters_.resize(levels_.size());
+  for (size_t l = 0; l < levels_.size(); ++l)
+    RETURN_NOT_OK(level_filters_[l].init(
+        type_, dim_num_, levels_[l].data(), levels_[l].size() / mbr_size_));
+
+  return Status::Ok();
+}
+
+template <class T>
+bool RTree::overlap(
+    const T* a, const T* b, unsigned dim_num, bool* a_contains_b) {
+  for (unsigned i = 0; i < dim_num; ++i) {
+    if (a[2 * i] > b[2 * i + 1] || a[2 * i + 1] < b[2 * i])
+      return false;
+  }
+
+  *a_contains_b = true;
+  for (unsigned i = 0; i < dim_num; ++i) {
+    if (a[2 * i] > b[2 * i] || a[2 * i + 1] < b[2 * i + 1]) {
+      *a_contains_b = false;
+      break;
+    }
+  }
+
+  return true;
+}
+
+// Explicit template instantiations
+template Status RTree::get_overlapping_tiles<int8_t>(
+    const int8_t* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<uint8_t>(
+    const uint8_t* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<int16_t>(
+    const int16_t* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<uint16_t>(
+    const uint16_t* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<int>(
+    const int* subarray, std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<unsigned>(
+    const unsigned* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<int64_t>(
+    const int64_t* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<uint64_t>(
+    const uint64_t* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<float>(
+    const float* subarray, std::vector<std::pair<uint64_t, bool>>* tiles) const;
+template Status RTree::get_overlapping_tiles<double>(
+    const double* subarray,
+    std::vector<std::pair<uint64_t, bool>>* tiles) const;
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,162 @@
+/**
+ * @file   rtree.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class RTree.
+ */
+
+#ifndef TILEDB_RTREE_H
+#define TILEDB_RTREE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/fragment/mbr_filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A packed R-tree built bottom-up over the MBRs of a sparse fragment.
+ * The MBRs follow the global cell order and are, thus, spatially
+ * coherent, so grouping consecutive runs of `fanout` MBRs per node
+ * yields a good-quality tree without any re-sorting. The tree makes
+ * overlapping-tile computation logarithmic in the number of tiles,
+ * instead of linear.
+ */
+class RTree {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  RTree();
+
+  /** Destructor. */
+  ~RTree();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Builds the tree over the input MBRs, which become the tree leaves
+   * (in the input order).
+   *
+   * @param type The datatype of the MBR coordinates.
+   * @param dim_num The number of dimensions.
+   * @param fanout The maximum number of children per tree node.
+   * @param mbrs The MBRs to build the tree over. Each MBR consists of
+   *     `2 * dim_num` coordinates of type `type`, i.e., a (low, high)
+   *     pair per dimension.
+   * @return Status
+   */
+  Status init(
+      Datatype type,
+      unsigned dim_num,
+      unsigned fanout,
+      const std::vector<void*>& mbrs);
+
+  /** Returns the number of leaves (i.e., input MBRs) in the tree. */
+  uint64_t leaf_num() const;
+
+  /**
+   * Computes the leaves whose MBR overlaps the input subarray, by a
+   * depth-first tree traversal.
+   *
+   * @tparam T The type of the subarray and MBR coordinates.
+   * @param subarray The subarray to check overlap against.
+   * @param tiles It will store a (leaf index, full overlap) pair for
+   *     every overlapping leaf, in ascending leaf order. The flag is
+   *     `true` if the subarray fully contains the leaf MBR.
+   * @return Status
+   */
+  template <class T>
+  Status get_overlapping_tiles(
+      const T* subarray, std::vector<std::pair<uint64_t, bool>>* tiles) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The datatype of the MBR coordinates. */
+  Datatype type_;
+
+  /** The number of dimensions. */
+  unsigned dim_num_;
+
+  /** The maximum number of children per tree node. */
+  unsigned fanout_;
+
+  /** The size (in bytes) of a single MBR. */
+  uint64_t mbr_size_;
+
+  /** The number of leaves in the tree. */
+  uint64_t leaf_num_;
+
+  /**
+   * The tree levels as packed MBR buffers. `levels_[0]` holds the
+   * leaves and the last level holds the single root node. The children
+   * of node `i` at some level are nodes `[i * fanout_ ,
+   * (i + 1) * fanout_)` at the level below.
+   */
+  std::vector<std::vector<uint8_t>> levels_;
+
+  /**
+   * A structure-of-arrays mirror of each level, used to test all the
+   * children of a visited node against the subarray with vectorized
+   * compare/mask instructions instead of one scalar interval test per
+   * child per dimension.
+   */
+  std::vector<MBRFilter> level_filters_;
+
+  /* ********************************* */
+  /*           PRIVATE METHODS         */
+  /* ********************************* */
+
+  /** Builds the tree levels bottom-up over the input MBRs. */
+  template <class T>
+  Status build(const std::vector<void*>& mbrs);
+
+  /**
+   * Checks if `a` overlaps `b`, also setting `a_contains_b` to `true`
+   * if `a` fully contains `b`.
+   */
+  template <class T>
+  static bool overlap(const T* a, const T* b, unsigned dim_num, bool* a_contains_b);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_RTREE_H
@@ -41,6 +41,7 @@
 #include "tiledb/sm/fragment/write_state.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/radix_sort.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/tile/tile_io.h"
@@ -48,6 +49,21 @@
 namespace tiledb {
 namespace sm {
 
+/**
+ * Returns `true` if the cells at positions `[0, cell_num)` are already
+ * sorted with respect to the input comparator. Used to let append-mostly
+ * streams, which typically arrive pre-sorted, skip the sort after a
+ * linear verification scan.
+ */
+template <class Cmp>
+static bool cells_sorted(uint64_t cell_num, Cmp cmp) {
+  for (uint64_t i = 1; i < cell_num; ++i) {
+    if (cmp(i, i - 1))
+      return false;
+  }
+  return true;
+}
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -61,12 +77,24 @@ WriteState::WriteState() {
 }
 
 WriteState::~WriteState() {
+  // Wait for any in-flight tile writes
+  for (auto& task : write_tasks_) {
+    if (task.valid())
+      task.wait();
+  }
+
   for (auto& tile : tiles_)
     delete tile;
 
+  for (auto& tile : tiles_bg_)
+    delete tile;
+
   for (auto& tile_var : tiles_var_)
     delete tile_var;
 
+  for (auto& tile_var : tiles_var_bg_)
+    delete tile_var;
+
   for (auto& tile_io : tile_io_)
     delete tile_io;
 
@@ -109,6 +137,11 @@ Status WriteState::init(const Fragment* fragment) {
   for (unsigned int i = 0; i < attribute_num; ++i)
     buffer_var_offsets_[i] = 0;
 
+  // Initialize the structures for the in-flight tile writes
+  write_tasks_.resize(attribute_num + 1);
+  bytes_written_.resize(attribute_num + 1);
+  bytes_written_var_.resize(attribute_num + 1);
+
   mbr_ = std::malloc(2 * coords_size);
   if (mbr_ == nullptr)
     return LOG_STATUS(Status::WriteStateError(
@@ -154,6 +187,10 @@ Status WriteState::finalize() {
   if (!tiles_[attribute_num]->empty())
     RETURN_NOT_OK(write_last_tile());
 
+  // Wait for all in-flight tile writes
+  for (unsigned int i = 0; i < attribute_num + 1; ++i)
+    RETURN_NOT_OK(wait_tile_write(i));
+
   // Sync all attributes
   RETURN_NOT_OK(close_files());
 
@@ -189,22 +226,38 @@ Status WriteState::close_files() {
   auto attribute_ids = fragment_->query()->attribute_ids();
   auto storage_manager = fragment_->query()->storage_manager();
 
-  // Sync all attributes
+  // Collect the URIs of all attribute files
+  std::vector<URI> uris;
   for (auto attribute_id : attribute_ids) {
     // For all attributes
-    if (attribute_id == attribute_num) {
-      RETURN_NOT_OK(storage_manager->close_file(fragment_->coords_uri()));
-    } else {
-      RETURN_NOT_OK(
-          storage_manager->close_file(fragment_->attr_uri(attribute_id)));
-    }
+    if (attribute_id == attribute_num)
+      uris.push_back(fragment_->coords_uri());
+    else
+      uris.push_back(fragment_->attr_uri(attribute_id));
 
     // Only for variable-size attributes (they have an extra file)
     if (array_schema->var_size(attribute_id))
-      RETURN_NOT_OK(
-          storage_manager->close_file(fragment_->attr_var_uri(attribute_id)));
+      uris.push_back(fragment_->attr_var_uri(attribute_id));
   }
 
+  // Close all files concurrently; on S3 each close finalizes a multipart
+  // upload with a round of high-latency requests, so closing the files
+  // one by one would serialize those rounds
+  auto io_pool = storage_manager->io_thread_pool();
+  std::vector<std::future<Status>> tasks;
+  for (const auto& uri : uris)
+    tasks.push_back(io_pool->enqueue(
+        [storage_manager, uri]() { return storage_manager->close_file(uri); }));
+
+  // Wait for all the closes, recording the first error
+  Status st = Status::Ok();
+  for (auto& task : tasks) {
+    auto task_st = task.get();
+    if (st.ok() && !task_st.ok())
+      st = task_st;
+  }
+  RETURN_NOT_OK(st);
+
   // Success
   return Status::Ok();
 }
@@ -243,26 +296,56 @@ Status WriteState::write(void** buffers, uint64_t* buffer_sizes) {
     // For easy reference
     auto array_schema = fragment_->query()->array_schema();
 
-    // Write each attribute individually
+    // The per-attribute pipelines (tiling, compression, I/O) are fully
+    // independent until the metadata update, and all their state is
+    // indexed by attribute - write the attributes concurrently on the
+    // compute thread pool. The tile writes each pipeline dispatches
+    // internally go to the I/O thread pool, so the fan-out does not
+    // block on its own pool.
+    auto compute_pool = storage_manager->compute_thread_pool();
+    std::vector<std::future<Status>> tasks;
     unsigned int buffer_i = 0;
     for (unsigned int i = 0; i < attribute_id_num; ++i) {
-      if (!array_schema->var_size(attribute_ids[i])) {  // FIXED CELLS
-        RETURN_NOT_OK(write_attr(
-            attribute_ids[i], buffers[buffer_i], buffer_sizes[buffer_i]));
+      auto attribute_id = attribute_ids[i];
+      if (!array_schema->var_size(attribute_id)) {  // FIXED CELLS
+        auto buffer = buffers[buffer_i];
+        auto buffer_size = buffer_sizes[buffer_i];
+        tasks.push_back(
+            compute_pool->enqueue([this, attribute_id, buffer, buffer_size]() {
+              return write_attr(attribute_id, buffer, buffer_size);
+            }));
         ++buffer_i;
       } else {  // VARIABLE-SIZED CELLS
-        RETURN_NOT_OK(write_attr_var(
-            attribute_ids[i],
-            buffers[buffer_i],  // offsets
-            buffer_sizes[buffer_i],
-            buffers[buffer_i + 1],  // actual cell values
-            buffer_sizes[buffer_i + 1]));
+        auto buffer = buffers[buffer_i];  // offsets
+        auto buffer_size = buffer_sizes[buffer_i];
+        auto buffer_var = buffers[buffer_i + 1];  // actual cell values
+        auto buffer_var_size = buffer_sizes[buffer_i + 1];
+        tasks.push_back(compute_pool->enqueue(
+            [this,
+             attribute_id,
+             buffer,
+             buffer_size,
+             buffer_var,
+             buffer_var_size]() {
+              return write_attr_var(
+                  attribute_id,
+                  buffer,
+                  buffer_size,
+                  buffer_var,
+                  buffer_var_size);
+            }));
         buffer_i += 2;
       }
     }
 
-    // Success
-    return Status::Ok();
+    // Wait for all the attribute writes, recording the first error
+    Status st = Status::Ok();
+    for (auto& task : tasks) {
+      auto task_st = task.get();
+      if (st.ok() && !task_st.ok())
+        st = task_st;
+    }
+    return st;
   }
 
   if (layout == Layout::UNORDERED)  // UNORDERED
@@ -276,22 +359,237 @@ Status WriteState::write(void** buffers, uint64_t* buffer_sizes) {
 /*         PRIVATE METHODS        */
 /* ****************************** */
 
+Status WriteState::dispatch_tile_write(unsigned int attribute_id) {
+  // Wait for the previous write of this attribute, so that at most one
+  // write per attribute is in flight and the tile order is preserved
+  RETURN_NOT_OK(wait_tile_write(attribute_id));
+
+  // For easy reference
+  auto array_schema = fragment_->query()->array_schema();
+  auto attribute_num = array_schema->attribute_num();
+  bool var_size =
+      (attribute_id < attribute_num) && array_schema->var_size(attribute_id);
+
+  // Swap in the spare tile(s)
+  std::swap(tiles_[attribute_id], tiles_bg_[attribute_id]);
+  if (var_size)
+    std::swap(tiles_var_[attribute_id], tiles_var_bg_[attribute_id]);
+
+  // Compress and write the full tile(s) in the background
+  auto tile = tiles_bg_[attribute_id];
+  auto tile_var = (var_size) ? tiles_var_bg_[attribute_id] : (Tile*)nullptr;
+
+  // Record the statistics of the completed tile
+  append_tile_stats(attribute_id, tile->data(), tile->size());
+
+  if (tile_var != nullptr)
+    tile_var->set_offsets_tile(tile);
+  auto tile_io = tile_io_[attribute_id];
+  auto tile_io_var = (var_size) ? tile_io_var_[attribute_id] : (TileIO*)nullptr;
+  auto bytes_written = &bytes_written_[attribute_id];
+  auto bytes_written_var = &bytes_written_var_[attribute_id];
+  auto io_pool = fragment_->query()->storage_manager()->io_thread_pool();
+  write_tasks_[attribute_id] = io_pool->enqueue(
+      [tile, tile_var, tile_io, tile_io_var, bytes_written, bytes_written_var]() {
+        RETURN_NOT_OK(tile_io->write(tile, bytes_written));
+        if (tile_var != nullptr)
+          RETURN_NOT_OK(tile_io_var->write(tile_var, bytes_written_var));
+        return Status::Ok();
+      });
+
+  // Reset the swapped-in tile(s) for filling
+  tiles_[attribute_id]->reset_offset();
+  tiles_[attribute_id]->set_size(0);
+  if (var_size) {
+    tiles_var_[attribute_id]->reset_offset();
+    tiles_var_[attribute_id]->set_size(0);
+  }
+
+  return Status::Ok();
+}
+
+Status WriteState::dispatch_tile_write_direct(
+    unsigned int attribute_id, void* data, uint64_t size) {
+  // Wait for the previous write of this attribute, so that at most one
+  // write per attribute is in flight and the tile order is preserved
+  RETURN_NOT_OK(wait_tile_write(attribute_id));
+
+  // For easy reference
+  auto array_schema = fragment_->query()->array_schema();
+  auto attribute_num = array_schema->attribute_num();
+
+  // Record the statistics of the completed tile
+  append_tile_stats(attribute_id, data, size);
+
+  // Wrap the user memory in a temporary tile, without copying
+  auto buff = new Buffer(data, size, false);
+  auto tile = (Tile*)nullptr;
+  if (attribute_id == attribute_num) {  // Coordinates
+    tile = new Tile(
+        array_schema->coords_type(),
+        array_schema->coords_compression(),
+        array_schema->coords_compression_level(),
+        array_schema->coords_size(),
+        array_schema->domain()->dim_num(),
+        buff,
+        true);
+  } else {
+    auto attr = array_schema->attribute(attribute_id);
+    tile = new Tile(
+        attr->type(),
+        attr->compressor(),
+        attr->compression_level(),
+        attr->cell_size(),
+        0,
+        buff,
+        true);
+    tile->set_shuffle(attr->shuffle());
+  }
+
+  // Compress and write the tile in the background
+  auto tile_io = tile_io_[attribute_id];
+  auto bytes_written = &bytes_written_[attribute_id];
+  auto io_pool = fragment_->query()->storage_manager()->io_thread_pool();
+  write_tasks_[attribute_id] =
+      io_pool->enqueue([tile, tile_io, bytes_written]() {
+        Status st = tile_io->write(tile, bytes_written);
+        delete tile;
+        return st;
+      });
+
+  return Status::Ok();
+}
+
+Status WriteState::wait_tile_write(unsigned int attribute_id) {
+  // Trivial case - no write in flight
+  if (!write_tasks_[attribute_id].valid())
+    return Status::Ok();
+
+  RETURN_NOT_OK(write_tasks_[attribute_id].get());
+
+  // For easy reference
+  auto array_schema = fragment_->query()->array_schema();
+  auto attribute_num = array_schema->attribute_num();
+  bool var_size =
+      (attribute_id < attribute_num) && array_schema->var_size(attribute_id);
+
+  // Append the offsets of the completed write to the metadata
+  metadata_->append_tile_offset(attribute_id, bytes_written_[attribute_id]);
+  if (var_size) {
+    metadata_->append_tile_var_offset(
+        attribute_id, bytes_written_var_[attribute_id]);
+    metadata_->append_tile_var_size(
+        attribute_id, tiles_var_bg_[attribute_id]->size());
+  }
+
+  return Status::Ok();
+}
+
+void WriteState::append_tile_stats(
+    unsigned int attribute_id, const void* data, uint64_t size) {
+  // Applicable only to fixed-sized, single-value attributes
+  auto array_schema = fragment_->query()->array_schema();
+  auto attribute_num = array_schema->attribute_num();
+  if (attribute_id == attribute_num || array_schema->var_size(attribute_id))
+    return;
+  auto attr = array_schema->attribute(attribute_id);
+  if (attr->cell_val_num() != 1)
+    return;
+
+  switch (attr->type()) {
+    case Datatype::CHAR:
+      append_tile_stats<char, int64_t>(attribute_id, data, size);
+      break;
+    case Datatype::INT8:
+      append_tile_stats<int8_t, int64_t>(attribute_id, data, size);
+      break;
+    case Datatype::UINT8:
+      append_tile_stats<uint8_t, uint64_t>(attribute_id, data, size);
+      break;
+    case Datatype::INT16:
+      append_tile_stats<int16_t, int64_t>(attribute_id, data, size);
+      break;
+    case Datatype::UINT16:
+      append_tile_stats<uint16_t, uint64_t>(attribute_id, data, size);
+      break;
+    case Datatype::INT32:
+      append_tile_stats<int, int64_t>(attribute_id, data, size);
+      break;
+    case Datatype::UINT32:
+      append_tile_stats<unsigned, uint64_t>(attribute_id, data, size);
+      break;
+    case Datatype::INT64:
+      append_tile_stats<int64_t, int64_t>(attribute_id, data, size);
+      break;
+    case Datatype::UINT64:
+      append_tile_stats<uint64_t, uint64_t>(attribute_id, data, size);
+      break;
+    case Datatype::FLOAT32:
+      append_tile_stats<float, double>(attribute_id, data, size);
+      break;
+    case Datatype::FLOAT64:
+      append_tile_stats<double, double>(attribute_id, data, size);
+      break;
+    default:
+      // No statistics for non-numeric attributes
+      break;
+  }
+}
+
+template <class T, class SumT>
+void WriteState::append_tile_stats(
+    unsigned int attribute_id, const void* data, uint64_t size) {
+  auto cells = (const T*)data;
+  uint64_t cell_num = size / sizeof(T);
+  if (cell_num == 0)
+    return;
+
+  T min = cells[0];
+  T max = cells[0];
+  SumT sum = 0;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    min = std::min(min, cells[i]);
+    max = std::max(max, cells[i]);
+    sum += (SumT)cells[i];
+  }
+
+  uint64_t sum_bits = 0;
+  std::memcpy(&sum_bits, &sum, sizeof(SumT));
+  metadata_->append_tile_stats(attribute_id, &min, &max, sum_bits);
+}
+
 template <class T>
-void WriteState::expand_mbr(const T* coords) {
+void WriteState::expand_mbr(const T* coords, uint64_t cell_num) {
   // For easy reference
   auto array_schema = fragment_->query()->array_schema();
   auto attribute_num = array_schema->attribute_num();
   auto dim_num = array_schema->dim_num();
   auto mbr = static_cast<T*>(mbr_);
 
-  // Initialize MBR
+  if (cell_num == 0)
+    return;
+
+  // Initialize MBR from the first cell of the tile
   if (tile_cell_num_[attribute_num] == 0) {
     for (unsigned int i = 0; i < dim_num; ++i) {
       mbr[2 * i] = coords[i];
       mbr[2 * i + 1] = coords[i];
     }
-  } else {  // Expand MBR
-    utils::expand_mbr(mbr, coords, dim_num);
+  }
+
+  // One pass per dimension with branchless min/max, which the compiler
+  // vectorizes, instead of a branchy per-cell expansion
+  for (unsigned int d = 0; d < dim_num; ++d) {
+    T min = mbr[2 * d];
+    T max = mbr[2 * d + 1];
+    auto c = coords + d;
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      T v = c[i * dim_num];
+      min = (v < min) ? v : min;
+      max = (v > max) ? v : max;
+    }
+    mbr[2 * d] = min;
+    mbr[2 * d + 1] = max;
   }
 }
 
@@ -300,52 +598,66 @@ Status WriteState::init_tiles() {
   auto attribute_num = array_schema->attribute_num();
   auto tile = (Tile*)nullptr;
 
+  // Two tiles are created per attribute - one being filled and one
+  // potentially being compressed/written in the background
   for (unsigned int i = 0; i < attribute_num; ++i) {
     auto attr = array_schema->attribute(i);
     bool var_size = attr->var_size();
 
-    tile = new Tile();
-    RETURN_NOT_OK_ELSE(
-        tile->init(
-            (var_size) ? constants::cell_var_offset_type : attr->type(),
-            (var_size) ? array_schema->cell_var_offsets_compression() :
-                         attr->compressor(),
-            (var_size) ? array_schema->cell_var_offsets_compression_level() :
-                         attr->compression_level(),
-            fragment_->tile_size(i),
-            (var_size) ? constants::cell_var_offset_size : attr->cell_size(),
-            0),
-        delete tile);
-    tiles_.emplace_back(tile);
-
-    if (var_size) {
+    for (auto tiles : {&tiles_, &tiles_bg_}) {
       tile = new Tile();
       RETURN_NOT_OK_ELSE(
           tile->init(
-              attr->type(),
-              attr->compressor(),
-              attr->compression_level(),
+              (var_size) ? constants::cell_var_offset_type : attr->type(),
+              (var_size) ? array_schema->cell_var_offsets_compression() :
+                           attr->compressor(),
+              (var_size) ? array_schema->cell_var_offsets_compression_level() :
+                           attr->compression_level(),
               fragment_->tile_size(i),
-              datatype_size(attr->type()),
+              (var_size) ? constants::cell_var_offset_size : attr->cell_size(),
               0),
           delete tile);
-      tiles_var_.emplace_back(tile);
-    } else {
-      tiles_var_.emplace_back(nullptr);
+      if (!var_size)
+        tile->set_shuffle(attr->shuffle());
+      else
+        tile->set_offsets_32(attr->offsets_32());
+      tiles->emplace_back(tile);
+    }
+
+    for (auto tiles_var : {&tiles_var_, &tiles_var_bg_}) {
+      if (var_size) {
+        tile = new Tile();
+        RETURN_NOT_OK_ELSE(
+            tile->init(
+                attr->type(),
+                attr->compressor(),
+                attr->compression_level(),
+                fragment_->tile_size(i),
+                datatype_size(attr->type()),
+                0),
+            delete tile);
+        tile->set_shuffle(attr->shuffle());
+        tile->set_dict_encode(attr->dict_encode());
+        tiles_var->emplace_back(tile);
+      } else {
+        tiles_var->emplace_back(nullptr);
+      }
     }
   }
 
-  tile = new Tile();
-  RETURN_NOT_OK_ELSE(
-      tile->init(
-          array_schema->coords_type(),
-          array_schema->coords_compression(),
-          array_schema->coords_compression_level(),
-          fragment_->tile_size(array_schema->attribute_num()),
-          array_schema->coords_size(),
-          array_schema->domain()->dim_num()),
-      delete tile);
-  tiles_.emplace_back(tile);
+  for (auto tiles : {&tiles_, &tiles_bg_}) {
+    tile = new Tile();
+    RETURN_NOT_OK_ELSE(
+        tile->init(
+            array_schema->coords_type(),
+            array_schema->coords_compression(),
+            array_schema->coords_compression_level(),
+            fragment_->tile_size(array_schema->attribute_num()),
+            array_schema->coords_size(),
+            array_schema->domain()->dim_num()),
+        delete tile);
+    tiles->emplace_back(tile);
+  }
 
   return Status::Ok();
 }
@@ -422,22 +734,41 @@ void WriteState::sort_cell_pos(
   for (uint64_t i = 0; i < buffer_cell_num; ++i)
     (*cell_pos)[i] = i;
 
+  // Integer coordinates in row-/col-major cell order that fit in 128-bit
+  // keys are sorted with the key-based parallel path
+  bool with_keys =
+      std::is_integral<T>::value &&
+      (cell_order == Layout::ROW_MAJOR || cell_order == Layout::COL_MAJOR) &&
+      dim_num * sizeof(T) * 8 <= 128;
+
   // Invoke the proper sort function, based on the cell order
   if (domain->tile_extents() == nullptr) {  // NO TILE GRID
-    // Sort cell positions
+    if (with_keys) {
+      sort_cell_pos_with_keys<T>(
+          buffer_T, buffer_cell_num, std::vector<uint64_t>(), cell_pos);
+      return;
+    }
+    // Sort cell positions, unless the input is already sorted
     switch (cell_order) {
-      case Layout::ROW_MAJOR:
-        std::sort(
-            cell_pos->begin(),
-            cell_pos->end(),
-            SmallerRow<T>(buffer_T, dim_num));
+      case Layout::ROW_MAJOR: {
+        SmallerRow<T> cmp(buffer_T, dim_num);
+        if (!cells_sorted(buffer_cell_num, cmp))
+          std::sort(cell_pos->begin(), cell_pos->end(), cmp);
         break;
-      case Layout::COL_MAJOR:
-        std::sort(
-            cell_pos->begin(),
-            cell_pos->end(),
-            SmallerCol<T>(buffer_T, dim_num));
+      }
+      case Layout::COL_MAJOR: {
+        SmallerCol<T> cmp(buffer_T, dim_num);
+        if (!cells_sorted(buffer_cell_num, cmp))
+          std::sort(cell_pos->begin(), cell_pos->end(), cmp);
         break;
+      }
+      case Layout::MORTON: {
+        SmallerMorton<T> cmp(
+            buffer_T, dim_num, static_cast<const T*>(domain->domain()));
+        if (!cells_sorted(buffer_cell_num, cmp))
+          std::sort(cell_pos->begin(), cell_pos->end(), cmp);
+        break;
+      }
       default:  // Error
         assert(0);
     }
@@ -447,26 +778,140 @@ void WriteState::sort_cell_pos(
     ids.resize(buffer_cell_num);
     for (uint64_t i = 0; i < buffer_cell_num; ++i)
       ids[i] = domain->tile_id<T>(&buffer_T[i * dim_num], (T*)tile_coords_aux_);
-    // Sort cell positions
+    if (with_keys) {
+      sort_cell_pos_with_keys<T>(buffer_T, buffer_cell_num, ids, cell_pos);
+      return;
+    }
+    // Sort cell positions, unless the input is already sorted
     switch (cell_order) {
-      case Layout::ROW_MAJOR:
-        std::sort(
-            cell_pos->begin(),
-            cell_pos->end(),
-            SmallerIdRow<T>(buffer_T, dim_num, ids));
+      case Layout::ROW_MAJOR: {
+        SmallerIdRow<T> cmp(buffer_T, dim_num, ids);
+        if (!cells_sorted(buffer_cell_num, cmp))
+          std::sort(cell_pos->begin(), cell_pos->end(), cmp);
         break;
-      case Layout::COL_MAJOR:
-        std::sort(
-            cell_pos->begin(),
-            cell_pos->end(),
-            SmallerIdCol<T>(buffer_T, dim_num, ids));
+      }
+      case Layout::COL_MAJOR: {
+        SmallerIdCol<T> cmp(buffer_T, dim_num, ids);
+        if (!cells_sorted(buffer_cell_num, cmp))
+          std::sort(cell_pos->begin(), cell_pos->end(), cmp);
         break;
+      }
+      case Layout::MORTON: {
+        SmallerIdMorton<T> cmp(
+            buffer_T, dim_num, static_cast<const T*>(domain->domain()), ids);
+        if (!cells_sorted(buffer_cell_num, cmp))
+          std::sort(cell_pos->begin(), cell_pos->end(), cmp);
+        break;
+      }
       default:  // Error
         assert(0);
     }
   }
 }
 
+template <class T>
+void WriteState::sort_cell_pos_with_keys(
+    const T* buffer,
+    uint64_t cell_num,
+    const std::vector<uint64_t>& tile_ids,
+    std::vector<uint64_t>* cell_pos) const {
+  // For easy reference
+  auto query = fragment_->query();
+  auto array_schema = query->array_schema();
+  auto dim_num = array_schema->dim_num();
+  Layout cell_order = array_schema->cell_order();
+  auto pool = query->storage_manager()->compute_thread_pool();
+  auto dim_bits = (unsigned)(sizeof(T) * 8);
+  bool wide = dim_num * dim_bits > 64;
+
+  // Mask that truncates a coordinate value to its type width, and the
+  // bit to flip so that signed values compare correctly as unsigned
+  const uint64_t mask =
+      (dim_bits == 64) ? ~uint64_t(0) : ((uint64_t(1) << dim_bits) - 1);
+  const uint64_t sign_bit =
+      std::is_signed<T>::value ? (uint64_t(1) << (dim_bits - 1)) : 0;
+
+  // Pack each cell's coordinates once into big-endian keys of up to two
+  // 64-bit words, interleaving the dimensions in comparison order
+  std::vector<uint64_t> key_hi;
+  if (wide)
+    key_hi.resize(cell_num);
+  std::vector<std::pair<uint64_t, uint64_t>> key_pos(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    auto c = &buffer[i * dim_num];
+    uint64_t hi = 0, lo = 0;
+    if (cell_order == Layout::ROW_MAJOR) {
+      for (unsigned d = 0; d < dim_num; ++d) {
+        auto v = (((uint64_t)c[d]) & mask) ^ sign_bit;
+        if (dim_bits == 64) {
+          hi = lo;
+          lo = v;
+        } else {
+          hi = (hi << dim_bits) | (lo >> (64 - dim_bits));
+          lo = (lo << dim_bits) | v;
+        }
+      }
+    } else {  // COL_MAJOR
+      for (unsigned d = dim_num - 1;; --d) {
+        auto v = (((uint64_t)c[d]) & mask) ^ sign_bit;
+        if (dim_bits == 64) {
+          hi = lo;
+          lo = v;
+        } else {
+          hi = (hi << dim_bits) | (lo >> (64 - dim_bits));
+          lo = (lo << dim_bits) | v;
+        }
+        if (d == 0)
+          break;
+      }
+    }
+    if (wide)
+      key_hi[i] = hi;
+    key_pos[i] = std::make_pair(lo, i);
+  }
+
+  // Append-mostly streams typically arrive pre-sorted - verify with a
+  // linear scan over the keys and keep the identity positions computed
+  // by the caller if so
+  bool sorted = true;
+  for (uint64_t i = 1; i < cell_num && sorted; ++i) {
+    uint64_t ta = tile_ids.empty() ? 0 : tile_ids[i - 1];
+    uint64_t tb = tile_ids.empty() ? 0 : tile_ids[i];
+    if (ta != tb) {
+      sorted = (ta < tb);
+      continue;
+    }
+    uint64_t ha = wide ? key_hi[i - 1] : 0;
+    uint64_t hb = wide ? key_hi[i] : 0;
+    if (ha != hb) {
+      sorted = (ha < hb);
+      continue;
+    }
+    sorted = (key_pos[i - 1].first <= key_pos[i].first);
+  }
+  if (sorted)
+    return;
+
+  // Stable least-significant-word sort: the coordinate key words from
+  // low to high, then the tile id (which dominates the global order)
+  radix_sort::sort_pairs(pool, &key_pos);
+  if (wide) {
+    for (auto& kp : key_pos)
+      kp.first = key_hi[kp.second];
+    radix_sort::sort_pairs(pool, &key_pos);
+  }
+  if (!tile_ids.empty()) {
+    for (auto& kp : key_pos)
+      kp.first = tile_ids[kp.second];
+    radix_sort::sort_pairs(pool, &key_pos);
+  }
+
+  // Store the sorted positions
+  cell_pos->resize(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    (*cell_pos)[i] = key_pos[i].second;
+}
+
 Status WriteState::update_metadata(const void* buffer, uint64_t buffer_size) {
   // For easy reference
   auto array_schema = fragment_->query()->array_schema();
@@ -516,25 +961,34 @@ Status WriteState::update_metadata(const void* buffer, uint64_t buffer_size) {
   auto buffer_T = static_cast<const T*>(buffer);
   uint64_t& tile_cell_num = tile_cell_num_[attribute_num];
 
-  // Update bounding coordinates and MBRs
-  for (uint64_t i = 0; i < buffer_cell_num; ++i) {
+  // Update bounding coordinates and MBRs one tile batch at a time, so
+  // that the per-dimension min/max runs over the whole batch
+  uint64_t i = 0;
+  while (i < buffer_cell_num) {
     // Set first bounding coordinates
     if (tile_cell_num == 0)
       std::memcpy(bounding_coords_, &buffer_T[i * dim_num], coords_size);
 
-    // Expand MBR
-    expand_mbr(&buffer_T[i * dim_num]);
+    // The cells of this batch that fall in the current tile
+    uint64_t batch_cell_num =
+        std::min(capacity - tile_cell_num, buffer_cell_num - i);
+
+    // Expand MBR over the batch
+    expand_mbr(&buffer_T[i * dim_num], batch_cell_num);
 
-    // Advance a cell
-    ++tile_cell_num;
+    // Feed the fragment Bloom filter
+    for (uint64_t j = 0; j < batch_cell_num; ++j)
+      metadata_->append_coords_hash(&buffer_T[(i + j) * dim_num]);
 
-    assert(buffer_cell_num != 0);
+    // Advance the batch
+    i += batch_cell_num;
+    tile_cell_num += batch_cell_num;
 
     // Set second bounding coordinates
-    if (i == buffer_cell_num - 1 || tile_cell_num == capacity)
+    if (i == buffer_cell_num || tile_cell_num == capacity)
       std::memcpy(
           static_cast<char*>(bounding_coords_) + coords_size,
-          &buffer_T[i * dim_num],
+          &buffer_T[(i - 1) * dim_num],
           coords_size);
 
     // Send MBR and bounding coordinates to metadata
@@ -565,23 +1019,36 @@ Status WriteState::write_attr(
   // Preparation
   auto buf = new ConstBuffer(buffer, buffer_size);
   auto tile = tiles_[attribute_id];
-  auto tile_io = tile_io_[attribute_id];
+  uint64_t tile_size = fragment_->tile_size(attribute_id);
+  bool direct_writes = false;
 
-  // Fill tiles and dispatch them for writing
-  uint64_t bytes_written = 0;
+  // Fill tiles and dispatch them for writing in the background
   do {
-    RETURN_NOT_OK(tile->write(buf));
-    if (tile->full()) {
-      RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
-      metadata_->append_tile_offset(attribute_id, bytes_written);
-      tile->reset_offset();
-      tile->set_size(0);
+    if (tile->empty() && buf->nbytes_left_to_read() >= tile_size) {
+      // The buffer holds at least one more full tile and the fill tile
+      // is empty - stream the tile directly from the user buffer,
+      // without an intermediate copy
+      RETURN_NOT_OK(dispatch_tile_write_direct(
+          attribute_id, (char*)buffer + buf->offset(), tile_size));
+      buf->advance_offset(tile_size);
+      direct_writes = true;
+    } else {
+      RETURN_NOT_OK(tile->write(buf));
+      if (tile->full()) {
+        RETURN_NOT_OK(dispatch_tile_write(attribute_id));
+        tile = tiles_[attribute_id];
+      }
     }
   } while (!buf->end());
 
   // Clean up
   delete buf;
 
+  // The directly dispatched tiles reference the user buffer, which may
+  // get invalidated once this call returns - wait for the last write
+  if (direct_writes)
+    RETURN_NOT_OK(wait_tile_write(attribute_id));
+
   cells_written_[attribute_id] +=
       buffer_size / array_schema->cell_size(attribute_id);
 
@@ -593,6 +1060,12 @@ Status WriteState::write_attr_last(unsigned int attribute_id) {
   assert(!tile->empty());
   auto tile_io = tile_io_[attribute_id];
 
+  // Wait for any in-flight write of this attribute
+  RETURN_NOT_OK(wait_tile_write(attribute_id));
+
+  // Record the statistics of the last (possibly partial) tile
+  append_tile_stats(attribute_id, tile->data(), tile->size());
+
   // Fill tiles and dispatch them for writing
   uint64_t bytes_written;
   RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
@@ -624,12 +1097,8 @@ Status WriteState::write_attr_var(
 
   auto tile = tiles_[attribute_id];
   auto tile_var = tiles_var_[attribute_id];
-  auto tile_io = tile_io_[attribute_id];
-  auto tile_io_var = tile_io_var_[attribute_id];
 
-  // Fill tiles and dispatch them for writing
-  uint64_t bytes_written = 0;
-  uint64_t bytes_written_var = 0;
+  // Fill tiles and dispatch them for writing in the background
   auto current_var_offset = buffer_var_offset;
   do {
     RETURN_NOT_OK(tile->write_with_shift(buf, buffer_var_offset));
@@ -643,15 +1112,9 @@ Status WriteState::write_attr_var(
     current_var_offset += bytes_to_write_var;
 
     if (tile->full()) {
-      RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
-      RETURN_NOT_OK(tile_io_var->write(tile_var, &bytes_written_var));
-      metadata_->append_tile_offset(attribute_id, bytes_written);
-      metadata_->append_tile_var_offset(attribute_id, bytes_written_var);
-      metadata_->append_tile_var_size(attribute_id, tile_var->size());
-      tile->reset_offset();
-      tile->set_size(0);
-      tile_var->reset_offset();
-      tile_var->set_size(0);
+      RETURN_NOT_OK(dispatch_tile_write(attribute_id));
+      tile = tiles_[attribute_id];
+      tile_var = tiles_var_[attribute_id];
     }
   } while (!buf->end());
 
@@ -672,8 +1135,12 @@ Status WriteState::write_attr_var_last(unsigned int attribute_id) {
   auto tile_io = tile_io_[attribute_id];
   auto tile_io_var = tile_io_var_[attribute_id];
 
+  // Wait for any in-flight write of this attribute
+  RETURN_NOT_OK(wait_tile_write(attribute_id));
+
   // Fill tiles and dispatch them for writing
   uint64_t bytes_written, bytes_written_var;
+  tile_var->set_offsets_tile(tile);
   RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
   RETURN_NOT_OK(tile_io_var->write(tile_var, &bytes_written_var));
   metadata_->append_tile_offset(attribute_id, bytes_written);
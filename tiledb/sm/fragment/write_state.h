@@ -37,6 +37,7 @@
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/tile/tile.h"
 
+#include <future>
 #include <iostream>
 #include <vector>
 
@@ -80,7 +81,8 @@ class WriteState {
 
   /**
    * Closes all attribute files in the fragment, flushing all internal state
-   * to persistent storage.
+   * to persistent storage. The files are closed concurrently on the I/O
+   * thread pool, since on S3 each close finalizes a multipart upload.
    *
    * @return Status
    */
@@ -133,9 +135,37 @@ class WriteState {
   /** The current tiles, one per attribute. */
   std::vector<Tile*> tiles_;
 
+  /**
+   * The spare tiles used for double buffering, one per attribute. While
+   * the spare tile of an attribute is being compressed and written in the
+   * background, the corresponding tile in `tiles_` gets filled.
+   */
+  std::vector<Tile*> tiles_bg_;
+
   /** The current variable-sized tiles, one per attribute. */
   std::vector<Tile*> tiles_var_;
 
+  /**
+   * The spare variable-sized tiles used for double buffering, one per
+   * attribute.
+   */
+  std::vector<Tile*> tiles_var_bg_;
+
+  /** The in-flight tile write tasks, one per attribute. */
+  std::vector<std::future<Status>> write_tasks_;
+
+  /**
+   * The number of bytes written by the in-flight tile write of each
+   * attribute.
+   */
+  std::vector<uint64_t> bytes_written_;
+
+  /**
+   * The number of bytes written by the in-flight variable-sized tile
+   * write of each attribute.
+   */
+  std::vector<uint64_t> bytes_written_var_;
+
   /**
    * The objects that perform tile I/O, one per attribute and one for
    * the dimensions.
@@ -152,14 +182,84 @@ class WriteState {
   /* ********************************* */
 
   /**
-   * Expands the current MBR with the input coordinates.
+   * Dispatches the compression and write of the currently full tile(s) of
+   * an attribute to the I/O thread pool, swapping in the spare tile(s) so
+   * that the caller keeps filling the next tile while the full one
+   * compresses and writes in the background. It first waits for the
+   * previous write of the attribute (if any), so that at most one write
+   * per attribute is in flight and the tile order in the file is
+   * preserved.
+   *
+   * @param attribute_id The id of the attribute this operation focuses on.
+   * @return Status
+   */
+  Status dispatch_tile_write(unsigned int attribute_id);
+
+  /**
+   * Compresses and writes a full tile that lies entirely in the user
+   * buffer, wrapping the user memory in a temporary tile instead of
+   * copying it into the attribute fill tile. The compression and I/O
+   * happen in the background, exactly like in `dispatch_tile_write`.
+   * The caller must wait for the write to complete (see
+   * `wait_tile_write`) before the user buffer gets invalidated.
+   *
+   * @param attribute_id The id of the attribute this operation focuses on.
+   * @param data The user buffer holding the full tile.
+   * @param size The tile size in bytes.
+   * @return Status
+   */
+  Status dispatch_tile_write_direct(
+      unsigned int attribute_id, void* data, uint64_t size);
+
+  /**
+   * Waits for the in-flight tile write of an attribute (if any) to
+   * complete and appends the resulting offsets to the fragment metadata.
+   *
+   * @param attribute_id The id of the attribute this operation focuses on.
+   * @return Status
+   */
+  Status wait_tile_write(unsigned int attribute_id);
+
+  /**
+   * Computes the min/max/sum statistics of a completed tile and appends
+   * them to the fragment metadata. Applicable only to fixed-sized,
+   * single-value attributes; a no-op for the rest (including the
+   * coordinates).
+   *
+   * @param attribute_id The id of the attribute the tile belongs to.
+   * @param data The tile data.
+   * @param size The tile size in bytes.
+   * @return void
+   */
+  void append_tile_stats(
+      unsigned int attribute_id, const void* data, uint64_t size);
+
+  /**
+   * Typed implementation of `append_tile_stats`.
+   *
+   * @tparam T The attribute cell type.
+   * @tparam SumT The type the sum is accumulated in.
+   * @param attribute_id The id of the attribute the tile belongs to.
+   * @param data The tile data.
+   * @param size The tile size in bytes.
+   * @return void
+   */
+  template <class T, class SumT>
+  void append_tile_stats(
+      unsigned int attribute_id, const void* data, uint64_t size);
+
+  /**
+   * Expands the current MBR with a batch of coordinates that belong to
+   * the same tile. The minimum/maximum of each dimension is computed
+   * over the whole batch with a tight branchless loop.
    *
    * @tparam T The type of the MBR and the input coordinates.
    * @param coords The input coordinates.
+   * @param cell_num The number of cells in the batch.
    * @return void
    */
   template <class T>
-  void expand_mbr(const T* coords);
+  void expand_mbr(const T* coords, uint64_t cell_num);
 
   /** Initializes the internal tile structures. */
   Status init_tiles();
@@ -199,6 +299,29 @@ class WriteState {
       uint64_t buffer_size,
       std::vector<uint64_t>* cell_pos) const;
 
+  /**
+   * Sorts the input cell coordinates by packing each cell's position in
+   * the global order into fixed-width integer keys once, and sorting the
+   * keys with the parallel radix sort on the compute thread pool. This
+   * replaces the comparator-based `std::sort`, which re-reads the
+   * coordinate buffer on every comparison. Applicable only to integer
+   * coordinates in row-/col-major cell order that fit in 128-bit keys.
+   *
+   * @tparam T The type of coordinates stored in *buffer*.
+   * @param buffer The buffer holding the cell coordinates.
+   * @param cell_num The number of cells in *buffer*.
+   * @param tile_ids The precomputed tile id of each cell. Empty if the
+   *     domain has no tile grid.
+   * @param cell_pos The sorted cell positions.
+   * @return void
+   */
+  template <class T>
+  void sort_cell_pos_with_keys(
+      const T* buffer,
+      uint64_t cell_num,
+      const std::vector<uint64_t>& tile_ids,
+      std::vector<uint64_t>* cell_pos) const;
+
   /**
    * Updates the metadata structures as tiles are written. Specifically, it
    * updates the MBR and bounding coordinates of each tile.
@@ -223,7 +346,10 @@ class WriteState {
 
   /**
    * Performs the write operation for the case of a dense fragment, focusing
-   * on a single fixed-sized attribute.
+   * on a single fixed-sized attribute. Tile-aligned portions of the input
+   * are compressed and written directly from the user buffer (see
+   * `dispatch_tile_write_direct`), without staging them in the attribute
+   * fill tile; only partial tiles pay the staging copy.
    *
    * @param attribute_id The id of the attribute this operation focuses on.
    * @param buffer The buffer to write.
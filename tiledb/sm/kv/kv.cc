@@ -33,7 +33,9 @@
 #include "tiledb/sm/kv/kv.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace tiledb {
 namespace sm {
@@ -56,6 +58,8 @@ KV::KV(StorageManager* storage_manager)
   read_buffers_ = nullptr;
   read_buffer_sizes_ = nullptr;
   read_buffer_num_ = 0;
+  bulk_item_num_ = 0;
+  hash_fn_ = KVHash::MD5;
 }
 
 KV::~KV() {
@@ -73,6 +77,7 @@ Status KV::init(
     bool include_keys) {
   kv_uri_ = URI(kv_uri);
   RETURN_NOT_OK(storage_manager_->load_array_schema(kv_uri_, &schema_));
+  hash_fn_ = schema_->kv_hash();
 
   if (attributes == nullptr || attribute_num == 0) {  // Load all attributes
     write_good_ = true;
@@ -122,6 +127,8 @@ void KV::clear() {
   kv_uri_ = URI("");
 
   clear_items();
+  clear_item_cache();
+  clear_item_pool();
   clear_query_attributes();
   clear_query_buffers();
 }
@@ -152,8 +159,29 @@ Status KV::add_item(const KVItem* kv_item) {
     return LOG_STATUS(Status::KVError("Cannot add item; Invalid item"));
   }
 
-  auto new_item = new KVItem();
+  auto new_item = new_kv_item();
+  if (new_item == nullptr) {
+    mtx_.unlock();
+    return LOG_STATUS(
+        Status::KVError("Cannot add item; Memory allocation failed"));
+  }
   *new_item = *kv_item;
+
+  // The item hash was computed with MD5 upon setting the key; recompute
+  // it if this store uses a different hash function
+  if (hash_fn_ != KVHash::MD5) {
+    auto item_key = kv_item->key();
+    auto hash = KVItem::compute_hash(
+        item_key->key_, item_key->key_type_, item_key->key_size_, hash_fn_);
+    auto st = new_item->set_key(
+        item_key->key_, item_key->key_type_, item_key->key_size_, hash);
+    if (!st.ok()) {
+      release_kv_item(new_item);
+      mtx_.unlock();
+      return st;
+    }
+  }
+
   items_[new_item->key()->hash_] = new_item;
 
   mtx_.unlock();
@@ -161,20 +189,66 @@ Status KV::add_item(const KVItem* kv_item) {
   return Status::Ok();
 }
 
+Status KV::add_items(
+    uint64_t item_num,
+    const void* keys,
+    const uint64_t* key_offsets,
+    uint64_t keys_size,
+    Datatype key_type,
+    const void** values,
+    const uint64_t* value_sizes,
+    const uint64_t* const* value_offsets) {
+  // Check if we are good for writes
+  if (!write_good_)
+    return LOG_STATUS(
+        Status::KVError("Cannot add items; Key-value store was not opened "
+                        "properly for writes"));
+
+  if (item_num == 0)
+    return Status::Ok();
+
+  if (keys == nullptr || key_offsets == nullptr ||
+      (!attributes_.empty() && (values == nullptr || value_sizes == nullptr)))
+    return LOG_STATUS(
+        Status::KVError("Cannot add items; Invalid input buffers"));
+
+  if (items_.size() + bulk_item_num_ + item_num > max_items_)
+    RETURN_NOT_OK(flush());
+
+  mtx_.lock();
+
+  auto st = write_items_bulk(
+      item_num,
+      keys,
+      key_offsets,
+      keys_size,
+      key_type,
+      values,
+      value_sizes,
+      value_offsets);
+  if (st.ok())
+    bulk_item_num_ += item_num;
+
+  mtx_.unlock();
+
+  return st;
+}
+
 Status KV::get_item(
     const void* key, Datatype key_type, uint64_t key_size, KVItem** kv_item) {
   mtx_.lock();
 
   // Create key-value item
-  *kv_item = new (std::nothrow) KVItem();
+  *kv_item = new_kv_item();
   if (*kv_item == nullptr)
     return LOG_STATUS(
         Status::KVError("Cannot get item; Memory allocation failed"));
 
   // Set key
-  auto st = (*kv_item)->set_key(key, key_type, key_size);
+  auto hash = KVItem::compute_hash(key, key_type, key_size, hash_fn_);
+  auto st = (*kv_item)->set_key(key, key_type, key_size, hash);
   if (!st.ok()) {
-    delete *kv_item;
+    release_kv_item(*kv_item);
     *kv_item = nullptr;
     mtx_.unlock();
     return st;
@@ -188,11 +262,17 @@ Status KV::get_item(
     return Status::Ok();
   }
 
+  // If the item is cached, copy and return
+  if (item_cache_get((*kv_item)->key()->hash_, *kv_item)) {
+    mtx_.unlock();
+    return Status::Ok();
+  }
+
   // Query
   bool found = false;
   st = read_item((*kv_item)->hash(), &found);
   if (!st.ok() || !found) {
-    delete *kv_item;
+    release_kv_item(*kv_item);
     *kv_item = nullptr;
     mtx_.unlock();
     return st;
@@ -209,7 +289,7 @@ Status KV::get_item(
     st = (*kv_item)->set_value(
         attr, value, read_attribute_types_[aid++], value_size);
     if (!st.ok()) {
-      delete *kv_item;
+      release_kv_item(*kv_item);
       *kv_item = nullptr;
       mtx_.unlock();
       return st;
@@ -217,6 +297,9 @@ Status KV::get_item(
     bid += 1 + (int)var;
   }
 
+  // Cache the retrieved item for subsequent gets of the same key
+  item_cache_put(**kv_item);
+
   mtx_.unlock();
 
   return Status::Ok();
@@ -224,16 +307,20 @@ Status KV::get_item(
 
 Status KV::get_item(const KVItem::Hash& hash, KVItem** kv_item) {
   // Create key-value item
-  *kv_item = new (std::nothrow) KVItem();
+  *kv_item = new_kv_item();
   if (*kv_item == nullptr)
     return LOG_STATUS(
         Status::KVError("Cannot get item; Memory allocation failed"));
 
+  // If the item is cached, copy and return
+  if (item_cache_get(hash, *kv_item))
+    return Status::Ok();
+
   // Query
   bool found = false;
   auto st = read_item(hash, &found);
   if (!st.ok() || !found) {
-    delete *kv_item;
+    release_kv_item(*kv_item);
     *kv_item = nullptr;
     return st;
   }
@@ -274,7 +361,7 @@ Status KV::get_item(const KVItem::Hash& hash, KVItem** kv_item) {
     st = (*kv_item)->set_value(
         attr, value, read_attribute_types_[aid++], value_size);
     if (!st.ok()) {
-      delete *kv_item;
+      release_kv_item(*kv_item);
       *kv_item = nullptr;
       return st;
     }
@@ -286,20 +373,125 @@ Status KV::get_item(const KVItem::Hash& hash, KVItem** kv_item) {
   if (key_found && key_type_found) {
     auto st = (*kv_item)->set_key(key, key_type, key_size, hash);
     if (!st.ok()) {
-      delete *kv_item;
+      release_kv_item(*kv_item);
       *kv_item = nullptr;
       return st;
     }
   }
 
+  // Cache the retrieved item for subsequent gets of the same key
+  item_cache_put(**kv_item);
+
   return Status::Ok();
 }
 
+Status KV::get_items(
+    uint64_t item_num,
+    const void** keys,
+    const Datatype* key_types,
+    const uint64_t* key_sizes,
+    KVItem** kv_items) {
+  if (item_num == 0)
+    return Status::Ok();
+  if (keys == nullptr || key_types == nullptr || key_sizes == nullptr ||
+      kv_items == nullptr)
+    return LOG_STATUS(
+        Status::KVError("Cannot get items; Invalid input arguments"));
+
+  mtx_.lock();
+
+  // Create the items and resolve those that are buffered or cached,
+  // collecting the positions of the rest indexed on their hash, so that
+  // duplicate keys in the batch share a single lookup
+  std::map<KVItem::Hash, std::vector<uint64_t>> misses;
+  Status st = Status::Ok();
+  for (uint64_t i = 0; i < item_num; ++i) {
+    kv_items[i] = new_kv_item();
+    if (kv_items[i] == nullptr) {
+      st = LOG_STATUS(
+          Status::KVError("Cannot get items; Memory allocation failed"));
+      break;
+    }
+    auto hash =
+        KVItem::compute_hash(keys[i], key_types[i], key_sizes[i], hash_fn_);
+    st = kv_items[i]->set_key(keys[i], key_types[i], key_sizes[i], hash);
+    if (!st.ok())
+      break;
+
+    // If the item is buffered or cached, copy and continue
+    auto it = items_.find(hash);
+    if (it != items_.end()) {
+      *kv_items[i] = *(it->second);
+      continue;
+    }
+    if (item_cache_get(hash, kv_items[i]))
+      continue;
+
+    misses[hash].push_back(i);
+  }
+
+  // Resolve the misses with a single multi-range read query
+  if (st.ok() && !misses.empty())
+    st = read_items(&misses, kv_items);
+
+  mtx_.unlock();
+
+  // Upon an error, recycle all the created items
+  if (!st.ok()) {
+    for (uint64_t i = 0; i < item_num; ++i) {
+      release_kv_item(kv_items[i]);
+      kv_items[i] = nullptr;
+    }
+  }
+
+  return st;
+}
+
+Status KV::preload_items(uint64_t item_num, const KVItem::Hash* hashes) {
+  if (item_num == 0)
+    return Status::Ok();
+  if (hashes == nullptr)
+    return LOG_STATUS(
+        Status::KVError("Cannot preload items; Invalid input arguments"));
+
+  mtx_.lock();
+
+  // Collect the hashes that are not already cached. Note that the cache
+  // lookup also marks the cached items as most-recently used, keeping
+  // them alive while the batch is consumed.
+  KVItem cached_item;
+  std::map<KVItem::Hash, std::vector<uint64_t>> misses;
+  std::vector<KVItem*> kv_items(item_num, nullptr);
+  Status st = Status::Ok();
+  for (uint64_t i = 0; i < item_num && st.ok(); ++i) {
+    if (item_cache_get(hashes[i], &cached_item))
+      continue;
+    kv_items[i] = new_kv_item();
+    if (kv_items[i] == nullptr)
+      st = LOG_STATUS(
+          Status::KVError("Cannot preload items; Memory allocation failed"));
+    else
+      misses[hashes[i]].push_back(i);
+  }
+
+  // Retrieve and cache the missing items with a single read query
+  if (st.ok() && !misses.empty())
+    st = read_items(&misses, &kv_items[0]);
+
+  mtx_.unlock();
+
+  // The items are only needed in the cache
+  for (auto kv_item : kv_items)
+    release_kv_item(kv_item);
+
+  return st;
+}
+
 Status KV::flush() {
   mtx_.lock();
 
   // No items to flush
-  if (items_.empty()) {
+  if (items_.empty() && bulk_item_num_ == 0) {
     mtx_.unlock();
     return Status::Ok();
   }
@@ -311,8 +503,12 @@ Status KV::flush() {
   }
 
   st = submit_write_query();
-  if (st.ok())
+  if (st.ok()) {
     clear_items();
+    clear_bulk_items();
+    // The flushed writes may overwrite cached values
+    clear_item_cache();
+  }
 
   mtx_.unlock();
   return st;
@@ -320,10 +516,100 @@ Status KV::flush() {
 
 void KV::clear_items() {
   for (auto& i : items_)
-    delete i.second;
+    release_kv_item(i.second);
   items_.clear();
 }
 
+void KV::clear_item_cache() {
+  std::lock_guard<std::mutex> lock(item_cache_mtx_);
+  for (auto& entry : item_cache_)
+    release_kv_item(entry.second);
+  item_cache_.clear();
+  item_cache_map_.clear();
+}
+
+void KV::clear_item_pool() {
+  std::lock_guard<std::mutex> lock(item_pool_mtx_);
+  for (auto& kv_item : item_pool_)
+    delete kv_item;
+  item_pool_.clear();
+}
+
+bool KV::item_cache_get(const KVItem::Hash& hash, KVItem* kv_item) {
+  std::lock_guard<std::mutex> lock(item_cache_mtx_);
+  auto it = item_cache_map_.find(hash);
+  if (it == item_cache_map_.end())
+    return false;
+
+  // Copy the cached item and make it the most recently used
+  *kv_item = *(it->second->second);
+  item_cache_.splice(item_cache_.end(), item_cache_, it->second);
+
+  return true;
+}
+
+void KV::item_cache_put(const KVItem& kv_item) {
+  auto new_item = new_kv_item();
+  if (new_item == nullptr)  // Caching is best-effort
+    return;
+  *new_item = kv_item;
+  auto hash = kv_item.hash();
+
+  std::lock_guard<std::mutex> lock(item_cache_mtx_);
+
+  // If the item is already cached, replace it and make it the most
+  // recently used
+  auto it = item_cache_map_.find(hash);
+  if (it != item_cache_map_.end()) {
+    release_kv_item(it->second->second);
+    it->second->second = new_item;
+    item_cache_.splice(item_cache_.end(), item_cache_, it->second);
+    return;
+  }
+
+  // Evict the least recently used item if the cache is full
+  if (item_cache_.size() >= constants::kv_max_cached_items) {
+    release_kv_item(item_cache_.front().second);
+    item_cache_map_.erase(item_cache_.front().first);
+    item_cache_.pop_front();
+  }
+
+  item_cache_.emplace_back(hash, new_item);
+  item_cache_map_[hash] = std::prev(item_cache_.end());
+}
+
+KVItem* KV::new_kv_item() {
+  {
+    std::lock_guard<std::mutex> lock(item_pool_mtx_);
+    if (!item_pool_.empty()) {
+      auto kv_item = item_pool_.back();
+      item_pool_.pop_back();
+      return kv_item;
+    }
+  }
+  return new (std::nothrow) KVItem();
+}
+
+void KV::release_kv_item(KVItem* kv_item) {
+  if (kv_item == nullptr)
+    return;
+  kv_item->reset();
+  {
+    std::lock_guard<std::mutex> lock(item_pool_mtx_);
+    if (item_pool_.size() < constants::kv_max_pooled_items) {
+      item_pool_.push_back(kv_item);
+      return;
+    }
+  }
+  delete kv_item;
+}
+
+void KV::clear_bulk_items() {
+  for (auto& buff : bulk_buff_vec_)
+    buff->reset_size();
+  bulk_item_num_ = 0;
+}
+
 Status KV::set_max_buffered_items(uint64_t max_items) {
   if (max_items == 0)
     return LOG_STATUS(Status::KVError(
@@ -377,6 +663,61 @@ Status KV::add_value(const KVItem::Value& value, unsigned bid, bool var) {
   return Status::Ok();
 }
 
+Status KV::add_bulk_item(uint64_t idx) {
+  // Aliases
+  auto& buff_coords = *write_buff_vec_[0];
+  auto& buff_key_offsets = *write_buff_vec_[1];
+  auto& buff_keys = *write_buff_vec_[2];
+  auto& buff_key_types = *write_buff_vec_[3];
+
+  // Coordinates (key hash)
+  RETURN_NOT_OK(buff_coords.write(
+      bulk_buff_vec_[0]->data(2 * idx * sizeof(uint64_t)),
+      2 * sizeof(uint64_t)));
+
+  // Key. Note that the staged key offsets are monotonically increasing
+  // across batches, so the key size is the distance to the next offset.
+  auto bulk_key_offsets = (const uint64_t*)bulk_buff_vec_[1]->data();
+  auto key_offset = bulk_key_offsets[idx];
+  auto key_size =
+      ((idx + 1 < bulk_item_num_) ? bulk_key_offsets[idx + 1] :
+                                    bulk_buff_vec_[2]->size()) -
+      key_offset;
+  uint64_t offset = buff_keys.size();
+  RETURN_NOT_OK(buff_key_offsets.write(&offset, sizeof(offset)));
+  RETURN_NOT_OK(buff_keys.write(bulk_buff_vec_[2]->data(key_offset), key_size));
+
+  // Key type
+  RETURN_NOT_OK(buff_key_types.write(bulk_buff_vec_[3]->data(idx), 1));
+
+  // Attribute values
+  unsigned bid = 4;  // Skip the buffers of the first 3 attributes
+  for (unsigned aid = 3; aid < write_attribute_num_; ++aid) {
+    if (write_attribute_var_sizes_[aid]) {
+      auto bulk_offsets = (const uint64_t*)bulk_buff_vec_[bid]->data();
+      auto value_offset = bulk_offsets[idx];
+      auto value_size =
+          ((idx + 1 < bulk_item_num_) ? bulk_offsets[idx + 1] :
+                                        bulk_buff_vec_[bid + 1]->size()) -
+          value_offset;
+      uint64_t var_offset = write_buff_vec_[bid + 1]->size();
+      RETURN_NOT_OK(
+          write_buff_vec_[bid]->write(&var_offset, sizeof(var_offset)));
+      RETURN_NOT_OK(write_buff_vec_[bid + 1]->write(
+          bulk_buff_vec_[bid + 1]->data(value_offset), value_size));
+      bid += 2;
+    } else {
+      auto cell_size = bulk_buff_vec_[bid]->size() / bulk_item_num_;
+      RETURN_NOT_OK(write_buff_vec_[bid]->write(
+          bulk_buff_vec_[bid]->data(idx * cell_size), cell_size));
+      bid++;
+    }
+  }
+  assert(bid == write_buff_vec_.size());
+
+  return Status::Ok();
+}
+
 void KV::clear_query_attributes() {
   // Read attributes
   if (read_attributes_ != nullptr) {
@@ -421,6 +762,11 @@ void KV::clear_write_buff_vec() {
   for (auto& buff : write_buff_vec_)
     delete buff;
   write_buff_vec_.clear();
+
+  for (auto& buff : bulk_buff_vec_)
+    delete buff;
+  bulk_buff_vec_.clear();
+  bulk_item_num_ = 0;
 }
 
 void KV::clear_write_buffers() {
@@ -452,19 +798,60 @@ Status KV::populate_write_buffers() {
     }
   }
 
-  for (const auto& item : items_) {
-    auto key = (item.second)->key();
+  // Sort the items added in bulk on their hash, so that the fragment is
+  // written as a single sorted run
+  std::vector<uint64_t> bulk_order(bulk_item_num_);
+  auto bulk_coords = (bulk_item_num_ > 0) ?
+                         (const uint64_t*)bulk_buff_vec_[0]->data() :
+                         nullptr;
+  if (bulk_item_num_ > 0) {
+    for (uint64_t i = 0; i < bulk_item_num_; ++i)
+      bulk_order[i] = i;
+    std::sort(
+        bulk_order.begin(),
+        bulk_order.end(),
+        [bulk_coords](uint64_t a, uint64_t b) {
+          auto hash_a = KVItem::Hash(bulk_coords[2 * a], bulk_coords[2 * a + 1]);
+          auto hash_b = KVItem::Hash(bulk_coords[2 * b], bulk_coords[2 * b + 1]);
+          return hash_a < hash_b;
+        });
+  }
+
+  // Merge the buffered items (`items_` is sorted on hash) with the sorted
+  // bulk items, emitting the cells in ascending hash order
+  auto it = items_.begin();
+  uint64_t b = 0;
+  while (it != items_.end() || b < bulk_item_num_) {
+    bool pick_bulk;
+    if (it == items_.end()) {
+      pick_bulk = true;
+    } else if (b == bulk_item_num_) {
+      pick_bulk = false;
+    } else {
+      auto idx = bulk_order[b];
+      auto bulk_hash =
+          KVItem::Hash(bulk_coords[2 * idx], bulk_coords[2 * idx + 1]);
+      pick_bulk = bulk_hash < it->first;
+    }
+
+    if (pick_bulk) {
+      RETURN_NOT_OK(add_bulk_item(bulk_order[b++]));
+      continue;
+    }
+
+    auto key = (it->second)->key();
     assert(key != nullptr);
     RETURN_NOT_OK(add_key(*key));
     unsigned bid = 4;  // Skip the buffers of the first 3 attributes
 
     for (unsigned aid = 3; aid < write_attribute_num_; ++aid) {
-      auto value = (item.second)->value(write_attributes_[aid]);
+      auto value = (it->second)->value(write_attributes_[aid]);
       assert(value != nullptr);
       RETURN_NOT_OK(add_value(*value, bid, write_attribute_var_sizes_[aid]));
       bid += (write_attribute_var_sizes_[aid]) ? 2 : 1;
     }
     assert(bid == write_buff_vec_.size());
+    ++it;
   }
 
   return Status::Ok();
@@ -620,6 +1007,175 @@ Status KV::read_item(const KVItem::Hash& hash, bool* found) {
   return Status::Ok();
 }
 
+Status KV::read_items(
+    std::map<KVItem::Hash, std::vector<uint64_t>>* misses, KVItem** kv_items) {
+  RETURN_NOT_OK(prepare_read_buffers());
+
+  // Prepare one point range per distinct missing hash. The map is
+  // ordered on the hash, hence the ranges are sorted on the coordinates.
+  auto range_num = (uint64_t)misses->size();
+  std::vector<uint64_t> subarrays;
+  subarrays.reserve(4 * range_num);
+  for (const auto& miss : *misses) {
+    subarrays.push_back(miss.first.first);
+    subarrays.push_back(miss.first.first);
+    subarrays.push_back(miss.first.second);
+    subarrays.push_back(miss.first.second);
+  }
+
+  // Size the read buffers for the worst case of every key being found
+  // (each range returns at most one cell). The value sizes of the
+  // variable-sized attributes are unknown up front, so they start from
+  // a guess and are grown whenever the query comes back incomplete.
+  unsigned bid = 0;
+  std::vector<unsigned> attr_ids(read_attribute_num_);
+  for (unsigned aid = 0; aid < read_attribute_num_; ++aid) {
+    RETURN_NOT_OK(schema_->attribute_id(read_attributes_[aid], &attr_ids[aid]));
+    if (read_attribute_var_sizes_[aid]) {
+      read_buffer_sizes_[bid++] = range_num * constants::cell_var_offset_size;
+      read_buffer_sizes_[bid++] = range_num * constants::cell_var_offset_size;
+    } else {
+      read_buffer_sizes_[bid++] = range_num * schema_->cell_size(attr_ids[aid]);
+    }
+  }
+  assert(bid == read_buffer_num_);
+  RETURN_NOT_OK(realloc_read_buffers());
+
+  // The coordinates, which hold the key hashes, are read as well, so
+  // that each result cell can be attributed to its input keys. The
+  // coordinates buffer never overflows, as each range returns at most
+  // one cell.
+  std::vector<const char*> attrs;
+  for (unsigned i = 0; i < read_attribute_num_; ++i)
+    attrs.push_back(read_attributes_[i]);
+  attrs.push_back(constants::coords);
+  std::vector<uint64_t> coords(2 * range_num);
+  std::vector<void*> buffers(read_buffer_num_ + 1);
+  std::vector<uint64_t> buffer_sizes(read_buffer_num_ + 1);
+  auto coords_bid = read_buffer_num_;
+
+  // Create and send the query. An incomplete status means some buffer
+  // filled up, in which case the results copied so far are processed,
+  // the full buffers are grown and the query is resumed.
+  auto query = new Query();
+  RETURN_NOT_OK_ELSE(
+      storage_manager_->query_init(query, kv_uri_.c_str(), QueryType::READ),
+      delete query);
+  Status st = query->set_subarrays(&subarrays[0], range_num);
+  while (st.ok()) {
+    for (unsigned i = 0; i < read_buffer_num_; ++i) {
+      buffers[i] = read_buff_vec_[i]->data();
+      buffer_sizes[i] = read_buff_vec_[i]->alloced_size();
+    }
+    buffers[coords_bid] = &coords[0];
+    buffer_sizes[coords_bid] = 2 * range_num * sizeof(uint64_t);
+    st = query->set_buffers(
+        &attrs[0], (unsigned)attrs.size(), &buffers[0], &buffer_sizes[0]);
+    if (!st.ok())
+      break;
+    st = storage_manager_->query_submit(query);
+    if (!st.ok())
+      break;
+
+    // Set the values of the items whose cells were returned in this round
+    auto cell_num = buffer_sizes[coords_bid] / (2 * sizeof(uint64_t));
+    for (uint64_t c = 0; c < cell_num && st.ok(); ++c) {
+      KVItem::Hash hash(coords[2 * c], coords[2 * c + 1]);
+      auto it = misses->find(hash);
+      if (it == misses->end())
+        continue;
+
+      unsigned b = 0;
+      const void* value;
+      const void* key = nullptr;
+      uint64_t value_size;
+      uint64_t key_size = 0;
+      auto key_type = Datatype::CHAR;
+      bool key_found = false;
+      bool key_type_found = false;
+      for (unsigned aid = 0; aid < read_attribute_num_ && st.ok(); ++aid) {
+        if (read_attribute_var_sizes_[aid]) {
+          auto offsets = (const uint64_t*)buffers[b];
+          auto offset_num = buffer_sizes[b] / constants::cell_var_offset_size;
+          auto end =
+              (c + 1 < offset_num) ? offsets[c + 1] : buffer_sizes[b + 1];
+          value = (const char*)buffers[b + 1] + offsets[c];
+          value_size = end - offsets[c];
+          b += 2;
+        } else {
+          value_size = schema_->cell_size(attr_ids[aid]);
+          value = (const char*)buffers[b] + c * value_size;
+          b++;
+        }
+
+        // The special key attributes set the item key instead of a value
+        if (!strcmp(attrs[aid], constants::key_attr_name)) {
+          key = value;
+          key_size = value_size;
+          key_found = true;
+          continue;
+        }
+        if (!strcmp(attrs[aid], constants::key_type_attr_name)) {
+          key_type = static_cast<Datatype>(((const char*)value)[0]);
+          key_type_found = true;
+          continue;
+        }
+
+        for (auto idx : it->second) {
+          st = kv_items[idx]->set_value(
+              attrs[aid], value, read_attribute_types_[aid], value_size);
+          if (!st.ok())
+            break;
+        }
+      }
+
+      // Set the key when the special key attributes are read (hash-based
+      // lookups have no key set on the items up front)
+      if (st.ok() && key_found && key_type_found) {
+        for (auto idx : it->second) {
+          st = kv_items[idx]->set_key(key, key_type, key_size, hash);
+          if (!st.ok())
+            break;
+        }
+      }
+
+      if (st.ok()) {
+        // Cache the retrieved item for subsequent gets of the same key
+        item_cache_put(*kv_items[it->second[0]]);
+        misses->erase(it);
+      }
+    }
+    if (!st.ok() || query->status() != QueryStatus::INCOMPLETE)
+      break;
+
+    // Grow the buffers that filled up, so that the resumed query always
+    // makes progress
+    for (unsigned i = 0; i < read_buffer_num_ && st.ok(); ++i) {
+      if (buffer_sizes[i] == read_buff_vec_[i]->alloced_size()) {
+        st = read_buff_vec_[i]->realloc(2 * read_buff_vec_[i]->alloced_size());
+        read_buffers_[i] = read_buff_vec_[i]->data();
+        read_buffer_sizes_[i] = read_buff_vec_[i]->alloced_size();
+      }
+    }
+  }
+
+  if (st.ok())
+    st = storage_manager_->query_finalize(query);
+  delete query;
+  RETURN_NOT_OK(st);
+
+  // The hashes that remain unresolved do not exist in the store
+  for (const auto& miss : *misses) {
+    for (auto idx : miss.second) {
+      release_kv_item(kv_items[idx]);
+      kv_items[idx] = nullptr;
+    }
+  }
+  misses->clear();
+
+  return Status::Ok();
+}
+
 Status KV::realloc_read_buffers() {
   for (unsigned i = 0; i < read_buffer_num_; ++i) {
     if (read_buffer_sizes_[i] > read_buff_vec_[i]->alloced_size()) {
@@ -673,5 +1229,86 @@ Status KV::submit_write_query() {
   return Status::Ok();
 }
 
+Status KV::write_items_bulk(
+    uint64_t item_num,
+    const void* keys,
+    const uint64_t* key_offsets,
+    uint64_t keys_size,
+    Datatype key_type,
+    const void** values,
+    const uint64_t* value_sizes,
+    const uint64_t* const* value_offsets) {
+  // If this is the first time to populate the bulk buffers
+  if (bulk_buff_vec_.empty()) {
+    for (unsigned i = 0; i < write_buffer_num_; ++i) {
+      auto buff = new (std::nothrow) Buffer();
+      if (buff == nullptr)
+        return LOG_STATUS(
+            Status::KVError("Cannot add items; Memory allocation failed"));
+      bulk_buff_vec_.emplace_back(buff);
+    }
+  }
+
+  // Aliases
+  auto& buff_coords = *bulk_buff_vec_[0];
+  auto& buff_key_offsets = *bulk_buff_vec_[1];
+  auto& buff_keys = *bulk_buff_vec_[2];
+  auto& buff_key_types = *bulk_buff_vec_[3];
+
+  // Coordinates (key hashes)
+  for (uint64_t i = 0; i < item_num; ++i) {
+    auto key = (const char*)keys + key_offsets[i];
+    auto key_size =
+        ((i + 1 < item_num) ? key_offsets[i + 1] : keys_size) - key_offsets[i];
+    if (key_size == 0)
+      return LOG_STATUS(
+          Status::KVError("Cannot add items; Key cannot have zero size"));
+    auto hash = KVItem::compute_hash(key, key_type, key_size, hash_fn_);
+    RETURN_NOT_OK(buff_coords.write(&hash.first, sizeof(hash.first)));
+    RETURN_NOT_OK(buff_coords.write(&hash.second, sizeof(hash.second)));
+  }
+
+  // Key offsets, shifted to the end of the keys staged so far
+  uint64_t key_shift = buff_keys.size();
+  for (uint64_t i = 0; i < item_num; ++i) {
+    uint64_t offset = key_shift + key_offsets[i];
+    RETURN_NOT_OK(buff_key_offsets.write(&offset, sizeof(offset)));
+  }
+
+  // Keys, appended with a single copy
+  RETURN_NOT_OK(buff_keys.write(keys, keys_size));
+
+  // Key types
+  auto key_type_c = static_cast<char>(key_type);
+  for (uint64_t i = 0; i < item_num; ++i)
+    RETURN_NOT_OK(buff_key_types.write(&key_type_c, sizeof(key_type_c)));
+
+  // Attribute values, one column at a time
+  unsigned bid = 4;  // Skip the buffers of the first 3 attributes
+  for (unsigned aid = 3; aid < write_attribute_num_; ++aid) {
+    unsigned vid = aid - 3;
+    if (write_attribute_var_sizes_[aid]) {
+      if (value_offsets == nullptr || value_offsets[vid] == nullptr)
+        return LOG_STATUS(
+            Status::KVError("Cannot add items; Missing offsets for "
+                            "variable-sized attribute"));
+      uint64_t shift = bulk_buff_vec_[bid + 1]->size();
+      for (uint64_t i = 0; i < item_num; ++i) {
+        uint64_t offset = shift + value_offsets[vid][i];
+        RETURN_NOT_OK(bulk_buff_vec_[bid]->write(&offset, sizeof(offset)));
+      }
+      RETURN_NOT_OK(
+          bulk_buff_vec_[bid + 1]->write(values[vid], value_sizes[vid]));
+      bid += 2;
+    } else {
+      RETURN_NOT_OK(bulk_buff_vec_[bid]->write(values[vid], value_sizes[vid]));
+      bid++;
+    }
+  }
+  assert(bid == write_buffer_num_);
+
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
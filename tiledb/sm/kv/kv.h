@@ -42,6 +42,7 @@
 #include "tiledb/sm/kv/kv_item.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <list>
 #include <map>
 #include <mutex>
 #include <string>
@@ -77,6 +78,44 @@ class KV {
   /** Adds a key-value item to the store. */
   Status add_item(const KVItem* kv_item);
 
+  /**
+   * Adds multiple key-value items to the store in a single call. The items
+   * are given in columnar form, i.e., one buffer per attribute holding the
+   * values of all items contiguously. The items are serialized directly
+   * into internal write buffers, bypassing the per-item `KVItem` object
+   * construction of `add_item`.
+   *
+   * Note that, unlike `add_item`, items added with this function become
+   * visible to `get_item` only after they are flushed, and the keys within
+   * a batch are not deduplicated against each other or against previously
+   * buffered items.
+   *
+   * @param item_num The number of items to be added.
+   * @param keys Buffer holding the keys of all items contiguously.
+   * @param key_offsets The starting offset of each key in `keys`.
+   * @param keys_size The size (in bytes) of `keys`.
+   * @param key_type The type of the keys (common across the batch).
+   * @param values One buffer per attribute (in the order the attributes
+   *     were specified upon initialization), holding the values of all
+   *     items contiguously. For a fixed-sized attribute, the buffer must
+   *     hold exactly `item_num` cells.
+   * @param value_sizes The size (in bytes) of each buffer in `values`.
+   * @param value_offsets For each variable-sized attribute, the starting
+   *     offset of each item's value in the corresponding `values` buffer.
+   *     The entries for fixed-sized attributes are ignored (may be
+   *     `nullptr`).
+   * @return Status
+   */
+  Status add_items(
+      uint64_t item_num,
+      const void* keys,
+      const uint64_t* key_offsets,
+      uint64_t keys_size,
+      Datatype key_type,
+      const void** values,
+      const uint64_t* value_sizes,
+      const uint64_t* const* value_offsets);
+
   /** Flushes the buffered written items to persistent storage. */
   Status flush();
 
@@ -103,6 +142,41 @@ class KV {
    */
   Status get_item(const KVItem::Hash& hash, KVItem** kv_item);
 
+  /**
+   * Gets a batch of key-value items from the key-value store. Keys that
+   * are neither buffered nor cached are resolved with a single
+   * multi-range read query (one point range per distinct key hash),
+   * which fetches each overlapping tile once even if multiple keys hash
+   * into it, instead of running one read query per key.
+   *
+   * @param item_num The number of items to get.
+   * @param keys The keys to query on, one per item.
+   * @param key_types The types of the keys.
+   * @param key_sizes The sizes (in bytes) of the keys.
+   * @param kv_items The key-value item results, one per key. The entry
+   *     for a key that does not exist in the store is set to `nullptr`.
+   * @return Status
+   */
+  Status get_items(
+      uint64_t item_num,
+      const void** keys,
+      const Datatype* key_types,
+      const uint64_t* key_sizes,
+      KVItem** kv_items);
+
+  /**
+   * Warms the item cache with the items that correspond to the input
+   * hashes. The items that are not already cached are retrieved with a
+   * single multi-range read query. This is used by the key-value store
+   * iterator to fetch the items of a batch of hashes in one read,
+   * instead of one read query per item.
+   *
+   * @param item_num The number of hashes.
+   * @param hashes The hashes of the items to preload.
+   * @return Status
+   */
+  Status preload_items(uint64_t item_num, const KVItem::Hash* hashes);
+
   /**
    * Initializes the key-value store for reading/writing.
    *
@@ -228,6 +302,47 @@ class KV {
   /** Items to be written to disk indexed on their hash. */
   std::map<KVItem::Hash, KVItem*> items_;
 
+  /**
+   * Read-through cache of recently retrieved items. The list holds the
+   * cached items in LRU order (the least recently used item at the
+   * front) and is bounded by `constants::kv_max_cached_items`; the map
+   * indexes the list on the item hash. The cache is invalidated upon
+   * `flush`, as the flushed writes may overwrite cached values.
+   */
+  std::list<std::pair<KVItem::Hash, KVItem*>> item_cache_;
+
+  /** Indexes `item_cache_` on the item hash. */
+  std::map<KVItem::Hash, std::list<std::pair<KVItem::Hash, KVItem*>>::iterator>
+      item_cache_map_;
+
+  /** Mutex protecting the item cache. */
+  std::mutex item_cache_mtx_;
+
+  /**
+   * Pool of recycled `KVItem` objects, bounded by
+   * `constants::kv_max_pooled_items`. The pooled items retain their
+   * internal key and value buffers, so that the per-item heap
+   * allocations of `add_item`/`get_item` are amortized across uses.
+   */
+  std::vector<KVItem*> item_pool_;
+
+  /** Mutex protecting the item pool. */
+  std::mutex item_pool_mtx_;
+
+  /**
+   * Buffers holding the items added in bulk with `add_items`, serialized
+   * in columnar form. There is a one-to-one correspondence with
+   * `write_buff_vec_`; the contents are merged (sorted on hash) into the
+   * write buffers upon flushing.
+   */
+  std::vector<Buffer*> bulk_buff_vec_;
+
+  /** The number of items buffered in `bulk_buff_vec_`. */
+  uint64_t bulk_item_num_;
+
+  /** The hash function used to map keys to coordinates. */
+  KVHash hash_fn_;
+
   /** The key-value URI.*/
   URI kv_uri_;
 
@@ -260,9 +375,55 @@ class KV {
    */
   Status add_value(const KVItem::Value& value, unsigned bid, bool var);
 
+  /**
+   * Serializes the bulk item with the input staged index into the write
+   * buffers.
+   */
+  Status add_bulk_item(uint64_t idx);
+
   /** Frees memory of items. */
   void clear_items();
 
+  /** Frees memory of the cached items and empties the item cache. */
+  void clear_item_cache();
+
+  /** Frees memory of the recycled items and empties the item pool. */
+  void clear_item_pool();
+
+  /**
+   * Searches the item cache for the input hash. Upon a hit, the cached
+   * item is copied into `kv_item` and becomes the most recently used.
+   *
+   * @param hash The hash of the item to search for.
+   * @param kv_item The item to copy the cached item into.
+   * @return `true` upon a cache hit and `false` otherwise.
+   */
+  bool item_cache_get(const KVItem::Hash& hash, KVItem* kv_item);
+
+  /**
+   * Caches a copy of the input item as the most recently used, evicting
+   * the least recently used item if the cache is full.
+   */
+  void item_cache_put(const KVItem& kv_item);
+
+  /**
+   * Returns a `KVItem` from the recycling pool, or a newly allocated one
+   * if the pool is empty (`nullptr` upon an allocation failure). Note
+   * that the items returned to the user through `get_item`/`get_items`
+   * are also drawn from the pool, but are deleted by the user and thus
+   * never recycled.
+   */
+  KVItem* new_kv_item();
+
+  /**
+   * Resets the input item and returns it to the recycling pool, or
+   * deletes it if the pool is full. A `nullptr` input is ignored.
+   */
+  void release_kv_item(KVItem* kv_item);
+
+  /** Resets the bulk buffers. */
+  void clear_bulk_items();
+
   /** It deletes the attributes passed in the read/write queries. */
   void clear_query_attributes();
 
@@ -312,6 +473,25 @@ class KV {
    */
   Status read_item(const KVItem::Hash& hash, bool* found);
 
+  /**
+   * Reads a batch of key-value items from persistent storage with a
+   * single multi-range read query and sets the values of the
+   * corresponding items in `kv_items`. If the special key attributes
+   * are read (i.e., the store was initialized with `include_keys` set
+   * to `true`), the item keys are set as well. The caller must hold
+   * `mtx_`.
+   *
+   * @param misses Maps each missing hash to the positions in `kv_items`
+   *     of the items with that key hash. Resolved hashes are erased;
+   *     the items of the hashes that remain upon return were not found
+   *     and are deleted and set to `nullptr` in `kv_items`.
+   * @param kv_items The key-value item results (see `get_items`).
+   * @return Status
+   */
+  Status read_items(
+      std::map<KVItem::Hash, std::vector<uint64_t>>* misses,
+      KVItem** kv_items);
+
   /**
    * Reallocate memory for read buffers that results in an incomplete
    * read query.
@@ -323,6 +503,21 @@ class KV {
 
   /** Submits a write query. */
   Status submit_write_query();
+
+  /**
+   * Serializes the input items into the bulk buffers, one column at a
+   * time. The caller must hold `mtx_`. See `add_items` for the input
+   * format.
+   */
+  Status write_items_bulk(
+      uint64_t item_num,
+      const void* keys,
+      const uint64_t* key_offsets,
+      uint64_t keys_size,
+      Datatype key_type,
+      const void** values,
+      const uint64_t* value_sizes,
+      const uint64_t* const* value_offsets);
 };
 
 }  // namespace sm
@@ -32,6 +32,7 @@
 
 #include "tiledb/sm/kv/kv_item.h"
 #include "md5/md5.h"
+#include "murmur3/murmur3.h"
 #include "tiledb/sm/misc/logger.h"
 
 #include <iostream>
@@ -45,6 +46,8 @@ namespace sm {
 
 KVItem::KVItem() {
   key_.key_ = nullptr;
+  key_.key_size_ = 0;
+  key_alloced_size_ = 0;
 }
 
 KVItem::~KVItem() {
@@ -56,7 +59,7 @@ KVItem::~KVItem() {
 /* ********************************* */
 
 KVItem& KVItem::operator=(const KVItem& kv_item) {
-  clear();
+  reset();
   copy_key(kv_item.key_);
   for (const auto& v : kv_item.values_)
     copy_value(*(v.second));
@@ -74,6 +77,8 @@ void KVItem::clear() {
     std::free(key_.key_);
     key_.key_ = nullptr;
   }
+  key_.key_size_ = 0;
+  key_alloced_size_ = 0;
 
   for (auto& v : values_) {
     if ((v.second)->value_ != nullptr)
@@ -81,6 +86,20 @@ void KVItem::clear() {
     delete v.second;
   }
   values_.clear();
+
+  for (auto& v : value_pool_) {
+    if (v->value_ != nullptr)
+      std::free(v->value_);
+    delete v;
+  }
+  value_pool_.clear();
+}
+
+void KVItem::reset() {
+  key_.key_size_ = 0;
+  for (auto& v : values_)
+    value_pool_.push_back(v.second);
+  values_.clear();
 }
 
 bool KVItem::good(
@@ -88,7 +107,7 @@ bool KVItem::good(
     const std::vector<Datatype>& types) const {
   assert(attributes.size() == types.size());
 
-  if (key_.key_ == nullptr)
+  if (key_.key_ == nullptr || key_.key_size_ == 0)
     return false;
 
   if (values_.size() != attributes.size())
@@ -135,12 +154,19 @@ Status KVItem::set_key(
     return LOG_STATUS(
         Status::KVItemError("Cannot add key; Key cannot be empty"));
 
-  if (key_.key_ != nullptr)
-    std::free(key_.key_);
-  key_.key_ = std::malloc(key_size);
-  if (key_.key_ == nullptr)
-    return LOG_STATUS(
-        Status::KVItemError("Cannot set key; Failed to allocate memory"));
+  // Reuse the key buffer of a recycled item if it is large enough
+  if (key_alloced_size_ < key_size) {
+    if (key_.key_ != nullptr)
+      std::free(key_.key_);
+    key_.key_ = std::malloc(key_size);
+    if (key_.key_ == nullptr) {
+      key_alloced_size_ = 0;
+      key_.key_size_ = 0;
+      return LOG_STATUS(
+          Status::KVItemError("Cannot set key; Failed to allocate memory"));
+    }
+    key_alloced_size_ = key_size;
+  }
   std::memcpy(key_.key_, key, key_size);
   key_.key_type_ = key_type;
   key_.key_size_ = key_size;
@@ -166,28 +192,41 @@ Status KVItem::set_value(
     return LOG_STATUS(Status::KVItemError(
         "Cannot add value; Value size is not a multiple of the datatype size"));
 
-  // Delete previous value buffer
+  // Reuse the previous value object for this attribute, or recycle one
+  // whose buffer was retained by `reset`
+  Value* value_obj;
   auto it = values_.find(attribute);
   if (it != values_.end()) {
-    if (it->second->value_ != nullptr)
-      std::free(it->second->value_);
-    delete it->second;
-    values_.erase(it);
+    value_obj = it->second;
+  } else {
+    if (!value_pool_.empty()) {
+      value_obj = value_pool_.back();
+      value_pool_.pop_back();
+    } else {
+      value_obj = new Value();
+      value_obj->value_ = nullptr;
+      value_obj->value_alloced_size_ = 0;
+    }
+    value_obj->attribute_ = attribute;
+    values_[attribute] = value_obj;
   }
 
-  // Set new value
-  auto value_obj = new Value();
-  value_obj->attribute_ = attribute;
-  value_obj->value_ = std::malloc(value_size);
-  if (value_obj->value_ == nullptr) {
-    delete value_obj;
-    return LOG_STATUS(
-        Status::KVItemError("Cannot set value; Failed to allocate memory"));
+  // Set new value, reusing the existing buffer if it is large enough
+  if (value_obj->value_alloced_size_ < value_size) {
+    if (value_obj->value_ != nullptr)
+      std::free(value_obj->value_);
+    value_obj->value_ = std::malloc(value_size);
+    if (value_obj->value_ == nullptr) {
+      value_obj->value_alloced_size_ = 0;
+      value_obj->value_size_ = 0;
+      return LOG_STATUS(
+          Status::KVItemError("Cannot set value; Failed to allocate memory"));
+    }
+    value_obj->value_alloced_size_ = value_size;
   }
   std::memcpy(value_obj->value_, value, value_size);
   value_obj->value_size_ = value_size;
   value_obj->value_type_ = value_type;
-  values_[attribute] = value_obj;
 
   return Status::Ok();
 }
@@ -198,11 +237,28 @@ Status KVItem::set_value(
 
 KVItem::Hash KVItem::compute_hash(
     const void* key, Datatype key_type, uint64_t key_size) {
+  return compute_hash(key, key_type, key_size, KVHash::MD5);
+}
+
+KVItem::Hash KVItem::compute_hash(
+    const void* key, Datatype key_type, uint64_t key_size, KVHash hash_fn) {
   // Case of empty key
   if (key == nullptr)
     return Hash();
 
   Hash hash;
+
+  if (hash_fn == KVHash::MURMUR3) {
+    // Fold the key type and size into the seed, so that the key bytes can
+    // be hashed in place without assembling a separate input buffer
+    auto seed = (uint32_t)(key_size * 31 + (uint64_t)key_type);
+    uint64_t digest[2];
+    murmur3::MurmurHash3_x64_128(key, (int)key_size, seed, digest);
+    hash.first = digest[0];
+    hash.second = digest[1];
+    return hash;
+  }
+
   md5::MD5_CTX md5_ctx;
   uint64_t coord_size = sizeof(md5_ctx.digest) / 2;
   assert(coord_size == sizeof(uint64_t));
@@ -229,29 +285,43 @@ void KVItem::copy_hash(const Hash& hash) {
 
 void KVItem::copy_key(const Key& key) {
   if (key.key_ != nullptr && key.key_size_ != 0) {
-    key_.key_ = std::malloc(key.key_size_);
+    // Reuse the key buffer of a recycled item if it is large enough
+    if (key_alloced_size_ < key.key_size_) {
+      if (key_.key_ != nullptr)
+        std::free(key_.key_);
+      key_.key_ = std::malloc(key.key_size_);
+      key_alloced_size_ = (key_.key_ == nullptr) ? 0 : key.key_size_;
+    }
     if (key_.key_ != nullptr)
       std::memcpy(key_.key_, key.key_, key.key_size_);
-    else
-      key_.key_ = nullptr;
-  } else {
-    key_.key_ = nullptr;
   }
-  key_.key_size_ = key.key_size_;
+  key_.key_size_ = (key_.key_ == nullptr) ? 0 : key.key_size_;
   key_.key_type_ = key.key_type_;
 }
 
 void KVItem::copy_value(const Value& value) {
-  auto new_value = new Value();
+  // Recycle a value object whose buffer was retained by `reset`
+  Value* new_value;
+  if (!value_pool_.empty()) {
+    new_value = value_pool_.back();
+    value_pool_.pop_back();
+  } else {
+    new_value = new Value();
+    new_value->value_ = nullptr;
+    new_value->value_alloced_size_ = 0;
+  }
   new_value->attribute_ = value.attribute_;
   if (value.value_ != nullptr && value.value_size_ != 0) {
-    new_value->value_ = std::malloc(value.value_size_);
+    // Reuse the existing buffer if it is large enough
+    if (new_value->value_alloced_size_ < value.value_size_) {
+      if (new_value->value_ != nullptr)
+        std::free(new_value->value_);
+      new_value->value_ = std::malloc(value.value_size_);
+      new_value->value_alloced_size_ =
+          (new_value->value_ == nullptr) ? 0 : value.value_size_;
+    }
     if (new_value->value_ != nullptr)
       std::memcpy(new_value->value_, value.value_, value.value_size_);
-    else
-      new_value->value_ = nullptr;
-  } else {
-    new_value->value_ = nullptr;
   }
   new_value->value_size_ = value.value_size_;
   new_value->value_type_ = value.value_type_;
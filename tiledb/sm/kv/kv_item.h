@@ -34,6 +34,7 @@
 #define TILEDB_KV_ITEM_H
 
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/kv_hash.h"
 #include "tiledb/sm/misc/status.h"
 
 #include <map>
@@ -67,6 +68,9 @@ class KVItem {
     void* value_;
     Datatype value_type_;
     uint64_t value_size_;
+    /** The allocated size of `value_`, which may exceed `value_size_`
+     * when the buffer is reused across values. */
+    uint64_t value_alloced_size_;
   };
 
   /* ********************************* */
@@ -93,6 +97,13 @@ class KVItem {
   /** Clears the members of this item. */
   void clear();
 
+  /**
+   * Logically empties the item, like `clear`, but retains the allocated
+   * key and value buffers so that they can be reused when the item is
+   * recycled for another key.
+   */
+  void reset();
+
   /**
    * Checks the goodness of the key-value item. Specifically, it checks
    * whether the set of attributes stored in the item is equivalent to
@@ -159,11 +170,18 @@ class KVItem {
 
   /**
    * Computes and returns a hash on a key, key type and key size tuple as a
-   * pair of `uint64_t` values.
+   * pair of `uint64_t` values, using the MD5 hash function.
    */
   static Hash compute_hash(
       const void* key, Datatype key_type, uint64_t key_size);
 
+  /**
+   * Computes and returns a hash on a key, key type and key size tuple as a
+   * pair of `uint64_t` values, using the input hash function.
+   */
+  static Hash compute_hash(
+      const void* key, Datatype key_type, uint64_t key_size, KVHash hash_fn);
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -172,9 +190,16 @@ class KVItem {
   /** The key. */
   Key key_;
 
+  /** The allocated size of `key_.key_`, which may exceed the key size
+   * when the buffer is reused across keys. */
+  uint64_t key_alloced_size_;
+
   /** Map of values: (attrbute name) -> (value). */
   std::unordered_map<std::string, Value*> values_;
 
+  /** Value objects retained by `reset`, recycled by `set_value`. */
+  std::vector<Value*> value_pool_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
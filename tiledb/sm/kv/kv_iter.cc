@@ -33,6 +33,9 @@
 #include "tiledb/sm/kv/kv_iter.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <algorithm>
+#include <chrono>
+
 namespace tiledb {
 namespace sm {
 
@@ -48,8 +51,11 @@ KVIter::KVIter(StorageManager* storage_manager)
   current_item_ = 0;
   kv_ = nullptr;
   status_ = QueryStatus::COMPLETED;
+  next_status_ = QueryStatus::COMPLETED;
   item_num_ = 0;
   max_item_num_ = constants::kv_max_items;
+  prefetch_pending_ = false;
+  batch_item_num_ = constants::kv_iter_min_batch_items;
 }
 
 KVIter::~KVIter() {
@@ -68,11 +74,10 @@ Status KVIter::here(KVItem** kv_item) const {
   if (done())
     return Status::Ok();
 
-  KVItem::Hash hash;
-  hash.first = read_buffers_[0][2 * current_item_];
-  hash.second = read_buffers_[0][2 * current_item_ + 1];
-
-  return kv_->get_item(hash, kv_item);
+  // The item has typically been preloaded into the item cache of `kv_`
+  // together with the rest of its batch, so this does not issue a
+  // separate read query.
+  return kv_->get_item(hashes_[current_item_], kv_item);
 }
 
 Status KVIter::init(
@@ -86,12 +91,17 @@ Status KVIter::init(
         "Cannot initialize key-value iterator; Memory allocation failed"));
   RETURN_NOT_OK(kv_->init(kv_uri, attributes, attribute_num, true));
   RETURN_NOT_OK(init_read_query());
-  RETURN_NOT_OK(submit_read_query());
+
+  // Fetch the first batch synchronously and start prefetching the next
+  RETURN_NOT_OK(fetch_batch());
+  promote_batch();
+  launch_prefetch();
 
   return Status::Ok();
 }
 
 Status KVIter::finalize() {
+  wait_prefetch();
   auto st = finalize_read_query();
   clear();
 
@@ -101,8 +111,29 @@ Status KVIter::finalize() {
 Status KVIter::next() {
   current_item_++;
 
-  if (current_item_ == item_num_ && status_ == QueryStatus::INCOMPLETE)
-    return submit_read_query();
+  if (current_item_ != item_num_ || status_ != QueryStatus::INCOMPLETE)
+    return Status::Ok();
+
+  // The current batch is exhausted - switch to the prefetched one. If
+  // the application got here before the prefetch completed, it consumes
+  // items faster than they are read, so the batch size is doubled.
+  if (prefetch_pending_) {
+    bool waited = prefetch_task_.wait_for(std::chrono::seconds(0)) !=
+                  std::future_status::ready;
+    auto st = prefetch_task_.get();
+    prefetch_pending_ = false;
+    RETURN_NOT_OK(st);
+    if (waited) {
+      auto max_batch_item_num =
+          std::min(max_item_num_, constants::kv_max_cached_items / 2);
+      batch_item_num_ = std::min(2 * batch_item_num_, max_batch_item_num);
+    }
+  } else {
+    RETURN_NOT_OK(fetch_batch());
+  }
+
+  promote_batch();
+  launch_prefetch();
 
   return Status::Ok();
 }
@@ -112,6 +143,7 @@ Status KVIter::next() {
 /* ********************************* */
 
 void KVIter::clear() {
+  wait_prefetch();
   delete kv_;
   kv_ = nullptr;
   delete[] read_buffers_[0];
@@ -119,8 +151,12 @@ void KVIter::clear() {
   read_buffer_sizes_[0] = 0;
   current_item_ = 0;
   status_ = QueryStatus::INPROGRESS;
+  next_status_ = QueryStatus::INPROGRESS;
   max_item_num_ = 0;
   item_num_ = 0;
+  hashes_.clear();
+  next_hashes_.clear();
+  batch_item_num_ = 0;
 }
 
 Status KVIter::init_read_query() {
@@ -139,17 +175,51 @@ Status KVIter::init_read_query() {
       attributes, 1, (void**)read_buffers_, read_buffer_sizes_);
 }
 
-Status KVIter::submit_read_query() {
-  // Always reset the size of the read buffer and offset
-  read_buffer_sizes_[0] = 2 * max_item_num_ * sizeof(uint64_t);
+Status KVIter::fetch_batch() {
+  // Submit the read query for the next batch of key hashes
+  read_buffer_sizes_[0] = 2 * batch_item_num_ * sizeof(uint64_t);
+  RETURN_NOT_OK(storage_manager_->query_submit(query_));
+  next_status_ = query_->status();
+
+  // Copy the hashes out of the query buffer, so that the batch after
+  // this one can be prefetched while this one is consumed
+  auto item_num = read_buffer_sizes_[0] / (2 * sizeof(uint64_t));
+  next_hashes_.resize(item_num);
+  for (uint64_t i = 0; i < item_num; ++i) {
+    next_hashes_[i].first = read_buffers_[0][2 * i];
+    next_hashes_[i].second = read_buffers_[0][2 * i + 1];
+  }
+
+  // Warm the item cache of the key-value store with the batch items in
+  // a single read, so that `here` is served from the cache instead of
+  // issuing one read query per item
+  if (item_num == 0)
+    return Status::Ok();
+  return kv_->preload_items(item_num, &next_hashes_[0]);
+}
+
+void KVIter::promote_batch() {
+  hashes_.swap(next_hashes_);
+  status_ = next_status_;
+  item_num_ = hashes_.size();
   current_item_ = 0;
+}
 
-  // Submit query
-  RETURN_NOT_OK(storage_manager_->query_submit(query_));
-  status_ = query_->status();
-  item_num_ = read_buffer_sizes_[0] / (2 * sizeof(uint64_t));
+void KVIter::launch_prefetch() {
+  if (status_ != QueryStatus::INCOMPLETE)
+    return;
 
-  return Status::Ok();
+  prefetch_task_ = storage_manager_->io_thread_pool()->enqueue(
+      [this]() { return fetch_batch(); });
+  prefetch_pending_ = true;
+}
+
+void KVIter::wait_prefetch() {
+  if (!prefetch_pending_)
+    return;
+
+  prefetch_task_.wait();
+  prefetch_pending_ = false;
 }
 
 Status KVIter::finalize_read_query() {
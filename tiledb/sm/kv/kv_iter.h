@@ -37,12 +37,23 @@
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 
+#include <future>
+#include <vector>
+
 namespace tiledb {
 namespace sm {
 
 /**
  * This is a key-value store iterator. It is used for reading
  * the stored key-value items one-by-one.
+ *
+ * The items are fetched in batches. While the application consumes the
+ * current batch, the next batch is prefetched asynchronously; each batch
+ * warms the item cache of the underlying key-value store with a single
+ * multi-range read, so that retrieving the current item does not issue
+ * a separate read query. The batch size starts small and doubles
+ * whenever the application exhausts a batch before its prefetch has
+ * completed, i.e., it adapts to the consumption rate.
  */
 class KVIter {
  public:
@@ -111,15 +122,36 @@ class KVIter {
   /** The read query. */
   Query* query_;
 
-  /** The read query status. */
+  /** The read query status after producing the current batch. */
   QueryStatus status_;
 
   /** Maximum number of items to be read at a time. */
   uint64_t max_item_num_;
 
-  /** Number of items read. */
+  /** Number of items in the current batch. */
   uint64_t item_num_;
 
+  /** The key hashes of the current batch. */
+  std::vector<KVItem::Hash> hashes_;
+
+  /** The key hashes of the prefetched (next) batch. */
+  std::vector<KVItem::Hash> next_hashes_;
+
+  /** The read query status after producing the prefetched batch. */
+  QueryStatus next_status_;
+
+  /** The in-flight prefetch task. Valid only if `prefetch_pending_`. */
+  std::future<Status> prefetch_task_;
+
+  /** `true` if a prefetch task is in flight. */
+  bool prefetch_pending_;
+
+  /**
+   * Number of items requested per batch. Doubles (up to a cap) whenever
+   * the application exhausts a batch before its prefetch has completed.
+   */
+  uint64_t batch_item_num_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -133,8 +165,23 @@ class KVIter {
   /** Finalizes a read query. */
   Status finalize_read_query();
 
-  /** Submits a read query, recording its status. */
-  Status submit_read_query();
+  /**
+   * Fetches the next batch into `next_hashes_`/`next_status_`,
+   * submitting the read query and warming the item cache of the
+   * key-value store with the batch items in a single read. May run on
+   * an I/O thread; the caller must ensure that no other fetch is in
+   * flight.
+   */
+  Status fetch_batch();
+
+  /** Makes the prefetched batch the current one. */
+  void promote_batch();
+
+  /** Enqueues a prefetch of the next batch, if there is one. */
+  void launch_prefetch();
+
+  /** Waits for the in-flight prefetch task, if any, discarding it. */
+  void wait_prefetch();
 };
 
 }  // namespace sm
@@ -0,0 +1,110 @@
+/**
+ * @file   arena.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class Arena.
+ */
+
+#include <cstdlib>
+
+#include "tiledb/sm/misc/arena.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+Arena::Arena(uint64_t block_size) {
+  block_size_ = block_size;
+  offset_ = 0;
+  size_ = 0;
+}
+
+Arena::~Arena() {
+  clear();
+}
+
+/* ********************************* */
+/*               API                 */
+/* ********************************* */
+
+void* Arena::allocate(uint64_t nbytes) {
+  // Round up so that every allocation is suitably aligned
+  nbytes = (nbytes + 15) & ~(uint64_t)15;
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // Oversized allocations get a dedicated block, inserted before the
+  // current block so that the space left in the latter is not wasted.
+  if (nbytes > block_size_) {
+    auto block = (char*)std::malloc(nbytes);
+    if (block == nullptr)
+      return nullptr;
+    size_ += nbytes;
+    if (blocks_.empty()) {
+      blocks_.push_back(block);
+      offset_ = block_size_;  // Mark the (dedicated) last block as full
+      return block;
+    }
+    blocks_.insert(blocks_.end() - 1, block);
+    return block;
+  }
+
+  // Add a new block if the current one cannot fit the allocation
+  if (blocks_.empty() || offset_ + nbytes > block_size_) {
+    auto block = (char*)std::malloc(block_size_);
+    if (block == nullptr)
+      return nullptr;
+    blocks_.push_back(block);
+    size_ += block_size_;
+    offset_ = 0;
+  }
+
+  auto p = blocks_.back() + offset_;
+  offset_ += nbytes;
+  return p;
+}
+
+void Arena::clear() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (auto block : blocks_)
+    std::free(block);
+  blocks_.clear();
+  offset_ = 0;
+  size_ = 0;
+}
+
+uint64_t Arena::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return size_;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,172 @@
+/**
+ * @file   arena.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Arena.
+ */
+
+#ifndef TILEDB_ARENA_H
+#define TILEDB_ARENA_H
+
+#include <cinttypes>
+#include <mutex>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A region (arena) allocator for short-lived small objects. Allocations
+ * are served by bumping a pointer inside large malloc-ed blocks and are
+ * all freed in one shot by `clear` (or upon destruction), which avoids
+ * per-object malloc/free overhead and fragmentation. Allocation is
+ * thread-safe; objects drawn from the arena must not be used after the
+ * arena is cleared or destroyed.
+ */
+class Arena {
+ public:
+  /** The default size of the blocks the arena allocates from. */
+  static const uint64_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param block_size The size of the blocks the arena allocates from.
+   */
+  explicit Arena(uint64_t block_size = DEFAULT_BLOCK_SIZE);
+
+  /** Destructor. Frees all the blocks. */
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /* ********************************* */
+  /*               API                 */
+  /* ********************************* */
+
+  /**
+   * Allocates `nbytes` bytes from the arena, suitably aligned for any
+   * object type. Allocations larger than the block size get a dedicated
+   * block. Returns `nullptr` upon a memory allocation error.
+   */
+  void* allocate(uint64_t nbytes);
+
+  /** Frees all the blocks. Invalidates all the served allocations. */
+  void clear();
+
+  /** Returns the total number of bytes the arena has malloc-ed. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The size of the blocks the arena allocates from. */
+  uint64_t block_size_;
+
+  /** The malloc-ed blocks. */
+  std::vector<char*> blocks_;
+
+  /** The offset of the first free byte in the last block. */
+  uint64_t offset_;
+
+  /** The total number of bytes malloc-ed. */
+  uint64_t size_;
+
+  /** A mutex protecting the allocations. */
+  mutable std::mutex mtx_;
+};
+
+/**
+ * An STL-compatible allocator that draws from an `Arena`, for use with
+ * the standard containers and `std::allocate_shared`. Deallocation is a
+ * no-op; the memory is reclaimed when the arena is cleared.
+ *
+ * @tparam T The type of the allocated objects.
+ */
+template <class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  /** Constructor. */
+  explicit ArenaAllocator(Arena* arena)
+      : arena_(arena) {
+  }
+
+  /** Conversion constructor for rebinding to another type. */
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other)
+      : arena_(other.arena()) {
+  }
+
+  /** Allocates space for `n` objects of type `T` from the arena. */
+  T* allocate(std::size_t n) {
+    auto p = arena_->allocate(n * sizeof(T));
+    if (p == nullptr)
+      throw std::bad_alloc();
+    return static_cast<T*>(p);
+  }
+
+  /** No-op; the memory is reclaimed when the arena is cleared. */
+  void deallocate(T* p, std::size_t n) {
+    (void)p;
+    (void)n;
+  }
+
+  /** Returns the arena the allocator draws from. */
+  Arena* arena() const {
+    return arena_;
+  }
+
+ private:
+  /** The arena the allocator draws from. */
+  Arena* arena_;
+};
+
+/** Two arena allocators are equal if they draw from the same arena. */
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return !(a == b);
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_ARENA_H
@@ -251,8 +251,123 @@ class SmallerRow {
   unsigned int dim_num_;
 };
 
-/** Wrapper of comparison function for sorting coords on row-major order. */
+/**
+ * Wrapper of comparison function for sorting cells on morton (Z-order)
+ * order.
+ */
 template <class T>
+class SmallerMorton {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param buffer The buffer containing the cells to be sorted.
+   * @param dim_num The number of dimensions of the cells.
+   * @param domain The array domain (serialized [low, high] pairs), used
+   *     to normalize the coordinates to non-negative values.
+   */
+  SmallerMorton(const T* buffer, unsigned int dim_num, const T* domain)
+      : buffer_(buffer)
+      , dim_num_(dim_num)
+      , domain_(domain) {
+  }
+
+  /**
+   * Comparison operator. The cells are compared on the dimension that
+   * holds the most significant differing bit of their morton codes,
+   * without materializing the codes.
+   *
+   * @param a The first cell position in the cell buffer.
+   * @param b The second cell position in the cell buffer.
+   */
+  bool operator()(uint64_t a, uint64_t b) {
+    const T* coords_a = &buffer_[a * dim_num_];
+    const T* coords_b = &buffer_[b * dim_num_];
+
+    uint64_t coord_a, coord_b, coords_xor, max_xor = 0;
+    unsigned int msd = 0;
+    for (unsigned int i = 0; i < dim_num_; ++i) {
+      coord_a = (uint64_t)(coords_a[i] - domain_[2 * i]);
+      coord_b = (uint64_t)(coords_b[i] - domain_[2 * i]);
+      coords_xor = coord_a ^ coord_b;
+      if (max_xor < coords_xor && max_xor < (max_xor ^ coords_xor)) {
+        msd = i;
+        max_xor = coords_xor;
+      }
+    }
+
+    if (max_xor == 0)  // Identical coordinates
+      return false;
+
+    coord_a = (uint64_t)(coords_a[msd] - domain_[2 * msd]);
+    coord_b = (uint64_t)(coords_b[msd] - domain_[2 * msd]);
+    return coord_a < coord_b;
+  }
+
+ private:
+  /** Cell buffer. */
+  const T* buffer_;
+  /** Number of dimensions. */
+  unsigned int dim_num_;
+  /** The array domain. */
+  const T* domain_;
+};
+
+/**
+ * Wrapper of comparison function for sorting cells; first by the smallest id,
+ * and then by morton (Z-order) order of coordinates.
+ */
+template <class T>
+class SmallerIdMorton {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param buffer The buffer containing the cells to be sorted.
+   * @param dim_num The number of dimensions of the cells.
+   * @param domain The array domain (serialized [low, high] pairs), used
+   *     to normalize the coordinates to non-negative values.
+   * @param ids The ids of the cells in the buffer.
+   */
+  SmallerIdMorton(
+      const T* buffer,
+      unsigned int dim_num,
+      const T* domain,
+      const std::vector<uint64_t>& ids)
+      : ids_(ids)
+      , smaller_morton_(buffer, dim_num, domain) {
+  }
+
+  /**
+   * Comparison operator.
+   *
+   * @param a The first cell position in the cell buffer.
+   * @param b The second cell position in the cell buffer.
+   */
+  bool operator()(uint64_t a, uint64_t b) {
+    if (ids_[a] < ids_[b])
+      return true;
+
+    if (ids_[a] > ids_[b])
+      return false;
+
+    // a.id_ == b.id_ --> check coordinates
+    return smaller_morton_(a, b);
+  }
+
+ private:
+  /** The cell ids. */
+  const std::vector<uint64_t>& ids_;
+  /** The morton order comparator. */
+  SmallerMorton<T> smaller_morton_;
+};
+
+/**
+ * Wrapper of comparison function for sorting coords on row-major order.
+ * If `DIM` is non-zero, the dimensionality is bound at compile time,
+ * letting the compiler unroll the per-dimension comparison loop.
+ */
+template <class T, unsigned DIM = 0>
 class RowCmp {
  public:
   /**
@@ -274,7 +389,8 @@ class RowCmp {
   bool operator()(
       const std::shared_ptr<Query::OverlappingCoords<T>>& a,
       const std::shared_ptr<Query::OverlappingCoords<T>>& b) {
-    for (unsigned int i = 0; i < dim_num_; ++i) {
+    const unsigned dim_num = (DIM != 0) ? DIM : dim_num_;
+    for (unsigned int i = 0; i < dim_num; ++i) {
       if (a->coords_[i] < b->coords_[i])
         return true;
       if (a->coords_[i] > b->coords_[i])
@@ -290,8 +406,12 @@ class RowCmp {
   unsigned dim_num_;
 };
 
-/** Wrapper of comparison function for sorting coords on col-major order. */
-template <class T>
+/**
+ * Wrapper of comparison function for sorting coords on col-major order.
+ * If `DIM` is non-zero, the dimensionality is bound at compile time,
+ * letting the compiler unroll the per-dimension comparison loop.
+ */
+template <class T, unsigned DIM = 0>
 class ColCmp {
  public:
   /**
@@ -313,7 +433,8 @@ class ColCmp {
   bool operator()(
       const std::shared_ptr<Query::OverlappingCoords<T>>& a,
       const std::shared_ptr<Query::OverlappingCoords<T>>& b) {
-    for (unsigned int i = dim_num_ - 1;; --i) {
+    const unsigned dim_num = (DIM != 0) ? DIM : dim_num_;
+    for (unsigned int i = dim_num - 1;; --i) {
       if (a->coords_[i] < b->coords_[i])
         return true;
       if (a->coords_[i] > b->coords_[i])
@@ -334,18 +455,28 @@ class ColCmp {
 
 /**
  * Wrapper of comparison function for sorting coords on the global order
- * of some domain.
+ * of some domain. The tile and cell order state of the domain is bound
+ * once at construction and the row-/col-major comparisons run inline,
+ * instead of re-entering the generic out-of-line domain comparison
+ * functions (which re-branch on the layout) for every pair of cells.
+ * If `DIM` is non-zero, the dimensionality is additionally bound at
+ * compile time, letting the compiler unroll the per-dimension loops.
  */
-template <class T>
+template <class T, unsigned DIM = 0>
 class GlobalCmp {
  public:
   /**
    * Constructor.
    *
-   * @param dim_num The number of dimensions of the coords.
+   * @param domain The domain defining the global order.
    */
   GlobalCmp(const Domain* domain)
       : domain_(domain) {
+    dim_num_ = domain->dim_num();
+    tile_order_ = domain->tile_order();
+    cell_order_ = domain->cell_order();
+    domain_data_ = static_cast<const T*>(domain->domain());
+    tile_extents_ = static_cast<const T*>(domain->tile_extents());
   }
 
   /**
@@ -358,23 +489,80 @@ class GlobalCmp {
   bool operator()(
       const std::shared_ptr<Query::OverlappingCoords<T>>& a,
       const std::shared_ptr<Query::OverlappingCoords<T>>& b) {
+    const unsigned dim_num = (DIM != 0) ? DIM : dim_num_;
+    auto ca = a->coords_;
+    auto cb = b->coords_;
+
     // Compare tile order first
-    auto tile_cmp = domain_->tile_order_cmp<T>(a->coords_, b->coords_);
+    if (tile_extents_ != nullptr) {
+      if (tile_order_ == Layout::ROW_MAJOR) {
+        for (unsigned i = 0; i < dim_num; ++i) {
+          auto ta = (T)((ca[i] - domain_data_[2 * i]) / tile_extents_[i]);
+          auto tb = (T)((cb[i] - domain_data_[2 * i]) / tile_extents_[i]);
+          if (ta < tb)
+            return true;
+          if (ta > tb)
+            return false;
+          // else ta == tb --> continue
+        }
+      } else {  // COL_MAJOR
+        for (unsigned i = dim_num - 1;; --i) {
+          auto ta = (T)((ca[i] - domain_data_[2 * i]) / tile_extents_[i]);
+          auto tb = (T)((cb[i] - domain_data_[2 * i]) / tile_extents_[i]);
+          if (ta < tb)
+            return true;
+          if (ta > tb)
+            return false;
+          // else ta == tb --> continue
+
+          if (i == 0)
+            break;
+        }
+      }
+    }
 
-    if (tile_cmp == -1)
-      return true;
-    if (tile_cmp == 1)
+    // Compare cell order
+    if (cell_order_ == Layout::ROW_MAJOR) {
+      for (unsigned i = 0; i < dim_num; ++i) {
+        if (ca[i] < cb[i])
+          return true;
+        if (ca[i] > cb[i])
+          return false;
+        // else ca[i] == cb[i] --> continue
+      }
       return false;
-    // else tile_cmp == 0 --> continue
+    }
+    if (cell_order_ == Layout::COL_MAJOR) {
+      for (unsigned i = dim_num - 1;; --i) {
+        if (ca[i] < cb[i])
+          return true;
+        if (ca[i] > cb[i])
+          return false;
+        // else ca[i] == cb[i] --> continue
+
+        if (i == 0)
+          break;
+      }
+      return false;
+    }
 
-    // Compare cell order
-    auto cell_cmp = domain_->cell_order_cmp(a->coords_, b->coords_);
-    return cell_cmp == -1;
+    // Any other cell order (e.g., Morton) delegates to the domain
+    return domain_->cell_order_cmp(ca, cb) == -1;
   }
 
  private:
   /** The domain. */
   const Domain* domain_;
+  /** The number of dimensions (used when `DIM` is 0). */
+  unsigned dim_num_;
+  /** The tile order of the domain. */
+  Layout tile_order_;
+  /** The cell order of the domain. */
+  Layout cell_order_;
+  /** The domain bounds (2 values per dimension). */
+  const T* domain_data_;
+  /** The tile extents (`nullptr` if the domain has none). */
+  const T* tile_extents_;
 };
 
 /** Wrapper of comparison function for sorting dense cell ranges. */
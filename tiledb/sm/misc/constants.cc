@@ -62,6 +62,17 @@ const char* kv_schema_filename = "__kv_schema.tdb";
 /** The fragment metadata file name. */
 const char* fragment_metadata_filename = "__fragment_metadata.tdb";
 
+/** The fragment summary file name. */
+const char* fragment_summary_filename = "__fragment_summary.tdb";
+
+/**
+ * The magic value tagging the flat fragment metadata layout. It follows
+ * the library version in the serialized metadata; the old layout stores
+ * the non-empty domain size (a small value) there instead, so the two
+ * layouts can be told apart.
+ */
+const uint64_t fragment_metadata_flat_magic = 0x314d4654424454ULL;  // "TDBTFM1"
+
 /** The default tile capacity. */
 const uint64_t capacity = 10000;
 
@@ -74,8 +85,13 @@ const Datatype cell_var_offset_type = Datatype::UINT64;
 /** A special value indicating varibale size. */
 const uint64_t var_size = std::numeric_limits<uint64_t>::max();
 
-/** The default compressor for the offsets of variable-sized cells. */
-Compressor cell_var_offsets_compression = Compressor::BLOSC_ZSTD;
+/**
+ * The default compressor for the offsets of variable-sized cells. The
+ * offsets are monotonically increasing, so their double deltas are tiny
+ * (zero for fixed-stride runs) and bit-pack into a fraction of the space
+ * a generic codec achieves, while decoding with branchless shifts.
+ */
+Compressor cell_var_offsets_compression = Compressor::DOUBLE_DELTA;
 
 /** The default compression level for the offsets of variable-sized cells. */
 int cell_var_offsets_compression_level = -1;
@@ -161,6 +177,15 @@ Compressor generic_tile_compressor = Compressor::BLOSC_ZSTD;
 /** Default compression level for a generic tile. */
 int generic_tile_compression_level = -1;
 
+/** Compression level preset favoring speed. */
+const int compression_level_fast = -2;
+
+/** Compression level preset balancing speed and compression ratio. */
+const int compression_level_balanced = -3;
+
+/** Compression level preset favoring compression ratio. */
+const int compression_level_archive = -4;
+
 /** Default cell size for a generic tile. */
 uint64_t generic_tile_cell_size = sizeof(char);
 
@@ -170,18 +195,184 @@ const char* group_filename = "__tiledb_group.tdb";
 /** The initial internal buffer size for the case of sparse arrays. */
 const uint64_t internal_buffer_size = 10000000;
 
-/** The buffer size for each attribute used in consolidation. */
+/** The maximum buffer size for each attribute used in consolidation. */
 const uint64_t consolidation_buffer_size = 50000000;
 
+/** The minimum buffer size for each attribute used in consolidation. */
+const uint64_t consolidation_min_buffer_size = 1000000;
+
+/**
+ * The default number of copied subarrays after which a sparse
+ * consolidation checkpoints its progress. A value of 0 disables
+ * checkpointing.
+ */
+const uint64_t consolidation_checkpoint_freq = 0;
+
+/** The consolidation checkpoint file name. */
+const char* consolidation_checkpoint_filename =
+    "__consolidation_checkpoint.tdb";
+
+/** The maximum number of incremental consolidation steps. */
+const uint64_t consolidation_steps = UINT64_MAX;
+
+/** The minimum number of fragments to merge in a consolidation step. */
+const uint64_t consolidation_step_min_frags = 2;
+
+/** The maximum number of fragments to merge in a consolidation step. */
+const uint64_t consolidation_step_max_frags = UINT64_MAX;
+
+/**
+ * The minimum size ratio between the smallest and largest fragment in
+ * a window, for the window to qualify for a consolidation step.
+ */
+const float consolidation_step_size_ratio = 0.0f;
+
+/** If `true`, the background consolidation scheduler is enabled. */
+const bool consolidation_scheduler_enable = false;
+
+/**
+ * The number of fragments beyond which the consolidation scheduler
+ * consolidates an open array.
+ */
+const uint64_t consolidation_scheduler_frag_threshold = 10;
+
+/** The interval (in ms) between consolidation scheduler scans. */
+const uint64_t consolidation_scheduler_interval_ms = 60000;
+
 /** The maximum number of bytes written in a single I/O. */
 const uint64_t max_write_bytes = std::numeric_limits<int>::max();
 
+/** The default maximum number of parallel compute operations. */
+const uint64_t sm_max_parallel_ops = std::thread::hardware_concurrency();
+
+/** The default number of async query worker threads. */
+const uint64_t sm_async_worker_num = 2;
+
+/**
+ * The default total concurrency budget, i.e. the total number of threads
+ * in the compute and I/O thread pools combined. A value of 0 means no
+ * explicit budget; the pools are sized independently from
+ * `sm_max_parallel_ops` and `vfs_max_parallel_ops`.
+ */
+const uint64_t sm_concurrency_total_budget = 0;
+
+/** The default fraction of the concurrency budget given to I/O threads. */
+const float sm_concurrency_io_ratio = 0.5f;
+
+/**
+ * The default cap on the number of parallel operations a single query
+ * may have in flight. A value of 0 means unbounded.
+ */
+const uint64_t sm_concurrency_per_query_cap = 0;
+
+/**
+ * The default memory budget (in bytes) that the caches and per-query
+ * tile buffers charge against. A value of 0 means unbounded.
+ */
+const uint64_t sm_memory_budget = 0;
+
+/**
+ * The default budget (in bytes) of small unordered writes buffered in
+ * memory before they are flushed as a single merged fragment. A value
+ * of 0 disables write combining.
+ */
+const uint64_t sm_write_combining_budget = 0;
+
+/**
+ * The default timestamp (in ms since the epoch) at which arrays open
+ * for reading; fragments written after it are skipped. A value of 0
+ * means the current time (no fragment is skipped).
+ */
+const uint64_t sm_array_open_timestamp = 0;
+
+/**
+ * The default number of tile body bytes speculatively fetched together
+ * with a generic tile header in a single read. Generic tiles that fit
+ * in the prefix (typically metadata objects) are read in one request
+ * instead of two dependent ones.
+ */
+const uint64_t sm_generic_tile_prefix_size = 65536;
+
+/**
+ * The default budget (in bytes) of tiles a read query materializes at
+ * once. Reads whose overlapping tiles are estimated to exceed the budget
+ * are processed in internal subarray partitions, streaming the result
+ * partition-by-partition. A value of 0 disables partitioning.
+ */
+const uint64_t sm_read_partition_budget = 512 * 1024 * 1024;
+
+/**
+ * The default buffer size (in bytes) above which allocations are
+ * hugepage-aligned and advised to be backed by transparent hugepages.
+ * A value of 0 disables the policy.
+ */
+const uint64_t sm_hugepage_threshold = 0;
+
+/**
+ * The default result size (in bytes) above which the final cell copy
+ * into the user buffers uses non-temporal (streaming) stores. The
+ * destination of that copy is written once and never read back by the
+ * library, so bypassing the cache for large results preserves the
+ * decompression working sets. A value of 0 disables streaming stores.
+ */
+const uint64_t sm_streaming_store_threshold = 4 * 1024 * 1024;
+
+/** The number of shards in the open array registry. */
+const uint64_t open_array_shard_num = 16;
+
 /** The default maximum number of parallel VFS operations. */
 const uint64_t vfs_max_parallel_ops = std::thread::hardware_concurrency();
 
 /** The default minimum number of bytes in a parallel VFS operation. */
 const uint64_t vfs_min_parallel_size = 10 * 1024 * 1024;
 
+/**
+ * The default maximum gap (in bytes) between two regions that get
+ * coalesced into a single read in a batched VFS read.
+ */
+const uint64_t vfs_max_batch_read_gap = 500 * 1024;
+
+/**
+ * The default minimum size (in bytes) of a posix write that is issued
+ * with direct I/O (`O_DIRECT`), bypassing the page cache. Large
+ * sequential fragment writes would otherwise pollute the page cache and
+ * trigger dirty-page stalls for co-located readers. A value of 0
+ * disables direct writes. Smaller writes (e.g., metadata files) remain
+ * buffered.
+ */
+const uint64_t vfs_min_direct_write_size = 4 * 1024 * 1024;
+
+/**
+ * The default size (in bytes) of the write-combining buffer of a file
+ * opened for writing. Metadata-heavy commit paths issue long runs of
+ * tiny writes, each of which is a syscall on posix and a locked append
+ * to the multipart buffer on S3; the buffer coalesces them into a
+ * handful of backend writes. A value of 0 disables write combining.
+ */
+const uint64_t vfs_write_buffer_size = 1024 * 1024;
+
+/**
+ * The maximum size (in bytes) of a write that gets coalesced in the
+ * write-combining buffer; larger writes gain nothing from combining
+ * and are issued directly.
+ */
+const uint64_t vfs_max_combined_write_size = 64 * 1024;
+
+/** The default maximum number of entries in the VFS existence cache. */
+const uint64_t vfs_exists_cache_size = 10000;
+
+/**
+ * The default time-to-live (in milliseconds) of a VFS existence cache
+ * entry. A value of 0 disables the cache.
+ */
+const uint64_t vfs_exists_cache_ttl_ms = 10000;
+
+/**
+ * If `true`, uncompressed tiles of local files are read by
+ * memory-mapping the file region instead of copying through a read.
+ */
+const bool vfs_map_reads = false;
+
 /** The maximum name length. */
 const unsigned uri_max_len = 256;
 
@@ -208,9 +399,30 @@ const uint64_t array_schema_cache_size = 10000000;
 /** The fragment metadata cache size. */
 const uint64_t fragment_metadata_cache_size = 10000000;
 
+/** The R-tree fanout (maximum number of children per tree node). */
+const unsigned rtree_fanout = 10;
+
+/** The number of Bloom filter bits per fragment cell. */
+const unsigned bloom_bits_per_cell = 10;
+
+/** The number of Bloom filter hash probes per lookup. */
+const unsigned bloom_hash_num = 7;
+
 /** The tile cache size. */
 const uint64_t tile_cache_size = 10000000;
 
+/** If `true`, the tile cache stores compressed tile bytes. */
+const bool tile_cache_compressed = false;
+
+/** The disk tile cache directory (empty string disables the cache). */
+const char* disk_cache_dir = "";
+
+/** The disk tile cache size. */
+const uint64_t disk_cache_size = 10737418240;  // 10GB
+
+/** The maximum bytes queued for background disk cache writes. */
+const uint64_t disk_cache_max_queued_bytes = 67108864;  // 64MB
+
 /** String describing GZIP. */
 const char* gzip_str = "GZIP";
 
@@ -319,6 +531,9 @@ const char* global_order_str = "global-order";
 /** The string representation for the unordered layout. */
 const char* unordered_str = "unordered";
 
+/** The string representation for the morton (Z-order) layout. */
+const char* morton_str = "morton";
+
 /** The string representation of null. */
 const char* null_str = "null";
 
@@ -329,6 +544,57 @@ const int version[3] = {
 /** The size of a tile chunk. */
 const uint64_t tile_chunk_size = (uint64_t)std::numeric_limits<int>::max();
 
+/**
+ * The flag set on the stored chunk number of a tile to denote that the
+ * tile chunks carry CRC32C checksums.
+ */
+const uint64_t tile_checksum_flag = (uint64_t)1 << 63;
+
+/**
+ * The flag set on the stored chunk number of a tile to denote that the
+ * tile chunks were byte-shuffled before compression.
+ */
+const uint64_t tile_shuffle_flag = (uint64_t)1 << 62;
+
+/**
+ * The flag set on the stored chunk number of a tile to denote that the
+ * tile data were dictionary-encoded before chunking.
+ */
+const uint64_t tile_dict_flag = (uint64_t)1 << 61;
+
+/** If `true`, per-chunk tile checksums are written by default. */
+const bool sm_enable_checksums = false;
+
+/**
+ * If `true`, the thread pools are NUMA-aware by default: workers are
+ * partitioned into per-node sub-pools pinned to their node's CPUs.
+ */
+const bool sm_numa_aware = false;
+
+/**
+ * If `true`, contexts reference a single process-wide pair of compute
+ * and I/O thread pools instead of creating their own.
+ */
+const bool sm_shared_thread_pools = false;
+
+/**
+ * If `true`, the tile requests reaching the tile cache are monitored
+ * and strided access patterns trigger speculative tile fetches.
+ */
+const bool sm_tile_prefetch = false;
+
+/**
+ * The number of consecutive tile requests that must repeat the same
+ * stride and size before the prefetcher starts predicting.
+ */
+const uint64_t tile_prefetch_confirmations = 2;
+
+/** The maximum number of files tracked by the tile prefetcher. */
+const uint64_t tile_prefetch_max_uris = 64;
+
+/** The maximum number of speculative tile fetches in flight. */
+const uint64_t tile_prefetch_max_inflight = 8;
+
 /** The default attribute name prefix. */
 const char* default_attr_name = "__attr";
 
@@ -370,6 +636,15 @@ const char* key_dim_2 = "__key_dim_2";
 /** Maximum number of items to be buffered before a flush. */
 uint64_t kv_max_items = 1000;
 
+/** Maximum number of recently retrieved items cached in memory. */
+const uint64_t kv_max_cached_items = 1000;
+
+/** Maximum number of recycled key-value items kept for reuse. */
+const uint64_t kv_max_pooled_items = 1000;
+
+/** Initial number of items a KV iterator fetches per batch. */
+const uint64_t kv_iter_min_batch_items = 128;
+
 /** Maximum number of attempts to wait for an S3 response. */
 const unsigned int s3_max_attempts = 1000;
 
@@ -385,6 +660,9 @@ const bool s3_use_virtual_addressing = true;
 /** Connect timeout in milliseconds. */
 const long s3_connect_timeout_ms = 3000;
 
+/** The maximum number of pooled connections to S3. */
+const uint64_t s3_max_connections = 64;
+
 /** Connect max tries. */
 const long s3_connect_max_tries = 5;
 
@@ -400,6 +678,21 @@ const char* s3_scheme = "https";
 /** Size of parts used in the S3 multi-part uploads. */
 const uint64_t s3_multipart_part_size = 5 * 1024 * 1024;
 
+/** The maximum number of parallel S3 multi-part upload operations. */
+const uint64_t s3_max_parallel_ops = std::thread::hardware_concurrency();
+
+/** The maximum number of S3 objects with prefetch state tracked at a time. */
+const uint64_t s3_prefetch_max_objects = 32;
+
+/** Number of consecutive sequential S3 reads that trigger read-ahead. */
+const uint64_t s3_prefetch_sequential_reads = 2;
+
+/** The maximum S3 read-ahead window size, in bytes. */
+const uint64_t s3_prefetch_max_window = 16 * 1024 * 1024;
+
+/** The minimum S3 read size that is split into parallel range GETs. */
+const uint64_t s3_min_parallel_read_size = 16 * 1024 * 1024;
+
 /** S3 region. */
 const char* s3_region = "us-east-1";
 
@@ -415,6 +708,21 @@ const char* hdfs_name_node_uri = "";
 /** HDFS default username. */
 const char* hdfs_username = "";
 
+/** HDFS read buffer size in bytes (`0` means the filesystem default). */
+const uint64_t hdfs_read_buffer_size = 0;
+
+/** HDFS write buffer size in bytes (`0` means the filesystem default). */
+const uint64_t hdfs_write_buffer_size = 0;
+
+/** HDFS block size hint in bytes (`0` means the filesystem default). */
+const uint64_t hdfs_block_size = 0;
+
+/** HDFS client readahead in bytes (`0` means the filesystem default). */
+const uint64_t hdfs_readahead = 0;
+
+/** Maximum number of pooled HDFS read file handles. */
+const uint64_t hdfs_max_open_read_files = 64;
+
 /** Prefix indicating a special name reserved by TileDB. */
 const char* special_name_prefix = "__";
 
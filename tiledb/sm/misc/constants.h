@@ -142,6 +142,12 @@ extern const char* file_suffix;
 /** The fragment metadata file name. */
 extern const char* fragment_metadata_filename;
 
+/** The fragment summary file name. */
+extern const char* fragment_summary_filename;
+
+/** The magic value tagging the flat fragment metadata layout. */
+extern const uint64_t fragment_metadata_flat_magic;
+
 /** Default datatype for a generic tile. */
 extern const Datatype generic_tile_datatype;
 
@@ -151,6 +157,15 @@ extern Compressor generic_tile_compressor;
 /** Default compression level for a generic tile. */
 extern int generic_tile_compression_level;
 
+/** Compression level preset favoring speed. */
+extern const int compression_level_fast;
+
+/** Compression level preset balancing speed and compression ratio. */
+extern const int compression_level_balanced;
+
+/** Compression level preset favoring compression ratio. */
+extern const int compression_level_archive;
+
 /** Default cell size for a generic tile. */
 extern uint64_t generic_tile_cell_size;
 
@@ -160,18 +175,174 @@ extern const char* group_filename;
 /** The initial internal buffer size for the case of sparse arrays. */
 extern const uint64_t internal_buffer_size;
 
-/** The buffer size for each attribute used in consolidation. */
+/** The maximum buffer size for each attribute used in consolidation. */
 extern const uint64_t consolidation_buffer_size;
 
+/** The minimum buffer size for each attribute used in consolidation. */
+extern const uint64_t consolidation_min_buffer_size;
+
+/**
+ * The default number of copied subarrays after which a sparse
+ * consolidation checkpoints its progress. A value of 0 disables
+ * checkpointing.
+ */
+extern const uint64_t consolidation_checkpoint_freq;
+
+/** The consolidation checkpoint file name. */
+extern const char* consolidation_checkpoint_filename;
+
+/** The maximum number of incremental consolidation steps. */
+extern const uint64_t consolidation_steps;
+
+/** The minimum number of fragments to merge in a consolidation step. */
+extern const uint64_t consolidation_step_min_frags;
+
+/** The maximum number of fragments to merge in a consolidation step. */
+extern const uint64_t consolidation_step_max_frags;
+
+/**
+ * The minimum size ratio between the smallest and largest fragment in
+ * a window, for the window to qualify for a consolidation step.
+ */
+extern const float consolidation_step_size_ratio;
+
+/** If `true`, the background consolidation scheduler is enabled. */
+extern const bool consolidation_scheduler_enable;
+
+/**
+ * The number of fragments beyond which the consolidation scheduler
+ * consolidates an open array.
+ */
+extern const uint64_t consolidation_scheduler_frag_threshold;
+
+/** The interval (in ms) between consolidation scheduler scans. */
+extern const uint64_t consolidation_scheduler_interval_ms;
+
 /** The maximum number of bytes written in a single I/O. */
 extern const uint64_t max_write_bytes;
 
+/** The default maximum number of parallel compute operations. */
+extern const uint64_t sm_max_parallel_ops;
+
+/** The default number of async query worker threads. */
+extern const uint64_t sm_async_worker_num;
+
+/**
+ * The default total concurrency budget, i.e. the total number of threads
+ * in the compute and I/O thread pools combined. A value of 0 means no
+ * explicit budget; the pools are sized independently from
+ * `sm_max_parallel_ops` and `vfs_max_parallel_ops`.
+ */
+extern const uint64_t sm_concurrency_total_budget;
+
+/** The default fraction of the concurrency budget given to I/O threads. */
+extern const float sm_concurrency_io_ratio;
+
+/**
+ * The default cap on the number of parallel operations a single query
+ * may have in flight. A value of 0 means unbounded.
+ */
+extern const uint64_t sm_concurrency_per_query_cap;
+
+/**
+ * The default memory budget (in bytes) that the caches and per-query
+ * tile buffers charge against. A value of 0 means unbounded.
+ */
+extern const uint64_t sm_memory_budget;
+
+/**
+ * The default budget (in bytes) of small unordered writes buffered in
+ * memory before they are flushed as a single merged fragment. A value
+ * of 0 disables write combining.
+ */
+extern const uint64_t sm_write_combining_budget;
+
+/**
+ * The default timestamp (in ms since the epoch) at which arrays open
+ * for reading; fragments written after it are skipped. A value of 0
+ * means the current time (no fragment is skipped).
+ */
+extern const uint64_t sm_array_open_timestamp;
+
+/**
+ * The default number of tile body bytes speculatively fetched together
+ * with a generic tile header in a single read. Generic tiles that fit
+ * in the prefix (typically metadata objects) are read in one request
+ * instead of two dependent ones.
+ */
+extern const uint64_t sm_generic_tile_prefix_size;
+
+/**
+ * The default budget (in bytes) of tiles a read query materializes at
+ * once. Reads whose overlapping tiles are estimated to exceed the budget
+ * are processed in internal subarray partitions, streaming the result
+ * partition-by-partition. A value of 0 disables partitioning.
+ */
+extern const uint64_t sm_read_partition_budget;
+
+/**
+ * The default buffer size (in bytes) above which allocations are
+ * hugepage-aligned and advised to be backed by transparent hugepages.
+ * A value of 0 disables the policy.
+ */
+extern const uint64_t sm_hugepage_threshold;
+
+/**
+ * The default result size (in bytes) above which the final cell copy
+ * into the user buffers uses non-temporal (streaming) stores. A value
+ * of 0 disables streaming stores.
+ */
+extern const uint64_t sm_streaming_store_threshold;
+
+/** The number of shards in the open array registry. */
+extern const uint64_t open_array_shard_num;
+
 /** The default maximum number of parallel VFS operations. */
 extern const uint64_t vfs_max_parallel_ops;
 
 /** The default minimum number of bytes in a parallel VFS operation. */
 extern const uint64_t vfs_min_parallel_size;
 
+/**
+ * The default maximum gap (in bytes) between two regions that get
+ * coalesced into a single read in a batched VFS read.
+ */
+extern const uint64_t vfs_max_batch_read_gap;
+
+/**
+ * The default minimum size (in bytes) of a posix write that is issued
+ * with direct I/O, bypassing the page cache. A value of 0 disables
+ * direct writes.
+ */
+extern const uint64_t vfs_min_direct_write_size;
+
+/**
+ * The default size (in bytes) of the write-combining buffer of a file
+ * opened for writing. A value of 0 disables write combining.
+ */
+extern const uint64_t vfs_write_buffer_size;
+
+/**
+ * The maximum size (in bytes) of a write that gets coalesced in the
+ * write-combining buffer; larger writes are issued directly.
+ */
+extern const uint64_t vfs_max_combined_write_size;
+
+/** The default maximum number of entries in the VFS existence cache. */
+extern const uint64_t vfs_exists_cache_size;
+
+/**
+ * The default time-to-live (in milliseconds) of a VFS existence cache
+ * entry. A value of 0 disables the cache.
+ */
+extern const uint64_t vfs_exists_cache_ttl_ms;
+
+/**
+ * If `true`, uncompressed tiles of local files are read by
+ * memory-mapping the file region instead of copying through a read.
+ */
+extern const bool vfs_map_reads;
+
 /** The maximum name length. */
 extern const unsigned uri_max_len;
 
@@ -196,9 +367,30 @@ extern const uint64_t array_schema_cache_size;
 /** The fragment metadata cache size. */
 extern const uint64_t fragment_metadata_cache_size;
 
+/** The R-tree fanout (maximum number of children per tree node). */
+extern const unsigned rtree_fanout;
+
+/** The number of Bloom filter bits per fragment cell. */
+extern const unsigned bloom_bits_per_cell;
+
+/** The number of Bloom filter hash probes per lookup. */
+extern const unsigned bloom_hash_num;
+
 /** The tile cache size. */
 extern const uint64_t tile_cache_size;
 
+/** If `true`, the tile cache stores compressed tile bytes. */
+extern const bool tile_cache_compressed;
+
+/** The disk tile cache directory (empty string disables the cache). */
+extern const char* disk_cache_dir;
+
+/** The disk tile cache size. */
+extern const uint64_t disk_cache_size;
+
+/** The maximum bytes queued for background disk cache writes. */
+extern const uint64_t disk_cache_max_queued_bytes;
+
 /** String describing GZIP. */
 extern const char* gzip_str;
 
@@ -307,6 +499,9 @@ extern const char* global_order_str;
 /** The string representation for the unordered layout. */
 extern const char* unordered_str;
 
+/** The string representation for the morton (Z-order) layout. */
+extern const char* morton_str;
+
 /** The string representation of null. */
 extern const char* null_str;
 
@@ -316,6 +511,57 @@ extern const int version[3];
 /** The size of a tile chunk. */
 extern const uint64_t tile_chunk_size;
 
+/**
+ * The flag set on the stored chunk number of a tile to denote that the
+ * tile chunks carry CRC32C checksums.
+ */
+extern const uint64_t tile_checksum_flag;
+
+/**
+ * The flag set on the stored chunk number of a tile to denote that the
+ * tile chunks were byte-shuffled before compression.
+ */
+extern const uint64_t tile_shuffle_flag;
+
+/**
+ * Flag on the stored tile chunk number denoting that the tile data are
+ * dictionary-encoded.
+ */
+extern const uint64_t tile_dict_flag;
+
+/** If `true`, per-chunk tile checksums are written by default. */
+extern const bool sm_enable_checksums;
+
+/**
+ * If `true`, the thread pools are NUMA-aware by default: workers are
+ * partitioned into per-node sub-pools pinned to their node's CPUs.
+ */
+extern const bool sm_numa_aware;
+
+/**
+ * If `true`, contexts reference a single process-wide pair of compute
+ * and I/O thread pools instead of creating their own.
+ */
+extern const bool sm_shared_thread_pools;
+
+/**
+ * If `true`, the tile requests reaching the tile cache are monitored
+ * and strided access patterns trigger speculative tile fetches.
+ */
+extern const bool sm_tile_prefetch;
+
+/**
+ * The number of consecutive tile requests that must repeat the same
+ * stride and size before the prefetcher starts predicting.
+ */
+extern const uint64_t tile_prefetch_confirmations;
+
+/** The maximum number of files tracked by the tile prefetcher. */
+extern const uint64_t tile_prefetch_max_uris;
+
+/** The maximum number of speculative tile fetches in flight. */
+extern const uint64_t tile_prefetch_max_inflight;
+
 /** The default attribute name prefix. */
 extern const char* default_attr_name;
 
@@ -357,6 +603,15 @@ extern const char* key_dim_2;
 /** Maximum number of items to be buffered before a flush. */
 extern uint64_t kv_max_items;
 
+/** Maximum number of recently retrieved items cached in memory. */
+extern const uint64_t kv_max_cached_items;
+
+/** Maximum number of recycled key-value items kept for reuse. */
+extern const uint64_t kv_max_pooled_items;
+
+/** Initial number of items a KV iterator fetches per batch. */
+extern const uint64_t kv_iter_min_batch_items;
+
 /** Maximum number of attempts to wait for an S3 response. */
 extern const unsigned int s3_max_attempts;
 
@@ -372,6 +627,9 @@ extern const bool s3_use_virtual_addressing;
 /** Connect timeout in milliseconds. */
 extern const long s3_connect_timeout_ms;
 
+/** The maximum number of pooled connections to S3. */
+extern const uint64_t s3_max_connections;
+
 /** Connect max tries. */
 extern const long s3_connect_max_tries;
 
@@ -387,6 +645,21 @@ extern const char* s3_scheme;
 /** Size of parts used in the S3 multi-part uploads. */
 extern const uint64_t s3_multipart_part_size;
 
+/** The maximum number of parallel S3 multi-part upload operations. */
+extern const uint64_t s3_max_parallel_ops;
+
+/** The maximum number of S3 objects with prefetch state tracked at a time. */
+extern const uint64_t s3_prefetch_max_objects;
+
+/** Number of consecutive sequential S3 reads that trigger read-ahead. */
+extern const uint64_t s3_prefetch_sequential_reads;
+
+/** The maximum S3 read-ahead window size, in bytes. */
+extern const uint64_t s3_prefetch_max_window;
+
+/** The minimum S3 read size that is split into parallel range GETs. */
+extern const uint64_t s3_min_parallel_read_size;
+
 /** S3 region. */
 extern const char* s3_region;
 
@@ -402,6 +675,21 @@ extern const char* hdfs_name_node_uri;
 /** HDFS default username. */
 extern const char* hdfs_username;
 
+/** HDFS read buffer size in bytes (`0` means the filesystem default). */
+extern const uint64_t hdfs_read_buffer_size;
+
+/** HDFS write buffer size in bytes (`0` means the filesystem default). */
+extern const uint64_t hdfs_write_buffer_size;
+
+/** HDFS block size hint in bytes (`0` means the filesystem default). */
+extern const uint64_t hdfs_block_size;
+
+/** HDFS client readahead in bytes (`0` means the filesystem default). */
+extern const uint64_t hdfs_readahead;
+
+/** Maximum number of pooled HDFS read file handles. */
+extern const uint64_t hdfs_max_open_read_files;
+
 /** Prefix indicating a special name reserved by TileDB. */
 extern const char* special_name_prefix;
 
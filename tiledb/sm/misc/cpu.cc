@@ -0,0 +1,85 @@
+/**
+ * @file   cpu.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the runtime CPU feature detection facility.
+ */
+
+#include "tiledb/sm/misc/cpu.h"
+
+#if defined(__linux__) && defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+
+namespace cpu {
+
+namespace {
+
+/** Probes the CPU the process runs on. */
+Features detect() {
+  Features features = {};
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  __builtin_cpu_init();
+  features.sse4_2_ = __builtin_cpu_supports("sse4.2");
+  features.avx2_ = __builtin_cpu_supports("avx2");
+  features.avx512bw_ = __builtin_cpu_supports("avx512bw");
+#elif defined(__aarch64__)
+  // NEON is architectural on AArch64
+  features.neon_ = true;
+#if defined(__linux__)
+  features.crc32_ = (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#elif defined(__ARM_FEATURE_CRC32)
+  features.crc32_ = true;
+#endif
+#elif defined(__ARM_NEON)
+  features.neon_ = true;
+#if defined(__ARM_FEATURE_CRC32)
+  features.crc32_ = true;
+#endif
+#endif
+
+  return features;
+}
+
+}  // namespace
+
+const Features& features() {
+  // Thread-safe in C++11; the detection runs exactly once
+  static const Features features = detect();
+  return features;
+}
+
+}  // namespace cpu
+
+}  // namespace sm
+}  // namespace tiledb
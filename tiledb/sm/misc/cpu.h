@@ -0,0 +1,77 @@
+/**
+ * @file   cpu.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the runtime CPU feature detection facility.
+ */
+
+#ifndef TILEDB_CPU_H
+#define TILEDB_CPU_H
+
+namespace tiledb {
+namespace sm {
+
+namespace cpu {
+
+/** The CPU features kernels may dispatch on at runtime. */
+struct Features {
+  /** `true` if the CPU supports SSE4.2 (x86). */
+  bool sse4_2_;
+
+  /** `true` if the CPU supports AVX2 (x86). */
+  bool avx2_;
+
+  /** `true` if the CPU supports AVX-512BW (x86). */
+  bool avx512bw_;
+
+  /** `true` if the CPU supports NEON (ARM). */
+  bool neon_;
+
+  /** `true` if the CPU supports the ARMv8 CRC32 extension. */
+  bool crc32_;
+};
+
+/**
+ * Returns the features of the CPU the process runs on. The features are
+ * detected once, upon the first invocation; `StorageManager::init()`
+ * forces the detection at startup, before any query runs.
+ *
+ * Kernels with multiple implementations (e.g., the CRC32C checksum)
+ * consult the features once to initialize a static function pointer
+ * with the fastest implementation the CPU supports, so the per-call
+ * dispatch cost is a single indirect call and a single binary serves
+ * heterogeneous machines.
+ */
+const Features& features();
+
+}  // namespace cpu
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CPU_H
@@ -0,0 +1,153 @@
+/**
+ * @file   crc32c.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements a CRC32C checksum function.
+ */
+
+#include "tiledb/sm/misc/crc32c.h"
+#include "tiledb/sm/misc/cpu.h"
+
+#include <array>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TILEDB_CRC32C_X86
+#include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define TILEDB_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+
+namespace crc32c {
+
+namespace {
+
+using ChecksumFn = uint32_t (*)(const void* data, uint64_t nbytes);
+
+/** Builds the byte-wise CRC32C lookup table. */
+std::array<uint32_t, 256> build_table() {
+  std::array<uint32_t, 256> table;
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int j = 0; j < 8; ++j)
+      crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+    table[i] = crc;
+  }
+  return table;
+}
+
+/** Software fallback using a lookup table. */
+uint32_t checksum_sw(const void* data, uint64_t nbytes) {
+  static const std::array<uint32_t, 256> table = build_table();
+  auto bytes = static_cast<const unsigned char*>(data);
+  uint32_t crc = 0xFFFFFFFF;
+  for (uint64_t i = 0; i < nbytes; ++i)
+    crc = (crc >> 8) ^ table[(crc ^ bytes[i]) & 0xFF];
+  return crc ^ 0xFFFFFFFF;
+}
+
+#ifdef TILEDB_CRC32C_X86
+
+// Compiled for SSE4.2 irrespective of the baseline target; only invoked
+// after the runtime CPU check
+__attribute__((target("sse4.2"))) uint32_t checksum_hw(
+    const void* data, uint64_t nbytes) {
+  auto bytes = static_cast<const unsigned char*>(data);
+  uint64_t crc = 0xFFFFFFFF;
+
+  // Process one word at a time
+  while (nbytes >= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(uint64_t));
+    crc = _mm_crc32_u64(crc, word);
+    bytes += sizeof(uint64_t);
+    nbytes -= sizeof(uint64_t);
+  }
+
+  // Process the remaining bytes
+  while (nbytes > 0) {
+    crc = _mm_crc32_u8((uint32_t)crc, *bytes++);
+    --nbytes;
+  }
+
+  return (uint32_t)crc ^ 0xFFFFFFFF;
+}
+
+#elif defined(TILEDB_CRC32C_ARM)
+
+uint32_t checksum_hw(const void* data, uint64_t nbytes) {
+  auto bytes = static_cast<const unsigned char*>(data);
+  uint32_t crc = 0xFFFFFFFF;
+
+  // Process one word at a time
+  while (nbytes >= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(uint64_t));
+    crc = __crc32cd(crc, word);
+    bytes += sizeof(uint64_t);
+    nbytes -= sizeof(uint64_t);
+  }
+
+  // Process the remaining bytes
+  while (nbytes > 0) {
+    crc = __crc32cb(crc, *bytes++);
+    --nbytes;
+  }
+
+  return crc ^ 0xFFFFFFFF;
+}
+
+#endif
+
+/** Selects the fastest implementation the CPU supports. */
+ChecksumFn pick_impl() {
+#if defined(TILEDB_CRC32C_X86)
+  if (cpu::features().sse4_2_)
+    return checksum_hw;
+#elif defined(TILEDB_CRC32C_ARM)
+  if (cpu::features().crc32_)
+    return checksum_hw;
+#endif
+  return checksum_sw;
+}
+
+}  // namespace
+
+uint32_t checksum(const void* data, uint64_t nbytes) {
+  static const ChecksumFn impl = pick_impl();
+  return impl(data, nbytes);
+}
+
+}  // namespace crc32c
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,60 @@
+/**
+ * @file   crc32c.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares a CRC32C checksum function.
+ */
+
+#ifndef TILEDB_CRC32C_H
+#define TILEDB_CRC32C_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+
+namespace crc32c {
+
+/**
+ * Computes the CRC32C (Castagnoli) checksum of the input bytes. The
+ * computation uses the dedicated CPU instructions (SSE4.2 `crc32` or the
+ * ARMv8 CRC32 extension) when the CPU the process runs on supports them
+ * (detected once at runtime), and a software lookup table otherwise.
+ *
+ * @param data The input bytes.
+ * @param nbytes The number of input bytes.
+ * @return The checksum.
+ */
+uint32_t checksum(const void* data, uint64_t nbytes);
+
+}  // namespace crc32c
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CRC32C_H
@@ -35,6 +35,12 @@
 namespace tiledb {
 namespace sm {
 
+/**
+ * The size (in messages, must be a power of two) of the ring buffer
+ * between the logging callers and the logger thread.
+ */
+static constexpr size_t async_queue_size = 8192;
+
 /* ********************************* */
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
@@ -42,6 +48,13 @@ namespace sm {
 Logger::Logger() {
   logger_ = spdlog::get("tiledb");
   if (logger_ == nullptr) {
+    // Log asynchronously: callers enqueue the message into a fixed-size
+    // lock-free ring buffer that a dedicated logger thread formats and
+    // writes, so logging never blocks a query thread on I/O. When the
+    // buffer is full the message is dropped rather than stalling the
+    // caller.
+    spdlog::set_async_mode(
+        async_queue_size, spdlog::async_overflow_policy::discard_log_msg);
 #ifdef _WIN32
     logger_ = spdlog::stdout_logger_mt("tiledb");
 #else
@@ -69,15 +69,25 @@ class Logger {
   /**
    * Log a debug statement with no message formatting.
    *
+   * Compiled out entirely unless TILEDB_VERBOSE is defined, so debug
+   * statements on hot paths cost nothing in release builds.
+   *
    * @param msg The string to log.
    */
   void debug(const char* msg) {
+#ifdef TILEDB_VERBOSE
     logger_->debug(msg);
+#else
+    (void)msg;
+#endif
   }
 
   /**
    * A formatted debug statment.
    *
+   * Compiled out entirely unless TILEDB_VERBOSE is defined, so debug
+   * statements on hot paths cost nothing in release builds.
+   *
    * @param fmt A fmtlib format string, see http://fmtlib.net/latest/ for
    *     details.
    * @param arg positional argument to format.
@@ -86,7 +96,11 @@ class Logger {
    */
   template <typename Arg1, typename... Args>
   void debug(const char* fmt, const Arg1& arg1, const Args&... args) {
+#ifdef TILEDB_VERBOSE
     logger_->debug(fmt, arg1, args...);
+#else
+    ignore(fmt, arg1, args...);
+#endif
   }
 
   /**
@@ -151,6 +165,15 @@ class Logger {
 
   /** The logger object. */
   std::shared_ptr<spdlog::logger> logger_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Marks the arguments of an elided log statement as used. */
+  template <typename... Args>
+  void ignore(const Args&...) {
+  }
 };
 
 /* ********************************* */
@@ -171,6 +194,11 @@ inline Status LOG_STATUS(const Status& st) {
   global_logger().error(st.to_string().c_str());
   return st;
 }
+
+/** Logs a debug message. */
+inline void LOG_DEBUG(const std::string& msg) {
+  global_logger().debug(msg.c_str());
+}
 #else
 /** Logs an error. */
 inline void LOG_ERROR(const std::string& msg) {
@@ -182,6 +210,12 @@ inline void LOG_ERROR(const std::string& msg) {
 inline Status LOG_STATUS(const Status& st) {
   return st;
 }
+
+/** Logs a debug message. */
+inline void LOG_DEBUG(const std::string& msg) {
+  (void)msg;
+  return;
+}
 #endif
 
 }  // namespace sm
@@ -0,0 +1,136 @@
+/**
+ * @file   numa.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the NUMA topology detection and thread placement
+ * facility.
+ */
+
+#include "tiledb/sm/misc/numa.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/stat.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+
+namespace numa {
+
+uint64_t node_num() {
+  static const uint64_t node_num = []() {
+#ifdef __linux__
+    uint64_t n = 0;
+    for (;; ++n) {
+      char path[64];
+      snprintf(
+          path,
+          sizeof(path),
+          "/sys/devices/system/node/node%llu",
+          (unsigned long long)n);
+      struct stat st;
+      if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode))
+        break;
+    }
+    return (n > 0) ? n : (uint64_t)1;
+#else
+    return (uint64_t)1;
+#endif
+  }();
+
+  return node_num;
+}
+
+Status pin_to_node(uint64_t node) {
+#ifdef __linux__
+  // Read the node's CPU list, e.g. "0-15,32-47"
+  char path[64];
+  snprintf(
+      path,
+      sizeof(path),
+      "/sys/devices/system/node/node%llu/cpulist",
+      (unsigned long long)node);
+  FILE* f = fopen(path, "r");
+  if (f == nullptr)
+    return LOG_STATUS(Status::UtilsError(
+        "Cannot pin thread to NUMA node " + std::to_string(node) +
+        "; Cannot read the node's CPU list"));
+  char buf[4096];
+  auto read = (fgets(buf, sizeof(buf), f) != nullptr);
+  fclose(f);
+  if (!read)
+    return LOG_STATUS(Status::UtilsError(
+        "Cannot pin thread to NUMA node " + std::to_string(node) +
+        "; Cannot read the node's CPU list"));
+
+  // Build the CPU set from the comma-separated list of CPU ranges
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  bool any = false;
+  char* p = buf;
+  while (*p != '\0' && *p != '\n') {
+    char* end;
+    long first = strtol(p, &end, 10);
+    if (end == p)
+      break;
+    long last = first;
+    p = end;
+    if (*p == '-') {
+      last = strtol(p + 1, &end, 10);
+      p = end;
+    }
+    for (long c = first; c <= last && c < CPU_SETSIZE; ++c) {
+      CPU_SET(c, &cpus);
+      any = true;
+    }
+    if (*p == ',')
+      ++p;
+  }
+
+  if (!any || sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+    return LOG_STATUS(Status::UtilsError(
+        "Cannot pin thread to NUMA node " + std::to_string(node) +
+        "; Cannot set the thread affinity"));
+
+  return Status::Ok();
+#else
+  (void)node;
+  return Status::Ok();
+#endif
+}
+
+}  // namespace numa
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,72 @@
+/**
+ * @file   numa.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the NUMA topology detection and thread placement
+ * facility.
+ */
+
+#ifndef TILEDB_NUMA_H
+#define TILEDB_NUMA_H
+
+#include <cstdint>
+
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+namespace numa {
+
+/**
+ * Returns the number of NUMA nodes of the machine the process runs on.
+ * The topology is detected once, upon the first invocation. Returns 1
+ * on platforms where the topology cannot be determined (including
+ * non-Linux platforms), which disables all NUMA-aware policies.
+ */
+uint64_t node_num();
+
+/**
+ * Pins the calling thread to the CPUs of the input NUMA node. Threads
+ * pinned to a node allocate node-local memory through the default
+ * first-touch placement policy, so a buffer allocated and filled by a
+ * pinned thread is local to that thread's socket.
+ *
+ * A no-op on platforms without thread affinity support.
+ *
+ * @param node The NUMA node to pin the calling thread to.
+ * @return Status
+ */
+Status pin_to_node(uint64_t node);
+
+}  // namespace numa
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_NUMA_H
@@ -0,0 +1,148 @@
+/**
+ * @file   query_stats.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class QueryStats.
+ */
+
+#ifndef TILEDB_QUERY_STATS_H
+#define TILEDB_QUERY_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Statistics gathered during the execution of a single query. Unlike the
+ * process-global counters in `stats::all_stats`, these are owned by a
+ * `Query` object, so the I/O and time of concurrent queries can be
+ * attributed individually. The counters are atomic, as the read path
+ * updates them from the I/O and compute thread pools.
+ *
+ * The phase timers are cumulative across threads, i.e. two tiles
+ * decompressed concurrently for 1ms each contribute 2ms.
+ */
+class QueryStats {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  QueryStats() {
+    reset();
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Resets all counters to zero. */
+  void reset() {
+    bytes_read_ = 0;
+    tiles_fetched_ = 0;
+    cache_hits_ = 0;
+    cache_misses_ = 0;
+    compute_overlap_ns_ = 0;
+    io_ns_ = 0;
+    decompress_ns_ = 0;
+    sort_ns_ = 0;
+    copy_ns_ = 0;
+  }
+
+  /* ********************************* */
+  /*             COUNTERS              */
+  /* ********************************* */
+
+  /** The number of bytes read from storage (compressed size). */
+  std::atomic<uint64_t> bytes_read_;
+
+  /** The number of tiles fetched by the query. */
+  std::atomic<uint64_t> tiles_fetched_;
+
+  /** The number of tiles served from the tile cache. */
+  std::atomic<uint64_t> cache_hits_;
+
+  /** The number of tiles not found in the tile cache. */
+  std::atomic<uint64_t> cache_misses_;
+
+  /** Time spent computing the subarray/tile overlap, in nanoseconds. */
+  std::atomic<uint64_t> compute_overlap_ns_;
+
+  /** Time spent reading tile bytes from storage, in nanoseconds. */
+  std::atomic<uint64_t> io_ns_;
+
+  /** Time spent decompressing tiles, in nanoseconds. */
+  std::atomic<uint64_t> decompress_ns_;
+
+  /** Time spent sorting and deduplicating coordinates, in nanoseconds. */
+  std::atomic<uint64_t> sort_ns_;
+
+  /** Time spent copying cells into the user buffers, in nanoseconds. */
+  std::atomic<uint64_t> copy_ns_;
+};
+
+/**
+ * RAII timer that accumulates the wall-clock time between its construction
+ * and destruction into a `QueryStats` counter. A `nullptr` counter
+ * disables the timer.
+ */
+class QueryStatsTimer {
+ public:
+  /** Constructor. */
+  explicit QueryStatsTimer(std::atomic<uint64_t>* counter)
+      : counter_(counter) {
+    if (counter_ != nullptr)
+      start_ = std::chrono::steady_clock::now();
+  }
+
+  /** Destructor. Accumulates the elapsed time into the counter. */
+  ~QueryStatsTimer() {
+    if (counter_ != nullptr) {
+      auto end = std::chrono::steady_clock::now();
+      *counter_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       end - start_)
+                       .count();
+    }
+  }
+
+ private:
+  /** The counter to accumulate into, or `nullptr` if disabled. */
+  std::atomic<uint64_t>* counter_;
+
+  /** The time of construction. */
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_STATS_H
@@ -0,0 +1,139 @@
+/**
+ * @file   radix_sort.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares a parallel LSD radix sort over (key, value) pairs,
+ * used as a fast alternative to comparator-based sorting when the sort
+ * order can be encoded in fixed-width integer keys.
+ */
+
+#ifndef TILEDB_RADIX_SORT_H
+#define TILEDB_RADIX_SORT_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "tiledb/sm/misc/thread_pool.h"
+
+namespace tiledb {
+namespace sm {
+
+namespace radix_sort {
+
+/**
+ * Sorts the input (key, value) pairs in ascending key order, using a
+ * parallel least-significant-digit radix sort with 8-bit digits. The sort
+ * is stable, i.e., pairs with equal keys retain their relative order.
+ *
+ * @tparam V The value type carried along with each key.
+ * @param pool The thread pool to parallelize over. The histogram and
+ *     scatter phases of each pass are partitioned over the pool threads.
+ * @param pairs The pairs to be sorted in place.
+ */
+template <class V>
+void sort_pairs(ThreadPool* pool, std::vector<std::pair<uint64_t, V>>* pairs) {
+  auto num = pairs->size();
+  if (num < 2)
+    return;
+
+  // Partition the input into one chunk per thread.
+  auto chunk_num = pool->num_threads();
+  if (chunk_num == 0)
+    chunk_num = 1;
+  if (chunk_num > num)
+    chunk_num = num;
+  auto chunk_size = num / chunk_num + uint64_t(bool(num % chunk_num));
+
+  std::vector<std::pair<uint64_t, V>> scratch(num);
+  auto src = pairs;
+  auto dst = &scratch;
+
+  // One pass per 8-bit digit, from least to most significant.
+  for (unsigned pass = 0; pass < sizeof(uint64_t); ++pass) {
+    unsigned shift = pass * 8;
+
+    // Compute per-chunk digit histograms in parallel.
+    std::vector<std::vector<uint64_t>> histograms(
+        chunk_num, std::vector<uint64_t>(256, 0));
+    std::vector<std::future<Status>> tasks;
+    for (uint64_t c = 0; c < chunk_num; ++c) {
+      tasks.push_back(pool->enqueue([src, c, chunk_size, num, shift,
+                                     &histograms]() {
+        auto start = c * chunk_size;
+        auto end = std::min(start + chunk_size, (uint64_t)num);
+        auto& histogram = histograms[c];
+        for (uint64_t i = start; i < end; ++i)
+          ++histogram[((*src)[i].first >> shift) & 0xff];
+        return Status::Ok();
+      }));
+    }
+    pool->wait_all(tasks);
+    tasks.clear();
+
+    // Exclusive scan over (digit, chunk) to get per-chunk scatter offsets.
+    uint64_t offset = 0;
+    std::vector<std::vector<uint64_t>> offsets(
+        chunk_num, std::vector<uint64_t>(256, 0));
+    for (unsigned d = 0; d < 256; ++d) {
+      for (uint64_t c = 0; c < chunk_num; ++c) {
+        offsets[c][d] = offset;
+        offset += histograms[c][d];
+      }
+    }
+
+    // Scatter in parallel; each chunk writes to disjoint positions.
+    for (uint64_t c = 0; c < chunk_num; ++c) {
+      tasks.push_back(
+          pool->enqueue([src, dst, c, chunk_size, num, shift, &offsets]() {
+            auto start = c * chunk_size;
+            auto end = std::min(start + chunk_size, (uint64_t)num);
+            auto& chunk_offsets = offsets[c];
+            for (uint64_t i = start; i < end; ++i)
+              (*dst)[chunk_offsets[((*src)[i].first >> shift) & 0xff]++] =
+                  (*src)[i];
+            return Status::Ok();
+          }));
+    }
+    pool->wait_all(tasks);
+
+    std::swap(src, dst);
+  }
+
+  // An even number of passes leaves the result in the input vector.
+  assert(src == pairs);
+}
+
+}  // namespace radix_sort
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_RADIX_SORT_H
@@ -12,19 +12,30 @@ Statistics::Statistics() {
 }
 
 void Statistics::dump(FILE* out) const {
+  // Aggregate the counter blocks of all threads once, up front.
+  ThreadCounters total = aggregate();
+
   fprintf(
       out,
       "======================= TileDB Statistics Report "
       "=======================\n");
   fprintf(out, "Function statistics:\n");
   fprintf(
-      out, "%-30s%20s%22s\n", "  Function name", "# calls", "Total time (ns)");
+      out,
+      "%-30s%20s%22s%15s%15s%15s\n",
+      "  Function name",
+      "# calls",
+      "Total time (ns)",
+      "p50 (ns)",
+      "p95 (ns)",
+      "p99 (ns)");
   fprintf(
       out,
       "  "
       "----------------------------------------------------------------------"
+      "---------------------------------------------"
       "\n");
-  dump_all_func_stats(out);
+  dump_all_func_stats(out, total);
 
   fprintf(out, "\nCounter statistics:\n");
   fprintf(out, "%-30s%20s\n", "  Counter name", "Value");
@@ -33,7 +44,35 @@ void Statistics::dump(FILE* out) const {
       "  "
       "------------------------------------------------"
       "\n");
-  dump_all_counter_stats(out);
+  dump_all_counter_stats(out, total);
+}
+
+void Statistics::dump_json(std::string* out) const {
+  // Aggregate the counter blocks of all threads once, up front.
+  ThreadCounters total = aggregate();
+
+  std::ostringstream json;
+  json << "{\n  \"functions\": {\n";
+  dump_all_func_stats_json(json, total);
+  json << "\n  },\n  \"counters\": {\n";
+  dump_all_counter_stats_json(json, total);
+  json << "\n  }\n}\n";
+
+  *out = json.str();
+}
+
+bool Statistics::get_counter(const std::string& name, uint64_t* value) const {
+  ThreadCounters total = aggregate();
+
+#define STATS_REPORT_COUNTER_STAT(counter_name) \
+  if (name == #counter_name) {                  \
+    *value = total.counter_##counter_name;      \
+    return true;                                \
+  }
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_COUNTER_STAT
+
+  return false;
 }
 
 bool Statistics::enabled() const {
@@ -44,6 +83,43 @@ void Statistics::set_enabled(bool enabled) {
   enabled_ = enabled;
 }
 
+Statistics::ThreadCounters* Statistics::thread_counters() {
+  // Registers the thread's counter block upon construction (i.e. upon the
+  // thread's first recorded sample) and merges it into the retired
+  // counters when the thread exits.
+  struct ThreadCountersHolder {
+    explicit ThreadCountersHolder(Statistics* stats)
+        : stats_(stats) {
+      std::memset(&counters_, 0, sizeof(ThreadCounters));
+      stats_->register_thread_counters(&counters_);
+    }
+
+    ~ThreadCountersHolder() {
+      stats_->deregister_thread_counters(&counters_);
+    }
+
+    Statistics* stats_;
+    ThreadCounters counters_;
+  };
+
+  static thread_local ThreadCountersHolder holder(this);
+  return &holder.counters_;
+}
+
+void Statistics::register_thread_counters(ThreadCounters* counters) {
+  std::lock_guard<std::mutex> lock(counters_mtx_);
+  thread_counters_.insert(counters);
+}
+
+void Statistics::deregister_thread_counters(ThreadCounters* counters) {
+  std::lock_guard<std::mutex> lock(counters_mtx_);
+  thread_counters_.erase(counters);
+  auto src = (const uint64_t*)counters;
+  auto dst = (uint64_t*)&retired_counters_;
+  for (uint64_t i = 0; i < sizeof(ThreadCounters) / sizeof(uint64_t); ++i)
+    dst[i] += src[i];
+}
+
 }  // namespace stats
 }  // namespace sm
 }  // namespace tiledb
\ No newline at end of file
@@ -34,10 +34,12 @@
 #define TILEDB_STATS_H
 
 #include <inttypes.h>
-#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <sstream>
 
 namespace tiledb {
@@ -49,17 +51,33 @@ namespace stats {
  */
 class Statistics {
  public:
-  /* Define the counters */
-#define STATS_DEFINE_FUNC_STAT(function_name)     \
-  std::atomic<uint64_t> function_name##_total_ns; \
-  std::atomic<uint64_t> function_name##_call_count;
+  /**
+   * The number of log-scale latency histogram buckets per function stat.
+   * Bucket `b` holds the durations whose highest set bit is `b`, i.e.
+   * the durations in `[2^b, 2^(b+1))` nanoseconds.
+   */
+  static const unsigned hist_bucket_num = 64;
+
+  /**
+   * A per-thread block of all statistics counters: per-function call
+   * counts, total times and latency histogram buckets, plus the plain
+   * counter stats. Each thread updates its own (unsynchronized) block on
+   * the hot path, so gathering statistics causes no cache-line contention
+   * between threads; the blocks of all threads are aggregated only when
+   * the statistics are dumped or queried.
+   */
+  struct ThreadCounters {
+#define STATS_DEFINE_FUNC_STAT(function_name) \
+  uint64_t function_name##_total_ns;          \
+  uint64_t function_name##_call_count;        \
+  uint64_t function_name##_hist[hist_bucket_num];
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_DEFINE_FUNC_STAT
 
-#define STATS_DEFINE_COUNTER_STAT(counter_name) \
-  std::atomic<uint64_t> counter_##counter_name;
+#define STATS_DEFINE_COUNTER_STAT(counter_name) uint64_t counter_##counter_name;
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_DEFINE_COUNTER_STAT
+  };
 
   /** Constructor. */
   Statistics();
@@ -69,48 +87,202 @@ class Statistics {
 
   /** Reset all counters to zero. */
   void reset() {
-#define STATS_INIT_FUNC_STAT(function_name) \
-  function_name##_total_ns = 0;             \
-  function_name##_call_count = 0;
-#include "tiledb/sm/misc/stats_counters.h"
-#undef STATS_INIT_FUNC_STAT
+    std::lock_guard<std::mutex> lock(counters_mtx_);
+    for (auto* counters : thread_counters_)
+      std::memset(counters, 0, sizeof(ThreadCounters));
+    std::memset(&retired_counters_, 0, sizeof(ThreadCounters));
+  }
 
-#define STATS_INIT_COUNTER_STAT(counter_name) counter_##counter_name = 0;
-#include "tiledb/sm/misc/stats_counters.h"
-#undef STATS_INIT_COUNTER_STAT
+  /**
+   * Returns the element-wise sum of the counter blocks of all live and
+   * exited threads.
+   */
+  ThreadCounters aggregate() const {
+    ThreadCounters total;
+    std::memset(&total, 0, sizeof(ThreadCounters));
+    auto dst = (uint64_t*)&total;
+    const uint64_t num = sizeof(ThreadCounters) / sizeof(uint64_t);
+
+    std::lock_guard<std::mutex> lock(counters_mtx_);
+    for (const auto* counters : thread_counters_) {
+      auto src = (const uint64_t*)counters;
+      for (uint64_t i = 0; i < num; ++i)
+        dst[i] += src[i];
+    }
+    auto src = (const uint64_t*)&retired_counters_;
+    for (uint64_t i = 0; i < num; ++i)
+      dst[i] += src[i];
+
+    return total;
   }
 
   /** Dump the current counter values to the given file. */
   void dump(FILE* out) const;
 
+  /**
+   * Writes the current counter values to `out` as a JSON document with a
+   * stable schema, suitable for machine consumption. The document has the
+   * form:
+   *
+   *     {"functions": {"<name>": {"call_count": ..., "total_ns": ...,
+   *     "p50_ns": ..., "p95_ns": ..., "p99_ns": ..., "hist": [...]},
+   *     ...}, "counters": {"<name>": ..., ...}}
+   *
+   * where `hist` lists the latency histogram bucket counts (bucket `b`
+   * counts the durations in `[2^b, 2^(b+1))` nanoseconds).
+   */
+  void dump_json(std::string* out) const;
+
+  /**
+   * Sets `*value` to the aggregated value of the counter stat with the
+   * input name (e.g. `"vfs_read_total_bytes"`).
+   *
+   * @param name The counter stat name.
+   * @param value Set to the aggregated counter value.
+   * @return `true` on success, `false` if no such counter exists.
+   */
+  bool get_counter(const std::string& name, uint64_t* value) const;
+
   /** Enable or disable statistics gathering. */
   void set_enabled(bool enabled);
 
+  /** Returns the histogram bucket that covers a duration in nanoseconds. */
+  static unsigned hist_bucket(uint64_t duration_ns) {
+    unsigned bucket = 0;
+    while (duration_ns > 1) {
+      duration_ns >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  /**
+   * Returns the calling thread's counter block, registering the thread
+   * with the statistics instance upon its first call.
+   */
+  ThreadCounters* thread_counters();
+
  private:
   /** True if stats are being gathered. */
   bool enabled_;
 
-  /** Dump all function stats to the output. */
-  void dump_all_func_stats(FILE* out) const {
-#define STATS_REPORT_FUNC_STAT(function_name) \
-  fprintf(                                    \
-      out,                                    \
-      "%-30s%20" PRIu64 ",%20" PRIu64 "\n",   \
-      "  " #function_name ",",                \
-      (uint64_t)function_name##_call_count,   \
-      (uint64_t)function_name##_total_ns);
+  /** Protects the thread counter block registry. */
+  mutable std::mutex counters_mtx_;
+
+  /** The counter blocks of all live threads. */
+  std::set<ThreadCounters*> thread_counters_;
+
+  /** The merged counter blocks of all exited threads. */
+  ThreadCounters retired_counters_;
+
+  /** Registers the counter block of a new thread. */
+  void register_thread_counters(ThreadCounters* counters);
+
+  /**
+   * Deregisters the counter block of an exiting thread, merging it into
+   * `retired_counters_` so that its samples survive the thread.
+   */
+  void deregister_thread_counters(ThreadCounters* counters);
+
+  /**
+   * Returns the upper bound (in nanoseconds) of the bucket that contains
+   * the given percentile of the input histogram, or 0 if the histogram
+   * is empty.
+   *
+   * @param buckets The histogram buckets.
+   * @param fraction The percentile to compute, in `[0.0, 1.0]`.
+   * @return The percentile upper bound in nanoseconds.
+   */
+  static uint64_t hist_percentile(const uint64_t* buckets, double fraction) {
+    uint64_t total = 0;
+    for (unsigned b = 0; b < hist_bucket_num; ++b)
+      total += buckets[b];
+    if (total == 0)
+      return 0;
+
+    auto rank = (uint64_t)(fraction * (double)total + 0.5);
+    if (rank == 0)
+      rank = 1;
+
+    uint64_t cumulative = 0;
+    for (unsigned b = 0; b < hist_bucket_num; ++b) {
+      cumulative += buckets[b];
+      if (cumulative >= rank)
+        return (b == hist_bucket_num - 1) ? UINT64_MAX :
+                                            (UINT64_C(1) << (b + 1)) - 1;
+    }
+
+    return UINT64_MAX;
+  }
+
+  /** Dump all function stats in the aggregated block to the output. */
+  void dump_all_func_stats(FILE* out, const ThreadCounters& total) const {
+#define STATS_REPORT_FUNC_STAT(function_name)                              \
+  fprintf(                                                                 \
+      out,                                                                 \
+      "%-30s%20" PRIu64 ",%20" PRIu64 ",%14" PRIu64 ",%14" PRIu64 ",%14"   \
+      PRIu64 "\n",                                                         \
+      "  " #function_name ",",                                             \
+      total.function_name##_call_count,                                    \
+      total.function_name##_total_ns,                                      \
+      hist_percentile(total.function_name##_hist, 0.50),                   \
+      hist_percentile(total.function_name##_hist, 0.95),                   \
+      hist_percentile(total.function_name##_hist, 0.99));
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_REPORT_FUNC_STAT
   }
 
-  /** Dump all counter stats to the output. */
-  void dump_all_counter_stats(FILE* out) const {
+  /** Dump all counter stats in the aggregated block to the output. */
+  void dump_all_counter_stats(FILE* out, const ThreadCounters& total) const {
 #define STATS_REPORT_COUNTER_STAT(counter_name) \
   fprintf(                                      \
       out,                                      \
       "%-30s%20" PRIu64 "\n",                   \
       "  " #counter_name ",",                   \
-      (uint64_t)counter_##counter_name);
+      total.counter_##counter_name);
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_COUNTER_STAT
+  }
+
+  /** Appends a latency histogram to the output as a JSON array. */
+  static void dump_hist_json(
+      std::ostringstream& out, const uint64_t* buckets) {
+    out << "[";
+    for (unsigned b = 0; b < hist_bucket_num; ++b)
+      out << (b == 0 ? "" : ", ") << buckets[b];
+    out << "]";
+  }
+
+  /** Appends all function stats in the aggregated block as JSON members. */
+  void dump_all_func_stats_json(
+      std::ostringstream& out, const ThreadCounters& total) const {
+    const char* sep = "";
+#define STATS_REPORT_FUNC_STAT(function_name)                   \
+  out << sep << "    \"" #function_name "\": {\"call_count\": " \
+      << total.function_name##_call_count                       \
+      << ", \"total_ns\": " << total.function_name##_total_ns   \
+      << ", \"p50_ns\": "                                       \
+      << hist_percentile(total.function_name##_hist, 0.50)      \
+      << ", \"p95_ns\": "                                       \
+      << hist_percentile(total.function_name##_hist, 0.95)      \
+      << ", \"p99_ns\": "                                       \
+      << hist_percentile(total.function_name##_hist, 0.99)      \
+      << ", \"hist\": ";                                        \
+  dump_hist_json(out, total.function_name##_hist);              \
+  out << "}";                                                   \
+  sep = ",\n";
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_FUNC_STAT
+  }
+
+  /** Appends all counter stats in the aggregated block as JSON members. */
+  void dump_all_counter_stats_json(
+      std::ostringstream& out, const ThreadCounters& total) const {
+    const char* sep = "";
+#define STATS_REPORT_COUNTER_STAT(counter_name)           \
+  out << sep << "    \"" #counter_name "\": "             \
+      << total.counter_##counter_name;                    \
+  sep = ",\n";
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_REPORT_COUNTER_STAT
   }
@@ -131,18 +303,21 @@ extern Statistics all_stats;
  * statement in the function. Note that a function can have multiple exit paths
  * (i.e. multiple returns), but you should still put this macro after the very
  * last statement in the function. */
-#define STATS_FUNC_OUT(f)                                     \
-  }                                                           \
-  ();                                                         \
-  if (stats::all_stats.enabled()) {                           \
-    auto __stats_end = std::chrono::steady_clock::now();      \
-    uint64_t __stats_dur_ns =                                 \
-        std::chrono::duration_cast<std::chrono::nanoseconds>( \
-            __stats_end - __stats_start)                      \
-            .count();                                         \
-    stats::all_stats.f##_total_ns += __stats_dur_ns;          \
-    stats::all_stats.f##_call_count++;                        \
-  }                                                           \
+#define STATS_FUNC_OUT(f)                                         \
+  }                                                               \
+  ();                                                             \
+  if (stats::all_stats.enabled()) {                               \
+    auto __stats_end = std::chrono::steady_clock::now();          \
+    uint64_t __stats_dur_ns =                                     \
+        std::chrono::duration_cast<std::chrono::nanoseconds>(     \
+            __stats_end - __stats_start)                          \
+            .count();                                             \
+    auto __stats_counters = stats::all_stats.thread_counters();   \
+    __stats_counters->f##_total_ns += __stats_dur_ns;             \
+    __stats_counters->f##_call_count++;                           \
+    __stats_counters                                              \
+        ->f##_hist[stats::Statistics::hist_bucket(__stats_dur_ns)]++; \
+  }                                                               \
   return __stats_##f##_retval;
 
 /** Marks the beginning of a stats-enabled void function. This should come
@@ -152,22 +327,25 @@ extern Statistics all_stats;
   [&]() {
 /** Marks the end of a stats-enabled void function. This should come after the
  * last statement in the function. */
-#define STATS_FUNC_VOID_OUT(f)                                 \
-  }                                                            \
-  ();                                                          \
-  if (stats::all_stats.enabled()) {                            \
-    auto __stats_##f##_end = std::chrono::steady_clock::now(); \
-    uint64_t __stats_dur_ns =                                  \
-        std::chrono::duration_cast<std::chrono::nanoseconds>(  \
-            __stats_##f##_end - __stats_##f##_start)           \
-            .count();                                          \
-    stats::all_stats.f##_total_ns += __stats_dur_ns;           \
-    stats::all_stats.f##_call_count++;                         \
+#define STATS_FUNC_VOID_OUT(f)                                    \
+  }                                                               \
+  ();                                                             \
+  if (stats::all_stats.enabled()) {                               \
+    auto __stats_##f##_end = std::chrono::steady_clock::now();    \
+    uint64_t __stats_dur_ns =                                     \
+        std::chrono::duration_cast<std::chrono::nanoseconds>(     \
+            __stats_##f##_end - __stats_##f##_start)              \
+            .count();                                             \
+    auto __stats_counters = stats::all_stats.thread_counters();   \
+    __stats_counters->f##_total_ns += __stats_dur_ns;             \
+    __stats_counters->f##_call_count++;                           \
+    __stats_counters                                              \
+        ->f##_hist[stats::Statistics::hist_bucket(__stats_dur_ns)]++; \
   }
 /** Adds a value to a counter stat. */
-#define STATS_COUNTER_ADD(counter_name, value)          \
-  if (stats::all_stats.enabled()) {                     \
-    stats::all_stats.counter_##counter_name += (value); \
+#define STATS_COUNTER_ADD(counter_name, value)                             \
+  if (stats::all_stats.enabled()) {                                        \
+    stats::all_stats.thread_counters()->counter_##counter_name += (value); \
   }
 
 }  // namespace stats
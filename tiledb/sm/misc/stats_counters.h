@@ -135,6 +135,9 @@ STATS_REPORT_FUNC_STAT(vfs_s3_write_multipart)
 STATS_DEFINE_COUNTER_STAT(vfs_read_total_bytes)
 STATS_DEFINE_COUNTER_STAT(vfs_write_total_bytes)
 STATS_DEFINE_COUNTER_STAT(vfs_read_num_parallelized)
+STATS_DEFINE_COUNTER_STAT(vfs_read_batch_num_regions)
+STATS_DEFINE_COUNTER_STAT(vfs_read_batch_num_reads)
+STATS_DEFINE_COUNTER_STAT(vfs_s3_read_num_parallelized)
 STATS_DEFINE_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_DEFINE_COUNTER_STAT(vfs_s3_write_num_parallelized)
 #endif
@@ -144,6 +147,9 @@ STATS_DEFINE_COUNTER_STAT(vfs_s3_write_num_parallelized)
 STATS_INIT_COUNTER_STAT(vfs_read_total_bytes)
 STATS_INIT_COUNTER_STAT(vfs_write_total_bytes)
 STATS_INIT_COUNTER_STAT(vfs_read_num_parallelized)
+STATS_INIT_COUNTER_STAT(vfs_read_batch_num_regions)
+STATS_INIT_COUNTER_STAT(vfs_read_batch_num_reads)
+STATS_INIT_COUNTER_STAT(vfs_s3_read_num_parallelized)
 STATS_INIT_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_INIT_COUNTER_STAT(vfs_s3_write_num_parallelized)
 #endif
@@ -153,6 +159,9 @@ STATS_INIT_COUNTER_STAT(vfs_s3_write_num_parallelized)
 STATS_REPORT_COUNTER_STAT(vfs_read_total_bytes)
 STATS_REPORT_COUNTER_STAT(vfs_write_total_bytes)
 STATS_REPORT_COUNTER_STAT(vfs_read_num_parallelized)
+STATS_REPORT_COUNTER_STAT(vfs_read_batch_num_regions)
+STATS_REPORT_COUNTER_STAT(vfs_read_batch_num_reads)
+STATS_REPORT_COUNTER_STAT(vfs_s3_read_num_parallelized)
 STATS_REPORT_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_REPORT_COUNTER_STAT(vfs_s3_write_num_parallelized)
 #endif
\ No newline at end of file
@@ -51,6 +51,47 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** The number of status codes. Must be kept in sync with StatusCode. */
+constexpr size_t status_code_num = size_t(StatusCode::FS_MEM) + 1;
+
+/**
+ * The static states referenced by message-less error statuses: one state
+ * per status code (a zero message length, the code, and a posix code of
+ * -1), in StatusCode order. These states are shared rather than copied
+ * and are never freed.
+ */
+struct StaticStates {
+  char states_[status_code_num][7];
+
+  StaticStates() {
+    const uint32_t length = 0;
+    const int16_t posix_code = -1;
+    for (size_t i = 0; i < status_code_num; ++i) {
+      memcpy(states_[i], &length, sizeof(length));
+      states_[i][4] = static_cast<char>(i);
+      memcpy(states_[i] + 5, &posix_code, sizeof(posix_code));
+    }
+  }
+};
+
+const StaticStates& static_states() {
+  static const StaticStates states;
+  return states;
+}
+
+}  // namespace
+
+const char* Status::static_state(StatusCode code) {
+  return static_states().states_[static_cast<unsigned char>(code)];
+}
+
+bool Status::is_static_state(const char* state) {
+  auto first = &static_states().states_[0][0];
+  return state >= first && state < first + sizeof(StaticStates::states_);
+}
+
 Status::Status(StatusCode code, const std::string& msg, int16_t posix_code) {
   assert(code != StatusCode::Ok);
   size_t msg_size = msg.size();
@@ -77,9 +118,11 @@ std::string Status::to_string() const {
   if (state_ == nullptr) {
     return result;
   }
-  result.append(": ");
   uint32_t size;
   memcpy(&size, state_, sizeof(size));
+  if (size == 0)
+    return result;
+  result.append(": ");
   result.append(static_cast<const char*>(state_ + 7), size);
   return result;
 }
@@ -165,6 +208,9 @@ std::string Status::code_to_string() const {
     case StatusCode::LRUCache:
       type = "[TileDB::LRUCache] Error";
       break;
+    case StatusCode::DiskCache:
+      type = "[TileDB::DiskCache] Error";
+      break;
     case StatusCode::KV:
       type = "[TileDB::KV] Error";
       break;
@@ -195,6 +241,15 @@ std::string Status::code_to_string() const {
     case StatusCode::DenseCellRangeIter:
       type = "[TileDB::DenseCellRangeIter] Error";
       break;
+    case StatusCode::RTree:
+      type = "[TileDB::RTree] Error";
+      break;
+    case StatusCode::BloomFilter:
+      type = "[TileDB::BloomFilter] Error";
+      break;
+    case StatusCode::FS_MEM:
+      type = "[TileDB::MemFS] Error";
+      break;
     default:
       type = "[TileDB::?] Error:";
   }
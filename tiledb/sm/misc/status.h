@@ -54,22 +54,35 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <utility>
 
 namespace tiledb {
 namespace sm {
 
-#define RETURN_NOT_OK(s) \
-  do {                   \
-    Status _s = (s);     \
-    if (!_s.ok()) {      \
-      return _s;         \
-    }                    \
+/**
+ * Branch hints for the status fast paths. Statuses are overwhelmingly Ok,
+ * so the error branches are laid out off the fall-through path.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TILEDB_LIKELY(x) __builtin_expect(!!(x), 1)
+#define TILEDB_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define TILEDB_LIKELY(x) (x)
+#define TILEDB_UNLIKELY(x) (x)
+#endif
+
+#define RETURN_NOT_OK(s)             \
+  do {                               \
+    Status _s = (s);                 \
+    if (TILEDB_UNLIKELY(!_s.ok())) { \
+      return _s;                     \
+    }                                \
   } while (false);
 
 #define RETURN_NOT_OK_ELSE(s, else_) \
   do {                               \
     Status _s = (s);                 \
-    if (!_s.ok()) {                  \
+    if (TILEDB_UNLIKELY(!_s.ok())) { \
       else_;                         \
       return _s;                     \
     }                                \
@@ -102,6 +115,7 @@ enum class StatusCode : char {
   Domain,
   Consolidation,
   LRUCache,
+  DiskCache,
   KV,
   KVItem,
   KVIter,
@@ -112,6 +126,9 @@ enum class StatusCode : char {
   Attribute,
   SparseReader,
   DenseCellRangeIter,
+  RTree,
+  BloomFilter,
+  FS_MEM,
 };
 
 class Status {
@@ -130,9 +147,21 @@ class Status {
       : Status(code, msg, -1) {
   }
 
+  /**
+   * Constructor with a code only. The returned status carries no
+   * allocated message: it points to a static per-code state, and a
+   * human-readable message is materialized from the code only when the
+   * status is printed. Suitable for error returns in hot loops, where
+   * the allocation and copying of a message string is measurable.
+   */
+  explicit Status(StatusCode code)
+      : state_(static_state(code)) {
+  }
+
   /** Destructor. */
   ~Status() {
-    delete[] state_;
+    if (state_ != nullptr && !is_static_state(state_))
+      delete[] state_;
   }
 
   /** Copy the specified status. */
@@ -141,6 +170,15 @@ class Status {
   /** Assign status. */
   void operator=(const Status& s);
 
+  /** Move the specified status, leaving it Ok. */
+  Status(Status&& s)
+      : state_(s.state_) {
+    s.state_ = nullptr;
+  }
+
+  /** Move-assign status. */
+  void operator=(Status&& s);
+
   /**  Return a success status **/
   static Status Ok() {
     return Status();
@@ -273,6 +311,11 @@ class Status {
     return Status(StatusCode::LRUCache, msg, -1);
   }
 
+  /** Return a DiskCacheError error class Status with a given message **/
+  static Status DiskCacheError(const std::string& msg) {
+    return Status(StatusCode::DiskCache, msg, -1);
+  }
+
   /** Return a KVError error class Status with a given message **/
   static Status KVError(const std::string& msg) {
     return Status(StatusCode::KV, msg, -1);
@@ -308,6 +351,11 @@ class Status {
     return Status(StatusCode::FS_HDFS, msg, -1);
   }
 
+  /** Return a MemFSError error class Status with a given message **/
+  static Status MemFSError(const std::string& msg) {
+    return Status(StatusCode::FS_MEM, msg, -1);
+  }
+
   /** Return a AttributeError error class Status with a given message **/
   static Status AttributeError(const std::string& msg) {
     return Status(StatusCode::Attribute, msg, -1);
@@ -324,9 +372,19 @@ class Status {
     return Status(StatusCode::DenseCellRangeIter, msg, -1);
   }
 
+  /** Return a RTreeError error class Status with a given message **/
+  static Status RTreeError(const std::string& msg) {
+    return Status(StatusCode::RTree, msg, -1);
+  }
+
+  /** Return a BloomFilterError error class Status with a given message **/
+  static Status BloomFilterError(const std::string& msg) {
+    return Status(StatusCode::BloomFilter, msg, -1);
+  }
+
   /** Returns true iff the status indicates success **/
   bool ok() const {
-    return (state_ == nullptr);
+    return TILEDB_LIKELY(state_ == nullptr);
   }
 
   /**
@@ -381,20 +439,37 @@ class Status {
 
   /** Clones and returns the input state (allocates memory). */
   static const char* copy_state(const char* s);
+
+  /** Returns the static (message-less) state of the input code. */
+  static const char* static_state(StatusCode code);
+
+  /** Returns true iff the input state is a static per-code state. */
+  static bool is_static_state(const char* state);
 };
 
 inline Status::Status(const Status& s) {
-  state_ = (s.state_ == nullptr) ? nullptr : copy_state(s.state_);
+  // Static states are shared, not copied
+  state_ = (s.state_ == nullptr || is_static_state(s.state_)) ?
+               s.state_ :
+               copy_state(s.state_);
 }
 
 inline void Status::operator=(const Status& s) {
   // The following condition catches both aliasing (when this == &s),
   // and when both s and *this are ok.
   if (state_ != s.state_) {
-    delete[] state_;
-    state_ = (s.state_ == nullptr) ? nullptr : copy_state(s.state_);
+    if (state_ != nullptr && !is_static_state(state_))
+      delete[] state_;
+    state_ = (s.state_ == nullptr || is_static_state(s.state_)) ?
+                 s.state_ :
+                 copy_state(s.state_);
   }
 }
+
+inline void Status::operator=(Status&& s) {
+  // The moved-from status adopts this state and frees it upon destruction
+  std::swap(state_, s.state_);
+}
 }  // namespace sm
 }  // namespace tiledb
 
@@ -32,21 +32,90 @@
 
 #include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/numa.h"
+
+#include <chrono>
 
 namespace tiledb {
 namespace sm {
 
-ThreadPool::ThreadPool(uint64_t num_threads) {
+thread_local ThreadPool* ThreadPool::tp_worker_pool_ = nullptr;
+
+thread_local uint64_t ThreadPool::tp_worker_id_ = 0;
+
+/* ****************************** */
+/*           TASK GROUP           */
+/* ****************************** */
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool* pool)
+    : pool_(pool) {
+}
+
+ThreadPool::TaskGroup::~TaskGroup() {
+  wait();
+}
+
+void ThreadPool::TaskGroup::run(const std::function<Status()>& function) {
+  tasks_.push_back(pool_->enqueue(function));
+}
+
+Status ThreadPool::TaskGroup::wait() {
+  Status st = Status::Ok();
+  for (auto& future : tasks_) {
+    if (!future.valid())
+      continue;
+
+    // Execute pending tasks instead of blocking until the task is done.
+    while (future.wait_for(std::chrono::milliseconds(0)) !=
+           std::future_status::ready) {
+      if (!pool_->run_pending_task()) {
+        // No pending tasks; the task has been claimed by another thread
+        // and will complete without our help.
+        future.wait();
+      }
+    }
+
+    Status task_st = future.get();
+    if (!task_st.ok()) {
+      LOG_STATUS(task_st);
+      if (st.ok())
+        st = task_st;
+    }
+  }
+  tasks_.clear();
+
+  return st;
+}
+
+/* ****************************** */
+/*          THREAD POOL           */
+/* ****************************** */
+
+ThreadPool::ThreadPool(uint64_t num_threads, bool numa_aware) {
   should_terminate_ = false;
+  num_pending_ = 0;
+  next_queue_ = 0;
+
+  // Partition the workers into contiguous per-node ranges; the workers
+  // pin themselves to their node upon startup
+  auto node_num = numa::node_num();
+  if (numa_aware && node_num > 1 && num_threads > 1) {
+    worker_nodes_.resize(num_threads);
+    for (uint64_t i = 0; i < num_threads; i++)
+      worker_nodes_[i] = (i * node_num) / num_threads;
+  }
+
+  for (uint64_t i = 0; i < num_threads; i++)
+    worker_queues_.emplace_back(new WorkerQueue());
   for (uint64_t i = 0; i < num_threads; i++) {
-    threads_.emplace_back([this]() { worker(*this); });
+    threads_.emplace_back([this, i]() { worker(*this, i); });
   }
 }
 
 ThreadPool::~ThreadPool() {
   {
     std::unique_lock<std::mutex> lck(queue_mutex_);
-    if (!task_queue_.empty()) {
+    if (num_pending_ > 0) {
       LOG_ERROR("Destroying ThreadPool with outstanding tasks.");
     }
     should_terminate_ = true;
@@ -63,9 +132,23 @@ std::future<Status> ThreadPool::enqueue(
   std::packaged_task<Status()> task(function);
   auto future = task.get_future();
 
+  // Tasks submitted from a worker thread go to that worker's own queue;
+  // tasks submitted from other threads are distributed round-robin.
+  uint64_t queue_idx = (tp_worker_pool_ == this) ?
+                           tp_worker_id_ :
+                           (next_queue_++ % worker_queues_.size());
+
+  // Increment before pushing so that `num_pending_` never underflows
+  // when a concurrent pop claims the task.
+  num_pending_++;
+  {
+    auto& queue = *worker_queues_[queue_idx];
+    std::unique_lock<std::mutex> lck(queue.mtx_);
+    queue.tasks_.push_back(std::move(task));
+  }
+
   {
     std::unique_lock<std::mutex> lck(queue_mutex_);
-    task_queue_.push(std::move(task));
     queue_cv_.notify_one();
   }
 
@@ -83,6 +166,16 @@ bool ThreadPool::wait_all(std::vector<std::future<Status>>& tasks) {
       LOG_ERROR("Waiting on invalid future.");
       all_ok = false;
     } else {
+      // Execute pending tasks instead of blocking until the task is done.
+      while (future.wait_for(std::chrono::milliseconds(0)) !=
+             std::future_status::ready) {
+        if (!run_pending_task()) {
+          // No pending tasks; the task has been claimed by another thread
+          // and will complete without our help.
+          future.wait();
+        }
+      }
+
       Status status = future.get();
       all_ok &= status.ok();
       if (!status.ok()) {
@@ -93,26 +186,79 @@ bool ThreadPool::wait_all(std::vector<std::future<Status>>& tasks) {
   return all_ok;
 }
 
-void ThreadPool::worker(ThreadPool& pool) {
-  while (true) {
-    std::packaged_task<Status()> task;
-    {
-      std::unique_lock<std::mutex> lck(pool.queue_mutex_);
-      pool.queue_cv_.wait(lck, [&pool]() {
-        return pool.should_terminate_ || !pool.task_queue_.empty();
-      });
-
-      if (pool.should_terminate_) {
-        break;
-      } else {
-        task = std::move(pool.task_queue_.front());
-        pool.task_queue_.pop();
+bool ThreadPool::pop_task(std::packaged_task<Status()>* task) {
+  auto queue_num = worker_queues_.size();
+  uint64_t start = 0;
+
+  // Try the calling worker's own queue first, popping the newest task.
+  if (tp_worker_pool_ == this) {
+    auto& queue = *worker_queues_[tp_worker_id_];
+    std::unique_lock<std::mutex> lck(queue.mtx_);
+    if (!queue.tasks_.empty()) {
+      *task = std::move(queue.tasks_.back());
+      queue.tasks_.pop_back();
+      num_pending_--;
+      return true;
+    }
+    start = tp_worker_id_ + 1;
+  }
+
+  // Steal the oldest task from another queue. NUMA-aware workers scan
+  // the queues of their own node first, so that tasks (and the buffers
+  // they touch) cross sockets only when their node has run dry.
+  bool numa_worker = (tp_worker_pool_ == this && !worker_nodes_.empty());
+  auto my_node = (numa_worker) ? worker_nodes_[tp_worker_id_] : 0;
+  unsigned pass_num = (numa_worker) ? 2 : 1;
+  for (unsigned pass = 0; pass < pass_num; pass++) {
+    for (uint64_t i = 0; i < queue_num; i++) {
+      auto q = (start + i) % queue_num;
+      if (numa_worker && ((worker_nodes_[q] == my_node) != (pass == 0)))
+        continue;
+      auto& queue = *worker_queues_[q];
+      std::unique_lock<std::mutex> lck(queue.mtx_);
+      if (!queue.tasks_.empty()) {
+        *task = std::move(queue.tasks_.front());
+        queue.tasks_.pop_front();
+        num_pending_--;
+        return true;
       }
     }
+  }
+
+  return false;
+}
+
+bool ThreadPool::run_pending_task() {
+  std::packaged_task<Status()> task;
+  if (!pop_task(&task))
+    return false;
+
+  task();
+  return true;
+}
+
+void ThreadPool::worker(ThreadPool& pool, uint64_t worker_id) {
+  tp_worker_pool_ = &pool;
+  tp_worker_id_ = worker_id;
+
+  // Pin NUMA-aware workers to their node; a failure leaves the worker
+  // unpinned, which affects performance but not correctness
+  if (!pool.worker_nodes_.empty())
+    numa::pin_to_node(pool.worker_nodes_[worker_id]);
+
+  while (true) {
+    if (pool.run_pending_task())
+      continue;
+
+    std::unique_lock<std::mutex> lck(pool.queue_mutex_);
+    pool.queue_cv_.wait(lck, [&pool]() {
+      return pool.should_terminate_ || pool.num_pending_ > 0;
+    });
 
-    task();
+    if (pool.should_terminate_ && pool.num_pending_ == 0)
+      break;
   }
 }
 
 }  // namespace sm
-}  // namespace tiledb
\ No newline at end of file
+}  // namespace tiledb
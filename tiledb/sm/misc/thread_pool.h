@@ -33,10 +33,12 @@
 #ifndef TILEDB_THREAD_POOL_H
 #define TILEDB_THREAD_POOL_H
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
@@ -46,16 +48,71 @@ namespace tiledb {
 namespace sm {
 
 /**
- * Thread pool class.
+ * Work-stealing thread pool class. Each worker thread maintains its own
+ * task deque; tasks enqueued from a worker thread go to that worker's
+ * deque (and are popped in LIFO order), whereas idle workers steal the
+ * oldest task from another deque. Threads that wait on tasks execute
+ * pending tasks instead of blocking, so parallel regions may be safely
+ * nested on the same pool without deadlocking.
  */
 class ThreadPool {
  public:
+  /**
+   * Groups a set of tasks submitted to a thread pool, so that they can
+   * be waited on collectively. Waiting executes pending pool tasks
+   * instead of blocking, which makes it safe to create a task group
+   * (i.e., open a nested parallel region) from within a pool task.
+   */
+  class TaskGroup {
+   public:
+    /**
+     * Constructor.
+     *
+     * @param pool The thread pool the group's tasks will execute on.
+     */
+    explicit TaskGroup(ThreadPool* pool);
+
+    /** Destructor. Waits on any tasks that have not been waited on. */
+    ~TaskGroup();
+
+    /**
+     * Enqueues a new task as part of this group.
+     *
+     * @param function Task function to execute.
+     */
+    void run(const std::function<Status()>& function);
+
+    /**
+     * Waits on all the group's tasks to complete, executing pending
+     * pool tasks while waiting.
+     *
+     * @return The first non-OK status returned by a task, or Status::Ok.
+     */
+    Status wait();
+
+   private:
+    /** The thread pool the group's tasks execute on. */
+    ThreadPool* pool_;
+
+    /** The futures of the tasks submitted to this group. */
+    std::vector<std::future<Status>> tasks_;
+  };
+
   /**
    * Constructor.
    *
+   * On NUMA-aware pools running on a multi-node machine, the workers
+   * are partitioned into per-node sub-pools: each worker is pinned to
+   * the CPUs of its node, and idle workers steal from same-node queues
+   * before crossing to another node. Together with first-touch memory
+   * placement, tasks that allocate, fill and consume a buffer on the
+   * same worker keep the buffer local to that worker's socket.
+   *
    * @param num_threads Number of threads to create (default 1).
+   * @param numa_aware If `true` and the machine has more than one NUMA
+   *     node, the workers are pinned to nodes as described above.
    */
-  explicit ThreadPool(uint64_t num_threads = 1);
+  explicit ThreadPool(uint64_t num_threads = 1, bool numa_aware = false);
 
   /** Destructor. */
   ~ThreadPool();
@@ -72,7 +129,10 @@ class ThreadPool {
   uint64_t num_threads() const;
 
   /**
-   * Wait on all the given tasks to complete.
+   * Wait on all the given tasks to complete. While a task is not done,
+   * the calling thread executes pending tasks from the pool instead of
+   * blocking, so it is safe to call this from within a task running on
+   * the same pool.
    *
    * @param tasks Task list to wait on.
    * @return True if all tasks returned Status::Ok, false otherwise.
@@ -80,20 +140,70 @@ class ThreadPool {
   bool wait_all(std::vector<std::future<Status>>& tasks);
 
  private:
+  /** Per-worker state: a task deque protected by its own mutex. */
+  struct WorkerQueue {
+    /** Protects `tasks_`. */
+    std::mutex mtx_;
+
+    /** The worker's task deque. */
+    std::deque<std::packaged_task<Status()>> tasks_;
+  };
+
+  /** Protects `should_terminate_` and used with `queue_cv_`. */
   std::mutex queue_mutex_;
 
+  /** Signals workers when tasks are enqueued or the pool terminates. */
   std::condition_variable queue_cv_;
 
+  /** Set to true when the pool is being destroyed. */
   bool should_terminate_;
 
-  std::queue<std::packaged_task<Status()>> task_queue_;
+  /** The number of enqueued tasks that have not been claimed yet. */
+  std::atomic<uint64_t> num_pending_;
+
+  /** Used to distribute externally submitted tasks over the queues. */
+  std::atomic<uint64_t> next_queue_;
+
+  /** The per-worker task queues. */
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+
+  /**
+   * The NUMA node of each worker, or empty if the pool is not
+   * NUMA-aware (or the machine has a single node). The workers of a
+   * node form a contiguous range of worker ids.
+   */
+  std::vector<uint64_t> worker_nodes_;
 
+  /** The worker threads. */
   std::vector<std::thread> threads_;
 
-  static void worker(ThreadPool& pool);
+  /** The pool the calling thread is a worker of (nullptr if none). */
+  static thread_local ThreadPool* tp_worker_pool_;
+
+  /** The calling thread's worker index within `tp_worker_pool_`. */
+  static thread_local uint64_t tp_worker_id_;
+
+  /**
+   * Pops a pending task, trying the calling worker's own deque first
+   * (newest task) and then stealing the oldest task from another deque.
+   *
+   * @param task Set to the popped task.
+   * @return True if a task was popped, false if all queues are empty.
+   */
+  bool pop_task(std::packaged_task<Status()>* task);
+
+  /**
+   * Pops and executes a single pending task.
+   *
+   * @return True if a task was executed, false if all queues are empty.
+   */
+  bool run_pending_task();
+
+  /** The worker thread routine. */
+  static void worker(ThreadPool& pool, uint64_t worker_id);
 };
 
 }  // namespace sm
 }  // namespace tiledb
 
-#endif  // TILEDB_THREAD_POOL_H
\ No newline at end of file
+#endif  // TILEDB_THREAD_POOL_H
@@ -0,0 +1,109 @@
+/**
+ * @file   trace.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the lightweight tracing facility.
+ */
+
+#include "tiledb/sm/misc/trace.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace tiledb {
+namespace sm {
+namespace trace {
+
+Tracer all_tracer;
+
+const uint64_t Tracer::event_buffer_size;
+
+Tracer::Tracer() {
+  enabled_ = false;
+  events_.resize(event_buffer_size);
+  event_num_ = 0;
+}
+
+bool Tracer::enabled() const {
+  return enabled_;
+}
+
+void Tracer::set_enabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+void Tracer::clear() {
+  event_num_ = 0;
+}
+
+void Tracer::record(const char* name, Phase phase) {
+  if (!enabled_)
+    return;
+
+  auto timestamp_ns = (uint64_t)std::chrono::duration_cast<
+                          std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+  auto idx = event_num_++ % event_buffer_size;
+  auto& event = events_[idx];
+  event.name_ = name;
+  event.timestamp_ns_ = timestamp_ns;
+  event.thread_id_ = std::hash<std::thread::id>()(std::this_thread::get_id());
+  event.phase_ = phase;
+}
+
+void Tracer::dump_json(FILE* out) const {
+  uint64_t event_num = event_num_;
+  uint64_t dump_num = std::min(event_num, event_buffer_size);
+  // If the ring buffer wrapped, start from the oldest surviving event so
+  // that the events are emitted in recording order.
+  uint64_t start = (event_num > event_buffer_size) ?
+                       (event_num % event_buffer_size) :
+                       0;
+
+  fprintf(out, "[\n");
+  for (uint64_t i = 0; i < dump_num; ++i) {
+    const auto& event = events_[(start + i) % event_buffer_size];
+    // The Chrome trace-event format expects timestamps in microseconds.
+    fprintf(
+        out,
+        "{\"name\":\"%s\",\"cat\":\"tiledb\",\"ph\":\"%c\","
+        "\"ts\":%.3f,\"pid\":0,\"tid\":%llu}%s\n",
+        event.name_,
+        (char)event.phase_,
+        (double)event.timestamp_ns_ / 1000.0,
+        (unsigned long long)event.thread_id_,
+        (i + 1 < dump_num) ? "," : "");
+  }
+  fprintf(out, "]\n");
+}
+
+}  // namespace trace
+}  // namespace sm
+}  // namespace tiledb
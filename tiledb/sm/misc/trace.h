@@ -0,0 +1,174 @@
+/**
+ * @file   trace.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains declarations of the lightweight tracing facility.
+ */
+
+#ifndef TILEDB_TRACE_H
+#define TILEDB_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+namespace trace {
+
+/**
+ * Class that records begin/end span events into a fixed-capacity ring
+ * buffer and dumps them in the Chrome trace-event JSON format, which can
+ * be loaded into `chrome://tracing` to view a per-thread timeline of the
+ * traced code sections.
+ *
+ * The recorded events are *span* events: each traced section records one
+ * event when it is entered and one when it is left, both tagged with the
+ * id of the recording thread and a nanosecond timestamp. When the ring
+ * buffer fills up, the oldest events are overwritten, so the dump always
+ * covers the most recent activity.
+ *
+ * Recording a single event is one atomic increment plus a few stores into
+ * a preallocated slot, and when tracing is disabled (the default) the
+ * cost is a single branch, so the instrumentation can stay in place in
+ * release builds.
+ */
+class Tracer {
+ public:
+  /** The number of event slots in the ring buffer. */
+  static const uint64_t event_buffer_size = 1048576;
+
+  /** The phase of a span event. */
+  enum class Phase : char { Begin = 'B', End = 'E' };
+
+  /** A single begin/end span event in the ring buffer. */
+  struct Event {
+    /** The span name. Must point to a string with static lifetime. */
+    const char* name_;
+    /** The event timestamp in nanoseconds (steady clock). */
+    uint64_t timestamp_ns_;
+    /** The id of the thread that recorded the event. */
+    uint64_t thread_id_;
+    /** The event phase (begin or end). */
+    Phase phase_;
+  };
+
+  /** Constructor. */
+  Tracer();
+
+  /** Returns true if tracing is currently enabled. */
+  bool enabled() const;
+
+  /** Enable or disable event recording. */
+  void set_enabled(bool enabled);
+
+  /** Discard all recorded events. */
+  void clear();
+
+  /**
+   * Records a span event. Does nothing if tracing is disabled.
+   *
+   * @param name The span name, which must have static lifetime.
+   * @param phase The event phase (begin or end).
+   */
+  void record(const char* name, Phase phase);
+
+  /**
+   * Dumps the recorded events to the given file as a Chrome trace-event
+   * JSON array. The dump is not synchronized with concurrent recording,
+   * so it should be invoked when no traced operations are in flight
+   * (e.g. after the queries under investigation have completed).
+   *
+   * @param out The output file.
+   */
+  void dump_json(FILE* out) const;
+
+ private:
+  /** True if events are being recorded. */
+  bool enabled_;
+
+  /** The preallocated ring buffer of events. */
+  std::vector<Event> events_;
+
+  /** The total number of events recorded since the last clear. */
+  std::atomic<uint64_t> event_num_;
+};
+
+/**
+ * The singleton instance holding the global event ring buffer.
+ */
+extern Tracer all_tracer;
+
+/**
+ * An RAII guard that records a begin event upon construction and the
+ * matching end event upon destruction. Prefer the `TRACE_SCOPED_SPAN`
+ * macro over using this class directly.
+ */
+class ScopedSpan {
+ public:
+  /** Constructor. Records the begin event of the span. */
+  explicit ScopedSpan(const char* name)
+      : name_(name)
+      , active_(all_tracer.enabled()) {
+    if (active_)
+      all_tracer.record(name_, Tracer::Phase::Begin);
+  }
+
+  /** Destructor. Records the end event of the span. */
+  ~ScopedSpan() {
+    if (active_)
+      all_tracer.record(name_, Tracer::Phase::End);
+  }
+
+ private:
+  /** The span name. */
+  const char* name_;
+
+  /** True if tracing was enabled when the span began. */
+  bool active_;
+};
+
+/** @cond */
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+/** @endcond */
+
+/**
+ * Traces the enclosing scope as a span with the given name, which must be
+ * a string literal (or another string with static lifetime).
+ */
+#define TRACE_SCOPED_SPAN(name) \
+  tiledb::sm::trace::ScopedSpan TRACE_CONCAT(__trace_span_, __LINE__)(name)
+
+}  // namespace trace
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TRACE_H
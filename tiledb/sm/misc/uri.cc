@@ -40,32 +40,53 @@
 #endif
 
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace tiledb {
 namespace sm {
 
-/* ********************************* */
-/*     CONSTRUCTORS & DESTRUCTORS    */
-/* ********************************* */
+namespace {
 
-URI::URI() {
-  uri_ = "";
+/** The interned empty (invalid) URI. */
+const std::string& empty_uri() {
+  static const std::string empty;
+  return empty;
 }
 
-URI::URI(const std::string& path) {
+/** Normalizes `path` into an absolute URI (empty string on error). */
+std::string normalize(const std::string& path) {
+  std::string uri;
   if (path.empty())
-    uri_ = "";
+    uri = "";
   else if (URI::is_file(path))
-    uri_ = VFS::abs_path(path);
-  else if (URI::is_hdfs(path) || URI::is_s3(path))
-    uri_ = path;
+    uri = VFS::abs_path(path);
+  else if (URI::is_hdfs(path) || URI::is_s3(path) || URI::is_memfs(path))
+    uri = path;
   else
-    uri_ = "";
+    uri = "";
 
-  if (uri_.length() > constants::uri_max_len) {
-    LOG_ERROR("URI '" + uri_ + "' exceeds length limit.");
-    uri_ = "";
+  if (uri.length() > constants::uri_max_len) {
+    LOG_ERROR("URI '" + uri + "' exceeds length limit.");
+    uri = "";
   }
+
+  return uri;
+}
+
+}  // namespace
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+URI::URI() {
+  uri_ = &empty_uri();
+}
+
+URI::URI(const std::string& path) {
+  uri_ = intern(path);
 }
 
 URI::~URI() = default;
@@ -75,11 +96,15 @@ URI::~URI() = default;
 /* ********************************* */
 
 const char* URI::c_str() const {
-  return uri_.c_str();
+  return uri_->c_str();
+}
+
+uint64_t URI::id() const {
+  return reinterpret_cast<uint64_t>(uri_);
 }
 
 bool URI::is_invalid() const {
-  return uri_.empty();
+  return uri_->empty();
 }
 
 bool URI::is_file(const std::string& path) {
@@ -88,7 +113,7 @@ bool URI::is_file(const std::string& path) {
 }
 
 bool URI::is_file() const {
-  return utils::starts_with(uri_, "file:///");
+  return utils::starts_with(*uri_, "file:///");
 }
 
 bool URI::is_hdfs(const std::string& path) {
@@ -96,7 +121,7 @@ bool URI::is_hdfs(const std::string& path) {
 }
 
 bool URI::is_hdfs() const {
-  return utils::starts_with(uri_, "hdfs://");
+  return utils::starts_with(*uri_, "hdfs://");
 }
 
 bool URI::is_s3(const std::string& path) {
@@ -106,35 +131,43 @@ bool URI::is_s3(const std::string& path) {
 }
 
 bool URI::is_s3() const {
-  return utils::starts_with(uri_, "s3://") ||
-         utils::starts_with(uri_, "http://") ||
-         utils::starts_with(uri_, "https://");
+  return utils::starts_with(*uri_, "s3://") ||
+         utils::starts_with(*uri_, "http://") ||
+         utils::starts_with(*uri_, "https://");
+}
+
+bool URI::is_memfs(const std::string& path) {
+  return utils::starts_with(path, "mem://");
+}
+
+bool URI::is_memfs() const {
+  return utils::starts_with(*uri_, "mem://");
 }
 
 URI URI::join_path(const std::string& path) const {
-  if (uri_.back() == '/') {
+  if (uri_->back() == '/') {
     if (path.front() == '/') {
-      return URI(uri_ + path.substr(1, path.size()));
+      return URI(*uri_ + path.substr(1, path.size()));
     }
-    return URI(uri_ + path);
+    return URI(*uri_ + path);
   } else {
     if (path.front() == '/') {
-      return URI(uri_ + path);
+      return URI(*uri_ + path);
     } else {
-      return URI(uri_ + "/" + path);
+      return URI(*uri_ + "/" + path);
     }
   }
 }
 
 std::string URI::last_path_part() const {
-  return uri_.substr(uri_.find_last_of('/') + 1);
+  return uri_->substr(uri_->find_last_of('/') + 1);
 }
 
 URI URI::parent() const {
-  uint64_t pos = uri_.find_last_of('/');
+  uint64_t pos = uri_->find_last_of('/');
   if (pos == std::string::npos)
     return URI();
-  return URI(uri_.substr(0, pos));
+  return URI(uri_->substr(0, pos));
 }
 
 std::string URI::to_path(const std::string& uri) {
@@ -146,7 +179,7 @@ std::string URI::to_path(const std::string& uri) {
 #endif
   }
 
-  if (is_hdfs(uri) || is_s3(uri))
+  if (is_hdfs(uri) || is_s3(uri) || is_memfs(uri))
     return uri;
 
   // Error
@@ -154,11 +187,44 @@ std::string URI::to_path(const std::string& uri) {
 }
 
 std::string URI::to_path() const {
-  return to_path(uri_);
+  return to_path(*uri_);
 }
 
 std::string URI::to_string() const {
-  return uri_;
+  return *uri_;
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+const std::string* URI::intern(const std::string& path) {
+  static std::mutex mtx;
+  static std::unordered_set<std::string> interned;
+  static std::unordered_map<std::string, const std::string*> cache;
+
+  // Relative paths normalize against the current working directory,
+  // which may change during the process lifetime, so they bypass the
+  // normalization cache (their normalized form is still interned).
+  bool cacheable =
+      !path.empty() &&
+      (path.front() == '/' || path.find("://") != std::string::npos);
+
+  // Fast path: the input path has been normalized and interned before
+  if (cacheable) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = cache.find(path);
+    if (it != cache.end())
+      return it->second;
+  }
+
+  // Slow path: normalize outside the lock, then intern
+  auto uri = normalize(path);
+  std::lock_guard<std::mutex> lock(mtx);
+  auto entry = &(*interned.insert(std::move(uri)).first);
+  if (cacheable)
+    cache.emplace(path, entry);
+  return entry;
 }
 
 }  // namespace sm
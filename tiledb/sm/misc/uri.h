@@ -68,6 +68,15 @@ class URI {
   /** Returns a C-style pointer to the URI string. */
   const char* c_str() const;
 
+  /**
+   * Returns a 64-bit identifier of the URI, unique per distinct URI
+   * within the process. Because URI strings are interned, the
+   * identifier is simply the address of the interned string, so
+   * obtaining it costs nothing. The identifier is not stable across
+   * process runs and must not be persisted.
+   */
+  uint64_t id() const;
+
   /** Checks if the URI is invalid (empty string). */
   bool is_invalid() const;
 
@@ -116,6 +125,21 @@ class URI {
    */
   bool is_s3() const;
 
+  /**
+   * Checks if the input path is in-memory.
+   *
+   * @param path The path to be checked.
+   * @return The result of the check.
+   */
+  static bool is_memfs(const std::string& path);
+
+  /**
+   * Checks if the URI is in-memory.
+   *
+   * @return The result of the check.
+   */
+  bool is_memfs() const;
+
   /**
    * Joins the URI with the input path.
    *
@@ -158,8 +182,25 @@ class URI {
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
 
-  /** The URI is stored as a string. */
-  std::string uri_;
+  /**
+   * The URI points into a process-wide table of interned normalized URI
+   * strings. Entries are never removed from the table, so copying a URI
+   * copies a pointer and the string returned by `c_str()` remains valid
+   * for the lifetime of the process. Constructing a URI from a path that
+   * has been seen before is a table lookup and skips normalization
+   * (including the `realpath` call for posix paths).
+   */
+  const std::string* uri_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Returns the interned normalized URI of `path`, normalizing and
+   * inserting it into the table upon first sight.
+   */
+  static const std::string* intern(const std::string& path);
 };
 
 }  // namespace sm
@@ -34,10 +34,16 @@
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <cstring>
 #include <iostream>
 #include <set>
 #include <sstream>
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TILEDB_UTILS_X86
+#include <emmintrin.h>
+#endif
+
 #ifdef _WIN32
 #include <sys/timeb.h>
 #include <sys/types.h>
@@ -92,6 +98,20 @@ Status convert(const std::string& str, uint64_t* value) {
   return Status::Ok();
 }
 
+Status convert(const std::string& str, float* value) {
+  try {
+    *value = std::stof(str);
+  } catch (std::invalid_argument& e) {
+    return LOG_STATUS(Status::UtilsError(
+        "Failed to convert string to float; Invalid argument"));
+  } catch (std::out_of_range& e) {
+    return LOG_STATUS(Status::UtilsError(
+        "Failed to convert string to float; Value out of range"));
+  }
+
+  return Status::Ok();
+}
+
 bool is_int(const std::string& str) {
   // Check if empty
   if (str.empty())
@@ -523,6 +543,54 @@ uint64_t ceil(uint64_t x, uint64_t y) {
   return x / y + (x % y != 0);
 }
 
+void memcpy_streaming(void* dest, const void* src, uint64_t nbytes) {
+#ifdef TILEDB_UTILS_X86
+  auto d = static_cast<unsigned char*>(dest);
+  auto s = static_cast<const unsigned char*>(src);
+
+  // Copy the head up to the first 16-byte aligned destination address
+  // with regular stores
+  uint64_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+  if (head > nbytes)
+    head = nbytes;
+  std::memcpy(d, s, head);
+  d += head;
+  s += head;
+  nbytes -= head;
+
+  // Stream the aligned bulk, a cache line at a time. The loads are
+  // unaligned, as the source need not share the destination alignment.
+  while (nbytes >= 64) {
+    auto v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    auto v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+    auto v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+    auto v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+    d += 64;
+    s += 64;
+    nbytes -= 64;
+  }
+  while (nbytes >= 16) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), v);
+    d += 16;
+    s += 16;
+    nbytes -= 16;
+  }
+
+  // Order the streaming stores before any subsequent load/store
+  _mm_sfence();
+
+  // Copy the tail with regular stores
+  std::memcpy(d, s, nbytes);
+#else
+  std::memcpy(dest, src, nbytes);
+#endif
+}
+
 // Explicit template instantiations
 template uint64_t cell_num_in_subarray<int>(
     const int* subarray, unsigned int dim_num);
@@ -61,6 +61,9 @@ Status convert(const std::string& str, long* value);
 /** Converts the input string into a `uint64_t` value. */
 Status convert(const std::string& str, uint64_t* value);
 
+/** Converts the input string into a `float` value. */
+Status convert(const std::string& str, float* value);
+
 /** Returns `true` if the input string is a (potentially signed) integer. */
 bool is_int(const std::string& str);
 
@@ -285,6 +288,21 @@ uint64_t timestamp_ms();
 /** Returns the value of x/y (integer division) rounded up. */
 uint64_t ceil(uint64_t x, uint64_t y);
 
+/**
+ * Copies *nbytes* bytes from *src* to *dest* using non-temporal
+ * (streaming) stores where the platform supports them, so that a large
+ * destination that is written once and never read back does not evict
+ * the working set from the CPU caches. The unaligned head and tail of
+ * the destination are copied with regular stores, and a store fence is
+ * issued before returning. Falls back to `std::memcpy` on platforms
+ * without streaming stores. The regions must not overlap.
+ *
+ * @param dest The destination buffer.
+ * @param src The source buffer.
+ * @param nbytes The number of bytes to copy.
+ */
+void memcpy_streaming(void* dest, const void* src, uint64_t nbytes);
+
 }  // namespace utils
 
 }  // namespace sm
@@ -76,7 +76,6 @@ ArrayOrderedWriteState::ArrayOrderedWriteState(Query* query)
     tile_slab_[i] = std::malloc(2 * coords_size_);
     tile_slab_norm_[i] = std::malloc(2 * coords_size_);
     tile_slab_init_[i] = false;
-    async_wait_[i] = false;
   }
   for (unsigned int i = 0; i < anum; ++i) {
     if (array_schema->var_size(attribute_ids_[i]))
@@ -110,6 +109,8 @@ ArrayOrderedWriteState::~ArrayOrderedWriteState() {
   std::free(tile_domain_);
 
   for (unsigned int i = 0; i < 2; ++i) {
+    if (write_task_[i].valid())
+      write_task_[i].wait();
     if (async_query_[i] != nullptr)
       async_query_[i]->finalize();
     delete async_query_[i];
@@ -130,6 +131,10 @@ ArrayOrderedWriteState::~ArrayOrderedWriteState() {
 /* ****************************** */
 
 Status ArrayOrderedWriteState::finalize() {
+  // Wait for any pending writes
+  RETURN_NOT_OK(wait_write(0));
+  RETURN_NOT_OK(wait_write(1));
+
   for (auto& aq : async_query_) {
     if (aq != nullptr)
       RETURN_NOT_OK(aq->finalize());
@@ -306,9 +311,6 @@ Status ArrayOrderedWriteState::write(void** buffers, uint64_t* buffer_sizes) {
   // Create buffers
   RETURN_NOT_OK(create_copy_state_buffers());
 
-  for (unsigned int i = 0; i < 2; ++i)
-    async_data_[i] = {i, 0, this};
-
   // Call the appropriate templated write
   Datatype type = query_->array_schema()->coords_type();
   if (type == Datatype::INT32)
@@ -411,23 +413,7 @@ void ArrayOrderedWriteState::advance_cell_slab_row(unsigned int aid) {
   update_current_tile_and_offset<T>(aid);
 }
 
-void ArrayOrderedWriteState::async_done(void* data) {
-  // Retrieve data
-  ArrayOrderedWriteState* asws = ((ASWS_Data*)data)->asws_;
-  unsigned int id = ((ASWS_Data*)data)->id_;
-
-  asws->async_notify(id);
-}
-
-void ArrayOrderedWriteState::async_notify(unsigned int id) {
-  {
-    std::lock_guard<std::mutex> lk(async_mtx_[id]);
-    async_wait_[id] = false;
-  }
-  async_cv_[id].notify_one();
-}
-
-Status ArrayOrderedWriteState::async_submit_query(unsigned int id) {
+Status ArrayOrderedWriteState::submit_write(unsigned int id) {
   // For easy reference
   auto storage_manager = query_->storage_manager();
   bool separate_fragments = this->separate_fragments();
@@ -449,7 +435,6 @@ Status ArrayOrderedWriteState::async_submit_query(unsigned int id) {
         query_->attribute_ids(),
         copy_state_.buffers_[id],
         copy_state_.buffer_offsets_[id]));
-    async_query_[id]->set_callback(async_done, &(async_data_[id]));
   } else {
     if (id == 0) {
       if (async_query_[id] == nullptr) {
@@ -464,29 +449,30 @@ Status ArrayOrderedWriteState::async_submit_query(unsigned int id) {
             query_->attribute_ids(),
             copy_state_.buffers_[id],
             copy_state_.buffer_offsets_[id]));
-        async_query_[id]->set_callback(async_done, &(async_data_[id]));
       }
     } else {  // id == 1
       if (async_query_[id] == nullptr) {
         async_query_[id] = new Query(async_query_[0]);
         async_query_[id]->set_buffers(
             copy_state_.buffers_[id], copy_state_.buffer_offsets_[id]);
-        async_query_[id]->set_callback(async_done, &(async_data_[id]));
       }
     }
   }
 
-  // Send the async query
-  RETURN_NOT_OK(storage_manager->async_push_query(async_query_[id], 1));
+  // Process the write as a task on the compute thread pool
+  auto query = async_query_[id];
+  query->set_status(QueryStatus::INPROGRESS);
+  write_task_[id] = storage_manager->compute_thread_pool()->enqueue(
+      [query]() { return query->async_process(); });
 
   // Success
   return Status::Ok();
 }
 
-void ArrayOrderedWriteState::async_wait(unsigned int id) {
-  std::unique_lock<std::mutex> lk(async_mtx_[id]);
-  async_cv_[id].wait(lk, [id, this] { return !async_wait_[id]; });
-  lk.unlock();
+Status ArrayOrderedWriteState::wait_write(unsigned int id) {
+  if (!write_task_[id].valid())
+    return Status::Ok();
+  return write_task_[id].get();
 }
 
 void ArrayOrderedWriteState::calculate_buffer_num() {
@@ -838,130 +824,164 @@ void ArrayOrderedWriteState::calculate_tile_slab_info_row(unsigned int id) {
   }
 }
 
-void ArrayOrderedWriteState::copy_tile_slab() {
+Status ArrayOrderedWriteState::copy_tile_slab() {
   // For easy reference
   auto array_schema = query_->array_schema();
-  auto nattributes = attribute_ids_.size();
+  auto nattributes = (unsigned)attribute_ids_.size();
 
-  // Copy tile slab for each attribute separately
+  // Compute the buffer index of each attribute
+  std::vector<unsigned> bids(nattributes);
   for (unsigned int i = 0, b = 0; i < nattributes; ++i) {
-    Datatype type = array_schema->type(attribute_ids_.at(i));
-    if (!array_schema->var_size(attribute_ids_[i])) {
-      switch (type) {
-        case Datatype::INT32:
-          copy_tile_slab<int>(i, b);
-          break;
-        case Datatype::INT64:
-          copy_tile_slab<int64_t>(i, b);
-          break;
-        case Datatype::FLOAT32:
-          copy_tile_slab<float>(i, b);
-          break;
-        case Datatype::FLOAT64:
-          copy_tile_slab<double>(i, b);
-          break;
-        case Datatype::INT8:
-          copy_tile_slab<int8_t>(i, b);
-          break;
-        case Datatype::UINT8:
-          copy_tile_slab<uint8_t>(i, b);
-          break;
-        case Datatype::INT16:
-          copy_tile_slab<int16_t>(i, b);
-          break;
-        case Datatype::UINT16:
-          copy_tile_slab<uint16_t>(i, b);
-          break;
-        case Datatype::UINT32:
-          copy_tile_slab<uint32_t>(i, b);
-          break;
-        case Datatype::UINT64:
-          copy_tile_slab<uint64_t>(i, b);
-          break;
-        case Datatype::CHAR:
-          copy_tile_slab<char>(i, b);
-          break;
-        case Datatype::STRING_ASCII:
-          copy_tile_slab<uint8_t>(i, b);
-          break;
-        case Datatype::STRING_UTF8:
-          copy_tile_slab<uint8_t>(i, b);
-          break;
-        case Datatype::STRING_UTF16:
-          copy_tile_slab<uint16_t>(i, b);
-          break;
-        case Datatype::STRING_UTF32:
-          copy_tile_slab<uint32_t>(i, b);
-          break;
-        case Datatype::STRING_UCS2:
-          copy_tile_slab<uint16_t>(i, b);
-          break;
-        case Datatype::STRING_UCS4:
-          copy_tile_slab<uint32_t>(i, b);
-          break;
-        case Datatype::ANY:
-          copy_tile_slab<uint8_t>(i, b);
-          break;
-      }
-      ++b;
-    } else {
-      switch (type) {
-        case Datatype::INT32:
-          copy_tile_slab_var<int>(i, b);
-          break;
-        case Datatype::INT64:
-          copy_tile_slab_var<int64_t>(i, b);
-          break;
-        case Datatype::FLOAT32:
-          copy_tile_slab_var<float>(i, b);
-          break;
-        case Datatype::FLOAT64:
-          copy_tile_slab_var<double>(i, b);
-          break;
-        case Datatype::INT8:
-          copy_tile_slab_var<int8_t>(i, b);
-          break;
-        case Datatype::UINT8:
-          copy_tile_slab_var<uint8_t>(i, b);
-          break;
-        case Datatype::INT16:
-          copy_tile_slab_var<int16_t>(i, b);
-          break;
-        case Datatype::UINT16:
-          copy_tile_slab_var<uint16_t>(i, b);
-          break;
-        case Datatype::UINT32:
-          copy_tile_slab_var<uint32_t>(i, b);
-          break;
-        case Datatype::UINT64:
-          copy_tile_slab_var<uint64_t>(i, b);
-          break;
-        case Datatype::CHAR:
-          copy_tile_slab_var<char>(i, b);
-          break;
-        case Datatype::STRING_ASCII:
-          copy_tile_slab_var<uint8_t>(i, b);
-          break;
-        case Datatype::STRING_UTF8:
-          copy_tile_slab_var<uint8_t>(i, b);
-          break;
-        case Datatype::STRING_UTF16:
-          copy_tile_slab_var<uint16_t>(i, b);
-          break;
-        case Datatype::STRING_UTF32:
-          copy_tile_slab_var<uint32_t>(i, b);
-          break;
-        case Datatype::STRING_UCS2:
-          copy_tile_slab_var<uint16_t>(i, b);
-          break;
-        case Datatype::STRING_UCS4:
-          copy_tile_slab_var<uint32_t>(i, b);
-          break;
-        case Datatype::ANY:
-          copy_tile_slab_var<uint8_t>(i, b);
-          break;
-      }
-      b += 2;
+    bids[i] = b;
+    b += array_schema->var_size(attribute_ids_[i]) ? 2 : 1;
+  }
+
+  // Single attribute - no need to involve the thread pool
+  if (nattributes == 1) {
+    copy_tile_slab_attr(0, bids[0]);
+    return Status::Ok();
+  }
+
+  // Each attribute copies into its own buffers and advances its own
+  // slab state - copy the attributes in parallel on the compute pool
+  auto thread_pool = query_->storage_manager()->compute_thread_pool();
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(nattributes);
+  for (unsigned int i = 0; i < nattributes; ++i) {
+    tasks.push_back(thread_pool->enqueue([this, i, &bids]() {
+      copy_tile_slab_attr(i, bids[i]);
+      return Status::Ok();
+    }));
+  }
+  if (!thread_pool->wait_all(tasks))
+    return LOG_STATUS(
+        Status::ASWSError("Cannot copy tile slab; Attribute tasks failed"));
+
+  return Status::Ok();
+}
+
+void ArrayOrderedWriteState::copy_tile_slab_attr(
+    unsigned int aid, unsigned int bid) {
+  // For easy reference
+  auto array_schema = query_->array_schema();
+  auto i = aid;
+  auto b = bid;
+
+  // Copy the tile slab of the attribute, dispatching on its type
+  Datatype type = array_schema->type(attribute_ids_.at(i));
+  if (!array_schema->var_size(attribute_ids_[i])) {
+    switch (type) {
+      case Datatype::INT32:
+        copy_tile_slab<int>(i, b);
+        break;
+      case Datatype::INT64:
+        copy_tile_slab<int64_t>(i, b);
+        break;
+      case Datatype::FLOAT32:
+        copy_tile_slab<float>(i, b);
+        break;
+      case Datatype::FLOAT64:
+        copy_tile_slab<double>(i, b);
+        break;
+      case Datatype::INT8:
+        copy_tile_slab<int8_t>(i, b);
+        break;
+      case Datatype::UINT8:
+        copy_tile_slab<uint8_t>(i, b);
+        break;
+      case Datatype::INT16:
+        copy_tile_slab<int16_t>(i, b);
+        break;
+      case Datatype::UINT16:
+        copy_tile_slab<uint16_t>(i, b);
+        break;
+      case Datatype::UINT32:
+        copy_tile_slab<uint32_t>(i, b);
+        break;
+      case Datatype::UINT64:
+        copy_tile_slab<uint64_t>(i, b);
+        break;
+      case Datatype::CHAR:
+        copy_tile_slab<char>(i, b);
+        break;
+      case Datatype::STRING_ASCII:
+        copy_tile_slab<uint8_t>(i, b);
+        break;
+      case Datatype::STRING_UTF8:
+        copy_tile_slab<uint8_t>(i, b);
+        break;
+      case Datatype::STRING_UTF16:
+        copy_tile_slab<uint16_t>(i, b);
+        break;
+      case Datatype::STRING_UTF32:
+        copy_tile_slab<uint32_t>(i, b);
+        break;
+      case Datatype::STRING_UCS2:
+        copy_tile_slab<uint16_t>(i, b);
+        break;
+      case Datatype::STRING_UCS4:
+        copy_tile_slab<uint32_t>(i, b);
+        break;
+      case Datatype::ANY:
+        copy_tile_slab<uint8_t>(i, b);
+        break;
+    }
+  } else {
+    switch (type) {
+      case Datatype::INT32:
+        copy_tile_slab_var<int>(i, b);
+        break;
+      case Datatype::INT64:
+        copy_tile_slab_var<int64_t>(i, b);
+        break;
+      case Datatype::FLOAT32:
+        copy_tile_slab_var<float>(i, b);
+        break;
+      case Datatype::FLOAT64:
+        copy_tile_slab_var<double>(i, b);
+        break;
+      case Datatype::INT8:
+        copy_tile_slab_var<int8_t>(i, b);
+        break;
+      case Datatype::UINT8:
+        copy_tile_slab_var<uint8_t>(i, b);
+        break;
+      case Datatype::INT16:
+        copy_tile_slab_var<int16_t>(i, b);
+        break;
+      case Datatype::UINT16:
+        copy_tile_slab_var<uint16_t>(i, b);
+        break;
+      case Datatype::UINT32:
+        copy_tile_slab_var<uint32_t>(i, b);
+        break;
+      case Datatype::UINT64:
+        copy_tile_slab_var<uint64_t>(i, b);
+        break;
+      case Datatype::CHAR:
+        copy_tile_slab_var<char>(i, b);
+        break;
+      case Datatype::STRING_ASCII:
+        copy_tile_slab_var<uint8_t>(i, b);
+        break;
+      case Datatype::STRING_UTF8:
+        copy_tile_slab_var<uint8_t>(i, b);
+        break;
+      case Datatype::STRING_UTF16:
+        copy_tile_slab_var<uint16_t>(i, b);
+        break;
+      case Datatype::STRING_UTF32:
+        copy_tile_slab_var<uint32_t>(i, b);
+        break;
+      case Datatype::STRING_UCS2:
+        copy_tile_slab_var<uint16_t>(i, b);
+        break;
+      case Datatype::STRING_UCS4:
+        copy_tile_slab_var<uint32_t>(i, b);
+        break;
+      case Datatype::ANY:
+        copy_tile_slab_var<uint8_t>(i, b);
+        break;
     }
   }
 }
@@ -1824,17 +1844,17 @@ Status ArrayOrderedWriteState::write_sorted_col() {
 
   // Iterate over each tile slab
   while (next_tile_slab_col<T>()) {
-    async_wait(copy_id_);
+    RETURN_NOT_OK(wait_write(copy_id_));
     reset_tile_slab_state<T>();
     reset_copy_state();
-    copy_tile_slab();
-    async_wait_[copy_id_] = true;
-    async_submit_query(copy_id_);
+    RETURN_NOT_OK(copy_tile_slab());
+    RETURN_NOT_OK(submit_write(copy_id_));
     copy_id_ = (copy_id_ + 1) % 2;
   }
 
-  // Wait for last async query to finish
-  async_wait((copy_id_ + 1) % 2);
+  // Wait for the pending writes to finish
+  RETURN_NOT_OK(wait_write(0));
+  RETURN_NOT_OK(wait_write(1));
 
   // Success
   return Status::Ok();
@@ -1854,17 +1874,17 @@ Status ArrayOrderedWriteState::write_sorted_row() {
 
   // Iterate over each tile slab
   while (next_tile_slab_row<T>()) {
-    async_wait(copy_id_);
+    RETURN_NOT_OK(wait_write(copy_id_));
     reset_tile_slab_state<T>();
     reset_copy_state();
-    copy_tile_slab();
-    async_wait_[copy_id_] = true;
-    async_submit_query(copy_id_);
+    RETURN_NOT_OK(copy_tile_slab());
+    RETURN_NOT_OK(submit_write(copy_id_));
     copy_id_ = (copy_id_ + 1) % 2;
   }
 
-  // Wait for last async query to finish
-  async_wait((copy_id_ + 1) % 2);
+  // Wait for the pending writes to finish
+  RETURN_NOT_OK(wait_write(0));
+  RETURN_NOT_OK(wait_write(1));
 
   // Success
   return Status::Ok();
@@ -37,8 +37,7 @@
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/query/query.h"
 
-#include <condition_variable>
-#include <mutex>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -58,7 +57,7 @@ class ArrayOrderedWriteState {
   /*          TYPE DEFINITIONS         */
   /* ********************************* */
 
-  /** Used in callback functions in an internal async query. */
+  /** Used in the cell/tile slab callback functions. */
   struct ASWS_Data {
     /** An id (typically an attribute id or a tile slab id.) */
     unsigned int id_;
@@ -137,8 +136,8 @@ class ArrayOrderedWriteState {
   /* ********************************* */
 
   /**
-   * Finalizes the object, and particularly the internal async queries.
-   * The async queries will be finalized in the destructor anyway, but
+   * Finalizes the object, and particularly the internal write queries.
+   * The write queries will be finalized in the destructor anyway, but
    * this function allows capturing errors upon query finalization.
    */
   Status finalize();
@@ -169,20 +168,14 @@ class ArrayOrderedWriteState {
   /** Function for advancing a cell slab during a copy operation. */
   void* (*advance_cell_slab_)(void*);
 
-  /** Condition variables used for the internal async queries. */
-  std::condition_variable async_cv_[2];
-
-  /** Data for the internal async queries. */
-  ASWS_Data async_data_[2];
-
-  /** Mutexes used in async queries. */
-  std::mutex async_mtx_[2];
-
-  /** The async queries. */
+  /** The internal write queries, one for each local buffer. */
   Query* async_query_[2];
 
-  /** Wait for async flags, one for each local buffer. */
-  bool async_wait_[2];
+  /**
+   * The pending write tasks on the compute thread pool, one for each
+   * local buffer.
+   */
+  std::future<Status> write_task_[2];
 
   /** The ids of the attributes the array was initialized with. */
   const std::vector<unsigned int> attribute_ids_;
@@ -309,26 +302,22 @@ class ArrayOrderedWriteState {
   void advance_cell_slab_row(unsigned int aid);
 
   /**
-   * Called when an async query completes.
+   * Submits the write of the local buffers of the input tile slab id
+   * as a task on the compute thread pool.
    *
-   * @param data A ASWS_Request object.
-   * @return void
+   * @param id The id of the tile slab the write focuses on.
+   * @return Status
    */
-  static void async_done(void* data);
-
-  /** Notifies an async condition on the input tile slab id. */
-  void async_notify(unsigned int id);
+  Status submit_write(unsigned int id);
 
   /**
-   * Sends an async query.
+   * Waits for the pending write task of the input tile slab id,
+   * returning its status. A no-op if no write is pending.
    *
-   * @param async_id The id of the tile slab the AIO request focuses on.
+   * @param id The id of the tile slab the write focuses on.
    * @return Status
    */
-  Status async_submit_query(unsigned int async_id);
-
-  /** Waits on an async condition on the input tile slab id. */
-  void async_wait(unsigned int id);
+  Status wait_write(unsigned int id);
 
   /**
    * Calculates the number of buffers to be allocated, based on the number
@@ -506,11 +495,23 @@ class ArrayOrderedWriteState {
   /**
    * Copies a tile slab from the user buffers into the local buffers,
    * properly re-organizing the cell order to follow the array global
-   * cell order.
+   * cell order. The attributes are copied in parallel on the compute
+   * thread pool, as each attribute copies into its own buffers and
+   * advances its own slab state.
+   *
+   * @return Status
+   */
+  Status copy_tile_slab();
+
+  /**
+   * Copies the tile slab of a single attribute, dispatching on the
+   * attribute type.
    *
+   * @param aid The index on attribute_ids_ to focus on.
+   * @param bid The index on the copy state buffers to focus on.
    * @return void.
    */
-  void copy_tile_slab();
+  void copy_tile_slab_attr(unsigned int aid, unsigned int bid);
 
   /**
    * Copies a tile slab from the local buffers into the user buffers,
@@ -54,6 +54,8 @@ template <class T>
 DenseCellRangeIter<T>::DenseCellRangeIter() {
   domain_ = nullptr;
   end_ = true;
+  materialized_ = false;
+  flat_pos_ = 0;
 }
 
 template <class T>
@@ -63,6 +65,8 @@ DenseCellRangeIter<T>::DenseCellRangeIter(
     , subarray_(subarray)
     , layout_(layout) {
   end_ = true;
+  materialized_ = false;
+  flat_pos_ = 0;
 }
 
 /* ****************************** */
@@ -96,6 +100,62 @@ Status DenseCellRangeIter<T>::begin() {
   return Status::Ok();
 }
 
+template <class T>
+Status DenseCellRangeIter<T>::all_ranges(std::vector<CellRange>* ranges) {
+  if (end_)
+    return Status::Ok();
+
+  auto dim_num = domain_->dim_num();
+  auto cell_order = domain_->cell_order();
+
+  // A slab either follows the cell order (so its cells are contiguous in
+  // the tile) or degenerates to a single cell when the query layout does
+  // not match the cell order. In both cases the range end position is
+  // the start position plus the slab length along the fastest-varying
+  // dimension of the cell order, with no second position computation.
+  unsigned slab_dim = (cell_order == Layout::ROW_MAJOR) ? dim_num - 1 : 0;
+
+  std::vector<T> next_tile_coords(dim_num);
+  bool in_subarray;
+  for (;;) {
+    // Emit the current range (the first one was computed by `begin`)
+    ranges->push_back(CellRange{tile_idx_, range_start_, range_end_});
+
+    // Get next start coordinates, which must follow the end coordinates
+    in_subarray = false;
+    coords_start_ = coords_end_;
+    compute_next_start_coords(&in_subarray);
+    if (!in_subarray) {
+      end_ = true;
+      return Status::Ok();
+    }
+
+    // For global order, `compute_next_start_coords` computes all tile
+    // info. For the other layouts, recompute the tile info only if the
+    // next range falls in a different tile.
+    if (layout_ != Layout::GLOBAL_ORDER) {
+      domain_->get_tile_coords(&coords_start_[0], &next_tile_coords[0]);
+      if (next_tile_coords != tile_coords_)
+        compute_current_tile_info();
+    }
+
+    compute_current_end_coords();
+    RETURN_NOT_OK(domain_->get_cell_pos<T>(&coords_start_[0], &range_start_));
+    range_end_ = range_start_ +
+                 (uint64_t)(coords_end_[slab_dim] - coords_start_[slab_dim]);
+  }
+}
+
+template <class T>
+Status DenseCellRangeIter<T>::materialize() {
+  flat_.clear();
+  flat_pos_ = 0;
+  RETURN_NOT_OK(all_ranges(&flat_));
+  materialized_ = true;
+  end_ = flat_.empty();
+  return Status::Ok();
+}
+
 template <class T>
 bool DenseCellRangeIter<T>::end() const {
   return end_;
@@ -103,21 +163,28 @@ bool DenseCellRangeIter<T>::end() const {
 
 template <class T>
 uint64_t DenseCellRangeIter<T>::tile_idx() const {
+  if (materialized_)
+    return flat_[flat_pos_].tile_idx_;
   return tile_idx_;
 }
 
 template <class T>
 uint64_t DenseCellRangeIter<T>::range_start() const {
+  if (materialized_)
+    return flat_[flat_pos_].start_;
   return range_start_;
 }
 
 template <class T>
 uint64_t DenseCellRangeIter<T>::range_end() const {
+  if (materialized_)
+    return flat_[flat_pos_].end_;
   return range_end_;
 }
 
 template <class T>
 const T* DenseCellRangeIter<T>::tile_coords() const {
+  assert(!materialized_);
   return &tile_coords_[0];
 }
 
@@ -127,6 +194,13 @@ void DenseCellRangeIter<T>::operator++() {
   if (end_)
     return;
 
+  // Materialized ranges are consumed with a cursor bump
+  if (materialized_) {
+    ++flat_pos_;
+    end_ = (flat_pos_ >= flat_.size());
+    return;
+  }
+
   // Get next start coordinates, which must follow the end coordinates
   bool in_subarray = false;
   coords_start_ = coords_end_;
@@ -70,6 +70,20 @@ class DenseCellRangeIter {
   /** Destructor. */
   ~DenseCellRangeIter() = default;
 
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /** A cell range materialized by the bulk interface. */
+  struct CellRange {
+    /** The tile index of the range in the global order of the domain. */
+    uint64_t tile_idx_;
+    /** The start position of the range within its tile. */
+    uint64_t start_;
+    /** The end position of the range within its tile. */
+    uint64_t end_;
+  };
+
   /* ********************************* */
   /*                 API               */
   /* ********************************* */
@@ -77,6 +91,34 @@ class DenseCellRangeIter {
   /** Initializes the iterator, computing the very first cell range. */
   Status begin();
 
+  /**
+   * Materializes all remaining cell ranges into the caller-provided
+   * vector in one call, advancing the iterator to its end. This avoids
+   * the per-range function calls and layout branching of `operator++`:
+   * the tile info is recomputed only when a range crosses into a new
+   * tile, and the range end position is derived from the slab length
+   * instead of a second cell position computation.
+   *
+   * Must be called after `begin()`.
+   *
+   * @param ranges The vector the ranges are appended to.
+   * @return Status
+   */
+  Status all_ranges(std::vector<CellRange>* ranges);
+
+  /**
+   * Materializes all remaining cell ranges into an internal flat
+   * buffer, from which the regular traversal API (`end()`,
+   * `tile_idx()`, `range_start()`, `range_end()`, `operator++`) is
+   * subsequently served. This turns each advance into a cursor bump.
+   *
+   * Must be called after `begin()`. Note that `tile_coords()` is not
+   * supported after materialization.
+   *
+   * @return Status
+   */
+  Status materialize();
+
   /** Checks if the iterator has reached the end. */
   bool end() const;
 
@@ -154,6 +196,15 @@ class DenseCellRangeIter {
   /** The query layout. */
   Layout layout_;
 
+  /** `true` if the ranges have been materialized into `flat_`. */
+  bool materialized_;
+
+  /** The materialized ranges, if `materialized_` is `true`. */
+  std::vector<CellRange> flat_;
+
+  /** The traversal cursor into `flat_`. */
+  uint64_t flat_pos_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -33,14 +33,20 @@
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/radix_sort.h"
+#include "tiledb/sm/misc/trace.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/tile/tile_io.h"
 
 #include <array>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <queue>
 #include <set>
 #include <sstream>
+#include <type_traits>
+#include <unordered_set>
 
 /* ****************************** */
 /*             MACROS             */
@@ -52,6 +58,25 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * Returns the byte that the `fill_size` bytes of `fill_value` all
+ * repeat, or -1 if the fill pattern is not a single repeated byte.
+ * Fill regions of a single repeated byte (e.g. the all-ones unsigned
+ * integer fill values) are materialized with one wide `memset`.
+ */
+int fill_pattern_byte(const void* fill_value, uint64_t fill_size) {
+  auto bytes = (const unsigned char*)fill_value;
+  for (uint64_t i = 1; i < fill_size; ++i) {
+    if (bytes[i] != bytes[0])
+      return -1;
+  }
+  return bytes[0];
+}
+
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -59,12 +84,17 @@ namespace sm {
 Query::Query() {
   common_query_ = nullptr;
   subarray_ = nullptr;
+  subarrays_ = nullptr;
+  subarray_range_num_ = 1;
   array_ordered_write_state_ = nullptr;
   array_schema_ = nullptr;
   buffers_ = nullptr;
   buffer_sizes_ = nullptr;
+  cache_hint_ = CacheHint::CACHE_DEFAULT;
   callback_ = nullptr;
   callback_data_ = nullptr;
+  progress_callback_ = nullptr;
+  progress_callback_data_ = nullptr;
   fragments_init_ = false;
   storage_manager_ = nullptr;
   fragments_borrowed_ = false;
@@ -72,14 +102,21 @@ Query::Query() {
   status_ = QueryStatus::INPROGRESS;
   layout_ = Layout::ROW_MAJOR;
   buffer_num_ = 0;
+  own_buffers_ = false;
+  tile_mem_charged_ = 0;
 }
 
 Query::Query(Query* common_query) {
   common_query_ = common_query;
   subarray_ = nullptr;
+  subarrays_ = nullptr;
+  subarray_range_num_ = 1;
   array_ordered_write_state_ = nullptr;
+  cache_hint_ = common_query->cache_hint_;
   callback_ = nullptr;
   callback_data_ = nullptr;
+  progress_callback_ = nullptr;
+  progress_callback_data_ = nullptr;
   fragments_init_ = false;
   storage_manager_ = common_query->storage_manager();
   fragments_borrowed_ = false;
@@ -89,14 +126,22 @@ Query::Query(Query* common_query) {
   status_ = QueryStatus::INPROGRESS;
   consolidation_fragment_uri_ = common_query->consolidation_fragment_uri_;
   buffer_num_ = common_query->buffer_num_;
+  own_buffers_ = false;
+  tile_mem_charged_ = 0;
 }
 
 Query::~Query() {
   if (subarray_ != nullptr)
     std::free(subarray_);
 
+  if (subarrays_ != nullptr)
+    std::free(subarrays_);
+
   delete array_ordered_write_state_;
 
+  if (tile_mem_charged_ > 0 && storage_manager_ != nullptr)
+    storage_manager_->memory_budget()->release(tile_mem_charged_);
+
   clear_fragments();
 }
 
@@ -131,13 +176,15 @@ Status Query::async_process() {
   else  // WRITE MODE
     st = write();
 
-  if (st.ok()) {  // Success
+  if (st.ok())  // Success
     set_status(QueryStatus::COMPLETED);
-    if (callback_ != nullptr)
-      callback_(callback_data_);
-  } else {  // Error
+  else  // Error
     set_status(QueryStatus::FAILED);
-  }
+
+  // Invoke the callback in both cases (after the status is set), so that
+  // waiters on query completion are not left hanging upon error
+  if (callback_ != nullptr)
+    callback_(callback_data_);
 
   return st;
 }
@@ -147,6 +194,10 @@ const std::vector<unsigned int>& Query::attribute_ids() const {
 }
 
 Status Query::clear_fragments() {
+  // For read queries the fragments are in-memory shells around metadata
+  // owned by the storage manager, so this teardown performs no I/O; a
+  // write query holds a single fragment whose finalization flushes its
+  // write state
   Status ret = Status::Ok();
   if (!fragments_borrowed_) {
     for (auto& fragment : fragments_) {
@@ -430,6 +481,122 @@ Status Query::overflow(
   return Status::Ok();
 }
 
+Status Query::preload(const char** attributes, unsigned int attribute_num) {
+  RETURN_NOT_OK(set_attributes(attributes, attribute_num));
+
+  auto coords_type = array_schema_->coords_type();
+  switch (coords_type) {
+    case Datatype::INT8:
+      return preload<int8_t>();
+    case Datatype::UINT8:
+      return preload<uint8_t>();
+    case Datatype::INT16:
+      return preload<int16_t>();
+    case Datatype::UINT16:
+      return preload<uint16_t>();
+    case Datatype::INT32:
+      return preload<int>();
+    case Datatype::UINT32:
+      return preload<unsigned>();
+    case Datatype::INT64:
+      return preload<int64_t>();
+    case Datatype::UINT64:
+      return preload<uint64_t>();
+    case Datatype::FLOAT32:
+      return preload<float>();
+    case Datatype::FLOAT64:
+      return preload<double>();
+    default:
+      return LOG_STATUS(
+          Status::QueryError("Cannot preload; Unsupported domain type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::preload() {
+  // Compute the overlapping tiles of the sparse fragments, reusing the
+  // overlap computation of the sparse read path, and append those of
+  // the dense fragments
+  OverlappingTileVec tiles;
+  RETURN_NOT_OK(compute_overlapping_tiles<T>(&tiles));
+  RETURN_NOT_OK(preload_dense_tiles<T>(&tiles));
+
+  if (tiles.empty())
+    return Status::Ok();
+
+  // Fetch the tiles of all the attributes concurrently. The fetched
+  // tiles populate the tile cache as a side effect and are discarded.
+  TileFetchList fetches;
+  for (const auto& attr : attributes_)
+    RETURN_NOT_OK(read_tiles(attr, &tiles, &fetches));
+  return wait_tiles(&fetches);
+}
+
+// Real domains are applicable only to sparse arrays, which have no
+// dense fragments (specialized below)
+template <>
+Status Query::preload_dense_tiles<float>(OverlappingTileVec* tiles) const;
+template <>
+Status Query::preload_dense_tiles<double>(OverlappingTileVec* tiles) const;
+
+template <class T>
+Status Query::preload_dense_tiles(OverlappingTileVec* tiles) const {
+  // Trivial case = no dense fragments
+  bool has_dense = false;
+  auto fragment_num = (unsigned)fragment_metadata_.size();
+  for (unsigned f = 0; f < fragment_num; ++f)
+    has_dense |= fragment_metadata_[f]->dense();
+  if (!has_dense)
+    return Status::Ok();
+
+  // Walk the space tiles in the tile domain of the subarray and record,
+  // per dense fragment, those that overlap both the subarray and the
+  // fragment non-empty domain
+  auto domain = array_schema_->domain();
+  auto dim_num = array_schema_->dim_num();
+  auto subarray = (const T*)subarray_;
+  std::vector<T> tile_domain(2 * dim_num), tile_coords(dim_num);
+  std::vector<T> tile_subarray(2 * dim_num), subarray_in_tile(2 * dim_num);
+  domain->get_tile_domain(subarray, &tile_domain[0]);
+  for (unsigned d = 0; d < dim_num; ++d)
+    tile_coords[d] = tile_domain[2 * d];
+  auto tile_num = domain->tile_num<T>(subarray);
+  bool tile_overlap, frag_overlap, in;
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    domain->get_tile_subarray(&tile_coords[0], &tile_subarray[0]);
+    domain->subarray_overlap(
+        subarray, &tile_subarray[0], &subarray_in_tile[0], &tile_overlap);
+    if (tile_overlap) {
+      for (unsigned f = 0; f < fragment_num; ++f) {
+        if (!fragment_metadata_[f]->dense())
+          continue;
+        auto frag_domain = (const T*)fragment_metadata_[f]->non_empty_domain();
+        if (!overlap(&subarray_in_tile[0], frag_domain, dim_num, &frag_overlap))
+          continue;
+        auto tile_idx = fragment_metadata_[f]->get_tile_pos(&tile_coords[0]);
+        tiles->emplace_back(arena_make_shared<OverlappingTile>(f, tile_idx));
+      }
+    }
+    domain->get_next_tile_coords(&tile_domain[0], &tile_coords[0], &in);
+  }
+
+  return Status::Ok();
+}
+
+template <>
+Status Query::preload_dense_tiles<float>(OverlappingTileVec* tiles) const {
+  (void)tiles;
+  return Status::Ok();
+}
+
+template <>
+Status Query::preload_dense_tiles<double>(OverlappingTileVec* tiles) const {
+  (void)tiles;
+  return Status::Ok();
+}
+
 Status Query::dense_read() {
   auto coords_type = array_schema_->coords_type();
   switch (coords_type) {
@@ -460,80 +627,201 @@ Status Query::dense_read() {
 template <class T>
 Status Query::dense_read() {
   // For easy reference
-  auto domain = array_schema_->domain();
   auto subarray_len = 2 * array_schema_->dim_num();
   std::vector<T> subarray;
   subarray.resize(subarray_len);
   for (size_t i = 0; i < subarray_len; ++i)
     subarray[i] = ((T*)subarray_)[i];
 
-  // Get overlapping sparse tile indexes
-  OverlappingTileVec sparse_tiles;
-  RETURN_NOT_OK(compute_overlapping_tiles<T>(&sparse_tiles));
+  // Fast path for the common case of a subarray that is tile-aligned
+  // and fully contained in a single dense fragment
+  if (!read_state_.initialized_ &&
+      dense_read_direct_applicable<T>(&subarray[0])) {
+    reset_read_state();
+    RETURN_NOT_OK(dense_read_direct<T>(&subarray[0]));
+    RETURN_NOT_OK(apply_predicates(&read_state_.cell_ranges_));
+    read_state_.cur_range_ = read_state_.cell_ranges_.cbegin();
+    read_state_.initialized_ = true;
+  }
 
-  // Read sparse tiles
-  RETURN_NOT_OK(read_tiles(constants::coords, &sparse_tiles));
-  for (const auto& attr : attributes_) {
-    if (attr != constants::coords)
-      RETURN_NOT_OK(read_tiles(attr, &sparse_tiles));
+  // Compute the result cell ranges, unless the query is resuming after
+  // an incomplete submission, in which case they are already in place
+  if (!read_state_.initialized_) {
+    reset_read_state();
+
+    // Get overlapping sparse tile indexes
+    OverlappingTileVec sparse_tiles;
+    {
+      QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+      RETURN_NOT_OK(compute_overlapping_tiles<T>(&sparse_tiles));
+    }
+
+    // Read sparse tiles, fetching the tiles of all attributes concurrently
+    TileFetchList sparse_fetches;
+    RETURN_NOT_OK(
+        read_tiles(constants::coords, &sparse_tiles, &sparse_fetches));
+    for (const auto& attr : attributes_) {
+      if (attr != constants::coords)
+        RETURN_NOT_OK(read_tiles(attr, &sparse_tiles, &sparse_fetches));
+    }
+    RETURN_NOT_OK(wait_tiles(&sparse_fetches));
+
+    // Compute the read coordinates for all sparse fragments
+    std::list<std::shared_ptr<OverlappingCoords<T>>> coords;
+    {
+      QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+      RETURN_NOT_OK(compute_overlapping_coords<T>(sparse_tiles, &coords));
+    }
+
+    // Sort and dedup the coordinates (not applicable to the global order
+    // layout for a single fragment)
+    if (!(fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER)) {
+      QueryStatsTimer timer(&stats_.sort_ns_);
+      RETURN_NOT_OK(sort_coords<T>(&coords));
+      RETURN_NOT_OK(dedup_coords<T>(&coords));
+    }
+
+    // For each tile, initialize a dense cell range iterator per
+    // (dense) fragment
+    std::vector<std::vector<DenseCellRangeIter<T>>> dense_frag_its;
+    std::unordered_map<uint64_t, std::pair<uint64_t, std::vector<T>>>
+        overlapping_tile_idx_coords;
+    RETURN_NOT_OK(init_tile_fragment_dense_cell_range_iters(
+        &dense_frag_its, &overlapping_tile_idx_coords));
+
+    // TODO: pass coords (or an iterator and its tile index and cell pos)
+    // TODO: in compute_dense_cell_ranges
+
+    // Get the cell ranges, processing the space tiles concurrently
+    std::list<DenseCellRange<T>> dense_cell_ranges;
+    RETURN_NOT_OK(compute_all_dense_cell_ranges<T>(
+        subarray,
+        overlapping_tile_idx_coords,
+        &dense_frag_its,
+        &dense_cell_ranges));
+
+    // Compute overlapping dense tile indexes
+    OverlappingTileVec dense_tiles;
+    RETURN_NOT_OK(compute_dense_overlapping_tiles_and_cell_ranges<T>(
+        dense_cell_ranges, coords, &dense_tiles, &read_state_.cell_ranges_));
+    coords.clear();
+    dense_cell_ranges.clear();
+    overlapping_tile_idx_coords.clear();
+
+    // Filter the cell ranges through the attribute value predicates
+    RETURN_NOT_OK(apply_predicates(&read_state_.cell_ranges_));
+
+    // Read dense tiles, fetching the tiles of all attributes
+    // concurrently. Tiles whose every cell range was rejected by the
+    // predicates are skipped, as are the attributes the predicate pass
+    // has already fetched for the tiles it scanned.
+    std::set<const OverlappingTile*> contributing;
+    for (const auto& cr : read_state_.cell_ranges_) {
+      if (cr->tile_ != nullptr)
+        contributing.insert(cr->tile_.get());
+    }
+    TileFetchList dense_fetches;
+    for (const auto& attr : attributes_) {
+      OverlappingTileVec missing;
+      for (const auto& tile : dense_tiles) {
+        if (contributing.count(tile.get()) != 0 &&
+            tile->attr_tiles_.find(attr) == tile->attr_tiles_.end())
+          missing.emplace_back(tile);
+      }
+      if (!missing.empty())
+        RETURN_NOT_OK(read_tiles(attr, &missing, &dense_fetches));
+    }
+    RETURN_NOT_OK(wait_tiles(&dense_fetches));
+
+    read_state_.cur_range_ = read_state_.cell_ranges_.cbegin();
+    read_state_.initialized_ = true;
   }
 
-  // Compute the read coordinates for all sparse fragments
-  std::list<std::shared_ptr<OverlappingCoords<T>>> coords;
-  RETURN_NOT_OK(compute_overlapping_coords<T>(sparse_tiles, &coords));
+  // Copy the next batch of cells
+  QueryStatsTimer timer(&stats_.copy_ns_);
+  return copy_cells_batch();
+}
 
-  // Sort and dedup the coordinates (not applicable to the global order
-  // layout for a single fragment)
-  if (!(fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER)) {
-    RETURN_NOT_OK(sort_coords<T>(&coords));
-    RETURN_NOT_OK(dedup_coords<T>(&coords));
+template <class T>
+bool Query::dense_read_direct_applicable(const T* subarray) const {
+  // A single dense fragment, a single-range subarray, and no
+  // coordinates requested (dense fragments store no coordinate tiles)
+  if (fragment_metadata_.size() != 1 || !fragment_metadata_[0]->dense() ||
+      subarrays_ != nullptr)
+    return false;
+  for (const auto& attr : attributes_) {
+    if (attr == constants::coords)
+      return false;
   }
 
-  // For each tile, initialize a dense cell range iterator per
-  // (dense) fragment
-  std::vector<std::vector<DenseCellRangeIter<T>>> dense_frag_its;
-  std::unordered_map<uint64_t, std::pair<uint64_t, std::vector<T>>>
-      overlapping_tile_idx_coords;
-  RETURN_NOT_OK(init_tile_fragment_dense_cell_range_iters(
-      &dense_frag_its, &overlapping_tile_idx_coords));
+  // The result must be requested in the order the tiles are stored
+  if (layout_ != Layout::GLOBAL_ORDER)
+    return false;
 
-  // TODO: pass coords (or an iterator and its tile index and cell pos)
-  // TODO: in compute_dense_cell_ranges
+  // The fragment (expanded) domain must contain the subarray
+  auto dim_num = array_schema_->dim_num();
+  auto frag_domain = (const T*)fragment_metadata_[0]->domain();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    if (subarray[2 * d] < frag_domain[2 * d] ||
+        subarray[2 * d + 1] > frag_domain[2 * d + 1])
+      return false;
+  }
 
-  // Get the cell ranges
-  std::list<DenseCellRange<T>> dense_cell_ranges;
-  DenseCellRangeIter<T> it(domain, subarray, layout_);
-  RETURN_NOT_OK(it.begin());
-  while (!it.end()) {
-    auto o_it = overlapping_tile_idx_coords.find(it.tile_idx());
-    assert(o_it != overlapping_tile_idx_coords.end());
-    RETURN_NOT_OK(compute_dense_cell_ranges<T>(
-        &(o_it->second.second)[0],
-        dense_frag_its[o_it->second.first],
-        it.range_start(),
-        it.range_end(),
-        &dense_cell_ranges));
-    ++it;
+  // The subarray must be aligned to the tile boundaries. Note that the
+  // domain of a dense array is always integral.
+  auto domain = array_schema_->domain();
+  auto tile_extents = (const T*)domain->tile_extents();
+  auto array_domain = (const T*)domain->domain();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto ext = tile_extents[d];
+    if ((subarray[2 * d] - array_domain[2 * d]) % ext != 0 ||
+        (subarray[2 * d + 1] - array_domain[2 * d] + 1) % ext != 0)
+      return false;
   }
 
-  // Compute overlapping dense tile indexes
-  OverlappingTileVec dense_tiles;
-  OverlappingCellRangeList overlapping_cell_ranges;
-  RETURN_NOT_OK(compute_dense_overlapping_tiles_and_cell_ranges<T>(
-      dense_cell_ranges, coords, &dense_tiles, &overlapping_cell_ranges));
-  coords.clear();
-  dense_cell_ranges.clear();
-  overlapping_tile_idx_coords.clear();
+  return true;
+}
 
-  // Read dense tiles
-  for (const auto& attr : attributes_)
-    RETURN_NOT_OK(read_tiles(attr, &dense_tiles));
+template <class T>
+Status Query::dense_read_direct(const T* subarray) {
+  // For easy reference
+  auto domain = array_schema_->domain();
+  auto dim_num = array_schema_->dim_num();
+  auto metadata = fragment_metadata_[0];
+  auto cell_num_per_tile = domain->cell_num_per_tile();
 
-  // Copy cells
-  for (const auto& attr : attributes_)
-    RETURN_NOT_OK(copy_cells(attr, overlapping_cell_ranges));
+  // Visit the subarray tiles in the tile order; each is a whole,
+  // fully-overlapping tile of the single fragment
+  OverlappingTileVec tiles;
+  {
+    QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+    std::vector<T> tile_domain(2 * dim_num);
+    domain->get_tile_domain(subarray, &tile_domain[0]);
+    std::vector<T> tile_coords(dim_num);
+    for (unsigned d = 0; d < dim_num; ++d)
+      tile_coords[d] = tile_domain[2 * d];
+    bool in = true;
+    while (in) {
+      auto tile_pos = metadata->get_tile_pos<T>(&tile_coords[0]);
+      tiles.emplace_back(arena_make_shared<OverlappingTile>(0u, tile_pos, true));
+      domain->get_next_tile_coords(&tile_domain[0], &tile_coords[0], &in);
+    }
+  }
+
+  // Fetch and decompress the tiles of all attributes concurrently
+  TileFetchList fetches;
+  {
+    TRACE_SCOPED_SPAN("query_read_tiles");
+    for (const auto& attr : attributes_)
+      RETURN_NOT_OK(read_tiles(attr, &tiles, &fetches));
+    RETURN_NOT_OK(wait_tiles(&fetches));
+  }
+
+  // One whole-tile cell range per tile
+  for (const auto& tile : tiles)
+    read_state_.cell_ranges_.emplace_back(
+        arena_make_shared<OverlappingCellRange>(tile, 0, cell_num_per_tile - 1));
 
-  status_ = QueryStatus::COMPLETED;
   return Status::Ok();
 }
 
@@ -570,65 +858,1152 @@ Status Query::sparse_read() {
 
 template <class T>
 Status Query::sparse_read() {
-  // Get overlapping tile indexes
-  OverlappingTileVec tiles;
-  RETURN_NOT_OK(compute_overlapping_tiles<T>(&tiles));
+  // Compute the result cell ranges of the first subarray partition,
+  // unless the query is resuming after an incomplete submission, in
+  // which case they are already in place
+  if (!read_state_.initialized_) {
+    reset_read_state();
+
+    // Seed the partition list. Queries that cannot be partitioned (see
+    // `partition_split_dim`) get the whole-subarray sentinel and behave
+    // exactly as before.
+    unsigned split_dim;
+    T align;
+    if (subarray_ != nullptr && partition_split_dim<T>(&split_dim, &align)) {
+      auto subarray = (const uint8_t*)subarray_;
+      auto subarray_size = 2 * array_schema_->dim_num() * sizeof(T);
+      read_state_.partitions_.emplace_back(subarray, subarray + subarray_size);
+    } else {
+      // An empty partition denotes the whole (un-partitioned) subarray
+      read_state_.partitions_.emplace_back();
+    }
 
-  // Read tiles
-  RETURN_NOT_OK(read_tiles(constants::coords, &tiles));
-  for (const auto& attr : attributes_) {
-    if (attr != constants::coords)
-      RETURN_NOT_OK(read_tiles(attr, &tiles));
+    RETURN_NOT_OK(next_read_partition<T>());
+    read_state_.initialized_ = true;
   }
 
-  // Compute the read coordinates for all fragments
+  // Copy cells partition by partition, until the user buffers fill up
+  // (INCOMPLETE) or the result is exhausted (COMPLETED)
+  for (;;) {
+    {
+      TRACE_SCOPED_SPAN("query_copy_cells");
+      QueryStatsTimer timer(&stats_.copy_ns_);
+      RETURN_NOT_OK(copy_cells_batch());
+    }
+    if (status_ != QueryStatus::INPROGRESS)
+      return Status::Ok();
+    RETURN_NOT_OK(next_read_partition<T>());
+  }
+}
+
+// Real domains are applicable only to sparse arrays (specialized below)
+template <>
+Status Query::aggregate<float>(
+    const std::string& attribute, unsigned attr_id, AggregateState* state);
+template <>
+Status Query::aggregate<double>(
+    const std::string& attribute, unsigned attr_id, AggregateState* state);
+
+Status Query::aggregate(
+    const char* attribute, uint64_t* count, void* min, void* max, void* sum) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot compute aggregate; Applicable only to reads"));
+  if (attribute == nullptr || !strcmp(attribute, constants::coords))
+    return LOG_STATUS(Status::QueryError(
+        "Cannot compute aggregate; Invalid attribute"));
+
+  // Applicable only to fixed-sized, single-value numeric attributes,
+  // matching the attributes the per-tile statistics are computed for
+  unsigned attr_id;
+  RETURN_NOT_OK(array_schema_->attribute_id(attribute, &attr_id));
+  if (array_schema_->var_size(attr_id) ||
+      array_schema_->cell_val_num(attr_id) != 1)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot compute aggregate; Applicable only to fixed-sized, "
+        "single-value attributes"));
+  auto attr_type = array_schema_->type(attr_id);
+  switch (attr_type) {
+    case Datatype::CHAR:
+    case Datatype::INT8:
+    case Datatype::UINT8:
+    case Datatype::INT16:
+    case Datatype::UINT16:
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT32:
+    case Datatype::FLOAT64:
+      break;
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot compute aggregate; Applicable only to numeric attributes"));
+  }
+
+  if (subarray_ == nullptr)
+    RETURN_NOT_OK(set_subarray(nullptr));
+
+  // Compute the aggregates, unless there are no fragments (empty result)
+  AggregateState state;
+  if (!fragment_metadata_.empty()) {
+    switch (array_schema_->coords_type()) {
+      case Datatype::INT8:
+        RETURN_NOT_OK(aggregate<int8_t>(attribute, attr_id, &state));
+        break;
+      case Datatype::UINT8:
+        RETURN_NOT_OK(aggregate<uint8_t>(attribute, attr_id, &state));
+        break;
+      case Datatype::INT16:
+        RETURN_NOT_OK(aggregate<int16_t>(attribute, attr_id, &state));
+        break;
+      case Datatype::UINT16:
+        RETURN_NOT_OK(aggregate<uint16_t>(attribute, attr_id, &state));
+        break;
+      case Datatype::INT32:
+        RETURN_NOT_OK(aggregate<int>(attribute, attr_id, &state));
+        break;
+      case Datatype::UINT32:
+        RETURN_NOT_OK(aggregate<unsigned>(attribute, attr_id, &state));
+        break;
+      case Datatype::INT64:
+        RETURN_NOT_OK(aggregate<int64_t>(attribute, attr_id, &state));
+        break;
+      case Datatype::UINT64:
+        RETURN_NOT_OK(aggregate<uint64_t>(attribute, attr_id, &state));
+        break;
+      case Datatype::FLOAT32:
+        RETURN_NOT_OK(aggregate<float>(attribute, attr_id, &state));
+        break;
+      case Datatype::FLOAT64:
+        RETURN_NOT_OK(aggregate<double>(attribute, attr_id, &state));
+        break;
+      default:
+        return LOG_STATUS(Status::QueryError(
+            "Cannot compute aggregate; Unsupported domain type"));
+    }
+  }
+
+  // Export the results; min/max/sum are meaningless on an empty result
+  *count = state.count_;
+  if (state.count_ == 0)
+    return Status::Ok();
+  auto cell_size = array_schema_->cell_size(attr_id);
+  if (min != nullptr)
+    std::memcpy(min, &state.min_[0], cell_size);
+  if (max != nullptr)
+    std::memcpy(max, &state.max_[0], cell_size);
+  if (sum != nullptr) {
+    switch (attr_type) {
+      case Datatype::CHAR:
+      case Datatype::INT8:
+      case Datatype::INT16:
+      case Datatype::INT32:
+      case Datatype::INT64:
+        std::memcpy(sum, &state.sum_int_, sizeof(int64_t));
+        break;
+      case Datatype::UINT8:
+      case Datatype::UINT16:
+      case Datatype::UINT32:
+      case Datatype::UINT64:
+        std::memcpy(sum, &state.sum_uint_, sizeof(uint64_t));
+        break;
+      default:
+        std::memcpy(sum, &state.sum_real_, sizeof(double));
+        break;
+    }
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::aggregate(
+    const std::string& attribute, unsigned attr_id, AggregateState* state) {
+  if (array_schema_->dense())
+    return aggregate_dense<T>(attribute, attr_id, state);
+  return aggregate_sparse<T>(attribute, attr_id, state);
+}
+
+template <>
+Status Query::aggregate<float>(
+    const std::string& attribute, unsigned attr_id, AggregateState* state) {
+  return aggregate_sparse<float>(attribute, attr_id, state);
+}
+
+template <>
+Status Query::aggregate<double>(
+    const std::string& attribute, unsigned attr_id, AggregateState* state) {
+  return aggregate_sparse<double>(attribute, attr_id, state);
+}
+
+template <class T>
+Status Query::aggregate_dense(
+    const std::string& attribute, unsigned attr_id, AggregateState* state) {
+  // For easy reference
+  auto subarray_len = 2 * array_schema_->dim_num();
+  std::vector<T> subarray;
+  subarray.resize(subarray_len);
+  for (size_t i = 0; i < subarray_len; ++i)
+    subarray[i] = ((T*)subarray_)[i];
+
+  // Get the overlapping sparse tile indexes and read their coordinates
+  // and values (the sparse overlays over a dense array are typically
+  // small compared to the dense tiles)
+  OverlappingTileVec sparse_tiles;
+  {
+    QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+    RETURN_NOT_OK(compute_overlapping_tiles<T>(&sparse_tiles));
+  }
+  TileFetchList fetches;
+  RETURN_NOT_OK(read_tiles(constants::coords, &sparse_tiles, &fetches));
+  RETURN_NOT_OK(read_tiles(attribute, &sparse_tiles, &fetches));
+  RETURN_NOT_OK(wait_tiles(&fetches));
+  fetches.clear();
+
+  // Compute the read coordinates for all sparse fragments
   std::list<std::shared_ptr<OverlappingCoords<T>>> coords;
-  RETURN_NOT_OK(compute_overlapping_coords<T>(tiles, &coords));
+  {
+    QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+    RETURN_NOT_OK(compute_overlapping_coords<T>(sparse_tiles, &coords));
+  }
 
   // Sort and dedup the coordinates (not applicable to the global order
   // layout for a single fragment)
   if (!(fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER)) {
+    QueryStatsTimer timer(&stats_.sort_ns_);
     RETURN_NOT_OK(sort_coords<T>(&coords));
     RETURN_NOT_OK(dedup_coords<T>(&coords));
   }
 
-  // Compute the maximal cell ranges
+  // Compute the result cell ranges exactly as a dense read would
+  std::vector<std::vector<DenseCellRangeIter<T>>> dense_frag_its;
+  std::unordered_map<uint64_t, std::pair<uint64_t, std::vector<T>>>
+      overlapping_tile_idx_coords;
+  RETURN_NOT_OK(init_tile_fragment_dense_cell_range_iters(
+      &dense_frag_its, &overlapping_tile_idx_coords));
+  std::list<DenseCellRange<T>> dense_cell_ranges;
+  RETURN_NOT_OK(compute_all_dense_cell_ranges<T>(
+      subarray,
+      overlapping_tile_idx_coords,
+      &dense_frag_its,
+      &dense_cell_ranges));
+  OverlappingTileVec dense_tiles;
   OverlappingCellRangeList cell_ranges;
-  RETURN_NOT_OK(compute_cell_ranges(coords, &cell_ranges));
+  RETURN_NOT_OK(compute_dense_overlapping_tiles_and_cell_ranges<T>(
+      dense_cell_ranges, coords, &dense_tiles, &cell_ranges));
   coords.clear();
+  dense_cell_ranges.clear();
+  overlapping_tile_idx_coords.clear();
 
-  // Copy cells
-  for (const auto& attr : attributes_)
-    RETURN_NOT_OK(copy_cells(attr, cell_ranges));
+  // First pass: whole-tile ranges of a dense fragment with statistics
+  // are answered from the metadata; the rest must scan tile values.
+  // Ranges with no tile correspond to cells no fragment has written
+  // and contribute nothing to the aggregates.
+  auto cell_num_per_tile = array_schema_->domain()->cell_num_per_tile();
+  OverlappingCellRangeList scan_ranges;
+  std::set<const OverlappingTile*> scan_tile_set;
+  OverlappingTileVec scan_tiles;
+  for (const auto& cr : cell_ranges) {
+    if (cr->tile_ == nullptr)
+      continue;
+    state->count_ += cr->end_ - cr->start_ + 1;
+    auto metadata = fragment_metadata_[cr->tile_->fragment_idx_];
+    if (metadata->dense() && cr->start_ == 0 &&
+        cr->end_ == cell_num_per_tile - 1 && metadata->has_tile_stats(attr_id)) {
+      RETURN_NOT_OK(aggregate_tile_stats(
+          attr_id, metadata->tile_stats(attr_id)[cr->tile_->tile_idx_], state));
+      continue;
+    }
+    scan_ranges.emplace_back(cr);
+    // The values of the sparse tiles have been fetched above
+    if (cr->tile_->attr_tiles_.count(attribute) == 0 &&
+        scan_tile_set.insert(cr->tile_.get()).second)
+      scan_tiles.emplace_back(cr->tile_);
+  }
+
+  // Read the values of only the tiles that must be scanned
+  if (!scan_tiles.empty())
+    RETURN_NOT_OK(read_tiles(attribute, &scan_tiles));
+
+  // Second pass: scan the cells of the remaining ranges
+  auto cell_size = array_schema_->cell_size(attr_id);
+  for (const auto& cr : scan_ranges) {
+    const auto& tile = cr->tile_->attr_tiles_.find(attribute)->second.first;
+    auto data = (const unsigned char*)tile->data() + cr->start_ * cell_size;
+    RETURN_NOT_OK(
+        aggregate_cells(attr_id, data, cr->end_ - cr->start_ + 1, state));
+  }
 
-  status_ = QueryStatus::COMPLETED;
   return Status::Ok();
 }
 
 template <class T>
-Status Query::compute_overlapping_tiles(OverlappingTileVec* tiles) const {
-  // For easy reference
-  auto subarray = (T*)subarray_;
-  auto dim_num = array_schema_->dim_num();
-  auto fragment_num = fragment_metadata_.size();
-  bool full_overlap;
-
-  // Find overlapping tile indexes for each fragment
-  tiles->clear();
-  for (unsigned i = 0; i < fragment_num; ++i) {
-    // Applicable only to sparse fragments
-    if (fragment_metadata_[i]->dense())
-      continue;
+Status Query::aggregate_sparse(
+    const std::string& attribute, unsigned attr_id, AggregateState* state) {
+  // Get overlapping tile indexes
+  OverlappingTileVec tiles;
+  {
+    QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+    RETURN_NOT_OK(compute_overlapping_tiles<T>(&tiles));
+  }
 
-    auto mbrs = fragment_metadata_[i]->mbrs();
-    auto mbr_num = (uint64_t)mbrs.size();
-    for (uint64_t j = 0; j < mbr_num; ++j) {
-      if (overlap(&subarray[0], (const T*)(mbrs[j]), dim_num, &full_overlap)) {
-        auto tile = std::make_shared<OverlappingTile>(i, j, full_overlap);
-        tiles->emplace_back(tile);
-      }
+  // In the single-fragment, single-range case there are no overwrites
+  // and no cross-range duplicates, so a tile fully covered by the
+  // subarray contributes all its cells; it is answered from the
+  // metadata statistics with no tile I/O at all
+  auto fragment_num = fragment_metadata_.size();
+  auto single = (fragment_num == 1 && subarrays_ == nullptr);
+  OverlappingTileVec coords_tiles;
+  for (const auto& tile : tiles) {
+    auto metadata = fragment_metadata_[tile->fragment_idx_];
+    if (single && tile->full_overlap_ && metadata->has_tile_stats(attr_id)) {
+      RETURN_NOT_OK(aggregate_tile_stats(
+          attr_id, metadata->tile_stats(attr_id)[tile->tile_idx_], state));
+      state->count_ += metadata->cell_num(tile->tile_idx_);
+    } else {
+      coords_tiles.emplace_back(tile);
     }
   }
+  if (coords_tiles.empty())
+    return Status::Ok();
+
+  // Read the coordinates of the remaining tiles and compute the result
+  // cells, pruning and deduplicating exactly as a sparse read would
+  RETURN_NOT_OK(read_tiles(constants::coords, &coords_tiles));
+  std::list<std::shared_ptr<OverlappingCoords<T>>> coords;
+  {
+    QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+    RETURN_NOT_OK(compute_overlapping_coords<T>(coords_tiles, &coords));
+  }
+  if (!single) {
+    QueryStatsTimer timer(&stats_.sort_ns_);
+    if (fragment_num > 1)
+      RETURN_NOT_OK(prune_overwritten_coords<T>(&coords));
+    RETURN_NOT_OK(sort_coords<T>(&coords));
+    RETURN_NOT_OK(dedup_coords<T>(&coords));
+  }
+  state->count_ += (uint64_t)coords.size();
+
+  // Count the surviving cells of each tile; a tile all of whose cells
+  // survive can still be answered from the statistics
+  std::unordered_map<const OverlappingTile*, uint64_t> survivors;
+  for (const auto& c : coords)
+    ++survivors[c->tile_.get()];
+
+  // Determine the tiles whose values must actually be scanned
+  std::set<const OverlappingTile*> scan_tile_set;
+  OverlappingTileVec scan_tiles;
+  for (const auto& tile : coords_tiles) {
+    auto it = survivors.find(tile.get());
+    if (it == survivors.end())
+      continue;  // The tile contributes no result cells
+    auto metadata = fragment_metadata_[tile->fragment_idx_];
+    if (metadata->has_tile_stats(attr_id) &&
+        it->second == metadata->cell_num(tile->tile_idx_)) {
+      RETURN_NOT_OK(aggregate_tile_stats(
+          attr_id, metadata->tile_stats(attr_id)[tile->tile_idx_], state));
+    } else {
+      scan_tile_set.insert(tile.get());
+      scan_tiles.emplace_back(tile);
+    }
+  }
+
+  // Read the values of only the tiles that must be scanned and
+  // accumulate their surviving cells
+  if (scan_tiles.empty())
+    return Status::Ok();
+  RETURN_NOT_OK(read_tiles(attribute, &scan_tiles));
+  auto cell_size = array_schema_->cell_size(attr_id);
+  for (const auto& c : coords) {
+    if (scan_tile_set.count(c->tile_.get()) == 0)
+      continue;
+    const auto& tile = c->tile_->attr_tiles_.find(attribute)->second.first;
+    auto data = (const unsigned char*)tile->data() + c->pos_ * cell_size;
+    RETURN_NOT_OK(aggregate_cells(attr_id, data, 1, state));
+  }
+
+  return Status::Ok();
+}
+
+Status Query::aggregate_tile_stats(
+    unsigned attr_id,
+    const FragmentMetadata::TileStats& stats,
+    AggregateState* state) {
+  switch (array_schema_->type(attr_id)) {
+    case Datatype::CHAR:
+      aggregate_tile_stats<char, int64_t>(stats, state);
+      break;
+    case Datatype::INT8:
+      aggregate_tile_stats<int8_t, int64_t>(stats, state);
+      break;
+    case Datatype::UINT8:
+      aggregate_tile_stats<uint8_t, uint64_t>(stats, state);
+      break;
+    case Datatype::INT16:
+      aggregate_tile_stats<int16_t, int64_t>(stats, state);
+      break;
+    case Datatype::UINT16:
+      aggregate_tile_stats<uint16_t, uint64_t>(stats, state);
+      break;
+    case Datatype::INT32:
+      aggregate_tile_stats<int, int64_t>(stats, state);
+      break;
+    case Datatype::UINT32:
+      aggregate_tile_stats<unsigned, uint64_t>(stats, state);
+      break;
+    case Datatype::INT64:
+      aggregate_tile_stats<int64_t, int64_t>(stats, state);
+      break;
+    case Datatype::UINT64:
+      aggregate_tile_stats<uint64_t, uint64_t>(stats, state);
+      break;
+    case Datatype::FLOAT32:
+      aggregate_tile_stats<float, double>(stats, state);
+      break;
+    case Datatype::FLOAT64:
+      aggregate_tile_stats<double, double>(stats, state);
+      break;
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot compute aggregate; Unsupported attribute type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T, class SumT>
+void Query::aggregate_tile_stats(
+    const FragmentMetadata::TileStats& stats, AggregateState* state) {
+  state->update_min_max<T>(
+      *(const T*)&stats.min_[0], *(const T*)&stats.max_[0]);
+  SumT sum = 0;
+  std::memcpy(&sum, &stats.sum_, sizeof(SumT));
+  state->add_sum(sum);
+}
+
+Status Query::aggregate_cells(
+    unsigned attr_id,
+    const void* data,
+    uint64_t cell_num,
+    AggregateState* state) {
+  switch (array_schema_->type(attr_id)) {
+    case Datatype::CHAR:
+      aggregate_cells<char, int64_t>(data, cell_num, state);
+      break;
+    case Datatype::INT8:
+      aggregate_cells<int8_t, int64_t>(data, cell_num, state);
+      break;
+    case Datatype::UINT8:
+      aggregate_cells<uint8_t, uint64_t>(data, cell_num, state);
+      break;
+    case Datatype::INT16:
+      aggregate_cells<int16_t, int64_t>(data, cell_num, state);
+      break;
+    case Datatype::UINT16:
+      aggregate_cells<uint16_t, uint64_t>(data, cell_num, state);
+      break;
+    case Datatype::INT32:
+      aggregate_cells<int, int64_t>(data, cell_num, state);
+      break;
+    case Datatype::UINT32:
+      aggregate_cells<unsigned, uint64_t>(data, cell_num, state);
+      break;
+    case Datatype::INT64:
+      aggregate_cells<int64_t, int64_t>(data, cell_num, state);
+      break;
+    case Datatype::UINT64:
+      aggregate_cells<uint64_t, uint64_t>(data, cell_num, state);
+      break;
+    case Datatype::FLOAT32:
+      aggregate_cells<float, double>(data, cell_num, state);
+      break;
+    case Datatype::FLOAT64:
+      aggregate_cells<double, double>(data, cell_num, state);
+      break;
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot compute aggregate; Unsupported attribute type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T, class SumT>
+void Query::aggregate_cells(
+    const void* data, uint64_t cell_num, AggregateState* state) {
+  auto cells = (const T*)data;
+  T min = cells[0];
+  T max = cells[0];
+  SumT sum = 0;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    min = std::min(min, cells[i]);
+    max = std::max(max, cells[i]);
+    sum += (SumT)cells[i];
+  }
+  state->update_min_max<T>(min, max);
+  state->add_sum(sum);
+}
+
+Status Query::apply_predicates(OverlappingCellRangeList* cell_ranges) {
+  if (predicates_.empty())
+    return Status::Ok();
+
+  // Decide once whether the fill cell satisfies the predicates; dense
+  // ranges that no fragment has written are kept or dropped wholesale
+  bool fill_selected = true;
+  for (const auto& pred : predicates_) {
+    uint8_t match = 1;
+    RETURN_NOT_OK(predicate_mask(
+        pred, fill_value(array_schema_->type(pred.attr_id_)), 1, &match));
+    fill_selected &= (match != 0);
+  }
+
+  // First pass: resolve each range from the per-tile statistics where
+  // possible. The statistics bound the values of the whole tile, so
+  // they apply to partial-tile ranges as well: if no value in the tile
+  // can match, the range is dropped, and if every value must match, the
+  // range is kept whole. The rest must be scanned.
+  std::vector<OverlappingCellRangeList::iterator> scan;
+  for (auto it = cell_ranges->begin(); it != cell_ranges->end();) {
+    const auto& cr = *it;
+    if (cr->tile_ == nullptr) {  // Empty (fill) range
+      it = (fill_selected) ? std::next(it) : cell_ranges->erase(it);
+      continue;
+    }
+    auto metadata = fragment_metadata_[cr->tile_->fragment_idx_];
+    bool rejected = false;
+    bool accepted = true;
+    for (const auto& pred : predicates_) {
+      if (!metadata->has_tile_stats(pred.attr_id_)) {
+        accepted = false;
+        continue;
+      }
+      const auto& stats = metadata->tile_stats(pred.attr_id_)[cr->tile_->tile_idx_];
+      bool always_true, maybe_true;
+      RETURN_NOT_OK(predicate_bounds(
+          pred, &stats.min_[0], &stats.max_[0], &always_true, &maybe_true));
+      rejected |= !maybe_true;
+      accepted &= always_true;
+    }
+    if (rejected) {
+      it = cell_ranges->erase(it);
+    } else {
+      if (!accepted)
+        scan.push_back(it);
+      ++it;
+    }
+  }
+
+  if (scan.empty())
+    return Status::Ok();
+
+  // Fetch the tiles of the predicate attributes that the scanned tiles
+  // miss; a predicate may filter on an attribute the query does not
+  // otherwise read
+  {
+    TileFetchList fetches;
+    for (const auto& pred : predicates_) {
+      OverlappingTileVec fetch_tiles;
+      std::set<const OverlappingTile*> seen;
+      for (auto it : scan) {
+        const auto& tile = (*it)->tile_;
+        if (tile->attr_tiles_.find(pred.attribute_) ==
+                tile->attr_tiles_.end() &&
+            seen.insert(tile.get()).second)
+          fetch_tiles.emplace_back(tile);
+      }
+      if (!fetch_tiles.empty())
+        RETURN_NOT_OK(read_tiles(pred.attribute_, &fetch_tiles, &fetches));
+    }
+    RETURN_NOT_OK(wait_tiles(&fetches));
+  }
+
+  // Second pass: evaluate the predicates over each scanned range into a
+  // byte mask and replace the range with the maximal sub-ranges of
+  // selected cells
+  std::vector<uint8_t> mask;
+  for (auto it : scan) {
+    const auto cr = *it;
+    auto cell_num = cr->end_ - cr->start_ + 1;
+    mask.assign(cell_num, 1);
+    for (const auto& pred : predicates_) {
+      const auto& tile =
+          cr->tile_->attr_tiles_.find(pred.attribute_)->second.first;
+      auto data = (const uint8_t*)tile->data() +
+                  cr->start_ * array_schema_->cell_size(pred.attr_id_);
+      RETURN_NOT_OK(predicate_mask(pred, data, cell_num, &mask[0]));
+    }
+    uint64_t i = 0;
+    while (i < cell_num) {
+      if (!mask[i]) {
+        ++i;
+        continue;
+      }
+      uint64_t j = i;
+      while (j + 1 < cell_num && mask[j + 1])
+        ++j;
+      cell_ranges->insert(
+          it,
+          arena_make_shared<OverlappingCellRange>(
+              cr->tile_, cr->start_ + i, cr->start_ + j));
+      i = j + 1;
+    }
+    cell_ranges->erase(it);
+  }
+
+  return Status::Ok();
+}
+
+Status Query::predicate_bounds(
+    const Predicate& pred,
+    const void* min,
+    const void* max,
+    bool* always_true,
+    bool* maybe_true) const {
+  switch (array_schema_->type(pred.attr_id_)) {
+    case Datatype::CHAR:
+      predicate_bounds<char>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::INT8:
+      predicate_bounds<int8_t>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::UINT8:
+      predicate_bounds<uint8_t>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::INT16:
+      predicate_bounds<int16_t>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::UINT16:
+      predicate_bounds<uint16_t>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::INT32:
+      predicate_bounds<int>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::UINT32:
+      predicate_bounds<unsigned>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::INT64:
+      predicate_bounds<int64_t>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::UINT64:
+      predicate_bounds<uint64_t>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::FLOAT32:
+      predicate_bounds<float>(pred, min, max, always_true, maybe_true);
+      break;
+    case Datatype::FLOAT64:
+      predicate_bounds<double>(pred, min, max, always_true, maybe_true);
+      break;
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot evaluate predicate; Unsupported attribute type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+void Query::predicate_bounds(
+    const Predicate& pred,
+    const void* min,
+    const void* max,
+    bool* always_true,
+    bool* maybe_true) const {
+  auto lo = *(const T*)min;
+  auto hi = *(const T*)max;
+  auto v = *(const T*)&pred.value_[0];
+  switch (pred.op_) {
+    case PredicateOp::LT:
+      *always_true = (hi < v);
+      *maybe_true = (lo < v);
+      break;
+    case PredicateOp::LE:
+      *always_true = (hi <= v);
+      *maybe_true = (lo <= v);
+      break;
+    case PredicateOp::GT:
+      *always_true = (lo > v);
+      *maybe_true = (hi > v);
+      break;
+    case PredicateOp::GE:
+      *always_true = (lo >= v);
+      *maybe_true = (hi >= v);
+      break;
+    case PredicateOp::EQ:
+      *always_true = (lo == v && hi == v);
+      *maybe_true = (lo <= v && v <= hi);
+      break;
+    case PredicateOp::NE:
+      *always_true = (v < lo || hi < v);
+      *maybe_true = !(lo == v && hi == v);
+      break;
+    case PredicateOp::BETWEEN: {
+      auto v2 = *(const T*)&pred.value2_[0];
+      *always_true = (v <= lo && hi <= v2);
+      *maybe_true = (v <= hi && lo <= v2);
+      break;
+    }
+    case PredicateOp::IN: {
+      auto values = (const T*)&pred.value_[0];
+      auto value_num = pred.value_.size() / sizeof(T);
+      bool member = false;
+      bool overlap = false;
+      for (uint64_t i = 0; i < value_num; ++i) {
+        member |= (lo == values[i]);
+        overlap |= (lo <= values[i] && values[i] <= hi);
+      }
+      *always_true = (lo == hi && member);
+      *maybe_true = overlap;
+      break;
+    }
+  }
+}
+
+Status Query::predicate_mask(
+    const Predicate& pred,
+    const void* data,
+    uint64_t cell_num,
+    uint8_t* mask) const {
+  switch (array_schema_->type(pred.attr_id_)) {
+    case Datatype::CHAR:
+      predicate_mask<char>(pred, data, cell_num, mask);
+      break;
+    case Datatype::INT8:
+      predicate_mask<int8_t>(pred, data, cell_num, mask);
+      break;
+    case Datatype::UINT8:
+      predicate_mask<uint8_t>(pred, data, cell_num, mask);
+      break;
+    case Datatype::INT16:
+      predicate_mask<int16_t>(pred, data, cell_num, mask);
+      break;
+    case Datatype::UINT16:
+      predicate_mask<uint16_t>(pred, data, cell_num, mask);
+      break;
+    case Datatype::INT32:
+      predicate_mask<int>(pred, data, cell_num, mask);
+      break;
+    case Datatype::UINT32:
+      predicate_mask<unsigned>(pred, data, cell_num, mask);
+      break;
+    case Datatype::INT64:
+      predicate_mask<int64_t>(pred, data, cell_num, mask);
+      break;
+    case Datatype::UINT64:
+      predicate_mask<uint64_t>(pred, data, cell_num, mask);
+      break;
+    case Datatype::FLOAT32:
+      predicate_mask<float>(pred, data, cell_num, mask);
+      break;
+    case Datatype::FLOAT64:
+      predicate_mask<double>(pred, data, cell_num, mask);
+      break;
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot evaluate predicate; Unsupported attribute type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+void Query::predicate_mask(
+    const Predicate& pred,
+    const void* data,
+    uint64_t cell_num,
+    uint8_t* mask) const {
+  auto cells = (const T*)data;
+  auto v = *(const T*)&pred.value_[0];
+  switch (pred.op_) {
+    case PredicateOp::LT:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] < v);
+      break;
+    case PredicateOp::LE:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] <= v);
+      break;
+    case PredicateOp::GT:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] > v);
+      break;
+    case PredicateOp::GE:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] >= v);
+      break;
+    case PredicateOp::EQ:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] == v);
+      break;
+    case PredicateOp::NE:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] != v);
+      break;
+    case PredicateOp::BETWEEN: {
+      auto v2 = *(const T*)&pred.value2_[0];
+      for (uint64_t i = 0; i < cell_num; ++i)
+        mask[i] &= (uint8_t)(cells[i] >= v) & (uint8_t)(cells[i] <= v2);
+      break;
+    }
+    case PredicateOp::IN: {
+      auto values = (const T*)&pred.value_[0];
+      auto value_num = pred.value_.size() / sizeof(T);
+      for (uint64_t i = 0; i < cell_num; ++i) {
+        uint8_t hit = 0;
+        for (uint64_t k = 0; k < value_num; ++k)
+          hit |= (uint8_t)(cells[i] == values[k]);
+        mask[i] &= hit;
+      }
+      break;
+    }
+  }
+}
+
+template <class T>
+Status Query::next_read_partition() {
+  auto budget = storage_manager_->config().sm_params().read_partition_budget_;
+
+  // Pop the front partition, splitting it for as long as its overlapping
+  // tiles are estimated to exceed the budget
+  OverlappingTileVec tiles;
+  std::vector<uint8_t> partition;
+  for (;;) {
+    assert(!read_state_.partitions_.empty());
+    partition = std::move(read_state_.partitions_.front());
+    read_state_.partitions_.pop_front();
+
+    // Get overlapping tile indexes
+    {
+      TRACE_SCOPED_SPAN("query_compute_overlapping_tiles");
+      QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+      RETURN_NOT_OK(compute_overlapping_tiles<T>(
+          &tiles,
+          partition.empty() ? nullptr : (const void*)partition.data()));
+    }
+
+    if (partition.empty() || budget == 0)
+      break;
+    uint64_t est_size;
+    RETURN_NOT_OK(estimate_tiles_size(tiles, &est_size));
+    if (est_size <= budget)
+      break;
+    std::vector<uint8_t> lo, hi;
+    if (!split_read_partition<T>(partition, &lo, &hi))
+      break;  // Cannot split any further; process the partition as is
+    read_state_.partitions_.emplace_front(std::move(hi));
+    read_state_.partitions_.emplace_front(std::move(lo));
+    tiles.clear();
+  }
+  auto range = partition.empty() ? (const T*)nullptr : (const T*)partition.data();
+
+  // Read only the coordinate tiles at this point; the attribute tiles
+  // are deferred until the coordinates prove which tiles contribute
+  // result cells
+  TileFetchList fetches;
+  {
+    TRACE_SCOPED_SPAN("query_read_tiles");
+    RETURN_NOT_OK(read_tiles(constants::coords, &tiles, &fetches));
+    RETURN_NOT_OK(wait_tiles(&fetches));
+    fetches.clear();
+  }
+
+  // Compute the read coordinates for all fragments
+  std::list<std::shared_ptr<OverlappingCoords<T>>> coords;
+  {
+    TRACE_SCOPED_SPAN("query_compute_overlapping_coords");
+    QueryStatsTimer timer(&stats_.compute_overlap_ns_);
+    RETURN_NOT_OK(compute_overlapping_coords<T>(tiles, &coords, range));
+  }
+
+  // Sort and dedup the coordinates (not applicable to the global order
+  // layout for a single fragment). With multiple fragments, the cells
+  // overwritten by newer fragments are pruned first, so that the sort
+  // operates on the live cells only.
+  if (layout_ == Layout::UNORDERED) {
+    // The unordered layout streams the cells grouped by tile, as they
+    // are decompressed, and skips the sort entirely. Cells overwritten
+    // by newer fragments must still be pruned (the pruning pass is
+    // hash-based and does not need sorted input).
+    if (fragment_metadata_.size() > 1) {
+      TRACE_SCOPED_SPAN("query_prune_coords");
+      QueryStatsTimer timer(&stats_.sort_ns_);
+      RETURN_NOT_OK(prune_overwritten_coords<T>(&coords));
+    }
+  } else if (
+      !(fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER)) {
+    TRACE_SCOPED_SPAN("query_sort_coords");
+    QueryStatsTimer timer(&stats_.sort_ns_);
+    if (fragment_metadata_.size() > 1)
+      RETURN_NOT_OK(prune_overwritten_coords<T>(&coords));
+    RETURN_NOT_OK(sort_coords<T>(&coords));
+    RETURN_NOT_OK(dedup_coords<T>(&coords));
+  }
+
+  // Compute the maximal cell ranges
+  RETURN_NOT_OK(compute_cell_ranges(coords, &read_state_.cell_ranges_));
+
+  // Filter the cell ranges through the attribute value predicates
+  RETURN_NOT_OK(apply_predicates(&read_state_.cell_ranges_));
+
+  // Read the attribute tiles of only the tiles that contribute at
+  // least one result cell. For highly selective subarrays this prunes
+  // the fetch and decompression of most overlapping tiles. The pruned
+  // tiles (and their coordinates) are freed when `tiles` goes out of
+  // scope; the contributing ones are kept alive by the cell ranges.
+  std::set<const OverlappingTile*> contributing;
+  for (const auto& cr : read_state_.cell_ranges_) {
+    if (cr->tile_ != nullptr)
+      contributing.insert(cr->tile_.get());
+  }
+  OverlappingTileVec result_tiles;
+  for (const auto& tile : tiles) {
+    if (contributing.count(tile.get()) != 0)
+      result_tiles.emplace_back(tile);
+  }
+  {
+    TRACE_SCOPED_SPAN("query_read_tiles");
+    for (const auto& attr : attributes_) {
+      if (attr == constants::coords)
+        continue;
+      // The predicate pass may have fetched this attribute already for
+      // the tiles it scanned
+      OverlappingTileVec missing;
+      for (const auto& tile : result_tiles) {
+        if (tile->attr_tiles_.find(attr) == tile->attr_tiles_.end())
+          missing.emplace_back(tile);
+      }
+      if (!missing.empty())
+        RETURN_NOT_OK(read_tiles(attr, &missing, &fetches));
+    }
+    RETURN_NOT_OK(wait_tiles(&fetches));
+  }
+
+  read_state_.cur_range_ = read_state_.cell_ranges_.cbegin();
+
+  return Status::Ok();
+}
+
+template <class T>
+bool Query::partition_split_dim(unsigned* dim, T* align) const {
+  // Multi-range subarrays and query-allocated buffers (which are sized
+  // to the exact result of a single submission) are not partitioned
+  if (subarrays_ != nullptr || own_buffers_)
+    return false;
+
+  auto domain = array_schema_->domain();
+  auto dim_num = array_schema_->dim_num();
+  *align = 0;
+
+  // Partitioning a dimension is valid only if the result order within
+  // and across partitions matches the query layout. The unordered
+  // layout imposes no order, so any split dimension is valid.
+  if (layout_ == Layout::UNORDERED || layout_ == Layout::ROW_MAJOR) {
+    *dim = 0;
+    return true;
+  }
+  if (layout_ == Layout::COL_MAJOR) {
+    *dim = dim_num - 1;
+    return true;
+  }
+  if (layout_ == Layout::GLOBAL_ORDER) {
+    // Without tile extents the global order degenerates to the cell
+    // order; otherwise split along the slowest tile order dimension,
+    // aligned to the tile extent so that no space tile is cut
+    auto tile_extents = (const T*)domain->tile_extents();
+    if (tile_extents == nullptr) {
+      if (domain->cell_order() == Layout::ROW_MAJOR)
+        *dim = 0;
+      else if (domain->cell_order() == Layout::COL_MAJOR)
+        *dim = dim_num - 1;
+      else
+        return false;
+      return true;
+    }
+    if (domain->tile_order() == Layout::ROW_MAJOR)
+      *dim = 0;
+    else if (domain->tile_order() == Layout::COL_MAJOR)
+      *dim = dim_num - 1;
+    else
+      return false;
+    *align = tile_extents[*dim];
+    return true;
+  }
+
+  return false;
+}
+
+template <class T>
+bool Query::split_read_partition(
+    const std::vector<uint8_t>& partition,
+    std::vector<uint8_t>* lo,
+    std::vector<uint8_t>* hi) const {
+  unsigned dim;
+  T align;
+  if (!partition_split_dim<T>(&dim, &align))
+    return false;
+
+  auto range = (const T*)partition.data();
+  auto lo_v = range[2 * dim];
+  auto hi_v = range[2 * dim + 1];
+  if (lo_v >= hi_v)
+    return false;
+
+  // The largest value strictly smaller/larger than `v`
+  auto prev_value = [](T v) {
+    return std::is_integral<T>::value ?
+               (T)(v - 1) :
+               (T)std::nextafter(v, std::numeric_limits<T>::lowest());
+  };
+  auto next_value = [](T v) {
+    return std::is_integral<T>::value ?
+               (T)(v + 1) :
+               (T)std::nextafter(v, std::numeric_limits<T>::max());
+  };
+
+  T first_hi, second_lo;
+  if (align != 0) {
+    // Split between space tiles, so that no tile straddles the split
+    auto dim_dom = &((const T*)array_schema_->domain()->domain())[2 * dim];
+    auto t_lo = (uint64_t)((lo_v - dim_dom[0]) / align);
+    auto t_hi = (uint64_t)((hi_v - dim_dom[0]) / align);
+    if (t_lo == t_hi)
+      return false;  // The range covers a single space tile
+    auto t_mid = t_lo + (t_hi - t_lo) / 2;
+    second_lo = (T)(dim_dom[0] + (T)(t_mid + 1) * align);
+    first_hi = prev_value(second_lo);
+  } else {
+    first_hi = (T)(lo_v + (hi_v - lo_v) / 2);
+    if (first_hi >= hi_v)
+      first_hi = prev_value(hi_v);
+    second_lo = next_value(first_hi);
+  }
+
+  *lo = partition;
+  *hi = partition;
+  ((T*)lo->data())[2 * dim + 1] = first_hi;
+  ((T*)hi->data())[2 * dim] = second_lo;
+
+  return true;
+}
+
+Status Query::estimate_tiles_size(
+    const OverlappingTileVec& tiles, uint64_t* size) const {
+  // The attributes the tiles will be fetched for (the coordinates are
+  // always fetched)
+  std::vector<unsigned> attr_ids;
+  for (const auto& attr : attributes_) {
+    unsigned attr_id;
+    RETURN_NOT_OK(array_schema_->attribute_id(attr, &attr_id));
+    attr_ids.push_back(attr_id);
+  }
+
+  // Sum the decompressed tile sizes from the fragment metadata. The
+  // value bytes of var-sized attributes are not included (their sizes
+  // are loaded lazily), so the estimate is a lower bound.
+  *size = 0;
+  for (const auto& tile : tiles) {
+    auto metadata = fragment_metadata_[tile->fragment_idx_];
+    for (auto attr_id : attr_ids)
+      *size += metadata->tile_size(attr_id, tile->tile_idx_);
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::compute_overlapping_tiles(
+    OverlappingTileVec* tiles, const void* partition) const {
+  // For easy reference. A partition (a single range) overrides the
+  // query subarray.
+  auto ranges = (partition != nullptr) ?
+                    (const T*)partition :
+                    ((subarrays_ != nullptr) ? (const T*)subarrays_ :
+                                               (const T*)subarray_);
+  auto range_num =
+      (partition == nullptr && subarrays_ != nullptr) ? subarray_range_num_ : 1;
+  auto dim_num = array_schema_->dim_num();
+  auto fragment_num = fragment_metadata_.size();
+  bool full_overlap;
+
+  // Detect point lookups (every range degenerates to a single coordinate
+  // tuple), so that the fragment Bloom filters can be consulted below
+  std::vector<std::vector<T>> points;
+  bool point_lookup = true;
+  for (uint64_t r = 0; r < range_num && point_lookup; ++r) {
+    auto range = &ranges[r * 2 * dim_num];
+    std::vector<T> point(dim_num);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      if (range[2 * d] != range[2 * d + 1]) {
+        point_lookup = false;
+        break;
+      }
+      point[d] = range[2 * d];
+    }
+    if (point_lookup)
+      points.emplace_back(std::move(point));
+  }
+
+  // Find overlapping tile indexes for each fragment. A tile that overlaps
+  // multiple ranges is recorded (and, hence, later fetched) only once.
+  tiles->clear();
+  for (unsigned i = 0; i < fragment_num; ++i) {
+    // Applicable only to sparse fragments
+    if (fragment_metadata_[i]->dense())
+      continue;
+
+    // Skip fragments whose non-empty domain (the minimum/maximum
+    // coordinates the fragment contains) does not overlap any range, so
+    // that point lookups do not degrade with the number of fragments
+    auto frag_domain = (const T*)fragment_metadata_[i]->non_empty_domain();
+    if (frag_domain != nullptr) {
+      bool frag_overlaps = false;
+      for (uint64_t r = 0; r < range_num && !frag_overlaps; ++r)
+        frag_overlaps =
+            overlap(&ranges[r * 2 * dim_num], frag_domain, dim_num, &full_overlap);
+      if (!frag_overlaps)
+        continue;
+    }
+
+    // Consult the fragment Bloom filter on point lookups, so that
+    // fragments that definitely do not contain any of the looked-up
+    // points incur no tile I/O at all
+    if (point_lookup) {
+      bool maybe_contains = false;
+      for (uint64_t r = 0; r < range_num && !maybe_contains; ++r)
+        maybe_contains =
+            fragment_metadata_[i]->maybe_contains_coords(&points[r][0]);
+      if (!maybe_contains)
+        continue;
+    }
+
+    // Maps an overlapping tile index to its full overlap flag. A tile
+    // fully covered by any single range is a full overlap.
+    std::map<uint64_t, bool> overlap_map;
+    auto mbrs = fragment_metadata_[i]->mbrs();
+    auto mbr_num = (uint64_t)mbrs.size();
+    auto rtree = fragment_metadata_[i]->rtree();
+    for (uint64_t r = 0; r < range_num; ++r) {
+      auto range = &ranges[r * 2 * dim_num];
+      if (rtree->leaf_num() == mbr_num && mbr_num > 0) {
+        // Traverse the R-tree instead of scanning the MBRs linearly
+        std::vector<std::pair<uint64_t, bool>> result;
+        RETURN_NOT_OK(rtree->get_overlapping_tiles(range, &result));
+        for (const auto& res : result)
+          overlap_map[res.first] |= res.second;
+      } else {  // No R-tree available - scan the MBRs linearly
+        for (uint64_t j = 0; j < mbr_num; ++j) {
+          if (overlap(range, (const T*)(mbrs[j]), dim_num, &full_overlap))
+            overlap_map[j] |= full_overlap;
+        }
+      }
+    }
+
+    // Emit the overlapping tiles in ascending tile order
+    for (const auto& it : overlap_map)
+      tiles->emplace_back(
+          arena_make_shared<OverlappingTile>(i, it.first, it.second));
+  }
 
   return Status::Ok();
 }
@@ -658,7 +2033,7 @@ Status Query::compute_dense_overlapping_tiles_and_cell_ranges(
   if (cr_it->fragment_idx_ != -1) {
     auto tile_idx = fragment_metadata_[cr_it->fragment_idx_]->get_tile_pos(
         cr_it->tile_coords_);
-    cur_tile = std::make_shared<OverlappingTile>(
+    cur_tile = arena_make_shared<OverlappingTile>(
         (unsigned)cr_it->fragment_idx_, tile_idx);
     tile_coords_map[std::pair<unsigned, const T*>(
         (unsigned)cr_it->fragment_idx_, cr_it->tile_coords_)] =
@@ -697,7 +2072,7 @@ Status Query::compute_dense_overlapping_tiles_and_cell_ranges(
       } else {
         auto tile_idx = fragment_metadata_[cr_it->fragment_idx_]->get_tile_pos(
             cr_it->tile_coords_);
-        tile = std::make_shared<OverlappingTile>(
+        tile = arena_make_shared<OverlappingTile>(
             (unsigned)cr_it->fragment_idx_, tile_idx);
         tile_coords_map[std::pair<unsigned, const T*>(
             (unsigned)cr_it->fragment_idx_, cr_it->tile_coords_)] =
@@ -731,12 +2106,12 @@ Status Query::compute_dense_overlapping_tiles_and_cell_ranges(
         // Left range
         if (coords_pos > start) {
           overlapping_cell_ranges->emplace_back(
-              std::make_shared<OverlappingCellRange>(
+              arena_make_shared<OverlappingCellRange>(
                   cur_tile, start, coords_pos - 1));
         }
         // Coords unary range
         overlapping_cell_ranges->emplace_back(
-            std::make_shared<OverlappingCellRange>(
+            arena_make_shared<OverlappingCellRange>(
                 coords_tile, coords_it->get()->pos_, coords_it->get()->pos_));
         // Update start
         start = coords_pos + 1;
@@ -757,7 +2132,7 @@ Status Query::compute_dense_overlapping_tiles_and_cell_ranges(
     // Push remaining range to the result
     if (start <= end)
       overlapping_cell_ranges->emplace_back(
-          std::make_shared<OverlappingCellRange>(cur_tile, start, end));
+          arena_make_shared<OverlappingCellRange>(cur_tile, start, end));
 
     // Update state
     cur_tile = tile;
@@ -786,12 +2161,12 @@ Status Query::compute_dense_overlapping_tiles_and_cell_ranges(
       // Left range
       if (coords_pos > start) {
         overlapping_cell_ranges->emplace_back(
-            std::make_shared<OverlappingCellRange>(
+            arena_make_shared<OverlappingCellRange>(
                 cur_tile, start, coords_pos - 1));
       }
       // Coords unary range
       overlapping_cell_ranges->emplace_back(
-          std::make_shared<OverlappingCellRange>(
+          arena_make_shared<OverlappingCellRange>(
               coords_tile, coords_it->get()->pos_, coords_it->get()->pos_));
       // Update start
       start = coords_pos + 1;
@@ -812,13 +2187,22 @@ Status Query::compute_dense_overlapping_tiles_and_cell_ranges(
   // Push remaining range to the result
   if (start <= end)
     overlapping_cell_ranges->emplace_back(
-        std::make_shared<OverlappingCellRange>(cur_tile, start, end));
+        arena_make_shared<OverlappingCellRange>(cur_tile, start, end));
 
   return Status::Ok();
 }
 
 Status Query::read_tiles(
     const std::string& attr_name, OverlappingTileVec* tiles) const {
+  TileFetchList fetches;
+  RETURN_NOT_OK(read_tiles(attr_name, tiles, &fetches));
+  return wait_tiles(&fetches);
+}
+
+Status Query::read_tiles(
+    const std::string& attr_name,
+    OverlappingTileVec* tiles,
+    TileFetchList* fetches) const {
   // Prepare tile IO
   unsigned attr_id;
   RETURN_NOT_OK(array_schema_->attribute_id(attr_name, &attr_id));
@@ -826,40 +2210,109 @@ Status Query::read_tiles(
   std::vector<std::shared_ptr<TileIO>> tile_io;
   std::vector<std::shared_ptr<TileIO>> tile_io_var;
   for (const auto& f : fragment_metadata_) {
+    // Materialize the tile offsets of this attribute, if this is the
+    // first query to touch it
+    RETURN_NOT_OK(f->load_tile_offsets(attr_id));
     tile_io.emplace_back(std::make_shared<TileIO>(
         storage_manager_, f->attr_uri(attr_id), f->file_sizes(attr_id)));
-    if (var_size)
+    tile_io.back()->set_cache_hint(cache_hint_);
+    if (var_size) {
       tile_io_var.emplace_back(std::make_shared<TileIO>(
           storage_manager_,
           f->attr_var_uri(attr_id),
           f->file_var_sizes(attr_id)));
-    else
+      tile_io_var.back()->set_cache_hint(cache_hint_);
+    } else {
       tile_io_var.emplace_back();
+    }
   }
   bool is_coords = (attr_id == array_schema_->attribute_num());
+  bool offsets_32 =
+      var_size && array_schema_->attribute(attr_id)->offsets_32();
+  auto memory_budget = storage_manager_->memory_budget();
+
+  // The fetches whose I/O has not been issued yet - they are issued in
+  // batches so that physically contiguous tiles can be merged into
+  // single reads
+  TileFetchList pending;
+
+  // Batch-resolve the fetch info (file offset and sizes) of all the
+  // tiles with one metadata pass per fragment, instead of three offset
+  // lookups per tile
+  auto fragment_num = fragment_metadata_.size();
+  std::vector<std::vector<uint64_t>> frag_tile_indices(fragment_num);
+  for (auto& tile : *tiles)
+    frag_tile_indices[tile->fragment_idx_].push_back(tile->tile_idx_);
+  std::vector<std::vector<FragmentMetadata::TileFetchInfo>> frag_info(
+      fragment_num);
+  std::vector<std::vector<FragmentMetadata::TileFetchInfo>> frag_info_var(
+      fragment_num);
+  for (size_t f = 0; f < fragment_num; ++f) {
+    if (frag_tile_indices[f].empty())
+      continue;
+    fragment_metadata_[f]->tile_fetch_info(
+        attr_id, frag_tile_indices[f], &frag_info[f]);
+    if (var_size)
+      fragment_metadata_[f]->tile_var_fetch_info(
+          attr_id, frag_tile_indices[f], &frag_info_var[f]);
+  }
+  std::vector<uint64_t> frag_pos(fragment_num, 0);
 
-  // For each fragment, read the tiles
+  // Issue asynchronous reads for the raw bytes of all tiles, so that
+  // fetching runs ahead of decompression.
   for (auto& tile : *tiles) {
     auto& tile_pair = tile->attr_tiles_[attr_name];
 
-    // Fixed-sized or offsets tile
+    // Fixed-sized or offsets tile. The offsets of 32-bit offsets tiles
+    // are stored narrowed on disk and widened to 64 bits once read.
     auto t = std::make_shared<Tile>();
-    RETURN_NOT_OK(t->init(
-        (var_size) ? constants::cell_var_offset_type :
-                     array_schema_->type(attr_id),
-        (var_size) ? array_schema_->cell_var_offsets_compression() :
-                     array_schema_->compression(attr_id),
-        (var_size) ? constants::cell_var_offset_size :
-                     array_schema_->cell_size(attr_id),
-        (is_coords) ? array_schema_->dim_num() : 0));
-    RETURN_NOT_OK(tile_io[tile->fragment_idx_]->read(
-        t.get(),
-        fragment_metadata_[tile->fragment_idx_]->file_offset(
-            attr_id, tile->tile_idx_),
-        fragment_metadata_[tile->fragment_idx_]->compressed_tile_size(
-            attr_id, tile->tile_idx_),
-        fragment_metadata_[tile->fragment_idx_]->tile_size(
-            attr_id, tile->tile_idx_)));
+    if (offsets_32) {
+      RETURN_NOT_OK(t->init(
+          Datatype::UINT32,
+          array_schema_->cell_var_offsets_compression(),
+          sizeof(uint32_t),
+          0));
+      t->set_offsets_32(true);
+    } else {
+      RETURN_NOT_OK(t->init(
+          (var_size) ? constants::cell_var_offset_type :
+                       array_schema_->type(attr_id),
+          (var_size) ? array_schema_->cell_var_offsets_compression() :
+                       array_schema_->compression(attr_id),
+          (var_size) ? constants::cell_var_offset_size :
+                       array_schema_->cell_size(attr_id),
+          (is_coords) ? array_schema_->dim_num() : 0));
+    }
+    auto fetch = std::make_shared<TileFetch>();
+    fetch->io_ = tile_io[tile->fragment_idx_];
+    fetch->tile_ = t;
+    auto& info =
+        frag_info[tile->fragment_idx_][frag_pos[tile->fragment_idx_]];
+    fetch->file_offset_ = info.file_offset_;
+    fetch->tile_size_ = info.tile_size_;
+    auto compressed_size = info.compressed_size_;
+    fetch->compressed_size_ = compressed_size;
+
+    // Charge the tile and its transient compressed buffer against the
+    // memory budget. If the budget is hit, drain the in-flight fetches
+    // first, so that the tiles are processed in bounded batches.
+    if (!memory_budget->try_charge(fetch->tile_size_ + compressed_size)) {
+      if (!fetches->empty()) {
+        RETURN_NOT_OK(issue_tile_fetches(&pending));
+        RETURN_NOT_OK(wait_tiles(fetches));
+        fetches->clear();
+      }
+      // A single tile may exceed the remaining budget; proceed regardless
+      if (!memory_budget->try_charge(fetch->tile_size_ + compressed_size))
+        memory_budget->charge(fetch->tile_size_ + compressed_size);
+    }
+    fetch->charged_ = compressed_size;
+    tile_mem_charged_ += fetch->tile_size_;
+
+    fetch->compressed_ =
+        storage_manager_->buffer_pool()->checkout_shared(compressed_size);
+    pending.push_back(fetch);
+    fetches->push_back(fetch);
     tile_pair.first = t;
 
     // Var-sized tile
@@ -870,88 +2323,556 @@ Status Query::read_tiles(
           array_schema_->compression(attr_id),
           datatype_size(array_schema_->type(attr_id)),
           0));
-      RETURN_NOT_OK(tile_io_var[tile->fragment_idx_]->read(
-          t_var.get(),
-          fragment_metadata_[tile->fragment_idx_]->file_var_offset(
-              attr_id, tile->tile_idx_),
-          fragment_metadata_[tile->fragment_idx_]->compressed_tile_var_size(
-              attr_id, tile->tile_idx_),
-          fragment_metadata_[tile->fragment_idx_]->tile_var_size(
-              attr_id, tile->tile_idx_)));
+      auto fetch_var = std::make_shared<TileFetch>();
+      fetch_var->io_ = tile_io_var[tile->fragment_idx_];
+      fetch_var->tile_ = t_var;
+      auto& info_var =
+          frag_info_var[tile->fragment_idx_][frag_pos[tile->fragment_idx_]];
+      fetch_var->file_offset_ = info_var.file_offset_;
+      fetch_var->tile_size_ = info_var.tile_size_;
+      auto compressed_var_size = info_var.compressed_size_;
+      fetch_var->compressed_size_ = compressed_var_size;
+
+      if (!memory_budget->try_charge(
+              fetch_var->tile_size_ + compressed_var_size)) {
+        if (!fetches->empty()) {
+          RETURN_NOT_OK(issue_tile_fetches(&pending));
+          RETURN_NOT_OK(wait_tiles(fetches));
+          fetches->clear();
+        }
+        if (!memory_budget->try_charge(
+                fetch_var->tile_size_ + compressed_var_size))
+          memory_budget->charge(fetch_var->tile_size_ + compressed_var_size);
+      }
+      fetch_var->charged_ = compressed_var_size;
+      tile_mem_charged_ += fetch_var->tile_size_;
+
+      fetch_var->compressed_ =
+          storage_manager_->buffer_pool()->checkout_shared(compressed_var_size);
+      pending.push_back(fetch_var);
+      fetches->push_back(fetch_var);
       tile_pair.second = t_var;
     }
+
+    ++frag_pos[tile->fragment_idx_];
+  }
+
+  return issue_tile_fetches(&pending);
+}
+
+Status Query::issue_tile_fetches(TileFetchList* pending) const {
+  if (pending->empty())
+    return Status::Ok();
+
+  // Sort the fetches by file and offset, so that physically contiguous
+  // tiles become adjacent
+  std::vector<std::shared_ptr<TileFetch>> sorted(
+      pending->begin(), pending->end());
+  std::sort(
+      sorted.begin(),
+      sorted.end(),
+      [](const std::shared_ptr<TileFetch>& a,
+         const std::shared_ptr<TileFetch>& b) {
+        if (a->io_.get() != b->io_.get())
+          return a->io_.get() < b->io_.get();
+        return a->file_offset_ < b->file_offset_;
+      });
+
+  // Identify the tiles already present in the tile cache. They are
+  // excluded from the merged runs and served through the cache-aware
+  // per-tile path instead.
+  std::vector<bool> cached(sorted.size(), false);
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    std::shared_ptr<void> cached_object;
+    uint64_t cached_size;
+    bool in_cache;
+    RETURN_NOT_OK(storage_manager_->read_shared_from_cache(
+        sorted[i]->io_->uri(),
+        sorted[i]->file_offset_,
+        &cached_object,
+        &cached_size,
+        &in_cache));
+    cached[i] = in_cache;
+  }
+
+  size_t i = 0;
+  while (i < sorted.size()) {
+    // Extend the run of physically contiguous non-cached tiles of the
+    // same file starting at `i` as far as possible
+    size_t j = i;
+    if (!cached[i]) {
+      while (j + 1 < sorted.size() && !cached[j + 1] &&
+             sorted[j + 1]->io_.get() == sorted[j]->io_.get() &&
+             sorted[j + 1]->file_offset_ ==
+                 sorted[j]->file_offset_ + sorted[j]->compressed_size_)
+        ++j;
+    }
+
+    // Cached or isolated tile - issue it through the per-tile path,
+    // which probes the cache and coordinates concurrent fetches
+    if (j == i) {
+      auto& f = sorted[i];
+      f->fetched_ = f->io_->read_compressed_async(
+          f->tile_.get(),
+          f->file_offset_,
+          f->compressed_size_,
+          f->tile_size_,
+          f->compressed_.get(),
+          &f->decompress_,
+          &stats_);
+      ++i;
+      continue;
+    }
+
+    // Merge the run into a single read, splitting the returned bytes
+    // back into the per-tile buffers. This converts many small random
+    // reads into one large sequential read (a single GET on S3).
+    std::vector<std::shared_ptr<TileFetch>> run(
+        sorted.begin() + i, sorted.begin() + j + 1);
+    uint64_t run_offset = run.front()->file_offset_;
+    uint64_t run_nbytes =
+        run.back()->file_offset_ + run.back()->compressed_size_ - run_offset;
+    auto task = storage_manager_->io_thread_pool()->enqueue(
+        [this, run, run_offset, run_nbytes]() {
+          auto combined =
+              storage_manager_->buffer_pool()->checkout_shared(run_nbytes);
+          RETURN_NOT_OK(storage_manager_->read(
+              run.front()->io_->uri(), run_offset, combined.get(), run_nbytes));
+          Status st = Status::Ok();
+          for (const auto& f : run) {
+            f->compressed_->reset_size();
+            f->compressed_->reset_offset();
+            auto tile_st = f->compressed_->write(
+                combined->data(f->file_offset_ - run_offset),
+                f->compressed_size_);
+            if (tile_st.ok())
+              tile_st = f->io_->read_prefetched(
+                  f->tile_.get(),
+                  f->file_offset_,
+                  f->tile_size_,
+                  f->compressed_.get(),
+                  &f->decompress_,
+                  &stats_);
+            if (!tile_st.ok() && st.ok())
+              st = tile_st;
+          }
+          return st;
+        });
+
+    // A single merged read completes all the fetches of the run
+    auto fetched = task.share();
+    for (const auto& f : run)
+      f->fetched_ = fetched;
+    i = j + 1;
   }
 
+  pending->clear();
   return Status::Ok();
 }
 
+Status Query::wait_tiles(TileFetchList* fetches) const {
+  // As each fetch completes, fan its decompression out to the compute
+  // thread pool. The fetches of later tiles overlap with the
+  // decompression of the current one.
+  auto thread_pool = storage_manager_->compute_thread_pool();
+  auto memory_budget = storage_manager_->memory_budget();
+  uint64_t per_query_cap =
+      storage_manager_->config().sm_params().concurrency_params_.per_query_cap_;
+  std::vector<std::future<Status>> decompress_tasks;
+  Status st = Status::Ok();
+  for (auto& fetch : *fetches) {
+    auto fetch_st = fetch->fetched_.get();
+    if (!fetch_st.ok()) {
+      if (st.ok())
+        st = fetch_st;
+      if (fetch->charged_ > 0)
+        memory_budget->release(fetch->charged_);
+      continue;
+    }
+    if (!fetch->decompress_ && fetch->charged_ > 0)
+      memory_budget->release(fetch->charged_);
+    if (fetch->decompress_) {
+      // Bound the number of in-flight decompression tasks if a per-query
+      // parallelism cap is configured
+      if (per_query_cap > 0 && decompress_tasks.size() >= per_query_cap) {
+        if (!thread_pool->wait_all(decompress_tasks) && st.ok())
+          st = LOG_STATUS(Status::QueryError(
+              "Cannot read tiles; Tile decompression failed"));
+        decompress_tasks.clear();
+      }
+      decompress_tasks.push_back(
+          thread_pool->enqueue([this, fetch, memory_budget]() {
+            auto decompress_st = fetch->io_->decompress_and_cache(
+                fetch->tile_.get(),
+                fetch->file_offset_,
+                fetch->tile_size_,
+                fetch->compressed_.get(),
+                &stats_);
+            // The compressed buffer is no longer needed
+            if (fetch->charged_ > 0)
+              memory_budget->release(fetch->charged_);
+            return decompress_st;
+          }));
+    }
+  }
+
+  // Wait for all decompression tasks to complete
+  if (!thread_pool->wait_all(decompress_tasks) && st.ok())
+    st = LOG_STATUS(
+        Status::QueryError("Cannot read tiles; Tile decompression failed"));
+
+  return st;
+}
+
 template <class T>
 Status Query::compute_overlapping_coords(
     const OverlappingTileVec& tiles,
-    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
-  for (const auto& tile : tiles) {
+    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords,
+    const T* partition) const {
+  auto tile_num = tiles.size();
+  if (tile_num == 0)
+    return Status::Ok();
+
+  // Single tile - no need to involve the thread pool
+  if (tile_num == 1) {
+    const auto& tile = tiles[0];
     std::list<std::shared_ptr<OverlappingCoords<T>>> tile_coords;
     if (tile.get()->full_overlap_) {
       RETURN_NOT_OK(get_all_coords<T>(tile, &tile_coords));
     } else {
-      RETURN_NOT_OK(compute_overlapping_coords<T>(tile, &tile_coords));
+      RETURN_NOT_OK(compute_overlapping_coords<T>(tile, &tile_coords, partition));
     }
     coords->splice(coords->end(), tile_coords);
+    return Status::Ok();
   }
 
+  // Each tile's computation is independent - run the tiles as thread
+  // pool tasks producing per-tile lists, spliced in tile order at the end
+  auto thread_pool = storage_manager_->compute_thread_pool();
+  std::vector<std::list<std::shared_ptr<OverlappingCoords<T>>>> tile_coords(
+      tile_num);
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(tile_num);
+  for (size_t i = 0; i < tile_num; ++i) {
+    tasks.push_back(
+        thread_pool->enqueue([this, &tiles, &tile_coords, i, partition]() {
+          const auto& tile = tiles[i];
+          if (tile.get()->full_overlap_)
+            return get_all_coords<T>(tile, &tile_coords[i]);
+          return compute_overlapping_coords<T>(tile, &tile_coords[i], partition);
+        }));
+  }
+  if (!thread_pool->wait_all(tasks))
+    return LOG_STATUS(Status::QueryError(
+        "Cannot compute overlapping coordinates; Tile task failed"));
+
+  for (auto& tc : tile_coords)
+    coords->splice(coords->end(), tc);
+
   return Status::Ok();
 }
 
 template <class T>
 Status Query::compute_overlapping_coords(
     const std::shared_ptr<OverlappingTile>& tile,
-    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
+    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords,
+    const T* partition) const {
   auto dim_num = array_schema_->dim_num();
   const auto t = tile->attr_tiles_.find(constants::coords)->second.first;
   auto t_ptr = t.get();
   auto coords_num = t_ptr->cell_num();
-  auto subarray = (T*)subarray_;
-  auto c = (T*)t_ptr->data();
+  auto ranges = (partition != nullptr) ?
+                    partition :
+                    ((subarrays_ != nullptr) ? (const T*)subarrays_ :
+                                               (const T*)subarray_);
+  auto range_num =
+      (partition == nullptr && subarrays_ != nullptr) ? subarray_range_num_ : 1;
+
+  // Unzipped tiles are checked one dimension stream at a time, with
+  // contiguous branchless loops that the compiler vectorizes. The
+  // zipped view is materialized only if any cell survives, so tiles
+  // with no results never pay for re-interleaving the coordinates.
+  if (t_ptr->unzipped_coords()) {
+    auto c = (const T*)t_ptr->data();
+    std::vector<uint8_t> mask(coords_num, 0);
+    std::vector<uint8_t> range_mask;
+    for (uint64_t r = 0; r < range_num; ++r) {
+      auto range = &ranges[r * 2 * dim_num];
+      range_mask.assign(coords_num, 1);
+      for (unsigned d = 0; d < dim_num; ++d) {
+        auto dim_c = c + d * coords_num;
+        auto lo = range[2 * d];
+        auto hi = range[2 * d + 1];
+        for (uint64_t i = 0; i < coords_num; ++i)
+          range_mask[i] &=
+              (uint8_t)(dim_c[i] >= lo) & (uint8_t)(dim_c[i] <= hi);
+      }
+      for (uint64_t i = 0; i < coords_num; ++i)
+        mask[i] |= range_mask[i];
+    }
+    uint64_t result_num = 0;
+    for (uint64_t i = 0; i < coords_num; ++i)
+      result_num += mask[i];
+    if (result_num == 0)
+      return Status::Ok();
+    auto zipped = (const T*)tile_coords(tile);
+    for (uint64_t i = 0; i < coords_num; ++i) {
+      if (mask[i])
+        coords->emplace_back(arena_make_shared<OverlappingCoords<T>>(
+            tile, &zipped[i * dim_num], i));
+    }
+    return Status::Ok();
+  }
 
+  // A cell is a result if it falls in any of the subarray ranges. It is
+  // appended only once, no matter how many ranges contain it.
+  auto c = (T*)t_ptr->data();
   for (uint64_t i = 0, pos = 0; i < coords_num; ++i, pos += dim_num) {
-    if (utils::coords_in_rect<T>(&c[pos], &subarray[0], dim_num))
-      coords->emplace_back(
-          std::make_shared<OverlappingCoords<T>>(tile, &c[pos], i));
+    for (uint64_t r = 0; r < range_num; ++r) {
+      if (utils::coords_in_rect<T>(
+              &c[pos], &ranges[r * 2 * dim_num], dim_num)) {
+        coords->emplace_back(
+            arena_make_shared<OverlappingCoords<T>>(tile, &c[pos], i));
+        break;
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Query::get_all_coords(
+    const std::shared_ptr<OverlappingTile>& tile,
+    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
+  auto dim_num = array_schema_->dim_num();
+  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
+  auto t_ptr = t.get();
+  auto coords_num = t_ptr->cell_num();
+  auto c = (const T*)((t_ptr->unzipped_coords()) ?
+                          tile_coords(tile) :
+                          (const unsigned char*)t_ptr->data());
+
+  for (uint64_t i = 0; i < coords_num; ++i)
+    coords->emplace_back(
+        arena_make_shared<OverlappingCoords<T>>(tile, &c[i * dim_num], i));
+
+  return Status::Ok();
+}
+
+const unsigned char* Query::tile_coords(
+    const std::shared_ptr<OverlappingTile>& tile) const {
+  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
+  auto t_ptr = t.get();
+  if (!t_ptr->unzipped_coords())
+    return (const unsigned char*)t_ptr->data();
+
+  // Zip into the per-tile view, leaving the (possibly shared) tile
+  // buffer untouched
+  if (tile->zipped_coords_.empty()) {
+    auto dim_num = array_schema_->dim_num();
+    auto cell_num = t_ptr->cell_num();
+    auto coord_size = t_ptr->cell_size() / dim_num;
+    auto src = (const unsigned char*)t_ptr->data();
+    tile->zipped_coords_.resize(cell_num * dim_num * coord_size);
+    auto dest = &tile->zipped_coords_[0];
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto src_dim = src + d * cell_num * coord_size;
+      for (uint64_t i = 0; i < cell_num; ++i)
+        std::memcpy(
+            dest + (i * dim_num + d) * coord_size,
+            src_dim + i * coord_size,
+            coord_size);
+    }
+  }
+
+  return &tile->zipped_coords_[0];
+}
+
+template <class T>
+Status Query::sort_coords(
+    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
+  // Bind the dimensionality once per sort for the common low-dimensional
+  // cases, so that the per-dimension comparator loops get unrolled
+  switch (array_schema_->dim_num()) {
+    case 1:
+      return sort_coords_fixed_dim<T, 1>(coords);
+    case 2:
+      return sort_coords_fixed_dim<T, 2>(coords);
+    case 3:
+      return sort_coords_fixed_dim<T, 3>(coords);
+    case 4:
+      return sort_coords_fixed_dim<T, 4>(coords);
+    default:
+      return sort_coords_fixed_dim<T, 0>(coords);
+  }
+}
+
+template <class T, unsigned DIM>
+Status Query::sort_coords_fixed_dim(
+    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
+  if (layout_ == Layout::GLOBAL_ORDER) {
+    auto domain = array_schema_->domain();
+    coords->sort(GlobalCmp<T, DIM>(domain));
+  } else {
+    // Prefer the radix key-based path, falling back to the comparators
+    if (can_sort_coords_with_keys<T>())
+      return sort_coords_with_keys<T>(coords);
+    auto dim_num = array_schema_->dim_num();
+    if (layout_ == Layout::ROW_MAJOR)
+      coords->sort(RowCmp<T, DIM>(dim_num));
+    else if (layout_ == Layout::COL_MAJOR)
+      coords->sort(ColCmp<T, DIM>(dim_num));
   }
 
   return Status::Ok();
 }
 
-template <class T>
-Status Query::get_all_coords(
-    const std::shared_ptr<OverlappingTile>& tile,
-    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
-  auto dim_num = array_schema_->dim_num();
-  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
-  auto t_ptr = t.get();
-  auto coords_num = t_ptr->cell_num();
-  auto c = (T*)t_ptr->data();
+template <class T>
+bool Query::can_sort_coords_with_keys() const {
+  // Key packing applies only to integer coordinates
+  if (!std::is_integral<T>::value)
+    return false;
+
+  // Only the row-/col-major layouts map to plain lexicographic key order
+  if (layout_ != Layout::ROW_MAJOR && layout_ != Layout::COL_MAJOR)
+    return false;
+
+  // All dimensions must fit in a 128-bit key
+  return array_schema_->dim_num() * sizeof(T) * 8 <= 128;
+}
+
+template <class T>
+Status Query::sort_coords_with_keys(
+    std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
+  auto dim_num = array_schema_->dim_num();
+  auto dim_bits = (unsigned)(sizeof(T) * 8);
+
+  // Mask that truncates a coordinate value to its type width, and the
+  // bit to flip so that signed values compare correctly as unsigned.
+  const uint64_t mask =
+      (dim_bits == 64) ? ~uint64_t(0) : ((uint64_t(1) << dim_bits) - 1);
+  const uint64_t sign_bit =
+      std::is_signed<T>::value ? (uint64_t(1) << (dim_bits - 1)) : 0;
+
+  // Snapshot the coordinates
+  std::vector<std::shared_ptr<OverlappingCoords<T>>> coords_vec(
+      coords->begin(), coords->end());
+  auto coords_num = (uint64_t)coords_vec.size();
+
+  // Narrow coordinates: pack each one into a single 64-bit key,
+  // interleaving the dimensions in comparison order.
+  if (dim_num * dim_bits <= 64) {
+    std::vector<std::pair<uint64_t, uint64_t>> key_pos(coords_num);
+    for (uint64_t i = 0; i < coords_num; ++i) {
+      auto c = coords_vec[i]->coords_;
+      uint64_t key = 0;
+      if (layout_ == Layout::ROW_MAJOR) {
+        for (unsigned d = 0; d < dim_num; ++d)
+          key = (key << (dim_num > 1 ? dim_bits : 0)) |
+                ((((uint64_t)c[d]) & mask) ^ sign_bit);
+      } else {  // COL_MAJOR
+        for (unsigned d = dim_num - 1;; --d) {
+          key = (key << (dim_num > 1 ? dim_bits : 0)) |
+                ((((uint64_t)c[d]) & mask) ^ sign_bit);
+          if (d == 0)
+            break;
+        }
+      }
+      key_pos[i] = std::make_pair(key, i);
+    }
+
+    // Sort the keys with a parallel radix sort (stable, so ties keep
+    // their original, i.e., fragment, order).
+    radix_sort::sort_pairs(storage_manager_->compute_thread_pool(), &key_pos);
+
+    // Rebuild the coordinates list in sorted order
+    coords->clear();
+    for (uint64_t i = 0; i < coords_num; ++i)
+      coords->push_back(coords_vec[key_pos[i].second]);
+
+    return Status::Ok();
+  }
+
+  // Wide coordinates: pack each one into a two-word big-endian key,
+  // carrying the original position as a tie-breaking tail. The position
+  // preserves the fragment order of ties (the input is grouped by
+  // ascending fragment), so a non-stable sort yields the stable result.
+  struct WideKey {
+    uint64_t hi_;
+    uint64_t lo_;
+    uint64_t pos_;
+  };
+  std::vector<WideKey> keys(coords_num);
+  for (uint64_t i = 0; i < coords_num; ++i) {
+    auto c = coords_vec[i]->coords_;
+    uint64_t hi = 0, lo = 0;
+    if (layout_ == Layout::ROW_MAJOR) {
+      for (unsigned d = 0; d < dim_num; ++d) {
+        auto v = (((uint64_t)c[d]) & mask) ^ sign_bit;
+        if (dim_bits == 64) {
+          hi = lo;
+          lo = v;
+        } else {
+          hi = (hi << dim_bits) | (lo >> (64 - dim_bits));
+          lo = (lo << dim_bits) | v;
+        }
+      }
+    } else {  // COL_MAJOR
+      for (unsigned d = dim_num - 1;; --d) {
+        auto v = (((uint64_t)c[d]) & mask) ^ sign_bit;
+        if (dim_bits == 64) {
+          hi = lo;
+          lo = v;
+        } else {
+          hi = (hi << dim_bits) | (lo >> (64 - dim_bits));
+          lo = (lo << dim_bits) | v;
+        }
+        if (d == 0)
+          break;
+      }
+    }
+    keys[i].hi_ = hi;
+    keys[i].lo_ = lo;
+    keys[i].pos_ = i;
+  }
 
+  // Each comparison is three integer compares, no per-dimension loop
+  std::sort(keys.begin(), keys.end(), [](const WideKey& a, const WideKey& b) {
+    if (a.hi_ != b.hi_)
+      return a.hi_ < b.hi_;
+    if (a.lo_ != b.lo_)
+      return a.lo_ < b.lo_;
+    return a.pos_ < b.pos_;
+  });
+
+  // Rebuild the coordinates list in sorted order
+  coords->clear();
   for (uint64_t i = 0; i < coords_num; ++i)
-    coords->emplace_back(
-        std::make_shared<OverlappingCoords<T>>(tile, &c[i * dim_num], i));
+    coords->push_back(coords_vec[keys[i].pos_]);
 
   return Status::Ok();
 }
 
 template <class T>
-Status Query::sort_coords(
+Status Query::prune_overwritten_coords(
     std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const {
-  if (layout_ == Layout::GLOBAL_ORDER) {
-    auto domain = array_schema_->domain();
-    coords->sort(GlobalCmp<T>(domain));
-  } else {
-    auto dim_num = array_schema_->dim_num();
-    if (layout_ == Layout::ROW_MAJOR)
-      coords->sort(RowCmp<T>(dim_num));
-    else if (layout_ == Layout::COL_MAJOR)
-      coords->sort(ColCmp<T>(dim_num));
+  auto coords_size = array_schema_->coords_size();
+
+  // The coordinates list is grouped by tile in ascending fragment order,
+  // so a backwards pass visits the newest fragment's cells first. A cell
+  // survives only if its coordinates have not been seen in a newer
+  // fragment; survivors are re-linked in their original order.
+  std::unordered_set<std::string> seen;
+  seen.reserve(coords->size());
+  std::list<std::shared_ptr<OverlappingCoords<T>>> pruned;
+  for (auto it = coords->rbegin(); it != coords->rend(); ++it) {
+    auto inserted =
+        seen.emplace((const char*)it->get()->coords_, coords_size).second;
+    if (inserted)
+      pruned.emplace_front(*it);
   }
+  coords->swap(pruned);
 
   return Status::Ok();
 }
@@ -988,31 +2909,95 @@ Status Query::compute_cell_ranges(
   if (coords_num == 0)
     return Status::Ok();
 
-  // Initialize the first range
-  auto it = coords.begin();
-  uint64_t start_pos = it->get()->pos_;
-  uint64_t end_pos = start_pos;
-  auto tile = it->get()->tile_;
-
-  // Scan the coordinates and compute ranges
-  for (++it; it != coords.end(); ++it) {
-    if (it->get()->tile_.get() == tile.get() &&
-        it->get()->pos_ == end_pos + 1) {
-      // Same range - advance end position
-      end_pos = it->get()->pos_;
-    } else {
-      // New range - append previous range
-      cell_ranges->emplace_back(
-          std::make_shared<OverlappingCellRange>(tile, start_pos, end_pos));
-      start_pos = it->get()->pos_;
-      end_pos = start_pos;
-      tile = it->get()->tile_;
+  // Small inputs are scanned serially
+  auto thread_pool = storage_manager_->compute_thread_pool();
+  auto chunk_num = std::min((uint64_t)thread_pool->num_threads(), coords_num);
+  if (chunk_num <= 1 || coords_num < 1024) {
+    // Initialize the first range
+    auto it = coords.begin();
+    uint64_t start_pos = it->get()->pos_;
+    uint64_t end_pos = start_pos;
+    auto tile = it->get()->tile_;
+
+    // Scan the coordinates and compute ranges
+    for (++it; it != coords.end(); ++it) {
+      if (it->get()->tile_.get() == tile.get() &&
+          it->get()->pos_ == end_pos + 1) {
+        // Same range - advance end position
+        end_pos = it->get()->pos_;
+      } else {
+        // New range - append previous range
+        cell_ranges->emplace_back(
+            arena_make_shared<OverlappingCellRange>(tile, start_pos, end_pos));
+        start_pos = it->get()->pos_;
+        end_pos = start_pos;
+        tile = it->get()->tile_;
+      }
     }
+
+    // Append the last range
+    cell_ranges->emplace_back(
+        arena_make_shared<OverlappingCellRange>(tile, start_pos, end_pos));
+
+    return Status::Ok();
   }
 
-  // Append the last range
-  cell_ranges->emplace_back(
-      std::make_shared<OverlappingCellRange>(tile, start_pos, end_pos));
+  // Snapshot the coordinates for random-access chunking
+  std::vector<const OverlappingCoords<T>*> cv;
+  cv.reserve(coords_num);
+  for (const auto& c : coords)
+    cv.push_back(c.get());
+
+  // Scan the chunks in parallel, each producing its own range list
+  std::vector<OverlappingCellRangeList> chunk_ranges(chunk_num);
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(chunk_num);
+  for (uint64_t ch = 0; ch < chunk_num; ++ch) {
+    uint64_t chunk_start = ch * coords_num / chunk_num;
+    uint64_t chunk_end = (ch + 1) * coords_num / chunk_num;
+    tasks.push_back(thread_pool->enqueue(
+        [this, &cv, &chunk_ranges, ch, chunk_start, chunk_end]() {
+          auto& ranges = chunk_ranges[ch];
+          uint64_t start_pos = cv[chunk_start]->pos_;
+          uint64_t end_pos = start_pos;
+          auto tile = cv[chunk_start]->tile_;
+          for (uint64_t i = chunk_start + 1; i < chunk_end; ++i) {
+            if (cv[i]->tile_.get() == tile.get() &&
+                cv[i]->pos_ == end_pos + 1) {
+              // Same range - advance end position
+              end_pos = cv[i]->pos_;
+            } else {
+              // New range - append previous range
+              ranges.emplace_back(arena_make_shared<OverlappingCellRange>(
+                  tile, start_pos, end_pos));
+              start_pos = cv[i]->pos_;
+              end_pos = start_pos;
+              tile = cv[i]->tile_;
+            }
+          }
+          ranges.emplace_back(arena_make_shared<OverlappingCellRange>(
+              tile, start_pos, end_pos));
+          return Status::Ok();
+        }));
+  }
+  if (!thread_pool->wait_all(tasks))
+    return LOG_STATUS(
+        Status::QueryError("Cannot compute cell ranges; Chunk task failed"));
+
+  // Stitch the chunks together, merging a range that continues across
+  // a chunk boundary into a single range
+  for (auto& ranges : chunk_ranges) {
+    if (!cell_ranges->empty() && !ranges.empty()) {
+      auto& last = cell_ranges->back();
+      auto& first = ranges.front();
+      if (first->tile_.get() == last->tile_.get() &&
+          first->start_ == last->end_ + 1) {
+        last->end_ = first->end_;
+        ranges.pop_front();
+      }
+    }
+    cell_ranges->splice(cell_ranges->end(), ranges);
+  }
 
   return Status::Ok();
 }
@@ -1038,7 +3023,7 @@ bool Query::overlap(
 
 Status Query::copy_cells(
     const std::string& attribute,
-    const OverlappingCellRangeList& cell_ranges) const {
+    const OverlappingCellRangeList& cell_ranges) {
   unsigned attr_id;
   RETURN_NOT_OK(array_schema_->attribute_id(attribute, &attr_id));
   if (array_schema_->var_size(attr_id))
@@ -1061,22 +3046,43 @@ Status Query::buffer_idx(const std::string& attribute, unsigned* bid) const {
       attribute + "'");
 }
 
+void** Query::buffers() const {
+  return buffers_;
+}
+
+uint64_t* Query::buffer_sizes() const {
+  return buffer_sizes_;
+}
+
 Status Query::copy_fixed_cells(
     const std::string& attribute,
-    const OverlappingCellRangeList& cell_ranges) const {
-  // For easy reference
+    const OverlappingCellRangeList& cell_ranges) {
+  // For easy reference. The copy appends after the bytes the current
+  // submission has already copied (from previous subarray partitions).
   unsigned attr_id, bid;
   RETURN_NOT_OK(array_schema_->attribute_id(attribute, &attr_id));
   RETURN_NOT_OK(buffer_idx(attribute, &bid));
   auto buffer = (unsigned char*)buffers_[bid];
-  uint64_t buffer_offset = 0;
+  uint64_t buffer_offset = read_state_.copy_offsets_[bid];
   auto cell_size = array_schema_->cell_size(attr_id);
   auto type = array_schema_->type(attr_id);
   auto fill_size = datatype_size(type);
   auto fill_value = this->fill_value(type);
   assert(fill_value != nullptr);
-
-  // Copy cells
+  auto fill_byte = fill_pattern_byte(fill_value, fill_size);
+
+  // A single copy operation: a contiguous source region (or a fill
+  // region, if `src_` is `nullptr`) copied to a destination offset
+  struct CopyOp {
+    const unsigned char* src_;
+    uint64_t dest_offset_;
+    uint64_t nbytes_;
+  };
+
+  // Compute the destination offset of each cell range, coalescing
+  // ranges that are adjacent in both the source and the destination
+  // into a single wide copy
+  std::vector<CopyOp> ops;
   for (const auto& cr : cell_ranges) {
     // Check for overflow
     auto bytes_to_copy = (cr->end_ - cr->start_ + 1) * cell_size;
@@ -1085,47 +3091,135 @@ Status Query::copy_fixed_cells(
           std::string("Cannot copy cells for attribute '") + attribute +
           "'; Result buffer overflowed"));
 
-    // Copy
-    if (cr->tile_ == nullptr) {  // Empty range
-      auto fill_num = bytes_to_copy / fill_size;
-      for (uint64_t i = 0; i < fill_num; ++i) {
-        std::memcpy(buffer + buffer_offset, fill_value, fill_size);
-        buffer_offset += fill_size;
-      }
-    } else {  // Non-empty range
+    auto src = (const unsigned char*)nullptr;
+    if (cr->tile_ != nullptr) {  // Non-empty range
       const auto& tile = cr->tile_->attr_tiles_.find(attribute)->second.first;
-      auto data = (unsigned char*)tile->data();
-      std::memcpy(
-          buffer + buffer_offset, data + cr->start_ * cell_size, bytes_to_copy);
-      buffer_offset += bytes_to_copy;
+      // Unzipped coordinate tiles are copied from their zipped view
+      auto data = (tile->unzipped_coords()) ?
+                      tile_coords(cr->tile_) :
+                      (const unsigned char*)tile->data();
+      src = data + cr->start_ * cell_size;
+    }
+
+    bool coalesced = false;
+    if (!ops.empty()) {
+      auto& prev = ops.back();
+      // Coalesce if both ranges are fill ranges, or the new source
+      // starts right after the previous one
+      if ((src == nullptr && prev.src_ == nullptr) ||
+          (src != nullptr && prev.src_ != nullptr &&
+           prev.src_ + prev.nbytes_ == src)) {
+        prev.nbytes_ += bytes_to_copy;
+        coalesced = true;
+      }
+    }
+    if (!coalesced)
+      ops.push_back({src, buffer_offset, bytes_to_copy});
+
+    buffer_offset += bytes_to_copy;
+  }
+
+  // Performs a single copy operation. Copies above the streaming store
+  // threshold bypass the cache, as the destination is written once and
+  // never read back by the library.
+  auto nt_threshold =
+      storage_manager_->config().sm_params().streaming_store_threshold_;
+  auto do_copy = [buffer, fill_value, fill_size, fill_byte, nt_threshold](
+                     const CopyOp& op) {
+    auto dest = buffer + op.dest_offset_;
+    if (op.src_ != nullptr) {
+      if (nt_threshold != 0 && op.nbytes_ >= nt_threshold)
+        utils::memcpy_streaming(dest, op.src_, op.nbytes_);
+      else
+        std::memcpy(dest, op.src_, op.nbytes_);
+    } else if (fill_byte >= 0) {
+      // The fill pattern is a single repeated byte (e.g. the all-ones
+      // integer fill values), so the region reduces to one wide memset
+      std::memset(dest, fill_byte, op.nbytes_);
+    } else {
+      // Write the fill value once, then double the initialized region
+      // with wide copies until the fill region is covered
+      std::memcpy(dest, fill_value, fill_size);
+      uint64_t filled = fill_size;
+      while (filled < op.nbytes_) {
+        auto to_copy = std::min(filled, op.nbytes_ - filled);
+        std::memcpy(dest + filled, dest, to_copy);
+        filled += to_copy;
+      }
+    }
+  };
+
+  // Execute the copies, parallelizing over the disjoint destination
+  // regions on the compute thread pool
+  auto pool = storage_manager_->compute_thread_pool();
+  uint64_t op_num = ops.size();
+  uint64_t task_num = std::min<uint64_t>(pool->num_threads(), op_num);
+  if (task_num <= 1) {
+    for (const auto& op : ops)
+      do_copy(op);
+  } else {
+    std::vector<std::future<Status>> tasks;
+    uint64_t ops_per_task = op_num / task_num;
+    uint64_t remainder = op_num % task_num;
+    uint64_t start = 0;
+    for (uint64_t t = 0; t < task_num; ++t) {
+      uint64_t end = start + ops_per_task + ((t < remainder) ? 1 : 0);
+      tasks.push_back(pool->enqueue([&ops, &do_copy, start, end]() {
+        for (uint64_t i = start; i < end; ++i)
+          do_copy(ops[i]);
+        return Status::Ok();
+      }));
+      start = end;
     }
+    if (!pool->wait_all(tasks))
+      return LOG_STATUS(Status::QueryError(
+          std::string("Cannot copy cells for attribute '") + attribute +
+          "'; Copy tasks failed"));
   }
 
-  // Update buffer sizes
-  buffer_sizes_[bid] = buffer_offset;
+  // Update the copy offsets; `buffer_sizes_` is set when the
+  // submission ends
+  read_state_.copy_offsets_[bid] = buffer_offset;
 
   return Status::Ok();
 }
 
 Status Query::copy_var_cells(
     const std::string& attribute,
-    const OverlappingCellRangeList& cell_ranges) const {
-  // For easy reference
+    const OverlappingCellRangeList& cell_ranges) {
+  // For easy reference. The copy appends after the bytes the current
+  // submission has already copied (from previous subarray partitions).
   unsigned attr_id, bid;
   RETURN_NOT_OK(array_schema_->attribute_id(attribute, &attr_id));
   RETURN_NOT_OK(buffer_idx(attribute, &bid));
   auto buffer = (unsigned char*)buffers_[bid];
   auto buffer_var = (unsigned char*)buffers_[bid + 1];
-  uint64_t buffer_offset = 0;
-  uint64_t buffer_var_offset = 0;
+  uint64_t buffer_offset = read_state_.copy_offsets_[bid];
+  uint64_t buffer_var_offset = read_state_.copy_offsets_[bid + 1];
   uint64_t offset_size = constants::cell_var_offset_size;
-  uint64_t cell_var_size;
   auto type = array_schema_->type(attr_id);
   auto fill_size = datatype_size(type);
   auto fill_value = this->fill_value(type);
   assert(fill_value != nullptr);
-
-  // Copy cells
+  auto fill_byte = fill_pattern_byte(fill_value, fill_size);
+
+  // A single scatter operation, covering one cell range
+  struct VarCopyOp {
+    const uint64_t* offsets_;    // Source tile offsets (nullptr: fill range)
+    const unsigned char* data_;  // Source tile values
+    uint64_t start_;
+    uint64_t end_;
+    uint64_t dest_offset_;      // Destination in the offsets buffer
+    uint64_t dest_var_offset_;  // Destination in the values buffer
+    uint64_t var_bytes_;        // Total value bytes in the range
+  };
+
+  // Prefix-sum pass: compute the destination offsets of each range in
+  // both result buffers. The total value size of a range follows
+  // directly from the source tile offsets, since the values of a cell
+  // range are contiguous in the source tile.
+  std::vector<VarCopyOp> ops;
+  ops.reserve(cell_ranges.size());
   for (const auto& cr : cell_ranges) {
     auto cell_num_in_range = cr->end_ - cr->start_ + 1;
     // Check if offset buffers can fit the result
@@ -1134,69 +3228,305 @@ Status Query::copy_var_cells(
           std::string("Cannot copy cell offsets for var-sized attribute '") +
           attribute + "'; Result buffer overflow"));
 
-    // Handle empty range
-    if (cr->tile_ == nullptr) {
-      // Check if result can fit in the buffer
-      if (buffer_var_offset + cell_num_in_range * fill_size >
-          buffer_sizes_[bid + 1])
-        return LOG_STATUS(Status::QueryError(
-            std::string("Cannot copy cell data for var-sized attribute '") +
-            attribute + "'; Result buffer overflowed"));
-
-      // Fill with empty
-      for (auto i = cr->start_; i <= cr->end_; ++i) {
-        // Offsets
-        std::memcpy(buffer + buffer_offset, &buffer_var_offset, offset_size);
-        buffer_offset += offset_size;
-
-        // Values
-        std::memcpy(buffer_var + buffer_var_offset, fill_value, fill_size);
-        buffer_var_offset += fill_size;
+    VarCopyOp op = {
+        nullptr, nullptr, cr->start_, cr->end_, buffer_offset,
+        buffer_var_offset, 0};
+    if (cr->tile_ == nullptr) {  // Empty range
+      op.var_bytes_ = cell_num_in_range * fill_size;
+    } else {  // Non-empty range
+      const auto& tile_pair = cr->tile_->attr_tiles_.find(attribute)->second;
+      const auto& tile = tile_pair.first;
+      const auto& tile_var = tile_pair.second;
+      op.offsets_ = (uint64_t*)tile->data();
+      op.data_ = (unsigned char*)tile_var->data();
+      auto cell_num = tile->cell_num();
+      op.var_bytes_ = ((cr->end_ == cell_num - 1) ?
+                           tile_var->size() + op.offsets_[0] :
+                           op.offsets_[cr->end_ + 1]) -
+                      op.offsets_[cr->start_];
+    }
+
+    // Check if the values can fit in the result buffer
+    if (buffer_var_offset + op.var_bytes_ > buffer_sizes_[bid + 1])
+      return LOG_STATUS(Status::QueryError(
+          std::string("Cannot copy cell data for var-sized attribute '") +
+          attribute + "'; Result buffer overflowed"));
+
+    buffer_offset += cell_num_in_range * offset_size;
+    buffer_var_offset += op.var_bytes_;
+    ops.push_back(op);
+  }
+
+  // Performs a single scatter operation: writes the destination offset
+  // of every cell in the range and copies the range values with one
+  // wide copy
+  auto do_copy = [buffer, buffer_var, offset_size, fill_value, fill_size,
+                  fill_byte](const VarCopyOp& op) {
+    auto dest_offs = buffer + op.dest_offset_;
+    auto dest_var = buffer_var + op.dest_var_offset_;
+    auto cell_num_in_range = op.end_ - op.start_ + 1;
+    if (op.offsets_ == nullptr) {  // Fill range
+      for (uint64_t i = 0; i < cell_num_in_range; ++i) {
+        uint64_t offset = op.dest_var_offset_ + i * fill_size;
+        std::memcpy(dest_offs + i * offset_size, &offset, offset_size);
+      }
+      if (fill_byte >= 0) {
+        // Single repeated byte fill pattern: one wide memset
+        std::memset(dest_var, fill_byte, op.var_bytes_);
+      } else {
+        // Write the fill value once, then double the initialized region
+        std::memcpy(dest_var, fill_value, fill_size);
+        uint64_t filled = fill_size;
+        while (filled < op.var_bytes_) {
+          auto to_copy = std::min(filled, op.var_bytes_ - filled);
+          std::memcpy(dest_var + filled, dest_var, to_copy);
+          filled += to_copy;
+        }
       }
+    } else {  // Non-empty range
+      auto base = op.offsets_[op.start_];
+      for (uint64_t i = 0; i < cell_num_in_range; ++i) {
+        uint64_t offset =
+            op.dest_var_offset_ + (op.offsets_[op.start_ + i] - base);
+        std::memcpy(dest_offs + i * offset_size, &offset, offset_size);
+      }
+      std::memcpy(dest_var, op.data_ + (base - op.offsets_[0]), op.var_bytes_);
+    }
+  };
+
+  // Scatter pass: execute the copies, parallelizing over the disjoint
+  // destination regions on the compute thread pool
+  auto pool = storage_manager_->compute_thread_pool();
+  uint64_t op_num = ops.size();
+  uint64_t task_num = std::min<uint64_t>(pool->num_threads(), op_num);
+  if (task_num <= 1) {
+    for (const auto& op : ops)
+      do_copy(op);
+  } else {
+    std::vector<std::future<Status>> tasks;
+    uint64_t ops_per_task = op_num / task_num;
+    uint64_t remainder = op_num % task_num;
+    uint64_t start = 0;
+    for (uint64_t t = 0; t < task_num; ++t) {
+      uint64_t end = start + ops_per_task + ((t < remainder) ? 1 : 0);
+      tasks.push_back(pool->enqueue([&ops, &do_copy, start, end]() {
+        for (uint64_t i = start; i < end; ++i)
+          do_copy(ops[i]);
+        return Status::Ok();
+      }));
+      start = end;
+    }
+    if (!pool->wait_all(tasks))
+      return LOG_STATUS(Status::QueryError(
+          std::string("Cannot copy cells for var-sized attribute '") +
+          attribute + "'; Copy tasks failed"));
+  }
 
-      continue;
+  // Update the copy offsets; `buffer_sizes_` is set when the
+  // submission ends
+  read_state_.copy_offsets_[bid] = buffer_offset;
+  read_state_.copy_offsets_[bid + 1] = buffer_var_offset;
+
+  return Status::Ok();
+}
+
+Status Query::copy_cells_batch() {
+  // In query-allocated mode, size the result buffers to the exact
+  // remaining result first, so that the copy completes in one batch
+  if (own_buffers_)
+    RETURN_NOT_OK(alloc_owned_buffers());
+
+  // Compute the longest prefix of the remaining cell ranges that fits
+  // in the result buffers of all attributes
+  OverlappingCellRangeList::const_iterator batch_end;
+  RETURN_NOT_OK(compute_copy_batch(&batch_end));
+
+  // Copy the batch for all attributes
+  OverlappingCellRangeList batch(read_state_.cur_range_, batch_end);
+  for (const auto& attr : attributes_)
+    RETURN_NOT_OK(copy_cells(attr, batch));
+  read_state_.cur_range_ = batch_end;
+
+  // If the current subarray partition is exhausted but more partitions
+  // remain, release its tiles and let the caller process the next one
+  if (read_state_.cur_range_ == read_state_.cell_ranges_.cend() &&
+      !read_state_.partitions_.empty()) {
+    read_state_.cell_ranges_.clear();
+    read_state_.cur_range_ = read_state_.cell_ranges_.cend();
+    arena_.clear();
+    status_ = QueryStatus::INPROGRESS;
+
+    // Incremental delivery: the copied prefix of the user buffers is
+    // final, so expose its sizes and notify the progress callback
+    // before the next partition is processed
+    if (progress_callback_ != nullptr) {
+      for (unsigned i = 0; i < buffer_num_; ++i)
+        buffer_sizes_[i] = read_state_.copy_offsets_[i];
+      progress_callback_(progress_callback_data_);
     }
 
-    // Non-empty range
-    const auto& tile_pair = cr->tile_->attr_tiles_.find(attribute)->second;
-    const auto& tile = tile_pair.first;
-    const auto& tile_var = tile_pair.second;
-    const auto offsets = (uint64_t*)tile->data();
-    auto data = (unsigned char*)tile_var->data();
-    auto cell_num = tile->cell_num();
-    auto tile_var_size = tile_var->size();
+    return Status::Ok();
+  }
+
+  // The submission ends here; expose the copied sizes to the user
+  for (unsigned i = 0; i < buffer_num_; ++i)
+    buffer_sizes_[i] = read_state_.copy_offsets_[i];
+
+  // The query is incomplete if cell ranges remain; a follow-up
+  // submission will resume from the current range
+  if (read_state_.cur_range_ != read_state_.cell_ranges_.cend()) {
+    status_ = QueryStatus::INCOMPLETE;
+  } else {
+    reset_read_state();
+    status_ = QueryStatus::COMPLETED;
+  }
+
+  return Status::Ok();
+}
 
-    for (auto i = cr->start_; i <= cr->end_; ++i) {
-      // Copy offsets
-      std::memcpy(buffer + buffer_offset, &buffer_var_offset, offset_size);
-      buffer_offset += offset_size;
+Status Query::compute_copy_batch(
+    OverlappingCellRangeList::const_iterator* batch_end) const {
+  // Compute the remaining capacity of each attribute buffer
+  struct AttrCapacity {
+    bool var_size_;
+    uint64_t cell_size_;  // The fixed cell size, or the fill size
+    uint64_t left_;       // Bytes left in the fixed/offsets buffer
+    uint64_t var_left_;   // Bytes left in the var-sized values buffer
+  };
+  std::vector<AttrCapacity> capacities;
+  capacities.reserve(attributes_.size());
+  for (const auto& attr : attributes_) {
+    unsigned attr_id, bid;
+    RETURN_NOT_OK(array_schema_->attribute_id(attr, &attr_id));
+    RETURN_NOT_OK(buffer_idx(attr, &bid));
+    AttrCapacity c;
+    c.var_size_ = array_schema_->var_size(attr_id);
+    c.cell_size_ = (c.var_size_) ? datatype_size(array_schema_->type(attr_id)) :
+                                   array_schema_->cell_size(attr_id);
+    c.left_ = buffer_sizes_[bid] - read_state_.copy_offsets_[bid];
+    c.var_left_ = (c.var_size_) ?
+                      buffer_sizes_[bid + 1] - read_state_.copy_offsets_[bid + 1] :
+                      0;
+    capacities.push_back(c);
+  }
 
-      // Check if next variable-sized cell fits in the result buffer
-      cell_var_size = (i != cell_num - 1) ?
-                          offsets[i + 1] - offsets[i] :
-                          tile_var_size - (offsets[i] - offsets[0]);
+  // Advance over whole cell ranges for as long as they fit in the
+  // buffers of all attributes
+  auto attribute_num = attributes_.size();
+  std::vector<uint64_t> needed(attribute_num);
+  std::vector<uint64_t> var_needed(attribute_num);
+  auto it = read_state_.cur_range_;
+  auto end = read_state_.cell_ranges_.cend();
+  for (; it != end; ++it) {
+    const auto& cr = *it;
+    auto cell_num_in_range = cr->end_ - cr->start_ + 1;
+    bool fits = true;
+    for (size_t i = 0; i < attribute_num && fits; ++i) {
+      const auto& c = capacities[i];
+      if (!c.var_size_) {
+        needed[i] = cell_num_in_range * c.cell_size_;
+        fits = (needed[i] <= c.left_);
+      } else {
+        needed[i] = cell_num_in_range * constants::cell_var_offset_size;
+        if (cr->tile_ == nullptr) {  // Empty range
+          var_needed[i] = cell_num_in_range * c.cell_size_;
+        } else {  // Non-empty range
+          const auto& tile_pair =
+              cr->tile_->attr_tiles_.find(attributes_[i])->second;
+          const auto& tile = tile_pair.first;
+          const auto& tile_var = tile_pair.second;
+          auto offsets = (uint64_t*)tile->data();
+          auto cell_num = tile->cell_num();
+          var_needed[i] = ((cr->end_ == cell_num - 1) ?
+                               tile_var->size() + offsets[0] :
+                               offsets[cr->end_ + 1]) -
+                          offsets[cr->start_];
+        }
+        fits = (needed[i] <= c.left_) && (var_needed[i] <= c.var_left_);
+      }
+    }
+    if (!fits)
+      break;
 
-      if (buffer_var_offset + cell_var_size > buffer_sizes_[bid + 1])
-        return LOG_STATUS(Status::QueryError(
-            std::string("Cannot copy cell data for var-sized attribute '") +
-            attribute + "'; Result buffer overflowed"));
+    // Charge the range against the capacities
+    for (size_t i = 0; i < attribute_num; ++i) {
+      capacities[i].left_ -= needed[i];
+      if (capacities[i].var_size_)
+        capacities[i].var_left_ -= var_needed[i];
+    }
+  }
 
-      // Copy variable-sized values
-      std::memcpy(
-          buffer_var + buffer_var_offset,
-          &data[offsets[i] - offsets[0]],
-          cell_var_size);
-      buffer_var_offset += cell_var_size;
+  // Not even a single cell range fits
+  if (it == read_state_.cur_range_ && it != end)
+    return LOG_STATUS(
+        Status::QueryError("Cannot copy cells; Result buffers are too small "
+                           "to fit a single cell range"));
+
+  *batch_end = it;
+  return Status::Ok();
+}
+
+Status Query::alloc_owned_buffers() {
+  // Compute the exact result size of every buffer over the remaining
+  // cell ranges. Empty ranges produce fill values; the value bytes of a
+  // var-sized range follow from the source tile offsets, since the
+  // values of a cell range are contiguous in the source tile.
+  std::vector<uint64_t> needed(buffer_num_, 0);
+  auto end = read_state_.cell_ranges_.cend();
+  for (const auto& attr : attributes_) {
+    unsigned attr_id, bid;
+    RETURN_NOT_OK(array_schema_->attribute_id(attr, &attr_id));
+    RETURN_NOT_OK(buffer_idx(attr, &bid));
+    auto var_size = array_schema_->var_size(attr_id);
+    auto cell_size = (var_size) ? datatype_size(array_schema_->type(attr_id)) :
+                                  array_schema_->cell_size(attr_id);
+    for (auto it = read_state_.cur_range_; it != end; ++it) {
+      const auto& cr = *it;
+      auto cell_num_in_range = cr->end_ - cr->start_ + 1;
+      if (!var_size) {
+        needed[bid] += cell_num_in_range * cell_size;
+        continue;
+      }
+      needed[bid] += cell_num_in_range * constants::cell_var_offset_size;
+      if (cr->tile_ == nullptr) {  // Empty range
+        needed[bid + 1] += cell_num_in_range * cell_size;
+      } else {  // Non-empty range
+        const auto& tile_pair = cr->tile_->attr_tiles_.find(attr)->second;
+        const auto& tile = tile_pair.first;
+        const auto& tile_var = tile_pair.second;
+        auto offsets = (uint64_t*)tile->data();
+        auto cell_num = tile->cell_num();
+        needed[bid + 1] += ((cr->end_ == cell_num - 1) ?
+                                tile_var->size() + offsets[0] :
+                                offsets[cr->end_ + 1]) -
+                           offsets[cr->start_];
+      }
     }
   }
 
-  // Update buffer sizes
-  buffer_sizes_[bid] = buffer_offset;
-  buffer_sizes_[bid + 1] = buffer_var_offset;
+  // (Re)allocate the owned buffers and expose them to the copy machinery
+  for (unsigned i = 0; i < buffer_num_; ++i) {
+    if (needed[i] > 0)
+      RETURN_NOT_OK(owned_buffers_[i]->realloc(needed[i]));
+    owned_buffers_[i]->set_size(needed[i]);
+    owned_buffer_ptrs_[i] = owned_buffers_[i]->data();
+    owned_buffer_sizes_[i] = needed[i];
+  }
 
   return Status::Ok();
 }
 
+void Query::reset_read_state() {
+  read_state_.initialized_ = false;
+  read_state_.cell_ranges_.clear();
+  read_state_.cur_range_ = read_state_.cell_ranges_.cend();
+  read_state_.partitions_.clear();
+
+  // With the cell ranges gone, all the temporary read structures of the
+  // previous computation can be reclaimed in one shot
+  arena_.clear();
+}
+
 Status Query::read() {
   // Check attributes
   RETURN_NOT_OK(check_attributes());
@@ -1212,6 +3542,7 @@ Status Query::read() {
   }
 
   status_ = QueryStatus::INPROGRESS;
+  read_state_.copy_offsets_.assign(buffer_num_, 0);
 
   // Perform dense or sparse read
   if (array_schema_->dense())
@@ -1219,6 +3550,20 @@ Status Query::read() {
   return sparse_read();
 }
 
+Status Query::reset(const void* subarray) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(
+        Status::QueryError("Cannot reset query; Applicable only to reads"));
+  if (status_ == QueryStatus::INPROGRESS)
+    return LOG_STATUS(
+        Status::QueryError("Cannot reset query; Query is in progress"));
+
+  // Retain the open fragments, the loaded fragment metadata, and the
+  // attribute/buffer bindings; `set_subarray` invalidates the read state
+  // and the next submission re-runs the (cheap, idempotent) `init`
+  return set_subarray(subarray);
+}
+
 void Query::set_array_schema(const ArraySchema* array_schema) {
   array_schema_ = array_schema;
   if (array_schema->is_kv())
@@ -1275,12 +3620,71 @@ void Query::set_buffers(void** buffers, uint64_t* buffer_sizes) {
   buffer_sizes_ = buffer_sizes;
 }
 
+Status Query::set_alloc_buffers(
+    const char** attributes, unsigned int attribute_num) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set query-allocated buffers; Applicable only to reads"));
+
+  RETURN_NOT_OK(set_attributes(attributes, attribute_num));
+  RETURN_NOT_OK(array_schema_->buffer_num(attribute_ids_, &buffer_num_));
+
+  // Create the owned buffers empty; they are sized to the exact result
+  // once the result cell ranges are known
+  own_buffers_ = true;
+  owned_buffers_.clear();
+  for (unsigned i = 0; i < buffer_num_; ++i)
+    owned_buffers_.emplace_back(std::make_shared<Buffer>());
+  owned_buffer_ptrs_.assign(buffer_num_, nullptr);
+  owned_buffer_sizes_.assign(buffer_num_, 0);
+  buffers_ = &owned_buffer_ptrs_[0];
+  buffer_sizes_ = &owned_buffer_sizes_[0];
+
+  return Status::Ok();
+}
+
+Status Query::result_buffer(
+    const char* attribute,
+    std::shared_ptr<Buffer>* buffer,
+    std::shared_ptr<Buffer>* buffer_var) const {
+  if (!own_buffers_)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot get result buffer; Query does not own its result buffers"));
+  if (status_ != QueryStatus::COMPLETED)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot get result buffer; Query has not completed"));
+
+  unsigned attr_id, bid;
+  RETURN_NOT_OK(array_schema_->attribute_id(attribute, &attr_id));
+  RETURN_NOT_OK(buffer_idx(attribute, &bid));
+  *buffer = owned_buffers_[bid];
+  *buffer_var = (array_schema_->var_size(attr_id)) ? owned_buffers_[bid + 1] :
+                                                     nullptr;
+
+  return Status::Ok();
+}
+
 void Query::set_callback(
     const std::function<void(void*)>& callback, void* callback_data) {
   callback_ = callback;
   callback_data_ = callback_data;
 }
 
+void Query::set_progress_callback(
+    const std::function<void(void*)>& callback, void* callback_data) {
+  progress_callback_ = callback;
+  progress_callback_data_ = callback_data;
+}
+
+Status Query::set_cache_hint(CacheHint hint) {
+  if (hint != CacheHint::CACHE_DEFAULT && hint != CacheHint::CACHE_BYPASS &&
+      hint != CacheHint::CACHE_PIN)
+    return LOG_STATUS(
+        Status::QueryError("Cannot set cache hint; Invalid hint"));
+  cache_hint_ = hint;
+  return Status::Ok();
+}
+
 Status Query::set_fragment_metadata(
     const std::vector<FragmentMetadata*>& fragment_metadata) {
   fragment_metadata_ = fragment_metadata;
@@ -1293,6 +3697,12 @@ Status Query::set_layout(Layout layout) {
     return LOG_STATUS(Status::QueryError(
         "Cannot set layout; The array is defined as a key-value store"));
 
+  // The morton layout applies only to the array cell order
+  if (layout == Layout::MORTON)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set layout; The morton layout applies only to the array "
+        "cell order - use GLOBAL_ORDER instead"));
+
   // Ordered layout for writes in sparse arrays is meaningless
   if (type_ == QueryType::WRITE && !array_schema_->dense() &&
       (layout == Layout::COL_MAJOR || layout == Layout::ROW_MAJOR))
@@ -1300,6 +3710,13 @@ Status Query::set_layout(Layout layout) {
         "Cannot set layout; Ordered layouts can be used when writing to sparse "
         "arrays - use UNORDERED instead"));
 
+  // The unordered layout for reads applies only to sparse arrays
+  if (type_ == QueryType::READ && layout == Layout::UNORDERED &&
+      array_schema_->dense())
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set layout; The unordered layout applies only to sparse "
+        "array reads"));
+
   // Layout for 1D vectors should not be col-major
   // Use the equivalent row-major
   if (array_schema_->dim_num() == 1 && layout == Layout::COL_MAJOR)
@@ -1314,6 +3731,84 @@ void Query::set_status(QueryStatus status) {
   status_ = status;
 }
 
+Status Query::set_predicate(
+    const char* attribute, PredicateOp op, const void* value) {
+  unsigned attr_id;
+  RETURN_NOT_OK(check_predicate_attribute(attribute, &attr_id));
+  if (value == nullptr)
+    return LOG_STATUS(
+        Status::QueryError("Cannot set predicate; Invalid operand value"));
+  switch (op) {
+    case PredicateOp::LT:
+    case PredicateOp::LE:
+    case PredicateOp::GT:
+    case PredicateOp::GE:
+    case PredicateOp::EQ:
+    case PredicateOp::NE:
+      break;
+    default:
+      return LOG_STATUS(
+          Status::QueryError("Cannot set predicate; Invalid operator"));
+  }
+
+  Predicate pred;
+  pred.attribute_ = attribute;
+  pred.attr_id_ = attr_id;
+  pred.op_ = op;
+  auto cell_size = array_schema_->cell_size(attr_id);
+  pred.value_.assign(
+      (const uint8_t*)value, (const uint8_t*)value + cell_size);
+  predicates_.push_back(std::move(pred));
+
+  // The result of a previous (incomplete) read is no longer valid
+  reset_read_state();
+
+  return Status::Ok();
+}
+
+Status Query::set_predicate_range(
+    const char* attribute, const void* low, const void* high) {
+  unsigned attr_id;
+  RETURN_NOT_OK(check_predicate_attribute(attribute, &attr_id));
+  if (low == nullptr || high == nullptr)
+    return LOG_STATUS(
+        Status::QueryError("Cannot set predicate; Invalid range bounds"));
+
+  Predicate pred;
+  pred.attribute_ = attribute;
+  pred.attr_id_ = attr_id;
+  pred.op_ = PredicateOp::BETWEEN;
+  auto cell_size = array_schema_->cell_size(attr_id);
+  pred.value_.assign((const uint8_t*)low, (const uint8_t*)low + cell_size);
+  pred.value2_.assign((const uint8_t*)high, (const uint8_t*)high + cell_size);
+  predicates_.push_back(std::move(pred));
+
+  reset_read_state();
+
+  return Status::Ok();
+}
+
+Status Query::set_predicate_set(
+    const char* attribute, const void* values, uint64_t value_num) {
+  unsigned attr_id;
+  RETURN_NOT_OK(check_predicate_attribute(attribute, &attr_id));
+  if (values == nullptr || value_num == 0)
+    return LOG_STATUS(
+        Status::QueryError("Cannot set predicate; Invalid value set"));
+
+  Predicate pred;
+  pred.attribute_ = attribute;
+  pred.attr_id_ = attr_id;
+  pred.op_ = PredicateOp::IN;
+  auto size = value_num * array_schema_->cell_size(attr_id);
+  pred.value_.assign((const uint8_t*)values, (const uint8_t*)values + size);
+  predicates_.push_back(std::move(pred));
+
+  reset_read_state();
+
+  return Status::Ok();
+}
+
 void Query::set_storage_manager(StorageManager* storage_manager) {
   storage_manager_ = storage_manager;
 }
@@ -1335,6 +3830,61 @@ Status Query::set_subarray(const void* subarray) {
   else
     std::memcpy(subarray_, subarray, subarray_size);
 
+  // A single subarray supersedes any previously set range list
+  if (subarrays_ != nullptr) {
+    std::free(subarrays_);
+    subarrays_ = nullptr;
+    subarray_range_num_ = 1;
+  }
+
+  // The result of a previous (incomplete) read is no longer valid
+  reset_read_state();
+
+  return Status::Ok();
+}
+
+Status Query::set_subarrays(const void* subarrays, uint64_t range_num) {
+  if (range_num == 0)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set subarrays; At least one range must be provided"));
+
+  // A single range is equivalent to a regular subarray
+  if (range_num == 1)
+    return set_subarray(subarrays);
+
+  if (subarrays == nullptr)
+    return LOG_STATUS(
+        Status::QueryError("Cannot set subarrays; Invalid subarrays input"));
+
+  if (array_schema_->dense())
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set subarrays; Multiple ranges are supported only for "
+        "sparse arrays"));
+
+  if (type_ == QueryType::WRITE)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set subarrays; Multiple ranges are supported only for "
+        "read queries"));
+
+  // Check that each range falls inside the array domain
+  uint64_t subarray_size = 2 * array_schema_->coords_size();
+  auto ranges = static_cast<const char*>(subarrays);
+  for (uint64_t r = 0; r < range_num; ++r)
+    RETURN_NOT_OK(check_subarray(ranges + r * subarray_size));
+
+  // Constrain the query on the entire domain; the ranges refine the
+  // overlap computation on the read path. This also invalidates the
+  // result of a previous (incomplete) read.
+  RETURN_NOT_OK(set_subarray(nullptr));
+
+  // Copy the ranges
+  subarrays_ = std::malloc(range_num * subarray_size);
+  if (subarrays_ == nullptr)
+    return LOG_STATUS(
+        Status::QueryError("Memory allocation for subarrays failed"));
+  std::memcpy(subarrays_, subarrays, range_num * subarray_size);
+  subarray_range_num_ = range_num;
+
   return Status::Ok();
 }
 
@@ -1342,6 +3892,10 @@ void Query::set_type(QueryType type) {
   type_ = type;
 }
 
+const QueryStats* Query::stats() const {
+  return &stats_;
+}
+
 QueryStatus Query::status() const {
   return status_;
 }
@@ -1536,6 +4090,147 @@ Status Query::check_subarray(const T* subarray) const {
   return Status::Ok();
 }
 
+Status Query::check_predicate_attribute(
+    const char* attribute, unsigned* attr_id) const {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set predicate; Applicable only to reads"));
+  if (attribute == nullptr || !strcmp(attribute, constants::coords))
+    return LOG_STATUS(
+        Status::QueryError("Cannot set predicate; Invalid attribute"));
+
+  // Applicable only to fixed-sized, single-value numeric attributes,
+  // matching the attributes the per-tile statistics are computed for
+  RETURN_NOT_OK(array_schema_->attribute_id(attribute, attr_id));
+  if (array_schema_->var_size(*attr_id) ||
+      array_schema_->cell_val_num(*attr_id) != 1)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set predicate; Applicable only to fixed-sized, "
+        "single-value attributes"));
+  switch (array_schema_->type(*attr_id)) {
+    case Datatype::CHAR:
+    case Datatype::INT8:
+    case Datatype::UINT8:
+    case Datatype::INT16:
+    case Datatype::UINT16:
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT32:
+    case Datatype::FLOAT64:
+      return Status::Ok();
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot set predicate; Applicable only to numeric attributes"));
+  }
+}
+
+template <class T>
+Status Query::compute_all_dense_cell_ranges(
+    const std::vector<T>& subarray,
+    const std::unordered_map<uint64_t, std::pair<uint64_t, std::vector<T>>>&
+        overlapping_tile_idx_coords,
+    std::vector<std::vector<DenseCellRangeIter<T>>>* dense_frag_its,
+    std::list<DenseCellRange<T>>* dense_cell_ranges) {
+  // For easy reference
+  auto domain = array_schema_->domain();
+
+  // A step is one (space tile, query range) unit of work in the subarray
+  // cell order
+  struct Step {
+    const T* tile_coords_;
+    uint64_t tile_pos_;
+    uint64_t start_;
+    uint64_t end_;
+  };
+
+  // First pass: record the steps in the subarray cell order, grouping the
+  // steps that fall in the same space tile
+  std::vector<Step> steps;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> tile_steps;
+  DenseCellRangeIter<T> it(domain, subarray, layout_);
+  RETURN_NOT_OK(it.begin());
+  std::vector<typename DenseCellRangeIter<T>::CellRange> flat_ranges;
+  RETURN_NOT_OK(it.all_ranges(&flat_ranges));
+  for (const auto& r : flat_ranges) {
+    auto o_it = overlapping_tile_idx_coords.find(r.tile_idx_);
+    assert(o_it != overlapping_tile_idx_coords.end());
+    tile_steps[o_it->second.first].push_back((uint64_t)steps.size());
+    steps.push_back(Step{&(o_it->second.second)[0],
+                         o_it->second.first,
+                         r.start_,
+                         r.end_});
+  }
+
+  // Processes all steps of a space tile in order, each into its own
+  // result list. The steps of a tile share the tile's fragment iterators
+  // and must execute sequentially; different tiles are independent.
+  std::vector<std::list<DenseCellRange<T>>> step_ranges(steps.size());
+  auto do_tile = [&](const std::vector<uint64_t>& step_ids) {
+    // Fast path for a whole empty tile: if no dense fragment overlaps
+    // the space tile, every step resolves to a single empty (fill)
+    // range, so the per-slab fragment merge below is skipped entirely.
+    // The copy phase later coalesces adjacent fill ranges and
+    // materializes them with wide stores.
+    auto& frag_its = (*dense_frag_its)[steps[step_ids[0]].tile_pos_];
+    bool tile_empty = true;
+    for (const auto& frag_it : frag_its)
+      tile_empty &= frag_it.end();
+    if (tile_empty) {
+      for (auto s : step_ids)
+        step_ranges[s].emplace_back(
+            -1, steps[s].tile_coords_, steps[s].start_, steps[s].end_);
+      return Status::Ok();
+    }
+
+    for (auto s : step_ids) {
+      RETURN_NOT_OK(compute_dense_cell_ranges<T>(
+          steps[s].tile_coords_,
+          (*dense_frag_its)[steps[s].tile_pos_],
+          steps[s].start_,
+          steps[s].end_,
+          &step_ranges[s]));
+    }
+    return Status::Ok();
+  };
+
+  // Execute the space tiles, parallelizing on the compute thread pool
+  std::vector<const std::vector<uint64_t>*> tiles;
+  for (const auto& ts : tile_steps)
+    tiles.push_back(&ts.second);
+  auto pool = storage_manager_->compute_thread_pool();
+  uint64_t tile_num = tiles.size();
+  uint64_t task_num = std::min<uint64_t>(pool->num_threads(), tile_num);
+  if (task_num <= 1) {
+    for (auto t : tiles)
+      RETURN_NOT_OK(do_tile(*t));
+  } else {
+    std::vector<std::future<Status>> tasks;
+    uint64_t tiles_per_task = tile_num / task_num;
+    uint64_t remainder = tile_num % task_num;
+    uint64_t start = 0;
+    for (uint64_t t = 0; t < task_num; ++t) {
+      uint64_t end = start + tiles_per_task + ((t < remainder) ? 1 : 0);
+      tasks.push_back(pool->enqueue([&tiles, &do_tile, start, end]() {
+        for (uint64_t i = start; i < end; ++i)
+          RETURN_NOT_OK(do_tile(*tiles[i]));
+        return Status::Ok();
+      }));
+      start = end;
+    }
+    if (!pool->wait_all(tasks))
+      return LOG_STATUS(Status::QueryError(
+          "Cannot compute dense cell ranges; Partition tasks failed"));
+  }
+
+  // Stitch the per-step results back together in the subarray cell order
+  for (auto& sr : step_ranges)
+    dense_cell_ranges->splice(dense_cell_ranges->end(), sr);
+
+  return Status::Ok();
+}
+
 template <class T>
 Status Query::compute_dense_cell_ranges(
     const T* tile_coords,
@@ -1760,6 +4455,10 @@ Status Query::init_tile_fragment_dense_cell_range_iters(
         if (tile_overlap) {
           frag_iters.emplace_back(domain, frag_subarray_in_tile, layout_);
           RETURN_NOT_OK(frag_iters.back().begin());
+          // Materialize the tile's ranges into a flat buffer, so that
+          // the merge in `compute_dense_cell_ranges` consumes them with
+          // cursor bumps instead of per-range coordinate arithmetic
+          RETURN_NOT_OK(frag_iters.back().materialize());
         } else {
           frag_iters.emplace_back();
         }
@@ -1806,7 +4505,9 @@ std::string Query::new_fragment_name() const {
 }
 
 Status Query::open_fragments(const std::vector<FragmentMetadata*>& metadata) {
-  // Create a fragment object for each fragment directory
+  // Create a fragment object for each fragment directory. The metadata
+  // has already been fetched (in parallel on the I/O thread pool) at
+  // array open, so this loop is pure in-memory bookkeeping.
   for (auto meta : metadata) {
     auto fragment = new Fragment(this);
     RETURN_NOT_OK(fragment->init(meta->fragment_uri(), meta));
@@ -1866,6 +4567,10 @@ void Query::zero_out_buffer_sizes(uint64_t* buffer_sizes) const {
 }
 
 void Query::zero_out_buffers() {
+  // In query-allocated mode, the buffers are not allocated yet
+  if (own_buffers_)
+    return;
+
   unsigned int buffer_i = 0;
   auto attribute_id_num = (unsigned int)attribute_ids_.size();
   for (unsigned int i = 0; i < attribute_id_num; ++i) {
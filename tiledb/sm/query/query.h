@@ -33,14 +33,19 @@
 #ifndef TILEDB_QUERY_H
 #define TILEDB_QUERY_H
 
+#include "tiledb/sm/enums/cache_hint.h"
+#include "tiledb/sm/enums/predicate_op.h"
 #include "tiledb/sm/enums/query_status.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/fragment/fragment.h"
+#include "tiledb/sm/misc/arena.h"
+#include "tiledb/sm/misc/query_stats.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/query/array_ordered_write_state.h"
 #include "tiledb/sm/query/dense_cell_range_iter.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -52,6 +57,7 @@ namespace sm {
 class ArrayOrderedWriteState;
 class Fragment;
 class StorageManager;
+class TileIO;
 
 /** Processes a (read/write) query. */
 class Query {
@@ -81,6 +87,15 @@ class Query {
      */
     std::unordered_map<std::string, TilePair> attr_tiles_;
 
+    /**
+     * The zipped (cell-interleaved) view of the coordinate tile, when
+     * the tile stores coordinates in the unzipped layout. Materialized
+     * lazily by `tile_coords`, at most once per tile; the tile buffer
+     * itself is never re-zipped, as it may be shared with other queries
+     * through the tile cache.
+     */
+    std::vector<uint8_t> zipped_coords_;
+
     /** Constructor. */
     OverlappingTile(
         unsigned fragment_idx, uint64_t tile_idx, bool full_overlap = false)
@@ -93,6 +108,39 @@ class Query {
   /** A vector of overlapping tiles. */
   typedef std::vector<std::shared_ptr<OverlappingTile>> OverlappingTileVec;
 
+  /** A pending asynchronous tile fetch issued by `read_tiles`. */
+  struct TileFetch {
+    /** The TileIO object that issued the fetch. */
+    std::shared_ptr<TileIO> io_;
+    /** The tile being fetched. */
+    std::shared_ptr<Tile> tile_;
+    /** The offset of the tile in the attribute file. */
+    uint64_t file_offset_;
+    /** The size of the decompressed tile. */
+    uint64_t tile_size_;
+    /** The size of the tile on disk. */
+    uint64_t compressed_size_;
+    /** Buffer holding the compressed tile bytes. */
+    std::shared_ptr<Buffer> compressed_;
+    /** `true` if the tile bytes must be decompressed upon completion. */
+    bool decompress_;
+    /**
+     * Future that completes when the tile bytes have been fetched. It is
+     * shared, since a single merged read may serve multiple fetches of
+     * physically contiguous tiles (see `issue_tile_fetches`).
+     */
+    std::shared_future<Status> fetched_;
+    /**
+     * The bytes charged against the memory budget for the transient
+     * compressed buffer of this fetch, released when the fetch has been
+     * decompressed.
+     */
+    uint64_t charged_;
+  };
+
+  /** A list of pending tile fetches. */
+  typedef std::list<std::shared_ptr<TileFetch>> TileFetchList;
+
   /** A cell range belonging to a particular overlapping tile. */
   struct OverlappingCellRange {
     /**
@@ -119,6 +167,114 @@ class Query {
   typedef std::list<std::shared_ptr<OverlappingCellRange>>
       OverlappingCellRangeList;
 
+  /**
+   * The state of a read query across submissions. When the result does
+   * not fit in the user buffers, the computed (sorted and de-duplicated)
+   * result cell ranges are kept here and the query is marked incomplete,
+   * so that a follow-up submission resumes copying from `cur_range_`
+   * instead of recomputing, re-fetching and re-sorting everything.
+   */
+  struct ReadState {
+    /** `true` if the result cell ranges have been computed. */
+    bool initialized_ = false;
+    /**
+     * The maximal result cell ranges. They keep the overlapping tiles
+     * (and, thus, the tile data) alive until the query completes.
+     */
+    OverlappingCellRangeList cell_ranges_;
+    /** The first cell range not yet copied to the user buffers. */
+    OverlappingCellRangeList::const_iterator cur_range_;
+    /**
+     * The subarray partitions not yet processed, serialized as raw
+     * subarray bytes. When the tiles overlapping the subarray are
+     * estimated to exceed `sm.read_partition_budget`, the subarray is
+     * split into partitions that are processed one at a time, so that
+     * only one partition's worth of tiles is materialized at once.
+     * An empty vector denotes the whole (un-partitioned) subarray.
+     */
+    std::list<std::vector<uint8_t>> partitions_;
+    /**
+     * The number of bytes copied to each user buffer in the current
+     * submission. Copies across partitions append at these offsets;
+     * they are assigned to `buffer_sizes_` when the submission ends.
+     */
+    std::vector<uint64_t> copy_offsets_;
+  };
+
+  /**
+   * The running state of an aggregate computation (see `aggregate`).
+   * The minimum/maximum hold raw attribute cell bytes; the sum is
+   * accumulated in the widest type of the attribute's kind, matching
+   * the convention of the per-tile statistics in the fragment metadata.
+   */
+  struct AggregateState {
+    /** The number of cells aggregated so far. */
+    uint64_t count_ = 0;
+    /** `true` if a minimum/maximum has been recorded. */
+    bool has_min_max_ = false;
+    /** The minimum cell value so far (raw attribute bytes). */
+    std::vector<uint8_t> min_;
+    /** The maximum cell value so far (raw attribute bytes). */
+    std::vector<uint8_t> max_;
+    /** The running sum for signed integer attributes. */
+    int64_t sum_int_ = 0;
+    /** The running sum for unsigned integer attributes. */
+    uint64_t sum_uint_ = 0;
+    /** The running sum for floating point attributes. */
+    double sum_real_ = 0.0;
+
+    /** Folds a typed minimum/maximum pair into the running min/max. */
+    template <class T>
+    void update_min_max(T min, T max) {
+      if (!has_min_max_) {
+        min_.assign((const uint8_t*)&min, (const uint8_t*)&min + sizeof(T));
+        max_.assign((const uint8_t*)&max, (const uint8_t*)&max + sizeof(T));
+        has_min_max_ = true;
+        return;
+      }
+      if (min < *(const T*)&min_[0])
+        std::memcpy(&min_[0], &min, sizeof(T));
+      if (max > *(const T*)&max_[0])
+        std::memcpy(&max_[0], &max, sizeof(T));
+    }
+
+    /** Adds to the running sum of the matching kind. */
+    void add_sum(int64_t v) {
+      sum_int_ += v;
+    }
+
+    /** Adds to the running sum of the matching kind. */
+    void add_sum(uint64_t v) {
+      sum_uint_ += v;
+    }
+
+    /** Adds to the running sum of the matching kind. */
+    void add_sum(double v) {
+      sum_real_ += v;
+    }
+  };
+
+  /**
+   * An attribute value predicate (see `set_predicate`). A read returns
+   * only the cells that satisfy all the set predicates. The operand
+   * values hold raw attribute cell bytes.
+   */
+  struct Predicate {
+    /** The name of the filtered attribute. */
+    std::string attribute_;
+    /** The id of the filtered attribute. */
+    unsigned attr_id_;
+    /** The comparison operator. */
+    PredicateOp op_;
+    /**
+     * The operand value. For `BETWEEN` this is the low bound; for `IN`
+     * it holds all the member values consecutively.
+     */
+    std::vector<uint8_t> value_;
+    /** The high bound for `BETWEEN`; unused otherwise. */
+    std::vector<uint8_t> value2_;
+  };
+
   /**
    * Records the overlapping tile and position of the coordinates
    * in that tile.
@@ -196,10 +352,27 @@ class Query {
    *
    * @tparam T The coords type.
    * @param tiles The tiles to be computed.
+   * @param partition If not `nullptr`, the subarray partition (of type
+   *     `T`) to compute the overlap against, instead of the query
+   *     subarray.
+   * @return Status
+   */
+  template <class T>
+  Status compute_overlapping_tiles(
+      OverlappingTileVec* tiles, const void* partition = nullptr) const;
+
+  /**
+   * Computes the tiles of the dense fragments that overlap the query
+   * subarray, appending them to `tiles`. Used by `preload`; the regular
+   * dense read path computes its tiles together with their cell ranges
+   * instead.
+   *
+   * @tparam T The domain type.
+   * @param tiles The overlapping tiles are appended here.
    * @return Status
    */
   template <class T>
-  Status compute_overlapping_tiles(OverlappingTileVec* tiles) const;
+  Status preload_dense_tiles(OverlappingTileVec* tiles) const;
 
   /**
    * Retrieves the tiles on a particular attribute from all input fragments
@@ -213,17 +386,61 @@ class Query {
       const std::string& attr_name, OverlappingTileVec* tiles) const;
 
   /**
-   * Computes the overlapping coordinates for a given subarray.
+   * Issues the asynchronous fetches for the tiles on a particular attribute
+   * from all input fragments, without waiting for them to complete. The
+   * pending fetches are appended to `fetches` and must be consumed with
+   * `wait_tiles`. This allows the tiles of multiple attributes to be
+   * fetched concurrently.
+   *
+   * @param attr_name The attribute name.
+   * @param tiles The retrieved tiles will be stored in `tiles`.
+   * @param fetches The pending tile fetches are appended here.
+   * @return Status
+   */
+  Status read_tiles(
+      const std::string& attr_name,
+      OverlappingTileVec* tiles,
+      TileFetchList* fetches) const;
+
+  /**
+   * Issues the asynchronous I/O of the input pending tile fetches,
+   * merging runs of physically contiguous tiles of the same file into
+   * single reads whose results are split back into the per-tile
+   * buffers. Tiles found in the tile cache are excluded from the merged
+   * runs and fetched through the cache-aware per-tile path. The input
+   * list is cleared.
+   *
+   * @param pending The pending tile fetches to issue.
+   * @return Status
+   */
+  Status issue_tile_fetches(TileFetchList* pending) const;
+
+  /**
+   * Waits on the input tile fetches to complete, fanning the decompression
+   * of the fetched tiles out to the compute thread pool.
+   *
+   * @param fetches The pending tile fetches to wait on.
+   * @return Status
+   */
+  Status wait_tiles(TileFetchList* fetches) const;
+
+  /**
+   * Computes the overlapping coordinates for a given subarray. The
+   * tiles are processed in parallel on the compute thread pool, as
+   * each tile's computation is independent.
    *
    * @tparam T The coords type.
    * @param tiles The tiles to get the overlapping coordinates from.
    * @param coords The coordinates to be retrieved.
+   * @param partition If not `nullptr`, the subarray partition to compute
+   *     the overlap against, instead of the query subarray.
    * @return Status
    */
   template <class T>
   Status compute_overlapping_coords(
       const OverlappingTileVec& tiles,
-      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
+      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords,
+      const T* partition = nullptr) const;
 
   /**
    * Retrieves the coordinates that overlap the subarray from the input
@@ -232,12 +449,15 @@ class Query {
    * @tparam T The coords type.
    * @param The overlapping tile.
    * @param coords The overlapping coordinates to retrieve.
+   * @param partition If not `nullptr`, the subarray partition to compute
+   *     the overlap against, instead of the query subarray.
    * @return Status
    */
   template <class T>
   Status compute_overlapping_coords(
       const std::shared_ptr<OverlappingTile>& tile,
-      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
+      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords,
+      const T* partition = nullptr) const;
 
   /**
    * Gets all the coordinates of the input tile into `coords`.
@@ -253,7 +473,26 @@ class Query {
       std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
 
   /**
-   * Sorts the input coordinates according to the input layout.
+   * Returns a pointer to the zipped (cell-interleaved) coordinates of
+   * the tile. Compressed coordinate tiles are kept in the unzipped
+   * layout they decompress into (one contiguous stream per dimension);
+   * when a consumer needs cell-interleaved coordinates, the zipped view
+   * is materialized lazily on the overlapping tile, at most once. The
+   * tile buffer itself is never modified, as it may be shared with
+   * other queries through the tile cache.
+   *
+   * @param tile The overlapping tile.
+   * @return A pointer to the zipped coordinates.
+   */
+  const unsigned char* tile_coords(
+      const std::shared_ptr<OverlappingTile>& tile) const;
+
+  /**
+   * Sorts the input coordinates according to the input layout. The
+   * function binds the array dimensionality as a compile-time constant
+   * for the common low-dimensional cases (one type dispatch per sort,
+   * not per comparison), so that the per-dimension comparator loops get
+   * unrolled.
    *
    * @tparam T The coords type.
    * @param coords The coordinates to sort.
@@ -263,6 +502,65 @@ class Query {
   Status sort_coords(
       std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
 
+  /**
+   * Sorts the input coordinates according to the input layout, with the
+   * dimensionality bound to `DIM` at compile time (0 means dynamic).
+   *
+   * @tparam T The coords type.
+   * @tparam DIM The number of dimensions (0 for dynamic).
+   * @param coords The coordinates to sort.
+   * @return Status
+   */
+  template <class T, unsigned DIM>
+  Status sort_coords_fixed_dim(
+      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
+
+  /**
+   * Returns `true` if the input coordinates can be sorted with the
+   * key-based path, i.e., if the coordinates can be packed into
+   * fixed-width 64- or 128-bit sort keys for the query layout.
+   *
+   * @tparam T The coords type.
+   * @return `true` if the key-based sort path is applicable.
+   */
+  template <class T>
+  bool can_sort_coords_with_keys() const;
+
+  /**
+   * Sorts the input coordinates by packing them into fixed-width sort
+   * keys once, so that each comparison during the sort is a plain
+   * integer compare instead of a per-dimension loop over the coordinate
+   * buffers. Keys that fit in 64 bits are sorted with a parallel radix
+   * sort; wider coordinates are packed into 128-bit keys (with the
+   * original position as a tie-breaking tail) and sorted with
+   * `std::sort`. This is applicable only when
+   * `can_sort_coords_with_keys` returns `true`.
+   *
+   * @tparam T The coords type.
+   * @param coords The coordinates to sort.
+   * @return Status
+   */
+  template <class T>
+  Status sort_coords_with_keys(
+      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
+
+  /**
+   * Prunes the cells that are overwritten by a more recent fragment,
+   * before the coordinates are sorted. The cells are visited
+   * newest-fragment-first while recording the coordinates seen so far;
+   * a cell whose coordinates have already been seen comes from an older
+   * fragment and cannot survive deduplication. For arrays with heavy
+   * overwrite churn this shrinks the sort input from the total number
+   * of overlapping cells down to the live ones.
+   *
+   * @tparam T The coords type.
+   * @param coords The coordinates to prune.
+   * @return Status
+   */
+  template <class T>
+  Status prune_overwritten_coords(
+      std::list<std::shared_ptr<OverlappingCoords<T>>>* coords) const;
+
   /**
    * Deduplicates the input coordinates, breaking ties giving preference
    * to the largest fragment index (i.e., it prefers more recent fragments).
@@ -277,6 +575,9 @@ class Query {
 
   /**
    * Compute the maximal cell ranges of contiguous cell positions.
+   * Large inputs are scanned in parallel chunks on the compute thread
+   * pool, with ranges that continue across a chunk boundary merged
+   * when the chunks are stitched back together.
    *
    * @tparam T The coords type.
    * @param coords The coordinates to compute the ranges from.
@@ -298,11 +599,13 @@ class Query {
    */
   Status copy_cells(
       const std::string& attribute,
-      const OverlappingCellRangeList& cell_ranges) const;
+      const OverlappingCellRangeList& cell_ranges);
 
   /**
    * Copies the cells for the input **fixed-sized** attribute and cell
-   * ranges, into the corresponding result buffers.
+   * ranges, into the corresponding result buffers. Adjacent cell ranges
+   * are coalesced into single wide copies, which are parallelized over
+   * the disjoint destination regions on the compute thread pool.
    *
    * @param attribute The targeted attribute.
    * @param cell_ranges The cell ranges to copy cells for.
@@ -310,11 +613,15 @@ class Query {
    */
   Status copy_fixed_cells(
       const std::string& attribute,
-      const OverlappingCellRangeList& cell_ranges) const;
+      const OverlappingCellRangeList& cell_ranges);
 
   /**
    * Copies the cells for the input **var-sized** attribute and cell
-   * ranges, into the corresponding result buffers.
+   * ranges, into the corresponding result buffers. The function first
+   * computes the destination offset of each cell range in the result
+   * buffers with a prefix sum over the range value sizes, and then
+   * scatters the cell offsets and values in parallel on the compute
+   * thread pool, as the destination regions are disjoint.
    *
    * @param attribute The targeted attribute.
    * @param cell_ranges The cell ranges to copy cells for.
@@ -322,7 +629,110 @@ class Query {
    */
   Status copy_var_cells(
       const std::string& attribute,
-      const OverlappingCellRangeList& cell_ranges) const;
+      const OverlappingCellRangeList& cell_ranges);
+
+  /**
+   * Copies the next batch of the result cell ranges in the read state
+   * into the user buffers, for all attributes. The batch is the longest
+   * prefix of the remaining cell ranges that fits in the buffers of all
+   * attributes. If cell ranges remain after the batch, the query status
+   * is set to `INCOMPLETE` and a subsequent submission will resume from
+   * the first remaining range; otherwise the read state is reset and
+   * the status is set to `COMPLETED`. If a progress callback is set
+   * (see `set_progress_callback`), it is invoked after each batch that
+   * ends before the submission does, so that consumers of a partitioned
+   * read can process the completed buffer prefix while the remaining
+   * partitions are still being read.
+   *
+   * @return Status
+   */
+  Status copy_cells_batch();
+
+  /**
+   * Computes the end of the next batch of result cell ranges to copy,
+   * i.e., the first of the remaining cell ranges in the read state that
+   * does not fit in the result buffers of all attributes. Errors if not
+   * even a single cell range fits.
+   *
+   * @param batch_end The batch end to be computed.
+   * @return Status
+   */
+  Status compute_copy_batch(
+      OverlappingCellRangeList::const_iterator* batch_end) const;
+
+  /**
+   * In query-allocated buffers mode, (re)allocates the owned result
+   * buffers to the exact size of the remaining result cell ranges
+   * (using the same arithmetic as `compute_copy_batch`), so that the
+   * copy completes in a single batch.
+   *
+   * @return Status
+   */
+  Status alloc_owned_buffers();
+
+  /**
+   * Pops subarray partitions off the read state and computes the result
+   * cell ranges (and fetches the corresponding tiles) for the next one.
+   * If the tiles overlapping the front partition are estimated to exceed
+   * `sm.read_partition_budget`, the partition is recursively split along
+   * the dimension determined by `partition_split_dim`, so that only one
+   * partition's worth of tiles is materialized at once.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status next_read_partition();
+
+  /**
+   * Determines the dimension along which subarray partitions are split
+   * for the query layout, and the tile extent the split points must be
+   * aligned to (0 for no alignment).
+   *
+   * @tparam T The domain type.
+   * @param dim The split dimension to be retrieved.
+   * @param align The split alignment to be retrieved.
+   * @return `true` if the query can be partitioned, `false` otherwise.
+   */
+  template <class T>
+  bool partition_split_dim(unsigned* dim, T* align) const;
+
+  /**
+   * Splits the input subarray partition in two along the partitioning
+   * dimension.
+   *
+   * @tparam T The domain type.
+   * @param partition The partition to split.
+   * @param lo The first half to be computed.
+   * @param hi The second half to be computed.
+   * @return `true` upon success, `false` if the partition cannot be
+   *     split any further.
+   */
+  template <class T>
+  bool split_read_partition(
+      const std::vector<uint8_t>& partition,
+      std::vector<uint8_t>* lo,
+      std::vector<uint8_t>* hi) const;
+
+  /**
+   * Estimates the total (decompressed) size of the input overlapping
+   * tiles on the queried attributes and the coordinates, based on the
+   * fragment metadata. For var-sized attributes only the offset tiles
+   * are accounted for, so the estimate is a lower bound.
+   *
+   * @param tiles The overlapping tiles to estimate the size of.
+   * @param size The estimated size to be retrieved.
+   * @return Status
+   */
+  Status estimate_tiles_size(
+      const OverlappingTileVec& tiles, uint64_t* size) const;
+
+  /**
+   * Resets the read state, so that the next submission of the query
+   * computes the result cell ranges afresh. Also frees the arena the
+   * cell ranges were allocated from.
+   */
+  void reset_read_state();
 
   /**
    * Checks whether two hyper-rectangles overlap, and determines whether
@@ -340,6 +750,39 @@ class Query {
   bool overlap(
       const T* a, const T* b, unsigned dim_num, bool* a_contains_b) const;
 
+  /**
+   * Computes the count/min/max/sum aggregates of an attribute over the
+   * cells a read of the query subarray would return, without
+   * materializing the cells in result buffers. Tiles whose cells are
+   * all part of the result are answered from the per-tile statistics in
+   * the fragment metadata (no tile I/O at all); only the boundary tiles
+   * and the tiles affected by overwrites are fetched and scanned. In a
+   * dense array, cells that no fragment has written contribute nothing
+   * to the aggregates.
+   *
+   * Applicable only to read queries and to fixed-sized, single-value
+   * numeric attributes.
+   *
+   * @param attribute The attribute to aggregate.
+   * @param count The number of result cells to be retrieved.
+   * @param min The minimum cell value to be retrieved, in the attribute
+   *     type. It may be `nullptr`. It is left unset if the count is 0.
+   * @param max The maximum cell value to be retrieved, in the attribute
+   *     type. It may be `nullptr`. It is left unset if the count is 0.
+   * @param sum The sum of the cell values to be retrieved, in the
+   *     widest type of the attribute's kind (`int64_t` for signed
+   *     integers, `uint64_t` for unsigned integers and `double` for
+   *     floating point values). It may be `nullptr`. It is left unset
+   *     if the count is 0.
+   * @return Status
+   */
+  Status aggregate(
+      const char* attribute,
+      uint64_t* count,
+      void* min,
+      void* max,
+      void* sum);
+
   /** Returns the array schema.*/
   const ArraySchema* array_schema() const;
 
@@ -352,6 +795,12 @@ class Query {
   /** Retrieves the index of the buffer corresponding to the input attribute. */
   Status buffer_idx(const std::string& attribute, unsigned* bid) const;
 
+  /** Returns the query buffers. */
+  void** buffers() const;
+
+  /** Returns the sizes of the query buffers. */
+  uint64_t* buffer_sizes() const;
+
   /** Finalizes and deletes the created fragments. */
   Status clear_fragments();
 
@@ -502,6 +951,29 @@ class Query {
    */
   Status overflow(const char* attribute_name, unsigned int* overflow) const;
 
+  /**
+   * Fetches into the tile cache all the tiles of the input attributes
+   * that overlap the query subarray, without materializing any cells in
+   * result buffers. Used to warm up the cache ahead of the actual reads.
+   *
+   * @param attributes The attributes whose tiles to fetch. If `nullptr`,
+   *     all the array attributes (and, for sparse arrays, the
+   *     coordinates) are fetched.
+   * @param attribute_num The number of attributes.
+   * @return Status
+   */
+  Status preload(const char** attributes, unsigned int attribute_num);
+
+  /**
+   * Fetches into the tile cache all the tiles of the query attributes
+   * that overlap the query subarray.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status preload();
+
   /** Perform a dense read */
   Status dense_read();
 
@@ -514,6 +986,33 @@ class Query {
   template <class T>
   Status dense_read();
 
+  /**
+   * Checks whether the direct dense read path applies: a single-range
+   * subarray that is aligned to the tile boundaries and fully contained
+   * in a single dense fragment, read in the global order. In that case
+   * the result is whole tiles in tile order and the general
+   * multi-fragment cell range merge is unnecessary.
+   *
+   * @tparam T The domain type.
+   * @param subarray The query subarray.
+   * @return `true` if the direct path applies.
+   */
+  template <class T>
+  bool dense_read_direct_applicable(const T* subarray) const;
+
+  /**
+   * Directly computes the result cell ranges of a dense read for which
+   * `dense_read_direct_applicable` holds: one whole-tile cell range per
+   * subarray tile, in tile order. The copy machinery then coalesces
+   * adjacent whole tiles into single wide copies.
+   *
+   * @tparam T The domain type.
+   * @param subarray The query subarray.
+   * @return Status
+   */
+  template <class T>
+  Status dense_read_direct(const T* subarray);
+
   /** Perform a sparse read */
   Status sparse_read();
 
@@ -558,6 +1057,41 @@ class Query {
   /** Sets the query buffers. */
   void set_buffers(void** buffers, uint64_t* buffer_sizes);
 
+  /**
+   * Sets the attributes of a read query in "query-allocated buffers"
+   * mode. Instead of copying results into user-provided buffers, the
+   * query allocates reference-counted result buffers itself, sized
+   * exactly to the result once the result cell ranges are known. Reads
+   * in this mode always complete in a single submission; there is no
+   * buffer overflow or resubmit cycle. The buffers are retrieved with
+   * `result_buffer` after the query completes.
+   *
+   * @param attributes The attributes the query will focus on. If
+   *     `nullptr`, the query is set on all attributes.
+   * @param attribute_num The number of attributes.
+   * @return Status
+   */
+  Status set_alloc_buffers(const char** attributes, unsigned int attribute_num);
+
+  /**
+   * Retrieves the query-allocated result buffers of an attribute, after
+   * a read in the mode set by `set_alloc_buffers` has completed. The
+   * buffers are reference-counted; a caller that holds on to them may
+   * use them (e.g., wrap them in a columnar in-memory format) with no
+   * extra copy, even after the query object is deleted.
+   *
+   * @param attribute The attribute name.
+   * @param buffer The values buffer for a fixed-sized attribute, or the
+   *     (64-bit) offsets buffer for a var-sized one.
+   * @param buffer_var The values buffer for a var-sized attribute, set
+   *     to `nullptr` for a fixed-sized one.
+   * @return Status
+   */
+  Status result_buffer(
+      const char* attribute,
+      std::shared_ptr<Buffer>* buffer,
+      std::shared_ptr<Buffer>* buffer_var) const;
+
   /**
    * Sets the callback function and its data input that will be called
    * upon the completion of an asynchronous query.
@@ -565,6 +1099,28 @@ class Query {
   void set_callback(
       const std::function<void(void*)>& callback, void* callback_data);
 
+  /**
+   * Sets the progress callback function and its data input, enabling
+   * incremental result delivery for asynchronous reads. The read path
+   * invokes the callback every time a batch of result cells has been
+   * copied into the user buffers (see `copy_cells_batch`), after
+   * updating the user buffer sizes to reflect the copied prefix. The
+   * callback is invoked on the thread processing the query; the user
+   * buffers must not be modified while the query is in flight.
+   */
+  void set_progress_callback(
+      const std::function<void(void*)>& callback, void* callback_data);
+
+  /**
+   * Sets the tile cache behavior of the query. `CacheHint::CACHE_BYPASS`
+   * marks the query as a streaming/one-shot read; its tiles are served
+   * from the tile cache if present, but are not inserted into it, so
+   * that a large scan does not pollute the cache. `CacheHint::CACHE_PIN`
+   * marks the query as latency-critical; its tiles are cached so that
+   * they resist eviction by one-shot reads.
+   */
+  Status set_cache_hint(CacheHint hint);
+
   /** Sets and initializes the fragment metadata. */
   Status set_fragment_metadata(
       const std::vector<FragmentMetadata*>& fragment_metadata);
@@ -579,6 +1135,65 @@ class Query {
   /** Sets the query status. */
   void set_status(QueryStatus status);
 
+  /**
+   * Resets a (typically completed) read query with a new subarray, so
+   * that the same query object can be resubmitted. The open fragments,
+   * the loaded fragment metadata (including any in-memory indexes), the
+   * attribute bindings and the buffer bindings are all retained; only
+   * the per-submission read state is invalidated. Repeated submissions
+   * of the same query shape with different subarrays thus skip the
+   * array opening and binding work entirely.
+   *
+   * @param subarray The new subarray. If it is null, the subarray is
+   *     set to the entire domain.
+   * @return Status
+   */
+  Status reset(const void* subarray);
+
+  /**
+   * Sets a comparison predicate on an attribute. This is applicable only
+   * to read queries, on fixed-sized, single-value numeric attributes.
+   * The read returns only the cells whose value for `attribute` compares
+   * `op` against `value`; multiple predicates (on the same or different
+   * attributes) are combined with a logical AND. The predicates are
+   * evaluated inside the read path, so that only the selected cells are
+   * copied to the user buffers, and tiles that the per-tile statistics
+   * prove empty of matches are neither fetched nor scanned.
+   *
+   * @param attribute The attribute to filter on.
+   * @param op The comparison operator.
+   * @param value The operand value, of the attribute type.
+   * @return Status
+   */
+  Status set_predicate(const char* attribute, PredicateOp op, const void* value);
+
+  /**
+   * Sets an inclusive range predicate on an attribute, selecting the
+   * cells whose value lies in `[low, high]`. See `set_predicate` for the
+   * applicability rules and the combination semantics.
+   *
+   * @param attribute The attribute to filter on.
+   * @param low The low bound, of the attribute type.
+   * @param high The high bound, of the attribute type.
+   * @return Status
+   */
+  Status set_predicate_range(
+      const char* attribute, const void* low, const void* high);
+
+  /**
+   * Sets a set membership predicate on an attribute, selecting the cells
+   * whose value equals one of `values`. See `set_predicate` for the
+   * applicability rules and the combination semantics.
+   *
+   * @param attribute The attribute to filter on.
+   * @param values The member values, serialized consecutively in the
+   *     attribute type.
+   * @param value_num The number of values in `values`.
+   * @return Status
+   */
+  Status set_predicate_set(
+      const char* attribute, const void* values, uint64_t value_num);
+
   /** Sets the storage manager. */
   void set_storage_manager(StorageManager* storage_manager);
 
@@ -591,9 +1206,27 @@ class Query {
    */
   Status set_subarray(const void* subarray);
 
+  /**
+   * Sets a list of subarray ranges the query is constrained on. This is
+   * applicable only to read queries on sparse arrays. Tile overlap is
+   * computed once for the union of the ranges and a tile overlapping
+   * multiple ranges is fetched only once. The results are produced in the
+   * array cell order, deduplicated across ranges.
+   *
+   * @param subarrays The ranges to be set, serialized as `range_num`
+   *     consecutive hyper-rectangles, each a sequence of [low, high] pairs
+   *     (one pair per dimension) with the same type as the domain.
+   * @param range_num The number of ranges in `subarrays`.
+   * @return Status
+   */
+  Status set_subarrays(const void* subarrays, uint64_t range_num);
+
   /** Sets the query type. */
   void set_type(QueryType type);
 
+  /** Returns the statistics gathered during the execution of the query. */
+  const QueryStats* stats() const;
+
   /** Returns the query status. */
   QueryStatus status() const;
 
@@ -624,6 +1257,13 @@ class Query {
   /** The names of the attributes involved in the query. */
   std::vector<std::string> attributes_;
 
+  /**
+   * An arena the temporary read structures (overlapping tiles, coordinates
+   * and cell ranges) are allocated from, freed in one shot upon the next
+   * read. Mutable as the read path serves `const` accessors.
+   */
+  mutable Arena arena_;
+
   /** The array schema. */
   const ArraySchema* array_schema_;
 
@@ -649,12 +1289,37 @@ class Query {
   /** Number of buffers. */
   unsigned buffer_num_;
 
+  /** `true` if the query allocates and owns its result buffers. */
+  bool own_buffers_;
+
+  /** The owned result buffers (same layout and order as `buffers_`). */
+  std::vector<std::shared_ptr<Buffer>> owned_buffers_;
+
+  /** The raw pointers of the owned buffers, aliased by `buffers_`. */
+  std::vector<void*> owned_buffer_ptrs_;
+
+  /** The sizes of the owned buffers, aliased by `buffer_sizes_`. */
+  std::vector<uint64_t> owned_buffer_sizes_;
+
+  /** The tile cache behavior hint of the query. */
+  CacheHint cache_hint_;
+
   /** A function that will be called upon the completion of an async query. */
   std::function<void(void*)> callback_;
 
   /** The data input to the callback function. */
   void* callback_data_;
 
+  /**
+   * A function that will be called every time the read path copies a
+   * batch of result cells into the user buffers, or `nullptr` for
+   * completion-only delivery.
+   */
+  std::function<void(void*)> progress_callback_;
+
+  /** The data input to the progress callback function. */
+  void* progress_callback_data_;
+
   /**
    * This is not *nullptr* in case of async write where the current query object
    * continues to write/append to the *common_query_*'s new fragment.
@@ -670,6 +1335,19 @@ class Query {
   /** The query status. */
   QueryStatus status_;
 
+  /**
+   * Statistics gathered during the execution of the query. Mutable as
+   * the read path serves `const` methods and updates the stats from the
+   * I/O and compute thread pools.
+   */
+  mutable QueryStats stats_;
+
+  /**
+   * The bytes charged against the memory budget for the decompressed
+   * tiles materialized by this query, released upon destruction.
+   */
+  mutable uint64_t tile_mem_charged_;
+
   /** The fragments involved in the query. */
   std::vector<Fragment*> fragments_;
 
@@ -685,6 +1363,15 @@ class Query {
   /** The cell layout. */
   Layout layout_;
 
+  /**
+   * The attribute value predicates of the query. A read returns only
+   * the cells that satisfy all of them.
+   */
+  std::vector<Predicate> predicates_;
+
+  /** The read state carried over across submissions of the query. */
+  ReadState read_state_;
+
   /** The storage manager. */
   StorageManager* storage_manager_;
 
@@ -694,6 +1381,19 @@ class Query {
    */
   void* subarray_;
 
+  /**
+   * The number of ranges in `subarrays_`. It is meaningful only when
+   * `subarrays_` is not nullptr.
+   */
+  uint64_t subarray_range_num_;
+
+  /**
+   * The list of subarray ranges the query is constrained on, serialized as
+   * consecutive hyper-rectangles. A nullptr implies that the query is
+   * constrained on the single range in `subarray_`.
+   */
+  void* subarrays_;
+
   /** The query type. */
   QueryType type_;
 
@@ -704,6 +1404,210 @@ class Query {
   /** Adds the coordinates attribute if it does not exist. */
   void add_coords();
 
+  /**
+   * Creates a shared pointer to an object of type `T` allocated from the
+   * query arena. The object is destroyed when the last shared pointer to
+   * it goes away, but its memory is reclaimed only when the arena is
+   * cleared upon the next read.
+   */
+  template <class T, class... Args>
+  std::shared_ptr<T> arena_make_shared(Args&&... args) const {
+    return std::allocate_shared<T>(
+        ArenaAllocator<T>(&arena_), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Computes the aggregates of an attribute for the given domain type.
+   *
+   * @tparam T The domain type.
+   * @param attribute The attribute to aggregate.
+   * @param attr_id The id of the attribute to aggregate.
+   * @param state The aggregate state to accumulate into.
+   * @return Status
+   */
+  template <class T>
+  Status aggregate(
+      const std::string& attribute, unsigned attr_id, AggregateState* state);
+
+  /**
+   * Computes the aggregates of an attribute over a dense array. The
+   * result cell ranges are computed exactly as in `dense_read`;
+   * whole-tile ranges with statistics are answered from the metadata
+   * and only the remaining ranges scan tile values.
+   *
+   * @tparam T The domain type.
+   * @param attribute The attribute to aggregate.
+   * @param attr_id The id of the attribute to aggregate.
+   * @param state The aggregate state to accumulate into.
+   * @return Status
+   */
+  template <class T>
+  Status aggregate_dense(
+      const std::string& attribute, unsigned attr_id, AggregateState* state);
+
+  /**
+   * Computes the aggregates of an attribute over a sparse array. Tiles
+   * fully covered by the subarray whose cells all survive
+   * deduplication are answered from the metadata statistics; only the
+   * rest fetch their coordinate (and, if needed, value) tiles.
+   *
+   * @tparam T The domain type.
+   * @param attribute The attribute to aggregate.
+   * @param attr_id The id of the attribute to aggregate.
+   * @param state The aggregate state to accumulate into.
+   * @return Status
+   */
+  template <class T>
+  Status aggregate_sparse(
+      const std::string& attribute, unsigned attr_id, AggregateState* state);
+
+  /**
+   * Folds the per-tile statistics of one tile into the aggregate state.
+   * The count is not updated; it is maintained by the caller.
+   *
+   * @param attr_id The id of the aggregated attribute.
+   * @param stats The tile statistics to fold in.
+   * @param state The aggregate state to accumulate into.
+   * @return Status
+   */
+  Status aggregate_tile_stats(
+      unsigned attr_id,
+      const FragmentMetadata::TileStats& stats,
+      AggregateState* state);
+
+  /**
+   * Typed implementation of `aggregate_tile_stats`.
+   *
+   * @tparam T The attribute cell type.
+   * @tparam SumT The type the sum is accumulated in.
+   * @param stats The tile statistics to fold in.
+   * @param state The aggregate state to accumulate into.
+   * @return void
+   */
+  template <class T, class SumT>
+  void aggregate_tile_stats(
+      const FragmentMetadata::TileStats& stats, AggregateState* state);
+
+  /**
+   * Folds a run of contiguous cells into the aggregate state. The count
+   * is not updated; it is maintained by the caller.
+   *
+   * @param attr_id The id of the aggregated attribute.
+   * @param data The cell values.
+   * @param cell_num The number of cells in the run.
+   * @param state The aggregate state to accumulate into.
+   * @return Status
+   */
+  Status aggregate_cells(
+      unsigned attr_id,
+      const void* data,
+      uint64_t cell_num,
+      AggregateState* state);
+
+  /**
+   * Typed implementation of `aggregate_cells`.
+   *
+   * @tparam T The attribute cell type.
+   * @tparam SumT The type the sum is accumulated in.
+   * @param data The cell values.
+   * @param cell_num The number of cells in the run.
+   * @param state The aggregate state to accumulate into.
+   * @return void
+   */
+  template <class T, class SumT>
+  void aggregate_cells(
+      const void* data, uint64_t cell_num, AggregateState* state);
+
+  /**
+   * Filters the computed result cell ranges through the attribute value
+   * predicates, in place. Ranges that the per-tile statistics prove to
+   * consist entirely of matches are kept whole and ranges proven empty
+   * of matches are dropped, both without touching the attribute data;
+   * the rest are scanned and split into the maximal sub-ranges of
+   * selected cells. The tiles of the predicate attributes are fetched
+   * here for the scanned tiles that miss them, as a predicate may filter
+   * on an attribute the query does not otherwise read.
+   *
+   * @param cell_ranges The cell ranges to filter.
+   * @return Status
+   */
+  Status apply_predicates(OverlappingCellRangeList* cell_ranges);
+
+  /**
+   * Checks that an attribute may carry a predicate: the query must be a
+   * read and the attribute a fixed-sized, single-value numeric one,
+   * matching the attributes the per-tile statistics are computed for.
+   *
+   * @param attribute The attribute to check.
+   * @param attr_id Set to the id of the attribute.
+   * @return Status
+   */
+  Status check_predicate_attribute(
+      const char* attribute, unsigned* attr_id) const;
+
+  /**
+   * Bounds the outcome of a predicate over a tile from the per-tile
+   * minimum/maximum statistics.
+   *
+   * @param pred The predicate to bound.
+   * @param min The minimum cell value in the tile (raw attribute bytes).
+   * @param max The maximum cell value in the tile (raw attribute bytes).
+   * @param always_true Set to `true` if every value in `[min, max]`
+   *     satisfies the predicate.
+   * @param maybe_true Set to `false` if no value in `[min, max]`
+   *     satisfies the predicate.
+   * @return Status
+   */
+  Status predicate_bounds(
+      const Predicate& pred,
+      const void* min,
+      const void* max,
+      bool* always_true,
+      bool* maybe_true) const;
+
+  /**
+   * Typed implementation of `predicate_bounds`.
+   *
+   * @tparam T The attribute cell type.
+   */
+  template <class T>
+  void predicate_bounds(
+      const Predicate& pred,
+      const void* min,
+      const void* max,
+      bool* always_true,
+      bool* maybe_true) const;
+
+  /**
+   * Evaluates a predicate over a run of contiguous cells, AND-ing the
+   * outcomes into a byte mask.
+   *
+   * @param pred The predicate to evaluate.
+   * @param data The cell values.
+   * @param cell_num The number of cells in the run.
+   * @param mask The mask of `cell_num` bytes to AND the outcomes into.
+   * @return Status
+   */
+  Status predicate_mask(
+      const Predicate& pred,
+      const void* data,
+      uint64_t cell_num,
+      uint8_t* mask) const;
+
+  /**
+   * Typed implementation of `predicate_mask`. The comparison outcomes
+   * are accumulated branchlessly so that the compiler vectorizes the
+   * loops.
+   *
+   * @tparam T The attribute cell type.
+   */
+  template <class T>
+  void predicate_mask(
+      const Predicate& pred,
+      const void* data,
+      uint64_t cell_num,
+      uint8_t* mask) const;
+
   /** Checks if attributes has been appropriately set for a query. */
   Status check_attributes();
 
@@ -722,6 +1626,32 @@ class Query {
   template <class T>
   Status check_subarray(const T* subarray) const;
 
+  /**
+   * Computes the result dense cell ranges for the entire query subarray,
+   * processing the space tiles concurrently on the compute thread pool.
+   * The steps that fall in the same space tile share the tile's fragment
+   * iterators and execute in order on a single thread; the space tiles
+   * are independent of each other. The results are stitched together in
+   * the subarray cell order.
+   *
+   * @tparam T The domain type.
+   * @param subarray The query subarray.
+   * @param overlapping_tile_idx_coords A map from global tile index to a
+   *     pair of (overlapping tile index, tile coordinates).
+   * @param dense_frag_its The fragment dense cell range iterators, one
+   *     vector per space tile overlapping the subarray.
+   * @param dense_cell_ranges The cell ranges where the results are
+   *     appended to, in the subarray cell order.
+   * @return Status
+   */
+  template <class T>
+  Status compute_all_dense_cell_ranges(
+      const std::vector<T>& subarray,
+      const std::unordered_map<uint64_t, std::pair<uint64_t, std::vector<T>>>&
+          overlapping_tile_idx_coords,
+      std::vector<std::vector<DenseCellRangeIter<T>>>* dense_frag_its,
+      std::list<DenseCellRange<T>>* dense_cell_ranges);
+
   /**
    * For the given cell range, it computes all the result dense cell ranges
    * across fragments, given precedence to more recent fragments.
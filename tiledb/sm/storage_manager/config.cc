@@ -154,14 +154,78 @@ Status Config::set(const std::string& param, const std::string& value) {
 
   if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(set_sm_tile_cache_size(value));
+  } else if (param == "sm.tile_cache_compressed") {
+    RETURN_NOT_OK(set_sm_tile_cache_compressed(value));
+  } else if (param == "sm.disk_cache.dir") {
+    RETURN_NOT_OK(set_sm_disk_cache_dir(value));
+  } else if (param == "sm.disk_cache.size") {
+    RETURN_NOT_OK(set_sm_disk_cache_size(value));
   } else if (param == "sm.array_schema_cache_size") {
     RETURN_NOT_OK(set_sm_array_schema_cache_size(value));
+  } else if (param == "sm.consolidation.steps") {
+    RETURN_NOT_OK(set_sm_consolidation_steps(value));
+  } else if (param == "sm.consolidation.step_min_frags") {
+    RETURN_NOT_OK(set_sm_consolidation_step_min_frags(value));
+  } else if (param == "sm.consolidation.step_max_frags") {
+    RETURN_NOT_OK(set_sm_consolidation_step_max_frags(value));
+  } else if (param == "sm.consolidation.step_size_ratio") {
+    RETURN_NOT_OK(set_sm_consolidation_step_size_ratio(value));
+  } else if (param == "sm.consolidation.checkpoint_frequency") {
+    RETURN_NOT_OK(set_sm_consolidation_checkpoint_freq(value));
+  } else if (param == "sm.consolidation.scheduler_enable") {
+    RETURN_NOT_OK(set_sm_consolidation_scheduler_enable(value));
+  } else if (param == "sm.consolidation.scheduler_frag_threshold") {
+    RETURN_NOT_OK(set_sm_consolidation_scheduler_frag_threshold(value));
+  } else if (param == "sm.consolidation.scheduler_interval_ms") {
+    RETURN_NOT_OK(set_sm_consolidation_scheduler_interval_ms(value));
   } else if (param == "sm.fragment_metadata_cache_size") {
     RETURN_NOT_OK(set_sm_fragment_metadata_cache_size(value));
+  } else if (param == "sm.max_parallel_ops") {
+    RETURN_NOT_OK(set_sm_max_parallel_ops(value));
+  } else if (param == "sm.async_worker_num") {
+    RETURN_NOT_OK(set_sm_async_worker_num(value));
+  } else if (param == "sm.enable_checksums") {
+    RETURN_NOT_OK(set_sm_enable_checksums(value));
+  } else if (param == "sm.concurrency.total_budget") {
+    RETURN_NOT_OK(set_sm_concurrency_total_budget(value));
+  } else if (param == "sm.concurrency.io_ratio") {
+    RETURN_NOT_OK(set_sm_concurrency_io_ratio(value));
+  } else if (param == "sm.concurrency.per_query_cap") {
+    RETURN_NOT_OK(set_sm_concurrency_per_query_cap(value));
+  } else if (param == "sm.memory_budget") {
+    RETURN_NOT_OK(set_sm_memory_budget(value));
+  } else if (param == "sm.read_partition_budget") {
+    RETURN_NOT_OK(set_sm_read_partition_budget(value));
+  } else if (param == "sm.write_combining_budget") {
+    RETURN_NOT_OK(set_sm_write_combining_budget(value));
+  } else if (param == "sm.array_open_timestamp") {
+    RETURN_NOT_OK(set_sm_array_open_timestamp(value));
+  } else if (param == "sm.generic_tile_prefix_size") {
+    RETURN_NOT_OK(set_sm_generic_tile_prefix_size(value));
+  } else if (param == "sm.hugepage_threshold") {
+    RETURN_NOT_OK(set_sm_hugepage_threshold(value));
+  } else if (param == "sm.streaming_store_threshold") {
+    RETURN_NOT_OK(set_sm_streaming_store_threshold(value));
+  } else if (param == "sm.numa_aware") {
+    RETURN_NOT_OK(set_sm_numa_aware(value));
+  } else if (param == "sm.shared_thread_pools") {
+    RETURN_NOT_OK(set_sm_shared_thread_pools(value));
+  } else if (param == "sm.tile_prefetch") {
+    RETURN_NOT_OK(set_sm_tile_prefetch(value));
   } else if (param == "vfs.max_parallel_ops") {
     RETURN_NOT_OK(set_vfs_max_parallel_ops(value));
   } else if (param == "vfs.min_parallel_size") {
     RETURN_NOT_OK(set_vfs_min_parallel_size(value));
+  } else if (param == "vfs.max_batch_read_gap") {
+    RETURN_NOT_OK(set_vfs_max_batch_read_gap(value));
+  } else if (param == "vfs.min_direct_write_size") {
+    RETURN_NOT_OK(set_vfs_min_direct_write_size(value));
+  } else if (param == "vfs.write_buffer_size") {
+    RETURN_NOT_OK(set_vfs_write_buffer_size(value));
+  } else if (param == "vfs.exists_cache_ttl_ms") {
+    RETURN_NOT_OK(set_vfs_exists_cache_ttl_ms(value));
+  } else if (param == "vfs.map_reads") {
+    RETURN_NOT_OK(set_vfs_map_reads(value));
   } else if (param == "vfs.s3.region") {
     RETURN_NOT_OK(set_vfs_s3_region(value));
   } else if (param == "vfs.s3.scheme") {
@@ -170,8 +234,12 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_vfs_s3_endpoint_override(value));
   } else if (param == "vfs.s3.use_virtual_addressing") {
     RETURN_NOT_OK(set_vfs_s3_use_virtual_addressing(value));
+  } else if (param == "vfs.s3.max_parallel_ops") {
+    RETURN_NOT_OK(set_vfs_s3_max_parallel_ops(value));
   } else if (param == "vfs.s3.multipart_part_size") {
     RETURN_NOT_OK(set_vfs_s3_multipart_part_size(value));
+  } else if (param == "vfs.s3.max_connections") {
+    RETURN_NOT_OK(set_vfs_s3_max_connections(value));
   } else if (param == "vfs.s3.connect_timeout_ms") {
     RETURN_NOT_OK(set_vfs_s3_connect_timeout_ms(value));
   } else if (param == "vfs.s3.connect_max_tries") {
@@ -186,6 +254,16 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_vfs_hdfs_username(value));
   } else if (param == "vfs.hdfs.kerb_ticket_cache_path") {
     RETURN_NOT_OK(set_vfs_hdfs_kerb_ticket_cache_path(value))
+  } else if (param == "vfs.hdfs.read_buffer_size") {
+    RETURN_NOT_OK(set_vfs_hdfs_read_buffer_size(value));
+  } else if (param == "vfs.hdfs.write_buffer_size") {
+    RETURN_NOT_OK(set_vfs_hdfs_write_buffer_size(value));
+  } else if (param == "vfs.hdfs.block_size") {
+    RETURN_NOT_OK(set_vfs_hdfs_block_size(value));
+  } else if (param == "vfs.hdfs.readahead") {
+    RETURN_NOT_OK(set_vfs_hdfs_readahead(value));
+  } else if (param == "vfs.hdfs.max_open_read_files") {
+    RETURN_NOT_OK(set_vfs_hdfs_max_open_read_files(value));
   }
 
   // If param does not exist, it is ignored
@@ -222,17 +300,157 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.tile_cache_size_;
     param_values_["sm.tile_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.tile_cache_compressed") {
+    sm_params_.tile_cache_compressed_ = constants::tile_cache_compressed;
+    param_values_["sm.tile_cache_compressed"] =
+        (sm_params_.tile_cache_compressed_) ? "true" : "false";
+  } else if (param == "sm.disk_cache.dir") {
+    sm_params_.disk_cache_dir_ = constants::disk_cache_dir;
+    param_values_["sm.disk_cache.dir"] = sm_params_.disk_cache_dir_;
+  } else if (param == "sm.disk_cache.size") {
+    sm_params_.disk_cache_size_ = constants::disk_cache_size;
+    value << sm_params_.disk_cache_size_;
+    param_values_["sm.disk_cache.size"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.array_schema_cache_size") {
     sm_params_.array_schema_cache_size_ = constants::array_schema_cache_size;
     value << sm_params_.array_schema_cache_size_;
     param_values_["sm.array_schema_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.consolidation.steps") {
+    sm_params_.consolidation_steps_ = constants::consolidation_steps;
+    value << sm_params_.consolidation_steps_;
+    param_values_["sm.consolidation.steps"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.step_min_frags") {
+    sm_params_.consolidation_step_min_frags_ =
+        constants::consolidation_step_min_frags;
+    value << sm_params_.consolidation_step_min_frags_;
+    param_values_["sm.consolidation.step_min_frags"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.step_max_frags") {
+    sm_params_.consolidation_step_max_frags_ =
+        constants::consolidation_step_max_frags;
+    value << sm_params_.consolidation_step_max_frags_;
+    param_values_["sm.consolidation.step_max_frags"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.step_size_ratio") {
+    sm_params_.consolidation_step_size_ratio_ =
+        constants::consolidation_step_size_ratio;
+    value << sm_params_.consolidation_step_size_ratio_;
+    param_values_["sm.consolidation.step_size_ratio"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.checkpoint_frequency") {
+    sm_params_.consolidation_checkpoint_freq_ =
+        constants::consolidation_checkpoint_freq;
+    value << sm_params_.consolidation_checkpoint_freq_;
+    param_values_["sm.consolidation.checkpoint_frequency"] = value.str();
+  } else if (param == "sm.consolidation.scheduler_enable") {
+    sm_params_.consolidation_scheduler_enable_ =
+        constants::consolidation_scheduler_enable;
+    value << ((sm_params_.consolidation_scheduler_enable_) ? "true" : "false");
+    param_values_["sm.consolidation.scheduler_enable"] = value.str();
+  } else if (param == "sm.consolidation.scheduler_frag_threshold") {
+    sm_params_.consolidation_scheduler_frag_threshold_ =
+        constants::consolidation_scheduler_frag_threshold;
+    value << sm_params_.consolidation_scheduler_frag_threshold_;
+    param_values_["sm.consolidation.scheduler_frag_threshold"] = value.str();
+  } else if (param == "sm.consolidation.scheduler_interval_ms") {
+    sm_params_.consolidation_scheduler_interval_ms_ =
+        constants::consolidation_scheduler_interval_ms;
+    value << sm_params_.consolidation_scheduler_interval_ms_;
+    param_values_["sm.consolidation.scheduler_interval_ms"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.fragment_metadata_cache_size") {
     sm_params_.fragment_metadata_cache_size_ =
         constants::fragment_metadata_cache_size;
     value << sm_params_.fragment_metadata_cache_size_;
     param_values_["sm.fragment_metadata_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.max_parallel_ops") {
+    sm_params_.max_parallel_ops_ = constants::sm_max_parallel_ops;
+    value << sm_params_.max_parallel_ops_;
+    param_values_["sm.max_parallel_ops"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.async_worker_num") {
+    sm_params_.async_worker_num_ = constants::sm_async_worker_num;
+    value << sm_params_.async_worker_num_;
+    param_values_["sm.async_worker_num"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.enable_checksums") {
+    sm_params_.enable_checksums_ = constants::sm_enable_checksums;
+    value << ((sm_params_.enable_checksums_) ? "true" : "false");
+    param_values_["sm.enable_checksums"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.concurrency.total_budget") {
+    sm_params_.concurrency_params_.total_budget_ =
+        constants::sm_concurrency_total_budget;
+    value << sm_params_.concurrency_params_.total_budget_;
+    param_values_["sm.concurrency.total_budget"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.concurrency.io_ratio") {
+    sm_params_.concurrency_params_.io_ratio_ =
+        constants::sm_concurrency_io_ratio;
+    value << sm_params_.concurrency_params_.io_ratio_;
+    param_values_["sm.concurrency.io_ratio"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.concurrency.per_query_cap") {
+    sm_params_.concurrency_params_.per_query_cap_ =
+        constants::sm_concurrency_per_query_cap;
+    value << sm_params_.concurrency_params_.per_query_cap_;
+    param_values_["sm.concurrency.per_query_cap"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.memory_budget") {
+    sm_params_.memory_budget_ = constants::sm_memory_budget;
+    value << sm_params_.memory_budget_;
+    param_values_["sm.memory_budget"] = value.str();
+  } else if (param == "sm.read_partition_budget") {
+    sm_params_.read_partition_budget_ = constants::sm_read_partition_budget;
+    value << sm_params_.read_partition_budget_;
+    param_values_["sm.read_partition_budget"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.write_combining_budget") {
+    sm_params_.write_combining_budget_ = constants::sm_write_combining_budget;
+    value << sm_params_.write_combining_budget_;
+    param_values_["sm.write_combining_budget"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.array_open_timestamp") {
+    sm_params_.array_open_timestamp_ = constants::sm_array_open_timestamp;
+    value << sm_params_.array_open_timestamp_;
+    param_values_["sm.array_open_timestamp"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.generic_tile_prefix_size") {
+    sm_params_.generic_tile_prefix_size_ =
+        constants::sm_generic_tile_prefix_size;
+    value << sm_params_.generic_tile_prefix_size_;
+    param_values_["sm.generic_tile_prefix_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.hugepage_threshold") {
+    sm_params_.hugepage_threshold_ = constants::sm_hugepage_threshold;
+    value << sm_params_.hugepage_threshold_;
+    param_values_["sm.hugepage_threshold"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.streaming_store_threshold") {
+    sm_params_.streaming_store_threshold_ =
+        constants::sm_streaming_store_threshold;
+    value << sm_params_.streaming_store_threshold_;
+    param_values_["sm.streaming_store_threshold"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.numa_aware") {
+    sm_params_.numa_aware_ = constants::sm_numa_aware;
+    value << ((sm_params_.numa_aware_) ? "true" : "false");
+    param_values_["sm.numa_aware"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.shared_thread_pools") {
+    sm_params_.shared_thread_pools_ = constants::sm_shared_thread_pools;
+    value << ((sm_params_.shared_thread_pools_) ? "true" : "false");
+    param_values_["sm.shared_thread_pools"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.tile_prefetch") {
+    sm_params_.tile_prefetch_ = constants::sm_tile_prefetch;
+    value << ((sm_params_.tile_prefetch_) ? "true" : "false");
+    param_values_["sm.tile_prefetch"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.max_parallel_ops") {
     vfs_params_.max_parallel_ops_ = constants::vfs_max_parallel_ops;
     value << vfs_params_.max_parallel_ops_;
@@ -243,6 +461,31 @@ Status Config::unset(const std::string& param) {
     value << vfs_params_.min_parallel_size_;
     param_values_["vfs.min_parallel_size"] = value.str();
     value.str(std::string());
+  } else if (param == "vfs.max_batch_read_gap") {
+    vfs_params_.max_batch_read_gap_ = constants::vfs_max_batch_read_gap;
+    value << vfs_params_.max_batch_read_gap_;
+    param_values_["vfs.max_batch_read_gap"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.min_direct_write_size") {
+    vfs_params_.min_direct_write_size_ = constants::vfs_min_direct_write_size;
+    value << vfs_params_.min_direct_write_size_;
+    param_values_["vfs.min_direct_write_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.write_buffer_size") {
+    vfs_params_.write_buffer_size_ = constants::vfs_write_buffer_size;
+    value << vfs_params_.write_buffer_size_;
+    param_values_["vfs.write_buffer_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.exists_cache_ttl_ms") {
+    vfs_params_.exists_cache_ttl_ms_ = constants::vfs_exists_cache_ttl_ms;
+    value << vfs_params_.exists_cache_ttl_ms_;
+    param_values_["vfs.exists_cache_ttl_ms"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.map_reads") {
+    vfs_params_.map_reads_ = constants::vfs_map_reads;
+    value << ((vfs_params_.map_reads_) ? "true" : "false");
+    param_values_["vfs.map_reads"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.s3.region") {
     vfs_params_.s3_params_.region_ = constants::s3_region;
     value << vfs_params_.s3_params_.region_;
@@ -266,12 +509,22 @@ Status Config::unset(const std::string& param) {
                                                                "false");
     param_values_["vfs.s3.use_virtual_addressing"] = value.str();
     value.str(std::string());
+  } else if (param == "vfs.s3.max_parallel_ops") {
+    vfs_params_.s3_params_.max_parallel_ops_ = constants::s3_max_parallel_ops;
+    value << vfs_params_.s3_params_.max_parallel_ops_;
+    param_values_["vfs.s3.max_parallel_ops"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.s3.multipart_part_size") {
     vfs_params_.s3_params_.multipart_part_size_ =
         constants::s3_multipart_part_size;
     value << vfs_params_.s3_params_.multipart_part_size_;
     param_values_["vfs.s3.multipart_part_size"] = value.str();
     value.str(std::string());
+  } else if (param == "vfs.s3.max_connections") {
+    vfs_params_.s3_params_.max_connections_ = constants::s3_max_connections;
+    value << vfs_params_.s3_params_.max_connections_;
+    param_values_["vfs.s3.max_connections"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.s3.connect_timeout_ms") {
     vfs_params_.s3_params_.connect_timeout_ms_ =
         constants::s3_connect_timeout_ms;
@@ -311,6 +564,34 @@ Status Config::unset(const std::string& param) {
     value << vfs_params_.hdfs_params_.kerb_ticket_cache_path_;
     param_values_["vfs.hdfs.kerb_ticket_cache_path"] = value.str();
     value.str(std::string());
+  } else if (param == "vfs.hdfs.read_buffer_size") {
+    vfs_params_.hdfs_params_.read_buffer_size_ =
+        constants::hdfs_read_buffer_size;
+    value << vfs_params_.hdfs_params_.read_buffer_size_;
+    param_values_["vfs.hdfs.read_buffer_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.hdfs.write_buffer_size") {
+    vfs_params_.hdfs_params_.write_buffer_size_ =
+        constants::hdfs_write_buffer_size;
+    value << vfs_params_.hdfs_params_.write_buffer_size_;
+    param_values_["vfs.hdfs.write_buffer_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.hdfs.block_size") {
+    vfs_params_.hdfs_params_.block_size_ = constants::hdfs_block_size;
+    value << vfs_params_.hdfs_params_.block_size_;
+    param_values_["vfs.hdfs.block_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.hdfs.readahead") {
+    vfs_params_.hdfs_params_.readahead_ = constants::hdfs_readahead;
+    value << vfs_params_.hdfs_params_.readahead_;
+    param_values_["vfs.hdfs.readahead"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.hdfs.max_open_read_files") {
+    vfs_params_.hdfs_params_.max_open_read_files_ =
+        constants::hdfs_max_open_read_files;
+    value << vfs_params_.hdfs_params_.max_open_read_files_;
+    param_values_["vfs.hdfs.max_open_read_files"] = value.str();
+    value.str(std::string());
   }
 
   return Status::Ok();
@@ -327,14 +608,119 @@ void Config::set_default_param_values() {
   param_values_["sm.tile_cache_size"] = value.str();
   value.str(std::string());
 
+  param_values_["sm.tile_cache_compressed"] =
+      (sm_params_.tile_cache_compressed_) ? "true" : "false";
+
+  param_values_["sm.disk_cache.dir"] = sm_params_.disk_cache_dir_;
+
+  value << sm_params_.disk_cache_size_;
+  param_values_["sm.disk_cache.size"] = value.str();
+  value.str(std::string());
+
   value << sm_params_.array_schema_cache_size_;
   param_values_["sm.array_schema_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.consolidation_steps_;
+  param_values_["sm.consolidation.steps"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_step_min_frags_;
+  param_values_["sm.consolidation.step_min_frags"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_step_max_frags_;
+  param_values_["sm.consolidation.step_max_frags"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_step_size_ratio_;
+  param_values_["sm.consolidation.step_size_ratio"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_checkpoint_freq_;
+  param_values_["sm.consolidation.checkpoint_frequency"] = value.str();
+  value.str(std::string());
+
+  value << ((sm_params_.consolidation_scheduler_enable_) ? "true" : "false");
+  param_values_["sm.consolidation.scheduler_enable"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_scheduler_frag_threshold_;
+  param_values_["sm.consolidation.scheduler_frag_threshold"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_scheduler_interval_ms_;
+  param_values_["sm.consolidation.scheduler_interval_ms"] = value.str();
+  value.str(std::string());
+
   value << sm_params_.fragment_metadata_cache_size_;
   param_values_["sm.fragment_metadata_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.max_parallel_ops_;
+  param_values_["sm.max_parallel_ops"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.async_worker_num_;
+  param_values_["sm.async_worker_num"] = value.str();
+  value.str(std::string());
+
+  value << ((sm_params_.enable_checksums_) ? "true" : "false");
+  param_values_["sm.enable_checksums"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.concurrency_params_.total_budget_;
+  param_values_["sm.concurrency.total_budget"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.concurrency_params_.io_ratio_;
+  param_values_["sm.concurrency.io_ratio"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.concurrency_params_.per_query_cap_;
+  param_values_["sm.concurrency.per_query_cap"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.memory_budget_;
+  param_values_["sm.memory_budget"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.read_partition_budget_;
+  param_values_["sm.read_partition_budget"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.write_combining_budget_;
+  param_values_["sm.write_combining_budget"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.array_open_timestamp_;
+  param_values_["sm.array_open_timestamp"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.generic_tile_prefix_size_;
+  param_values_["sm.generic_tile_prefix_size"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.hugepage_threshold_;
+  param_values_["sm.hugepage_threshold"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.streaming_store_threshold_;
+  param_values_["sm.streaming_store_threshold"] = value.str();
+  value.str(std::string());
+
+  value << ((sm_params_.numa_aware_) ? "true" : "false");
+  param_values_["sm.numa_aware"] = value.str();
+  value.str(std::string());
+
+  value << ((sm_params_.shared_thread_pools_) ? "true" : "false");
+  param_values_["sm.shared_thread_pools"] = value.str();
+  value.str(std::string());
+
+  value << ((sm_params_.tile_prefetch_) ? "true" : "false");
+  param_values_["sm.tile_prefetch"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.max_parallel_ops_;
   param_values_["vfs.max_parallel_ops"] = value.str();
   value.str(std::string());
@@ -343,6 +729,26 @@ void Config::set_default_param_values() {
   param_values_["vfs.min_parallel_size"] = value.str();
   value.str(std::string());
 
+  value << vfs_params_.max_batch_read_gap_;
+  param_values_["vfs.max_batch_read_gap"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.min_direct_write_size_;
+  param_values_["vfs.min_direct_write_size"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.write_buffer_size_;
+  param_values_["vfs.write_buffer_size"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.exists_cache_ttl_ms_;
+  param_values_["vfs.exists_cache_ttl_ms"] = value.str();
+  value.str(std::string());
+
+  value << ((vfs_params_.map_reads_) ? "true" : "false");
+  param_values_["vfs.map_reads"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.s3_params_.region_;
   param_values_["vfs.s3.region"] = value.str();
   value.str(std::string());
@@ -360,10 +766,18 @@ void Config::set_default_param_values() {
   param_values_["vfs.s3.use_virtual_addressing"] = value.str();
   value.str(std::string());
 
+  value << vfs_params_.s3_params_.max_parallel_ops_;
+  param_values_["vfs.s3.max_parallel_ops"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.s3_params_.multipart_part_size_;
   param_values_["vfs.s3.multipart_part_size"] = value.str();
   value.str(std::string());
 
+  value << vfs_params_.s3_params_.max_connections_;
+  param_values_["vfs.s3.max_connections"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.s3_params_.connect_timeout_ms_;
   param_values_["vfs.s3.connect_timeout_ms"] = value.str();
   value.str(std::string());
@@ -391,6 +805,26 @@ void Config::set_default_param_values() {
   value << vfs_params_.hdfs_params_.kerb_ticket_cache_path_;
   param_values_["vfs.hdfs.kerb_ticket_cache_path"] = value.str();
   value.str(std::string());
+
+  value << vfs_params_.hdfs_params_.read_buffer_size_;
+  param_values_["vfs.hdfs.read_buffer_size"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.hdfs_params_.write_buffer_size_;
+  param_values_["vfs.hdfs.write_buffer_size"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.hdfs_params_.block_size_;
+  param_values_["vfs.hdfs.block_size"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.hdfs_params_.readahead_;
+  param_values_["vfs.hdfs.readahead"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.hdfs_params_.max_open_read_files_;
+  param_values_["vfs.hdfs.max_open_read_files"] = value.str();
+  value.str(std::string());
 }
 
 Status Config::parse_bool(const std::string& value, bool* result) {
@@ -422,6 +856,98 @@ Status Config::set_sm_fragment_metadata_cache_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_consolidation_steps(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_steps_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_step_min_frags(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_step_min_frags_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_step_max_frags(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_step_max_frags_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_step_size_ratio(const std::string& value) {
+  float v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (v < 0.0f || v > 1.0f)
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid consolidation step size ratio"));
+  sm_params_.consolidation_step_size_ratio_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_checkpoint_freq(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_checkpoint_freq_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_scheduler_enable(
+    const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid consolidation scheduler value"));
+  }
+  sm_params_.consolidation_scheduler_enable_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_scheduler_frag_threshold(
+    const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_scheduler_frag_threshold_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_consolidation_scheduler_interval_ms(
+    const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (v == 0)
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid consolidation scheduler interval"));
+  sm_params_.consolidation_scheduler_interval_ms_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_max_parallel_ops(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.max_parallel_ops_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_async_worker_num(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.async_worker_num_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_sm_tile_cache_size(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -430,6 +956,158 @@ Status Config::set_sm_tile_cache_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_disk_cache_dir(const std::string& value) {
+  sm_params_.disk_cache_dir_ = value;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_disk_cache_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.disk_cache_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_tile_cache_compressed(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid compressed tile cache value"));
+  }
+  sm_params_.tile_cache_compressed_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_enable_checksums(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid checksum enabling value"));
+  }
+  sm_params_.enable_checksums_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_concurrency_total_budget(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.concurrency_params_.total_budget_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_concurrency_io_ratio(const std::string& value) {
+  float v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (v < 0.0f || v > 1.0f)
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid concurrency I/O ratio"));
+  sm_params_.concurrency_params_.io_ratio_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_concurrency_per_query_cap(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.concurrency_params_.per_query_cap_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_memory_budget(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.memory_budget_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_read_partition_budget(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.read_partition_budget_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_write_combining_budget(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.write_combining_budget_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_array_open_timestamp(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.array_open_timestamp_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_generic_tile_prefix_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.generic_tile_prefix_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_hugepage_threshold(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.hugepage_threshold_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_streaming_store_threshold(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.streaming_store_threshold_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_numa_aware(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid NUMA awareness value"));
+  }
+  sm_params_.numa_aware_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_shared_thread_pools(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid shared thread pools value"));
+  }
+  sm_params_.shared_thread_pools_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_tile_prefetch(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid tile prefetch value"));
+  }
+  sm_params_.tile_prefetch_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_max_parallel_ops(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -446,6 +1124,49 @@ Status Config::set_vfs_min_parallel_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_vfs_max_batch_read_gap(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.max_batch_read_gap_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_min_direct_write_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.min_direct_write_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_write_buffer_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.write_buffer_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_exists_cache_ttl_ms(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.exists_cache_ttl_ms_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_map_reads(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid map reads value"));
+  }
+  vfs_params_.map_reads_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_s3_region(const std::string& value) {
   vfs_params_.s3_params_.region_ = value;
   return Status::Ok();
@@ -474,6 +1195,14 @@ Status Config::set_vfs_s3_use_virtual_addressing(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_vfs_s3_max_parallel_ops(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.s3_params_.max_parallel_ops_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_s3_multipart_part_size(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -482,6 +1211,14 @@ Status Config::set_vfs_s3_multipart_part_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_vfs_s3_max_connections(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.s3_params_.max_connections_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_s3_connect_timeout_ms(const std::string& value) {
   long v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -526,5 +1263,40 @@ Status Config::set_vfs_hdfs_kerb_ticket_cache_path(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_vfs_hdfs_read_buffer_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.hdfs_params_.read_buffer_size_ = v;
+  return Status::Ok();
+}
+
+Status Config::set_vfs_hdfs_write_buffer_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.hdfs_params_.write_buffer_size_ = v;
+  return Status::Ok();
+}
+
+Status Config::set_vfs_hdfs_block_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.hdfs_params_.block_size_ = v;
+  return Status::Ok();
+}
+
+Status Config::set_vfs_hdfs_readahead(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.hdfs_params_.readahead_ = v;
+  return Status::Ok();
+}
+
+Status Config::set_vfs_hdfs_max_open_read_files(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.hdfs_params_.max_open_read_files_ = v;
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
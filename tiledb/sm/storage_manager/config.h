@@ -49,16 +49,96 @@ class Config {
   /*         TYPE DEFINITIONS          */
   /* ********************************* */
 
+  /**
+   * Concurrency parameters, bounding the CPU footprint of a TileDB
+   * instance in co-tenanted deployments.
+   */
+  struct ConcurrencyParams {
+    /**
+     * The total concurrency budget, i.e. the total number of threads in
+     * the compute and I/O thread pools combined. A value of 0 means no
+     * explicit budget; the pools are sized independently from
+     * `sm.max_parallel_ops` and `vfs.max_parallel_ops`.
+     */
+    uint64_t total_budget_;
+
+    /** The fraction of the concurrency budget given to I/O threads. */
+    float io_ratio_;
+
+    /**
+     * The cap on the number of parallel operations a single query may
+     * have in flight. A value of 0 means unbounded.
+     */
+    uint64_t per_query_cap_;
+
+    ConcurrencyParams() {
+      total_budget_ = constants::sm_concurrency_total_budget;
+      io_ratio_ = constants::sm_concurrency_io_ratio;
+      per_query_cap_ = constants::sm_concurrency_per_query_cap;
+    }
+  };
+
   /** Storage manager parameters. */
   struct SMParams {
     uint64_t array_schema_cache_size_;
+    uint64_t async_worker_num_;
+    uint64_t consolidation_steps_;
+    uint64_t consolidation_step_min_frags_;
+    uint64_t consolidation_step_max_frags_;
+    float consolidation_step_size_ratio_;
+    uint64_t consolidation_checkpoint_freq_;
+    bool consolidation_scheduler_enable_;
+    uint64_t consolidation_scheduler_frag_threshold_;
+    uint64_t consolidation_scheduler_interval_ms_;
     uint64_t fragment_metadata_cache_size_;
+    uint64_t hugepage_threshold_;
+    uint64_t max_parallel_ops_;
+    uint64_t memory_budget_;
+    uint64_t read_partition_budget_;
+    uint64_t write_combining_budget_;
+    uint64_t array_open_timestamp_;
+    uint64_t generic_tile_prefix_size_;
+    uint64_t streaming_store_threshold_;
     uint64_t tile_cache_size_;
+    bool tile_cache_compressed_;
+    std::string disk_cache_dir_;
+    uint64_t disk_cache_size_;
+    bool enable_checksums_;
+    bool numa_aware_;
+    bool shared_thread_pools_;
+    bool tile_prefetch_;
+    ConcurrencyParams concurrency_params_;
 
     SMParams() {
       array_schema_cache_size_ = constants::array_schema_cache_size;
+      async_worker_num_ = constants::sm_async_worker_num;
+      consolidation_steps_ = constants::consolidation_steps;
+      consolidation_step_min_frags_ = constants::consolidation_step_min_frags;
+      consolidation_step_max_frags_ = constants::consolidation_step_max_frags;
+      consolidation_step_size_ratio_ = constants::consolidation_step_size_ratio;
+      consolidation_checkpoint_freq_ = constants::consolidation_checkpoint_freq;
+      consolidation_scheduler_enable_ = constants::consolidation_scheduler_enable;
+      consolidation_scheduler_frag_threshold_ =
+          constants::consolidation_scheduler_frag_threshold;
+      consolidation_scheduler_interval_ms_ =
+          constants::consolidation_scheduler_interval_ms;
       fragment_metadata_cache_size_ = constants::fragment_metadata_cache_size;
+      hugepage_threshold_ = constants::sm_hugepage_threshold;
+      max_parallel_ops_ = constants::sm_max_parallel_ops;
+      memory_budget_ = constants::sm_memory_budget;
+      read_partition_budget_ = constants::sm_read_partition_budget;
+      write_combining_budget_ = constants::sm_write_combining_budget;
+      array_open_timestamp_ = constants::sm_array_open_timestamp;
+      generic_tile_prefix_size_ = constants::sm_generic_tile_prefix_size;
+      streaming_store_threshold_ = constants::sm_streaming_store_threshold;
       tile_cache_size_ = constants::tile_cache_size;
+      tile_cache_compressed_ = constants::tile_cache_compressed;
+      disk_cache_dir_ = constants::disk_cache_dir;
+      disk_cache_size_ = constants::disk_cache_size;
+      enable_checksums_ = constants::sm_enable_checksums;
+      numa_aware_ = constants::sm_numa_aware;
+      shared_thread_pools_ = constants::sm_shared_thread_pools;
+      tile_prefetch_ = constants::sm_tile_prefetch;
     }
   };
 
@@ -67,18 +147,22 @@ class Config {
     std::string scheme_;
     std::string endpoint_override_;
     bool use_virtual_addressing_;
+    uint64_t max_parallel_ops_;
     uint64_t multipart_part_size_;
     long connect_timeout_ms_;
     long connect_max_tries_;
     long connect_scale_factor_;
     long request_timeout_ms_;
+    uint64_t max_connections_;
 
     S3Params() {
       region_ = constants::s3_region;
       scheme_ = constants::s3_scheme;
       endpoint_override_ = constants::s3_endpoint_override;
       use_virtual_addressing_ = constants::s3_use_virtual_addressing;
+      max_parallel_ops_ = constants::s3_max_parallel_ops;
       multipart_part_size_ = constants::s3_multipart_part_size;
+      max_connections_ = constants::s3_max_connections;
       connect_timeout_ms_ = constants::s3_connect_timeout_ms;
       connect_max_tries_ = constants::s3_connect_max_tries;
       connect_scale_factor_ = constants::s3_connect_scale_factor;
@@ -90,11 +174,21 @@ class Config {
     std::string name_node_uri_;
     std::string username_;
     std::string kerb_ticket_cache_path_;
+    uint64_t read_buffer_size_;
+    uint64_t write_buffer_size_;
+    uint64_t block_size_;
+    uint64_t readahead_;
+    uint64_t max_open_read_files_;
 
     HDFSParams() {
       kerb_ticket_cache_path_ = constants::hdfs_kerb_ticket_cache_path;
       name_node_uri_ = constants::hdfs_name_node_uri;
       username_ = constants::hdfs_username;
+      read_buffer_size_ = constants::hdfs_read_buffer_size;
+      write_buffer_size_ = constants::hdfs_write_buffer_size;
+      block_size_ = constants::hdfs_block_size;
+      readahead_ = constants::hdfs_readahead;
+      max_open_read_files_ = constants::hdfs_max_open_read_files;
     }
   };
 
@@ -103,10 +197,20 @@ class Config {
     HDFSParams hdfs_params_;
     uint64_t max_parallel_ops_;
     uint64_t min_parallel_size_;
+    uint64_t max_batch_read_gap_;
+    uint64_t min_direct_write_size_;
+    uint64_t write_buffer_size_;
+    uint64_t exists_cache_ttl_ms_;
+    bool map_reads_;
 
     VFSParams() {
       max_parallel_ops_ = constants::vfs_max_parallel_ops;
       min_parallel_size_ = constants::vfs_min_parallel_size;
+      max_batch_read_gap_ = constants::vfs_max_batch_read_gap;
+      min_direct_write_size_ = constants::vfs_min_direct_write_size;
+      write_buffer_size_ = constants::vfs_write_buffer_size;
+      exists_cache_ttl_ms_ = constants::vfs_exists_cache_ttl_ms;
+      map_reads_ = constants::vfs_map_reads;
     }
   };
 
@@ -149,6 +253,20 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.tile_cache_compressed` <br>
+   *    If `true`, the tile cache stores the compressed tile bytes instead
+   *    of the decompressed tiles, multiplying the effective cache capacity
+   *    by the compression ratio at the cost of decompressing on every
+   *    cache hit. <br>
+   *    **Default**: false
+   * - `sm.disk_cache.dir` <br>
+   *    The directory of the on-disk second-tier tile cache. An empty
+   *    string disables the disk cache. <br>
+   *    **Default**: ""
+   * - `sm.disk_cache.size` <br>
+   *    The on-disk tile cache size in bytes. Any `uint64_t` value is
+   *    acceptable. <br>
+   *    **Default**: 10,737,418,240
    * - `sm.array_schema_cache_size` <br>
    *    Array schema cache size in bytes. Any `uint64_t` value is acceptable.
    * <br>
@@ -157,6 +275,125 @@ class Config {
    *    The fragment metadata cache size in bytes. Any `uint64_t` value is
    *    acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.consolidation.steps` <br>
+   *    The maximum number of incremental consolidation steps. In each
+   *    step, a window of adjacent fragments with similar sizes gets
+   *    merged into a single fragment. <br>
+   *    **Default**: UINT64_MAX
+   * - `sm.consolidation.step_min_frags` <br>
+   *    The minimum number of fragments to merge in a consolidation
+   *    step. <br>
+   *    **Default**: 2
+   * - `sm.consolidation.step_max_frags` <br>
+   *    The maximum number of fragments to merge in a consolidation
+   *    step. <br>
+   *    **Default**: UINT64_MAX
+   * - `sm.consolidation.step_size_ratio` <br>
+   *    The minimum size ratio between the smallest and largest fragment
+   *    in a window, for the window to qualify for a consolidation step.
+   *    Any value in `[0.0, 1.0]` is acceptable. <br>
+   *    **Default**: 0.0
+   * - `sm.consolidation.checkpoint_frequency` <br>
+   *    The number of copied subarrays after which a sparse consolidation
+   *    checkpoints its progress, so that a killed consolidation resumes
+   *    from the last checkpoint instead of restarting from scratch. A
+   *    value of 0 disables checkpointing. <br>
+   *    **Default**: 0
+   * - `sm.consolidation.scheduler_enable` <br>
+   *    If `true`, a background scheduler periodically checks the
+   *    fragment count of the open arrays and consolidates the arrays
+   *    whose count crossed `sm.consolidation.scheduler_frag_threshold`,
+   *    without any manual `tiledb_array_consolidate` calls. <br>
+   *    **Default**: false
+   * - `sm.consolidation.scheduler_frag_threshold` <br>
+   *    The number of fragments beyond which the consolidation scheduler
+   *    consolidates an open array. <br>
+   *    **Default**: 10
+   * - `sm.consolidation.scheduler_interval_ms` <br>
+   *    The interval (in ms) between consolidation scheduler scans. <br>
+   *    **Default**: 60000
+   * - `sm.max_parallel_ops` <br>
+   *    The maximum number of parallel operations in the storage manager,
+   *    e.g. the number of tiles compressed concurrently. This determines
+   *    the size of the storage manager compute thread pool. <br>
+   *    **Default**: number of cores
+   * - `sm.async_worker_num` <br>
+   *    The number of worker threads that process the async query queue. <br>
+   *    **Default**: 2
+   * - `sm.enable_checksums` <br>
+   *    If `true`, per-chunk CRC32C checksums are written to compressed
+   *    tiles and verified upon reading. <br>
+   *    **Default**: false
+   * - `sm.concurrency.total_budget` <br>
+   *    The total number of threads in the compute and I/O thread pools
+   *    combined. If greater than 0, it overrides `sm.max_parallel_ops`
+   *    and `vfs.max_parallel_ops` when sizing the pools, with the split
+   *    determined by `sm.concurrency.io_ratio`. <br>
+   *    **Default**: 0 (no explicit budget)
+   * - `sm.concurrency.io_ratio` <br>
+   *    The fraction of the concurrency budget given to I/O threads, the
+   *    rest going to compute threads. Only meaningful when
+   *    `sm.concurrency.total_budget` is set. Any value in `[0.0, 1.0]`
+   *    is acceptable. <br>
+   *    **Default**: 0.5
+   * - `sm.concurrency.per_query_cap` <br>
+   *    The cap on the number of parallel operations a single query may
+   *    have in flight (e.g. concurrent tile decompressions), so that
+   *    one query cannot monopolize the thread pools. <br>
+   *    **Default**: 0 (unbounded)
+   * - `sm.memory_budget` <br>
+   *    The memory budget (in bytes) that the caches and per-query tile
+   *    buffers charge against. When the budget is hit, the read path
+   *    fetches tiles in smaller batches instead of all at once. The
+   *    budget should exceed the combined cache sizes. <br>
+   *    **Default**: 0 (unbounded)
+   * - `sm.read_partition_budget` <br>
+   *    The budget (in bytes) of tiles a read query materializes at
+   *    once. Reads whose overlapping tiles are estimated to exceed the
+   *    budget are processed in internal subarray partitions, streaming
+   *    the result partition-by-partition with bounded memory. <br>
+   *    **Default**: 536870912 (512MB); 0 disables partitioning
+   * - `sm.hugepage_threshold` <br>
+   *    The buffer size (in bytes) above which allocations are
+   *    hugepage-aligned and advised to be backed by transparent
+   *    hugepages, reducing dTLB pressure when large tiles are
+   *    decompressed and copied. Only effective on Linux. <br>
+   *    **Default**: 0 (disabled)
+   * - `sm.streaming_store_threshold` <br>
+   *    The result size (in bytes) above which the final cell copy into
+   *    the user buffers uses non-temporal (streaming) stores, so that
+   *    large results that are written once and not read back do not
+   *    evict the decompression working sets from the CPU caches. Only
+   *    effective on x86. <br>
+   *    **Default**: 4194304 (4MB); 0 disables streaming stores
+   * - `sm.numa_aware` <br>
+   *    If `true` and the machine has more than one NUMA node, the
+   *    compute and I/O thread pool workers are partitioned into
+   *    per-node sub-pools pinned to their node's CPUs, and idle
+   *    workers steal same-node tasks before crossing sockets. With
+   *    first-touch memory placement, a tile is then fetched,
+   *    decompressed and copied on the same socket. Only effective on
+   *    Linux. <br>
+   *    **Default**: false
+   * - `sm.shared_thread_pools` <br>
+   *    If `true`, the context references a single process-wide pair of
+   *    compute and I/O thread pools, shared by all contexts created
+   *    with this setting, instead of creating its own. The shared pools
+   *    are sized by the configuration of the first context that creates
+   *    them, so the process thread count reflects the hardware rather
+   *    than the number of contexts. <br>
+   *    **Default**: false
+   * - `sm.tile_prefetch` <br>
+   *    If `true`, the per-file sequence of compressed-tile requests
+   *    reaching the tile cache is monitored, and once the requests
+   *    repeat a constant stride with a constant size, the next tile in
+   *    the sequence is speculatively fetched into the cache in the
+   *    background. This hides the backend read latency of predictable
+   *    access patterns, such as panning across a dense array. Implies
+   *    `sm.tile_cache_compressed`, as the prefetcher caches raw file
+   *    bytes, which only match the tile cache contents when the cache
+   *    stores compressed tiles. <br>
+   *    **Default**: false
    * - `vfs.max_parallel_ops` <br>
    *    The maximum number of VFS parallel operations.<br>
    *    **Default**: number of cores
@@ -164,6 +401,31 @@ class Config {
    *    The minimum number of bytes in a parallel VFS operation. (Does not
    *    affect parallel S3 writes.)<br>
    *    **Default**: 10MB
+   * - `vfs.max_batch_read_gap` <br>
+   *    The maximum gap (in bytes) between two regions that get coalesced
+   *    into a single read in a batched VFS read.<br>
+   *    **Default**: 500KB
+   * - `vfs.min_direct_write_size` <br>
+   *    The minimum size (in bytes) of a posix write that is issued with
+   *    direct I/O, bypassing the page cache (applicable only to Linux).
+   *    A value of 0 disables direct writes.<br>
+   *    **Default**: 4MB
+   * - `vfs.write_buffer_size` <br>
+   *    The size (in bytes) of the write-combining buffer of a file opened
+   *    for writing, which coalesces small writes into a single backend
+   *    write. A value of 0 disables write combining.<br>
+   *    **Default**: 1MB
+   * - `vfs.exists_cache_ttl_ms` <br>
+   *    The time-to-live (in milliseconds) of a VFS existence cache entry.
+   *    A value of 0 disables the cache.<br>
+   *    **Default**: 10000
+   * - `vfs.map_reads` <br>
+   *    If `true`, uncompressed tiles of local files are read by
+   *    memory-mapping the file region, so the tile wraps the page
+   *    cache directly instead of copying through a read. Mapped tiles
+   *    bypass the tile cache, which the page cache substitutes for.
+   *    Only effective for the posix filesystem. <br>
+   *    **Default**: false
    * - `vfs.s3.region` <br>
    *    The S3 region, if S3 is enabled. <br>
    *    **Default**: us-east-1
@@ -177,12 +439,22 @@ class Config {
    *    The S3 use of virtual addressing (`true` or `false`), if S3 is
    *    enabled. <br>
    *    **Default**: true
+   * - `vfs.s3.max_parallel_ops` <br>
+   *    The maximum number of S3 backend parallel operations, e.g. the
+   *    number of multipart part uploads that may be in flight for an
+   *    object. <br>
+   *    **Default**: number of cores
    * - `vfs.s3.multipart_part_size` <br>
    *    The part size (in bytes) used in S3 multipart writes, if S3 is enabled.
    *    Any `uint64_t` value is acceptable. Note: `vfs.s3.multipart_part_size *
    *    vfs.max_parallel_ops` bytes will be buffered before issuing multipart
    *    uploads in parallel. <br>
    *    **Default**: 5*1024*1024
+   * - `vfs.s3.max_connections` <br>
+   *    The maximum number of pooled connections to S3. Parallel tile
+   *    fetches beyond this limit wait for a connection to free up rather
+   *    than establishing a new one. <br>
+   *    **Default**: 64
    * - `vfs.s3.connect_timeout_ms` <br>
    *    The connection timeout in ms. Any `long` value is acceptable. <br>
    *    **Default**: 3000
@@ -205,6 +477,26 @@ class Config {
    * - `vfs.hdfs.kerb_ticket_cache_path` <br>
    *    HDFS kerb ticket cache path. <br>
    *    **Default**: ""
+   * - `vfs.hdfs.read_buffer_size` <br>
+   *    Buffer size in bytes used when opening HDFS files for reading.
+   *    `0` uses the filesystem default. <br>
+   *    **Default**: 0
+   * - `vfs.hdfs.write_buffer_size` <br>
+   *    Buffer size in bytes used when opening HDFS files for writing.
+   *    `0` uses the filesystem default. <br>
+   *    **Default**: 0
+   * - `vfs.hdfs.block_size` <br>
+   *    Block size hint in bytes for newly created HDFS files. `0` uses
+   *    the filesystem default. <br>
+   *    **Default**: 0
+   * - `vfs.hdfs.readahead` <br>
+   *    Client readahead in bytes (sets `dfs.client.cache.readahead` on
+   *    the connection). `0` uses the filesystem default. <br>
+   *    **Default**: 0
+   * - `vfs.hdfs.max_open_read_files` <br>
+   *    Maximum number of open HDFS file handles pooled for reuse across
+   *    reads of the same file. <br>
+   *    **Default**: 64
    */
   Status set(const std::string& param, const std::string& value);
 
@@ -260,18 +552,118 @@ class Config {
   /** Sets the array metadata cache size, properly parsing the input value. */
   Status set_sm_array_schema_cache_size(const std::string& value);
 
+  /** Sets the max number of incremental consolidation steps. */
+  Status set_sm_consolidation_steps(const std::string& value);
+
+  /** Sets the min number of fragments to merge in a consolidation step. */
+  Status set_sm_consolidation_step_min_frags(const std::string& value);
+
+  /** Sets the max number of fragments to merge in a consolidation step. */
+  Status set_sm_consolidation_step_max_frags(const std::string& value);
+
+  /** Sets the min fragment size ratio of a consolidation step window. */
+  Status set_sm_consolidation_step_size_ratio(const std::string& value);
+
+  /** Sets the consolidation checkpoint frequency. */
+  Status set_sm_consolidation_checkpoint_freq(const std::string& value);
+
+  /** Enables or disables the background consolidation scheduler. */
+  Status set_sm_consolidation_scheduler_enable(const std::string& value);
+
+  /** Sets the fragment count threshold of the consolidation scheduler. */
+  Status set_sm_consolidation_scheduler_frag_threshold(
+      const std::string& value);
+
+  /** Sets the scan interval (in ms) of the consolidation scheduler. */
+  Status set_sm_consolidation_scheduler_interval_ms(const std::string& value);
+
   /** Sets the fragment metadata cache size, properly parsing the input value.*/
   Status set_sm_fragment_metadata_cache_size(const std::string& value);
 
+  /** Sets the max number of allowed storage manager parallel operations. */
+  Status set_sm_max_parallel_ops(const std::string& value);
+
+  /** Sets the number of async query worker threads. */
+  Status set_sm_async_worker_num(const std::string& value);
+
   /** Sets the tile cache size, properly parsing the input value. */
   Status set_sm_tile_cache_size(const std::string& value);
 
+  /** Sets whether the tile cache stores compressed tile bytes. */
+  Status set_sm_tile_cache_compressed(const std::string& value);
+
+  /** Sets the disk tile cache directory. */
+  Status set_sm_disk_cache_dir(const std::string& value);
+
+  /** Sets the disk tile cache size, properly parsing the input value. */
+  Status set_sm_disk_cache_size(const std::string& value);
+
+  /** Sets whether per-chunk tile checksums are enabled. */
+  Status set_sm_enable_checksums(const std::string& value);
+
+  /** Sets the total concurrency budget. */
+  Status set_sm_concurrency_total_budget(const std::string& value);
+
+  /** Sets the I/O fraction of the concurrency budget. */
+  Status set_sm_concurrency_io_ratio(const std::string& value);
+
+  /** Sets the per-query parallelism cap. */
+  Status set_sm_concurrency_per_query_cap(const std::string& value);
+
+  /** Sets the memory budget, properly parsing the input value. */
+  Status set_sm_memory_budget(const std::string& value);
+
+  /** Sets the read partition budget, properly parsing the input value. */
+  Status set_sm_read_partition_budget(const std::string& value);
+
+  /** Sets the write combining budget, properly parsing the input value. */
+  Status set_sm_write_combining_budget(const std::string& value);
+
+  /** Sets the array open timestamp, properly parsing the input value. */
+  Status set_sm_array_open_timestamp(const std::string& value);
+
+  /** Sets the generic tile prefix size, properly parsing the input value. */
+  Status set_sm_generic_tile_prefix_size(const std::string& value);
+
+  /** Sets the hugepage threshold, properly parsing the input value. */
+  Status set_sm_hugepage_threshold(const std::string& value);
+
+  /** Sets the streaming store threshold, properly parsing the input value. */
+  Status set_sm_streaming_store_threshold(const std::string& value);
+
+  /** Sets NUMA awareness of the thread pools, properly parsing the value. */
+  Status set_sm_numa_aware(const std::string& value);
+
+  /** Sets whether the process-wide thread pools are used, properly parsing
+   * the value. */
+  Status set_sm_shared_thread_pools(const std::string& value);
+
+  /** Sets whether the tile prefetcher is enabled, properly parsing the
+   * value. */
+  Status set_sm_tile_prefetch(const std::string& value);
+
   /** Sets the max number of allowed VFS parallel operations. */
   Status set_vfs_max_parallel_ops(const std::string& value);
 
   /** Sets the min number of bytes of a VFS parallel operation. */
   Status set_vfs_min_parallel_size(const std::string& value);
 
+  /** Sets the max gap between coalesced regions of a batched VFS read. */
+  Status set_vfs_max_batch_read_gap(const std::string& value);
+
+  /** Sets the minimum size of a posix write issued with direct I/O. */
+  Status set_vfs_min_direct_write_size(const std::string& value);
+
+  /** Sets the size of the VFS write-combining buffer. */
+  Status set_vfs_write_buffer_size(const std::string& value);
+
+  /** Sets the TTL of a VFS existence cache entry. */
+  Status set_vfs_exists_cache_ttl_ms(const std::string& value);
+
+  /** Sets whether local files are read via memory mapping, properly
+   * parsing the value. */
+  Status set_vfs_map_reads(const std::string& value);
+
   /** Sets the S3 region. */
   Status set_vfs_s3_region(const std::string& value);
 
@@ -285,8 +677,13 @@ class Config {
   Status set_vfs_s3_use_virtual_addressing(const std::string& value);
 
   /** Sets the S3 multipart part size. */
+  Status set_vfs_s3_max_parallel_ops(const std::string& value);
+
   Status set_vfs_s3_multipart_part_size(const std::string& value);
 
+  /** Sets the maximum number of pooled connections to S3. */
+  Status set_vfs_s3_max_connections(const std::string& value);
+
   /** Sets the S3 connect timeout in milliseconds. */
   Status set_vfs_s3_connect_timeout_ms(const std::string& value);
 
@@ -307,6 +704,21 @@ class Config {
 
   /** Sets the Kerberos auth ticket cache path */
   Status set_vfs_hdfs_kerb_ticket_cache_path(const std::string& value);
+
+  /** Sets the HDFS read buffer size in bytes. */
+  Status set_vfs_hdfs_read_buffer_size(const std::string& value);
+
+  /** Sets the HDFS write buffer size in bytes. */
+  Status set_vfs_hdfs_write_buffer_size(const std::string& value);
+
+  /** Sets the HDFS block size hint in bytes. */
+  Status set_vfs_hdfs_block_size(const std::string& value);
+
+  /** Sets the HDFS client readahead in bytes. */
+  Status set_vfs_hdfs_readahead(const std::string& value);
+
+  /** Sets the maximum number of pooled HDFS read file handles. */
+  Status set_vfs_hdfs_max_open_read_files(const std::string& value);
 };
 
 }  // namespace sm
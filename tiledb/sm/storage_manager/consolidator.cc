@@ -31,6 +31,7 @@
  */
 
 #include "tiledb/sm/storage_manager/consolidator.h"
+#include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
@@ -50,6 +51,7 @@ namespace sm {
 
 Consolidator::Consolidator(StorageManager* storage_manager)
     : storage_manager_(storage_manager) {
+  fill_scale_ = 1.0;
 }
 
 Consolidator::~Consolidator() = default;
@@ -59,8 +61,126 @@ Consolidator::~Consolidator() = default;
 /* ****************************** */
 
 Status Consolidator::consolidate(const char* array_name) {
-  std::vector<URI> old_fragment_uris;
-  URI new_fragment_uri;
+  uint64_t steps = storage_manager_->config().sm_params().consolidation_steps_;
+  bool consolidated;
+
+  // Consolidate incrementally, until no fragment window qualifies for
+  // merging or the maximum number of steps is reached
+  for (uint64_t step = 0; step < steps; ++step) {
+    RETURN_NOT_OK(consolidate_step(array_name, &consolidated));
+    if (!consolidated)
+      break;
+  }
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+void Consolidator::compute_next_to_consolidate(
+    const std::vector<FragmentMetadata*>& metadata,
+    bool dense,
+    std::vector<URI>* to_consolidate) const {
+  to_consolidate->clear();
+
+  // For easy reference
+  auto sm_params = storage_manager_->config().sm_params();
+  uint64_t fragment_num = metadata.size();
+  uint64_t min_frags =
+      std::max<uint64_t>(sm_params.consolidation_step_min_frags_, 2);
+  uint64_t max_frags =
+      std::min<uint64_t>(sm_params.consolidation_step_max_frags_, fragment_num);
+  auto size_ratio = sm_params.consolidation_step_size_ratio_;
+
+  if (fragment_num < min_frags || max_frags < min_frags)
+    return;
+
+  // Compute the fragment sizes
+  std::vector<uint64_t> sizes(fragment_num);
+  for (uint64_t i = 0; i < fragment_num; ++i)
+    sizes[i] = metadata[i]->fragment_size();
+
+  // Find the longest window (preferring the oldest fragments) whose
+  // smallest and largest fragments have similar sizes. For dense
+  // arrays only prefix windows are considered (see the declaration).
+  for (uint64_t len = max_frags; len >= min_frags; --len) {
+    uint64_t last_start = dense ? 0 : fragment_num - len;
+    for (uint64_t start = 0; start <= last_start; ++start) {
+      uint64_t min_size = sizes[start];
+      uint64_t max_size = sizes[start];
+      for (uint64_t i = start + 1; i < start + len; ++i) {
+        min_size = std::min(min_size, sizes[i]);
+        max_size = std::max(max_size, sizes[i]);
+      }
+      if (max_size == 0 || (float)min_size / (float)max_size >= size_ratio) {
+        for (uint64_t i = start; i < start + len; ++i)
+          to_consolidate->push_back(metadata[i]->fragment_uri());
+        return;
+      }
+    }
+  }
+}
+
+uint64_t Consolidator::compute_buffer_size(
+    const std::vector<FragmentMetadata*>& metadata,
+    const std::vector<URI>& to_consolidate,
+    const ArraySchema* array_schema) const {
+  // Compute the number of buffers in a set
+  auto attribute_num = array_schema->attribute_num();
+  uint64_t buffer_num = 0;
+  for (unsigned int i = 0; i < attribute_num; ++i)
+    buffer_num += (array_schema->var_size(i)) ? 2 : 1;
+  buffer_num += (array_schema->dense()) ? 0 : 1;
+
+  // Estimate the input size and the tile granularity from the metadata
+  // of the fragments to be consolidated
+  uint64_t total_size = 0;
+  uint64_t max_tile_size = 0;
+  for (auto meta : metadata) {
+    bool in_window = false;
+    for (const auto& uri : to_consolidate) {
+      if (meta->fragment_uri().to_string() == uri.to_string()) {
+        in_window = true;
+        break;
+      }
+    }
+    if (!in_window)
+      continue;
+
+    auto fragment_size = meta->fragment_size();
+    auto tile_num = meta->tile_num();
+    total_size += fragment_size;
+    if (tile_num > 0)
+      max_tile_size = std::max(max_tile_size, fragment_size / tile_num);
+  }
+
+  // A buffer larger than its share of the input data is wasted
+  uint64_t buffer_size = std::min(
+      constants::consolidation_buffer_size,
+      std::max<uint64_t>(total_size / buffer_num, 1));
+
+  // Both buffer sets must fit in the memory budget (if one is set)
+  auto memory_budget = storage_manager_->config().sm_params().memory_budget_;
+  if (memory_budget != 0)
+    buffer_size = std::min(buffer_size, memory_budget / (2 * buffer_num));
+
+  // Adapt to the fill rates observed in the previous steps
+  buffer_size = (uint64_t)(buffer_size * fill_scale_);
+
+  // A buffer must always fit the largest average tile
+  buffer_size = std::max(buffer_size, max_tile_size);
+  buffer_size = std::max(buffer_size, constants::consolidation_min_buffer_size);
+
+  return buffer_size;
+}
+
+Status Consolidator::consolidate_fragments(
+    const char* array_name,
+    const std::vector<URI>& to_consolidate,
+    uint64_t buffer_size,
+    Checkpoint* checkpoint) {
   URI array_uri = URI(array_name);
 
   // Get array schema
@@ -73,53 +193,71 @@ Status Consolidator::consolidate(const char* array_name) {
       create_subarray(array_uri.to_string(), array_schema, &subarray),
       delete array_schema);
 
-  // Prepare buffers
-  void** buffers;
-  uint64_t* buffer_sizes;
+  // Prepare two buffer sets, for the double-buffered copy
+  void** buffers_a;
+  uint64_t* buffer_sizes_a;
+  void** buffers_b;
+  uint64_t* buffer_sizes_b;
   unsigned int buffer_num;
   RETURN_NOT_OK_ELSE(
-      create_buffers(array_schema, &buffers, &buffer_sizes, &buffer_num),
+      create_buffers(
+          array_schema, buffer_size, &buffers_a, &buffer_sizes_a, &buffer_num),
       delete array_schema);
+  Status st = create_buffers(
+      array_schema, buffer_size, &buffers_b, &buffer_sizes_b, &buffer_num);
+  if (!st.ok()) {
+    free_buffers(buffer_num, buffers_a, buffer_sizes_a);
+    delete array_schema;
+    if (subarray != nullptr)
+      std::free(subarray);
+    return st;
+  }
 
   // Create queries
-  unsigned int fragment_num;
   auto query_r = new Query();
   auto query_w = new Query();
-  Status st = create_queries(
+  st = create_queries(
       query_r,
       query_w,
       subarray,
       array_name,
-      buffers,
-      buffer_sizes,
-      &fragment_num);
+      buffers_a,
+      buffer_sizes_a,
+      to_consolidate);
   if (!st.ok())
     goto clean_up;
 
-  // Check number of fragments
-  if (fragment_num <= 1)  // Nothing to consolidate
-    goto clean_up;
-
-  // Read from one array and write to the other
-  st = copy_array(subarray, query_r, query_w);
+  // Read from the old fragments and write to the new one
+  st = copy_array(
+      array_name,
+      subarray,
+      to_consolidate,
+      query_r,
+      &query_w,
+      buffers_a,
+      buffer_sizes_a,
+      buffers_b,
+      buffer_sizes_b,
+      buffer_num,
+      buffer_size,
+      checkpoint);
   if (!st.ok())
     goto clean_up;
 
-  // Get old fragment uris
-  old_fragment_uris = query_r->fragment_uris();
-
   // Finalize both queries
   st = finalize_queries(query_r, query_w);
   if (!st.ok())
     goto clean_up;
 
-  // Lock the array exclusively
+  // Lock the array exclusively only for the visibility swap: hiding
+  // the consolidated fragments is one small file removal per fragment,
+  // so the readers stall for milliseconds instead of for the whole
+  // fragment deletion
   st = storage_manager_->object_lock(array_uri, StorageManager::XLOCK);
   if (!st.ok())
     goto clean_up;
 
-  // Delete old fragments
-  st = delete_old_fragments(old_fragment_uris);
+  st = hide_old_fragments(to_consolidate);
   if (!st.ok()) {
     storage_manager_->object_unlock(array_uri, StorageManager::XLOCK);
     goto clean_up;
@@ -127,46 +265,236 @@ Status Consolidator::consolidate(const char* array_name) {
 
   // Unlock the array
   st = storage_manager_->object_unlock(array_uri, StorageManager::XLOCK);
+  if (!st.ok())
+    goto clean_up;
+
+  // Delete the hidden fragment directories outside the lock. Acquiring
+  // the exclusive lock above drained the readers that could still
+  // reference them, and any reader that opened since does not list
+  // them, so the deletion races with nobody. A failure here leaves
+  // behind directories that are invisible and harmless.
+  st = delete_old_fragments(to_consolidate);
+
+  // The step is complete - drop its checkpoint
+  if (st.ok() && checkpoint != nullptr)
+    st = remove_checkpoint(array_uri);
 
 // Clean up
 clean_up:
   if (subarray != nullptr)
     std::free(subarray);
   delete array_schema;
-  free_buffers(buffer_num, buffers, buffer_sizes);
+  free_buffers(buffer_num, buffers_a, buffer_sizes_a);
+  free_buffers(buffer_num, buffers_b, buffer_sizes_b);
   delete query_r;
   delete query_w;
 
   return st;
 }
 
-/* ****************************** */
-/*        PRIVATE METHODS         */
-/* ****************************** */
+Status Consolidator::consolidate_step(
+    const char* array_name, bool* consolidated) {
+  *consolidated = false;
+
+  // Open the array with a probe query to inspect the fragments
+  auto query = new Query();
+  Status st = storage_manager_->query_init(query, array_name, QueryType::READ);
+  if (!st.ok()) {
+    delete query;
+    return st;
+  }
+
+  // Checkpointing applies only to sparse arrays (see `Checkpoint`)
+  bool dense = query->array_schema()->dense();
+  bool checkpointing =
+      storage_manager_->config().sm_params().consolidation_checkpoint_freq_ >
+          0 &&
+      !dense;
+
+  // Resume an interrupted consolidation from its checkpoint, if a
+  // valid one exists; otherwise find the next window of adjacent
+  // fragments to merge
+  Checkpoint checkpoint;
+  checkpoint.buffer_size_ = 0;
+  checkpoint.completed_ = 0;
+  bool resume = false;
+  std::vector<URI> to_consolidate;
+  uint64_t buffer_size = 0;
+  if (checkpointing)
+    st = load_checkpoint(URI(array_name), &checkpoint, &resume);
+  if (st.ok()) {
+    if (resume) {
+      for (const auto& uri : checkpoint.to_consolidate_)
+        to_consolidate.emplace_back(uri);
+      buffer_size = checkpoint.buffer_size_;
+    } else {
+      compute_next_to_consolidate(
+          query->fragment_metadata(), dense, &to_consolidate);
+
+      // Size the consolidation buffers from the metadata of the window
+      if (!to_consolidate.empty()) {
+        buffer_size = compute_buffer_size(
+            query->fragment_metadata(), to_consolidate, query->array_schema());
+        checkpoint.buffer_size_ = buffer_size;
+        for (const auto& uri : to_consolidate)
+          checkpoint.to_consolidate_.push_back(uri.to_string());
+      }
+    }
+  }
+
+  // Close the array
+  auto finalize_st = storage_manager_->query_finalize(query);
+  delete query;
+  RETURN_NOT_OK(st);
+  RETURN_NOT_OK(finalize_st);
+
+  // Nothing to consolidate
+  if (to_consolidate.empty())
+    return Status::Ok();
+
+  RETURN_NOT_OK(consolidate_fragments(
+      array_name,
+      to_consolidate,
+      buffer_size,
+      checkpointing ? &checkpoint : nullptr));
+  *consolidated = true;
+
+  return Status::Ok();
+}
 
 Status Consolidator::copy_array(
-    void* read_subarray, Query* query_r, Query* query_w) {
+    const char* array_name,
+    void* subarray,
+    const std::vector<URI>& to_consolidate,
+    Query* query_r,
+    Query** query_w,
+    void** buffers_a,
+    uint64_t* buffer_sizes_a,
+    void** buffers_b,
+    uint64_t* buffer_sizes_b,
+    unsigned int buffer_num,
+    uint64_t buffer_size,
+    Checkpoint* checkpoint) {
   // Compute subarrays
   std::vector<void*> subarrays;
-  RETURN_NOT_OK(query_r->compute_subarrays(read_subarray, &subarrays));
-
-  for (auto subarray : subarrays) {
-    auto s = (uint64_t*)subarray;
-    std::cout << s[0] << " " << s[1] << " " << s[2] << " " << s[3] << "\n";
-  }
+  RETURN_NOT_OK(query_r->compute_subarrays(subarray, &subarrays));
 
-  // Perform a potentilly step-wise copy in a loop
+  // For easy reference
+  URI array_uri = URI(array_name);
+  auto checkpoint_freq =
+      storage_manager_->config().sm_params().consolidation_checkpoint_freq_;
+  uint64_t done = (checkpoint != nullptr) ? checkpoint->completed_ : 0;
+
+  // Perform a potentially step-wise copy in a loop. The copy is
+  // double-buffered: each subarray is read into one buffer set, while
+  // the previously read one is written on an I/O thread pool task, so
+  // the reads overlap with the writes.
+  auto io_pool = storage_manager_->io_thread_pool();
+  std::future<Status> write_task;
+  auto read_buffers = buffers_a;
+  auto read_buffer_sizes = buffer_sizes_a;
   Status st = Status::Ok();
+  double max_fill = 0.0;
+  uint64_t index = 0;
   for (const auto& s : subarrays) {
+    // Skip the subarrays a resumed consolidation has already copied
+    if (index++ < done)
+      continue;
+
+    // Read the subarray into the current buffer set
+    for (unsigned int i = 0; i < buffer_num; ++i)
+      read_buffer_sizes[i] = buffer_size;
+    query_r->set_buffers(read_buffers, read_buffer_sizes);
     st = query_r->set_subarray(s);
     if (!st.ok())
       break;
     st = storage_manager_->query_submit(query_r);
     if (!st.ok())
       break;
-    st = storage_manager_->query_submit(query_w);
-    if (!st.ok())
-      break;
+
+    // Record the buffer fill rate of this round
+    for (unsigned int i = 0; i < buffer_num; ++i)
+      max_fill =
+          std::max(max_fill, (double)read_buffer_sizes[i] / buffer_size);
+
+    // Wait for the previous write to complete before issuing a new one
+    if (write_task.valid()) {
+      st = write_task.get();
+      if (!st.ok())
+        break;
+    }
+
+    // Write the buffers just read on an I/O thread pool task
+    auto write_query = *query_w;
+    auto write_buffers = read_buffers;
+    auto write_buffer_sizes = read_buffer_sizes;
+    write_task = io_pool->enqueue(
+        [this, write_query, write_buffers, write_buffer_sizes]() {
+          write_query->set_buffers(write_buffers, write_buffer_sizes);
+          return storage_manager_->query_submit(write_query);
+        });
+
+    // Swap the buffer sets
+    if (read_buffers == buffers_a) {
+      read_buffers = buffers_b;
+      read_buffer_sizes = buffer_sizes_b;
+    } else {
+      read_buffers = buffers_a;
+      read_buffer_sizes = buffer_sizes_a;
+    }
+
+    // Periodically checkpoint the progress, finalizing the fragment
+    // written so far and continuing into a fresh one
+    if (checkpoint != nullptr && (index - done) % checkpoint_freq == 0 &&
+        index < subarrays.size()) {
+      // Wait for the in-flight write before finalizing
+      st = write_task.get();
+      if (!st.ok())
+        break;
+
+      // Finalize the current write query, making the partial fragment
+      // visible. Its cells are exact copies of cells of the still
+      // visible old fragments, so readers are unaffected.
+      checkpoint->fragment_uris_.push_back(
+          (*query_w)->last_fragment_uri().to_string());
+      st = storage_manager_->query_finalize(*query_w);
+      if (!st.ok())
+        break;
+      delete *query_w;
+      *query_w = new Query();
+      st = create_write_query(
+          *query_w,
+          array_name,
+          subarray,
+          read_buffers,
+          read_buffer_sizes,
+          to_consolidate);
+      if (!st.ok())
+        break;
+
+      // Persist the progress
+      checkpoint->completed_ = index;
+      st = store_checkpoint(array_uri, *checkpoint);
+      if (!st.ok())
+        break;
+    }
+  }
+
+  // Wait for the last write to complete
+  if (write_task.valid()) {
+    auto write_st = write_task.get();
+    if (st.ok())
+      st = write_st;
+  }
+
+  // Adapt the buffer sizing of the next steps to the observed fill
+  // rates: mostly-empty buffers shrink the next allocation, while
+  // buffers that filled up lift a previous shrink
+  if (st.ok()) {
+    if (max_fill < 0.25)
+      fill_scale_ = std::max(fill_scale_ / 2, 1.0 / 16);
+    else if (max_fill > 0.75)
+      fill_scale_ = std::min(fill_scale_ * 2, 1.0);
   }
 
   // Clean up
@@ -180,6 +508,7 @@ Status Consolidator::copy_array(
 
 Status Consolidator::create_buffers(
     ArraySchema* array_meta,
+    uint64_t buffer_size,
     void*** buffers,
     uint64_t** buffer_sizes,
     unsigned int* buffer_num) {
@@ -208,10 +537,10 @@ Status Consolidator::create_buffers(
   // Allocate space for each buffer
   bool error = false;
   for (unsigned int i = 0; i < *buffer_num; ++i) {
-    (*buffers)[i] = std::malloc(constants::consolidation_buffer_size);
+    (*buffers)[i] = std::malloc(buffer_size);
     if ((*buffers)[i] == nullptr)  // The loop should continue to
       error = true;                // allocate nullptr to each buffer
-    (*buffer_sizes)[i] = constants::consolidation_buffer_size;
+    (*buffer_sizes)[i] = buffer_size;
   }
 
   // Clean up upon error
@@ -234,8 +563,8 @@ Status Consolidator::create_queries(
     const char* array_name,
     void** buffers,
     uint64_t* buffer_sizes,
-    unsigned int* fragment_num) {
-  // Create read query
+    const std::vector<URI>& to_consolidate) {
+  // Create read query, restricted to the fragments to consolidate
   RETURN_NOT_OK(storage_manager_->query_init(
       query_r,
       array_name,
@@ -245,19 +574,28 @@ Status Consolidator::create_queries(
       nullptr,
       0,
       buffers,
-      buffer_sizes));
+      buffer_sizes,
+      URI(""),
+      &to_consolidate));
 
-  // Get fragment num and terminate with success if it is <=1
-  *fragment_num = query_r->fragment_num();
-  if (*fragment_num <= 1)
-    return Status::Ok();
+  // Create write query
+  return create_write_query(
+      query_w, array_name, subarray, buffers, buffer_sizes, to_consolidate);
+}
 
-  // Get last fragment URI, which will be the URI of the consolidated fragment
-  URI new_fragment_uri = query_r->last_fragment_uri();
+Status Consolidator::create_write_query(
+    Query* query_w,
+    const char* array_name,
+    void* subarray,
+    void** buffers,
+    uint64_t* buffer_sizes,
+    const std::vector<URI>& to_consolidate) {
+  // The new fragment will take the place of the last of the
+  // consolidated fragments, hence it gets that fragment's timestamp
+  URI new_fragment_uri = to_consolidate.back();
   RETURN_NOT_OK(rename_new_fragment_uri(&new_fragment_uri));
 
-  // Create write query
-  RETURN_NOT_OK(storage_manager_->query_init(
+  return storage_manager_->query_init(
       query_w,
       array_name,
       QueryType::WRITE,
@@ -267,7 +605,126 @@ Status Consolidator::create_queries(
       0,
       buffers,
       buffer_sizes,
-      new_fragment_uri));
+      new_fragment_uri);
+}
+
+URI Consolidator::checkpoint_uri(const URI& array_uri) const {
+  return array_uri.join_path(
+      std::string(constants::consolidation_checkpoint_filename));
+}
+
+Status Consolidator::load_checkpoint(
+    const URI& array_uri, Checkpoint* checkpoint, bool* found) {
+  *found = false;
+
+  // Check if a checkpoint file exists
+  auto vfs = storage_manager_->vfs();
+  auto uri = checkpoint_uri(array_uri);
+  bool is_file;
+  RETURN_NOT_OK(vfs->is_file(uri, &is_file));
+  if (!is_file)
+    return Status::Ok();
+
+  // Read the checkpoint file
+  uint64_t size;
+  RETURN_NOT_OK(vfs->file_size(uri, &size));
+  Buffer buff;
+  RETURN_NOT_OK(buff.realloc(size));
+  RETURN_NOT_OK(vfs->read(uri, 0, buff.data(), size));
+
+  // Parse, treating any malformed content (e.g., from a crash during
+  // a checkpoint write) as a stale checkpoint
+  ConstBuffer cbuff(buff.data(), size);
+  uint32_t version = 0;
+  uint64_t num, uri_size;
+  std::string uri_str;
+  bool ok = cbuff.read(&version, sizeof(uint32_t)).ok() && version == 1;
+  ok = ok && cbuff.read(&checkpoint->buffer_size_, sizeof(uint64_t)).ok();
+  ok = ok && cbuff.read(&checkpoint->completed_, sizeof(uint64_t)).ok();
+  ok = ok && cbuff.read(&num, sizeof(uint64_t)).ok() && num <= size;
+  for (uint64_t i = 0; ok && i < num; ++i) {
+    ok = cbuff.read(&uri_size, sizeof(uint64_t)).ok() && uri_size <= size;
+    if (ok) {
+      uri_str.resize(uri_size);
+      ok = cbuff.read(&uri_str[0], uri_size).ok();
+      checkpoint->to_consolidate_.push_back(uri_str);
+    }
+  }
+  ok = ok && cbuff.read(&num, sizeof(uint64_t)).ok() && num <= size;
+  for (uint64_t i = 0; ok && i < num; ++i) {
+    ok = cbuff.read(&uri_size, sizeof(uint64_t)).ok() && uri_size <= size;
+    if (ok) {
+      uri_str.resize(uri_size);
+      ok = cbuff.read(&uri_str[0], uri_size).ok();
+      checkpoint->fragment_uris_.push_back(uri_str);
+    }
+  }
+  ok = ok && !checkpoint->to_consolidate_.empty();
+
+  // The checkpoint is also stale if any fragment of its window is gone
+  if (ok) {
+    for (const auto& s : checkpoint->to_consolidate_) {
+      bool exists;
+      RETURN_NOT_OK(storage_manager_->is_fragment(URI(s), &exists));
+      if (!exists) {
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  // Remove a stale checkpoint; the step is redone from scratch (the
+  // partial fragments it may have left behind remain valid)
+  if (!ok) {
+    checkpoint->to_consolidate_.clear();
+    checkpoint->fragment_uris_.clear();
+    return remove_checkpoint(array_uri);
+  }
+
+  *found = true;
+  return Status::Ok();
+}
+
+Status Consolidator::store_checkpoint(
+    const URI& array_uri, const Checkpoint& checkpoint) {
+  // Serialize the checkpoint
+  Buffer buff;
+  uint32_t version = 1;
+  RETURN_NOT_OK(buff.write(&version, sizeof(uint32_t)));
+  RETURN_NOT_OK(buff.write(&checkpoint.buffer_size_, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff.write(&checkpoint.completed_, sizeof(uint64_t)));
+  uint64_t num = checkpoint.to_consolidate_.size();
+  RETURN_NOT_OK(buff.write(&num, sizeof(uint64_t)));
+  for (const auto& s : checkpoint.to_consolidate_) {
+    uint64_t uri_size = s.size();
+    RETURN_NOT_OK(buff.write(&uri_size, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff.write(s.data(), uri_size));
+  }
+  num = checkpoint.fragment_uris_.size();
+  RETURN_NOT_OK(buff.write(&num, sizeof(uint64_t)));
+  for (const auto& s : checkpoint.fragment_uris_) {
+    uint64_t uri_size = s.size();
+    RETURN_NOT_OK(buff.write(&uri_size, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff.write(s.data(), uri_size));
+  }
+
+  // Replace the previous checkpoint. A crash in between leaves no
+  // checkpoint or a malformed one, which a restarted consolidation
+  // treats as stale, redoing the step from scratch
+  auto vfs = storage_manager_->vfs();
+  auto uri = checkpoint_uri(array_uri);
+  RETURN_NOT_OK(remove_checkpoint(array_uri));
+  RETURN_NOT_OK(vfs->write(uri, buff.data(), buff.size()));
+  return vfs->close_file(uri);
+}
+
+Status Consolidator::remove_checkpoint(const URI& array_uri) {
+  auto vfs = storage_manager_->vfs();
+  auto uri = checkpoint_uri(array_uri);
+  bool is_file;
+  RETURN_NOT_OK(vfs->is_file(uri, &is_file));
+  if (is_file)
+    RETURN_NOT_OK(vfs->remove_file(uri));
 
   return Status::Ok();
 }
@@ -295,8 +752,18 @@ Status Consolidator::create_subarray(
 }
 
 Status Consolidator::delete_old_fragments(const std::vector<URI>& uris) {
+  // The fragments are already hidden, so `delete_fragment` (which
+  // requires a visible fragment) does not apply
+  for (auto& uri : uris)
+    RETURN_NOT_OK(storage_manager_->vfs()->remove_dir(uri));
+
+  return Status::Ok();
+}
+
+Status Consolidator::hide_old_fragments(const std::vector<URI>& uris) {
   for (auto& uri : uris)
-    RETURN_NOT_OK(storage_manager_->delete_fragment(uri));
+    RETURN_NOT_OK(storage_manager_->vfs()->remove_file(
+        uri.join_path(constants::fragment_metadata_filename)));
 
   return Status::Ok();
 }
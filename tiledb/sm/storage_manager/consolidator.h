@@ -34,16 +34,18 @@
 #define TILEDB_CONSOLIDATOR_H
 
 #include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/uri.h"
 
+#include <string>
 #include <vector>
 
 namespace tiledb {
 namespace sm {
 
 class ArraySchema;
+class FragmentMetadata;
 class Query;
 class StorageManager;
-class URI;
 
 /** Handles array consolidation. */
 class Consolidator {
@@ -66,10 +68,46 @@ class Consolidator {
   /*                API                */
   /* ********************************* */
 
-  /** Consolidates the fragments of the input array. */
+  /**
+   * Consolidates the fragments of the input array incrementally. In
+   * each step, a window of adjacent fragments with similar sizes (see
+   * the `sm.consolidation.*` config parameters) gets merged into a
+   * single fragment, until no window qualifies or the maximum number of
+   * steps is reached. With the default parameters, all the fragments
+   * get merged into one in a single step.
+   */
   Status consolidate(const char* array_name);
 
  private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /**
+   * The progress of a consolidation step, persisted in a checkpoint
+   * file in the array directory every
+   * `sm.consolidation.checkpoint_frequency` copied subarrays. Instead
+   * of accumulating the entire window into a single fragment, a
+   * checkpointing consolidation finalizes the fragment written so far
+   * and continues into a fresh one. The finalized fragments hold exact
+   * copies of cells of the (still visible) old fragments, so they are
+   * safe to expose immediately and to keep upon a crash; a restarted
+   * consolidation resumes from the recorded subarray instead of
+   * redoing all the I/O. Checkpointing applies only to sparse arrays -
+   * a dense global-order write cannot finalize before covering the
+   * whole write subarray.
+   */
+  struct Checkpoint {
+    /** The size allocated for each consolidation buffer. */
+    uint64_t buffer_size_;
+    /** The number of fully copied read subarrays. */
+    uint64_t completed_;
+    /** The URIs of the fragments to be consolidated. */
+    std::vector<std::string> to_consolidate_;
+    /** The URIs of the finalized partial fragments. */
+    std::vector<std::string> fragment_uris_;
+  };
+
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
@@ -77,6 +115,15 @@ class Consolidator {
   /** The storage manager. */
   StorageManager* storage_manager_;
 
+  /**
+   * Scale factor applied to the computed consolidation buffer size,
+   * adapted between consolidation steps based on the buffer fill rates
+   * observed in the copy loop. Mostly-empty buffers (e.g., very sparse
+   * fragments) shrink the next allocation, while buffers that filled
+   * up lift a previous shrink.
+   */
+  double fill_scale_;
+
   /* ********************************* */
   /*          PRIVATE METHODS           */
   /* ********************************* */
@@ -84,13 +131,113 @@ class Consolidator {
   /**
    * Copies the array by reading from the fragments to be consolidated
    * (with *query_r*) and writing to the new fragment (with *query_w*).
+   * The copy is double-buffered: each subarray is read into one of the
+   * two input buffer sets, while the previously read set is written on
+   * an I/O thread pool task, overlapping the reads with the writes.
+   * If a checkpoint is given, the copy skips the subarrays recorded as
+   * completed and periodically checkpoints its progress, finalizing
+   * the current write query and replacing it with one that targets a
+   * fresh fragment.
    *
-   * @param read_subarray The read subarray.
+   * @param array_name The array name.
+   * @param subarray The subarray to read from and write into.
+   * @param to_consolidate The URIs of the fragments to be consolidated.
    * @param query_r The read query.
-   * @param query_w The write query.
+   * @param query_w The write query. It may be replaced upon a
+   *     checkpoint.
+   * @param buffers_a The first buffer set.
+   * @param buffer_sizes_a The sizes of the first buffer set.
+   * @param buffers_b The second buffer set.
+   * @param buffer_sizes_b The sizes of the second buffer set.
+   * @param buffer_num The number of buffers in each set.
+   * @param buffer_size The size allocated for each buffer.
+   * @param checkpoint The consolidation checkpoint (`nullptr` if
+   *     checkpointing is disabled).
+   * @return Status
+   */
+  Status copy_array(
+      const char* array_name,
+      void* subarray,
+      const std::vector<URI>& to_consolidate,
+      Query* query_r,
+      Query** query_w,
+      void** buffers_a,
+      uint64_t* buffer_sizes_a,
+      void** buffers_b,
+      uint64_t* buffer_sizes_b,
+      unsigned int buffer_num,
+      uint64_t buffer_size,
+      Checkpoint* checkpoint);
+
+  /**
+   * Computes the size of each consolidation buffer adaptively from the
+   * metadata of the fragments to be consolidated: the buffers are sized
+   * to their share of the input data (no larger than the fixed maximum),
+   * capped so that both buffer sets fit in `sm.memory_budget` (if set),
+   * scaled by the fill rates observed in the previous steps, and floored
+   * so that a buffer always fits the largest average tile.
+   *
+   * @param metadata The metadata of all the array fragments.
+   * @param to_consolidate The URIs of the fragments to be consolidated.
+   * @param array_schema The array schema.
+   * @return The buffer size.
+   */
+  uint64_t compute_buffer_size(
+      const std::vector<FragmentMetadata*>& metadata,
+      const std::vector<URI>& to_consolidate,
+      const ArraySchema* array_schema) const;
+
+  /**
+   * Finds the next window of adjacent fragments to merge. The function
+   * prefers the longest window of at least
+   * `sm.consolidation.step_min_frags` and at most
+   * `sm.consolidation.step_max_frags` fragments whose smallest and
+   * largest fragment sizes satisfy `sm.consolidation.step_size_ratio`.
+   * For dense arrays, only windows starting at the first fragment are
+   * considered; the merged fragment covers the whole domain and gets
+   * the timestamp of the window's last fragment, so a mid-array window
+   * would shadow the cells of the fragments preceding it.
+   *
+   * @param metadata The metadata of all the array fragments, sorted by
+   *     timestamp.
+   * @param dense Whether the array is dense.
+   * @param to_consolidate The URIs of the fragments to merge will be
+   *     stored here (left empty if no window qualifies).
+   */
+  void compute_next_to_consolidate(
+      const std::vector<FragmentMetadata*>& metadata,
+      bool dense,
+      std::vector<URI>* to_consolidate) const;
+
+  /**
+   * Consolidates the input fragments of the input array into a single
+   * new fragment, deleting the old ones. If a checkpoint is given, the
+   * copy is resumable (see `Checkpoint`) and may produce multiple new
+   * fragments.
+   *
+   * @param array_name The array name.
+   * @param to_consolidate The URIs of the fragments to be consolidated.
+   * @param buffer_size The size allocated for each consolidation buffer.
+   * @param checkpoint The consolidation checkpoint (`nullptr` if
+   *     checkpointing is disabled).
+   * @return Status
+   */
+  Status consolidate_fragments(
+      const char* array_name,
+      const std::vector<URI>& to_consolidate,
+      uint64_t buffer_size,
+      Checkpoint* checkpoint);
+
+  /**
+   * Performs a single consolidation step, i.e., it finds the next
+   * window of adjacent fragments to merge and consolidates them into a
+   * single fragment.
+   *
+   * @param array_name The array name.
+   * @param consolidated Set to `true` if the step merged some fragments.
    * @return Status
    */
-  Status copy_array(void* read_subarray, Query* query_r, Query* query_w);
+  Status consolidate_step(const char* array_name, bool* consolidated);
 
   /**
    * Creates the buffers that will be used upon reading the input fragments and
@@ -98,6 +245,7 @@ class Consolidator {
    * created.
    *
    * @param array_schema The array schema.
+   * @param buffer_size The size allocated for each buffer.
    * @param buffers The buffers to be created.
    * @param buffer_sizes The corresponding buffer sizes.
    * @param buffer_num The number of buffers to be retrieved.
@@ -105,13 +253,13 @@ class Consolidator {
    */
   Status create_buffers(
       ArraySchema* array_schema,
+      uint64_t buffer_size,
       void*** buffers,
       uint64_t** buffer_sizes,
       unsigned int* buffer_num);
 
   /**
-   * Creates the queries needed for consolidation. It also retrieves
-   * the number of fragments to be consolidated.
+   * Creates the queries needed for consolidation.
    *
    * @param query_r This query reads from the fragments to be consolidated.
    * @param query_w This query writes to the new consolidated fragment.
@@ -119,7 +267,7 @@ class Consolidator {
    * @param array_name The array name.
    * @param buffers The buffers to be passed in the queries.
    * @param buffer_sizes The corresponding buffer sizes.
-   * @param fragment_num The number of fragments to be retrieved.
+   * @param to_consolidate The URIs of the fragments to be consolidated.
    * @return Status
    */
   Status create_queries(
@@ -129,7 +277,49 @@ class Consolidator {
       const char* array_name,
       void** buffers,
       uint64_t* buffer_sizes,
-      unsigned int* fragment_num);
+      const std::vector<URI>& to_consolidate);
+
+  /**
+   * Creates a write query targeting a fresh fragment, which takes the
+   * timestamp of the last of the consolidated fragments.
+   *
+   * @param query_w The write query to be created.
+   * @param array_name The array name.
+   * @param subarray The subarray to write into.
+   * @param buffers The buffers to be passed in the query.
+   * @param buffer_sizes The corresponding buffer sizes.
+   * @param to_consolidate The URIs of the fragments to be consolidated.
+   * @return Status
+   */
+  Status create_write_query(
+      Query* query_w,
+      const char* array_name,
+      void* subarray,
+      void** buffers,
+      uint64_t* buffer_sizes,
+      const std::vector<URI>& to_consolidate);
+
+  /** Returns the URI of the checkpoint file of the input array. */
+  URI checkpoint_uri(const URI& array_uri) const;
+
+  /**
+   * Loads the consolidation checkpoint of the input array, if a valid
+   * one exists and all the fragments of its window are still present.
+   * Invalid or stale checkpoints are removed.
+   *
+   * @param array_uri The array URI.
+   * @param checkpoint The loaded checkpoint.
+   * @param found Set to `true` if a valid checkpoint was loaded.
+   * @return Status
+   */
+  Status load_checkpoint(
+      const URI& array_uri, Checkpoint* checkpoint, bool* found);
+
+  /** Persists the input consolidation checkpoint. */
+  Status store_checkpoint(const URI& array_uri, const Checkpoint& checkpoint);
+
+  /** Removes the consolidation checkpoint of the input array, if any. */
+  Status remove_checkpoint(const URI& array_uri);
 
   /** Creates the subarray that should represent the entire array domain. */
   Status create_subarray(
@@ -138,12 +328,24 @@ class Consolidator {
       void** subarray) const;
 
   /**
-   * Deletes the old fragments that got consolidated.
+   * Deletes the directories of the old fragments that got consolidated.
+   * The fragments must have been hidden with `hide_old_fragments` first.
    * @param uris The URIs of the old fragments.
    * @return Status
    */
   Status delete_old_fragments(const std::vector<URI>& uris);
 
+  /**
+   * Makes the old fragments that got consolidated invisible to
+   * subsequent array opens, by removing their fragment metadata files.
+   * This is the visibility swap of consolidation: it is cheap (one
+   * small file removal per fragment), so it is the only part that runs
+   * under the exclusive array lock.
+   * @param uris The URIs of the old fragments.
+   * @return Status
+   */
+  Status hide_old_fragments(const std::vector<URI>& uris);
+
   /** Finalizes the input queries. */
   Status finalize_queries(Query* query_r, Query* query_w);
 
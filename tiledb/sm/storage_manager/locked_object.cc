@@ -80,11 +80,12 @@ Status LockedObject::lock_exclusive(VFS* vfs, const URI& uri) {
   std::unique_lock<std::mutex> lk(mtx_);
   cv_.wait(lk, [this] { return !exclusive_lock_ && (shared_locks_ == 0); });
 
+  // With no in-process holders left, the filelock has been released, so
+  // it can be (re-)acquired exclusively for cross-process coordination
   if (filelock_ == INVALID_FILELOCK)
     RETURN_NOT_OK(vfs->filelock_lock(uri, &filelock_, false));
 
   exclusive_lock_ = true;
-  lk.unlock();
 
   return Status::Ok();
 }
@@ -93,36 +94,44 @@ Status LockedObject::lock_shared(VFS* vfs, const URI& uri) {
   std::unique_lock<std::mutex> lk(mtx_);
   cv_.wait(lk, [this] { return !exclusive_lock_; });
 
-  if (filelock_ == INVALID_FILELOCK)
+  // Only the first in-process shared holder acquires the filelock; the
+  // others piggyback on it without any VFS round trip
+  if (shared_locks_ == 0 && filelock_ == INVALID_FILELOCK)
     RETURN_NOT_OK(vfs->filelock_lock(uri, &filelock_, true));
 
   ++shared_locks_;
-  lk.unlock();
 
   return Status::Ok();
 }
 
 Status LockedObject::unlock_exclusive(VFS* vfs, const URI& uri) {
+  std::unique_lock<std::mutex> lk(mtx_);
+
+  Status st = Status::Ok();
   if (filelock_ != INVALID_FILELOCK)
-    RETURN_NOT_OK(vfs->filelock_unlock(uri, filelock_));
+    st = vfs->filelock_unlock(uri, filelock_);
   filelock_ = INVALID_FILELOCK;
 
   exclusive_lock_ = false;
   cv_.notify_all();
 
-  return Status::Ok();
+  return st;
 }
 
 Status LockedObject::unlock_shared(VFS* vfs, const URI& uri) {
-  if (filelock_ != INVALID_FILELOCK)
-    RETURN_NOT_OK(vfs->filelock_unlock(uri, filelock_));
-  filelock_ = INVALID_FILELOCK;
+  std::unique_lock<std::mutex> lk(mtx_);
 
+  // The filelock is held until the last in-process shared holder leaves
+  Status st = Status::Ok();
   --shared_locks_;
-  if (shared_locks_ == 0)
+  if (shared_locks_ == 0) {
+    if (filelock_ != INVALID_FILELOCK)
+      st = vfs->filelock_unlock(uri, filelock_);
+    filelock_ = INVALID_FILELOCK;
     cv_.notify_one();
+  }
 
-  return Status::Ok();
+  return st;
 }
 
 }  // namespace sm
@@ -43,7 +43,14 @@
 namespace tiledb {
 namespace sm {
 
-/** Stores information about a locked object (array or group). */
+/**
+ * Stores information about a locked object (array or group). The
+ * shared/exclusive coordination within the process happens on an
+ * in-memory table (mutex and condition variable); the filesystem
+ * filelock is acquired only by the first in-process holder and released
+ * by the last one, so it serves purely for cross-process coordination
+ * and the other lockers pay no VFS round trips.
+ */
 class LockedObject {
  public:
   /* ****************************** */
@@ -0,0 +1,83 @@
+/**
+ * @file   memory_budget.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class MemoryBudget.
+ */
+
+#include "tiledb/sm/storage_manager/memory_budget.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+MemoryBudget::MemoryBudget(uint64_t budget) {
+  budget_ = budget;
+  usage_ = 0;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+uint64_t MemoryBudget::budget() const {
+  return budget_;
+}
+
+uint64_t MemoryBudget::usage() const {
+  return usage_;
+}
+
+bool MemoryBudget::try_charge(uint64_t nbytes) {
+  if (budget_ == 0) {
+    usage_ += nbytes;
+    return true;
+  }
+
+  uint64_t usage = usage_;
+  do {
+    if (usage + nbytes > budget_)
+      return false;
+  } while (!usage_.compare_exchange_weak(usage, usage + nbytes));
+
+  return true;
+}
+
+void MemoryBudget::charge(uint64_t nbytes) {
+  usage_ += nbytes;
+}
+
+void MemoryBudget::release(uint64_t nbytes) {
+  usage_ -= nbytes;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,118 @@
+/**
+ * @file   memory_budget.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class MemoryBudget.
+ */
+
+#ifndef TILEDB_MEMORY_BUDGET_H
+#define TILEDB_MEMORY_BUDGET_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Tracks the memory usage of a storage manager instance against a
+ * configurable budget. The caches and the per-query tile buffers charge
+ * their allocations against the budget, and memory-intensive stages
+ * (e.g. tile fetching in the read path) consult it to bound the amount
+ * of memory they have in flight, falling back to processing their input
+ * in smaller batches when the budget is hit.
+ *
+ * The budget is advisory: `try_charge` lets a caller back off when the
+ * budget is exhausted, but a caller that cannot make progress otherwise
+ * may `charge` unconditionally, so usage can transiently exceed the
+ * budget (e.g. by a single tile).
+ */
+class MemoryBudget {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param budget The memory budget in bytes (0 means unbounded).
+   */
+  explicit MemoryBudget(uint64_t budget = 0);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the budget in bytes (0 means unbounded). */
+  uint64_t budget() const;
+
+  /** Returns the number of bytes currently charged. */
+  uint64_t usage() const;
+
+  /**
+   * Charges the given number of bytes if they fit in the budget.
+   *
+   * @param nbytes The number of bytes to charge.
+   * @return `true` if the bytes were charged, `false` if charging them
+   *     would exceed the budget.
+   */
+  bool try_charge(uint64_t nbytes);
+
+  /**
+   * Charges the given number of bytes unconditionally. To be used by
+   * callers that cannot make progress with less memory; usage may
+   * exceed the budget as a result.
+   *
+   * @param nbytes The number of bytes to charge.
+   */
+  void charge(uint64_t nbytes);
+
+  /**
+   * Releases previously charged bytes.
+   *
+   * @param nbytes The number of bytes to release.
+   */
+  void release(uint64_t nbytes);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The budget in bytes (0 means unbounded). */
+  uint64_t budget_;
+
+  /** The number of bytes currently charged. */
+  std::atomic<uint64_t> usage_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_MEMORY_BUDGET_H
@@ -43,12 +43,12 @@ namespace sm {
 OpenArray::OpenArray() {
   array_schema_ = nullptr;
   cnt_ = 0;
+  mtx_reader_num_ = 0;
+  mtx_writer_ = false;
 }
 
 OpenArray::~OpenArray() {
   delete array_schema_;
-  for (auto& fragment : fragment_metadata_)
-    delete fragment.second;
 }
 
 /* ****************************** */
@@ -72,10 +72,12 @@ void OpenArray::decr_cnt() {
 }
 
 void OpenArray::fragment_metadata_add(FragmentMetadata* metadata) {
+  std::lock_guard<std::mutex> lock(fragment_metadata_mtx_);
   fragment_metadata_[metadata->fragment_uri().to_string()] = metadata;
 }
 
 FragmentMetadata* OpenArray::fragment_metadata_get(const URI& fragment_uri) {
+  std::lock_guard<std::mutex> lock(fragment_metadata_mtx_);
   auto it = fragment_metadata_.find(fragment_uri.to_string());
   if (it == fragment_metadata_.end())
     return nullptr;
@@ -88,11 +90,35 @@ void OpenArray::incr_cnt() {
 }
 
 void OpenArray::mtx_lock() {
-  mtx_.lock();
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (mtx_writer_ || mtx_reader_num_ > 0)
+    mtx_cv_.wait(lock);
+  mtx_writer_ = true;
+}
+
+void OpenArray::mtx_lock_shared() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (mtx_writer_)
+    mtx_cv_.wait(lock);
+  ++mtx_reader_num_;
 }
 
 void OpenArray::mtx_unlock() {
-  mtx_.unlock();
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    mtx_writer_ = false;
+  }
+  mtx_cv_.notify_all();
+}
+
+void OpenArray::mtx_unlock_shared() {
+  uint64_t reader_num;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    reader_num = --mtx_reader_num_;
+  }
+  if (reader_num == 0)
+    mtx_cv_.notify_all();
 }
 
 void OpenArray::set_array_schema(const ArraySchema* array_schema) {
@@ -34,6 +34,7 @@
 #ifndef TILEDB_OPEN_ARRAY_H
 #define TILEDB_OPEN_ARRAY_H
 
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -87,12 +88,25 @@ class OpenArray {
   /** Increments the counter indicating the times this array has been opened. */
   void incr_cnt();
 
-  /** Locks the array mutex. */
+  /**
+   * Locks the array mutex in exclusive mode. This grants sole access to
+   * the open array, e.g. for loading the array schema.
+   */
   void mtx_lock();
 
-  /** Unlocks the array mutex. */
+  /**
+   * Locks the array mutex in shared mode. Multiple threads may hold the
+   * mutex in shared mode at the same time, but none while a thread holds
+   * it in exclusive mode.
+   */
+  void mtx_lock_shared();
+
+  /** Unlocks the array mutex from exclusive mode. */
   void mtx_unlock();
 
+  /** Unlocks the array mutex from shared mode. */
+  void mtx_unlock_shared();
+
   /** Sets an array schema. */
   void set_array_schema(const ArraySchema* array_schema);
 
@@ -110,15 +124,32 @@ class OpenArray {
   /**
    * Enables searching for loaded fragment metadata by fragment name.
    * Format: <fragment_name> --> (fragment_metadata)
+   * Note that the metadata objects are owned by the storage manager
+   * (which keeps them cached process-wide), not by the open array.
    */
   std::map<std::string, FragmentMetadata*> fragment_metadata_;
 
   /**
-   * A mutex used to lock the array when loading the array metadata and
-   * any fragment metadata structures from the disk.
+   * Protects `fragment_metadata_`, so that threads holding the array
+   * mutex in shared mode can safely add and look up metadata.
+   */
+  std::mutex fragment_metadata_mtx_;
+
+  /**
+   * A mutex that, together with `mtx_cv_`, `mtx_reader_num_` and
+   * `mtx_writer_`, implements a reader-writer lock on the open array.
    */
   std::mutex mtx_;
 
+  /** A condition variable for waiting on the array mutex. */
+  std::condition_variable mtx_cv_;
+
+  /** The number of threads holding the array mutex in shared mode. */
+  uint64_t mtx_reader_num_;
+
+  /** `true` if a thread holds the array mutex in exclusive mode. */
+  bool mtx_writer_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
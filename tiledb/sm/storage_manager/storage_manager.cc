@@ -32,8 +32,17 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <sstream>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "tiledb/sm/misc/cpu.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
@@ -53,27 +62,78 @@ namespace sm {
 /* ****************************** */
 
 StorageManager::StorageManager() {
+  array_open_timestamp_ = 0;
   async_done_ = false;
-  async_thread_[0] = nullptr;
-  async_thread_[1] = nullptr;
+  async_seq_ = 0;
+  consolidation_scheduler_thread_ = nullptr;
+  consolidation_scheduler_done_ = false;
+  compute_thread_pool_ = nullptr;
+  io_thread_pool_ = nullptr;
+  shared_thread_pools_ = false;
   consolidator_ = nullptr;
+  write_combiner_ = nullptr;
   array_schema_cache_ = nullptr;
+  buffer_pool_ = nullptr;
   fragment_metadata_cache_ = nullptr;
+  memory_budget_ = nullptr;
   tile_cache_ = nullptr;
+  tile_cache_compressed_ = false;
+  tile_prefetch_ = false;
+  tile_prefetches_inflight_ = 0;
+  tile_prefetch_stop_ = false;
+  disk_tile_cache_ = nullptr;
   vfs_ = nullptr;
+  for (uint64_t i = 0; i < constants::open_array_shard_num; ++i)
+    open_array_shards_.push_back(new OpenArrayShard());
 }
 
 StorageManager::~StorageManager() {
+  // The consolidation scheduler goes first, as a running consolidation
+  // uses virtually every member destroyed below
+  consolidation_scheduler_stop();
+  delete consolidation_scheduler_thread_;
+
+  // Wait for any pending background preload tasks, which use the thread
+  // pools and the caches destroyed below
+  for (auto& task : preload_tasks_)
+    task.wait();
+
+  // Likewise wait for in-flight speculative tile fetches, which may
+  // even outlive the thread pools when `sm.shared_thread_pools` is set
+  {
+    std::unique_lock<std::mutex> lock(tile_prefetch_mtx_);
+    tile_prefetch_stop_ = true;
+    tile_prefetch_cv_.wait(
+        lock, [this]() { return tile_prefetches_inflight_ == 0; });
+  }
+
+  // Flushes any pending combined writes, so it must go first, while the
+  // VFS and the thread pools the write path uses are still alive
+  delete write_combiner_;
   async_stop();
-  delete async_thread_[0];
-  delete async_thread_[1];
+  for (auto& thread : async_threads_)
+    delete thread;
+  if (!shared_thread_pools_) {
+    delete compute_thread_pool_;
+    delete io_thread_pool_;
+  }
   delete array_schema_cache_;
+  delete buffer_pool_;
   delete consolidator_;
   delete fragment_metadata_cache_;
+  delete memory_budget_;
   delete tile_cache_;
+  delete disk_tile_cache_;
   delete vfs_;
-  for (auto& open_array : open_arrays_)
-    delete open_array.second;
+  for (auto& shard : open_array_shards_) {
+    for (auto& open_array : shard->open_arrays_)
+      delete open_array.second;
+    delete shard;
+  }
+  for (auto& metadata : fragment_metadata_)
+    delete metadata.second;
+  for (auto& schema : array_schemas_)
+    delete schema.second;
 }
 
 /* ****************************** */
@@ -126,6 +186,193 @@ Status StorageManager::array_compute_max_read_buffer_sizes(
   return array_close(uri);
 }
 
+Status StorageManager::array_partition_subarray(
+    const char* array_uri,
+    const void* subarray,
+    Layout layout,
+    const char** attributes,
+    unsigned attribute_num,
+    uint64_t budget,
+    std::vector<std::vector<uint8_t>>* partitions) {
+  // Sanity check
+  if (budget == 0)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot partition subarray; Invalid memory budget"));
+
+  // Open the array
+  auto uri = URI(array_uri);
+  std::vector<FragmentMetadata*> metadata;
+  auto array_schema = (const ArraySchema*)nullptr;
+  RETURN_NOT_OK(array_open(uri, QueryType::READ, &array_schema, &metadata));
+
+  // Resolve the attributes; `nullptr` means all attributes, plus the
+  // coordinates if the array is sparse
+  std::vector<std::string> attributes_vec;
+  if (attributes == nullptr) {
+    attributes_vec = array_schema->attribute_names();
+    if (!array_schema->dense())
+      attributes_vec.emplace_back(constants::coords);
+  } else {
+    for (unsigned i = 0; i < attribute_num; ++i)
+      attributes_vec.emplace_back(attributes[i]);
+  }
+  std::vector<unsigned> attribute_ids;
+  RETURN_NOT_OK_ELSE(
+      array_schema->get_attribute_ids(attributes_vec, attribute_ids),
+      array_close(uri));
+  // Compute the partitions
+  std::list<std::vector<uint8_t>> my_partitions;
+  RETURN_NOT_OK_ELSE(
+      compute_subarray_partitions(
+          array_schema,
+          metadata,
+          subarray,
+          layout,
+          attribute_ids,
+          budget,
+          &my_partitions),
+      array_close(uri));
+
+  // Emit the partitions
+  partitions->clear();
+  for (auto& partition : my_partitions)
+    partitions->emplace_back(std::move(partition));
+
+  // Close the array
+  return array_close(uri);
+}
+
+Status StorageManager::compute_subarray_partitions(
+    const ArraySchema* array_schema,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    const void* subarray,
+    Layout layout,
+    const std::vector<unsigned>& attribute_ids,
+    uint64_t budget,
+    std::list<std::vector<uint8_t>>* partitions) {
+  unsigned buffer_num = 0;
+  for (auto attribute_id : attribute_ids)
+    buffer_num += 1 + (unsigned)array_schema->var_size(attribute_id);
+
+  // Seed the partition list with the input subarray
+  uint64_t subarray_size = 2 * array_schema->coords_size();
+  auto domain = array_schema->domain();
+  auto to_copy = (subarray != nullptr) ? (const uint8_t*)subarray :
+                                         (const uint8_t*)domain->domain();
+  partitions->clear();
+  partitions->emplace_back(to_copy, to_copy + subarray_size);
+
+  // Split every partition whose estimated read sizes exceed the budget,
+  // replacing it in place with its two halves so that the emitted
+  // partitions remain ordered according to the layout
+  std::vector<uint64_t> max_buffer_sizes(buffer_num);
+  auto it = partitions->begin();
+  while (it != partitions->end()) {
+    // Compute an upper bound on the read sizes of the partition
+    RETURN_NOT_OK(array_compute_max_read_buffer_sizes(
+        array_schema,
+        fragment_metadata,
+        &(*it)[0],
+        attribute_ids,
+        &max_buffer_sizes[0],
+        buffer_num));
+    uint64_t total_size = 0;
+    for (unsigned i = 0; i < buffer_num; ++i)
+      total_size += max_buffer_sizes[i];
+
+    // Omit partitions with no results
+    if (total_size == 0) {
+      it = partitions->erase(it);
+      continue;
+    }
+
+    // The partition fits in the budget
+    if (total_size <= budget) {
+      ++it;
+      continue;
+    }
+
+    // Split the partition
+    void* subarray_1 = nullptr;
+    void* subarray_2 = nullptr;
+    RETURN_NOT_OK(
+        domain->split_subarray(&(*it)[0], layout, &subarray_1, &subarray_2));
+    if (subarray_1 == nullptr || subarray_2 == nullptr) {
+      // The partition cannot be split any further; emit it as is
+      std::free(subarray_1);
+      std::free(subarray_2);
+      ++it;
+      continue;
+    }
+    auto part_1 = (const uint8_t*)subarray_1;
+    auto part_2 = (const uint8_t*)subarray_2;
+    it = partitions->erase(it);
+    it = partitions->emplace(it, part_2, part_2 + subarray_size);
+    it = partitions->emplace(it, part_1, part_1 + subarray_size);
+    std::free(subarray_1);
+    std::free(subarray_2);
+  }
+
+  return Status::Ok();
+}
+
+Status StorageManager::array_compute_est_read_buffer_sizes(
+    const char* array_uri,
+    const void* subarray,
+    const char** attributes,
+    unsigned attribute_num,
+    double confidence,
+    uint64_t* buffer_sizes) {
+  // Sanity check
+  if (confidence < 1.0)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot compute estimated read buffer sizes; Confidence factor "
+        "must not be less than 1.0"));
+
+  // Open the array
+  auto uri = URI(array_uri);
+  std::vector<FragmentMetadata*> metadata;
+  auto array_schema = (const ArraySchema*)nullptr;
+  RETURN_NOT_OK(array_open(uri, QueryType::READ, &array_schema, &metadata));
+
+  // Zero out all buffer sizes
+  unsigned buffer_num;
+  RETURN_NOT_OK_ELSE(
+      array_schema->buffer_num(attributes, attribute_num, &buffer_num),
+      array_close(uri));
+  for (unsigned i = 0; i < buffer_num; ++i)
+    buffer_sizes[i] = 0;
+
+  // Return if there are no metadata
+  if (metadata.empty())
+    return Status::Ok();
+
+  // Compute buffer sizes
+  std::vector<std::string> attributes_vec;
+  std::vector<unsigned> attribute_ids;
+  for (unsigned i = 0; i < attribute_num; ++i)
+    attributes_vec.emplace_back(attributes[i]);
+  RETURN_NOT_OK_ELSE(
+      array_schema->get_attribute_ids(attributes_vec, attribute_ids),
+      array_close(uri));
+  RETURN_NOT_OK_ELSE(
+      array_compute_est_read_buffer_sizes(
+          array_schema,
+          metadata,
+          subarray,
+          attribute_ids,
+          buffer_sizes,
+          buffer_num),
+      array_close(uri));
+
+  // Apply the confidence factor as headroom on the expectation
+  for (unsigned i = 0; i < buffer_num; ++i)
+    buffer_sizes[i] = (uint64_t)std::ceil(confidence * buffer_sizes[i]);
+
+  // Close array
+  return array_close(uri);
+}
+
 Status StorageManager::array_compute_max_read_buffer_sizes(
     const ArraySchema* array_schema,
     const std::vector<FragmentMetadata*>& fragment_metadata,
@@ -137,96 +384,276 @@ Status StorageManager::array_compute_max_read_buffer_sizes(
   for (unsigned i = 0; i < buffer_num; ++i)
     buffer_sizes[i] = 0;
 
+  // Check the memo cache. Clients commonly size their buffers with the
+  // same subarray before every read; the fragments are immutable, so
+  // identical inputs always yield the same bounds.
+  std::string memo_key;
+  for (const auto& meta : fragment_metadata)
+    memo_key += meta->fragment_uri().to_string() + ";";
+  memo_key.append(
+      static_cast<const char*>(subarray), 2 * array_schema->coords_size());
+  for (auto aid : attribute_ids)
+    memo_key += "," + std::to_string(aid);
+  {
+    std::lock_guard<std::mutex> lock(max_buffer_sizes_memo_mtx_);
+    auto it = max_buffer_sizes_memo_.find(memo_key);
+    if (it != max_buffer_sizes_memo_.end() &&
+        it->second.size() == buffer_num) {
+      std::memcpy(
+          buffer_sizes, it->second.data(), buffer_num * sizeof(uint64_t));
+      return Status::Ok();
+    }
+  }
+
   // Compute buffer sizes
+  Status st;
   switch (array_schema->coords_type()) {
     case Datatype::INT32:
-      return array_compute_max_read_buffer_sizes<int>(
+      st = array_compute_max_read_buffer_sizes<int>(
           array_schema,
           fragment_metadata,
           static_cast<const int*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::INT64:
-      return array_compute_max_read_buffer_sizes<int64_t>(
+      st = array_compute_max_read_buffer_sizes<int64_t>(
           array_schema,
           fragment_metadata,
           static_cast<const int64_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::FLOAT32:
-      return array_compute_max_read_buffer_sizes<float>(
+      st = array_compute_max_read_buffer_sizes<float>(
           array_schema,
           fragment_metadata,
           static_cast<const float*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::FLOAT64:
-      return array_compute_max_read_buffer_sizes<double>(
+      st = array_compute_max_read_buffer_sizes<double>(
           array_schema,
           fragment_metadata,
           static_cast<const double*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::INT8:
-      return array_compute_max_read_buffer_sizes<int8_t>(
+      st = array_compute_max_read_buffer_sizes<int8_t>(
           array_schema,
           fragment_metadata,
           static_cast<const int8_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::UINT8:
-      return array_compute_max_read_buffer_sizes<uint8_t>(
+      st = array_compute_max_read_buffer_sizes<uint8_t>(
           array_schema,
           fragment_metadata,
           static_cast<const uint8_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::INT16:
-      return array_compute_max_read_buffer_sizes<int16_t>(
+      st = array_compute_max_read_buffer_sizes<int16_t>(
           array_schema,
           fragment_metadata,
           static_cast<const int16_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::UINT16:
-      return array_compute_max_read_buffer_sizes<uint16_t>(
+      st = array_compute_max_read_buffer_sizes<uint16_t>(
           array_schema,
           fragment_metadata,
           static_cast<const uint16_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::UINT32:
-      return array_compute_max_read_buffer_sizes<uint32_t>(
+      st = array_compute_max_read_buffer_sizes<uint32_t>(
           array_schema,
           fragment_metadata,
           static_cast<const uint32_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     case Datatype::UINT64:
-      return array_compute_max_read_buffer_sizes<uint64_t>(
+      st = array_compute_max_read_buffer_sizes<uint64_t>(
           array_schema,
           fragment_metadata,
           static_cast<const uint64_t*>(subarray),
           attribute_ids,
           buffer_sizes,
           buffer_num);
+      break;
     default:
       return LOG_STATUS(Status::StorageManagerError(
           "Cannot compute max read buffer sizes; Invalid coordinates type"));
   }
+  RETURN_NOT_OK(st);
+
+  // Memoize the result, keeping the cache small
+  {
+    const uint64_t memo_max_entries = 256;
+    std::lock_guard<std::mutex> lock(max_buffer_sizes_memo_mtx_);
+    if (max_buffer_sizes_memo_.size() >= memo_max_entries)
+      max_buffer_sizes_memo_.clear();
+    max_buffer_sizes_memo_[memo_key].assign(
+        buffer_sizes, buffer_sizes + buffer_num);
+  }
+
+  return Status::Ok();
+}
+
+Status StorageManager::array_compute_est_read_buffer_sizes(
+    const ArraySchema* array_schema,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    const void* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    uint64_t* buffer_sizes,
+    unsigned buffer_num) {
+  // Zero out buffer sizes
+  for (unsigned i = 0; i < buffer_num; ++i)
+    buffer_sizes[i] = 0;
+
+  // Compute buffer sizes
+  switch (array_schema->coords_type()) {
+    case Datatype::INT32:
+      return array_compute_est_read_buffer_sizes<int>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const int*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::INT64:
+      return array_compute_est_read_buffer_sizes<int64_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const int64_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::FLOAT32:
+      return array_compute_est_read_buffer_sizes<float>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const float*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::FLOAT64:
+      return array_compute_est_read_buffer_sizes<double>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const double*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::INT8:
+      return array_compute_est_read_buffer_sizes<int8_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const int8_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::UINT8:
+      return array_compute_est_read_buffer_sizes<uint8_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const uint8_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::INT16:
+      return array_compute_est_read_buffer_sizes<int16_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const int16_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::UINT16:
+      return array_compute_est_read_buffer_sizes<uint16_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const uint16_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::UINT32:
+      return array_compute_est_read_buffer_sizes<uint32_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const uint32_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    case Datatype::UINT64:
+      return array_compute_est_read_buffer_sizes<uint64_t>(
+          array_schema,
+          fragment_metadata,
+          static_cast<const uint64_t*>(subarray),
+          attribute_ids,
+          buffer_sizes,
+          buffer_num);
+    default:
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot compute estimated read buffer sizes; Invalid coordinates "
+          "type"));
+  }
 
   return Status::Ok();
 }
 
+BufferPool* StorageManager::buffer_pool() const {
+  return buffer_pool_;
+}
+
+MemoryBudget* StorageManager::memory_budget() const {
+  return memory_budget_;
+}
+
+ThreadPool* StorageManager::compute_thread_pool() const {
+  return compute_thread_pool_;
+}
+
+ThreadPool* StorageManager::io_thread_pool() const {
+  return io_thread_pool_;
+}
+
+void StorageManager::shared_thread_pools(
+    uint64_t num_compute_threads,
+    uint64_t num_io_threads,
+    bool numa_aware,
+    ThreadPool** compute_thread_pool,
+    ThreadPool** io_thread_pool) {
+  // The shared pools are created once and intentionally never destroyed,
+  // as storage managers in other threads may outlive any particular one
+  static ThreadPool* shared_compute_pool = nullptr;
+  static ThreadPool* shared_io_pool = nullptr;
+  static std::once_flag once;
+  std::call_once(once, [&]() {
+    shared_compute_pool = new ThreadPool(num_compute_threads, numa_aware);
+    shared_io_pool = new ThreadPool(num_io_threads, numa_aware);
+  });
+  *compute_thread_pool = shared_compute_pool;
+  *io_thread_pool = shared_io_pool;
+}
+
 Status StorageManager::array_consolidate(const char* array_name) {
   // Check array URI
   URI array_uri(array_name);
@@ -242,6 +669,10 @@ Status StorageManager::array_consolidate(const char* array_name) {
     return LOG_STATUS(Status::StorageManagerError(
         "Cannot consolidate array; Array does not exist"));
   }
+
+  // Flush any pending combined writes, so that they get consolidated too
+  RETURN_NOT_OK(write_combiner_->flush(array_uri.to_string()));
+
   return consolidator_->consolidate(array_name);
 }
 
@@ -427,18 +858,29 @@ Status StorageManager::object_unlock(const URI& uri, LockType lock_type) {
   return st;
 }
 
-Status StorageManager::async_push_query(Query* query, int i) {
+Status StorageManager::async_push_query(Query* query) {
   // Set the request status
   query->set_status(QueryStatus::INPROGRESS);
 
+  // Estimate the query cost, so that small point reads get ahead of
+  // bulk scans. Writes and reads of unknown size (e.g. on real domains)
+  // keep their arrival order at the lowest priority.
+  uint64_t cost = UINT64_MAX;
+  if (query->type() == QueryType::READ && query->subarray() != nullptr) {
+    auto cell_num =
+        query->array_schema()->domain()->cell_num(query->subarray());
+    if (cell_num != 0)
+      cost = cell_num;
+  }
+
   // Push request
   {
-    std::lock_guard<std::mutex> lock(async_mtx_[i]);
-    async_queue_[i].emplace(query);
+    std::lock_guard<std::mutex> lock(async_mtx_);
+    async_queue_.push(AsyncQuery{cost, async_seq_++, query});
   }
 
-  // Signal AIO thread
-  async_cv_[i].notify_one();
+  // Signal an async worker
+  async_cv_.notify_one();
 
   return Status::Ok();
 }
@@ -479,6 +921,8 @@ Status StorageManager::object_remove(const char* path) const {
         std::string("Cannot remove object '") + path +
         "'; Invalid TileDB object"));
 
+  array_schemas_evict(uri);
+
   return vfs_->remove_dir(uri);
 }
 
@@ -501,6 +945,11 @@ Status StorageManager::object_move(
         std::string("Cannot move object '") + old_path +
         "'; Invalid TileDB object"));
 
+  // The destination is evicted too, in case an earlier object there got
+  // overwritten
+  array_schemas_evict(old_uri);
+  array_schemas_evict(new_uri);
+
   return vfs_->move_dir(old_uri, new_uri);
 }
 
@@ -539,18 +988,92 @@ Status StorageManager::group_create(const std::string& group) {
 }
 
 Status StorageManager::init(Config* config) {
+  // Detect the CPU features once at startup, so that kernels with
+  // multiple implementations dispatch without re-probing
+  cpu::features();
+
   if (config != nullptr)
     config_ = *config;
   consolidator_ = new Consolidator(this);
   Config::SMParams sm_params = config_.sm_params();
+  write_combiner_ = new WriteCombiner(this, sm_params.write_combining_budget_);
+  array_open_timestamp_ = sm_params.array_open_timestamp_;
+  Buffer::set_hugepage_threshold(sm_params.hugepage_threshold_);
+
+  // The caches charge their capacities against the memory budget up
+  // front, so the rest of the budget bounds the per-query tile buffers
+  memory_budget_ = new MemoryBudget(sm_params.memory_budget_);
+  memory_budget_->charge(sm_params.array_schema_cache_size_);
+  memory_budget_->charge(sm_params.fragment_metadata_cache_size_);
+  memory_budget_->charge(sm_params.tile_cache_size_);
+
   array_schema_cache_ = new LRUCache(sm_params.array_schema_cache_size_);
+  buffer_pool_ = new BufferPool();
   fragment_metadata_cache_ =
       new LRUCache(sm_params.fragment_metadata_cache_size_);
-  tile_cache_ = new LRUCache(sm_params.tile_cache_size_);
-  async_thread_[0] = new std::thread(async_start, this, 0);
-  async_thread_[1] = new std::thread(async_start, this, 1);
+  uint64_t num_compute_threads = std::max<uint64_t>(
+      sm_params.max_parallel_ops_, 1);
+  uint64_t num_io_threads = std::max<uint64_t>(
+      config_.vfs_params().max_parallel_ops_, 1);
+
+  // If a total concurrency budget is configured, it overrides the
+  // individual pool sizes, with the I/O vs. compute split determined by
+  // the configured ratio.
+  uint64_t concurrency_budget =
+      sm_params.concurrency_params_.total_budget_;
+  if (concurrency_budget > 0) {
+    num_io_threads = std::max<uint64_t>(
+        (uint64_t)((double)concurrency_budget *
+                   sm_params.concurrency_params_.io_ratio_),
+        1);
+    num_compute_threads = std::max<uint64_t>(
+        (concurrency_budget > num_io_threads) ?
+            concurrency_budget - num_io_threads :
+            0,
+        1);
+  }
+  tile_cache_ =
+      new ShardedLRUCache(sm_params.tile_cache_size_, num_compute_threads);
+  // The prefetcher feeds the cache raw file bytes, which only match
+  // the tile cache contents when the cache stores compressed tiles, so
+  // `sm.tile_prefetch` implies `sm.tile_cache_compressed`
+  tile_prefetch_ = sm_params.tile_prefetch_;
+  tile_cache_compressed_ = sm_params.tile_cache_compressed_ || tile_prefetch_;
+  if (!sm_params.disk_cache_dir_.empty()) {
+    disk_tile_cache_ =
+        new DiskCache(sm_params.disk_cache_dir_, sm_params.disk_cache_size_);
+    RETURN_NOT_OK(disk_tile_cache_->init());
+  }
+  uint64_t num_async_workers =
+      std::max<uint64_t>(sm_params.async_worker_num_, 1);
+  for (uint64_t i = 0; i < num_async_workers; ++i)
+    async_threads_.push_back(new std::thread(async_start, this));
+  shared_thread_pools_ = sm_params.shared_thread_pools_;
+  if (shared_thread_pools_) {
+    // All contexts created with `sm.shared_thread_pools` reference one
+    // process-wide pair of pools, sized by the first of them, so the
+    // process thread count reflects the hardware rather than the number
+    // of contexts
+    shared_thread_pools(
+        num_compute_threads,
+        num_io_threads,
+        sm_params.numa_aware_,
+        &compute_thread_pool_,
+        &io_thread_pool_);
+  } else {
+    compute_thread_pool_ =
+        new ThreadPool(num_compute_threads, sm_params.numa_aware_);
+    io_thread_pool_ = new ThreadPool(num_io_threads, sm_params.numa_aware_);
+  }
   vfs_ = new VFS();
   RETURN_NOT_OK(vfs_->init(config_.vfs_params()));
+
+  // The consolidation scheduler goes last, as it uses the members
+  // initialized above
+  if (sm_params.consolidation_scheduler_enable_)
+    consolidation_scheduler_thread_ =
+        new std::thread(consolidation_scheduler_start, this);
+
   return Status::Ok();
 }
 
@@ -589,6 +1112,17 @@ Status StorageManager::load_array_schema(
     return LOG_STATUS(Status::StorageManagerError(
         "Cannot load array schema; Invalid array URI"));
 
+  // Serve a copy of a cached deserialized schema, skipping the existence
+  // checks and the schema file read
+  {
+    std::lock_guard<std::mutex> lock(array_schemas_mtx_);
+    auto it = array_schemas_.find(array_uri.to_string());
+    if (it != array_schemas_.end()) {
+      *array_schema = new ArraySchema(it->second);
+      return Status::Ok();
+    }
+  }
+
   bool is_array = false;
   bool is_kv = false;
   RETURN_NOT_OK(this->is_array(array_uri, &is_array));
@@ -607,7 +1141,7 @@ Status StorageManager::load_array_schema(
   bool in_cache;
   auto buff = new Buffer();
   RETURN_NOT_OK_ELSE(
-      array_schema_cache_->read(schema_uri.to_string(), buff, &in_cache),
+      array_schema_cache_->read(CacheKey(schema_uri.id(), 0), buff, &in_cache),
       delete buff);
 
   // Read from file if not in cache
@@ -635,13 +1169,22 @@ Status StorageManager::load_array_schema(
 
   // Store in cache
   if (st.ok() && !in_cache && buff->size() <= array_schema_cache_->max_size()) {
-    buff->disown_data();
-    st = array_schema_cache_->insert(
-        schema_uri.to_string(), buff->data(), buff->size());
+    st = buff->disown_data();
+    if (st.ok())
+      st = array_schema_cache_->insert(
+          CacheKey(schema_uri.id(), 0), buff->data(), buff->size());
   }
 
   delete buff;
 
+  // Store a copy of the deserialized schema
+  if (st.ok()) {
+    std::lock_guard<std::mutex> lock(array_schemas_mtx_);
+    auto it = array_schemas_.find(array_uri.to_string());
+    if (it == array_schemas_.end())
+      array_schemas_[array_uri.to_string()] = new ArraySchema(*array_schema);
+  }
+
   return st;
 }
 
@@ -658,37 +1201,26 @@ Status StorageManager::load_fragment_metadata(
   URI fragment_metadata_uri = fragment_uri.join_path(
       std::string(constants::fragment_metadata_filename));
 
-  // Try to read from cache
+  // Read the serialized metadata
   bool in_cache;
-  auto buff = new Buffer();
-  RETURN_NOT_OK_ELSE(
-      fragment_metadata_cache_->read(
-          fragment_metadata_uri.to_string(), buff, &in_cache),
-      delete buff);
+  auto buff = (Buffer*)nullptr;
+  RETURN_NOT_OK(
+      read_fragment_metadata(fragment_metadata_uri, &buff, &in_cache));
 
-  // Read from file if not in cache
-  if (!in_cache) {
-    delete buff;
-    auto tile_io = new TileIO(this, fragment_metadata_uri);
-    auto tile = (Tile*)nullptr;
-    RETURN_NOT_OK_ELSE(tile_io->read_generic(&tile, 0), delete tile_io);
-    tile->disown_buff();
-    buff = tile->buffer();
-    delete tile;
-    delete tile_io;
-  }
-
-  // Deserialize
-  auto cbuff = new ConstBuffer(buff);
-  Status st = fragment_metadata->deserialize(cbuff);
-  delete cbuff;
+  // Deserialize. Metadata in the flat layout takes ownership of the
+  // buffer data and uses it in place; the metadata object itself lives
+  // for the lifetime of the process (see `fragment_metadata_`), so the
+  // blob need not be cached separately in that case.
+  bool took_ownership;
+  Status st = fragment_metadata->deserialize(buff, &took_ownership);
 
   // Store in cache
-  if (st.ok() && !in_cache &&
+  if (st.ok() && !took_ownership && !in_cache &&
       buff->size() <= fragment_metadata_cache_->max_size()) {
-    buff->disown_data();
-    st = fragment_metadata_cache_->insert(
-        fragment_metadata_uri.to_string(), buff->data(), buff->size());
+    st = buff->disown_data();
+    if (st.ok())
+      st = fragment_metadata_cache_->insert(
+          CacheKey(fragment_metadata_uri.id(), 0), buff->data(), buff->size());
   }
 
   delete buff;
@@ -696,6 +1228,31 @@ Status StorageManager::load_fragment_metadata(
   return st;
 }
 
+Status StorageManager::read_fragment_metadata(
+    const URI& fragment_metadata_uri, Buffer** buff, bool* in_cache) {
+  // Try to read from cache
+  *buff = new Buffer();
+  RETURN_NOT_OK_ELSE(
+      fragment_metadata_cache_->read(
+          CacheKey(fragment_metadata_uri.id(), 0), *buff, in_cache),
+      delete *buff);
+
+  // Read from file if not in cache
+  if (!*in_cache) {
+    delete *buff;
+    *buff = nullptr;
+    auto tile_io = new TileIO(this, fragment_metadata_uri);
+    auto tile = (Tile*)nullptr;
+    RETURN_NOT_OK_ELSE(tile_io->read_generic(&tile, 0), delete tile_io);
+    tile->disown_buff();
+    *buff = tile->buffer();
+    delete tile;
+    delete tile_io;
+  }
+
+  return Status::Ok();
+}
+
 Status StorageManager::object_type(const URI& uri, ObjectType* type) const {
   bool is_group;
   RETURN_NOT_OK(this->is_group(uri, &is_group));
@@ -783,6 +1340,74 @@ Status StorageManager::object_iter_begin(
   return Status::Ok();
 }
 
+Status StorageManager::ls_objects(
+    const std::vector<URI>& paths,
+    std::map<std::string, std::vector<URI>>* children) {
+  // List all paths concurrently, filtering out the non-TileDB objects
+  auto path_num = paths.size();
+  std::vector<std::vector<URI>> path_objs(path_num);
+  std::vector<std::future<Status>> tasks;
+  for (size_t i = 0; i < path_num; ++i) {
+    tasks.push_back(io_thread_pool_->enqueue([this, &paths, &path_objs, i]() {
+      std::vector<URI> uris;
+      RETURN_NOT_OK(vfs_->ls(paths[i], &uris));
+      ObjectType obj_type;
+      for (auto& uri : uris) {
+        RETURN_NOT_OK(object_type(uri, &obj_type));
+        if (obj_type != ObjectType::INVALID)
+          path_objs[i].push_back(uri);
+      }
+      return Status::Ok();
+    }));
+  }
+
+  // Wait for all the listings, recording the first error
+  Status st = Status::Ok();
+  for (auto& task : tasks) {
+    auto task_st = task.get();
+    if (st.ok() && !task_st.ok())
+      st = task_st;
+  }
+  RETURN_NOT_OK(st);
+
+  for (size_t i = 0; i < path_num; ++i)
+    (*children)[paths[i].to_string()] = std::move(path_objs[i]);
+
+  return Status::Ok();
+}
+
+Status StorageManager::object_iter_children(
+    ObjectIter* obj_iter, const URI& path, std::vector<URI>* children) {
+  // Upon a cache miss, list concurrently all the discovered directories
+  // that are pending a listing, i.e., `path` along with the not yet
+  // expanded objects of the iterator
+  auto it = obj_iter->children_.find(path.to_string());
+  if (it == obj_iter->children_.end()) {
+    std::vector<URI> frontier;
+    frontier.push_back(path);
+    auto expanded_it = obj_iter->expanded_.begin();
+    for (auto& obj : obj_iter->objs_) {
+      bool expanded = false;
+      if (obj_iter->order_ == WalkOrder::POSTORDER) {
+        expanded = *expanded_it;
+        ++expanded_it;
+      }
+      if (!expanded && obj.to_string() != path.to_string() &&
+          obj_iter->children_.find(obj.to_string()) ==
+              obj_iter->children_.end())
+        frontier.push_back(obj);
+    }
+    RETURN_NOT_OK(ls_objects(frontier, &obj_iter->children_));
+    it = obj_iter->children_.find(path.to_string());
+  }
+
+  // Consume the cache entry, as each directory is visited exactly once
+  *children = std::move(it->second);
+  obj_iter->children_.erase(it);
+
+  return Status::Ok();
+}
+
 void StorageManager::object_iter_free(ObjectIter* obj_iter) {
   delete obj_iter;
 }
@@ -817,17 +1442,14 @@ Status StorageManager::object_iter_next_postorder(
     do {
       obj_num = obj_iter->objs_.size();
       std::vector<URI> uris;
-      RETURN_NOT_OK(vfs_->ls(obj_iter->objs_.front(), &uris));
+      RETURN_NOT_OK(
+          object_iter_children(obj_iter, obj_iter->objs_.front(), &uris));
       obj_iter->expanded_.front() = true;
 
       // Push the new TileDB objects in the front of the iterator's list
-      ObjectType obj_type;
       for (auto it = uris.rbegin(); it != uris.rend(); ++it) {
-        RETURN_NOT_OK(object_type(*it, &obj_type));
-        if (obj_type != ObjectType::INVALID) {
-          obj_iter->objs_.push_front(*it);
-          obj_iter->expanded_.push_front(false);
-        }
+        obj_iter->objs_.push_front(*it);
+        obj_iter->expanded_.push_front(false);
       }
     } while (obj_num != obj_iter->objs_.size());
   }
@@ -864,15 +1486,11 @@ Status StorageManager::object_iter_next_preorder(
 
   // Get all contents of the next URI
   std::vector<URI> uris;
-  RETURN_NOT_OK(vfs_->ls(front_uri, &uris));
+  RETURN_NOT_OK(object_iter_children(obj_iter, front_uri, &uris));
 
   // Push the new TileDB objects in the front of the iterator's list
-  ObjectType obj_type;
-  for (auto it = uris.rbegin(); it != uris.rend(); ++it) {
-    RETURN_NOT_OK(object_type(*it, &obj_type));
-    if (obj_type != ObjectType::INVALID)
-      obj_iter->objs_.push_front(*it);
-  }
+  for (auto it = uris.rbegin(); it != uris.rend(); ++it)
+    obj_iter->objs_.push_front(*it);
 
   return Status::Ok();
 }
@@ -905,6 +1523,21 @@ Status StorageManager::query_init(
   return Status::Ok();
 }
 
+Status StorageManager::query_init(
+    Query* query,
+    const ArraySchema* array_schema,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    QueryType type) {
+  // The array has been opened by the caller, who keeps it open for the
+  // lifetime of the query; simply set the basic query members
+  query->set_storage_manager(this);
+  query->set_type(type);
+  query->set_array_schema(array_schema);
+  query->set_fragment_metadata(fragment_metadata);
+
+  return Status::Ok();
+}
+
 Status StorageManager::query_init(
     Query* query,
     const char* array_name,
@@ -915,12 +1548,28 @@ Status StorageManager::query_init(
     unsigned int attribute_num,
     void** buffers,
     uint64_t* buffer_sizes,
-    const URI& consolidation_fragment_uri) {
-  // Open the array
+    const URI& consolidation_fragment_uri,
+    const std::vector<URI>* fragment_uris) {
+  // Open the array, pruning the fragments that do not overlap the
+  // subarray of a read query
   std::vector<FragmentMetadata*> fragment_metadata;
   auto array_schema = (const ArraySchema*)nullptr;
-  RETURN_NOT_OK(
-      array_open(URI(array_name), type, &array_schema, &fragment_metadata));
+  RETURN_NOT_OK(array_open(
+      URI(array_name), type, &array_schema, &fragment_metadata, subarray));
+
+  // Restrict the query to the given fragments, if requested
+  if (fragment_uris != nullptr) {
+    std::vector<FragmentMetadata*> filtered;
+    for (auto metadata : fragment_metadata) {
+      for (const auto& uri : *fragment_uris) {
+        if (metadata->fragment_uri().to_string() == uri.to_string()) {
+          filtered.push_back(metadata);
+          break;
+        }
+      }
+    }
+    fragment_metadata = filtered;
+  }
 
   // Initialize query
   return query->init(
@@ -937,7 +1586,185 @@ Status StorageManager::query_init(
       consolidation_fragment_uri);
 }
 
+Status StorageManager::query_init_from_plan(
+    Query* query, const void* plan, uint64_t plan_size, uint64_t partition_idx) {
+  // Parse the plan
+  ConstBuffer buff(plan, plan_size);
+  uint32_t version;
+  RETURN_NOT_OK(buff.read(&version, sizeof(version)));
+  if (version != 1)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot initialize query from plan; Unsupported plan version"));
+  uint64_t uri_size;
+  RETURN_NOT_OK(buff.read(&uri_size, sizeof(uri_size)));
+  std::string uri_str;
+  uri_str.resize(uri_size);
+  RETURN_NOT_OK(buff.read(&uri_str[0], uri_size));
+  char layout_c;
+  RETURN_NOT_OK(buff.read(&layout_c, sizeof(layout_c)));
+  uint64_t fragment_num;
+  RETURN_NOT_OK(buff.read(&fragment_num, sizeof(fragment_num)));
+  std::vector<std::string> fragment_uris(fragment_num);
+  for (uint64_t f = 0; f < fragment_num; ++f) {
+    uint64_t frag_size;
+    RETURN_NOT_OK(buff.read(&frag_size, sizeof(frag_size)));
+    fragment_uris[f].resize(frag_size);
+    RETURN_NOT_OK(buff.read(&(fragment_uris[f])[0], frag_size));
+  }
+  uint64_t subarray_size;
+  RETURN_NOT_OK(buff.read(&subarray_size, sizeof(subarray_size)));
+  uint64_t partition_num;
+  RETURN_NOT_OK(buff.read(&partition_num, sizeof(partition_num)));
+  if (partition_idx >= partition_num)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot initialize query from plan; Invalid partition index"));
+  std::vector<uint8_t> partition(subarray_size);
+  for (uint64_t p = 0; p <= partition_idx; ++p)
+    RETURN_NOT_OK(buff.read(&partition[0], subarray_size));
+
+  // Open the array
+  auto uri = URI(uri_str);
+  std::vector<FragmentMetadata*> fragment_metadata;
+  auto array_schema = (const ArraySchema*)nullptr;
+  RETURN_NOT_OK(array_open(
+      uri, QueryType::READ, &array_schema, &fragment_metadata));
+  if (2 * array_schema->coords_size() != subarray_size) {
+    array_close(uri);
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot initialize query from plan; Subarray size mismatch"));
+  }
+
+  // Restrict the query to the fragment snapshot recorded in the plan,
+  // so that all workers executing the plan observe the same data
+  std::vector<FragmentMetadata*> filtered;
+  for (const auto& frag_uri : fragment_uris) {
+    bool found = false;
+    for (auto metadata : fragment_metadata) {
+      if (metadata->fragment_uri().to_string() == frag_uri) {
+        filtered.push_back(metadata);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      array_close(uri);
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot initialize query from plan; The fragment snapshot of the "
+          "plan is no longer available"));
+    }
+  }
+
+  // Set the query members, constraining the query on the partition
+  query->set_storage_manager(this);
+  query->set_type(QueryType::READ);
+  query->set_array_schema(array_schema);
+  query->set_fragment_metadata(filtered);
+  RETURN_NOT_OK_ELSE(
+      query->set_layout(static_cast<Layout>(layout_c)), array_close(uri));
+  RETURN_NOT_OK_ELSE(query->set_subarray(&partition[0]), array_close(uri));
+
+  return Status::Ok();
+}
+
+Status StorageManager::query_plan(
+    const char* array_uri,
+    const void* subarray,
+    Layout layout,
+    const char** attributes,
+    unsigned attribute_num,
+    uint64_t budget,
+    Buffer* plan,
+    uint64_t* partition_num) {
+  // Sanity check
+  if (budget == 0)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot plan query; Invalid memory budget"));
+
+  // Open the array once; this is the fragment snapshot the plan records
+  auto uri = URI(array_uri);
+  std::vector<FragmentMetadata*> metadata;
+  auto array_schema = (const ArraySchema*)nullptr;
+  RETURN_NOT_OK(array_open(uri, QueryType::READ, &array_schema, &metadata));
+
+  // Resolve the attributes; `nullptr` means all attributes, plus the
+  // coordinates if the array is sparse
+  std::vector<std::string> attributes_vec;
+  if (attributes == nullptr) {
+    attributes_vec = array_schema->attribute_names();
+    if (!array_schema->dense())
+      attributes_vec.emplace_back(constants::coords);
+  } else {
+    for (unsigned i = 0; i < attribute_num; ++i)
+      attributes_vec.emplace_back(attributes[i]);
+  }
+  std::vector<unsigned> attribute_ids;
+  RETURN_NOT_OK_ELSE(
+      array_schema->get_attribute_ids(attributes_vec, attribute_ids),
+      array_close(uri));
+
+  // Partition the subarray against the fragment snapshot
+  std::list<std::vector<uint8_t>> partitions;
+  RETURN_NOT_OK_ELSE(
+      compute_subarray_partitions(
+          array_schema,
+          metadata,
+          subarray,
+          layout,
+          attribute_ids,
+          budget,
+          &partitions),
+      array_close(uri));
+
+  // Serialize the plan
+  uint32_t version = 1;
+  auto uri_str = uri.to_string();
+  uint64_t uri_size = uri_str.size();
+  auto layout_c = (char)layout;
+  uint64_t fragment_num = metadata.size();
+  uint64_t subarray_size = 2 * array_schema->coords_size();
+  *partition_num = partitions.size();
+  auto st = plan->write(&version, sizeof(version));
+  if (st.ok())
+    st = plan->write(&uri_size, sizeof(uri_size));
+  if (st.ok())
+    st = plan->write(uri_str.data(), uri_size);
+  if (st.ok())
+    st = plan->write(&layout_c, sizeof(layout_c));
+  if (st.ok())
+    st = plan->write(&fragment_num, sizeof(fragment_num));
+  for (auto meta : metadata) {
+    if (!st.ok())
+      break;
+    auto frag_str = meta->fragment_uri().to_string();
+    uint64_t frag_size = frag_str.size();
+    st = plan->write(&frag_size, sizeof(frag_size));
+    if (st.ok())
+      st = plan->write(frag_str.data(), frag_size);
+  }
+  if (st.ok())
+    st = plan->write(&subarray_size, sizeof(subarray_size));
+  if (st.ok())
+    st = plan->write(partition_num, sizeof(*partition_num));
+  for (const auto& partition : partitions) {
+    if (!st.ok())
+      break;
+    st = plan->write(&partition[0], subarray_size);
+  }
+  RETURN_NOT_OK_ELSE(st, array_close(uri));
+
+  // Close the array
+  return array_close(uri);
+}
+
 Status StorageManager::query_submit(Query* query) {
+  // Buffer small unordered writes in the write combiner; a combined
+  // query is complete. Non-combinable queries flush the pending writes
+  // of their array first, so they observe them.
+  bool combined;
+  RETURN_NOT_OK(write_combiner_->combine(query, &combined));
+  if (combined)
+    return Status::Ok();
+
   // Initialize query
   if (query->status() != QueryStatus::INCOMPLETE)
     RETURN_NOT_OK(query->init());
@@ -950,6 +1777,61 @@ Status StorageManager::query_submit(Query* query) {
   return query->write();
 }
 
+Status StorageManager::query_submit_batch(Query** queries, uint64_t query_num) {
+  // Trivial case
+  if (query_num == 0)
+    return Status::Ok();
+
+  // Initialize the queries first, so that initialization errors surface
+  // before anything is scheduled
+  for (uint64_t i = 0; i < query_num; ++i) {
+    if (queries[i]->status() != QueryStatus::INCOMPLETE)
+      RETURN_NOT_OK(queries[i]->init());
+  }
+
+  // Completion bookkeeping shared by all the batch callbacks
+  std::mutex mtx;
+  std::condition_variable cv;
+  uint64_t pending = query_num;
+  auto callback = [&mtx, &cv, &pending](void*) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (--pending == 0)
+      cv.notify_all();
+  };
+
+  // Push the queries to the async queue; the queue orders them by
+  // estimated cost and the async workers process them cooperatively
+  for (uint64_t i = 0; i < query_num; ++i) {
+    queries[i]->set_callback(callback, nullptr);
+    auto st = async_push_query(queries[i]);
+    if (!st.ok()) {  // The query will never run; account for it here
+      queries[i]->set_status(QueryStatus::FAILED);
+      std::lock_guard<std::mutex> lock(mtx);
+      --pending;
+    }
+  }
+
+  // Wait for the batch to complete
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&pending] { return pending == 0; });
+  }
+
+  // Clear the callbacks, which refer to state local to this call
+  for (uint64_t i = 0; i < query_num; ++i)
+    queries[i]->set_callback(nullptr, nullptr);
+
+  // Report an error if any query failed; the per-query statuses remain
+  // retrievable from the query objects
+  for (uint64_t i = 0; i < query_num; ++i) {
+    if (queries[i]->status() == QueryStatus::FAILED)
+      return LOG_STATUS(Status::StorageManagerError(
+          "Batch query submission failed; A query in the batch failed"));
+  }
+
+  return Status::Ok();
+}
+
 Status StorageManager::query_submit_async(
     Query* query, std::function<void(void*)> callback, void* callback_data) {
   // Initialize query
@@ -958,7 +1840,17 @@ Status StorageManager::query_submit_async(
 
   // Push the query into the async queue
   query->set_callback(callback, callback_data);
-  return async_push_query(query, 0);
+  return async_push_query(query);
+}
+
+Status StorageManager::query_submit_async(
+    Query* query,
+    std::function<void(void*)> callback,
+    void* callback_data,
+    std::function<void(void*)> progress_callback,
+    void* progress_callback_data) {
+  query->set_progress_callback(progress_callback, progress_callback_data);
+  return query_submit_async(query, callback, callback_data);
 }
 
 Status StorageManager::read_from_cache(
@@ -967,17 +1859,199 @@ Status StorageManager::read_from_cache(
     Buffer* buffer,
     uint64_t nbytes,
     bool* in_cache) const {
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
+  // Feed the request into the predictive prefetcher; hits extend the
+  // pattern too, keeping an ongoing sequence one tile ahead
+  if (tile_prefetch_)
+    tile_prefetch_observe(uri, offset, nbytes);
+
+  CacheKey key(uri.id(), offset);
   RETURN_NOT_OK(buffer->realloc(nbytes));
-  RETURN_NOT_OK(
-      tile_cache_->read(key.str(), buffer->data(), 0, nbytes, in_cache));
+  RETURN_NOT_OK(tile_cache_->read(key, buffer->data(), 0, nbytes, in_cache));
+
+  // Fall through to the second-tier disk cache upon a memory cache
+  // miss, promoting a hit back into the memory cache. The disk tier is
+  // keyed by URI string, which is stable across process runs (unlike
+  // `URI::id`); building it here is off the hot path, as a disk lookup
+  // follows anyway.
+  if (!*in_cache && disk_tile_cache_ != nullptr) {
+    std::stringstream disk_key;
+    disk_key << uri.to_string() << "+" << offset;
+    RETURN_NOT_OK(disk_tile_cache_->read(
+        disk_key.str(), buffer->data(), nbytes, in_cache));
+    if (*in_cache) {
+      void* object = std::malloc(nbytes);
+      if (object != nullptr) {
+        std::memcpy(object, buffer->data(), nbytes);
+        RETURN_NOT_OK(tile_cache_->insert(key, object, nbytes, false));
+      }
+    }
+  }
+
   buffer->set_size(nbytes);
   buffer->reset_offset();
 
   return Status::Ok();
 }
 
+Status StorageManager::read_shared_from_cache(
+    const URI& uri,
+    uint64_t offset,
+    std::shared_ptr<void>* object,
+    uint64_t* size,
+    bool* in_cache) const {
+  CacheKey key(uri.id(), offset);
+  RETURN_NOT_OK(tile_cache_->read_shared(key, object, size, in_cache));
+
+  // Fall through to the second-tier disk cache upon a memory cache
+  // miss, sharing the disk object with the caller and promoting a copy
+  // back into the memory cache (which owns what it stores)
+  if (!*in_cache && disk_tile_cache_ != nullptr) {
+    std::stringstream disk_key;
+    disk_key << uri.to_string() << "+" << offset;
+    void* disk_object;
+    uint64_t disk_size;
+    RETURN_NOT_OK(disk_tile_cache_->read(
+        disk_key.str(), &disk_object, &disk_size, in_cache));
+    if (*in_cache) {
+      *object = std::shared_ptr<void>(disk_object, std::free);
+      *size = disk_size;
+      void* promoted = std::malloc(disk_size);
+      if (promoted != nullptr) {
+        std::memcpy(promoted, disk_object, disk_size);
+        RETURN_NOT_OK(tile_cache_->insert(key, promoted, disk_size, false));
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
+bool StorageManager::tile_cache_compressed() const {
+  return tile_cache_compressed_;
+}
+
+bool StorageManager::tile_fetch_begin(const URI& uri, uint64_t offset) {
+  CacheKey key(uri.id(), offset);
+
+  std::shared_ptr<InFlightTileFetch> fetch;
+  {
+    std::lock_guard<std::mutex> lock(inflight_tile_fetches_mtx_);
+    auto it = inflight_tile_fetches_.find(key);
+    if (it == inflight_tile_fetches_.end()) {
+      inflight_tile_fetches_[key] = std::make_shared<InFlightTileFetch>();
+      return true;
+    }
+    fetch = it->second;
+  }
+
+  // Wait for the in-flight fetch to complete
+  std::unique_lock<std::mutex> lock(fetch->mtx_);
+  fetch->cv_.wait(lock, [&fetch]() { return fetch->done_; });
+
+  return false;
+}
+
+void StorageManager::tile_fetch_end(const URI& uri, uint64_t offset) {
+  CacheKey key(uri.id(), offset);
+
+  std::shared_ptr<InFlightTileFetch> fetch;
+  {
+    std::lock_guard<std::mutex> lock(inflight_tile_fetches_mtx_);
+    auto it = inflight_tile_fetches_.find(key);
+    if (it == inflight_tile_fetches_.end())
+      return;
+    fetch = it->second;
+    inflight_tile_fetches_.erase(it);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(fetch->mtx_);
+    fetch->done_ = true;
+  }
+  fetch->cv_.notify_all();
+}
+
+void StorageManager::tile_prefetch_observe(
+    const URI& uri, uint64_t offset, uint64_t nbytes) const {
+  bool predict = false;
+  uint64_t pred_offset = 0;
+  {
+    std::lock_guard<std::mutex> lock(tile_prefetch_mtx_);
+    if (tile_prefetch_stop_)
+      return;
+
+    // Cap the tracked files, evicting an arbitrary pattern when full
+    auto it = tile_access_patterns_.find(uri.id());
+    if (it == tile_access_patterns_.end() &&
+        tile_access_patterns_.size() >= constants::tile_prefetch_max_uris)
+      tile_access_patterns_.erase(tile_access_patterns_.begin());
+
+    auto& pattern = tile_access_patterns_[uri.id()];
+    int64_t stride = (int64_t)offset - (int64_t)pattern.offset_;
+    if (pattern.nbytes_ == nbytes && stride == pattern.stride_ && stride != 0)
+      ++pattern.confirmations_;
+    else
+      pattern.confirmations_ = 0;
+    pattern.offset_ = offset;
+    pattern.nbytes_ = nbytes;
+    pattern.stride_ = stride;
+
+    // Predict the next tile one stride ahead (in either direction) once
+    // the stride has repeated enough, bounding the speculation in flight
+    if (pattern.confirmations_ >= constants::tile_prefetch_confirmations &&
+        tile_prefetches_inflight_ < constants::tile_prefetch_max_inflight &&
+        (stride > 0 || offset >= (uint64_t)(-stride))) {
+      predict = true;
+      pred_offset = offset + stride;
+      ++tile_prefetches_inflight_;
+    }
+  }
+
+  if (!predict)
+    return;
+
+  // Speculation mutates only the caches, which are not part of the
+  // logically `const` state observed through the read path
+  auto self = const_cast<StorageManager*>(this);
+  self->io_thread_pool_->enqueue([self, uri, pred_offset, nbytes]() {
+    self->tile_prefetch(uri, pred_offset, nbytes);
+    return Status::Ok();
+  });
+}
+
+void StorageManager::tile_prefetch(
+    const URI& uri, uint64_t offset, uint64_t nbytes) {
+  bool stop;
+  {
+    std::lock_guard<std::mutex> lock(tile_prefetch_mtx_);
+    stop = tile_prefetch_stop_;
+  }
+
+  // Skip tiles that are already cached or being fetched; `false` from
+  // `tile_fetch_begin` means a concurrent fetch of the tile completed
+  if (!stop && tile_fetch_begin(uri, offset)) {
+    bool in_cache = false;
+    std::shared_ptr<void> object;
+    uint64_t size;
+    auto st = read_shared_from_cache(uri, offset, &object, &size, &in_cache);
+    if (st.ok() && !in_cache) {
+      // Fetch the raw tile bytes and cache them; a failed speculative
+      // read (e.g. a prediction past the end of the file) is dropped
+      Buffer buffer;
+      st = read(uri, offset, &buffer, nbytes);
+      if (st.ok())
+        write_to_cache(uri, offset, &buffer);
+    }
+    tile_fetch_end(uri, offset);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(tile_prefetch_mtx_);
+    --tile_prefetches_inflight_;
+  }
+  tile_prefetch_cv_.notify_all();
+}
+
 Status StorageManager::read(
     const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const {
   RETURN_NOT_OK(buffer->realloc(nbytes));
@@ -988,6 +2062,21 @@ Status StorageManager::read(
   return Status::Ok();
 }
 
+Status StorageManager::read_at_most(
+    const URI& uri,
+    uint64_t offset,
+    Buffer* buffer,
+    uint64_t nbytes,
+    uint64_t* nbytes_read) const {
+  RETURN_NOT_OK(buffer->realloc(nbytes));
+  RETURN_NOT_OK(
+      vfs_->read_at_most(uri, offset, buffer->data(), nbytes, nbytes_read));
+  buffer->set_size(*nbytes_read);
+  buffer->reset_offset();
+
+  return Status::Ok();
+}
+
 Status StorageManager::store_array_schema(ArraySchema* array_schema) {
   auto& array_uri = array_schema->array_uri();
   URI array_schema_uri = array_uri.join_path(constants::array_schema_filename);
@@ -1035,9 +2124,18 @@ Status StorageManager::store_fragment_metadata(FragmentMetadata* metadata) {
   if (!is_dir)
     return Status::Ok();
 
+  // Store the fragment summary before the metadata file, which acts as
+  // the fragment commit marker. The summary is an optimization, so a
+  // failure here is only logged; readers fall back to the full metadata
+  // load for fragments without a (valid) summary file.
+  Status st_summary = store_fragment_summary(metadata);
+  if (!st_summary.ok())
+    LOG_STATUS(st_summary);
+
   // Serialize
   auto buff = new Buffer();
-  RETURN_NOT_OK_ELSE(metadata->serialize(buff), delete buff);
+  RETURN_NOT_OK_ELSE(
+      metadata->serialize(buff, compute_thread_pool()), delete buff);
 
   // Write to file
   URI fragment_metadata_uri = fragment_uri.join_path(
@@ -1077,7 +2175,11 @@ VFS* StorageManager::vfs() const {
 }
 
 Status StorageManager::write_to_cache(
-    const URI& uri, uint64_t offset, Buffer* buffer) const {
+    const URI& uri, uint64_t offset, Buffer* buffer, CacheHint hint) const {
+  // Do nothing if the requesting query declared a streaming/one-shot read
+  if (hint == CacheHint::CACHE_BYPASS)
+    return Status::Ok();
+
   // Do nothing if the object size is larger than the cache size
   uint64_t object_size = buffer->size();
   if (object_size > tile_cache_->max_size())
@@ -1092,8 +2194,7 @@ Status StorageManager::write_to_cache(
   }
 
   // Generate key (uri + offset)
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
+  CacheKey key(uri.id(), offset);
 
   // Insert to cache
   void* object = std::malloc(object_size);
@@ -1101,7 +2202,18 @@ Status StorageManager::write_to_cache(
     return LOG_STATUS(Status::StorageManagerError(
         "Cannot write to cache; Object memory allocation failed"));
   std::memcpy(object, buffer->data(), object_size);
-  RETURN_NOT_OK(tile_cache_->insert(key.str(), object, object_size, false));
+  RETURN_NOT_OK(tile_cache_->insert(
+      key, object, object_size, false, hint == CacheHint::CACHE_PIN));
+
+  // Queue the object for the second-tier disk cache, which is keyed by
+  // URI string so that its contents survive across process runs; the
+  // copy is performed by its background writer
+  if (disk_tile_cache_ != nullptr) {
+    std::stringstream disk_key;
+    disk_key << uri.to_string() << "+" << offset;
+    RETURN_NOT_OK(
+        disk_tile_cache_->insert(disk_key.str(), buffer->data(), object_size));
+  }
 
   return Status::Ok();
 }
@@ -1115,15 +2227,16 @@ Status StorageManager::write(const URI& uri, Buffer* buffer) const {
 /* ****************************** */
 
 Status StorageManager::array_close(URI array_uri) {
-  // Lock mutex
-  open_array_mtx_.lock();
+  // Lock the registry shard of the array
+  auto shard = open_array_shard(array_uri);
+  shard->mtx_.lock();
 
   // Find the open array entry
-  auto it = open_arrays_.find(array_uri.to_string());
+  auto it = shard->open_arrays_.find(array_uri.to_string());
 
   // Sanity check
-  if (it == open_arrays_.end()) {
-    open_array_mtx_.unlock();
+  if (it == shard->open_arrays_.end()) {
+    shard->mtx_.unlock();
     return LOG_STATUS(Status::StorageManagerError(
         "Cannot close array; Open array entry not found"));
   }
@@ -1131,24 +2244,17 @@ Status StorageManager::array_close(URI array_uri) {
   // For easy reference
   OpenArray* open_array = it->second;
 
-  // Lock the mutex of the array
-  open_array->mtx_lock();
-
-  // Decrement counter
+  // Decrement counter and potentially remove the open array entry. The
+  // counter is mutated only under the shard mutex, so when it drops to
+  // zero no other thread can be holding the open array.
   open_array->decr_cnt();
-
-  // Potentially remove open array entry
   if (open_array->cnt() == 0) {
-    open_array->mtx_unlock();
     delete open_array;
-    open_arrays_.erase(it);
-  } else {
-    // Unlock the mutex of the array
-    open_array->mtx_unlock();
+    shard->open_arrays_.erase(it);
   }
 
-  // Unlock mutex
-  open_array_mtx_.unlock();
+  // Unlock the shard
+  shard->mtx_.unlock();
 
   // Unlock the array
   RETURN_NOT_OK(object_unlock(array_uri, SLOCK));
@@ -1169,11 +2275,95 @@ Status StorageManager::array_compute_max_read_buffer_sizes(
 
   // First we calculate a rough upper bound. Especially for dense
   // arrays, this will not be accurate, as it accounts only for the
-  // non-empty regions of the subarray.
+  // non-empty regions of the subarray. The fragments are independent,
+  // so they are processed concurrently on the compute thread pool, each
+  // into its own partial sums.
+  auto fragment_num = metadata.size();
+  std::vector<std::vector<uint64_t>> partial_sizes(
+      fragment_num, std::vector<uint64_t>(buffer_num, 0));
+  auto compute_fragment = [&](size_t f) {
+    auto meta = metadata[f];
+
+    // Skip fragments whose non-empty domain does not overlap the subarray
+    auto non_empty_domain = static_cast<const T*>(meta->non_empty_domain());
+    if (non_empty_domain != nullptr &&
+        !utils::overlap(subarray, non_empty_domain, array_schema->dim_num()))
+      return Status::Ok();
+
+    // The variable tile sizes are materialized lazily
+    for (auto aid : attribute_ids) {
+      if (array_schema->var_size(aid))
+        RETURN_NOT_OK(meta->load_tile_offsets(aid));
+    }
+    return meta->compute_max_read_buffer_sizes(
+        subarray, attribute_ids, buffer_num, &partial_sizes[f][0]);
+  };
+
+  if (fragment_num == 1 || compute_thread_pool_ == nullptr) {
+    for (size_t f = 0; f < fragment_num; ++f)
+      RETURN_NOT_OK(compute_fragment(f));
+  } else {
+    std::vector<std::future<Status>> tasks;
+    for (size_t f = 0; f < fragment_num; ++f)
+      tasks.push_back(compute_thread_pool_->enqueue(
+          [&compute_fragment, f]() { return compute_fragment(f); }));
+    if (!compute_thread_pool_->wait_all(tasks))
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot compute max read buffer sizes; Fragment processing "
+          "failed"));
+  }
+
+  // Accumulate the per-fragment bounds
+  for (size_t f = 0; f < fragment_num; ++f)
+    for (unsigned i = 0; i < buffer_num; ++i)
+      buffer_sizes[i] += partial_sizes[f][i];
+
+  // Rectify bound for dense arrays
+  if (array_schema->dense()) {
+    unsigned bid = 0;
+    auto cell_num = array_schema->domain()->cell_num(subarray);
+    for (auto aid : attribute_ids) {
+      if (array_schema->var_size(aid)) {
+        buffer_sizes[bid++] = cell_num * constants::cell_var_offset_size;
+        buffer_sizes[bid++] +=
+            cell_num * datatype_size(array_schema->type(aid));
+      } else {
+        buffer_sizes[bid++] = cell_num * array_schema->cell_size(aid);
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status StorageManager::array_compute_est_read_buffer_sizes(
+    const ArraySchema* array_schema,
+    const std::vector<FragmentMetadata*>& metadata,
+    const T* subarray,
+    const std::vector<unsigned>& attribute_ids,
+    uint64_t* buffer_sizes,
+    unsigned buffer_num) {
+  // Sanity check
+  assert(!metadata.empty());
+
+  // Sum up the per-fragment estimates
   auto meta_buffer_sizes = new uint64_t[buffer_num];
   for (auto& meta : metadata) {
+    // Skip fragments whose non-empty domain does not overlap the subarray
+    auto non_empty_domain = static_cast<const T*>(meta->non_empty_domain());
+    if (non_empty_domain != nullptr &&
+        !utils::overlap(subarray, non_empty_domain, array_schema->dim_num()))
+      continue;
+
+    // The variable tile sizes are materialized lazily
+    for (auto aid : attribute_ids) {
+      if (array_schema->var_size(aid))
+        RETURN_NOT_OK_ELSE(
+            meta->load_tile_offsets(aid), delete[] meta_buffer_sizes);
+    }
     RETURN_NOT_OK_ELSE(
-        meta->compute_max_read_buffer_sizes(
+        meta->compute_est_read_buffer_sizes(
             subarray, attribute_ids, buffer_num, meta_buffer_sizes),
         delete[] meta_buffer_sizes);
     for (unsigned i = 0; i < buffer_num; ++i)
@@ -1181,7 +2371,7 @@ Status StorageManager::array_compute_max_read_buffer_sizes(
   }
   delete[] meta_buffer_sizes;
 
-  // Rectify bound for dense arrays
+  // For dense arrays the subarray cell number is exact
   if (array_schema->dense()) {
     unsigned bid = 0;
     auto cell_num = array_schema->domain()->cell_num(subarray);
@@ -1230,7 +2420,14 @@ Status StorageManager::array_open(
     const URI& array_uri,
     QueryType type,
     const ArraySchema** array_schema,
-    std::vector<FragmentMetadata*>* fragment_metadata) {
+    std::vector<FragmentMetadata*>* fragment_metadata,
+    const void* subarray) {
+  // A read takes its fragment snapshot here, so any pending combined
+  // writes of the array must reach storage first. The combiner itself
+  // only opens arrays for writing, so this cannot recurse.
+  if (type == QueryType::READ && write_combiner_ != nullptr)
+    RETURN_NOT_OK(write_combiner_->flush(array_uri.to_string()));
+
   // Check if array exists
   bool is_array = false;
   RETURN_NOT_OK(this->is_array(array_uri, &is_array));
@@ -1246,49 +2443,167 @@ Status StorageManager::array_open(
   // Lock the array in shared mode
   RETURN_NOT_OK(object_lock(array_uri, SLOCK));
 
-  // Lock mutex
-  open_array_mtx_.lock();
-
-  // Get the open array entry
+  // Get the open array entry from the registry shard, incrementing the
+  // counter so that the entry cannot be removed while this open is in
+  // progress
+  auto shard = open_array_shard(array_uri);
+  shard->mtx_.lock();
   OpenArray* open_array;
-  Status st = open_array_get_entry(array_uri, &open_array);
+  Status st = open_array_get_entry(shard, array_uri, &open_array);
   if (!st.ok()) {
-    open_array_mtx_.unlock();
+    shard->mtx_.unlock();
     return st;
   }
-
-  // Lock the mutex of the array
-  open_array->mtx_lock();
-
-  // Unlock mutex
-  open_array_mtx_.unlock();
-
-  // Increment counter
   open_array->incr_cnt();
+  shard->mtx_.unlock();
+
+  // Kick off the fragment listing on the I/O thread pool, overlapping
+  // it with the schema load below; the two do not depend on each other
+  std::vector<URI> fragment_uris;
+  std::vector<std::future<Status>> list_task;
+  if (type == QueryType::READ)
+    list_task.push_back(
+        io_thread_pool_->enqueue([this, array_uri, &fragment_uris]() {
+          RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
+          sort_fragment_uris(&fragment_uris);
+          filter_fragment_uris(&fragment_uris);
+          return Status::Ok();
+        }));
+
+  // If the array schema is already loaded, lock the array in shared mode,
+  // so that concurrent opens of the same array do not serialize; the
+  // fragment metadata map of the open array is internally synchronized.
+  // Otherwise, lock in exclusive mode for loading the schema.
+  bool shared_mode = (open_array->array_schema() != nullptr);
+  if (shared_mode)
+    open_array->mtx_lock_shared();
+  else
+    open_array->mtx_lock();
 
   // Load array schema
-  RETURN_NOT_OK_ELSE(
-      open_array_load_array_schema(array_uri, open_array),
-      array_open_error(open_array));
+  Status st_schema = open_array_load_array_schema(array_uri, open_array);
+
+  // Join the listing before any early return, as the task writes into
+  // local state
+  Status st_list = Status::Ok();
+  if (type == QueryType::READ && !io_thread_pool_->wait_all(list_task))
+    st_list = LOG_STATUS(Status::StorageManagerError(
+        "Cannot open array; fragment listing failed"));
+  if (!st_schema.ok() || !st_list.ok()) {
+    array_open_error(open_array, shared_mode);
+    return (!st_schema.ok()) ? st_schema : st_list;
+  }
   *array_schema = open_array->array_schema();
 
   // Get fragment metadata only in read mode
   if (type == QueryType::READ)
     RETURN_NOT_OK_ELSE(
-        open_array_load_fragment_metadata(open_array, fragment_metadata),
-        array_open_error(open_array));
+        open_array_load_fragment_metadata(
+            open_array, fragment_uris, subarray, fragment_metadata),
+        array_open_error(open_array, shared_mode));
 
   // Unlock the array mutex
-  open_array->mtx_unlock();
+  if (shared_mode)
+    open_array->mtx_unlock_shared();
+  else
+    open_array->mtx_unlock();
+
+  return Status::Ok();
+}
+
+Status StorageManager::array_preload(
+    const URI& array_uri,
+    const void* subarray,
+    const char** attributes,
+    unsigned attribute_num) {
+  // Open the array here, so that errors such as a non-existent array are
+  // reported to the caller synchronously. The array remains open (and,
+  // hence, the schema and fragment metadata below valid) until the
+  // background task closes it.
+  std::vector<FragmentMetadata*> fragment_metadata;
+  auto array_schema = (const ArraySchema*)nullptr;
+  RETURN_NOT_OK(array_open(
+      array_uri, QueryType::READ, &array_schema, &fragment_metadata));
+
+  // Copy the inputs, as the caller's pointers need not outlive this call.
+  // An empty subarray copy denotes the entire domain and an empty
+  // attribute list denotes all the attributes.
+  std::vector<uint8_t> subarray_copy;
+  if (subarray != nullptr) {
+    auto sub = (const uint8_t*)subarray;
+    subarray_copy.assign(sub, sub + 2 * array_schema->coords_size());
+  }
+  std::vector<std::string> attribute_names;
+  for (unsigned i = 0; i < attribute_num; ++i)
+    attribute_names.emplace_back(attributes[i]);
+
+  // Prune the preload tasks that have already completed, so that the
+  // task list does not grow without bound on long-lived contexts
+  std::lock_guard<std::mutex> lock(preload_tasks_mtx_);
+  for (auto it = preload_tasks_.begin(); it != preload_tasks_.end();) {
+    if (it->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+      it = preload_tasks_.erase(it);
+    else
+      ++it;
+  }
+
+  // Fetch the overlapping tiles on the I/O thread pool. Preloading is
+  // best-effort, so failures of the task are only logged.
+  auto uri = array_uri;
+  preload_tasks_.push_back(io_thread_pool_->enqueue([this,
+                                                     uri,
+                                                     array_schema,
+                                                     fragment_metadata,
+                                                     subarray_copy,
+                                                     attribute_names]() {
+    Query query;
+    Status st =
+        query_init(&query, array_schema, fragment_metadata, QueryType::READ);
+    if (st.ok())
+      st = query.set_subarray(
+          subarray_copy.empty() ? nullptr : &subarray_copy[0]);
+    if (st.ok()) {
+      std::vector<const char*> attr_ptrs;
+      for (const auto& attr : attribute_names)
+        attr_ptrs.push_back(attr.c_str());
+      st = query.preload(
+          attr_ptrs.empty() ? nullptr : &attr_ptrs[0],
+          (unsigned)attr_ptrs.size());
+    }
+    if (!st.ok())
+      LOG_STATUS(st);
+    RETURN_NOT_OK(array_close(uri));
+    return st;
+  }));
 
   return Status::Ok();
 }
 
-Status StorageManager::array_open_error(OpenArray* open_array) {
-  open_array->mtx_unlock();
+Status StorageManager::array_open_error(
+    OpenArray* open_array, bool shared_mode) {
+  if (shared_mode)
+    open_array->mtx_unlock_shared();
+  else
+    open_array->mtx_unlock();
   return array_close(open_array->array_uri());
 }
 
+void StorageManager::array_schemas_evict(const URI& uri) const {
+  auto prefix = uri.to_string();
+  std::lock_guard<std::mutex> lock(array_schemas_mtx_);
+  for (auto it = array_schemas_.begin(); it != array_schemas_.end();) {
+    const auto& key = it->first;
+    bool match = key.compare(0, prefix.size(), prefix) == 0 &&
+                 (key.size() == prefix.size() || key[prefix.size()] == '/');
+    if (match) {
+      delete it->second;
+      it = array_schemas_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void StorageManager::async_process_query(Query* query) {
   // For easy reference
   Status st = query->async_process();
@@ -1296,64 +2611,341 @@ void StorageManager::async_process_query(Query* query) {
     LOG_STATUS(st);
 }
 
-void StorageManager::async_process_queries(int i) {
+void StorageManager::async_process_queries() {
   while (!async_done_) {
-    std::unique_lock<std::mutex> lock(async_mtx_[i]);
-    async_cv_[i].wait(
-        lock, [this, i] { return !async_queue_[i].empty() || async_done_; });
+    std::unique_lock<std::mutex> lock(async_mtx_);
+    async_cv_.wait(
+        lock, [this] { return !async_queue_.empty() || async_done_; });
     if (async_done_)
       break;
-    auto query = async_queue_[i].front();
-    async_queue_[i].pop();
+    auto query = async_queue_.top().query_;
+    async_queue_.pop();
     lock.unlock();
     async_process_query(query);
   }
 }
 
-void StorageManager::async_start(StorageManager* storage_manager, int i) {
-  storage_manager->async_process_queries(i);
+void StorageManager::async_start(StorageManager* storage_manager) {
+  storage_manager->async_process_queries();
+}
+
+void StorageManager::consolidation_scheduler_start(
+    StorageManager* storage_manager) {
+#ifdef __linux__
+  // Run the scheduler (and thus the consolidations it triggers) at idle
+  // scheduling priority, so that it never competes with foreground
+  // queries for CPU
+  struct sched_param sched;
+  std::memset(&sched, 0, sizeof(sched));
+  pthread_setschedparam(pthread_self(), SCHED_IDLE, &sched);
+#endif
+
+  storage_manager->consolidation_scheduler_process();
+}
+
+void StorageManager::consolidation_scheduler_stop() {
+  if (consolidation_scheduler_thread_ == nullptr)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(consolidation_scheduler_mtx_);
+    consolidation_scheduler_done_ = true;
+  }
+  consolidation_scheduler_cv_.notify_all();
+  consolidation_scheduler_thread_->join();
+}
+
+void StorageManager::consolidation_scheduler_process() {
+  Config::SMParams sm_params = config_.sm_params();
+  auto interval =
+      std::chrono::milliseconds(sm_params.consolidation_scheduler_interval_ms_);
+  auto threshold = sm_params.consolidation_scheduler_frag_threshold_;
+
+  std::unique_lock<std::mutex> lock(consolidation_scheduler_mtx_);
+  while (!consolidation_scheduler_done_) {
+    consolidation_scheduler_cv_.wait_for(lock, interval);
+    if (consolidation_scheduler_done_)
+      break;
+    lock.unlock();
+
+    // Snapshot the URIs of the currently open arrays
+    std::vector<std::string> array_uris;
+    for (auto* shard : open_array_shards_) {
+      std::lock_guard<std::mutex> shard_lock(shard->mtx_);
+      for (const auto& open_array : shard->open_arrays_)
+        array_uris.push_back(open_array.first);
+    }
+
+    // Consolidate the arrays whose fragment count crossed the
+    // threshold. Failures are logged and do not stop the scheduler.
+    for (const auto& array_uri : array_uris) {
+      std::vector<URI> fragment_uris;
+      auto st = get_fragment_uris(URI(array_uri), &fragment_uris);
+      if (st.ok() && fragment_uris.size() >= threshold)
+        st = array_consolidate(array_uri.c_str());
+      if (!st.ok())
+        LOG_STATUS(st);
+    }
+
+    lock.lock();
+  }
 }
 
 void StorageManager::async_stop() {
   // Check if async was never started
-  if (async_thread_[0] == nullptr)
+  if (async_threads_.empty())
     return;
 
-  async_done_ = true;
-  async_cv_[0].notify_one();
-  async_cv_[1].notify_one();
-  async_thread_[0]->join();
-  async_thread_[1]->join();
+  {
+    std::lock_guard<std::mutex> lock(async_mtx_);
+    async_done_ = true;
+  }
+  async_cv_.notify_all();
+  for (auto& thread : async_threads_)
+    thread->join();
 }
 
-Status StorageManager::get_fragment_uris(
-    const URI& array_uri, std::vector<URI>* fragment_uris) const {
-  // Get all uris in the array directory
-  std::vector<URI> uris;
-  RETURN_NOT_OK(vfs_->ls(array_uri.join_path(""), &uris));
+FragmentMetadata* StorageManager::fragment_metadata_add(
+    FragmentMetadata* metadata) {
+  std::lock_guard<std::mutex> lock(fragment_metadata_mtx_);
+  auto key = metadata->fragment_uri().to_string();
+  auto it = fragment_metadata_.find(key);
+  if (it != fragment_metadata_.end()) {
+    // Another thread registered this fragment first - keep its copy
+    if (it->second != metadata)
+      delete metadata;
+    return it->second;
+  }
+  fragment_metadata_[key] = metadata;
+  return metadata;
+}
 
-  // Get only the fragment uris
-  bool exists;
-  for (auto& uri : uris) {
-    if (utils::starts_with(uri.last_path_part(), "."))
-      continue;
+FragmentMetadata* StorageManager::fragment_metadata_get(
+    const URI& fragment_uri) {
+  std::lock_guard<std::mutex> lock(fragment_metadata_mtx_);
+  auto it = fragment_metadata_.find(fragment_uri.to_string());
+  if (it == fragment_metadata_.end())
+    return nullptr;
+
+  return it->second;
+}
+
+void StorageManager::fragment_summary_add(
+    const URI& fragment_uri, const FragmentSummary& summary) {
+  std::lock_guard<std::mutex> lock(fragment_summaries_mtx_);
+  fragment_summaries_[fragment_uri.to_string()] = summary;
+}
+
+bool StorageManager::fragment_summary_get(
+    const URI& fragment_uri, FragmentSummary* summary) {
+  std::lock_guard<std::mutex> lock(fragment_summaries_mtx_);
+  auto it = fragment_summaries_.find(fragment_uri.to_string());
+  if (it == fragment_summaries_.end())
+    return false;
+
+  *summary = it->second;
+  return true;
+}
+
+bool StorageManager::fragment_known(const URI& fragment_uri) {
+  std::lock_guard<std::mutex> lock(known_fragments_mtx_);
+  return known_fragments_.find(fragment_uri.to_string()) !=
+         known_fragments_.end();
+}
+
+void StorageManager::fragment_known_add(const URI& fragment_uri) {
+  std::lock_guard<std::mutex> lock(known_fragments_mtx_);
+  known_fragments_.insert(fragment_uri.to_string());
+}
+
+StorageManager::FragmentSummary StorageManager::fragment_summary_from_metadata(
+    const ArraySchema* array_schema, FragmentMetadata* metadata) const {
+  FragmentSummary summary;
+  summary.dense_ = metadata->dense();
+  summary.timestamp_ = fragment_timestamp(metadata->fragment_uri());
+
+  // A dense fragment materializes all the cells in its expanded domain,
+  // whereas a sparse fragment contributes cells only in its non-empty
+  // domain
+  auto domain =
+      metadata->dense() ? metadata->domain() : metadata->non_empty_domain();
+  if (domain != nullptr) {
+    auto domain_size = 2 * array_schema->coords_size();
+    auto domain_bytes = (const uint8_t*)domain;
+    summary.domain_.assign(domain_bytes, domain_bytes + domain_size);
+  }
+
+  return summary;
+}
+
+Status StorageManager::load_fragment_summary(
+    const URI& fragment_uri, FragmentSummary* summary, bool* found) {
+  *found = false;
+
+  // Check if a summary file exists
+  URI summary_uri =
+      fragment_uri.join_path(std::string(constants::fragment_summary_filename));
+  bool is_file;
+  RETURN_NOT_OK(vfs_->is_file(summary_uri, &is_file));
+  if (!is_file)
+    return Status::Ok();
+
+  // Read the summary file
+  uint64_t size;
+  RETURN_NOT_OK(vfs_->file_size(summary_uri, &size));
+  Buffer buff;
+  RETURN_NOT_OK(buff.realloc(size));
+  RETURN_NOT_OK(vfs_->read(summary_uri, 0, buff.data(), size));
+
+  // Parse, treating malformed content as a missing summary
+  ConstBuffer cbuff(buff.data(), size);
+  uint32_t version = 0;
+  char dense;
+  uint64_t domain_size;
+  bool ok = cbuff.read(&version, sizeof(uint32_t)).ok() && version == 1;
+  ok = ok && cbuff.read(&dense, sizeof(char)).ok();
+  ok = ok && cbuff.read(&summary->timestamp_, sizeof(uint64_t)).ok();
+  ok = ok && cbuff.read(&domain_size, sizeof(uint64_t)).ok() &&
+       domain_size <= size;
+  if (ok) {
+    summary->dense_ = (dense == 1);
+    summary->domain_.resize(domain_size);
+    ok = domain_size == 0 ||
+         cbuff.read(&summary->domain_[0], domain_size).ok();
+  }
+
+  *found = ok;
+  return Status::Ok();
+}
 
-    RETURN_NOT_OK(is_fragment(uri, &exists))
-    if (exists)
-      fragment_uris->push_back(uri);
+Status StorageManager::store_fragment_summary(FragmentMetadata* metadata) {
+  auto summary =
+      fragment_summary_from_metadata(metadata->array_schema(), metadata);
+
+  // Serialize the summary
+  Buffer buff;
+  uint32_t version = 1;
+  char dense = summary.dense_ ? 1 : 0;
+  uint64_t domain_size = summary.domain_.size();
+  RETURN_NOT_OK(buff.write(&version, sizeof(uint32_t)));
+  RETURN_NOT_OK(buff.write(&dense, sizeof(char)));
+  RETURN_NOT_OK(buff.write(&summary.timestamp_, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff.write(&domain_size, sizeof(uint64_t)));
+  if (domain_size != 0)
+    RETURN_NOT_OK(buff.write(&summary.domain_[0], domain_size));
+
+  // Write to file
+  URI summary_uri = metadata->fragment_uri().join_path(
+      std::string(constants::fragment_summary_filename));
+  RETURN_NOT_OK(vfs_->write(summary_uri, buff.data(), buff.size()));
+  return vfs_->close_file(summary_uri);
+}
+
+bool StorageManager::summary_overlaps(
+    const ArraySchema* array_schema,
+    const FragmentSummary& summary,
+    const void* subarray) const {
+  // A summary without a recorded domain cannot prune the fragment
+  if (summary.domain_.size() != 2 * array_schema->coords_size())
+    return true;
+
+  auto dim_num = array_schema->dim_num();
+  auto domain = &summary.domain_[0];
+  switch (array_schema->coords_type()) {
+    case Datatype::INT32:
+      return utils::overlap(
+          (const int*)domain, (const int*)subarray, dim_num);
+    case Datatype::INT64:
+      return utils::overlap(
+          (const int64_t*)domain, (const int64_t*)subarray, dim_num);
+    case Datatype::FLOAT32:
+      return utils::overlap(
+          (const float*)domain, (const float*)subarray, dim_num);
+    case Datatype::FLOAT64:
+      return utils::overlap(
+          (const double*)domain, (const double*)subarray, dim_num);
+    case Datatype::INT8:
+      return utils::overlap(
+          (const int8_t*)domain, (const int8_t*)subarray, dim_num);
+    case Datatype::UINT8:
+      return utils::overlap(
+          (const uint8_t*)domain, (const uint8_t*)subarray, dim_num);
+    case Datatype::INT16:
+      return utils::overlap(
+          (const int16_t*)domain, (const int16_t*)subarray, dim_num);
+    case Datatype::UINT16:
+      return utils::overlap(
+          (const uint16_t*)domain, (const uint16_t*)subarray, dim_num);
+    case Datatype::UINT32:
+      return utils::overlap(
+          (const unsigned*)domain, (const unsigned*)subarray, dim_num);
+    case Datatype::UINT64:
+      return utils::overlap(
+          (const uint64_t*)domain, (const uint64_t*)subarray, dim_num);
+    default:
+      return true;
   }
+}
+
+Status StorageManager::get_fragment_uris(
+    const URI& array_uri, std::vector<URI>* fragment_uris) {
+  // Stream the directory listing, checking each URI on the I/O thread
+  // pool as it arrives, so that the per-fragment existence checks
+  // overlap the (possibly paginated) listing. URIs that have already
+  // passed the check in this process skip it - fragments are immutable,
+  // so on a reopen only the newly arrived fragments pay the check.
+  std::mutex mtx;
+  std::vector<std::pair<uint64_t, URI>> frags;
+  std::vector<std::future<Status>> tasks;
+  uint64_t pos = 0;
+  auto st = vfs_->ls(array_uri.join_path(""), [&](const std::string& path) {
+    URI uri(path);
+    if (utils::starts_with(uri.last_path_part(), "."))
+      return Status::Ok();
+    auto p = pos++;
+    if (fragment_known(uri)) {
+      std::lock_guard<std::mutex> lock(mtx);
+      frags.emplace_back(p, uri);
+      return Status::Ok();
+    }
+    tasks.push_back(io_thread_pool_->enqueue([this, uri, p, &frags, &mtx]() {
+      bool exists;
+      RETURN_NOT_OK(is_fragment(uri, &exists));
+      if (exists) {
+        fragment_known_add(uri);
+        std::lock_guard<std::mutex> lock(mtx);
+        frags.emplace_back(p, uri);
+      }
+      return Status::Ok();
+    }));
+    return Status::Ok();
+  });
+  bool all_ok = io_thread_pool_->wait_all(tasks);
+  RETURN_NOT_OK(st);
+  if (!all_ok)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot get fragment URIs; fragment checks failed"));
+
+  // Report the fragments in listing order
+  std::sort(
+      frags.begin(),
+      frags.end(),
+      [](const std::pair<uint64_t, URI>& a,
+         const std::pair<uint64_t, URI>& b) { return a.first < b.first; });
+  for (auto& f : frags)
+    fragment_uris->push_back(f.second);
 
   return Status::Ok();
 }
 
 Status StorageManager::open_array_get_entry(
-    const URI& array_uri, OpenArray** open_array) {
+    OpenArrayShard* shard, const URI& array_uri, OpenArray** open_array) {
   // Find the open array entry
-  auto it = open_arrays_.find(array_uri.to_string());
+  auto it = shard->open_arrays_.find(array_uri.to_string());
   // Create and init entry if it does not exist
-  if (it == open_arrays_.end()) {
+  if (it == shard->open_arrays_.end()) {
     *open_array = new OpenArray();
-    open_arrays_[array_uri.to_string()] = *open_array;
+    shard->open_arrays_[array_uri.to_string()] = *open_array;
   } else {
     *open_array = it->second;
   }
@@ -1375,38 +2967,175 @@ Status StorageManager::open_array_load_array_schema(
 }
 
 Status StorageManager::open_array_load_fragment_metadata(
-    OpenArray* open_array, std::vector<FragmentMetadata*>* fragment_metadata) {
-  // Get all the fragment uris, sorted by timestamp
-  std::vector<URI> fragment_uris;
-  const URI& array_uri = open_array->array_uri();
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
-  sort_fragment_uris(&fragment_uris);
-
+    OpenArray* open_array,
+    const std::vector<URI>& fragment_uris,
+    const void* subarray,
+    std::vector<FragmentMetadata*>* fragment_metadata) {
   if (fragment_uris.empty())
     return Status::Ok();
 
-  // Load the metadata for each fragment
-  for (auto& uri : fragment_uris) {
-    // Find metadata entry in open array
-    auto metadata = open_array->fragment_metadata_get(uri);
-    // If not found, load metadata and store in open array
-    if (metadata == nullptr) {
-      URI coords_uri = uri.join_path(
-          std::string("/") + constants::coords + constants::file_suffix);
-      bool sparse;
-      RETURN_NOT_OK(vfs_->is_file(coords_uri, &sparse));
-      metadata = new FragmentMetadata(open_array->array_schema(), !sparse, uri);
-      RETURN_NOT_OK_ELSE(load_fragment_metadata(metadata), delete metadata);
-      open_array->fragment_metadata_add(metadata);
+  auto array_schema = open_array->array_schema();
+  auto fragment_num = fragment_uris.size();
+  std::vector<FragmentMetadata*> metadata(fragment_num, nullptr);
+
+  // Prune the fragments that do not overlap the subarray via their
+  // summaries, so that their full metadata is never loaded. Summaries
+  // not yet cached are fetched in parallel on the I/O thread pool; a
+  // fragment without a summary file (e.g., written by an older version)
+  // falls through to the full metadata load below.
+  std::vector<uint8_t> pruned(fragment_num, 0);
+  if (subarray != nullptr) {
+    std::vector<size_t> to_fetch;
+    for (size_t i = 0; i < fragment_num; ++i) {
+      FragmentSummary summary;
+      bool have = fragment_summary_get(fragment_uris[i], &summary);
+      if (!have) {
+        // Derive the summary in memory if the metadata is already cached
+        auto meta = open_array->fragment_metadata_get(fragment_uris[i]);
+        if (meta == nullptr)
+          meta = fragment_metadata_get(fragment_uris[i]);
+        if (meta != nullptr) {
+          summary = fragment_summary_from_metadata(array_schema, meta);
+          fragment_summary_add(fragment_uris[i], summary);
+          have = true;
+        }
+      }
+      if (have) {
+        if (!summary_overlaps(array_schema, summary, subarray))
+          pruned[i] = 1;
+      } else {
+        to_fetch.push_back(i);
+      }
+    }
+    std::vector<std::future<Status>> fetch_tasks;
+    for (auto i : to_fetch) {
+      fetch_tasks.push_back(io_thread_pool_->enqueue(
+          [this, array_schema, subarray, &fragment_uris, &pruned, i]() {
+            FragmentSummary summary;
+            bool found;
+            RETURN_NOT_OK(
+                load_fragment_summary(fragment_uris[i], &summary, &found));
+            if (found) {
+              if (!summary_overlaps(array_schema, summary, subarray))
+                pruned[i] = 1;
+              fragment_summary_add(fragment_uris[i], summary);
+            }
+            return Status::Ok();
+          }));
+    }
+    if (!io_thread_pool_->wait_all(fetch_tasks))
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot open array; fragment summary loading failed"));
+  }
+
+  // Reuse any metadata already present in the open array or the
+  // process-wide map, and record which fragments must be loaded
+  std::vector<size_t> to_load;
+  for (size_t i = 0; i < fragment_num; ++i) {
+    if (pruned[i])
+      continue;
+    metadata[i] = open_array->fragment_metadata_get(fragment_uris[i]);
+    if (metadata[i] == nullptr) {
+      metadata[i] = fragment_metadata_get(fragment_uris[i]);
+      if (metadata[i] == nullptr) {
+        to_load.push_back(i);
+      } else {
+        // The metadata may point to the schema of a previously closed
+        // open array - refresh it
+        metadata[i]->set_array_schema(open_array->array_schema());
+        open_array->fragment_metadata_add(metadata[i]);
+      }
+    }
+  }
+
+  // Load the missing metadata in parallel on the I/O thread pool
+  std::vector<std::future<Status>> tasks;
+  for (auto i : to_load) {
+    tasks.push_back(io_thread_pool_->enqueue(
+        [this, open_array, &fragment_uris, &metadata, i]() {
+          const auto& uri = fragment_uris[i];
+          URI coords_uri = uri.join_path(
+              std::string("/") + constants::coords + constants::file_suffix);
+          bool sparse;
+          RETURN_NOT_OK(vfs_->is_file(coords_uri, &sparse));
+          auto meta =
+              new FragmentMetadata(
+                  this, open_array->array_schema(), !sparse, uri);
+          RETURN_NOT_OK_ELSE(load_fragment_metadata(meta), delete meta);
+          metadata[i] = meta;
+          return Status::Ok();
+        }));
+  }
+  if (!io_thread_pool_->wait_all(tasks)) {
+    for (auto i : to_load)
+      delete metadata[i];
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot open array; fragment metadata loading failed"));
+  }
+
+  // Register the newly loaded metadata. If a concurrent open registered
+  // the same fragment first, its copy is kept and used instead. Cache
+  // the summary of any fragment that lacked a summary file, so that
+  // subsequent opens prune it in memory.
+  for (auto i : to_load) {
+    metadata[i] = fragment_metadata_add(metadata[i]);
+    open_array->fragment_metadata_add(metadata[i]);
+    FragmentSummary summary;
+    if (!fragment_summary_get(fragment_uris[i], &summary)) {
+      summary = fragment_summary_from_metadata(array_schema, metadata[i]);
+      fragment_summary_add(fragment_uris[i], summary);
+      // The fragment may turn out not to overlap the subarray after all
+      if (subarray != nullptr &&
+          !summary_overlaps(array_schema, summary, subarray))
+        metadata[i] = nullptr;
     }
+  }
 
-    // Add to list
-    fragment_metadata->push_back(metadata);
+  // Report the metadata in sorted fragment order, skipping the pruned
+  // fragments
+  for (auto meta : metadata) {
+    if (meta != nullptr)
+      fragment_metadata->push_back(meta);
   }
 
   return Status::Ok();
 }
 
+StorageManager::OpenArrayShard* StorageManager::open_array_shard(
+    const URI& array_uri) const {
+  return open_array_shards_
+      [std::hash<std::string>()(array_uri.to_string()) %
+       open_array_shards_.size()];
+}
+
+void StorageManager::filter_fragment_uris(
+    std::vector<URI>* fragment_uris) const {
+  if (array_open_timestamp_ == 0 || fragment_uris->empty())
+    return;
+
+  // The URIs are sorted by timestamp, so the fragments to skip form a
+  // suffix of the list
+  while (!fragment_uris->empty() &&
+         fragment_timestamp(fragment_uris->back()) > array_open_timestamp_)
+    fragment_uris->pop_back();
+}
+
+uint64_t StorageManager::fragment_timestamp(const URI& fragment_uri) {
+  // Get fragment name
+  std::string uri_str = fragment_uri.c_str();
+  if (uri_str.back() == '/')
+    uri_str.pop_back();
+  std::string fragment_name = URI(uri_str).last_path_part();
+  assert(utils::starts_with(fragment_name, "__"));
+
+  // Get timestamp in the end of the name after '_'
+  assert(fragment_name.find_last_of("_") != std::string::npos);
+  std::string t_str = fragment_name.substr(fragment_name.find_last_of('_') + 1);
+  uint64_t t = 0;
+  sscanf(t_str.c_str(), "%lld", (long long int*)&t);
+  return t;
+}
+
 void StorageManager::sort_fragment_uris(std::vector<URI>* fragment_uris) const {
   // Do nothing if there are not enough fragments
   uint64_t fragment_num = fragment_uris->size();
@@ -1414,25 +3143,13 @@ void StorageManager::sort_fragment_uris(std::vector<URI>* fragment_uris) const {
     return;
 
   // Initializations
-  std::string t_str;
-  uint64_t t, pos = 0;
+  uint64_t pos = 0;
   std::vector<std::pair<uint64_t, uint64_t>> t_pos_vec;
 
   // Get the timestamp for each fragment
-  for (auto& uri : *fragment_uris) {
-    // Get fragment name
-    std::string uri_str = uri.c_str();
-    if (uri_str.back() == '/')
-      uri_str.pop_back();
-    std::string fragment_name = URI(uri_str).last_path_part();
-    assert(utils::starts_with(fragment_name, "__"));
-
-    // Get timestamp in the end of the name after '_'
-    assert(fragment_name.find_last_of("_") != std::string::npos);
-    t_str = fragment_name.substr(fragment_name.find_last_of('_') + 1);
-    sscanf(t_str.c_str(), "%lld", (long long int*)&t);
-    t_pos_vec.emplace_back(std::pair<uint64_t, uint64_t>(t, pos++));
-  }
+  for (auto& uri : *fragment_uris)
+    t_pos_vec.emplace_back(
+        std::pair<uint64_t, uint64_t>(fragment_timestamp(uri), pos++));
 
   // Sort the names based on the timestamps
   std::sort(t_pos_vec.begin(), t_pos_vec.end());
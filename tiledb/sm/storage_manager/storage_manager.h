@@ -38,23 +38,31 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
 
 #include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer_pool.h"
+#include "tiledb/sm/cache/disk_cache.h"
 #include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/cache/sharded_lru_cache.h"
+#include "tiledb/sm/enums/cache_hint.h"
 #include "tiledb/sm/enums/object_type.h"
 #include "tiledb/sm/enums/walk_order.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/uri.h"
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/storage_manager/config.h"
 #include "tiledb/sm/storage_manager/consolidator.h"
 #include "tiledb/sm/storage_manager/locked_object.h"
+#include "tiledb/sm/storage_manager/memory_budget.h"
 #include "tiledb/sm/storage_manager/open_array.h"
+#include "tiledb/sm/storage_manager/write_combiner.h"
 
 namespace tiledb {
 namespace sm {
@@ -80,6 +88,14 @@ class StorageManager {
     std::string next_;
     /** The next objects to be visited. */
     std::list<URI> objs_;
+    /**
+     * Caches the TileDB objects contained in discovered but not yet
+     * visited directories, keyed on the directory URI in string format.
+     * The cache is filled by listing a whole frontier of directories
+     * concurrently and an entry is dropped once its directory is
+     * visited.
+     */
+    std::map<std::string, std::vector<URI>> children_;
     /** The traversal order of the iterator. */
     WalkOrder order_;
     /** `True` if the iterator will recursively visit the directory tree. */
@@ -103,6 +119,12 @@ class StorageManager {
   /*                API                */
   /* ********************************* */
 
+  /**
+   * Closes an array, decrementing the reference count of the corresponding
+   * open array entry. The entry is removed when the count drops to zero.
+   */
+  Status array_close(URI array);
+
   /**
    * Computes an upper bound on the buffer sizes required for a read
    * query, for a given subarray and set of attributes.
@@ -126,9 +148,44 @@ class StorageManager {
       unsigned attribute_num,
       uint64_t* buffer_sizes);
 
+  /**
+   * Partitions a subarray into a list of sub-partitions, such that the
+   * results of a read query on each sub-partition are estimated to fit
+   * in the input memory budget. The estimates are upper bounds computed
+   * from the fragment metadata, hence a read on a produced partition is
+   * guaranteed not to overflow buffers totaling the budget. A partition
+   * that exceeds the budget but cannot be split any further (i.e., it
+   * covers a single cell) is emitted as is.
+   *
+   * @param array_uri The array URI.
+   * @param subarray The subarray to partition. Use `nullptr` for the
+   *     entire domain.
+   * @param layout The layout in which the partitions will be read. The
+   *     partitions are also emitted in this order.
+   * @param attributes The attributes the reads will focus on. Use
+   *     `nullptr` to indicate **all** attributes (and the coordinates,
+   *     if the array is sparse).
+   * @param attribute_num The number of attributes.
+   * @param budget The memory budget (in bytes).
+   * @param partitions The serialized sub-partitions, each of size
+   *     `2 * coords_size`. Sub-partitions with no results are omitted.
+   * @return Status
+   */
+  Status array_partition_subarray(
+      const char* array_uri,
+      const void* subarray,
+      Layout layout,
+      const char** attributes,
+      unsigned attribute_num,
+      uint64_t budget,
+      std::vector<std::vector<uint8_t>>* partitions);
+
   /**
    * Computes an upper bound on the buffer sizes required for a read
-   * query, for a given subarray and set of attributes.
+   * query, for a given subarray and set of attributes. The per-fragment
+   * bounds are computed concurrently on the compute thread pool, and
+   * the result is memoized, as clients commonly size their buffers with
+   * the same subarray before every read.
    *
    * @param array_schema The array schema
    * @param fragment_metadata The fragment metadata of the array.
@@ -178,6 +235,90 @@ class StorageManager {
       uint64_t* buffer_sizes,
       unsigned buffer_num);
 
+  /**
+   * Computes an estimate of the buffer sizes required for a read query,
+   * for a given subarray and set of attributes. Unlike
+   * `array_compute_max_read_buffer_sizes`, which for sparse arrays counts
+   * every cell of every tile overlapping the subarray, this function scales
+   * each tile's contribution by the fraction of its MBR the subarray
+   * covers, yielding the expected result size under the assumption that
+   * the cells are uniformly distributed within each tile MBR.
+   *
+   * @param array_uri The array URI.
+   * @param subarray The subarray to focus on. Note that it must have the same
+   *     underlying type as the array domain.
+   * @param attributes The attributes to focus on.
+   * @param attribute_num The number of attributes.
+   * @param confidence A factor (>= 1.0) the expected sizes are multiplied
+   *     with, adding headroom that reduces the chance of a retry upon
+   *     buffer overflow. `1.0` returns the raw expectation.
+   * @param buffer_sizes The buffer sizes to be retrieved. Note that one
+   *     buffer size corresponds to a fixed-sized attributes, and two
+   *     buffer sizes for a variable-sized attribute (the first is the
+   *     size of the offsets, whereas the second is the size of the
+   *     actual variable-sized cell values.
+   * @return Status
+   */
+  Status array_compute_est_read_buffer_sizes(
+      const char* array_uri,
+      const void* subarray,
+      const char** attributes,
+      unsigned attribute_num,
+      double confidence,
+      uint64_t* buffer_sizes);
+
+  /**
+   * Computes an estimate of the buffer sizes required for a read query,
+   * for a given subarray and set of attributes.
+   *
+   * @param array_schema The array schema
+   * @param fragment_metadata The fragment metadata of the array.
+   * @param subarray The subarray to focus on. Note that it must have the same
+   *     underlying type as the array domain.
+   * @param attribute_ids The attribute ids to focus on.
+   * @param buffer_sizes The buffer sizes to be retrieved. Note that one
+   *     buffer size corresponds to a fixed-sized attributes, and two
+   *     buffer sizes for a variable-sized attribute (the first is the
+   *     size of the offsets, whereas the second is the size of the
+   *     actual variable-sized cell values.
+   * @param buffer_num The number of buffers.
+   * @return Status
+   */
+  Status array_compute_est_read_buffer_sizes(
+      const ArraySchema* array_schema,
+      const std::vector<FragmentMetadata*>& fragment_metadata,
+      const void* subarray,
+      const std::vector<unsigned>& attribute_ids,
+      uint64_t* buffer_sizes,
+      unsigned buffer_num);
+
+  /**
+   * Computes an estimate of the buffer sizes required for a read query,
+   * for a given subarray and set of attributes.
+   *
+   * @tparam T The domain type.
+   * @param array_schema The array schema
+   * @param fragment_metadata The fragment metadata of the array.
+   * @param subarray The subarray to focus on. Note that it must have the same
+   *     underlying type as the array domain.
+   * @param attribute_ids The attribute ids to focus on.
+   * @param buffer_sizes The buffer sizes to be retrieved. Note that one
+   *     buffer size corresponds to a fixed-sized attributes, and two
+   *     buffer sizes for a variable-sized attribute (the first is the
+   *     size of the offsets, whereas the second is the size of the
+   *     actual variable-sized cell values.
+   * @param buffer_num The number of buffers.
+   * @return Status
+   */
+  template <class T>
+  Status array_compute_est_read_buffer_sizes(
+      const ArraySchema* array_schema,
+      const std::vector<FragmentMetadata*>& fragment_metadata,
+      const T* subarray,
+      const std::vector<unsigned>& attribute_ids,
+      uint64_t* buffer_sizes,
+      unsigned buffer_num);
+
   /**
    * Consolidates the fragments of an array into a single one.
    *
@@ -208,6 +349,53 @@ class StorageManager {
   Status array_get_non_empty_domain(
       const char* array_uri, void* domain, bool* is_empty);
 
+  /**
+   * Opens an array, retrieving its schema and fragment metadata. The array
+   * remains open (and its schema and fragment metadata valid) until a
+   * matching `array_close` call; concurrent opens of the same array share
+   * a single reference-counted entry.
+   *
+   * @param array_uri The array URI.
+   * @param query_type The query type.
+   * @param array_schema The array schema to be retrieved.
+   * @param fragment_metadata The fragment metadat to be retrieved.
+   * @param subarray If not `nullptr`, only the metadata of the fragments
+   *     whose domain overlaps the subarray are retrieved. Non-overlapping
+   *     fragments contribute no cells to the subarray, and their (compact)
+   *     summaries allow skipping their full metadata load altogether.
+   * @return
+   */
+  Status array_open(
+      const URI& array_uri,
+      QueryType query_type,
+      const ArraySchema** array_schema,
+      std::vector<FragmentMetadata*>* fragment_metadata,
+      const void* subarray = nullptr);
+
+  /**
+   * Preloads into the tile cache, on the I/O thread pool, all the tiles
+   * of the input attributes that overlap the input subarray, so that
+   * subsequent read queries on the subarray are served from the cache.
+   * The array is opened here (hence errors such as a non-existent array
+   * are reported synchronously) and remains open until the background
+   * task completes; I/O errors of the task itself are only logged, as
+   * preloading is best-effort.
+   *
+   * @param array_uri The array URI.
+   * @param subarray The subarray whose tiles to preload. If `nullptr`,
+   *     the tiles of the entire domain are preloaded.
+   * @param attributes The attributes whose tiles to preload. If
+   *     `nullptr`, all the array attributes (and, for sparse arrays, the
+   *     coordinates) are preloaded.
+   * @param attribute_num The number of attributes.
+   * @return Status
+   */
+  Status array_preload(
+      const URI& array_uri,
+      const void* subarray,
+      const char** attributes,
+      unsigned attribute_num);
+
   /**
    * Locks a TileDB object (array or group).
    *
@@ -227,19 +415,30 @@ class StorageManager {
   Status object_unlock(const URI& uri, LockType lock_type);
 
   /**
-   * Pushes an async query to the queue.
+   * Pushes an async query to the queue, to be picked up by one of the
+   * async worker threads. Cheaper queries (e.g. small point reads) are
+   * processed ahead of more expensive ones (e.g. bulk scans).
    *
    * @param query The async query.
-   * @param i The index of the thread that executes the function. If it is
-   *    equal to 0, it means a user query, whereas if it is 1 it means an
-   *    internal query.
    * @return Status
    */
-  Status async_push_query(Query* query, int i);
+  Status async_push_query(Query* query);
+
+  /** Returns the pool of reusable tile-sized buffers. */
+  BufferPool* buffer_pool() const;
+
+  /** Returns the thread pool for compute-bound tasks. */
+  ThreadPool* compute_thread_pool() const;
+
+  /** Returns the thread pool for I/O-bound tasks. */
+  ThreadPool* io_thread_pool() const;
 
   /** Returns the configuration parameters. */
   Config config() const;
 
+  /** Returns the memory budget. */
+  MemoryBudget* memory_budget() const;
+
   /** Creates a directory with the input URI. */
   Status create_dir(const URI& uri);
 
@@ -345,6 +544,19 @@ class StorageManager {
    */
   Status load_fragment_metadata(FragmentMetadata* metadata);
 
+  /**
+   * Reads the serialized fragment metadata at the input URI, either from
+   * the fragment metadata cache or from persistent storage.
+   *
+   * @param fragment_metadata_uri The URI of the serialized metadata.
+   * @param buff Set to a new buffer holding the serialized metadata.
+   *     The caller assumes ownership.
+   * @param in_cache Set to `true` if the metadata was served from the cache.
+   * @return Status
+   */
+  Status read_fragment_metadata(
+      const URI& fragment_metadata_uri, Buffer** buff, bool* in_cache);
+
   /** Removes a TileDB object (group, array, kv). */
   Status object_remove(const char* path) const;
 
@@ -449,6 +661,24 @@ class StorageManager {
    */
   Status query_init(Query* query, const char* array_name, QueryType type);
 
+  /**
+   * Initializes a query against an array that the caller has already
+   * opened with `array_open`. No array opening takes place; the caller
+   * is responsible for keeping the array open (and, hence, the input
+   * schema and fragment metadata valid) for the lifetime of the query.
+   *
+   * @param query The query to initialize.
+   * @param array_schema The schema of the opened array.
+   * @param fragment_metadata The fragment metadata of the opened array.
+   * @param type The query type.
+   * @return Status
+   */
+  Status query_init(
+      Query* query,
+      const ArraySchema* array_schema,
+      const std::vector<FragmentMetadata*>& fragment_metadata,
+      QueryType type);
+
   /**
    * Initializes a query.
    *
@@ -465,6 +695,9 @@ class StorageManager {
    * @param consolidation_fragment_uri This is used only in write queries.
    *     If it is different than empty, then it indicates that the query will
    *     be writing into a consolidation fragment with the input name.
+   * @param fragment_uris If it is not `nullptr`, the query will be
+   *     restricted to the fragments with the input URIs (used in
+   *     incremental consolidation, which reads a subset of fragments).
    * @return Status
    */
   Status query_init(
@@ -477,11 +710,78 @@ class StorageManager {
       unsigned int attribute_num,
       void** buffers,
       uint64_t* buffer_sizes,
-      const URI& consolidation_fragment_uri = URI(""));
+      const URI& consolidation_fragment_uri = URI(""),
+      const std::vector<URI>* fragment_uris = nullptr);
+
+  /**
+   * Initializes a read query from a serialized query plan (see
+   * `query_plan`), constraining it on the plan partition with the input
+   * index. The query is restricted to the fragment snapshot recorded in
+   * the plan, so all the workers executing the partitions of a plan
+   * observe the same data and produce non-overlapping results, without
+   * re-running the overlap discovery of the planner.
+   *
+   * @param query The query to initialize.
+   * @param plan The serialized query plan.
+   * @param plan_size The size (in bytes) of the serialized plan.
+   * @param partition_idx The index of the plan partition to execute.
+   * @return Status
+   */
+  Status query_init_from_plan(
+      Query* query,
+      const void* plan,
+      uint64_t plan_size,
+      uint64_t partition_idx);
+
+  /**
+   * Plans a read query once for execution by multiple workers. The
+   * array is opened a single time, the input subarray is partitioned
+   * with the memory budget (see `array_partition_subarray`) against the
+   * current fragment snapshot, and the array URI, layout, fragment
+   * snapshot and partitions are serialized into a compact plan. Each
+   * worker passes the plan to `query_init_from_plan` with its assigned
+   * partition index and executes the query directly.
+   *
+   * @param array_uri The array URI.
+   * @param subarray The subarray to plan for. Use `nullptr` for the
+   *     entire domain.
+   * @param layout The layout in which the partitions will be read.
+   * @param attributes The attributes the reads will focus on. Use
+   *     `nullptr` to indicate **all** attributes (and the coordinates,
+   *     if the array is sparse).
+   * @param attribute_num The number of attributes.
+   * @param budget The memory budget (in bytes) per partition.
+   * @param plan The buffer the serialized plan is written to.
+   * @param partition_num The number of partitions in the plan.
+   * @return Status
+   */
+  Status query_plan(
+      const char* array_uri,
+      const void* subarray,
+      Layout layout,
+      const char** attributes,
+      unsigned attribute_num,
+      uint64_t budget,
+      Buffer* plan,
+      uint64_t* partition_num);
 
   /** Submits a query for (sync) execution. */
   Status query_submit(Query* query);
 
+  /**
+   * Submits a batch of queries for execution, scheduling them on the async
+   * workers, and blocks until all of them complete. The async queue orders
+   * the queries by estimated cost and tiles fetched by one query are
+   * served to the others from the tile cache, so queries in the batch that
+   * target the same tiles do not duplicate I/O.
+   *
+   * @param queries The queries to submit.
+   * @param query_num The number of queries.
+   * @return Status An error if any query in the batch failed; the status
+   *     of each individual query can be retrieved from the query object.
+   */
+  Status query_submit_batch(Query** queries, uint64_t query_num);
+
   /**
    * Submits a query for async execution.
    *
@@ -493,6 +793,31 @@ class StorageManager {
   Status query_submit_async(
       Query* query, std::function<void(void*)> callback, void* callback_data);
 
+  /**
+   * Submits a query for async execution with incremental result
+   * delivery. In addition to the completion callback, the read path
+   * invokes the progress callback every time a batch of result cells
+   * has been copied into the user buffers (with the user buffer sizes
+   * updated to the copied prefix), so that consumers can process
+   * partial results while the rest of the query is still executing.
+   * The progress callback runs on the thread processing the query.
+   *
+   * @param query The query to submit.
+   * @param callback The function that will be called upon query completion.
+   * @param callback_data The data to be provided to the callback function.
+   * @param progress_callback The function that will be called upon the
+   *     completion of each result batch before the query completes.
+   * @param progress_callback_data The data to be provided to the progress
+   *     callback function.
+   * @return Status
+   */
+  Status query_submit_async(
+      Query* query,
+      std::function<void(void*)> callback,
+      void* callback_data,
+      std::function<void(void*)> progress_callback,
+      void* progress_callback_data);
+
   /**
    * Reads from the cache into the input buffer. `uri` and `offset` collectively
    * form the key of the cached object to be read. Essentially, this is used
@@ -516,6 +841,61 @@ class StorageManager {
       uint64_t nbytes,
       bool* in_cache) const;
 
+  /**
+   * Retrieves shared ownership of a cached object without copying its
+   * contents. `uri` and `offset` collectively form the key of the cached
+   * object, as in `read_from_cache`. The returned object remains valid
+   * even if it gets evicted from the cache, for as long as the caller
+   * holds the returned pointer.
+   *
+   * @param uri The URI of the cached object.
+   * @param offset The offset of the cached object.
+   * @param object The cached object to be retrieved.
+   * @param size The size of the cached object to be retrieved.
+   * @param in_cache This is set to `true` if the object is in the cache,
+   *     and `false` otherwise.
+   * @return Status.
+   */
+  Status read_shared_from_cache(
+      const URI& uri,
+      uint64_t offset,
+      std::shared_ptr<void>* object,
+      uint64_t* size,
+      bool* in_cache) const;
+
+  /**
+   * Returns `true` if the tile cache stores compressed tile bytes
+   * instead of decompressed tiles (see config parameter
+   * `sm.tile_cache_compressed`).
+   */
+  bool tile_cache_compressed() const;
+
+  /**
+   * Begins a single-flight fetch of the tile with the input cache key
+   * (`uri`, `offset`). If no fetch of the same tile is in flight, the
+   * fetch is registered and `true` is returned - the caller becomes the
+   * leader and must call `tile_fetch_end` once it has fetched (and
+   * typically cached) the tile, on failures as well. Otherwise, the
+   * function blocks until the in-flight fetch completes and returns
+   * `false`, upon which the caller should re-check the tile cache. This
+   * collapses concurrent misses on the same hot tile into a single
+   * backend read.
+   *
+   * @param uri The URI of the cached object.
+   * @param offset The offset of the cached object.
+   * @return `true` if the caller is the leader of the fetch.
+   */
+  bool tile_fetch_begin(const URI& uri, uint64_t offset);
+
+  /**
+   * Completes a single-flight tile fetch started with `tile_fetch_begin`,
+   * waking up all the waiting requesters.
+   *
+   * @param uri The URI of the cached object.
+   * @param offset The offset of the cached object.
+   */
+  void tile_fetch_end(const URI& uri, uint64_t offset);
+
   /**
    * Reads from a file into the input buffer.
    *
@@ -529,6 +909,25 @@ class StorageManager {
   Status read(
       const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const;
 
+  /**
+   * Reads up to *nbytes* bytes from a file into the input buffer, without
+   * failing if the file ends before *nbytes* bytes are available.
+   *
+   * @param uri The URI file to read from.
+   * @param offset The offset in the file the read will start from.
+   * @param buffer The buffer to write into. The function reallocates memory
+   *     for the buffer, sets its size to *nbytes_read* and resets its offset.
+   * @param nbytes The maximum number of bytes to read.
+   * @param nbytes_read The number of bytes actually read.
+   * @return Status.
+   */
+  Status read_at_most(
+      const URI& uri,
+      uint64_t offset,
+      Buffer* buffer,
+      uint64_t nbytes,
+      uint64_t* nbytes_read) const;
+
   /**
    * Stores an array schema into persistent storage.
    *
@@ -564,9 +963,17 @@ class StorageManager {
    * @param uri The URI of the cached object.
    * @param offset The offset of the cached object.
    * @param buffer The buffer whose contents will be cached.
+   * @param hint The cache behavior hint of the requesting query;
+   *     `CacheHint::BYPASS` skips the insertion altogether, whereas
+   *     `CacheHint::PIN` inserts the object pinned against eviction by
+   *     one-shot reads.
    * @return Status.
    */
-  Status write_to_cache(const URI& uri, uint64_t offset, Buffer* buffer) const;
+  Status write_to_cache(
+      const URI& uri,
+      uint64_t offset,
+      Buffer* buffer,
+      CacheHint hint = CacheHint::CACHE_DEFAULT) const;
 
   /**
    * Writes the contents of a buffer into a URI file.
@@ -582,38 +989,129 @@ class StorageManager {
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
 
+  /** An entry in the async query queue. */
+  struct AsyncQuery {
+    /**
+     * The estimated query cost, i.e., the number of subarray cells for
+     * reads of known size, or `UINT64_MAX` otherwise.
+     */
+    uint64_t cost_;
+
+    /** Monotonic arrival number, keeping equal-cost queries FIFO. */
+    uint64_t seq_;
+
+    /** The query to process. */
+    Query* query_;
+
+    /** Orders the queue so that the cheapest, oldest query is on top. */
+    bool operator<(const AsyncQuery& rhs) const {
+      if (cost_ != rhs.cost_)
+        return cost_ > rhs.cost_;
+      return seq_ > rhs.seq_;
+    }
+  };
+
+  /**
+   * The timestamp (in ms since the epoch) at which arrays open for
+   * reading; fragments written after it are skipped. A value of 0 means
+   * the current time (no fragment is skipped).
+   */
+  uint64_t array_open_timestamp_;
+
   /** An array schema cache. */
   LRUCache* array_schema_cache_;
 
+  /**
+   * Process-wide map of deserialized array schemas, indexed by array
+   * URI string. Schemas are immutable once created, so an entry remains
+   * valid until its array gets removed or moved; repeated opens of the
+   * same array skip the existence checks, the schema file I/O and the
+   * deserialization. The storage manager owns the stored schema objects
+   * and serves copies to the callers. Mutable, as the (const) object
+   * removal/move paths evict entries.
+   */
+  mutable std::map<std::string, ArraySchema*> array_schemas_;
+
+  /** Protects `array_schemas_`. */
+  mutable std::mutex array_schemas_mtx_;
+
+  /** A pool of reusable tile-sized buffers. */
+  BufferPool* buffer_pool_;
+
+  /**
+   * The memory budget that the caches and per-query tile buffers charge
+   * against.
+   */
+  MemoryBudget* memory_budget_;
+
   /** Mutex for providing thread-safety upon creating TileDB objects. */
   std::mutex object_create_mtx_;
 
-  /**
-   * Async condition variable. The first is for user async queries, the second
-   * for internal async queries.
-   * */
-  std::condition_variable async_cv_[2];
+  /** Async condition variable, signaled when a query is pushed. */
+  std::condition_variable async_cv_;
 
-  /** If true, the async thread will be eventually terminated. */
+  /** If true, the async workers will be eventually terminated. */
   bool async_done_;
 
   /**
-   * Async query queue. The first is for user queries, the second for
-   * internal queries. The queries are processed in a FIFO manner.
+   * Async query queue, shared by all async workers. The queries are
+   * processed in ascending order of estimated cost, so that small point
+   * reads are not stuck behind bulk scans; equal-cost queries are
+   * processed in a FIFO manner.
+   */
+  std::priority_queue<AsyncQuery> async_queue_;
+
+  /** Async queue mutex. */
+  std::mutex async_mtx_;
+
+  /** The next arrival number to be assigned to an async query. */
+  uint64_t async_seq_;
+
+  /** The worker threads that handle all async queries. */
+  std::vector<std::thread*> async_threads_;
+
+  /**
+   * The background consolidation scheduler thread (`nullptr` if the
+   * scheduler is disabled). It periodically checks the fragment count
+   * of the open arrays and consolidates the arrays whose count crossed
+   * the configured threshold.
+   */
+  std::thread* consolidation_scheduler_thread_;
+
+  /** If true, the consolidation scheduler will be eventually terminated. */
+  bool consolidation_scheduler_done_;
+
+  /** Protects `consolidation_scheduler_done_`. */
+  std::mutex consolidation_scheduler_mtx_;
+
+  /**
+   * Consolidation scheduler condition variable, signaled upon
+   * termination so that the scheduler does not sleep out its interval.
    */
-  std::queue<Query*> async_queue_[2];
+  std::condition_variable consolidation_scheduler_cv_;
+
+  /** Thread pool for compute-bound tasks (e.g. tile decompression). */
+  ThreadPool* compute_thread_pool_;
+
+  /** Thread pool for I/O-bound tasks (e.g. tile read-ahead). */
+  ThreadPool* io_thread_pool_;
 
   /**
-   * Async mutex. The first is for the user queries thread, the second for
-   * the internal queries thread.
+   * `True` if the thread pools are the process-wide shared ones (see
+   * `sm.shared_thread_pools`), in which case they are not owned (or
+   * destroyed) by this storage manager.
    */
-  std::mutex async_mtx_[2];
+  bool shared_thread_pools_;
 
   /**
-   * Threads that handle all async queries. The first is for user queries,
-   * the second for internal queries.
+   * Pending background array preload tasks (see `array_preload`).
+   * Completed entries are pruned whenever a new preload is issued; the
+   * destructor waits on the rest before tearing down the thread pools.
    */
-  std::thread* async_thread_[2];
+  std::vector<std::future<Status>> preload_tasks_;
+
+  /** Mutex protecting `preload_tasks_`. */
+  std::mutex preload_tasks_mtx_;
 
   /** Stores the TileDB configuration parameters. */
   Config config_;
@@ -621,9 +1119,84 @@ class StorageManager {
   /** Object that handles array consolidation. */
   Consolidator* consolidator_;
 
+  /**
+   * Object that combines small unordered writes into merged fragments
+   * (see `sm.write_combining_budget`).
+   */
+  WriteCombiner* write_combiner_;
+
   /** A fragment metadata cache. */
   LRUCache* fragment_metadata_cache_;
 
+  /**
+   * Process-wide map of deserialized fragment metadata, indexed by
+   * fragment URI string. Fragments are immutable, so the entries remain
+   * valid for the lifetime of the storage manager, and repeated opens of
+   * the same array skip both the metadata I/O and the deserialization.
+   * The storage manager owns the stored metadata objects.
+   */
+  std::map<std::string, FragmentMetadata*> fragment_metadata_;
+
+  /** Mutex for managing the fragment metadata map. */
+  std::mutex fragment_metadata_mtx_;
+
+  /**
+   * A compact summary of a fragment, sufficient for deciding whether the
+   * fragment can contribute cells to a subarray without loading its full
+   * metadata.
+   */
+  struct FragmentSummary {
+    /** `true` if the fragment is dense. */
+    bool dense_;
+    /** The timestamp encoded in the fragment name. */
+    uint64_t timestamp_;
+    /**
+     * The domain the fragment may contribute cells in; the expanded
+     * fragment domain for dense fragments and the non-empty domain for
+     * sparse ones.
+     */
+    std::vector<uint8_t> domain_;
+  };
+
+  /**
+   * Process-wide map of fragment summaries, indexed by fragment URI
+   * string. Like the fragment metadata, the summaries are immutable and
+   * remain valid for the lifetime of the storage manager.
+   */
+  std::map<std::string, FragmentSummary> fragment_summaries_;
+
+  /** Mutex for managing the fragment summaries map. */
+  std::mutex fragment_summaries_mtx_;
+
+  /**
+   * A small memo cache for max read buffer size computations, indexed
+   * by a key combining the fragment set, the subarray and the targeted
+   * attributes. Clients commonly size their buffers with the same
+   * subarray before every read, so identical bounds are computed only
+   * once per fragment set. Fragments are immutable, so the entries
+   * never go stale; the cache is simply cleared when it grows beyond a
+   * small limit.
+   */
+  std::map<std::string, std::vector<uint64_t>> max_buffer_sizes_memo_;
+
+  /** Mutex for managing the max buffer sizes memo cache. */
+  std::mutex max_buffer_sizes_memo_mtx_;
+
+  /**
+   * Process-wide set of URIs known to be committed fragments. Fragments
+   * are immutable, so once a URI has passed the existence check it need
+   * not be re-checked; each fragment listing diffs against this set and
+   * pays the per-fragment check only for newly arrived fragments. This
+   * makes the steady-state cost of reopening an array proportional to
+   * the fragment arrival rate rather than the array history. The set is
+   * consulted only for URIs present in the current listing, so entries
+   * of deleted (e.g., consolidated) fragments are harmless.
+   */
+  std::set<std::string> known_fragments_;
+
+  /** Mutex for managing the known fragments set. */
+  std::mutex known_fragments_mtx_;
+
   /** Used for object shared and exclusive locking. */
   std::mutex locked_object_mtx_;
 
@@ -633,17 +1206,103 @@ class StorageManager {
    */
   std::map<std::string, LockedObject*> locked_objs_;
 
-  /** Mutex for managing OpenArray objects. */
-  std::mutex open_array_mtx_;
+  /** A shard of the open array registry, guarded by its own mutex. */
+  struct OpenArrayShard {
+    /**
+     * Stores the currently open arrays of the shard. An array is *opened*
+     * when a new query is initialized via *query_init* for a particular
+     * array. The map is indexed by the array URI string.
+     */
+    std::map<std::string, OpenArray*> open_arrays_;
+
+    /** Protects `open_arrays_`. */
+    std::mutex mtx_;
+  };
+
+  /**
+   * The open array registry, sharded by array URI hash so that opens and
+   * closes of unrelated arrays do not contend on a single global mutex.
+   */
+  std::vector<OpenArrayShard*> open_array_shards_;
+
+  /** A tile cache, sharded to avoid global lock contention. */
+  ShardedLRUCache* tile_cache_;
+
+  /** If `true`, the tile cache stores compressed tile bytes. */
+  bool tile_cache_compressed_;
+
+  /**
+   * An optional persistent second-tier tile cache on local disk, or
+   * `nullptr` if disabled. Memory cache misses fall through to it
+   * before reaching the (potentially remote) backend.
+   */
+  DiskCache* disk_tile_cache_;
+
+  /** An in-flight single-flight tile fetch that waiters block on. */
+  struct InFlightTileFetch {
+    /** Protects `done_`. */
+    std::mutex mtx_;
+
+    /** Signals the completion of the fetch. */
+    std::condition_variable cv_;
+
+    /** `true` when the fetch has completed. */
+    bool done_ = false;
+  };
+
+  /**
+   * The in-flight tile fetches, indexed by the tile cache key. The
+   * entries are shared with the waiters, so an entry remains valid for
+   * a waiter even after the leader erases it upon completion.
+   */
+  std::map<CacheKey, std::shared_ptr<InFlightTileFetch>>
+      inflight_tile_fetches_;
+
+  /** Protects `inflight_tile_fetches_`. */
+  std::mutex inflight_tile_fetches_mtx_;
+
+  /**
+   * The last observed tile request and the detected stride for a file,
+   * maintained by the predictive tile prefetcher.
+   */
+  struct TileAccessPattern {
+    /** The offset of the last requested tile. */
+    uint64_t offset_ = 0;
+
+    /** The size of the last requested tile. */
+    uint64_t nbytes_ = 0;
+
+    /** The signed distance between the last two requested tiles. */
+    int64_t stride_ = 0;
+
+    /** The number of consecutive requests that repeated `stride_`. */
+    uint64_t confirmations_ = 0;
+  };
+
+  /** If `true`, the predictive tile prefetcher is enabled. */
+  bool tile_prefetch_;
 
   /**
-   * Stores the currently open arrays. An array is *opened* when a new query is
-   * initialized via *query_init* for a particular array.
+   * The tile access patterns observed by the prefetcher, indexed by
+   * `URI::id`. `mutable` as the patterns are updated on the logically
+   * `const` cache read path.
    */
-  std::map<std::string, OpenArray*> open_arrays_;
+  mutable std::map<uint64_t, TileAccessPattern> tile_access_patterns_;
 
-  /** A tile cache. */
-  LRUCache* tile_cache_;
+  /** The number of speculative tile fetches currently in flight. */
+  mutable uint64_t tile_prefetches_inflight_;
+
+  /**
+   * Set to `true` upon destruction, preventing further speculative
+   * fetches from being scheduled.
+   */
+  bool tile_prefetch_stop_;
+
+  /** Signals when a speculative tile fetch completes. */
+  mutable std::condition_variable tile_prefetch_cv_;
+
+  /** Protects the prefetcher state above. */
+  mutable std::mutex tile_prefetch_mtx_;
 
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
@@ -655,8 +1314,32 @@ class StorageManager {
   /*         PRIVATE METHODS           */
   /* ********************************* */
 
-  /** Closes an array. */
-  Status array_close(URI array);
+  /**
+   * Feeds one tile cache request into the predictive prefetcher. The
+   * prefetcher tracks the per-file sequence of requested (offset, size)
+   * pairs; once a constant stride with a constant size repeats
+   * `constants::tile_prefetch_confirmations` times, the next tile in
+   * the sequence is speculatively scheduled on the I/O thread pool via
+   * `tile_prefetch`, so that the sequence finds it already cached.
+   *
+   * @param uri The URI of the requested tile.
+   * @param offset The offset of the requested tile.
+   * @param nbytes The size of the requested tile.
+   */
+  void tile_prefetch_observe(
+      const URI& uri, uint64_t offset, uint64_t nbytes) const;
+
+  /**
+   * Speculatively fetches `nbytes` bytes at `offset` of `uri` into the
+   * tile cache, unless the tile is already cached or being fetched. A
+   * failed speculative read (e.g. a prediction past the end of the
+   * file) is silently dropped.
+   *
+   * @param uri The URI of the predicted tile.
+   * @param offset The offset of the predicted tile.
+   * @param nbytes The size of the predicted tile.
+   */
+  void tile_prefetch(const URI& uri, uint64_t offset, uint64_t nbytes);
 
   /**
    * Retrieves the non-empty domain from the input fragment metadata. This is
@@ -674,35 +1357,86 @@ class StorageManager {
       T* domain);
 
   /**
-   * Opens an array, retrieving its schema and fragment metadata.
+   * Invokes in case an error occurs in array_open. It is a clean-up
+   * function.
    *
-   * @param array_uri The array URI.
-   * @param query_type The query type.
-   * @param array_schema The array schema to be retrieved.
-   * @param fragment_metadata The fragment metadat to be retrieved.
-   * @return
+   * @param open_array The open array entry to clean up.
+   * @param shared_mode `true` if the caller holds the array mutex in
+   *     shared mode, `false` if in exclusive mode.
+   * @return Status
    */
-  Status array_open(
-      const URI& array_uri,
-      QueryType query_type,
-      const ArraySchema** array_schema,
-      std::vector<FragmentMetadata*>* fragment_metadata);
+  Status array_open_error(OpenArray* open_array, bool shared_mode);
 
   /**
-   * Invokes in case an error occurs in array_open. It is a clean-up function.
+   * Retrieves the TileDB objects contained in each of the input paths,
+   * listing all the paths concurrently on the I/O thread pool. This is
+   * used by the object iterators to expand a whole frontier of
+   * discovered directories with one parallel round of listings, instead
+   * of issuing one `VFS::ls` per directory sequentially.
+   *
+   * @param paths The paths to list.
+   * @param children Maps each path (in string format) to the TileDB
+   *     objects it contains, in listing order.
+   * @return Status
+   */
+  Status ls_objects(
+      const std::vector<URI>& paths,
+      std::map<std::string, std::vector<URI>>* children);
+
+  /**
+   * Partitions a subarray against the input fragment snapshot, such
+   * that the maximum read sizes of each partition over the input
+   * attributes fit in the memory budget (see `array_partition_subarray`
+   * for the splitting rules).
+   *
+   * @param array_schema The array schema.
+   * @param fragment_metadata The fragment metadata of the array.
+   * @param subarray The subarray to partition. Use `nullptr` for the
+   *     entire domain.
+   * @param layout The layout in which the partitions will be read.
+   * @param attribute_ids The ids of the attributes the reads will
+   *     focus on.
+   * @param budget The memory budget (in bytes).
+   * @param partitions The serialized sub-partitions.
+   * @return Status
+   */
+  Status compute_subarray_partitions(
+      const ArraySchema* array_schema,
+      const std::vector<FragmentMetadata*>& fragment_metadata,
+      const void* subarray,
+      Layout layout,
+      const std::vector<unsigned>& attribute_ids,
+      uint64_t budget,
+      std::list<std::vector<uint8_t>>* partitions);
+
+  /**
+   * Retrieves the TileDB objects contained in `path` during an object
+   * iteration, consuming the corresponding entry of the iterator's
+   * children cache. Upon a cache miss, all the discovered directories
+   * pending a listing are listed concurrently.
+   *
+   * @param obj_iter The object iterator.
+   * @param path The path whose contained objects are retrieved.
+   * @param children The contained TileDB objects, in listing order.
+   * @return Status
+   */
+  Status object_iter_children(
+      ObjectIter* obj_iter, const URI& path, std::vector<URI>* children);
+
+  /**
+   * Evicts from the deserialized schema map the entries under the input
+   * URI: the URI itself, and any URI beneath it when a group gets moved
+   * or removed.
    */
-  Status array_open_error(OpenArray* open_array);
+  void array_schemas_evict(const URI& uri) const;
 
   /**
    * Starts listening to async queries.
    *
    * @param storage_manager The storage manager object that handles the
-   *     async query threads.
-   * @param i The index of the thread to execute the function. If it is
-   *     equal to 0, it means a user query, whereas if it is 1 it means an
-   *     internal query.
+   *     async query workers.
    */
-  static void async_start(StorageManager* storage_manager, int i = 0);
+  static void async_start(StorageManager* storage_manager);
 
   /** Stops listening to async queries. */
   void async_stop();
@@ -711,28 +1445,155 @@ class StorageManager {
   void async_process_query(Query* query);
 
   /**
-   * Starts handling async queries.
+   * Starts handling async queries. This is executed by each async
+   * worker thread.
+   */
+  void async_process_queries();
+
+  /**
+   * The consolidation scheduler thread entry point.
+   *
+   * @param storage_manager The storage manager object that owns the
+   *     scheduler thread.
+   */
+  static void consolidation_scheduler_start(StorageManager* storage_manager);
+
+  /** Stops the consolidation scheduler thread. */
+  void consolidation_scheduler_stop();
+
+  /**
+   * Retrieves the process-wide thread pools shared by the contexts
+   * created with `sm.shared_thread_pools`. The pools are created upon
+   * the first call (sized by its arguments; subsequent calls ignore
+   * theirs) and live until process exit.
+   *
+   * @param num_compute_threads The compute pool size upon creation.
+   * @param num_io_threads The I/O pool size upon creation.
+   * @param numa_aware NUMA awareness of the pools upon creation.
+   * @param compute_thread_pool The shared compute pool to be retrieved.
+   * @param io_thread_pool The shared I/O pool to be retrieved.
+   */
+  static void shared_thread_pools(
+      uint64_t num_compute_threads,
+      uint64_t num_io_threads,
+      bool numa_aware,
+      ThreadPool** compute_thread_pool,
+      ThreadPool** io_thread_pool);
+
+  /**
+   * Runs the consolidation scheduler loop: every scan interval, the
+   * fragment count of each open array is checked and the arrays whose
+   * count crossed the configured threshold are consolidated.
+   * Consolidation failures are logged and do not stop the scheduler.
+   */
+  void consolidation_scheduler_process();
+
+  /**
+   * Adds the input metadata to the process-wide fragment metadata map,
+   * which assumes ownership of it. If the fragment has been registered
+   * concurrently by another thread, the input is deleted and the already
+   * registered metadata is returned instead.
    *
-   * @param i The index of the thread that executes the function. If it is
-   * equal to 0, it means a user query, whereas if it is 1 it means an
-   * internal query.
+   * @param metadata The fragment metadata to add.
+   * @return The registered metadata for the fragment.
+   */
+  FragmentMetadata* fragment_metadata_add(FragmentMetadata* metadata);
+
+  /**
+   * Retrieves the metadata of a fragment from the process-wide fragment
+   * metadata map (`nullptr` if it is not found).
+   */
+  FragmentMetadata* fragment_metadata_get(const URI& fragment_uri);
+
+  /** Adds a fragment summary to the process-wide summary map. */
+  void fragment_summary_add(
+      const URI& fragment_uri, const FragmentSummary& summary);
+
+  /**
+   * Retrieves a fragment summary from the process-wide summary map,
+   * returning `false` if it is not found.
    */
-  void async_process_queries(int i);
+  bool fragment_summary_get(const URI& fragment_uri, FragmentSummary* summary);
 
-  /** Retrieves all the fragment URI's of an array. */
+  /** Constructs a fragment summary from loaded fragment metadata. */
+  FragmentSummary fragment_summary_from_metadata(
+      const ArraySchema* array_schema, FragmentMetadata* metadata) const;
+
+  /**
+   * Loads the summary file of a fragment. Sets `found` to `false` if the
+   * fragment has no summary file (e.g., it was written by an older
+   * version) or the file is malformed, in which case the caller must
+   * fall back to loading the full fragment metadata.
+   */
+  Status load_fragment_summary(
+      const URI& fragment_uri, FragmentSummary* summary, bool* found);
+
+  /**
+   * Stores the summary file of a fragment, constructed from its loaded
+   * metadata. Invoked before the fragment metadata file is written, so
+   * that any fragment with a metadata file also has a summary.
+   */
+  Status store_fragment_summary(FragmentMetadata* metadata);
+
+  /**
+   * Returns `true` if the fragment domain recorded in the input summary
+   * overlaps the input subarray.
+   */
+  bool summary_overlaps(
+      const ArraySchema* array_schema,
+      const FragmentSummary& summary,
+      const void* subarray) const;
+
+  /**
+   * Retrieves all the fragment URI's of an array. The listing is diffed
+   * against the known fragments set, so only fragments seen for the
+   * first time pay the existence check.
+   */
   Status get_fragment_uris(
-      const URI& array_uri, std::vector<URI>* fragment_uris) const;
+      const URI& array_uri, std::vector<URI>* fragment_uris);
+
+  /** Returns `true` if the URI is in the known fragments set. */
+  bool fragment_known(const URI& fragment_uri);
 
-  /** Retrieves an open array entry for the given array URI. */
-  Status open_array_get_entry(const URI& array_uri, OpenArray** open_array);
+  /** Adds the URI to the known fragments set. */
+  void fragment_known_add(const URI& fragment_uri);
+
+  /**
+   * Retrieves (creating it if it does not exist) an open array entry for
+   * the given array URI. The caller must hold the mutex of the input
+   * registry shard.
+   */
+  Status open_array_get_entry(
+      OpenArrayShard* shard, const URI& array_uri, OpenArray** open_array);
 
   /** Loads the array schema into an open array. */
   Status open_array_load_array_schema(
       const URI& array_uri, OpenArray* open_array);
 
-  /** Retrieves the fragment metadata of an open array for a given subarray. */
+  /** Returns the registry shard that stores the input array URI. */
+  OpenArrayShard* open_array_shard(const URI& array_uri) const;
+
+  /**
+   * Retrieves the metadata of the input fragments (sorted by timestamp)
+   * into an open array. The fragment listing is performed by the caller,
+   * so that it can overlap with the schema load. If `subarray` is not
+   * `nullptr`, the fragments whose domain does not overlap the subarray
+   * are pruned via their summaries, skipping their full metadata load.
+   */
   Status open_array_load_fragment_metadata(
-      OpenArray* open_array, std::vector<FragmentMetadata*>* fragment_metadata);
+      OpenArray* open_array,
+      const std::vector<URI>& fragment_uris,
+      const void* subarray,
+      std::vector<FragmentMetadata*>* fragment_metadata);
+
+  /**
+   * Removes the fragments written after `array_open_timestamp_` from
+   * the input URIs. A no-op when the timestamp is 0.
+   */
+  void filter_fragment_uris(std::vector<URI>* fragment_uris) const;
+
+  /** Returns the timestamp encoded in the input fragment URI name. */
+  static uint64_t fragment_timestamp(const URI& fragment_uri);
 
   /**
    * Sorts the input fragment URIs in ascending timestamp order, breaking
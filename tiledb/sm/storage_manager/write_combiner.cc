@@ -0,0 +1,273 @@
+/**
+ * @file   write_combiner.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class WriteCombiner.
+ */
+
+#include "tiledb/sm/storage_manager/write_combiner.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/query/query.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+WriteCombiner::WriteCombiner(
+    StorageManager* storage_manager, uint64_t buffer_budget)
+    : storage_manager_(storage_manager)
+    , buffer_budget_(buffer_budget) {
+  total_bytes_ = 0;
+}
+
+WriteCombiner::~WriteCombiner() {
+  flush_all();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status WriteCombiner::combine(Query* query, bool* combined) {
+  *combined = false;
+  if (buffer_budget_ == 0)
+    return Status::Ok();
+
+  auto array_schema = query->array_schema();
+  if (array_schema == nullptr)
+    return Status::Ok();
+  auto array_name = array_schema->array_uri().to_string();
+
+  // Compute the total write size of an eligible query
+  bool eligible = query->type() == QueryType::WRITE &&
+                  query->layout() == Layout::UNORDERED &&
+                  !array_schema->dense() && query->subarray() == nullptr &&
+                  !query->attribute_ids().empty() &&
+                  query->buffers() != nullptr &&
+                  query->buffer_sizes() != nullptr;
+  uint64_t write_bytes = 0;
+  if (eligible) {
+    unsigned int buffer_num;
+    RETURN_NOT_OK(
+        array_schema->buffer_num(query->attribute_ids(), &buffer_num));
+    for (unsigned int b = 0; b < buffer_num; ++b)
+      write_bytes += query->buffer_sizes()[b];
+    eligible = write_bytes > 0 && write_bytes < buffer_budget_;
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // A write that cannot join the pending batch of its array (it is not
+  // combinable, or it writes a different attribute set) flushes the
+  // batch first, so that the writes of an array always apply in
+  // submission order
+  auto it = pending_.find(array_name);
+  if (it != pending_.end() && query->type() == QueryType::WRITE &&
+      (!eligible || it->second->attribute_ids_ != query->attribute_ids())) {
+    auto pending = it->second;
+    pending_.erase(it);
+    RETURN_NOT_OK(flush_pending(array_name, pending));
+  }
+
+  if (!eligible)
+    return Status::Ok();
+
+  // Charge the buffered bytes against the memory budget, flushing
+  // everything to make room if needed; if they still do not fit, the
+  // write passes through uncombined
+  auto memory_budget = storage_manager_->memory_budget();
+  if (!memory_budget->try_charge(write_bytes)) {
+    RETURN_NOT_OK(flush_all_locked());
+    if (!memory_budget->try_charge(write_bytes))
+      return Status::Ok();
+  }
+
+  Status st = append(query, write_bytes);
+  if (!st.ok()) {
+    // A partially appended batch is unusable; drop it
+    memory_budget->release(write_bytes);
+    auto it_err = pending_.find(array_name);
+    if (it_err != pending_.end()) {
+      memory_budget->release(it_err->second->bytes_);
+      total_bytes_ -= it_err->second->bytes_;
+      delete it_err->second;
+      pending_.erase(it_err);
+    }
+    return st;
+  }
+
+  total_bytes_ += write_bytes;
+  query->set_status(QueryStatus::COMPLETED);
+  *combined = true;
+
+  // Flush once the buffered bytes reach the budget
+  if (total_bytes_ >= buffer_budget_)
+    return flush_all_locked();
+
+  return Status::Ok();
+}
+
+Status WriteCombiner::flush(const std::string& array_name) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto it = pending_.find(array_name);
+  if (it == pending_.end())
+    return Status::Ok();
+
+  auto pending = it->second;
+  pending_.erase(it);
+  return flush_pending(array_name, pending);
+}
+
+Status WriteCombiner::flush_all() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return flush_all_locked();
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+Status WriteCombiner::append(Query* query, uint64_t write_bytes) {
+  auto array_schema = query->array_schema();
+  auto array_name = array_schema->array_uri().to_string();
+  auto& attribute_ids = query->attribute_ids();
+
+  // Create the batch of the array if it does not exist. A fixed-sized
+  // attribute (and the coordinates) occupies one buffer slot; a
+  // variable-sized attribute occupies an offsets slot followed by a
+  // values slot, mirroring the query buffer layout.
+  auto it = pending_.find(array_name);
+  if (it == pending_.end()) {
+    auto pending = new PendingWrites();
+    pending->attribute_ids_ = attribute_ids;
+    for (auto id : attribute_ids) {
+      pending->attributes_.emplace_back(
+          (id == array_schema->attribute_num()) ?
+              constants::coords :
+              array_schema->attribute_name(id));
+      if (array_schema->var_size(id)) {
+        pending->var_slot_.push_back(
+            (unsigned int)pending->buffers_.size() + 1);
+        pending->buffers_.push_back(new Buffer());
+      }
+      pending->var_slot_.push_back(UINT32_MAX);
+      pending->buffers_.push_back(new Buffer());
+    }
+    it = pending_.insert(std::make_pair(array_name, pending)).first;
+  }
+
+  // Append the query buffers to the batch
+  auto pending = it->second;
+  auto buffers = query->buffers();
+  auto buffer_sizes = query->buffer_sizes();
+  for (size_t b = 0; b < pending->buffers_.size(); ++b) {
+    if (pending->var_slot_[b] != UINT32_MAX) {
+      // Offsets of a variable-sized attribute; rebase them onto the
+      // values already buffered for the attribute
+      uint64_t base = pending->buffers_[pending->var_slot_[b]]->size();
+      auto offsets = (const uint64_t*)buffers[b];
+      uint64_t offset_num = buffer_sizes[b] / constants::cell_var_offset_size;
+      for (uint64_t i = 0; i < offset_num; ++i) {
+        uint64_t offset = offsets[i] + base;
+        RETURN_NOT_OK(pending->buffers_[b]->write(&offset, sizeof(uint64_t)));
+      }
+    } else {
+      RETURN_NOT_OK(pending->buffers_[b]->write(buffers[b], buffer_sizes[b]));
+    }
+  }
+  pending->bytes_ += write_bytes;
+
+  return Status::Ok();
+}
+
+Status WriteCombiner::flush_pending(
+    const std::string& array_name, PendingWrites* pending) {
+  // Assemble the merged query input
+  auto buffer_num = (unsigned int)pending->buffers_.size();
+  std::vector<const char*> attributes;
+  for (auto& attr : pending->attributes_)
+    attributes.push_back(attr.c_str());
+  std::vector<void*> buffers(buffer_num);
+  std::vector<uint64_t> buffer_sizes(buffer_num);
+  for (unsigned int b = 0; b < buffer_num; ++b) {
+    buffers[b] = pending->buffers_[b]->data();
+    buffer_sizes[b] = pending->buffers_[b]->size();
+  }
+
+  // Write the batch as a single unordered write query, producing one
+  // merged fragment. The query is executed inline rather than through
+  // `query_submit`, as the latter would route it back into the combiner.
+  auto query = new Query();
+  Status st = storage_manager_->query_init(
+      query,
+      array_name.c_str(),
+      QueryType::WRITE,
+      Layout::UNORDERED,
+      nullptr,
+      &attributes[0],
+      (unsigned int)attributes.size(),
+      &buffers[0],
+      &buffer_sizes[0]);
+  if (st.ok()) {
+    st = query->init();
+    if (st.ok())
+      st = query->write();
+    auto st_finalize = storage_manager_->query_finalize(query);
+    if (st.ok())
+      st = st_finalize;
+  }
+  delete query;
+
+  // The batch is dropped regardless of the outcome; on failure, the
+  // error surfaces to the submission that triggered the flush
+  storage_manager_->memory_budget()->release(pending->bytes_);
+  total_bytes_ -= pending->bytes_;
+  delete pending;
+
+  return st;
+}
+
+Status WriteCombiner::flush_all_locked() {
+  Status ret = Status::Ok();
+  for (auto& entry : pending_) {
+    auto st = flush_pending(entry.first, entry.second);
+    if (!st.ok() && ret.ok())
+      ret = st;
+  }
+  pending_.clear();
+
+  return ret;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,206 @@
+/**
+ * @file   write_combiner.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class WriteCombiner.
+ */
+
+#ifndef TILEDB_WRITE_COMBINER_H
+#define TILEDB_WRITE_COMBINER_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+class Query;
+class StorageManager;
+
+/**
+ * Combines small unordered sparse writes into larger ones. Every write
+ * query normally produces a full fragment directory with one file per
+ * attribute, so workloads that issue many tiny writes (e.g. appending
+ * telemetry records as they arrive) accumulate fragments much faster
+ * than consolidation can merge them, and read performance collapses in
+ * the meantime.
+ *
+ * When `sm.write_combining_budget` is set, the storage manager routes
+ * synchronously submitted writes through this class instead. A write
+ * that is unordered, sparse, not constrained to a subarray and smaller
+ * than the budget gets its buffers copied into an in-memory batch keyed
+ * by the array URI (variable-sized attribute offsets are rebased onto
+ * the batch), and the query completes immediately. A batch is flushed
+ * as a single internal unordered write query--producing one merged
+ * fragment--when the buffered bytes reach the budget, when the array
+ * gets opened for reading (reads snapshot the fragments upon opening,
+ * so they observe the buffered writes), when a non-combinable write is
+ * submitted against the array, when the array gets consolidated, or
+ * when the storage manager shuts down, so applications observe their
+ * own writes without any code changes.
+ *
+ * Combined writes are durable only once their batch is flushed; if a
+ * flush fails, the batch is dropped and the error is returned to the
+ * submission that triggered the flush. The buffered bytes are charged
+ * against the memory budget.
+ */
+class WriteCombiner {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param storage_manager The storage manager.
+   * @param buffer_budget The maximum number of buffered bytes; reaching
+   *     it triggers a flush. 0 disables write combining.
+   */
+  WriteCombiner(StorageManager* storage_manager, uint64_t buffer_budget);
+
+  /** Destructor. Flushes all pending writes (best effort). */
+  ~WriteCombiner();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Buffers the write buffers of the input query if it is a combinable
+   * small write, marking the query completed. A write that cannot join
+   * the pending batch of its array (it is too large, constrained, or
+   * writes a different attribute set) flushes the batch first, so that
+   * the writes of an array always apply in submission order.
+   *
+   * @param query The submitted query.
+   * @param combined Set to `true` if the query was buffered, in which
+   *     case the caller must not execute it.
+   * @return Status
+   */
+  Status combine(Query* query, bool* combined);
+
+  /** Flushes the pending writes of the input array. */
+  Status flush(const std::string& array_name);
+
+  /** Flushes all pending writes. */
+  Status flush_all();
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** The buffered writes of a single array. */
+  struct PendingWrites {
+    /** The attribute names, in the order of the original queries. */
+    std::vector<std::string> attributes_;
+
+    /** The corresponding attribute ids. */
+    std::vector<unsigned int> attribute_ids_;
+
+    /** One buffer per query buffer slot. */
+    std::vector<Buffer*> buffers_;
+
+    /**
+     * For each buffer slot, the slot of the corresponding
+     * variable-sized value buffer if the slot holds offsets, or
+     * `UINT32_MAX` if it holds fixed-sized cells or values.
+     */
+    std::vector<unsigned int> var_slot_;
+
+    /** The total number of buffered bytes. */
+    uint64_t bytes_;
+
+    PendingWrites() {
+      bytes_ = 0;
+    }
+
+    ~PendingWrites() {
+      for (auto& buff : buffers_)
+        delete buff;
+    }
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The storage manager. */
+  StorageManager* storage_manager_;
+
+  /** The buffered byte budget (0 disables write combining). */
+  uint64_t buffer_budget_;
+
+  /** Protects the pending writes. */
+  std::mutex mtx_;
+
+  /** The pending writes, keyed by array URI. */
+  std::map<std::string, PendingWrites*> pending_;
+
+  /** The total number of buffered bytes across all arrays. */
+  uint64_t total_bytes_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Appends the write buffers of the input query to the pending writes
+   * of its array, creating them if needed.
+   *
+   * @param query The query to buffer.
+   * @param write_bytes The total number of bytes the query writes.
+   * @return Status
+   */
+  Status append(Query* query, uint64_t write_bytes);
+
+  /**
+   * Flushes the input pending writes as a single unordered write query.
+   * The batch is deleted and its bytes are released from the memory
+   * budget regardless of the outcome. Must be called with `mtx_` held.
+   *
+   * @param array_name The array the pending writes belong to.
+   * @param pending The pending writes; owned (and freed) by the call.
+   * @return Status
+   */
+  Status flush_pending(const std::string& array_name, PendingWrites* pending);
+
+  /** Flushes all pending writes. Must be called with `mtx_` held. */
+  Status flush_all_locked();
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_WRITE_COMBINER_H
@@ -31,6 +31,7 @@
  */
 
 #include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 
 #include <iostream>
@@ -49,7 +50,12 @@ Tile::Tile() {
   compression_level_ = -1;
   dim_num_ = 0;
   owns_buff_ = true;
+  shuffle_ = false;
+  dict_encode_ = false;
+  offsets_tile_ = nullptr;
   type_ = Datatype::INT32;
+  unzipped_coords_ = false;
+  offsets_32_ = false;
 }
 
 Tile::Tile(unsigned int dim_num)
@@ -59,7 +65,12 @@ Tile::Tile(unsigned int dim_num)
   compressor_ = Compressor::NO_COMPRESSION;
   compression_level_ = -1;
   owns_buff_ = true;
+  shuffle_ = false;
+  dict_encode_ = false;
+  offsets_tile_ = nullptr;
   type_ = Datatype::INT32;
+  unzipped_coords_ = false;
+  offsets_32_ = false;
 }
 
 Tile::Tile(
@@ -76,7 +87,58 @@ Tile::Tile(
     , compression_level_(compression_level)
     , dim_num_(dim_num)
     , owns_buff_(owns_buff)
-    , type_(type) {
+    , shuffle_(false)
+    , dict_encode_(false)
+    , offsets_tile_(nullptr)
+    , type_(type)
+    , unzipped_coords_(false)
+    , offsets_32_(false) {
+}
+
+Tile::Tile(Tile&& tile)
+    : buffer_(tile.buffer_)
+    , cached_object_(std::move(tile.cached_object_))
+    , cell_size_(tile.cell_size_)
+    , compressor_(tile.compressor_)
+    , compression_level_(tile.compression_level_)
+    , dim_num_(tile.dim_num_)
+    , owns_buff_(tile.owns_buff_)
+    , shuffle_(tile.shuffle_)
+    , dict_encode_(tile.dict_encode_)
+    , offsets_tile_(tile.offsets_tile_)
+    , type_(tile.type_)
+    , unzipped_coords_(tile.unzipped_coords_)
+    , offsets_32_(tile.offsets_32_) {
+  tile.buffer_ = nullptr;
+  tile.owns_buff_ = true;
+  tile.offsets_tile_ = nullptr;
+}
+
+Tile& Tile::operator=(Tile&& tile) {
+  if (this != &tile) {
+    if (owns_buff_)
+      delete buffer_;
+
+    buffer_ = tile.buffer_;
+    cached_object_ = std::move(tile.cached_object_);
+    cell_size_ = tile.cell_size_;
+    compressor_ = tile.compressor_;
+    compression_level_ = tile.compression_level_;
+    dim_num_ = tile.dim_num_;
+    owns_buff_ = tile.owns_buff_;
+    shuffle_ = tile.shuffle_;
+    dict_encode_ = tile.dict_encode_;
+    offsets_tile_ = tile.offsets_tile_;
+    type_ = tile.type_;
+    unzipped_coords_ = tile.unzipped_coords_;
+    offsets_32_ = tile.offsets_32_;
+
+    tile.buffer_ = nullptr;
+    tile.owns_buff_ = true;
+    tile.offsets_tile_ = nullptr;
+  }
+
+  return *this;
 }
 
 Tile::~Tile() {
@@ -207,6 +269,60 @@ void Tile::set_size(uint64_t size) {
   buffer_->set_size(size);
 }
 
+void Tile::set_shuffle(bool shuffle) {
+  shuffle_ = shuffle;
+}
+
+bool Tile::shuffle() const {
+  return shuffle_;
+}
+
+void Tile::set_dict_encode(bool dict_encode) {
+  dict_encode_ = dict_encode;
+}
+
+bool Tile::dict_encode() const {
+  return dict_encode_;
+}
+
+void Tile::set_offsets_32(bool offsets_32) {
+  offsets_32_ = offsets_32;
+}
+
+bool Tile::offsets_32() const {
+  return offsets_32_;
+}
+
+Status Tile::widen_offsets() {
+  assert(offsets_32_);
+
+  // Expand the offsets in place, backwards, so that reads never overtake
+  // writes
+  uint64_t offsets_num = buffer_->size() / sizeof(uint32_t);
+  RETURN_NOT_OK(
+      buffer_->realloc(offsets_num * constants::cell_var_offset_size));
+  auto data_32 = (const uint32_t*)buffer_->data();
+  auto data_64 = (uint64_t*)buffer_->data();
+  for (uint64_t i = offsets_num; i > 0; --i)
+    data_64[i - 1] = data_32[i - 1];
+  buffer_->set_size(offsets_num * constants::cell_var_offset_size);
+  buffer_->reset_offset();
+
+  cell_size_ = constants::cell_var_offset_size;
+  type_ = constants::cell_var_offset_type;
+  offsets_32_ = false;
+
+  return Status::Ok();
+}
+
+void Tile::set_offsets_tile(Tile* offsets_tile) {
+  offsets_tile_ = offsets_tile;
+}
+
+Tile* Tile::offsets_tile() const {
+  return offsets_tile_;
+}
+
 uint64_t Tile::size() const {
   return buffer_->size();
 }
@@ -236,12 +352,22 @@ void Tile::split_coordinates() {
 
   // Clean up
   std::free((void*)tile_tmp);
+
+  unzipped_coords_ = true;
 }
 
 bool Tile::stores_coords() const {
   return dim_num_ > 0;
 }
 
+bool Tile::unzipped_coords() const {
+  return unzipped_coords_;
+}
+
+void Tile::set_unzipped_coords(bool unzipped) {
+  unzipped_coords_ = unzipped;
+}
+
 Datatype Tile::type() const {
   return type_;
 }
@@ -264,6 +390,32 @@ Status Tile::write_with_shift(ConstBuffer* buf, uint64_t offset) {
   return Status::Ok();
 }
 
+Status Tile::wrap_cached(std::shared_ptr<void> object, uint64_t size) {
+  if (owns_buff_)
+    delete buffer_;
+
+  cached_object_ = std::move(object);
+  buffer_ = new Buffer(cached_object_.get(), size, false);
+  if (buffer_ == nullptr)
+    return LOG_STATUS(Status::TileError(
+        "Cannot wrap cached object; Buffer allocation failed"));
+  owns_buff_ = true;
+
+  // Compressed coordinate tiles are cached in the unzipped layout they
+  // decompress into; uncompressed ones hold the raw (zipped) file bytes
+  unzipped_coords_ =
+      stores_coords() && compressor_ != Compressor::NO_COMPRESSION;
+
+  // Offsets tiles are always cached in the widened 64-bit format
+  if (offsets_32_) {
+    cell_size_ = constants::cell_var_offset_size;
+    type_ = constants::cell_var_offset_type;
+    offsets_32_ = false;
+  }
+
+  return Status::Ok();
+}
+
 void Tile::zip_coordinates() {
   assert(dim_num_ > 0);
 
@@ -290,6 +442,8 @@ void Tile::zip_coordinates() {
 
   // Clean up
   std::free((void*)tile_tmp);
+
+  unzipped_coords_ = false;
 }
 
 /* ****************************** */
@@ -39,6 +39,7 @@
 #include "tiledb/sm/misc/status.h"
 
 #include <cinttypes>
+#include <memory>
 
 namespace tiledb {
 namespace sm {
@@ -90,6 +91,18 @@ class Tile {
       Buffer* buff,
       bool owns_buff);
 
+  /**
+   * Move constructor. Steals the buffer of `tile` (a pointer swap, so
+   * moving a tile never copies tile data). `tile` is left empty.
+   */
+  Tile(Tile&& tile);
+
+  /** Move assignment. See the move constructor. */
+  Tile& operator=(Tile&& tile);
+
+  Tile(const Tile&) = delete;
+  Tile& operator=(const Tile&) = delete;
+
   /** Destructor. */
   ~Tile();
 
@@ -194,6 +207,57 @@ class Tile {
   /** Sets the internal buffer size. */
   void set_size(uint64_t size);
 
+  /** Sets whether the tile data are byte-shuffled before compression. */
+  void set_shuffle(bool shuffle);
+
+  /**
+   * Returns `true` if the tile data are byte-shuffled before compression.
+   */
+  bool shuffle() const;
+
+  /**
+   * Sets whether the tile data are dictionary-encoded before compression.
+   */
+  void set_dict_encode(bool dict_encode);
+
+  /**
+   * Returns `true` if the tile data are dictionary-encoded before
+   * compression.
+   */
+  bool dict_encode() const;
+
+  /**
+   * Sets whether the tile holds cell offsets that are stored as 32-bit
+   * values on disk.
+   */
+  void set_offsets_32(bool offsets_32);
+
+  /**
+   * Returns `true` if the tile holds cell offsets that are stored as
+   * 32-bit values on disk.
+   */
+  bool offsets_32() const;
+
+  /**
+   * Widens the 32-bit offsets the tile holds (as filled from disk) to
+   * the in-memory 64-bit offset format, in place. The widened offsets
+   * start at 0 for each tile.
+   *
+   * @return Status
+   */
+  Status widen_offsets();
+
+  /**
+   * Sets the companion tile that holds the offsets delimiting the
+   * variable-sized values of this tile, used for dictionary encoding.
+   * The caller must keep the offsets tile alive while this tile is
+   * being written.
+   */
+  void set_offsets_tile(Tile* offsets_tile);
+
+  /** Returns the companion offsets tile, or `nullptr` if not set. */
+  Tile* offsets_tile() const;
+
   /** Returns the tile size. */
   uint64_t size() const;
 
@@ -206,6 +270,16 @@ class Tile {
   /** Returns *true* if the tile stores coordinates. */
   bool stores_coords() const;
 
+  /**
+   * Returns *true* if the tile stores coordinates in the unzipped
+   * (split) layout, where all the values of each dimension appear
+   * contiguously in the buffer.
+   */
+  bool unzipped_coords() const;
+
+  /** Sets whether the tile stores coordinates in the unzipped layout. */
+  void set_unzipped_coords(bool unzipped);
+
   /** Returns the tile data type. */
   Datatype type() const;
 
@@ -238,6 +312,19 @@ class Tile {
    */
   Status write_with_shift(ConstBuffer* buf, uint64_t offset);
 
+  /**
+   * Makes the tile reference the input cached object without copying its
+   * contents. The tile shares ownership of the object, keeping it alive
+   * for the tile's lifetime even if the object gets evicted from the
+   * cache. The tile data must not be modified through the tile after
+   * this call.
+   *
+   * @param object The cached object to be wrapped.
+   * @param size The size of the cached object.
+   * @return Status
+   */
+  Status wrap_cached(std::shared_ptr<void> object, uint64_t size);
+
   /**
    * Zips the coordinate values such that a cell's coordinates across
    * all dimensions appear contiguously in the buffer.
@@ -252,6 +339,12 @@ class Tile {
   /** Local buffer that stores the tile data. */
   Buffer* buffer_;
 
+  /**
+   * The cached object the tile data may reference (shared ownership
+   * keeps it alive). Set only by `wrap_cached`.
+   */
+  std::shared_ptr<void> cached_object_;
+
   /** The cell size. */
   uint64_t cell_size_;
 
@@ -273,9 +366,37 @@ class Tile {
    */
   bool owns_buff_;
 
+  /** If *true*, the tile data are byte-shuffled before compression. */
+  bool shuffle_;
+
+  /** If *true*, the tile data are dictionary-encoded before compression. */
+  bool dict_encode_;
+
+  /**
+   * The companion tile holding the offsets that delimit the
+   * variable-sized values of this tile (not owned). Used for dictionary
+   * encoding.
+   */
+  Tile* offsets_tile_;
+
   /** The tile data type. */
   Datatype type_;
 
+  /**
+   * If *true*, the tile stores coordinates in the unzipped (split)
+   * layout, where all the values of each dimension appear contiguously
+   * in the buffer. This is the layout compressed coordinate tiles
+   * decompress into, and the layout they are cached in.
+   */
+  bool unzipped_coords_;
+
+  /**
+   * If *true*, the tile holds cell offsets of a variable-sized attribute
+   * that are stored as 32-bit values on disk. The flag is cleared once
+   * the offsets get widened to the in-memory 64-bit format.
+   */
+  bool offsets_32_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
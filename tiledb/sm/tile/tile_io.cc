@@ -34,11 +34,14 @@
 #include "tiledb/sm/compressors/blosc_compressor.h"
 #include "tiledb/sm/compressors/bzip_compressor.h"
 #include "tiledb/sm/compressors/dd_compressor.h"
+#include "tiledb/sm/compressors/dict_compressor.h"
 #include "tiledb/sm/compressors/gzip_compressor.h"
 #include "tiledb/sm/compressors/lz4_compressor.h"
 #include "tiledb/sm/compressors/rle_compressor.h"
 #include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/misc/crc32c.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/trace.h"
 
 /* ****************************** */
 /*             MACROS             */
@@ -55,6 +58,7 @@ namespace sm {
 
 TileIO::TileIO() {
   buffer_ = nullptr;
+  cache_hint_ = CacheHint::CACHE_DEFAULT;
   file_size_ = 0;
   storage_manager_ = nullptr;
   uri_ = URI("");
@@ -63,8 +67,9 @@ TileIO::TileIO() {
 TileIO::TileIO(StorageManager* storage_manager, const URI& uri)
     : storage_manager_(storage_manager)
     , uri_(uri) {
+  cache_hint_ = CacheHint::CACHE_DEFAULT;
   file_size_ = 0;
-  buffer_ = new Buffer();
+  buffer_ = storage_manager_->buffer_pool()->checkout();
 }
 
 TileIO::TileIO(
@@ -72,11 +77,15 @@ TileIO::TileIO(
     : file_size_(file_size)
     , storage_manager_(storage_manager)
     , uri_(uri) {
-  buffer_ = new Buffer();
+  cache_hint_ = CacheHint::CACHE_DEFAULT;
+  buffer_ = storage_manager_->buffer_pool()->checkout();
 }
 
 TileIO::~TileIO() {
-  delete buffer_;
+  if (storage_manager_ != nullptr)
+    storage_manager_->buffer_pool()->release(buffer_);
+  else
+    delete buffer_;
 }
 
 /* ****************************** */
@@ -87,48 +96,465 @@ uint64_t TileIO::file_size() const {
   return file_size_;
 }
 
+void TileIO::set_cache_hint(CacheHint hint) {
+  cache_hint_ = hint;
+}
+
+const URI& TileIO::uri() const {
+  return uri_;
+}
+
 Status TileIO::read(
     Tile* tile,
     uint64_t file_offset,
     uint64_t compressed_size,
     uint64_t tile_size) {
-  // Try to read from cache
-  bool in_cache;
-  RETURN_NOT_OK(storage_manager_->read_from_cache(
-      uri_, file_offset, tile->buffer(), tile_size, &in_cache));
+  TRACE_SCOPED_SPAN("tileio_read");
+
+  // When the tile cache operates on compressed tiles, the compressed
+  // bytes are looked up and stored instead of the decompressed tile
+  bool cache_compressed = storage_manager_->tile_cache_compressed() &&
+                          tile->compressor() != Compressor::NO_COMPRESSION;
+
+  bool in_cache = false;
+  if (cache_compressed) {
+    RETURN_NOT_OK(storage_manager_->read_from_cache(
+        uri_, file_offset, buffer_, compressed_size, &in_cache));
+  } else {
+    // Try to read from cache, sharing the cached object without copying
+    std::shared_ptr<void> cached_object;
+    uint64_t cached_size;
+    RETURN_NOT_OK(storage_manager_->read_shared_from_cache(
+        uri_, file_offset, &cached_object, &cached_size, &in_cache));
+    if (in_cache)
+      return tile->wrap_cached(cached_object, cached_size);
+  }
+
+  // The compressed bytes were found in the cache - only the
+  // decompression remains, which requires no coordination
   if (in_cache)
-    return Status::Ok();
+    return read_miss(tile, file_offset, compressed_size, tile_size, true);
+
+  // Single-flight: collapse concurrent fetches of the same tile into a
+  // single backend read - the first requester fetches and caches the
+  // tile, while the rest wait on the in-flight entry and are then
+  // served from the cache
+  if (!storage_manager_->tile_fetch_begin(uri_, file_offset)) {
+    // The in-flight fetch completed - re-check the cache
+    if (cache_compressed) {
+      RETURN_NOT_OK(storage_manager_->read_from_cache(
+          uri_, file_offset, buffer_, compressed_size, &in_cache));
+    } else {
+      std::shared_ptr<void> cached_object;
+      uint64_t cached_size;
+      RETURN_NOT_OK(storage_manager_->read_shared_from_cache(
+          uri_, file_offset, &cached_object, &cached_size, &in_cache));
+      if (in_cache)
+        return tile->wrap_cached(cached_object, cached_size);
+    }
+    // Upon a miss (the fetch failed or the tile was evicted or not
+    // cacheable), fetch the tile without further coordination
+    return read_miss(tile, file_offset, compressed_size, tile_size, in_cache);
+  }
+
+  auto st = read_miss(tile, file_offset, compressed_size, tile_size, false);
+  storage_manager_->tile_fetch_end(uri_, file_offset);
+  return st;
+}
+
+Status TileIO::read_miss(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t compressed_size,
+    uint64_t tile_size,
+    bool in_cache) {
+  bool cache_compressed = storage_manager_->tile_cache_compressed() &&
+                          tile->compressor() != Compressor::NO_COMPRESSION;
+
+  // 32-bit offsets tiles occupy half their in-memory size on disk
+  uint64_t persisted_size = (tile->offsets_32()) ? tile_size / 2 : tile_size;
 
   // No compression
   if (tile->compressor() == Compressor::NO_COMPRESSION) {
-    RETURN_NOT_OK(
-        storage_manager_->read(uri_, file_offset, tile->buffer(), tile_size));
+    // Zero-copy path (see `vfs.map_reads`): wrap the page-cache memory
+    // of the mapped file region directly instead of copying through a
+    // read. Mapped tiles skip the tile cache, which the page cache
+    // substitutes for. 32-bit offsets tiles are excluded, as widening
+    // the offsets requires an owned, mutable buffer. A mapping failure
+    // falls back to the copying read.
+    auto vfs = storage_manager_->vfs();
+    if (!tile->offsets_32() && vfs->supports_map(uri_)) {
+      void* mapped;
+      if (vfs->map(uri_, file_offset, persisted_size, &mapped).ok()) {
+        uint64_t mapped_size = persisted_size;
+        std::shared_ptr<void> object(mapped, [vfs, mapped_size](void* p) {
+          vfs->unmap(p, mapped_size);
+        });
+        return tile->wrap_cached(object, persisted_size);
+      }
+    }
+    RETURN_NOT_OK(storage_manager_->read(
+        uri_, file_offset, tile->buffer(), persisted_size));
   } else {  // Compression
-    RETURN_NOT_OK(
-        storage_manager_->read(uri_, file_offset, buffer_, compressed_size));
+    if (!in_cache) {
+      RETURN_NOT_OK(
+          storage_manager_->read(uri_, file_offset, buffer_, compressed_size));
+      if (cache_compressed)
+        RETURN_NOT_OK(storage_manager_->write_to_cache(
+            uri_, file_offset, buffer_, cache_hint_));
+    }
 
     // Decompress tile
     tile->reset_offset();
     tile->reset_size();
     buffer_->reset_offset();
     RETURN_NOT_OK(tile->realloc(tile_size));
-    RETURN_NOT_OK(decompress_tile(tile));
+    RETURN_NOT_OK(decompress_tile(
+        tile, buffer_, storage_manager_->compute_thread_pool()));
     tile->reset_offset();
   }
 
+  // Widen the offsets to the in-memory 64-bit format before caching
+  if (tile->offsets_32())
+    RETURN_NOT_OK(tile->widen_offsets());
+
+  // In the compressed caching mode the compressed bytes are already
+  // cached above
+  if (cache_compressed)
+    return Status::Ok();
+
   // Store tile in cache
-  return (storage_manager_->write_to_cache(uri_, file_offset, tile->buffer()));
+  return (storage_manager_->write_to_cache(
+      uri_, file_offset, tile->buffer(), cache_hint_));
+}
+
+Status TileIO::read_compressed(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t compressed_size,
+    uint64_t tile_size,
+    Buffer* compressed,
+    bool* decompress,
+    QueryStats* stats) {
+  *decompress = false;
+  TRACE_SCOPED_SPAN("tileio_read_compressed");
+  QueryStatsTimer timer((stats != nullptr) ? &stats->io_ns_ : nullptr);
+  if (stats != nullptr)
+    stats->tiles_fetched_++;
+
+  // When the tile cache operates on compressed tiles, the compressed
+  // bytes are looked up and stored instead of the decompressed tile
+  bool cache_compressed = storage_manager_->tile_cache_compressed() &&
+                          tile->compressor() != Compressor::NO_COMPRESSION;
+
+  bool in_cache = false;
+  if (cache_compressed) {
+    RETURN_NOT_OK(storage_manager_->read_from_cache(
+        uri_, file_offset, compressed, compressed_size, &in_cache));
+  } else {
+    // Try to read from cache, sharing the cached object without copying
+    std::shared_ptr<void> cached_object;
+    uint64_t cached_size;
+    RETURN_NOT_OK(storage_manager_->read_shared_from_cache(
+        uri_, file_offset, &cached_object, &cached_size, &in_cache));
+    if (in_cache) {
+      if (stats != nullptr)
+        stats->cache_hits_++;
+      return tile->wrap_cached(cached_object, cached_size);
+    }
+  }
+  if (stats != nullptr) {
+    if (in_cache)
+      stats->cache_hits_++;
+    else
+      stats->cache_misses_++;
+  }
+
+  // The cached compressed bytes still require decompression by the caller
+  if (in_cache) {
+    *decompress = true;
+    return Status::Ok();
+  }
+
+  // Single-flight: collapse concurrent fetches of the same tile into a
+  // single backend read - the first requester fetches the tile, while
+  // the rest wait on the in-flight entry and re-check the cache
+  if (!storage_manager_->tile_fetch_begin(uri_, file_offset)) {
+    if (cache_compressed) {
+      RETURN_NOT_OK(storage_manager_->read_from_cache(
+          uri_, file_offset, compressed, compressed_size, &in_cache));
+      if (in_cache) {
+        *decompress = true;
+        return Status::Ok();
+      }
+    } else {
+      std::shared_ptr<void> cached_object;
+      uint64_t cached_size;
+      RETURN_NOT_OK(storage_manager_->read_shared_from_cache(
+          uri_, file_offset, &cached_object, &cached_size, &in_cache));
+      if (in_cache)
+        return tile->wrap_cached(cached_object, cached_size);
+    }
+    // Upon a miss (the fetch failed or the tile was evicted or not
+    // cacheable), fetch the tile without further coordination
+    return read_compressed_miss(
+        tile,
+        file_offset,
+        compressed_size,
+        tile_size,
+        compressed,
+        decompress,
+        stats);
+  }
+
+  auto st = read_compressed_miss(
+      tile,
+      file_offset,
+      compressed_size,
+      tile_size,
+      compressed,
+      decompress,
+      stats);
+  storage_manager_->tile_fetch_end(uri_, file_offset);
+  return st;
+}
+
+Status TileIO::read_compressed_miss(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t compressed_size,
+    uint64_t tile_size,
+    Buffer* compressed,
+    bool* decompress,
+    QueryStats* stats) {
+  bool cache_compressed = storage_manager_->tile_cache_compressed() &&
+                          tile->compressor() != Compressor::NO_COMPRESSION;
+
+  // No compression - read directly into the tile. Note that 32-bit
+  // offsets tiles occupy half their in-memory size on disk.
+  if (tile->compressor() == Compressor::NO_COMPRESSION) {
+    uint64_t persisted_size = (tile->offsets_32()) ? tile_size / 2 : tile_size;
+
+    // Zero-copy mapped read, as in `read_miss`
+    auto vfs = storage_manager_->vfs();
+    if (!tile->offsets_32() && vfs->supports_map(uri_)) {
+      void* mapped;
+      if (vfs->map(uri_, file_offset, persisted_size, &mapped).ok()) {
+        uint64_t mapped_size = persisted_size;
+        std::shared_ptr<void> object(mapped, [vfs, mapped_size](void* p) {
+          vfs->unmap(p, mapped_size);
+        });
+        if (stats != nullptr)
+          stats->bytes_read_ += persisted_size;
+        return tile->wrap_cached(object, persisted_size);
+      }
+    }
+
+    RETURN_NOT_OK(storage_manager_->read(
+        uri_, file_offset, tile->buffer(), persisted_size));
+    if (stats != nullptr)
+      stats->bytes_read_ += persisted_size;
+
+    // Widen the offsets to the in-memory 64-bit format before caching
+    if (tile->offsets_32())
+      RETURN_NOT_OK(tile->widen_offsets());
+    return storage_manager_->write_to_cache(
+        uri_, file_offset, tile->buffer(), cache_hint_);
+  }
+
+  // Compression - read the compressed bytes; the caller will decompress
+  RETURN_NOT_OK(
+      storage_manager_->read(uri_, file_offset, compressed, compressed_size));
+  if (stats != nullptr)
+    stats->bytes_read_ += compressed_size;
+  if (cache_compressed)
+    RETURN_NOT_OK(storage_manager_->write_to_cache(
+        uri_, file_offset, compressed, cache_hint_));
+  *decompress = true;
+
+  return Status::Ok();
+}
+
+Status TileIO::read_prefetched(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t tile_size,
+    Buffer* compressed,
+    bool* decompress,
+    QueryStats* stats) {
+  *decompress = false;
+  if (stats != nullptr) {
+    stats->tiles_fetched_++;
+    stats->cache_misses_++;
+  }
+
+  bool cache_compressed = storage_manager_->tile_cache_compressed() &&
+                          tile->compressor() != Compressor::NO_COMPRESSION;
+
+  // No compression - copy the prefetched bytes into the tile. Note that
+  // 32-bit offsets tiles occupy half their in-memory size on disk.
+  if (tile->compressor() == Compressor::NO_COMPRESSION) {
+    uint64_t persisted_size = (tile->offsets_32()) ? tile_size / 2 : tile_size;
+    auto buff = tile->buffer();
+    RETURN_NOT_OK(buff->realloc(persisted_size));
+    std::memcpy(buff->data(), compressed->data(), persisted_size);
+    buff->set_size(persisted_size);
+    buff->reset_offset();
+    if (stats != nullptr)
+      stats->bytes_read_ += persisted_size;
+
+    // Widen the offsets to the in-memory 64-bit format before caching
+    if (tile->offsets_32())
+      RETURN_NOT_OK(tile->widen_offsets());
+    return storage_manager_->write_to_cache(
+        uri_, file_offset, tile->buffer(), cache_hint_);
+  }
+
+  // Compression - the caller will decompress the prefetched bytes
+  if (stats != nullptr)
+    stats->bytes_read_ += compressed->size();
+  if (cache_compressed)
+    RETURN_NOT_OK(storage_manager_->write_to_cache(
+        uri_, file_offset, compressed, cache_hint_));
+  *decompress = true;
+
+  return Status::Ok();
+}
+
+std::future<Status> TileIO::read_compressed_async(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t compressed_size,
+    uint64_t tile_size,
+    Buffer* compressed,
+    bool* decompress,
+    QueryStats* stats) {
+  return storage_manager_->io_thread_pool()->enqueue(
+      [this,
+       tile,
+       file_offset,
+       compressed_size,
+       tile_size,
+       compressed,
+       decompress,
+       stats]() {
+        return read_compressed(
+            tile,
+            file_offset,
+            compressed_size,
+            tile_size,
+            compressed,
+            decompress,
+            stats);
+      });
+}
+
+Status TileIO::decompress_and_cache(
+    Tile* tile,
+    uint64_t file_offset,
+    uint64_t tile_size,
+    Buffer* compressed,
+    QueryStats* stats) {
+  TRACE_SCOPED_SPAN("tileio_decompress_and_cache");
+  QueryStatsTimer timer((stats != nullptr) ? &stats->decompress_ns_ : nullptr);
+  // Decompress tile
+  tile->reset_offset();
+  tile->reset_size();
+  compressed->reset_offset();
+  RETURN_NOT_OK(tile->realloc(tile_size));
+  // This function runs as a task on the compute thread pool, but nesting
+  // a parallel region on the same pool is safe - waiting threads execute
+  // pending tasks instead of blocking
+  RETURN_NOT_OK(decompress_tile(
+      tile, compressed, storage_manager_->compute_thread_pool()));
+  tile->reset_offset();
+
+  // Widen the offsets to the in-memory 64-bit format before caching
+  if (tile->offsets_32())
+    RETURN_NOT_OK(tile->widen_offsets());
+
+  // In the compressed caching mode the compressed bytes were already
+  // cached by `read_compressed`
+  if (storage_manager_->tile_cache_compressed() &&
+      tile->compressor() != Compressor::NO_COMPRESSION)
+    return Status::Ok();
+
+  // Store tile in cache
+  return (storage_manager_->write_to_cache(
+      uri_, file_offset, tile->buffer(), cache_hint_));
 }
 
 Status TileIO::read_generic(Tile** tile, uint64_t file_offset) {
   uint64_t tile_size;
   uint64_t compressed_size;
-  uint64_t header_size;
+  uint64_t header_size = 3 * sizeof(uint64_t) + 2 * sizeof(char) + sizeof(int);
+
+  // Speculatively read the header together with a prefix of the tile
+  // body in a single request. Generic tiles hold metadata objects that
+  // typically fit in the prefix, in which case the dependent second
+  // round trip (costly on remote backends) is skipped altogether.
+  uint64_t prefix_size =
+      storage_manager_->config().sm_params().generic_tile_prefix_size_;
+  uint64_t nbytes_read;
+  RETURN_NOT_OK(storage_manager_->read_at_most(
+      uri_, file_offset, buffer_, header_size + prefix_size, &nbytes_read));
+  if (nbytes_read < header_size)
+    return LOG_STATUS(Status::TileIOError(
+        "Cannot read generic tile; File is too small to hold a tile header"));
+
+  RETURN_NOT_OK(parse_generic_tile_header(
+      buffer_, tile, &tile_size, &compressed_size, &header_size));
+
+  // The tile body exceeds the prefix - issue the follow-up read through
+  // the regular path
+  if (compressed_size > nbytes_read - header_size) {
+    RETURN_NOT_OK_ELSE(
+        read(*tile, file_offset + header_size, compressed_size, tile_size),
+        delete *tile);
+    return Status::Ok();
+  }
+
+  // The entire tile body is already in the speculative buffer, right
+  // after the header (where `buffer_`'s offset was left by the parsing)
+  auto tile_offset = file_offset + header_size;
+
+  // Try to read from cache, sharing the cached object without copying
+  bool in_cache;
+  std::shared_ptr<void> cached_object;
+  uint64_t cached_size;
+  RETURN_NOT_OK_ELSE(
+      storage_manager_->read_shared_from_cache(
+          uri_, tile_offset, &cached_object, &cached_size, &in_cache),
+      delete *tile);
+  if (in_cache) {
+    RETURN_NOT_OK_ELSE(
+        (*tile)->wrap_cached(cached_object, cached_size), delete *tile);
+    return Status::Ok();
+  }
 
-  RETURN_NOT_OK(read_generic_tile_header(
-      tile, file_offset, &tile_size, &compressed_size, &header_size));
+  Status st;
+  if ((*tile)->compressor() == Compressor::NO_COMPRESSION) {
+    st = (*tile)->buffer()->write(buffer_->cur_data(), tile_size);
+    (*tile)->reset_offset();
+  } else {
+    // Decompress tile
+    (*tile)->reset_offset();
+    (*tile)->reset_size();
+    st = (*tile)->realloc(tile_size);
+    if (st.ok())
+      st = decompress_tile(
+          *tile, buffer_, storage_manager_->compute_thread_pool());
+    (*tile)->reset_offset();
+  }
+  if (!st.ok()) {
+    delete *tile;
+    return st;
+  }
+
+  // Store tile in cache
   RETURN_NOT_OK_ELSE(
-      read(*tile, file_offset + header_size, compressed_size, tile_size),
+      storage_manager_->write_to_cache(
+          uri_, tile_offset, (*tile)->buffer(), cache_hint_),
       delete *tile);
 
   return Status::Ok();
@@ -140,12 +566,7 @@ Status TileIO::read_generic_tile_header(
     uint64_t* tile_size,
     uint64_t* compressed_size,
     uint64_t* header_size) {
-  // Initializations
   *header_size = 3 * sizeof(uint64_t) + 2 * sizeof(char) + sizeof(int);
-  char datatype;
-  uint64_t cell_size;
-  char compressor;
-  int compression_level;
 
   // Read header from file
   auto header_buff = new Buffer();
@@ -153,26 +574,38 @@ Status TileIO::read_generic_tile_header(
       storage_manager_->read(uri_, file_offset, header_buff, *header_size),
       delete header_buff);
 
-  // Read header individual values
-  RETURN_NOT_OK_ELSE(
-      header_buff->read(compressed_size, sizeof(uint64_t)), delete header_buff);
-  RETURN_NOT_OK_ELSE(
-      header_buff->read(tile_size, sizeof(uint64_t)), delete header_buff);
-  RETURN_NOT_OK_ELSE(
-      header_buff->read(&datatype, sizeof(char)), delete header_buff);
-  RETURN_NOT_OK_ELSE(
-      header_buff->read(&cell_size, sizeof(uint64_t)), delete header_buff);
-  RETURN_NOT_OK_ELSE(
-      header_buff->read(&compressor, sizeof(char)), delete header_buff);
-  RETURN_NOT_OK_ELSE(
-      header_buff->read(&compression_level, sizeof(int)), delete header_buff);
-
+  Status st = parse_generic_tile_header(
+      header_buff, tile, tile_size, compressed_size, header_size);
   delete header_buff;
 
+  return st;
+}
+
+Status TileIO::parse_generic_tile_header(
+    Buffer* header_buff,
+    Tile** tile,
+    uint64_t* tile_size,
+    uint64_t* compressed_size,
+    uint64_t* header_size) {
+  // Initializations
+  *header_size = 3 * sizeof(uint64_t) + 2 * sizeof(char) + sizeof(int);
+  char datatype;
+  uint64_t cell_size;
+  char compressor;
+  int compression_level;
+
+  // Read header individual values
+  RETURN_NOT_OK(header_buff->read(compressed_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(header_buff->read(tile_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(header_buff->read(&datatype, sizeof(char)));
+  RETURN_NOT_OK(header_buff->read(&cell_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(header_buff->read(&compressor, sizeof(char)));
+  RETURN_NOT_OK(header_buff->read(&compression_level, sizeof(int)));
+
   *tile = new Tile();
   RETURN_NOT_OK_ELSE(
       (*tile)->init((Datatype)datatype, (Compressor)compressor, cell_size, 0),
-      delete tile);
+      delete *tile);
 
   return Status::Ok();
 }
@@ -183,6 +616,15 @@ Status TileIO::write(Tile* tile, uint64_t* bytes_written) {
   buffer_->reset_size();
   buffer_->reset_offset();
 
+  // Narrow the offsets of 32-bit offsets tiles into a scratch tile,
+  // leaving the in-memory 64-bit offsets intact
+  Buffer narrow_buff;
+  Tile narrow_tile;
+  if (tile->offsets_32()) {
+    RETURN_NOT_OK(narrow_offsets(tile, &narrow_buff, &narrow_tile));
+    tile = &narrow_tile;
+  }
+
   // Compress tile
   Compressor compressor = tile->compressor();
   if (compressor != Compressor::NO_COMPRESSION)
@@ -212,13 +654,23 @@ Status TileIO::write_generic(Tile* tile) {
   auto buffer =
       (compressor == Compressor::NO_COMPRESSION) ? tile->buffer() : buffer_;
 
-  RETURN_NOT_OK(write_generic_tile_header(tile, buffer->size()));
-  RETURN_NOT_OK(storage_manager_->write(uri_, buffer));
+  // Assemble the header and the (potentially compressed) tile into a
+  // single buffer and commit it with one write, so that the file
+  // becomes visible with a single PUT on S3 (e.g., a fragment metadata
+  // commit that readers poll for)
+  auto blob = new Buffer();
+  Status st = write_generic_tile_header(tile, buffer->size(), blob);
+  if (st.ok())
+    st = blob->write(buffer->data(), buffer->size());
+  if (st.ok())
+    st = storage_manager_->write(uri_, blob);
+  delete blob;
 
-  return Status::Ok();
+  return st;
 }
 
-Status TileIO::write_generic_tile_header(Tile* tile, uint64_t compressed_size) {
+Status TileIO::write_generic_tile_header(
+    Tile* tile, uint64_t compressed_size, Buffer* buff) {
   // Initializations
   uint64_t tile_size = tile->size();
   auto datatype = (char)tile->type();
@@ -227,21 +679,14 @@ Status TileIO::write_generic_tile_header(Tile* tile, uint64_t compressed_size) {
   int compression_level = tile->compression_level();
 
   // Write to buffer
-  auto buff = new Buffer();
-  RETURN_NOT_OK_ELSE(
-      buff->write(&compressed_size, sizeof(uint64_t)), delete buff);
-  RETURN_NOT_OK_ELSE(buff->write(&tile_size, sizeof(uint64_t)), delete buff);
-  RETURN_NOT_OK_ELSE(buff->write(&datatype, sizeof(char)), delete buff);
-  RETURN_NOT_OK_ELSE(buff->write(&cell_size, sizeof(uint64_t)), delete buff);
-  RETURN_NOT_OK_ELSE(buff->write(&compressor, sizeof(char)), delete buff);
-  RETURN_NOT_OK_ELSE(buff->write(&compression_level, sizeof(int)), delete buff);
-
-  // Write to file
-  Status st = storage_manager_->write(uri_, buff);
-
-  delete buff;
+  RETURN_NOT_OK(buff->write(&compressed_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff->write(&tile_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff->write(&datatype, sizeof(char)));
+  RETURN_NOT_OK(buff->write(&cell_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff->write(&compressor, sizeof(char)));
+  RETURN_NOT_OK(buff->write(&compression_level, sizeof(int)));
 
-  return st;
+  return Status::Ok();
 }
 
 /* ****************************** */
@@ -290,117 +735,207 @@ Status TileIO::compress_one_tile(Tile* tile) {
   auto cell_size = tile->cell_size();
   auto tile_size = tile->size();
 
+  // Dictionary-encode the cell values before chunking, if requested.
+  // The encoding is skipped when it does not shrink the tile.
+  Buffer dict_buff;
+  bool dict = false;
+  if (tile->dict_encode() && tile->offsets_tile() != nullptr &&
+      tile_size > 0) {
+    auto offsets_tile = tile->offsets_tile();
+    auto offsets = (const uint64_t*)offsets_tile->data();
+    auto offsets_num = offsets_tile->size() / constants::cell_var_offset_size;
+    ConstBuffer values(tile->data(), tile_size);
+    RETURN_NOT_OK(
+        DictEncoder::compress(offsets, offsets_num, &values, &dict_buff));
+    dict = (dict_buff.size() < tile_size);
+  }
+  auto input_size = (dict) ? dict_buff.size() : tile_size;
+
   // Compute necessary info for chunking
-  uint64_t chunk_num, max_chunk_size, overhead;
-  RETURN_NOT_OK(
-      compute_chunking_info(tile, &chunk_num, &max_chunk_size, &overhead));
+  uint64_t chunk_num, max_chunk_size, total_overhead;
+  RETURN_NOT_OK(compute_chunking_info(
+      tile,
+      input_size,
+      (dict) ? 1 : cell_size,
+      &chunk_num,
+      &max_chunk_size,
+      &total_overhead));
+
+  // Compress the chunks concurrently, each into its own buffer. The
+  // chunked format renders the chunks independent.
+  auto checksums = storage_manager_->config().sm_params().enable_checksums_;
+  auto shuffle = tile->shuffle() && type_size > 1 && !dict;
+  auto thread_pool = storage_manager_->compute_thread_pool();
+  std::vector<uint64_t> chunk_sizes(chunk_num);
+  std::vector<uint32_t> chunk_checksums(chunk_num, 0);
+  std::vector<Buffer*> chunk_buffers(chunk_num, nullptr);
+  std::vector<std::future<Status>> tasks;
+  Status st = Status::Ok();
+  uint64_t left_to_compress = input_size;
+  uint64_t input_offset = 0;
+  for (uint64_t i = 0; i < chunk_num; ++i) {
+    auto chunk_size = MIN(left_to_compress, max_chunk_size);
+    chunk_sizes[i] = chunk_size;
+
+    // The compressors do not expand the output buffer - allocate the
+    // chunk size plus the compression overhead upfront
+    chunk_buffers[i] = new Buffer();
+    st = chunk_buffers[i]->realloc(chunk_size + overhead(tile, chunk_size));
+    if (!st.ok())
+      break;
+
+    auto chunk_data = (dict) ? (void*)((char*)dict_buff.data() + input_offset) :
+                               tile->cur_data();
+    auto chunk_buffer = chunk_buffers[i];
+    auto chunk_checksum = &chunk_checksums[i];
+    tasks.push_back(thread_pool->enqueue([compressor,
+                                          level,
+                                          type,
+                                          type_size,
+                                          cell_size,
+                                          chunk_data,
+                                          chunk_size,
+                                          chunk_buffer,
+                                          checksums,
+                                          shuffle,
+                                          chunk_checksum]() {
+      // Shuffle the chunk into a scratch buffer before compressing it
+      std::vector<char> scratch;
+      auto input_data = chunk_data;
+      if (shuffle) {
+        scratch.resize(chunk_size);
+        TileIO::shuffle(chunk_data, &scratch[0], chunk_size, type_size);
+        input_data = &scratch[0];
+      }
+
+      ConstBuffer input(input_data, chunk_size);
+      RETURN_NOT_OK(compress_chunk(
+          compressor, level, type, type_size, cell_size, &input, chunk_buffer));
+      // Checksum the compressed chunk while it is still hot in cache
+      if (checksums)
+        *chunk_checksum =
+            crc32c::checksum(chunk_buffer->data(), chunk_buffer->size());
+      return Status::Ok();
+    }));
 
-  // Properly reallocate buffer
-  RETURN_NOT_OK(buffer_->realloc(buffer_->size() + tile_size + overhead));
+    // Update
+    left_to_compress -= chunk_size;
+    if (dict)
+      input_offset += chunk_size;
+    else
+      tile->advance_offset(chunk_size);
+  }
+  if (!thread_pool->wait_all(tasks))
+    st = LOG_STATUS(
+        Status::TileIOError("Cannot compress tile; Chunk compression failed"));
+
+  // Assemble the compressed chunks in order into the on-disk format. The
+  // presence of chunk checksums is denoted by a flag on the chunk number.
+  if (st.ok())
+    st = buffer_->realloc(buffer_->size() + input_size + total_overhead);
+  if (st.ok()) {
+    uint64_t stored_chunk_num = chunk_num;
+    if (checksums)
+      stored_chunk_num |= constants::tile_checksum_flag;
+    if (shuffle)
+      stored_chunk_num |= constants::tile_shuffle_flag;
+    if (dict)
+      stored_chunk_num |= constants::tile_dict_flag;
+    st = buffer_->write(&stored_chunk_num, sizeof(uint64_t));
+  }
+  for (uint64_t i = 0; st.ok() && i < chunk_num; ++i) {
+    uint64_t compressed_chunk_size = chunk_buffers[i]->size();
+    st = buffer_->write(&chunk_sizes[i], sizeof(uint64_t));
+    if (st.ok())
+      st = buffer_->write(&compressed_chunk_size, sizeof(uint64_t));
+    if (st.ok() && checksums)
+      st = buffer_->write(&chunk_checksums[i], sizeof(uint32_t));
+    if (st.ok())
+      st = buffer_->write(chunk_buffers[i]->data(), compressed_chunk_size);
+  }
 
-  // Write number of chunks
-  RETURN_NOT_OK(buffer_->write(&chunk_num, sizeof(uint64_t)));
+  // Clean up
+  for (auto& chunk_buffer : chunk_buffers)
+    delete chunk_buffer;
+  RETURN_NOT_OK(st);
 
-  // Compress in chunks
-  Status st;
-  uint64_t compressed_chunk_size = 0;
-  uint64_t left_to_compress = tile_size;
-  for (uint64_t i = 0; i < chunk_num; ++i) {
-    // Write chunk info
-    auto chunk_size = MIN(left_to_compress, max_chunk_size);
+  assert(left_to_compress == 0);
 
-    RETURN_NOT_OK(buffer_->write(&chunk_size, sizeof(uint64_t)));
-    uint64_t buffer_offset = buffer_->offset();  // Will be used later
-    RETURN_NOT_OK(buffer_->write(&compressed_chunk_size, sizeof(uint64_t)));
-
-    // Create const buffer
-    auto input_buffer = new ConstBuffer(tile->cur_data(), chunk_size);
-
-    // Invoke the proper compressor
-    switch (compressor) {
-      case Compressor::GZIP:
-        st = GZip::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::ZSTD:
-        st = ZStd::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::LZ4:
-        st = LZ4::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::BLOSC_LZ:
-        st =
-            Blosc::compress("blosclz", type_size, level, input_buffer, buffer_);
-        break;
+  return Status::Ok();
+}
+
+Status TileIO::compress_chunk(
+    Compressor compressor,
+    int level,
+    Datatype type,
+    uint64_t type_size,
+    uint64_t cell_size,
+    ConstBuffer* input,
+    Buffer* output) {
+  // Invoke the proper compressor
+  switch (compressor) {
+    case Compressor::GZIP:
+      return GZip::compress(level, input, output);
+    case Compressor::ZSTD:
+      return ZStd::compress(level, input, output);
+    case Compressor::LZ4:
+      return LZ4::compress(level, input, output);
+    case Compressor::BLOSC_LZ:
+      return Blosc::compress("blosclz", type_size, level, input, output);
 #undef BLOSC_LZ4
-      case Compressor::BLOSC_LZ4:
-        st = Blosc::compress("lz4", type_size, level, input_buffer, buffer_);
-        break;
+    case Compressor::BLOSC_LZ4:
+      return Blosc::compress("lz4", type_size, level, input, output);
 #undef BLOSC_LZ4HC
-      case Compressor::BLOSC_LZ4HC:
-        st = Blosc::compress("lz4hc", type_size, level, input_buffer, buffer_);
-        break;
+    case Compressor::BLOSC_LZ4HC:
+      return Blosc::compress("lz4hc", type_size, level, input, output);
 #undef BLOSC_SNAPPY
-      case Compressor::BLOSC_SNAPPY:
-        st = Blosc::compress("snappy", type_size, level, input_buffer, buffer_);
-        break;
+    case Compressor::BLOSC_SNAPPY:
+      return Blosc::compress("snappy", type_size, level, input, output);
 #undef BLOSC_ZLIB
-      case Compressor::BLOSC_ZLIB:
-        st = Blosc::compress("zlib", type_size, level, input_buffer, buffer_);
-        break;
+    case Compressor::BLOSC_ZLIB:
+      return Blosc::compress("zlib", type_size, level, input, output);
 #undef BLOSC_ZSTD
-      case Compressor::BLOSC_ZSTD:
-        st = Blosc::compress("zstd", type_size, level, input_buffer, buffer_);
-        break;
-      case Compressor::RLE:
-        st = RLE::compress(cell_size, input_buffer, buffer_);
-        break;
-      case Compressor::BZIP2:
-        st = BZip::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::DOUBLE_DELTA:
-        st = DoubleDelta::compress(type, input_buffer, buffer_);
-        break;
-      default:
-        assert(0);
-    }
-
-    delete input_buffer;
-    RETURN_NOT_OK(st);
-
-    // Write compressed chunk size
-    compressed_chunk_size =
-        buffer_->size() - (buffer_offset + sizeof(uint64_t));
-    std::memcpy(
-        buffer_->data(buffer_offset), &compressed_chunk_size, sizeof(uint64_t));
-
-    // Update
-    left_to_compress -= chunk_size;
-    tile->advance_offset(chunk_size);
+    case Compressor::BLOSC_ZSTD:
+      return Blosc::compress("zstd", type_size, level, input, output);
+    case Compressor::RLE:
+      return RLE::compress(cell_size, input, output);
+    case Compressor::BZIP2:
+      return BZip::compress(level, input, output);
+    case Compressor::DOUBLE_DELTA:
+      return DoubleDelta::compress(type, input, output);
+    default:
+      assert(0);
   }
 
-  assert(left_to_compress == 0);
-
   return Status::Ok();
 }
 
 Status TileIO::compute_chunking_info(
     Tile* tile,
+    uint64_t input_size,
+    uint64_t cell_align,
     uint64_t* chunk_num,
     uint64_t* max_chunk_size,
     uint64_t* overhead) {
-  // For easy reference
-  auto cell_size = tile->cell_size();
-  auto tile_size = tile->size();
+  // The preset levels also select the chunk granularity: "archive"
+  // favors larger chunks for a better compression ratio, "fast" smaller
+  // chunks for more decompression parallelism.
+  uint64_t chunk_size = constants::tile_chunk_size;
+  auto level = tile->compression_level();
+  if (level == constants::compression_level_archive)
+    chunk_size *= 4;
+  else if (level == constants::compression_level_fast)
+    chunk_size /= 2;
 
   // Compute max chunk size
-  *max_chunk_size = MIN(constants::tile_chunk_size, tile_size);
-  *max_chunk_size = *max_chunk_size / cell_size * cell_size;
+  *max_chunk_size = MIN(chunk_size, input_size);
+  *max_chunk_size = *max_chunk_size / cell_align * cell_align;
   uint64_t chunk_overhead = this->overhead(tile, *max_chunk_size);
 
   // Adjust max chunk size
   if (*max_chunk_size + chunk_overhead > constants::tile_chunk_size) {
     *max_chunk_size -= chunk_overhead;
-    *max_chunk_size = (*max_chunk_size) / cell_size * cell_size;
+    *max_chunk_size = (*max_chunk_size) / cell_align * cell_align;
     chunk_overhead = this->overhead(tile, *max_chunk_size);
   }
 
@@ -412,8 +947,8 @@ Status TileIO::compute_chunking_info(
   }
 
   // Compute number of chunks
-  *chunk_num = tile_size / (*max_chunk_size) +
-               uint64_t(bool(tile_size % (*max_chunk_size)));
+  *chunk_num = input_size / (*max_chunk_size) +
+               uint64_t(bool(input_size % (*max_chunk_size)));
 
   // Compute overhead: equal to the compression overhead per chunk, plus 2
   // values per chunk that store the original and compressed chunk size,
@@ -421,88 +956,307 @@ Status TileIO::compute_chunking_info(
   *overhead =
       (*chunk_num) * chunk_overhead * 2 * sizeof(uint64_t) + sizeof(uint64_t);
 
+  // Account for the per-chunk checksums, if enabled
+  if (storage_manager_->config().sm_params().enable_checksums_)
+    *overhead += (*chunk_num) * sizeof(uint32_t);
+
   return Status::Ok();
 }
 
-Status TileIO::decompress_tile(Tile* tile) {
+Status TileIO::narrow_offsets(
+    Tile* tile, Buffer* narrow_buff, Tile* narrow_tile) {
+  auto offsets = (const uint64_t*)tile->data();
+  uint64_t offsets_num = tile->size() / constants::cell_var_offset_size;
+  RETURN_NOT_OK(narrow_buff->realloc(offsets_num * sizeof(uint32_t)));
+  auto narrow = (uint32_t*)narrow_buff->data();
+
+  // Rebase the offsets to start at 0, so that only the extent of the
+  // tile (and not its position in the fragment) must fit in 32 bits
+  uint64_t base = (offsets_num > 0) ? offsets[0] : 0;
+  for (uint64_t i = 0; i < offsets_num; ++i) {
+    uint64_t offset = offsets[i] - base;
+    if (offset > UINT32_MAX)
+      return LOG_STATUS(
+          Status::TileIOError("Cannot write tile; Variable-sized values "
+                              "exceed the 32-bit offsets range"));
+    narrow[i] = (uint32_t)offset;
+  }
+  narrow_buff->set_size(offsets_num * sizeof(uint32_t));
+
+  *narrow_tile = Tile(
+      Datatype::UINT32,
+      tile->compressor(),
+      tile->compression_level(),
+      sizeof(uint32_t),
+      0,
+      narrow_buff,
+      false);
+
+  return Status::Ok();
+}
+
+Status TileIO::decompress_tile(
+    Tile* tile, Buffer* compressed, ThreadPool* thread_pool) {
   // Simple case - No coordinates
   if (!tile->stores_coords())
-    return decompress_one_tile(tile);
+    return decompress_one_tile(tile, compressed, thread_pool);
 
-  // Decompress each dimension tile
+  // Decompress each dimension tile. The tile is left in the unzipped
+  // (one stream per dimension) layout; the read path consumes the
+  // dimension streams contiguously and materializes zipped views only
+  // where cell-interleaved coordinates are actually needed.
   auto dim_num = tile->dim_num();
   for (unsigned int i = 0; i < dim_num; ++i)
-    RETURN_NOT_OK(decompress_one_tile(tile));
-
-  // Zip coordinates
-  tile->zip_coordinates();
+    RETURN_NOT_OK(decompress_one_tile(tile, compressed, thread_pool));
+  tile->set_unzipped_coords(true);
 
   return Status::Ok();
 }
 
-Status TileIO::decompress_one_tile(Tile* tile) {
-  // Read number of chunks
+Status TileIO::decompress_one_tile(
+    Tile* tile, Buffer* compressed, ThreadPool* thread_pool) {
+  // Read number of chunks. Flags on the stored value denote whether
+  // the chunks carry checksums and whether they were byte-shuffled.
   uint64_t chunk_num;
 
-  RETURN_NOT_OK(buffer_->read(&chunk_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(compressed->read(&chunk_num, sizeof(uint64_t)));
+  bool checksums = (chunk_num & constants::tile_checksum_flag) != 0;
+  bool shuffled = (chunk_num & constants::tile_shuffle_flag) != 0;
+  bool dict = (chunk_num & constants::tile_dict_flag) != 0;
+  chunk_num &= ~(
+      constants::tile_checksum_flag | constants::tile_shuffle_flag |
+      constants::tile_dict_flag);
   assert(chunk_num > 0);
 
-  Status st;
-  Datatype type = tile->type();
+  // For easy reference
+  auto compressor = tile->compressor();
+  auto type = tile->type();
+  auto type_size = datatype_size(type);
+  auto cell_size = tile->cell_size();
+
+  // Dictionary-encoded tiles first decompress the chunks into a scratch
+  // buffer holding the encoded stream, which is then decoded into the
+  // tile.
+  Buffer dict_buff;
+
+  // Serial path
+  if (thread_pool == nullptr || chunk_num == 1) {
+    for (uint64_t i = 0; i < chunk_num; ++i) {
+      // Read original and compressed chunk size
+      uint64_t chunk_size, compressed_chunk_size;
+      RETURN_NOT_OK(compressed->read(&chunk_size, sizeof(uint64_t)));
+      RETURN_NOT_OK(compressed->read(&compressed_chunk_size, sizeof(uint64_t)));
+
+      // Verify the chunk checksum, if present
+      if (checksums) {
+        uint32_t chunk_checksum;
+        RETURN_NOT_OK(compressed->read(&chunk_checksum, sizeof(uint32_t)));
+        if (crc32c::checksum(compressed->cur_data(), compressed_chunk_size) !=
+            chunk_checksum)
+          return LOG_STATUS(Status::TileIOError(
+              "Cannot decompress tile; Chunk checksum mismatch"));
+      }
+
+      auto dest_buff = (dict) ? &dict_buff : tile->buffer();
+      uint64_t pre_size = dest_buff->size();
+      ConstBuffer input(compressed->cur_data(), compressed_chunk_size);
+      RETURN_NOT_OK(
+          decompress_chunk(compressor, type, cell_size, &input, dest_buff));
+
+      // Unshuffle the decompressed chunk in place
+      if (shuffled) {
+        auto chunk_out = (char*)dest_buff->data() + pre_size;
+        uint64_t out_nbytes = dest_buff->size() - pre_size;
+        std::vector<char> scratch(out_nbytes);
+        std::memcpy(&scratch[0], chunk_out, out_nbytes);
+        unshuffle(&scratch[0], chunk_out, out_nbytes, type_size);
+      }
+
+      compressed->advance_offset(compressed_chunk_size);
+    }
+
+    // Decode the encoded stream into the tile
+    if (dict) {
+      ConstBuffer encoded(dict_buff.data(), dict_buff.size());
+      RETURN_NOT_OK(DictEncoder::decompress(&encoded, tile->buffer()));
+    }
+    return Status::Ok();
+  }
+
+  // Parallel path - scan the chunk headers serially, then decompress the
+  // chunks concurrently. Each chunk decompresses into its own buffer and
+  // gets copied to its (disjoint) region of the tile buffer, as the
+  // decompressors can only append to a buffer they exclusively use.
+  // With dictionary encoding, pre-scan the chunk headers to size the
+  // scratch buffer that receives the encoded stream.
+  if (dict) {
+    uint64_t encoded_size = 0;
+    auto org_offset = compressed->offset();
+    for (uint64_t i = 0; i < chunk_num; ++i) {
+      uint64_t chunk_size, compressed_chunk_size;
+      RETURN_NOT_OK(compressed->read(&chunk_size, sizeof(uint64_t)));
+      RETURN_NOT_OK(compressed->read(&compressed_chunk_size, sizeof(uint64_t)));
+      if (checksums)
+        compressed->advance_offset(sizeof(uint32_t));
+      compressed->advance_offset(compressed_chunk_size);
+      encoded_size += chunk_size;
+    }
+    compressed->set_offset(org_offset);
+    RETURN_NOT_OK(dict_buff.realloc(encoded_size));
+  }
+
+  auto tile_buffer = tile->buffer();
+  auto output_base = (dict) ? (char*)dict_buff.data() :
+                              (char*)tile_buffer->data() + tile_buffer->size();
+  std::vector<Buffer*> chunk_buffers(chunk_num, nullptr);
+  std::vector<std::future<Status>> tasks;
+  Status st = Status::Ok();
+  uint64_t output_offset = 0;
   for (uint64_t i = 0; i < chunk_num; ++i) {
     // Read original and compressed chunk size
     uint64_t chunk_size, compressed_chunk_size;
-    RETURN_NOT_OK(buffer_->read(&chunk_size, sizeof(uint64_t)));
-    RETURN_NOT_OK(buffer_->read(&compressed_chunk_size, sizeof(uint64_t)));
-
-    auto input_buffer =
-        new ConstBuffer(buffer_->cur_data(), compressed_chunk_size);
-
-    // Invoke the proper decompressor
-    switch (tile->compressor()) {
-      case Compressor::NO_COMPRESSION:
-        assert(0);
-        break;
-      case Compressor::GZIP:
-        st = GZip::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::ZSTD:
-        st = ZStd::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::LZ4:
-        st = LZ4::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::BLOSC_LZ:
+    uint32_t chunk_checksum = 0;
+    st = compressed->read(&chunk_size, sizeof(uint64_t));
+    if (st.ok())
+      st = compressed->read(&compressed_chunk_size, sizeof(uint64_t));
+    if (st.ok() && checksums)
+      st = compressed->read(&chunk_checksum, sizeof(uint32_t));
+    if (!st.ok())
+      break;
+
+    chunk_buffers[i] = new Buffer();
+    st = chunk_buffers[i]->realloc(chunk_size);
+    if (!st.ok())
+      break;
+
+    auto input_data = compressed->cur_data();
+    auto chunk_buffer = chunk_buffers[i];
+    auto output_data = output_base + output_offset;
+    tasks.push_back(thread_pool->enqueue([compressor,
+                                          type,
+                                          cell_size,
+                                          input_data,
+                                          compressed_chunk_size,
+                                          chunk_buffer,
+                                          output_data,
+                                          checksums,
+                                          shuffled,
+                                          type_size,
+                                          chunk_checksum]() {
+      // Verify the chunk checksum, if present
+      if (checksums &&
+          crc32c::checksum(input_data, compressed_chunk_size) !=
+              chunk_checksum)
+        return LOG_STATUS(Status::TileIOError(
+            "Cannot decompress tile; Chunk checksum mismatch"));
+
+      ConstBuffer input(input_data, compressed_chunk_size);
+      RETURN_NOT_OK(
+          decompress_chunk(compressor, type, cell_size, &input, chunk_buffer));
+
+      // Unshuffle directly into the tile region, instead of copying
+      if (shuffled)
+        unshuffle(
+            chunk_buffer->data(), output_data, chunk_buffer->size(), type_size);
+      else
+        std::memcpy(output_data, chunk_buffer->data(), chunk_buffer->size());
+      return Status::Ok();
+    }));
+
+    compressed->advance_offset(compressed_chunk_size);
+    output_offset += chunk_size;
+  }
+  if (!thread_pool->wait_all(tasks))
+    st = LOG_STATUS(Status::TileIOError(
+        "Cannot decompress tile; Chunk decompression failed"));
+
+  // Clean up
+  for (auto& chunk_buffer : chunk_buffers)
+    delete chunk_buffer;
+  RETURN_NOT_OK(st);
+
+  // Decode the encoded stream into the tile
+  if (dict) {
+    ConstBuffer encoded(dict_buff.data(), output_offset);
+    RETURN_NOT_OK(DictEncoder::decompress(&encoded, tile_buffer));
+  } else {
+    tile_buffer->advance_size(output_offset);
+    tile_buffer->advance_offset(output_offset);
+  }
+
+  return Status::Ok();
+}
+
+Status TileIO::decompress_chunk(
+    Compressor compressor,
+    Datatype type,
+    uint64_t cell_size,
+    ConstBuffer* input,
+    Buffer* output) {
+  // Invoke the proper decompressor
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      assert(0);
+      return Status::Ok();
+    case Compressor::GZIP:
+      return GZip::decompress(input, output);
+    case Compressor::ZSTD:
+      return ZStd::decompress(input, output);
+    case Compressor::LZ4:
+      return LZ4::decompress(input, output);
+    case Compressor::BLOSC_LZ:
 #undef BLOSC_LZ4
-      case Compressor::BLOSC_LZ4:
+    case Compressor::BLOSC_LZ4:
 #undef BLOSC_LZ4HC
-      case Compressor::BLOSC_LZ4HC:
+    case Compressor::BLOSC_LZ4HC:
 #undef BLOSC_SNAPPY
-      case Compressor::BLOSC_SNAPPY:
+    case Compressor::BLOSC_SNAPPY:
 #undef BLOSC_ZLIB
-      case Compressor::BLOSC_ZLIB:
+    case Compressor::BLOSC_ZLIB:
 #undef BLOSC_ZSTD
-      case Compressor::BLOSC_ZSTD:
-        st = Blosc::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::RLE:
-        st = RLE::decompress(tile->cell_size(), input_buffer, tile->buffer());
-        break;
-      case Compressor::BZIP2:
-        st = BZip::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::DOUBLE_DELTA:
-        st = DoubleDelta::decompress(type, input_buffer, tile->buffer());
-        break;
-    }
+    case Compressor::BLOSC_ZSTD:
+      return Blosc::decompress(input, output);
+    case Compressor::RLE:
+      return RLE::decompress(cell_size, input, output);
+    case Compressor::BZIP2:
+      return BZip::decompress(input, output);
+    case Compressor::DOUBLE_DELTA:
+      return DoubleDelta::decompress(type, input, output);
+  }
 
-    delete input_buffer;
-    RETURN_NOT_OK(st);
+  return Status::Ok();
+}
 
-    buffer_->advance_offset(compressed_chunk_size);
-  }
+void TileIO::shuffle(
+    const void* input, void* output, uint64_t nbytes, uint64_t elem_size) {
+  auto in = static_cast<const unsigned char*>(input);
+  auto out = static_cast<unsigned char*>(output);
+  uint64_t elem_num = nbytes / elem_size;
+  for (uint64_t j = 0; j < elem_size; ++j)
+    for (uint64_t i = 0; i < elem_num; ++i)
+      out[j * elem_num + i] = in[i * elem_size + j];
+
+  // Copy any trailing bytes that do not form a whole element
+  uint64_t shuffled_bytes = elem_num * elem_size;
+  if (shuffled_bytes < nbytes)
+    std::memcpy(
+        out + shuffled_bytes, in + shuffled_bytes, nbytes - shuffled_bytes);
+}
 
-  return st;
+void TileIO::unshuffle(
+    const void* input, void* output, uint64_t nbytes, uint64_t elem_size) {
+  auto in = static_cast<const unsigned char*>(input);
+  auto out = static_cast<unsigned char*>(output);
+  uint64_t elem_num = nbytes / elem_size;
+  for (uint64_t j = 0; j < elem_size; ++j)
+    for (uint64_t i = 0; i < elem_num; ++i)
+      out[i * elem_size + j] = in[j * elem_num + i];
+
+  // Copy any trailing bytes that do not form a whole element
+  uint64_t shuffled_bytes = elem_num * elem_size;
+  if (shuffled_bytes < nbytes)
+    std::memcpy(
+        out + shuffled_bytes, in + shuffled_bytes, nbytes - shuffled_bytes);
 }
 
 uint64_t TileIO::overhead(Tile* tile, uint64_t nbytes) const {
@@ -33,6 +33,9 @@
 #ifndef TILEDB_TILE_IO_H
 #define TILEDB_TILE_IO_H
 
+#include <future>
+
+#include "tiledb/sm/misc/query_stats.h"
 #include "tiledb/sm/misc/uri.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/tile.h"
@@ -41,6 +44,7 @@ namespace tiledb {
 namespace sm {
 
 class StorageManager;
+class ThreadPool;
 
 /** Handles IO (reading/writing) for tiles. */
 class TileIO {
@@ -79,6 +83,12 @@ class TileIO {
   /** Returns the size of the file. */
   uint64_t file_size() const;
 
+  /**
+   * Sets the cache behavior hint of the requesting query, which is
+   * forwarded to the tile cache upon insertion of the read tiles.
+   */
+  void set_cache_hint(CacheHint hint);
+
   /**
    * Reads into a tile from the file.
    *
@@ -94,12 +104,114 @@ class TileIO {
       uint64_t compressed_size,
       uint64_t tile_size);
 
+  /**
+   * Reads the raw (potentially compressed) bytes of a tile from the file,
+   * without decompressing them. If the tile is cached or uncompressed, the
+   * (decompressed) data are read directly into the tile and `*decompress`
+   * is set to `false`. Otherwise, the compressed bytes are read into
+   * `compressed` and `*decompress` is set to `true`, in which case the
+   * caller is responsible for invoking `decompress_and_cache` (potentially
+   * on a separate thread) to produce the final tile data. Note that when
+   * the tile cache operates on compressed tiles (config parameter
+   * `sm.tile_cache_compressed`), a cache hit also sets `*decompress` to
+   * `true`, as the cached bytes still require decompression.
+   *
+   * @param tile The tile to read into.
+   * @param file_offset The offset in the file to read from.
+   * @param compressed_size The size of the compressed tile.
+   * @param tile_size The size of the decompressed tile.
+   * @param compressed The buffer that will hold the compressed tile bytes.
+   * @param decompress Set to `true` if the caller must decompress.
+   * @param stats Per-query statistics to update, or `nullptr`.
+   * @return Status.
+   */
+  Status read_compressed(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t compressed_size,
+      uint64_t tile_size,
+      Buffer* compressed,
+      bool* decompress,
+      QueryStats* stats = nullptr);
+
+  /**
+   * Variant of `read_compressed` that consumes tile bytes already
+   * fetched by the caller (e.g., by a merged read of multiple
+   * physically contiguous tiles) instead of issuing its own I/O. The
+   * raw on-disk bytes of the tile must be in `compressed`; uncompressed
+   * tiles are copied into the tile and cached, whereas for compressed
+   * tiles `*decompress` is set to `true` and the caller is responsible
+   * for invoking `decompress_and_cache`.
+   *
+   * @param tile The tile whose contents will be read.
+   * @param file_offset The offset in the file where the tile is located.
+   * @param tile_size The original size of the tile (before compression).
+   * @param compressed The buffer holding the raw tile bytes.
+   * @param decompress Set to `true` if the tile bytes must still be
+   *     decompressed by the caller.
+   * @param stats The query stats to update (`nullptr` for none).
+   * @return Status.
+   */
+  Status read_prefetched(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t tile_size,
+      Buffer* compressed,
+      bool* decompress,
+      QueryStats* stats = nullptr);
+
+  /**
+   * Asynchronous version of `read_compressed`. The read is enqueued on the
+   * storage manager I/O thread pool, so that the bytes of the next tile can
+   * be fetched while the current tile decompresses (a two-stage
+   * producer/consumer pipeline). All output arguments must remain valid
+   * until the returned future completes.
+   *
+   * @param tile The tile to read into.
+   * @param file_offset The offset in the file to read from.
+   * @param compressed_size The size of the compressed tile.
+   * @param tile_size The size of the decompressed tile.
+   * @param compressed The buffer that will hold the compressed tile bytes.
+   * @param decompress Set to `true` if the caller must decompress.
+   * @param stats Per-query statistics to update, or `nullptr`.
+   * @return Future holding the status of the read.
+   */
+  std::future<Status> read_compressed_async(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t compressed_size,
+      uint64_t tile_size,
+      Buffer* compressed,
+      bool* decompress,
+      QueryStats* stats = nullptr);
+
+  /**
+   * Decompresses the bytes in `compressed` into a tile and stores the
+   * result in the tile cache. This function does not modify any state of
+   * the TileIO object and thus may be safely invoked concurrently for
+   * different tiles of the same file.
+   *
+   * @param tile The tile where the decompressed data will be stored.
+   * @param file_offset The offset of the tile in the file (cache key part).
+   * @param tile_size The size of the decompressed tile.
+   * @param compressed The buffer holding the compressed tile bytes.
+   * @param stats Per-query statistics to update, or `nullptr`.
+   * @return Status.
+   */
+  Status decompress_and_cache(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t tile_size,
+      Buffer* compressed,
+      QueryStats* stats = nullptr);
+
   /**
    * Reads a generic tile from the file. This means that there are not tile
-   * metadata kept anywhere except for the file. Therefore, the function
-   * first reads a small header to retrieve appropriate information about
-   * the tile, and then reads the tile data. Note that it creates a new
-   * Tile object.
+   * metadata kept anywhere except for the file. The function speculatively
+   * reads the small tile header together with a body prefix of
+   * `sm.generic_tile_prefix_size` bytes in a single request; only if the
+   * tile body exceeds the prefix is a second read issued. Note that it
+   * creates a new Tile object.
    *
    * @param tile The tile that will hold the read data.
    * @param file_offset The offset in the file to read from.
@@ -141,7 +253,8 @@ class TileIO {
    * Writes a tile generically to the file. This means that a header will be
    * prepended to the file before writing the tile contents. The reason is
    * that there will be no tile metadata retrieved from another source,
-   * other thant the file itself.
+   * other thant the file itself. The header and the tile contents are
+   * committed with a single write.
    *
    * @param tile The tile to be written.
    * @return Status
@@ -149,14 +262,61 @@ class TileIO {
   Status write_generic(Tile* tile);
 
   /**
-   * Writes the generic tile header to the file.
+   * Serializes the generic tile header into the input buffer.
    *
-   * @param tile The tile whose header will be written.
+   * @param tile The tile whose header will be serialized.
    * @param compressed_size The size that the (potentially) compressed tile
    *     will occupy in the file.
+   * @param buff The buffer the header is appended to.
    * @return Status
    */
-  Status write_generic_tile_header(Tile* tile, uint64_t compressed_size);
+  Status write_generic_tile_header(
+      Tile* tile, uint64_t compressed_size, Buffer* buff);
+
+  /**
+   * Compresses a single tile chunk from `input` into `output`, invoking
+   * the proper compressor. The output buffer must have been allocated
+   * sufficient space (chunk size plus compression overhead) upfront.
+   *
+   * @param compressor The compressor to invoke.
+   * @param level The compression level.
+   * @param type The tile data type.
+   * @param type_size The size of the tile data type.
+   * @param cell_size The tile cell size.
+   * @param input The buffer holding the chunk to be compressed.
+   * @param output The buffer where the compressed chunk will be written.
+   * @return Status
+   */
+  static Status compress_chunk(
+      Compressor compressor,
+      int level,
+      Datatype type,
+      uint64_t type_size,
+      uint64_t cell_size,
+      ConstBuffer* input,
+      Buffer* output);
+
+  /**
+   * Decompresses a single tile chunk from `input` into `output`, invoking
+   * the proper decompressor. The output buffer must have been allocated
+   * sufficient space (the original chunk size) upfront.
+   *
+   * @param compressor The compressor the chunk was compressed with.
+   * @param type The tile data type.
+   * @param cell_size The tile cell size.
+   * @param input The buffer holding the compressed chunk.
+   * @param output The buffer where the decompressed chunk will be written.
+   * @return Status
+   */
+  static Status decompress_chunk(
+      Compressor compressor,
+      Datatype type,
+      uint64_t cell_size,
+      ConstBuffer* input,
+      Buffer* output);
+
+  /** Returns the file URI. */
+  const URI& uri() const;
 
  private:
   /* ********************************* */
@@ -165,10 +325,15 @@ class TileIO {
 
   /**
    * An internal buffer used to facilitate compression/decompression (or
-   * other future filters).
+   * other future filters). It is checked out of the storage manager
+   * buffer pool and released back upon destruction, so its allocation
+   * gets recycled across tiles and queries.
    */
   Buffer* buffer_;
 
+  /** The cache behavior hint of the requesting query. */
+  CacheHint cache_hint_;
+
   /** The size of the file pointed by `uri_`. */
   uint64_t file_size_;
 
@@ -182,6 +347,42 @@ class TileIO {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /**
+   * Completes `read` after a tile cache miss: reads the tile from
+   * storage, decompresses it and stores it in the tile cache.
+   *
+   * @param tile The tile whose contents will be read.
+   * @param file_offset The offset in the file where the tile is located.
+   * @param compressed_size The size of the compressed tile.
+   * @param tile_size The original size of the tile (before compression).
+   * @param in_cache In the compressed caching mode, `true` denotes that
+   *     the compressed bytes were found in the cache (in `buffer_`) and
+   *     only the decompression remains.
+   * @return Status.
+   */
+  Status read_miss(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t compressed_size,
+      uint64_t tile_size,
+      bool in_cache);
+
+  /**
+   * Completes `read_compressed` after a tile cache miss: reads the
+   * (potentially compressed) tile bytes from storage and caches them
+   * where applicable. See `read_compressed` for the parameters.
+   *
+   * @return Status.
+   */
+  Status read_compressed_miss(
+      Tile* tile,
+      uint64_t file_offset,
+      uint64_t compressed_size,
+      uint64_t tile_size,
+      Buffer* compressed,
+      bool* decompress,
+      QueryStats* stats);
+
   /**
    * Compresses a tile. The compressed data are written in buffer_.
    * Note that a coordinates tile must be split into one tile per
@@ -194,7 +395,9 @@ class TileIO {
   Status compress_tile(Tile* tile);
 
   /**
-   * Compresses a single tile. The compressed data are written in buffer_.
+   * Compresses a single tile. The tile chunks are compressed concurrently
+   * on the storage manager compute thread pool (the chunked on-disk format
+   * renders each chunk independent) and then assembled in order in buffer_.
    *
    * @param tile The tile to be compressed.
    * @return Status
@@ -205,6 +408,10 @@ class TileIO {
    * Computes necessary info for chunking a tile upon compression.
    *
    * @param tile The tile whose chunking info is being computed.
+   * @param input_size The size of the data to be chunked, which may
+   *     differ from the tile size if the tile data were pre-encoded.
+   * @param cell_align The alignment (in bytes) the chunks must respect,
+   *     so that no cell is split between two chunks.
    * @param chunk_num The number of chunks to compute.
    * @param max_chunk_size The maximum chunk size to compute.
    * @param overhead The total compression overhead.
@@ -212,28 +419,106 @@ class TileIO {
    */
   Status compute_chunking_info(
       Tile* tile,
+      uint64_t input_size,
+      uint64_t cell_align,
       uint64_t* chunk_num,
       uint64_t* max_chunk_size,
       uint64_t* overhead);
 
   /**
-   * Decompresses buffer_ into a tile.
+   * Narrows the 64-bit cell offsets of `tile` into the 32-bit on-disk
+   * format, rebasing them to start at 0. The narrowed offsets are
+   * written into `narrow_buff` and wrapped by `narrow_tile` without
+   * copying, leaving the input tile intact (its 64-bit offsets may
+   * still be consumed, e.g. by the dictionary encoding of the
+   * corresponding value tile). It is an error if the variable-sized
+   * values the offsets delimit exceed the 32-bit range.
+   *
+   * @param tile The offsets tile to be narrowed.
+   * @param narrow_buff The buffer where the narrowed offsets will be
+   *     written.
+   * @param narrow_tile The tile to wrap the narrowed offsets.
+   * @return Status
+   */
+  static Status narrow_offsets(Tile* tile, Buffer* narrow_buff, Tile* narrow_tile);
+
+  /**
+   * Decompresses `compressed` into a tile.
    * Note that a coordinates tile was split into one tile per
    * dimension. In that case *decompress_one_tile* will be invoked
    * for each dimension sub-tile.
    *
    * @param tile The tile where the decompressed data will be stored.
+   * @param compressed The buffer holding the compressed tile bytes.
+   * @param thread_pool The thread pool on which the tile chunks will be
+   *     decompressed concurrently. If `nullptr`, the chunks are
+   *     decompressed serially on the calling thread. It is safe to pass
+   *     the pool this function is itself running on, as waiting threads
+   *     execute pending tasks instead of blocking.
    * @return Status
    */
-  Status decompress_tile(Tile* tile);
+  static Status decompress_tile(
+      Tile* tile, Buffer* compressed, ThreadPool* thread_pool);
 
   /**
-   * Decompresses buffer_ into a tile.
+   * Decompresses `compressed` into a tile.
    *
    * @param tile The tile where the decompressed data will be stored.
+   * @param compressed The buffer holding the compressed tile bytes.
+   * @param thread_pool The thread pool on which the tile chunks will be
+   *     decompressed concurrently (`nullptr` for serial decompression).
+   * @return Status
+   */
+  static Status decompress_one_tile(
+      Tile* tile, Buffer* compressed, ThreadPool* thread_pool);
+
+  /**
+   * Parses a generic tile header from `header_buff` (starting at its
+   * current offset). It also creates a new tile with the header
+   * information, and retrieves the tile original and compressed size.
+   *
+   * @param header_buff The buffer holding the header bytes.
+   * @param tile The tile to be created.
+   * @param tile_size The original tile size to be retrieved.
+   * @param compressed_size The compressed tile size to be retrieved.
+   * @param header_size The size of the parsed header.
    * @return Status
    */
-  Status decompress_one_tile(Tile* tile);
+  static Status parse_generic_tile_header(
+      Buffer* header_buff,
+      Tile** tile,
+      uint64_t* tile_size,
+      uint64_t* compressed_size,
+      uint64_t* header_size);
+
+  /**
+   * Byte-shuffles `nbytes` of `input` into `output`, grouping the i-th
+   * byte of every `elem_size`-sized element together. This typically
+   * renders numeric data much more compressible, as the high-order bytes
+   * of nearby values tend to be equal. Trailing bytes that do not form a
+   * whole element are copied verbatim. `input` and `output` must not
+   * overlap.
+   *
+   * @param input The buffer holding the data to be shuffled.
+   * @param output The buffer where the shuffled data will be written.
+   * @param nbytes The number of bytes to shuffle.
+   * @param elem_size The size of one element.
+   * @return void
+   */
+  static void shuffle(
+      const void* input, void* output, uint64_t nbytes, uint64_t elem_size);
+
+  /**
+   * Reverses `shuffle`. `input` and `output` must not overlap.
+   *
+   * @param input The buffer holding the shuffled data.
+   * @param output The buffer where the unshuffled data will be written.
+   * @param nbytes The number of bytes to unshuffle.
+   * @param elem_size The size of one element.
+   * @return void
+   */
+  static void unshuffle(
+      const void* input, void* output, uint64_t nbytes, uint64_t elem_size);
 
   /** Computes the compression overhead on *nbytes* of the input tile. */
   uint64_t overhead(Tile* tile, uint64_t nbytes) const;
@@ -0,0 +1,444 @@
+/**
+ * @file   tiledb_advisor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * A command-line compression advisor. It samples tiles from an existing
+ * array, benchmarks every available compressor at several levels on the
+ * actual tile data, and reports the compression ratio and speed tradeoffs
+ * together with a recommended attribute setting.
+ *
+ * Usage: tiledb_advisor <array-uri> [tiles-per-attribute]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/enums/compressor.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/uri.h"
+#include "tiledb/sm/storage_manager/config.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+#include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/tile/tile_io.h"
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** The default number of tiles sampled per attribute. */
+constexpr unsigned default_sample_tiles = 8;
+
+/** A (compressor, level) combination to be benchmarked. */
+struct Candidate {
+  Compressor compressor_;
+  int level_;
+};
+
+/** The benchmark results of a single candidate. */
+struct Result {
+  Candidate candidate_;
+  bool failed_;
+  double ratio_;
+  double compress_mbs_;
+  double decompress_mbs_;
+};
+
+/** A decompressed tile sampled from the array. */
+struct Sample {
+  std::vector<char> data_;
+};
+
+/** Returns `true` if the input datatype is an integer type. */
+bool is_integer_type(Datatype type) {
+  switch (type) {
+    case Datatype::INT8:
+    case Datatype::UINT8:
+    case Datatype::INT16:
+    case Datatype::UINT16:
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::CHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Returns the candidate set for an attribute of the input datatype. */
+std::vector<Candidate> make_candidates(Datatype type) {
+  std::vector<Candidate> candidates = {
+      {Compressor::GZIP, 1},
+      {Compressor::GZIP, 6},
+      {Compressor::GZIP, 9},
+      {Compressor::ZSTD, 1},
+      {Compressor::ZSTD, 3},
+      {Compressor::ZSTD, 9},
+      {Compressor::LZ4, 1},
+      {Compressor::BLOSC_LZ, 5},
+      {Compressor::BLOSC_LZ4, 5},
+      {Compressor::BLOSC_ZSTD, 5},
+      {Compressor::BZIP2, 1},
+      {Compressor::BZIP2, 9},
+      {Compressor::RLE, -1},
+  };
+  if (is_integer_type(type))
+    candidates.push_back({Compressor::DOUBLE_DELTA, -1});
+  return candidates;
+}
+
+/** Converts bytes over seconds to MB/s. */
+double to_mbs(uint64_t bytes, double seconds) {
+  if (seconds <= 0.0)
+    return 0.0;
+  return (bytes / (1024.0 * 1024.0)) / seconds;
+}
+
+/** Returns the elapsed seconds between two steady clock points. */
+double elapsed_seconds(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * Benchmarks a single candidate on the input samples, compressing and
+ * then decompressing every sample once (plus an untimed warmup on the
+ * first sample).
+ */
+Result benchmark_candidate(
+    const Candidate& candidate,
+    Datatype type,
+    uint64_t cell_size,
+    const std::vector<Sample>& samples) {
+  Result result = {candidate, true, 0.0, 0.0, 0.0};
+  auto type_size = datatype_size(type);
+
+  // Allocate scratch buffers large enough for the worst-case expansion
+  // of any of the benchmarked codecs
+  uint64_t max_size = 0;
+  for (const auto& s : samples)
+    max_size = std::max(max_size, (uint64_t)s.data_.size());
+  Buffer compressed;
+  Buffer decompressed;
+  if (!compressed.realloc(3 * max_size + 16384).ok() ||
+      !decompressed.realloc(max_size).ok())
+    return result;
+
+  uint64_t in_bytes = 0, out_bytes = 0;
+  double compress_seconds = 0.0, decompress_seconds = 0.0;
+  for (size_t i = 0; i < samples.size() + 1; ++i) {
+    // Run the first sample twice; the first (warmup) run is not timed,
+    // so that one-off codec context allocations do not skew the results
+    bool warmup = (i == 0);
+    const auto& sample = samples[warmup ? 0 : i - 1];
+    auto sample_size = (uint64_t)sample.data_.size();
+
+    ConstBuffer input(sample.data_.data(), sample_size);
+    compressed.reset_size();
+    compressed.reset_offset();
+    auto t0 = std::chrono::steady_clock::now();
+    auto st = TileIO::compress_chunk(
+        candidate.compressor_,
+        candidate.level_,
+        type,
+        type_size,
+        cell_size,
+        &input,
+        &compressed);
+    auto t1 = std::chrono::steady_clock::now();
+    if (!st.ok())
+      return result;
+
+    ConstBuffer comp_input(compressed.data(), compressed.size());
+    decompressed.reset_size();
+    decompressed.reset_offset();
+    auto t2 = std::chrono::steady_clock::now();
+    st = TileIO::decompress_chunk(
+        candidate.compressor_, type, cell_size, &comp_input, &decompressed);
+    auto t3 = std::chrono::steady_clock::now();
+    if (!st.ok() || decompressed.size() != sample_size)
+      return result;
+
+    if (!warmup) {
+      in_bytes += sample_size;
+      out_bytes += compressed.size();
+      compress_seconds += elapsed_seconds(t0, t1);
+      decompress_seconds += elapsed_seconds(t2, t3);
+    }
+  }
+
+  result.failed_ = false;
+  result.ratio_ = (out_bytes == 0) ? 0.0 : (double)in_bytes / out_bytes;
+  result.compress_mbs_ = to_mbs(in_bytes, compress_seconds);
+  result.decompress_mbs_ = to_mbs(in_bytes, decompress_seconds);
+  return result;
+}
+
+/**
+ * Picks the recommended candidate: the highest compression ratio among
+ * the candidates whose compression and decompression throughput are
+ * within 4x of the fastest observed, falling back to the highest ratio
+ * overall if no candidate qualifies.
+ */
+const Result* recommend(const std::vector<Result>& results) {
+  double best_compress_mbs = 0.0, best_decompress_mbs = 0.0;
+  for (const auto& r : results) {
+    if (r.failed_)
+      continue;
+    best_compress_mbs = std::max(best_compress_mbs, r.compress_mbs_);
+    best_decompress_mbs = std::max(best_decompress_mbs, r.decompress_mbs_);
+  }
+
+  const Result* best = nullptr;
+  const Result* best_overall = nullptr;
+  for (const auto& r : results) {
+    if (r.failed_)
+      continue;
+    if (best_overall == nullptr || r.ratio_ > best_overall->ratio_)
+      best_overall = &r;
+    bool eligible = (4.0 * r.compress_mbs_ >= best_compress_mbs) &&
+                    (4.0 * r.decompress_mbs_ >= best_decompress_mbs);
+    if (eligible && (best == nullptr || r.ratio_ > best->ratio_))
+      best = &r;
+  }
+  return (best != nullptr) ? best : best_overall;
+}
+
+/**
+ * Samples up to `sample_tiles` decompressed tiles of the input attribute,
+ * evenly spaced across all fragments of the array. For variable-sized
+ * attributes the value (not the offsets) tiles are sampled, as the
+ * attribute compressor applies to the values.
+ */
+Status sample_attribute_tiles(
+    StorageManager* sm,
+    const ArraySchema* schema,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    unsigned attr_id,
+    unsigned sample_tiles,
+    std::vector<Sample>* samples) {
+  auto var_size = schema->var_size(attr_id);
+  auto type = schema->type(attr_id);
+  auto cell_size =
+      var_size ? datatype_size(type) : schema->cell_size(attr_id);
+
+  // Enumerate all (fragment, tile) pairs of the attribute
+  std::vector<std::pair<size_t, uint64_t>> all_tiles;
+  for (size_t f = 0; f < fragment_metadata.size(); ++f) {
+    RETURN_NOT_OK(fragment_metadata[f]->load_tile_offsets(attr_id));
+    auto tile_num = fragment_metadata[f]->tile_num();
+    for (uint64_t t = 0; t < tile_num; ++t)
+      all_tiles.emplace_back(f, t);
+  }
+  if (all_tiles.empty())
+    return Status::Ok();
+
+  // Pick the sampled tiles evenly spaced over the enumeration
+  auto stride = std::max<uint64_t>(1, all_tiles.size() / sample_tiles);
+  for (uint64_t i = 0; i < all_tiles.size() && samples->size() < sample_tiles;
+       i += stride) {
+    auto f = all_tiles[i].first;
+    auto t = all_tiles[i].second;
+    auto meta = fragment_metadata[f];
+
+    uint64_t file_offset, compressed_size, tile_size;
+    URI uri;
+    if (var_size) {
+      uri = meta->attr_var_uri(attr_id);
+      file_offset = meta->file_var_offset(attr_id, t);
+      compressed_size = meta->compressed_tile_var_size(attr_id, t);
+      tile_size = meta->tile_var_size(attr_id, t);
+    } else {
+      uri = meta->attr_uri(attr_id);
+      file_offset = meta->file_offset(attr_id, t);
+      compressed_size = meta->compressed_tile_size(attr_id, t);
+      tile_size = meta->tile_size(attr_id, t);
+    }
+    if (tile_size == 0)
+      continue;
+
+    Tile tile;
+    RETURN_NOT_OK(
+        tile.init(type, schema->compression(attr_id), cell_size, 0));
+    TileIO tile_io(
+        sm,
+        uri,
+        var_size ? meta->file_var_sizes(attr_id) :
+                   meta->file_sizes(attr_id));
+    RETURN_NOT_OK(tile_io.read(&tile, file_offset, compressed_size, tile_size));
+
+    samples->emplace_back();
+    samples->back().data_.resize(tile_size);
+    std::memcpy(samples->back().data_.data(), tile.data(), tile_size);
+  }
+
+  return Status::Ok();
+}
+
+/** Benchmarks all candidates on one attribute and prints the report. */
+Status advise_attribute(
+    StorageManager* sm,
+    const ArraySchema* schema,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    unsigned attr_id,
+    unsigned sample_tiles) {
+  auto attr = schema->attribute(attr_id);
+  auto type = schema->type(attr_id);
+  auto var_size = schema->var_size(attr_id);
+  auto cell_size =
+      var_size ? datatype_size(type) : schema->cell_size(attr_id);
+
+  std::vector<Sample> samples;
+  RETURN_NOT_OK(sample_attribute_tiles(
+      sm, schema, fragment_metadata, attr_id, sample_tiles, &samples));
+
+  uint64_t sampled_bytes = 0;
+  for (const auto& s : samples)
+    sampled_bytes += s.data_.size();
+
+  std::printf(
+      "\nAttribute \"%s\" (%s, %s, current: %s level %d)\n",
+      attr->name().c_str(),
+      datatype_str(type),
+      var_size ? "var-sized" : "fixed-size",
+      compressor_str(schema->compression(attr_id)),
+      schema->compression_level(attr_id));
+
+  if (samples.empty()) {
+    std::printf("  No tiles to sample.\n");
+    return Status::Ok();
+  }
+
+  std::printf(
+      "  Sampled %zu tiles (%.1f MB)\n\n",
+      samples.size(),
+      sampled_bytes / (1024.0 * 1024.0));
+  std::printf(
+      "  %-14s %5s %8s %15s %17s\n",
+      "COMPRESSOR",
+      "LEVEL",
+      "RATIO",
+      "COMPRESS MB/s",
+      "DECOMPRESS MB/s");
+
+  std::vector<Result> results;
+  for (const auto& candidate : make_candidates(type)) {
+    results.push_back(benchmark_candidate(candidate, type, cell_size, samples));
+    const auto& r = results.back();
+    if (r.failed_) {
+      std::printf(
+          "  %-14s %5d %8s %15s %17s\n",
+          compressor_str(candidate.compressor_),
+          candidate.level_,
+          "-",
+          "-",
+          "-");
+    } else {
+      std::printf(
+          "  %-14s %5d %8.2f %15.1f %17.1f\n",
+          compressor_str(candidate.compressor_),
+          candidate.level_,
+          r.ratio_,
+          r.compress_mbs_,
+          r.decompress_mbs_);
+    }
+  }
+
+  auto best = recommend(results);
+  if (best != nullptr) {
+    std::printf(
+        "\n  Recommended: set_compressor(%s); set_compression_level(%d)\n",
+        compressor_str(best->candidate_.compressor_),
+        best->candidate_.level_);
+  } else {
+    std::printf("\n  No working candidate found.\n");
+  }
+
+  return Status::Ok();
+}
+
+Status advise(const std::string& array_uri, unsigned sample_tiles) {
+  Config config;
+  StorageManager sm;
+  RETURN_NOT_OK(sm.init(&config));
+
+  URI uri(array_uri);
+  const ArraySchema* schema;
+  std::vector<FragmentMetadata*> fragment_metadata;
+  RETURN_NOT_OK(sm.array_open(uri, QueryType::READ, &schema, &fragment_metadata));
+
+  std::printf("Array: %s\n", array_uri.c_str());
+  if (fragment_metadata.empty())
+    std::printf("The array is empty; nothing to sample.\n");
+
+  Status st = Status::Ok();
+  auto attribute_num = schema->attribute_num();
+  for (unsigned i = 0; i < attribute_num && st.ok(); ++i)
+    st = advise_attribute(&sm, schema, fragment_metadata, i, sample_tiles);
+
+  auto close_st = sm.array_close(uri);
+  return st.ok() ? close_st : st;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <array-uri> [tiles-per-attribute]\n";
+    return 1;
+  }
+
+  unsigned sample_tiles = default_sample_tiles;
+  if (argc == 3) {
+    auto n = std::atol(argv[2]);
+    if (n <= 0) {
+      std::cerr << "Invalid number of tiles per attribute\n";
+      return 1;
+    }
+    sample_tiles = (unsigned)n;
+  }
+
+  auto st = advise(argv[1], sample_tiles);
+  if (!st.ok()) {
+    std::cerr << st.to_string() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
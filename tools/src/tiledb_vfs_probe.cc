@@ -0,0 +1,323 @@
+/**
+ * @file tiledb_vfs_probe.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * A command-line VFS backend throughput probe. It writes and reads
+ * scratch files on the target backend at several client concurrency
+ * levels, measures the aggregate throughput and the small-read latency,
+ * and emits recommended VFS configuration parameters for the backend
+ * (parallelism, parallel operation granularity, and S3 part sizes on S3
+ * targets). Optimal settings differ wildly across backends (local NVMe
+ * peaks at a few threads, object stores need tens of connections), so
+ * the probe replaces per-deployment hand-tuning.
+ *
+ * Usage: tiledb_vfs_probe <target-dir-uri> [per-thread-mb]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tiledb/sm/enums/vfs_mode.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/misc/uri.h"
+#include "tiledb/sm/storage_manager/config.h"
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** The default per-thread probe file size (in MB). */
+constexpr uint64_t default_file_mb = 4;
+
+/** The I/O chunk size of the probe (below `vfs.min_parallel_size`). */
+constexpr uint64_t chunk_size = 1024 * 1024;
+
+/** The size of the small random reads of the latency phase. */
+constexpr uint64_t small_read_size = 4096;
+
+/** The number of small random reads per thread. */
+constexpr uint64_t small_read_num = 32;
+
+/** The client concurrency levels the probe measures. */
+const std::vector<uint64_t> concurrency_levels = {1, 2, 4, 8, 16, 32, 64};
+
+/** The measurements of a single concurrency level. */
+struct LevelResult {
+  uint64_t concurrency_;
+  double write_mbs_;
+  double read_mbs_;
+  double small_read_ms_;
+};
+
+/** Returns the URI of the `i`-th probe file under the scratch dir. */
+URI probe_file(const URI& scratch, uint64_t i) {
+  return scratch.join_path("probe_" + std::to_string(i));
+}
+
+/** Writes a probe file of `file_bytes` bytes in `chunk_size` chunks. */
+Status write_file(
+    VFS* vfs, const URI& uri, const std::vector<char>& chunk,
+    uint64_t file_bytes) {
+  RETURN_NOT_OK(vfs->open_file(uri, VFSMode::VFS_WRITE));
+  for (uint64_t off = 0; off < file_bytes; off += chunk_size)
+    RETURN_NOT_OK(vfs->write(
+        uri, &chunk[0], std::min(chunk_size, file_bytes - off)));
+  return vfs->close_file(uri);
+}
+
+/** Reads a probe file back fully in `chunk_size` chunks. */
+Status read_file(
+    VFS* vfs, const URI& uri, std::vector<char>* chunk, uint64_t file_bytes) {
+  for (uint64_t off = 0; off < file_bytes; off += chunk_size)
+    RETURN_NOT_OK(vfs->read(
+        uri, off, &(*chunk)[0], std::min(chunk_size, file_bytes - off)));
+  return Status::Ok();
+}
+
+/**
+ * Measures one concurrency level: `concurrency` client threads write
+ * their own probe file, read it back fully, and then issue small random
+ * reads, with the aggregate throughput and mean small-read latency
+ * recorded in `result`.
+ */
+Status run_level(
+    VFS* vfs,
+    const URI& scratch,
+    uint64_t concurrency,
+    uint64_t file_bytes,
+    LevelResult* result) {
+  result->concurrency_ = concurrency;
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> threads;
+
+  // Write phase
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < concurrency; ++i) {
+    threads.emplace_back([vfs, &scratch, &failed, i, file_bytes]() {
+      std::vector<char> chunk(chunk_size, (char)(i + 1));
+      if (!write_file(vfs, probe_file(scratch, i), chunk, file_bytes).ok())
+        failed = true;
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  threads.clear();
+  auto t1 = std::chrono::steady_clock::now();
+  if (failed)
+    return Status::Error("Probe write phase failed");
+  auto write_s = std::chrono::duration<double>(t1 - t0).count();
+  result->write_mbs_ =
+      (double)(concurrency * file_bytes) / (1024 * 1024) / write_s;
+
+  // Sequential read phase
+  t0 = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < concurrency; ++i) {
+    threads.emplace_back([vfs, &scratch, &failed, i, file_bytes]() {
+      std::vector<char> chunk(chunk_size);
+      if (!read_file(vfs, probe_file(scratch, i), &chunk, file_bytes).ok())
+        failed = true;
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  threads.clear();
+  t1 = std::chrono::steady_clock::now();
+  if (failed)
+    return Status::Error("Probe read phase failed");
+  auto read_s = std::chrono::duration<double>(t1 - t0).count();
+  result->read_mbs_ =
+      (double)(concurrency * file_bytes) / (1024 * 1024) / read_s;
+
+  // Small random read (latency) phase
+  std::vector<double> latencies_ms(concurrency, 0.0);
+  for (uint64_t i = 0; i < concurrency; ++i) {
+    threads.emplace_back([vfs, &scratch, &failed, &latencies_ms, i,
+                          file_bytes]() {
+      std::vector<char> buf(small_read_size);
+      std::mt19937_64 rng(0xBADC0FFE + i);
+      auto uri = probe_file(scratch, i);
+      auto range = file_bytes - small_read_size;
+      auto s0 = std::chrono::steady_clock::now();
+      for (uint64_t r = 0; r < small_read_num; ++r) {
+        if (!vfs->read(uri, rng() % range, &buf[0], small_read_size).ok()) {
+          failed = true;
+          return;
+        }
+      }
+      auto s1 = std::chrono::steady_clock::now();
+      latencies_ms[i] =
+          std::chrono::duration<double, std::milli>(s1 - s0).count() /
+          (double)small_read_num;
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  threads.clear();
+  if (failed)
+    return Status::Error("Probe latency phase failed");
+  double lat_sum = 0.0;
+  for (auto l : latencies_ms)
+    lat_sum += l;
+  result->small_read_ms_ = lat_sum / (double)concurrency;
+
+  // Remove the probe files
+  for (uint64_t i = 0; i < concurrency; ++i)
+    RETURN_NOT_OK(vfs->remove_file(probe_file(scratch, i)));
+
+  return Status::Ok();
+}
+
+/** Rounds `bytes` up to a power of two, clamped to `[lo, hi]`. */
+uint64_t round_pow2(uint64_t bytes, uint64_t lo, uint64_t hi) {
+  uint64_t p = lo;
+  while (p < bytes && p < hi)
+    p *= 2;
+  return p;
+}
+
+/**
+ * Prints the recommended configuration derived from the measurements:
+ * the smallest concurrency within 5% of the best read throughput, and a
+ * parallel operation granularity derived from the bandwidth-delay
+ * product of the backend (the request size below which issuing another
+ * concurrent request beats splitting the current one).
+ */
+void recommend(const URI& target, const std::vector<LevelResult>& results) {
+  const LevelResult* best = &results[0];
+  for (const auto& r : results) {
+    if (r.read_mbs_ > best->read_mbs_)
+      best = &r;
+  }
+  const LevelResult* chosen = best;
+  for (const auto& r : results) {
+    if (r.read_mbs_ >= 0.95 * best->read_mbs_ &&
+        r.concurrency_ < chosen->concurrency_)
+      chosen = &r;
+  }
+
+  // Bandwidth-delay product per connection, in bytes
+  auto per_thread_mbs = chosen->read_mbs_ / (double)chosen->concurrency_;
+  auto bdp = (uint64_t)(per_thread_mbs * 1024 * 1024 *
+                        (chosen->small_read_ms_ / 1000.0));
+  auto min_parallel_size =
+      round_pow2(bdp, 1024 * 1024, 64 * 1024 * 1024);
+
+  std::printf("\nRecommended configuration:\n");
+  std::printf(
+      "  vfs.max_parallel_ops = %llu\n",
+      (unsigned long long)chosen->concurrency_);
+  std::printf(
+      "  vfs.min_parallel_size = %llu\n",
+      (unsigned long long)min_parallel_size);
+  if (target.is_s3()) {
+    std::printf(
+        "  vfs.s3.max_parallel_ops = %llu\n",
+        (unsigned long long)chosen->concurrency_);
+    std::printf(
+        "  vfs.s3.multipart_part_size = %llu\n",
+        (unsigned long long)std::max(
+            min_parallel_size, (uint64_t)(5 * 1024 * 1024)));
+  }
+}
+
+Status probe(const std::string& target, uint64_t file_mb) {
+  Config config;
+  VFS vfs;
+  RETURN_NOT_OK(vfs.init(config.vfs_params()));
+
+  URI target_uri(target);
+  auto scratch = target_uri.join_path("__tiledb_vfs_probe");
+  RETURN_NOT_OK(vfs.create_dir(scratch));
+
+  auto file_bytes = file_mb * 1024 * 1024;
+  std::printf("Target: %s\n", target_uri.to_string().c_str());
+  std::printf("Probe file size: %llu MB per thread\n\n",
+              (unsigned long long)file_mb);
+  std::printf("  threads   write MB/s    read MB/s   4KB-read ms\n");
+
+  std::vector<LevelResult> results;
+  Status st = Status::Ok();
+  for (auto concurrency : concurrency_levels) {
+    LevelResult result;
+    st = run_level(&vfs, scratch, concurrency, file_bytes, &result);
+    if (!st.ok())
+      break;
+    results.push_back(result);
+    std::printf(
+        "  %7llu  %11.1f  %11.1f  %12.3f\n",
+        (unsigned long long)result.concurrency_,
+        result.write_mbs_,
+        result.read_mbs_,
+        result.small_read_ms_);
+  }
+
+  auto rm_st = vfs.remove_dir(scratch);
+  RETURN_NOT_OK(st);
+  RETURN_NOT_OK(rm_st);
+
+  if (!results.empty())
+    recommend(target_uri, results);
+
+  return Status::Ok();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <target-dir-uri> [per-thread-mb]\n";
+    return 1;
+  }
+
+  uint64_t file_mb = default_file_mb;
+  if (argc == 3) {
+    auto n = std::atol(argv[2]);
+    if (n <= 0) {
+      std::cerr << "Invalid per-thread probe size\n";
+      return 1;
+    }
+    file_mb = (uint64_t)n;
+  }
+
+  auto st = probe(argv[1], file_mb);
+  if (!st.ok()) {
+    std::cerr << st.to_string() << "\n";
+    return 1;
+  }
+
+  return 0;
+}